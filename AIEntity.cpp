@@ -189,5 +189,6 @@ void AIEntity::Update(float deltaTime) {
         
         // Update rotation to match orientation
         gameObject->rotation = aiOrientation;
+        gameObject->MarkDirty(GameObject::DIRTY_TRANSFORM);
     }
 }
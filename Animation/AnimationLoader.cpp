@@ -4,6 +4,8 @@
 #include <sstream>
 #include <vector>
 #include <string>
+#include <utility>
+#include "../AssetManager.h"
 
 // For JSON parsing, we'll use a simple approach since we don't have a JSON library
 // In a real implementation, you would use a proper JSON library like nlohmann/json
@@ -24,6 +26,10 @@ std::shared_ptr<Animation::Animation> AnimationLoader::LoadFromFile(const std::s
     // Close the file
     file.close();
     
+    return std::shared_ptr<Animation::Animation>(LoadFromString(content));
+}
+
+Animation::Animation* AnimationLoader::LoadFromString(const std::string& content) {
     // Parse the JSON content
     std::string animationName;
     float duration = 1.0f;
@@ -119,7 +125,7 @@ std::shared_ptr<Animation::Animation> AnimationLoader::LoadFromFile(const std::s
     }
     
     // Create the animation
-    std::shared_ptr<Animation::Animation> animation = std::make_shared<Animation::Animation>(animationName, duration, isLooping);
+    Animation::Animation* animation = new Animation::Animation(animationName, duration, isLooping);
     
     // Add the keyframes to the animation
     for (const auto& keyframe : keyframes) {
@@ -194,3 +200,31 @@ std::shared_ptr<Animation::Animation> AnimationLoader::LoadFromOBJSequence(
     
     return animation;
 }
+
+Animation::Animation* AssetLoader<Animation::Animation>::Load(const std::string& path, const std::string& settings) {
+    (void)settings;
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open animation file: " << path << std::endl;
+        return nullptr;
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return AnimationLoader::LoadFromString(buffer.str());
+}
+
+bool AssetLoader<Animation::Animation>::Reload(Animation::Animation* animation, const std::string& path,
+                                               const std::string& settings) {
+    Animation::Animation* fresh = Load(path, settings);
+    if (!fresh) {
+        return false;
+    }
+    *animation = std::move(*fresh);
+    delete fresh;
+    return true;
+}
+
+void AssetLoader<Animation::Animation>::Unload(Animation::Animation* animation) {
+    delete animation;
+}
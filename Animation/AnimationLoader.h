@@ -3,13 +3,18 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 #include "Animation.h"
+#include "../AssetStreamer.h"
 
 class AnimationLoader {
 public:
     // Load an animation from a .savanim file
     static std::shared_ptr<Animation::Animation> LoadFromFile(const std::string& path);
     
+    // Parse the contents of a .savanim file; nullptr on failure
+    static Animation::Animation* LoadFromString(const std::string& content);
+    
     // Save an animation to a .savanim file
     static void SaveToFile(const Animation::Animation& anim, const std::string& path);
     
@@ -22,4 +27,30 @@ public:
         bool loop = true);
 };
 
+// Animations are parsed and their keyframe meshes loaded on a worker
+template <>
+struct AssetStreamLoader<Animation::Animation> {
+    static bool Read(const std::string& path, const std::string& settings, std::vector<unsigned char>& bytes) {
+        (void)settings;
+        return AssetStreamer::ReadFile(path, bytes);
+    }
+    
+    static Animation::Animation* Decode(const std::string& path, const std::string& settings,
+                                        const std::vector<unsigned char>& bytes) {
+        (void)path;
+        (void)settings;
+        return AnimationLoader::LoadFromString(std::string(bytes.begin(), bytes.end()));
+    }
+    
+    static size_t GetUploadSize(const Animation::Animation& animation) {
+        (void)animation;
+        return 0;
+    }
+    
+    static bool Upload(Animation::Animation& animation) {
+        (void)animation;
+        return true;
+    }
+};
+
 #endif // ANIMATION_LOADER_H
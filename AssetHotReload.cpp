@@ -0,0 +1,70 @@
+#include "AssetHotReload.h"
+#include "AssetManager.h"
+#include "Shaders/Core/ShaderSourceCache.h"
+#include <iostream>
+
+namespace {
+    bool EndsWith(const std::string& text, const std::string& suffix) {
+        return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+}
+
+AssetHotReload& AssetHotReload::GetInstance() {
+    static AssetHotReload instance;
+    return instance;
+}
+
+bool AssetHotReload::Start(const std::vector<std::string>& folders) {
+    bool watching = false;
+    for (const std::string& folder : folders) {
+        watching = watcher.AddFolder(folder) || watching;
+    }
+    running = watching;
+    reloadCount = 0;
+    return watching;
+}
+
+void AssetHotReload::Stop() {
+    watcher.Clear();
+    running = false;
+}
+
+size_t AssetHotReload::Update() {
+    if (!running) {
+        return 0;
+    }
+
+    watcher.Poll(changed);
+    size_t reloaded = 0;
+    for (const std::string& path : changed) {
+        if (IsIgnored(path)) {
+            continue;
+        }
+        size_t count = AssetManager::GetInstance().Reload(path);
+
+        // Shader includes are not assets of their own; reload the shaders
+        // that include them instead
+        for (const std::string& shader : ShaderSourceCache::GetInstance().GetDependents(path)) {
+            count += AssetManager::GetInstance().Reload(shader);
+        }
+        if (count > 0) {
+            std::cout << "Reloaded " << path << std::endl;
+        }
+        reloaded += count;
+    }
+    reloadCount += reloaded;
+    return reloaded;
+}
+
+bool AssetHotReload::IsIgnored(const std::string& path) {
+    // Cooking a changed file writes its cooked file next to it
+    if (EndsWith(path, ".savmesh") || EndsWith(path, ".savtex") || EndsWith(path, ".savshader") ||
+        EndsWith(path, ".tmp")) {
+        return true;
+    }
+
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    return name.empty() || name[0] == '#' || name.compare(0, 2, ".#") == 0 || name.back() == '~' ||
+           EndsWith(name, ".swp") || EndsWith(name, ".swx");
+}
@@ -0,0 +1,62 @@
+#ifndef ASSET_HOT_RELOAD_H
+#define ASSET_HOT_RELOAD_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "FileWatcher.h"
+
+// Reloads assets while the editor or game runs, as their files are saved.
+//
+//     std::vector<std::string> folders = { "Shaders" };
+//     for (const auto& path : ProjectSettings::GetInstance().GetAssetPaths()) {
+//         folders.push_back(path.second);
+//     }
+//     AssetHotReload::GetInstance().Start(folders);
+//     ...
+//     AssetHotReload::GetInstance().Update();    // once a frame, main thread
+//
+// Only the assets loaded from a changed file are reloaded, through
+// AssetManager::Reload, which loads them again into the objects already in
+// use: every handle, model and material sees the new version without the
+// scene being reloaded. Meshes and textures load through their caches, so
+// just the changed file is cooked again. Files nothing has loaded are
+// ignored until something does.
+class AssetHotReload {
+public:
+    static AssetHotReload& GetInstance();
+
+    // Watch folders for changes; false if none of them could be watched
+    bool Start(const std::vector<std::string>& folders);
+
+    // Stop watching
+    void Stop();
+
+    bool IsRunning() const { return running; }
+
+    // Reload the assets of files that changed since the last call. Loads
+    // graphics objects, so call it on the main thread. Returns the number
+    // of assets reloaded.
+    size_t Update();
+
+    // Assets reloaded since Start
+    size_t GetReloadCount() const { return reloadCount; }
+
+    // Files written by the engine itself (cooked meshes and textures) and
+    // editors' temporary files, which are never reloaded
+    static bool IsIgnored(const std::string& path);
+
+    FileWatcher& GetWatcher() { return watcher; }
+
+private:
+    AssetHotReload() : running(false), reloadCount(0) {}
+    AssetHotReload(const AssetHotReload&);
+    AssetHotReload& operator=(const AssetHotReload&);
+
+    FileWatcher watcher;
+    bool running;
+    size_t reloadCount;
+    std::vector<std::string> changed;
+};
+
+#endif // ASSET_HOT_RELOAD_H
@@ -0,0 +1,288 @@
+#include "AssetManager.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+AssetManager& AssetManager::GetInstance() {
+    // Never destroyed, so handles held by other statics can still release
+    // their assets at exit
+    static AssetManager* instance = new AssetManager();
+    return *instance;
+}
+
+std::string AssetManager::MakeKey(const std::type_info& type, const std::string& path, const std::string& settings) {
+    std::string key = type.name();
+    key += '\n';
+    key += path;
+    key += '\n';
+    key += settings;
+    return key;
+}
+
+AssetEntry* AssetManager::Acquire(const std::type_info& type, const std::string& path, const std::string& settings,
+                                  void* (*load)(const std::string&, const std::string&), void (*unload)(void*),
+                                  ReloadFunction reload) {
+    std::string normalized = NormalizePath(path);
+    std::string key = MakeKey(type, normalized, settings);
+
+    AssetEntry* entry = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it != entries.end()) {
+            // Already loaded, or another thread is loading it
+            entry = it->second;
+            entry->refCount++;
+            loadFinished.wait(lock, [entry] { return entry->state != AssetEntry::LOADING; });
+            if (entry->state == AssetEntry::READY) {
+                return entry;
+            }
+
+            // The loading thread has already removed the failed entry; the
+            // last one to let go of it deletes it
+            if (--entry->refCount == 0) {
+                delete entry;
+            }
+            return nullptr;
+        }
+
+        entry = new AssetEntry();
+        entry->key = key;
+        entry->path = normalized;
+        entry->settings = settings;
+        entry->unload = unload;
+        entry->reload = reload;
+        entry->refCount = 1;
+        entries[key] = entry;
+    }
+
+    // Load without holding the lock so other assets can load meanwhile
+    void* asset = nullptr;
+    try {
+        asset = load(normalized, settings);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Exception while loading asset " << normalized << ": " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Error: Exception while loading asset " << normalized << std::endl;
+    }
+    loadCalls++;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (asset) {
+        entry->asset = asset;
+        entry->state = AssetEntry::READY;
+        loadFinished.notify_all();
+        return entry;
+    }
+
+    std::cerr << "Error: Failed to load asset: " << normalized << std::endl;
+
+    // Forget the failure so a later request tries again
+    entry->state = AssetEntry::FAILED;
+    entries.erase(key);
+    if (--entry->refCount == 0) {
+        delete entry;
+    }
+    loadFinished.notify_all();
+    return nullptr;
+}
+
+AssetEntry* AssetManager::Find(const std::type_info& type, const std::string& path, const std::string& settings) {
+    std::string key = MakeKey(type, NormalizePath(path), settings);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end() || it->second->state != AssetEntry::READY) {
+        return nullptr;
+    }
+    it->second->refCount++;
+    return it->second;
+}
+
+AssetEntry* AssetManager::Insert(const std::type_info& type, const std::string& path, const std::string& settings,
+                                 void* asset, void (*unload)(void*), ReloadFunction reload) {
+    std::string normalized = NormalizePath(path);
+    std::string key = MakeKey(type, normalized, settings);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (auto it = entries.find(key); it != entries.end(); it = entries.find(key)) {
+        AssetEntry* existing = it->second;
+        existing->refCount++;
+        loadFinished.wait(lock, [existing] { return existing->state != AssetEntry::LOADING; });
+        if (existing->state == AssetEntry::READY) {
+            // Loaded twice; keep the copy everyone else already uses
+            lock.unlock();
+            unload(asset);
+            return existing;
+        }
+
+        // That load failed; look again in case another one started
+        if (--existing->refCount == 0) {
+            delete existing;
+        }
+    }
+
+    AssetEntry* entry = new AssetEntry();
+    entry->key = key;
+    entry->path = normalized;
+    entry->settings = settings;
+    entry->asset = asset;
+    entry->unload = unload;
+    entry->reload = reload;
+    entry->refCount = 1;
+    entry->state = AssetEntry::READY;
+    entries[key] = entry;
+    return entry;
+}
+
+void AssetManager::AddRef(AssetEntry* entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entry->refCount++;
+}
+
+void AssetManager::Release(AssetEntry* entry) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--entry->refCount > 0) {
+            return;
+        }
+        entries.erase(entry->key);
+    }
+
+    // Unload outside the lock; the asset may release handles of its own
+    if (entry->unload && entry->asset) {
+        entry->unload(entry->asset);
+    }
+    delete entry;
+}
+
+size_t AssetManager::Reload(const std::string& path) {
+    std::string normalized = NormalizePath(path);
+
+    // Hold on to the matches so they cannot be unloaded while reloading
+    std::vector<AssetEntry*> matches;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& pair : entries) {
+            AssetEntry* entry = pair.second;
+            if (entry->state == AssetEntry::READY && entry->reload && UsesFile(*entry, normalized)) {
+                entry->refCount++;
+                matches.push_back(entry);
+            }
+        }
+    }
+
+    size_t reloaded = 0;
+    for (AssetEntry* entry : matches) {
+        bool success = false;
+        try {
+            success = entry->reload(entry->asset, entry->path, entry->settings);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: Exception while reloading asset " << entry->path << ": " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Error: Exception while reloading asset " << entry->path << std::endl;
+        }
+
+        if (success) {
+            entry->version++;
+            reloaded++;
+        } else {
+            std::cerr << "Error: Failed to reload asset, keeping the previous version: " << entry->path << std::endl;
+        }
+        Release(entry);
+    }
+    return reloaded;
+}
+
+bool AssetManager::UsesFile(const AssetEntry& entry, const std::string& path) {
+    if (entry.path == path) {
+        return true;
+    }
+
+    // Settings values naming other files, like "fragment=Shaders/lit.frag"
+    const std::string& settings = entry.settings;
+    size_t start = 0;
+    while (start < settings.size()) {
+        size_t end = settings.find(';', start);
+        if (end == std::string::npos) {
+            end = settings.size();
+        }
+        size_t equals = settings.find('=', start);
+        if (equals != std::string::npos && equals < end && settings.compare(equals + 1, end - equals - 1, path) == 0) {
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+size_t AssetManager::GetRefCount(const std::type_info& type, const std::string& path,
+                                 const std::string& settings) const {
+    std::string key = MakeKey(type, NormalizePath(path), settings);
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    return it != entries.end() ? it->second->refCount : 0;
+}
+
+size_t AssetManager::GetLoadedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::string AssetManager::NormalizePath(const std::string& path) {
+    std::string unified = path;
+    std::replace(unified.begin(), unified.end(), '\\', '/');
+
+    bool absolute = !unified.empty() && unified[0] == '/';
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (start <= unified.size()) {
+        size_t end = unified.find('/', start);
+        if (end == std::string::npos) {
+            end = unified.size();
+        }
+        std::string part = unified.substr(start, end - start);
+        start = end + 1;
+
+        if (part.empty() || part == ".") {
+            continue;
+        }
+        if (part == "..") {
+            if (!parts.empty() && parts.back() != "..") {
+                parts.pop_back();
+            } else if (!absolute) {
+                parts.push_back(part);
+            }
+            continue;
+        }
+        parts.push_back(part);
+    }
+
+    std::string result = absolute ? "/" : "";
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (i > 0) {
+            result += '/';
+        }
+        result += parts[i];
+    }
+    if (result.empty() && !path.empty()) {
+        result = ".";
+    }
+    return result;
+}
+
+std::string AssetManager::GetSetting(const std::string& settings, const std::string& name) {
+    size_t start = 0;
+    while (start < settings.size()) {
+        size_t end = settings.find(';', start);
+        if (end == std::string::npos) {
+            end = settings.size();
+        }
+        size_t equals = settings.find('=', start);
+        if (equals != std::string::npos && equals < end && settings.compare(start, equals - start, name) == 0) {
+            return settings.substr(equals + 1, end - equals - 1);
+        }
+        start = end + 1;
+    }
+    return "";
+}
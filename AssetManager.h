@@ -0,0 +1,341 @@
+#ifndef ASSET_MANAGER_H
+#define ASSET_MANAGER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+class Texture;
+class AudioClip;
+class ShaderProgram;
+class MeshAsset;
+
+namespace Animation {
+class Animation;
+}
+
+// How an asset type is loaded, reloaded and unloaded. Specialized for each
+// type the AssetManager handles; Load returns nullptr on failure. Reload is
+// optional: it loads the file again into the existing object, so pointers
+// to it stay valid, and leaves the object as it was if that fails.
+//
+//     template <>
+//     struct AssetLoader<Font> {
+//         static Font* Load(const std::string& path, const std::string& settings);
+//         static bool Reload(Font* font, const std::string& path, const std::string& settings);
+//         static void Unload(Font* font);
+//     };
+template <typename T>
+struct AssetLoader;
+
+template <>
+struct AssetLoader<Texture> {
+    static Texture* Load(const std::string& path, const std::string& settings);
+    static bool Reload(Texture* texture, const std::string& path, const std::string& settings);
+    static void Unload(Texture* texture);
+};
+
+template <>
+struct AssetLoader<AudioClip> {
+    static AudioClip* Load(const std::string& path, const std::string& settings);
+    static bool Reload(AudioClip* clip, const std::string& path, const std::string& settings);
+    static void Unload(AudioClip* clip);
+};
+
+// path is the vertex shader; settings hold "fragment" and "geometry"
+template <>
+struct AssetLoader<ShaderProgram> {
+    static ShaderProgram* Load(const std::string& path, const std::string& settings);
+    static bool Reload(ShaderProgram* program, const std::string& path, const std::string& settings);
+    static void Unload(ShaderProgram* program);
+};
+
+template <>
+struct AssetLoader<MeshAsset> {
+    static MeshAsset* Load(const std::string& path, const std::string& settings);
+    static bool Reload(MeshAsset* mesh, const std::string& path, const std::string& settings);
+    static void Unload(MeshAsset* mesh);
+};
+
+template <>
+struct AssetLoader<Animation::Animation> {
+    static Animation::Animation* Load(const std::string& path, const std::string& settings);
+    static bool Reload(Animation::Animation* animation, const std::string& path, const std::string& settings);
+    static void Unload(Animation::Animation* animation);
+};
+
+// One loaded (or loading) asset. Owned by the AssetManager.
+struct AssetEntry {
+    enum State {
+        LOADING,
+        READY,
+        FAILED
+    };
+
+    std::string key;
+    std::string path;
+    std::string settings;
+    void* asset = nullptr;
+    void (*unload)(void*) = nullptr;
+    bool (*reload)(void*, const std::string&, const std::string&) = nullptr;    // nullptr if not reloadable
+    size_t refCount = 0;     // guarded by the manager's mutex
+    State state = LOADING;
+    std::atomic<unsigned int> version{0};    // times reloaded
+};
+
+// Counted reference to an asset. Copies share the asset; when the last
+// handle to it is destroyed or reset, the asset is unloaded.
+template <typename T>
+class AssetHandle {
+public:
+    AssetHandle() : entry(nullptr) {}
+    AssetHandle(const AssetHandle& other);
+    AssetHandle(AssetHandle&& other) : entry(other.entry) { other.entry = nullptr; }
+    ~AssetHandle() { Reset(); }
+
+    AssetHandle& operator=(const AssetHandle& other);
+    AssetHandle& operator=(AssetHandle&& other);
+
+    // Drop this reference
+    void Reset();
+
+    T* Get() const { return entry ? static_cast<T*>(entry->asset) : nullptr; }
+    T* operator->() const { return Get(); }
+    T& operator*() const { return *Get(); }
+    explicit operator bool() const { return Get() != nullptr; }
+
+    // Normalized path the asset was loaded from, empty for an empty handle
+    const std::string& GetPath() const;
+
+    // Times the asset was reloaded; compare to notice a reload
+    unsigned int GetVersion() const { return entry ? entry->version.load() : 0; }
+
+    bool operator==(const AssetHandle& other) const { return entry == other.entry; }
+    bool operator!=(const AssetHandle& other) const { return entry != other.entry; }
+
+private:
+    friend class AssetManager;
+
+    // Takes over a reference already counted by the manager
+    explicit AssetHandle(AssetEntry* adopted) : entry(adopted) {}
+
+    AssetEntry* entry;
+};
+
+// Central cache for everything loaded from disk.
+//
+// Assets are keyed by type, normalized path and import settings, so every
+// request for the same file with the same settings shares one copy. A
+// request for an asset another thread is still loading waits for that load
+// instead of starting its own. Assets are reference counted through their
+// handles and unloaded as soon as the last handle goes away.
+//
+//     AssetHandle<Texture> bark = AssetManager::GetInstance().LoadTexture("Textures/bark.png");
+//     AssetHandle<Texture> same = AssetManager::GetInstance().LoadTexture("./Textures//bark.png");
+//     // bark == same, the file was read once
+//
+// Loaders run on the thread that requested the asset, and unloading runs
+// on the thread that releases the last handle. Assets that own graphics
+// objects (textures, shader programs, mesh buffers) must therefore be
+// loaded, reloaded and released on the main thread.
+class AssetManager {
+public:
+    static AssetManager& GetInstance();
+
+    // Load an asset, or share the copy that is already loaded
+    template <typename T>
+    AssetHandle<T> Load(const std::string& path, const std::string& settings = "");
+
+    AssetHandle<Texture> LoadTexture(const std::string& path, const std::string& settings = "") {
+        return Load<Texture>(path, settings);
+    }
+    AssetHandle<MeshAsset> LoadMesh(const std::string& path, const std::string& settings = "") {
+        return Load<MeshAsset>(path, settings);
+    }
+    AssetHandle<AudioClip> LoadAudioClip(const std::string& path) {
+        return Load<AudioClip>(path);
+    }
+    // keywords: comma-separated shader keywords to enable ("NORMAL_MAP,FOG")
+    AssetHandle<ShaderProgram> LoadShaderProgram(const std::string& vertexPath, const std::string& fragmentPath,
+                                                 const std::string& geometryPath = "",
+                                                 const std::string& keywords = "") {
+        std::string settings = "fragment=" + NormalizePath(fragmentPath);
+        if (!geometryPath.empty()) {
+            settings += ";geometry=" + NormalizePath(geometryPath);
+        }
+        if (!keywords.empty()) {
+            settings += ";keywords=" + keywords;
+        }
+        return Load<ShaderProgram>(vertexPath, settings);
+    }
+
+    // Share an asset that is already loaded; empty if it is not loaded yet
+    template <typename T>
+    AssetHandle<T> Find(const std::string& path, const std::string& settings = "");
+
+    // Take over an asset loaded outside the manager (by the AssetStreamer).
+    // If the same asset was loaded meanwhile, the new copy is unloaded and
+    // the loaded one shared instead.
+    template <typename T>
+    AssetHandle<T> Adopt(const std::string& path, const std::string& settings, T* asset);
+
+    // Cache key of an asset: its type, normalized path and settings
+    template <typename T>
+    static std::string GetKey(const std::string& path, const std::string& settings = "") {
+        return MakeKey(typeid(T*), NormalizePath(path), settings);
+    }
+
+    // Load every asset read from a file again, in place, so every handle
+    // sees the new version. Also reloads assets naming the file in their
+    // settings, such as shader programs using it as their fragment stage.
+    // Returns the number of assets reloaded; those that fail to reload
+    // keep their previous version.
+    size_t Reload(const std::string& path);
+
+    // Number of handles to an asset, 0 if it is not loaded
+    template <typename T>
+    size_t GetRefCount(const std::string& path, const std::string& settings = "") const;
+
+    // Assets currently loaded or loading
+    size_t GetLoadedCount() const;
+
+    // Loader calls made so far (requests served from the cache do not count)
+    size_t GetLoadCallCount() const { return loadCalls; }
+
+    // Forward slashes, no "." or empty components, ".." folded where possible
+    static std::string NormalizePath(const std::string& path);
+
+    // Value of "name" in "name=value;other=value" import settings
+    static std::string GetSetting(const std::string& settings, const std::string& name);
+
+    // Called by AssetHandle
+    void AddRef(AssetEntry* entry);
+    void Release(AssetEntry* entry);
+
+private:
+    typedef bool (*ReloadFunction)(void*, const std::string&, const std::string&);
+
+    AssetManager() : loadCalls(0) {}
+    AssetManager(const AssetManager&);
+    AssetManager& operator=(const AssetManager&);
+
+    mutable std::mutex mutex;
+    std::condition_variable loadFinished;
+    std::unordered_map<std::string, AssetEntry*> entries;
+    std::atomic<size_t> loadCalls;
+
+    static std::string MakeKey(const std::type_info& type, const std::string& path, const std::string& settings);
+
+    // Find or start loading an asset; returns a counted entry, or nullptr
+    // if the load failed
+    AssetEntry* Acquire(const std::type_info& type, const std::string& path, const std::string& settings,
+                        void* (*load)(const std::string&, const std::string&), void (*unload)(void*),
+                        ReloadFunction reload);
+
+    // Counted entry of a loaded asset, or nullptr
+    AssetEntry* Find(const std::type_info& type, const std::string& path, const std::string& settings);
+
+    // Add a loaded asset, or share the entry already holding it
+    AssetEntry* Insert(const std::type_info& type, const std::string& path, const std::string& settings,
+                       void* asset, void (*unload)(void*), ReloadFunction reload);
+
+    size_t GetRefCount(const std::type_info& type, const std::string& path, const std::string& settings) const;
+
+    // Whether an asset was loaded from a file or names it in its settings
+    static bool UsesFile(const AssetEntry& entry, const std::string& path);
+
+    template <typename T>
+    static void* LoadAsset(const std::string& path, const std::string& settings) {
+        return AssetLoader<T>::Load(path, settings);
+    }
+
+    template <typename T>
+    static void UnloadAsset(void* asset) {
+        AssetLoader<T>::Unload(static_cast<T*>(asset));
+    }
+
+    template <typename T>
+    static bool ReloadAsset(void* asset, const std::string& path, const std::string& settings) {
+        return AssetLoader<T>::Reload(static_cast<T*>(asset), path, settings);
+    }
+
+    // ReloadAsset<T>, or nullptr for loaders without a Reload
+    template <typename T>
+    static auto GetReloader(int) -> decltype(&AssetLoader<T>::Reload, ReloadFunction()) {
+        return &ReloadAsset<T>;
+    }
+    template <typename T>
+    static ReloadFunction GetReloader(...) {
+        return nullptr;
+    }
+};
+
+template <typename T>
+AssetHandle<T> AssetManager::Load(const std::string& path, const std::string& settings) {
+    return AssetHandle<T>(Acquire(typeid(T*), path, settings, &LoadAsset<T>, &UnloadAsset<T>, GetReloader<T>(0)));
+}
+
+template <typename T>
+AssetHandle<T> AssetManager::Find(const std::string& path, const std::string& settings) {
+    return AssetHandle<T>(Find(typeid(T*), path, settings));
+}
+
+template <typename T>
+AssetHandle<T> AssetManager::Adopt(const std::string& path, const std::string& settings, T* asset) {
+    return AssetHandle<T>(Insert(typeid(T*), path, settings, asset, &UnloadAsset<T>, GetReloader<T>(0)));
+}
+
+template <typename T>
+size_t AssetManager::GetRefCount(const std::string& path, const std::string& settings) const {
+    return GetRefCount(typeid(T*), path, settings);
+}
+
+template <typename T>
+AssetHandle<T>::AssetHandle(const AssetHandle& other) : entry(other.entry) {
+    if (entry) {
+        AssetManager::GetInstance().AddRef(entry);
+    }
+}
+
+template <typename T>
+AssetHandle<T>& AssetHandle<T>::operator=(const AssetHandle& other) {
+    if (entry != other.entry) {
+        if (other.entry) {
+            AssetManager::GetInstance().AddRef(other.entry);
+        }
+        Reset();
+        entry = other.entry;
+    }
+    return *this;
+}
+
+template <typename T>
+AssetHandle<T>& AssetHandle<T>::operator=(AssetHandle&& other) {
+    if (this != &other) {
+        Reset();
+        entry = other.entry;
+        other.entry = nullptr;
+    }
+    return *this;
+}
+
+template <typename T>
+void AssetHandle<T>::Reset() {
+    if (entry) {
+        AssetEntry* released = entry;
+        entry = nullptr;
+        AssetManager::GetInstance().Release(released);
+    }
+}
+
+template <typename T>
+const std::string& AssetHandle<T>::GetPath() const {
+    static const std::string empty;
+    return entry ? entry->path : empty;
+}
+
+#endif // ASSET_MANAGER_H
@@ -0,0 +1,388 @@
+#include "AssetStreamer.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <exception>
+#include <limits>
+
+// Initialize static instance
+AssetStreamer* AssetStreamer::instance = nullptr;
+
+AssetRequestBase::AssetRequestBase(const std::string& path, float priority)
+    : path(path), status(Status::QUEUED), priority(priority) {
+}
+
+bool AssetRequestBase::IsDone() const {
+    Status current = GetStatus();
+    return current == Status::DONE || current == Status::FAILED || current == Status::CANCELLED;
+}
+
+void AssetRequestBase::SetPriority(float newPriority) {
+    AssetStreamer::GetInstance().SetPriority(this, newPriority);
+}
+
+float AssetRequestBase::GetPriority() const {
+    return AssetStreamer::GetInstance().GetPriority(this);
+}
+
+void AssetRequestBase::Cancel() {
+    AssetStreamer::GetInstance().Cancel(this);
+}
+
+AssetStreamer::AssetStreamer()
+    : stopping(false), nextSequence(0), bytesInFlight(0), decodesRunning(0),
+      uploadBudget(8 * 1024 * 1024), readAheadLimit(256 * 1024 * 1024) {
+}
+
+AssetStreamer::~AssetStreamer() {
+    Shutdown();
+}
+
+AssetStreamer& AssetStreamer::GetInstance() {
+    if (!instance) {
+        instance = new AssetStreamer();
+    }
+    return *instance;
+}
+
+bool AssetStreamer::ReadFile(const std::string& path, std::vector<unsigned char>& bytes) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open asset file: " << path << std::endl;
+        return false;
+    }
+
+    std::streamoff size = file.tellg();
+    if (size < 0) {
+        return false;
+    }
+    bytes.resize(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    if (size > 0 && !file.read(reinterpret_cast<char*>(&bytes[0]), size)) {
+        std::cerr << "Failed to read asset file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void AssetStreamer::Enqueue(const std::string& key, const std::string& path, const std::string& settings,
+                            const std::shared_ptr<AssetRequestBase>& request,
+                            const std::function<AssetStreamJob*()>& createJob) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::shared_ptr<AssetStreamJob> job;
+        auto it = jobs.find(key);
+        if (it != jobs.end()) {
+            // Already on its way; share the load
+            job = it->second;
+        } else {
+            job.reset(createJob());
+            job->key = key;
+            job->path = path;
+            job->settings = settings;
+            job->sequence = nextSequence++;
+            job->priority = -std::numeric_limits<float>::infinity();
+            jobs[key] = job;
+        }
+
+        request->job = job;
+        request->status = job->stage == AssetStreamJob::Stage::READ ? AssetRequestBase::Status::QUEUED
+                                                                     : AssetRequestBase::Status::LOADING;
+        job->requests.push_back(request);
+
+        float previous = job->priority;
+        UpdateJobPriority(*job);
+        if (job->stage == AssetStreamJob::Stage::READ && job->priority != previous) {
+            ReadEntry entry = { job->priority, job->sequence, job };
+            readQueue.push(entry);
+        }
+
+        if (!ioThread.joinable()) {
+            ioThread = std::thread(&AssetStreamer::IOLoop, this);
+        }
+    }
+    readAvailable.notify_one();
+}
+
+void AssetStreamer::UpdateJobPriority(AssetStreamJob& job) {
+    float highest = -std::numeric_limits<float>::infinity();
+    for (const std::shared_ptr<AssetRequestBase>& request : job.requests) {
+        highest = std::max(highest, request->priority);
+    }
+    job.priority = highest;
+}
+
+void AssetStreamer::IOLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        readAvailable.wait(lock, [this]() {
+            return stopping || (!readQueue.empty() && bytesInFlight < readAheadLimit);
+        });
+        if (stopping) {
+            return;
+        }
+
+        ReadEntry entry = readQueue.top();
+        readQueue.pop();
+        std::shared_ptr<AssetStreamJob> job = entry.job;
+        if (job->cancelled || job->stage != AssetStreamJob::Stage::READ || entry.priority != job->priority) {
+            continue;
+        }
+
+        job->stage = AssetStreamJob::Stage::DECODE;
+        for (const std::shared_ptr<AssetRequestBase>& request : job->requests) {
+            request->status = AssetRequestBase::Status::LOADING;
+        }
+
+        lock.unlock();
+        bool ok = false;
+        try {
+            ok = job->Read();
+        } catch (const std::exception& e) {
+            std::cerr << "Error: Exception while reading asset " << job->path << ": " << e.what() << std::endl;
+        }
+        lock.lock();
+
+        if (job->cancelled) {
+            continue;
+        }
+        if (!ok) {
+            // Reported on the main thread
+            job->failed = true;
+            job->stage = AssetStreamJob::Stage::UPLOAD;
+            uploadQueue.push_back(job);
+            uploadAvailable.notify_all();
+            continue;
+        }
+
+        bytesInFlight += job->bytes.size();
+        decodesRunning++;
+        JobSystem::GetInstance().Submit([this, job]() { DecodeJob(job); });
+    }
+}
+
+void AssetStreamer::DecodeJob(const std::shared_ptr<AssetStreamJob>& job) {
+    bool ok = false;
+    try {
+        ok = job->Decode();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Exception while decoding asset " << job->path << ": " << e.what() << std::endl;
+    }
+
+    size_t readSize = job->bytes.size();
+    std::vector<unsigned char>().swap(job->bytes);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        bytesInFlight -= readSize;
+        decodesRunning--;
+        if (!job->cancelled) {
+            job->failed = !ok;
+            job->stage = AssetStreamJob::Stage::UPLOAD;
+            uploadQueue.push_back(job);
+        }
+    }
+    readAvailable.notify_one();
+    uploadAvailable.notify_all();
+}
+
+void AssetStreamer::Update() {
+    UploadJobs(uploadBudget);
+}
+
+void AssetStreamer::UploadJobs(size_t budget) {
+    std::vector<std::shared_ptr<AssetStreamJob>> uploads;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (uploadQueue.empty()) {
+            return;
+        }
+
+        std::sort(uploadQueue.begin(), uploadQueue.end(),
+                  [](const std::shared_ptr<AssetStreamJob>& a, const std::shared_ptr<AssetStreamJob>& b) {
+                      if (a->priority != b->priority) {
+                          return a->priority > b->priority;
+                      }
+                      return a->sequence < b->sequence;
+                  });
+
+        // Failures cost nothing; the first upload always goes through
+        size_t spent = 0;
+        size_t taken = 0;
+        while (taken < uploadQueue.size()) {
+            const AssetStreamJob& job = *uploadQueue[taken];
+            if (!job.failed && !job.cancelled) {
+                if (spent > 0 && spent + job.uploadSize > budget) {
+                    break;
+                }
+                spent += job.uploadSize;
+            }
+            taken++;
+        }
+        uploads.assign(uploadQueue.begin(), uploadQueue.begin() + taken);
+        uploadQueue.erase(uploadQueue.begin(), uploadQueue.begin() + taken);
+    }
+
+    for (const std::shared_ptr<AssetStreamJob>& job : uploads) {
+        if (job->cancelled) {
+            continue;
+        }
+
+        bool ok = false;
+        if (!job->failed) {
+            try {
+                ok = job->Upload();
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Exception while uploading asset " << job->path << ": " << e.what() << std::endl;
+            }
+        }
+        if (!ok) {
+            std::cerr << "Error: Failed to load asset: " << job->path << std::endl;
+        }
+
+        std::vector<std::shared_ptr<AssetRequestBase>> finished;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job->stage = AssetStreamJob::Stage::FINISHED;
+            finished.swap(job->requests);
+            for (const std::shared_ptr<AssetRequestBase>& request : finished) {
+                request->job.reset();
+            }
+            auto it = jobs.find(job->key);
+            if (it != jobs.end() && it->second == job) {
+                jobs.erase(it);
+            }
+        }
+
+        // Callbacks run without the lock so they can queue more loads
+        job->Finish(finished, ok);
+    }
+}
+
+void AssetStreamer::Flush() {
+    while (true) {
+        UploadJobs(std::numeric_limits<size_t>::max());
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (jobs.empty()) {
+            return;
+        }
+        uploadAvailable.wait(lock, [this]() { return !uploadQueue.empty() || jobs.empty(); });
+    }
+}
+
+void AssetStreamer::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ioThread.joinable()) {
+            return;
+        }
+        stopping = true;
+    }
+    readAvailable.notify_all();
+    ioThread.join();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        uploadAvailable.wait(lock, [this]() { return decodesRunning == 0; });
+
+        // Everything not yet finished fails
+        for (auto& pair : jobs) {
+            AssetStreamJob& job = *pair.second;
+            job.failed = true;
+            if (job.stage != AssetStreamJob::Stage::UPLOAD) {
+                job.stage = AssetStreamJob::Stage::UPLOAD;
+                uploadQueue.push_back(pair.second);
+            }
+        }
+        readQueue = std::priority_queue<ReadEntry>();
+        stopping = false;
+    }
+
+    UploadJobs(std::numeric_limits<size_t>::max());
+}
+
+void AssetStreamer::SetUploadBudget(size_t bytesPerFrame) {
+    std::lock_guard<std::mutex> lock(mutex);
+    uploadBudget = bytesPerFrame;
+}
+
+size_t AssetStreamer::GetUploadBudget() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return uploadBudget;
+}
+
+void AssetStreamer::SetReadAheadLimit(size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        readAheadLimit = bytes;
+    }
+    readAvailable.notify_one();
+}
+
+size_t AssetStreamer::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs.size();
+}
+
+void AssetStreamer::SetPriority(AssetRequestBase* request, float priority) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        request->priority = priority;
+
+        std::shared_ptr<AssetStreamJob> job = request->job;
+        if (!job) {
+            return;
+        }
+        float previous = job->priority;
+        UpdateJobPriority(*job);
+        if (job->stage == AssetStreamJob::Stage::READ && job->priority != previous) {
+            ReadEntry entry = { job->priority, job->sequence, job };
+            readQueue.push(entry);
+        }
+    }
+    readAvailable.notify_one();
+}
+
+float AssetStreamer::GetPriority(const AssetRequestBase* request) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return request->priority;
+}
+
+void AssetStreamer::Cancel(AssetRequestBase* request) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (request->IsDone()) {
+        return;
+    }
+    request->status = AssetRequestBase::Status::CANCELLED;
+
+    std::shared_ptr<AssetStreamJob> job = request->job;
+    request->job.reset();
+    if (!job) {
+        return;
+    }
+
+    auto it = std::find_if(job->requests.begin(), job->requests.end(),
+                           [request](const std::shared_ptr<AssetRequestBase>& other) { return other.get() == request; });
+    if (it != job->requests.end()) {
+        job->requests.erase(it);
+    }
+
+    if (!job->requests.empty()) {
+        UpdateJobPriority(*job);
+        if (job->stage == AssetStreamJob::Stage::READ) {
+            ReadEntry entry = { job->priority, job->sequence, job };
+            readQueue.push(entry);
+        }
+        return;
+    }
+
+    // Nobody wants it any more; stages drop cancelled jobs as they reach them
+    job->cancelled = true;
+    auto found = jobs.find(job->key);
+    if (found != jobs.end() && found->second == job) {
+        jobs.erase(found);
+    }
+}
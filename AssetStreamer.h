@@ -0,0 +1,335 @@
+#ifndef ASSET_STREAMER_H
+#define ASSET_STREAMER_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <atomic>
+#include <unordered_map>
+#include <queue>
+#include <cstddef>
+#include "AssetManager.h"
+
+// How an asset type is loaded by the AssetStreamer, in three stages:
+//
+//     Read    I/O thread       file -> bytes
+//     Decode  JobSystem worker bytes -> asset, no graphics calls
+//     Upload  main thread      finish the asset (create graphics objects)
+//
+// Specialized next to each streamable type. Finished assets are handed to
+// the AssetManager and unloaded through AssetLoader<T>.
+//
+//     template <>
+//     struct AssetStreamLoader<Font> {
+//         static bool Read(const std::string& path, const std::string& settings, std::vector<unsigned char>& bytes);
+//         static Font* Decode(const std::string& path, const std::string& settings,
+//                             const std::vector<unsigned char>& bytes);
+//         static size_t GetUploadSize(const Font& font);
+//         static bool Upload(Font& font);
+//     };
+template <typename T>
+struct AssetStreamLoader;
+
+class AssetStreamer;
+class AssetStreamJob;
+
+// Type independent part of an AssetRequest
+class AssetRequestBase {
+public:
+    enum class Status {
+        QUEUED,     // waiting for the I/O thread
+        LOADING,    // being read, decoded or uploaded
+        DONE,
+        FAILED,
+        CANCELLED
+    };
+
+    virtual ~AssetRequestBase() {}
+
+    // Normalized path of the requested asset
+    const std::string& GetPath() const { return path; }
+    Status GetStatus() const { return status.load(); }
+    bool IsDone() const;
+    bool Succeeded() const { return GetStatus() == Status::DONE; }
+
+    // Higher priorities are read and uploaded first. Use e.g. the negative
+    // distance to the camera, and update it as the camera moves.
+    void SetPriority(float priority);
+    float GetPriority() const;
+
+    // Stop waiting for the asset; its completion callback is not called.
+    // The load itself stops once no request wants it any more.
+    void Cancel();
+
+protected:
+    AssetRequestBase(const std::string& path, float priority);
+
+    void SetStatus(Status result) { status = result; }
+
+private:
+    friend class AssetStreamer;
+
+    std::string path;
+    std::atomic<Status> status;
+
+    // Guarded by the streamer's mutex
+    float priority;
+    std::shared_ptr<AssetStreamJob> job;
+};
+
+// Handle to an asset being loaded by AssetStreamer::LoadAsync
+//
+//     auto request = AssetStreamer::GetInstance().LoadAsync<Texture>("Textures/bark.png", -distance);
+//     request->OnComplete([](AssetRequest<Texture>& done) { ... done.GetHandle() ... });
+template <typename T>
+class AssetRequest : public AssetRequestBase {
+public:
+    typedef std::function<void(AssetRequest<T>&)> CompletionCallback;
+
+    // The asset once the request is done, an empty handle before that or
+    // if the load failed. Main thread only.
+    const AssetHandle<T>& GetHandle() const { return handle; }
+    T* Get() const { return handle.Get(); }
+
+    // Called on the main thread once the load is done or has failed, or
+    // immediately if that has already happened. Not called when cancelled.
+    void OnComplete(CompletionCallback completion) {
+        Status current = GetStatus();
+        if (current == Status::DONE || current == Status::FAILED) {
+            completion(*this);
+        } else if (current != Status::CANCELLED) {
+            callback = completion;
+        }
+    }
+
+private:
+    friend class AssetStreamer;
+    template <typename U>
+    friend class TypedAssetStreamJob;
+
+    AssetRequest(const std::string& path, float priority) : AssetRequestBase(path, priority) {}
+
+    AssetHandle<T> handle;
+    CompletionCallback callback;
+
+    // Main thread
+    void Finish(Status result, const AssetHandle<T>& asset);
+};
+
+// One asset moving through the stages, shared by every request for it.
+// Used by the AssetStreamer only.
+class AssetStreamJob {
+public:
+    enum class Stage {
+        READ,
+        DECODE,
+        UPLOAD,
+        FINISHED
+    };
+
+    std::string key;
+    std::string path;
+    std::string settings;
+
+    // Guarded by the streamer's mutex
+    float priority = 0.0f;              // highest priority of the requests
+    unsigned long long sequence = 0;    // queue order among equal priorities
+    Stage stage = Stage::READ;
+    bool cancelled = false;
+    bool failed = false;
+    std::vector<std::shared_ptr<AssetRequestBase>> requests;
+
+    // Owned by whichever stage is running
+    std::vector<unsigned char> bytes;
+    size_t uploadSize = 0;
+
+    virtual ~AssetStreamJob() {}
+
+    virtual bool Read() = 0;
+    virtual bool Decode() = 0;
+    virtual bool Upload() = 0;
+
+    // Hand the result to the requests; main thread
+    virtual void Finish(const std::vector<std::shared_ptr<AssetRequestBase>>& finished, bool ok) = 0;
+};
+
+template <typename T>
+class TypedAssetStreamJob : public AssetStreamJob {
+public:
+    ~TypedAssetStreamJob() {
+        // Decoded but never uploaded (cancelled or failed)
+        if (asset) {
+            AssetLoader<T>::Unload(asset);
+        }
+    }
+
+    bool Read() override { return AssetStreamLoader<T>::Read(path, settings, bytes); }
+
+    bool Decode() override {
+        asset = AssetStreamLoader<T>::Decode(path, settings, bytes);
+        if (!asset) {
+            return false;
+        }
+        uploadSize = AssetStreamLoader<T>::GetUploadSize(*asset);
+        return true;
+    }
+
+    bool Upload() override {
+        if (!AssetStreamLoader<T>::Upload(*asset)) {
+            return false;
+        }
+        handle = AssetManager::GetInstance().Adopt<T>(path, settings, asset);
+        asset = nullptr;
+        return static_cast<bool>(handle);
+    }
+
+    void Finish(const std::vector<std::shared_ptr<AssetRequestBase>>& finished, bool ok) override {
+        for (const std::shared_ptr<AssetRequestBase>& request : finished) {
+            static_cast<AssetRequest<T>&>(*request).Finish(ok ? AssetRequestBase::Status::DONE
+                                                              : AssetRequestBase::Status::FAILED, handle);
+        }
+        handle.Reset();
+    }
+
+private:
+    T* asset = nullptr;
+    AssetHandle<T> handle;
+};
+
+// Loads assets in the background, nearest (highest priority) first.
+//
+// A dedicated I/O thread reads files in priority order, JobSystem workers
+// decode them (image decoding, mesh parsing, ...), and Update uploads the
+// results on the main thread, at most a budget of bytes per frame so
+// streaming never stalls a frame for long. Finished assets go into the
+// AssetManager, so requests for an asset that is already loaded complete
+// at once and several requests for the same asset share one load.
+//
+//     auto rock = AssetStreamer::GetInstance().LoadAsync<MeshAsset>("Models/rock.obj", -distance);
+//     ...
+//     AssetStreamer::GetInstance().Update();    // once per frame (Scene::Update does this)
+//     if (rock->Succeeded()) { ... rock->GetHandle() ... }
+class AssetStreamer {
+public:
+    static AssetStreamer& GetInstance();
+
+    // Queue an asset for loading
+    template <typename T>
+    std::shared_ptr<AssetRequest<T>> LoadAsync(const std::string& path, float priority = 0.0f,
+                                               const std::string& settings = "");
+
+    // Upload decoded assets within the budget and call completion
+    // callbacks. Main thread, once per frame.
+    void Update();
+
+    // Finish every queued load now, blocking until done (loading screens)
+    void Flush();
+
+    // Stop the I/O thread; loads that have not finished fail.
+    // LoadAsync starts it again.
+    void Shutdown();
+
+    // Bytes uploaded per Update. At least one asset is uploaded per call,
+    // however large.
+    void SetUploadBudget(size_t bytesPerFrame);
+    size_t GetUploadBudget() const;
+
+    // The I/O thread waits while this many bytes are read but not decoded
+    void SetReadAheadLimit(size_t bytes);
+
+    // Loads queued or in progress
+    size_t GetPendingCount() const;
+
+    // Read a whole file, for AssetStreamLoader::Read
+    static bool ReadFile(const std::string& path, std::vector<unsigned char>& bytes);
+
+private:
+    friend class AssetRequestBase;
+
+    AssetStreamer();
+    ~AssetStreamer();
+
+    static AssetStreamer* instance;
+
+    // Read queue entry; stale once the job's priority or stage changed
+    struct ReadEntry {
+        float priority;
+        unsigned long long sequence;
+        std::shared_ptr<AssetStreamJob> job;
+
+        bool operator<(const ReadEntry& other) const {
+            if (priority != other.priority) {
+                return priority < other.priority;
+            }
+            return sequence > other.sequence;
+        }
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable readAvailable;
+    std::condition_variable uploadAvailable;
+    std::thread ioThread;
+    bool stopping;
+
+    std::unordered_map<std::string, std::shared_ptr<AssetStreamJob>> jobs;
+    std::priority_queue<ReadEntry> readQueue;
+    std::vector<std::shared_ptr<AssetStreamJob>> uploadQueue;
+    unsigned long long nextSequence;
+    size_t bytesInFlight;
+    size_t decodesRunning;
+    size_t uploadBudget;
+    size_t readAheadLimit;
+
+    // Attach a request to the job loading key, creating the job if needed
+    void Enqueue(const std::string& key, const std::string& path, const std::string& settings,
+                 const std::shared_ptr<AssetRequestBase>& request,
+                 const std::function<AssetStreamJob*()>& createJob);
+
+    void IOLoop();
+    void DecodeJob(const std::shared_ptr<AssetStreamJob>& job);
+    void UploadJobs(size_t budget);
+
+    // Called by AssetRequestBase with the mutex not held
+    void SetPriority(AssetRequestBase* request, float priority);
+    float GetPriority(const AssetRequestBase* request) const;
+    void Cancel(AssetRequestBase* request);
+
+    // Highest priority of a job's requests; mutex held
+    static void UpdateJobPriority(AssetStreamJob& job);
+};
+
+template <typename T>
+void AssetRequest<T>::Finish(Status result, const AssetHandle<T>& asset) {
+    if (GetStatus() == Status::CANCELLED) {
+        return;
+    }
+    handle = asset;
+    SetStatus(result);
+    if (callback) {
+        CompletionCallback completion = callback;
+        callback = nullptr;
+        completion(*this);
+    }
+}
+
+template <typename T>
+std::shared_ptr<AssetRequest<T>> AssetStreamer::LoadAsync(const std::string& path, float priority,
+                                                          const std::string& settings) {
+    std::shared_ptr<AssetRequest<T>> request(new AssetRequest<T>(AssetManager::NormalizePath(path), priority));
+
+    AssetHandle<T> loaded = AssetManager::GetInstance().Find<T>(path, settings);
+    if (loaded) {
+        request->Finish(AssetRequestBase::Status::DONE, loaded);
+        return request;
+    }
+
+    Enqueue(AssetManager::GetKey<T>(path, settings), request->GetPath(), settings, request,
+            []() -> AssetStreamJob* { return new TypedAssetStreamJob<T>(); });
+    return request;
+}
+
+#endif // ASSET_STREAMER_H
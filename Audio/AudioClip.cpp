@@ -1,6 +1,7 @@
 #include "AudioClip.h"
 #include <iostream>
 #include "AudioPlatform.h"
+#include "../AssetManager.h"
 
 AudioClip::AudioClip(const std::string& path) : chunk(nullptr), path(path), loaded(false) {
 }
@@ -29,6 +30,43 @@ bool AudioClip::Load() {
     return true;
 }
 
+bool AudioClip::LoadFromMemory(const void* data, size_t size) {
+    if (loaded) {
+        return true;
+    }
+    
+#if AUDIO_ENABLED
+    chunk = Mix_LoadWAV_RW(SDL_RWFromConstMem(data, static_cast<int>(size)), 1);
+    if (!chunk) {
+        std::cerr << "Failed to decode audio clip: " << path << std::endl;
+        std::cerr << "SDL_mixer Error: " << Mix_GetError() << std::endl;
+        return false;
+    }
+#else
+    (void)data;
+    (void)size;
+#endif
+    
+    loaded = true;
+    return true;
+}
+
+bool AudioClip::Reload() {
+#if AUDIO_ENABLED
+    Mix_Chunk* fresh = Mix_LoadWAV(path.c_str());
+    if (!fresh) {
+        std::cerr << "Failed to reload audio clip: " << path << std::endl;
+        std::cerr << "SDL_mixer Error: " << Mix_GetError() << std::endl;
+        return false;
+    }
+    Unload();
+    chunk = fresh;
+#endif
+    
+    loaded = true;
+    return true;
+}
+
 void AudioClip::Unload() {
 #if AUDIO_ENABLED
     if (chunk) {
@@ -38,3 +76,27 @@ void AudioClip::Unload() {
 #endif
     loaded = false;
 }
+
+AudioClip* AssetLoader<AudioClip>::Load(const std::string& path, const std::string& settings) {
+    (void)settings;
+    AudioClip* clip = new AudioClip(path);
+    
+#if AUDIO_ENABLED
+    if (!clip->Load()) {
+        delete clip;
+        return nullptr;
+    }
+#endif
+    
+    return clip;
+}
+
+bool AssetLoader<AudioClip>::Reload(AudioClip* clip, const std::string& path, const std::string& settings) {
+    (void)path;
+    (void)settings;
+    return clip->Reload();
+}
+
+void AssetLoader<AudioClip>::Unload(AudioClip* clip) {
+    delete clip;
+}
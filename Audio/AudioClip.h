@@ -2,7 +2,10 @@
 #define AUDIO_CLIP_H
 
 #include "AudioPlatform.h"
+#include "../AssetStreamer.h"
 #include <string>
+#include <vector>
+#include <cstddef>
 
 class AudioClip {
 private:
@@ -15,10 +18,49 @@ public:
     ~AudioClip();
     
     bool Load();
+    
+    // Decode a sound file held in memory instead of reading the path
+    bool LoadFromMemory(const void* data, size_t size);
+    
+    // Read the file again; the previous sound stays if that fails. Channels
+    // playing the previous sound stop.
+    bool Reload();
+    
     void Unload();
     Mix_Chunk* GetChunk() const { return chunk; }
     bool IsLoaded() const { return loaded; }
     const std::string& GetPath() const { return path; }
 };
 
+// Sound files are read on the I/O thread and decoded on a worker
+template <>
+struct AssetStreamLoader<AudioClip> {
+    static bool Read(const std::string& path, const std::string& settings, std::vector<unsigned char>& bytes) {
+        (void)settings;
+        return AssetStreamer::ReadFile(path, bytes);
+    }
+    
+    static AudioClip* Decode(const std::string& path, const std::string& settings,
+                             const std::vector<unsigned char>& bytes) {
+        (void)settings;
+        AudioClip* clip = new AudioClip(path);
+        if (!clip->LoadFromMemory(bytes.data(), bytes.size())) {
+            delete clip;
+            return nullptr;
+        }
+        return clip;
+    }
+    
+    // Nothing goes to the GPU
+    static size_t GetUploadSize(const AudioClip& clip) {
+        (void)clip;
+        return 0;
+    }
+    
+    static bool Upload(AudioClip& clip) {
+        (void)clip;
+        return true;
+    }
+};
+
 #endif // AUDIO_CLIP_H
@@ -111,6 +111,10 @@ void AudioSource::SetStopCondition(std::function<bool()> condition) {
     this->stopCondition = condition;
 }
 
+void AudioSource::StopWhen(CoroutineTrigger& trigger) {
+    InvokeWhen(trigger, [this]() { Stop(); });
+}
+
 void AudioSource::Start() {
     // Called when the component is first initialized
     // Nothing to do here for now
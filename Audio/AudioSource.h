@@ -28,6 +28,8 @@ public:
     void SetVolume(float volume); // 0.0 to 1.0
     void SetLoop(bool loop);
     void SetStopCondition(std::function<bool()> condition);
+    // Stop when the trigger fires; unlike SetStopCondition nothing is polled
+    void StopWhen(CoroutineTrigger& trigger);
     
     bool IsPlaying() const { return playing; }
     bool IsLooping() const { return loop; }
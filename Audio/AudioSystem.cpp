@@ -1,6 +1,7 @@
 #include "AudioSystem.h"
 #include "AudioSource.h"
 #include "AudioClip.h"
+#include "../AssetManager.h"
 #include <iostream>
 #include <algorithm>
 
@@ -63,10 +64,11 @@ void AudioSystem::Shutdown() {
     }
     activeSources.clear();
     
-    // Free all cached clips
+    // Free the sample data of clips still in use before the mixer closes
     for (auto& pair : clipCache) {
-        if (pair.second) {
-            pair.second->Unload();
+        std::shared_ptr<AudioClip> clip = pair.second.lock();
+        if (clip) {
+            clip->Unload();
         }
     }
     clipCache.clear();
@@ -110,21 +112,25 @@ std::shared_ptr<AudioClip> AudioSystem::LoadClip(const std::string& path) {
         }
     }
     
-    // Check if clip is already cached
+    // Check if clip is already handed out
     auto it = clipCache.find(path);
     if (it != clipCache.end()) {
-        return it->second;
+        std::shared_ptr<AudioClip> cached = it->second.lock();
+        if (cached) {
+            return cached;
+        }
     }
     
-    // Create new clip
-    auto clip = std::make_shared<AudioClip>(path);
-    
-#if AUDIO_ENABLED
-    if (!clip->Load()) {
+    // Load through the asset manager, which shares clips loaded elsewhere.
+    // The shared_ptr keeps the handle, so the clip is unloaded once the
+    // last user lets go of it.
+    AssetHandle<AudioClip> handle = AssetManager::GetInstance().LoadAudioClip(path);
+    if (!handle) {
         std::cerr << "Failed to load audio clip: " << path << std::endl;
         return nullptr;
     }
-#endif
+    AudioClip* asset = handle.Get();
+    std::shared_ptr<AudioClip> clip(asset, [handle](AudioClip*) mutable { handle.Reset(); });
     
     // Cache clip
     clipCache[path] = clip;
@@ -21,7 +21,8 @@ class AudioSource;
 class AudioSystem {
 private:
     static AudioSystem* instance;
-    std::unordered_map<std::string, std::shared_ptr<AudioClip>> clipCache;
+    // Clips handed out by LoadClip; the AssetManager owns them
+    std::unordered_map<std::string, std::weak_ptr<AudioClip>> clipCache;
     std::vector<AudioSource*> activeSources;
     float masterVolume;
     bool initialized;
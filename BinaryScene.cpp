@@ -0,0 +1,565 @@
+#include "BinaryScene.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+static_assert(sizeof(BinaryScene::Header) == 16, "Header layout changed");
+static_assert(sizeof(BinaryScene::SectionEntry) == 32, "SectionEntry layout changed");
+static_assert(sizeof(BinaryScene::SceneRecord) == 8, "SceneRecord layout changed");
+static_assert(sizeof(BinaryScene::ObjectRecord) == 80, "ObjectRecord layout changed");
+static_assert(sizeof(BinaryScene::LightRecord) == 20, "LightRecord layout changed");
+static_assert(sizeof(BinaryScene::MeshRecord) == 8, "MeshRecord layout changed");
+static_assert(sizeof(BinaryScene::ComponentRecord) == 8, "ComponentRecord layout changed");
+
+namespace {
+    const size_t SECTION_COUNT = 6;
+
+    size_t Align8(size_t value) {
+        return (value + 7) & ~static_cast<size_t>(7);
+    }
+
+    // Deduplicated, null-terminated strings
+    struct StringTable {
+        std::string bytes;
+        std::unordered_map<std::string, uint32_t> lookup;
+
+        uint32_t Add(const std::string& text) {
+            auto it = lookup.find(text);
+            if (it != lookup.end()) {
+                return it->second;
+            }
+            uint32_t offset = static_cast<uint32_t>(bytes.size());
+            bytes.append(text);
+            bytes.push_back('\0');
+            lookup[text] = offset;
+            return offset;
+        }
+    };
+
+    // {"x": .., "y": .., "z": ..} with nothing else
+    bool ReadVector(const nlohmann::json& json, float out[3]) {
+        if (!json.is_object() || json.size() != 3) {
+            return false;
+        }
+        const char* axes[3] = { "x", "y", "z" };
+        for (int i = 0; i < 3; i++) {
+            auto it = json.find(axes[i]);
+            if (it == json.end() || !it->is_number()) {
+                return false;
+            }
+            out[i] = it->get<float>();
+        }
+        return true;
+    }
+
+    float NumberOr(const nlohmann::json& json, const char* key, float fallback) {
+        auto it = json.find(key);
+        return (it != json.end() && it->is_number()) ? it->get<float>() : fallback;
+    }
+
+    std::string StringOr(const nlohmann::json& json, const char* key, const std::string& fallback) {
+        auto it = json.find(key);
+        return (it != json.end() && it->is_string()) ? it->get<std::string>() : fallback;
+    }
+
+    // Shortest decimal form that reads back as the same float, so 0.7 stays 0.7
+    nlohmann::json FloatToJson(float value) {
+        if (value == static_cast<float>(static_cast<long long>(value)) && value > -1e7f && value < 1e7f) {
+            return static_cast<long long>(value);
+        }
+        char buffer[32];
+        for (int precision = 6; precision <= 9; precision++) {
+            std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+            if (static_cast<float>(std::strtod(buffer, nullptr)) == value) {
+                break;
+            }
+        }
+        return std::strtod(buffer, nullptr);
+    }
+
+    nlohmann::json VectorToJson(const float value[3]) {
+        nlohmann::json json;
+        json["x"] = FloatToJson(value[0]);
+        json["y"] = FloatToJson(value[1]);
+        json["z"] = FloatToJson(value[2]);
+        return json;
+    }
+
+    // Vectors the float record cannot give back exactly (doubles, or whole
+    // numbers written as 1.0) are also kept as JSON text, which ToJson prefers
+    void KeepIfInexact(nlohmann::json& extra, const std::string& key, const nlohmann::json& value, const float stored[3]) {
+        if (VectorToJson(stored).dump() != value.dump()) {
+            extra[key] = value;
+        }
+    }
+
+    // Collects the records of a scene document before they are written
+    struct Builder {
+        std::vector<BinaryScene::ObjectRecord> objects;
+        std::vector<BinaryScene::LightRecord> lights;
+        std::vector<BinaryScene::MeshRecord> meshes;
+        std::vector<BinaryScene::ComponentRecord> components;
+        StringTable strings;
+
+        uint32_t AddJson(const nlohmann::json& json) {
+            return json.empty() ? BinaryScene::NO_STRING : strings.Add(json.dump());
+        }
+
+        // Typed records for the components the engine understands
+        void AddEngineComponent(const std::string& type, const nlohmann::json& component, BinaryScene::ObjectRecord& record) {
+            auto properties = component.find("properties");
+            if (properties == component.end() || !properties->is_object()) {
+                return;
+            }
+
+            if (type == "Light" && StringOr(*properties, "type", "point") == "point") {
+                BinaryScene::LightRecord light;
+                auto color = properties->find("color");
+                bool hasColor = color != properties->end() && color->is_object();
+                light.color[0] = hasColor ? NumberOr(*color, "r", 1.0f) : 1.0f;
+                light.color[1] = hasColor ? NumberOr(*color, "g", 1.0f) : 1.0f;
+                light.color[2] = hasColor ? NumberOr(*color, "b", 1.0f) : 1.0f;
+                light.intensity = NumberOr(*properties, "intensity", 1.0f);
+                light.range = NumberOr(*properties, "range", 10.0f);
+                lights.push_back(light);
+                record.lightCount++;
+            } else if (type == "Mesh") {
+                std::string model = StringOr(*properties, "model", std::string());
+                if (model.empty()) {
+                    return;
+                }
+                std::string texture = StringOr(*properties, "texture", std::string());
+                BinaryScene::MeshRecord mesh;
+                mesh.model = strings.Add(model);
+                mesh.texture = texture.empty() ? BinaryScene::NO_STRING : strings.Add(texture);
+                meshes.push_back(mesh);
+                record.meshCount++;
+            }
+        }
+
+        // Components must all be objects with a string type to be stored as records
+        static bool ComponentsAreRecords(const nlohmann::json& json) {
+            if (!json.is_array()) {
+                return false;
+            }
+            for (const auto& component : json) {
+                auto type = component.find("type");
+                if (!component.is_object() || type == component.end() || !type->is_string()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool ChildrenAreObjects(const nlohmann::json& json) {
+            if (!json.is_array()) {
+                return false;
+            }
+            for (const auto& child : json) {
+                if (!child.is_object()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void AddObject(const nlohmann::json& json, int32_t parent) {
+            BinaryScene::ObjectRecord record;
+            std::memset(&record, 0, sizeof(record));
+            record.name = BinaryScene::NO_STRING;
+            record.parent = parent;
+            record.scale[0] = record.scale[1] = record.scale[2] = 1.0f;
+            record.firstComponent = static_cast<uint32_t>(components.size());
+            record.firstLight = static_cast<uint32_t>(lights.size());
+            record.firstMesh = static_cast<uint32_t>(meshes.size());
+
+            nlohmann::json extra = nlohmann::json::object();
+            const nlohmann::json* children = nullptr;
+
+            for (auto it = json.begin(); it != json.end(); ++it) {
+                const std::string& key = it.key();
+                const nlohmann::json& value = it.value();
+
+                if (key == "name" && value.is_string()) {
+                    record.name = strings.Add(value.get<std::string>());
+                } else if (key == "position" && ReadVector(value, record.position)) {
+                    record.flags |= BinaryScene::HAS_POSITION;
+                    KeepIfInexact(extra, key, value, record.position);
+                } else if (key == "rotation" && ReadVector(value, record.rotation)) {
+                    record.flags |= BinaryScene::HAS_ROTATION;
+                    KeepIfInexact(extra, key, value, record.rotation);
+                } else if (key == "scale" && ReadVector(value, record.scale)) {
+                    record.flags |= BinaryScene::HAS_SCALE;
+                    KeepIfInexact(extra, key, value, record.scale);
+                } else if (key == "components" && ComponentsAreRecords(value)) {
+                    record.flags |= BinaryScene::HAS_COMPONENTS;
+                    for (const auto& component : value) {
+                        std::string type = component["type"].get<std::string>();
+                        nlohmann::json data = component;
+                        data.erase("type");
+
+                        BinaryScene::ComponentRecord entry;
+                        entry.type = strings.Add(type);
+                        entry.data = AddJson(data);
+                        components.push_back(entry);
+                        record.componentCount++;
+
+                        AddEngineComponent(type, component, record);
+                    }
+                } else if (key == "children" && ChildrenAreObjects(value)) {
+                    record.flags |= BinaryScene::HAS_CHILDREN;
+                    children = &value;
+                } else {
+                    extra[key] = value;
+                }
+            }
+            record.extra = AddJson(extra);
+
+            int32_t index = static_cast<int32_t>(objects.size());
+            objects.push_back(record);
+
+            if (children) {
+                for (const auto& child : *children) {
+                    AddObject(child, index);
+                }
+            }
+        }
+    };
+
+    void AddSection(std::vector<BinaryScene::SectionEntry>& toc, size_t& cursor, uint32_t type,
+                    uint32_t recordSize, size_t count, size_t size) {
+        BinaryScene::SectionEntry entry;
+        entry.type = type;
+        entry.recordSize = recordSize;
+        entry.offset = cursor;
+        entry.size = size;
+        entry.count = count;
+        toc.push_back(entry);
+        cursor = Align8(cursor + size);
+    }
+
+    void WriteSection(std::ofstream& file, const BinaryScene::SectionEntry& entry, const void* bytes) {
+        static const char padding[8] = { 0 };
+        file.seekp(static_cast<std::streamoff>(entry.offset));
+        if (entry.size > 0) {
+            file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(entry.size));
+        }
+        file.write(padding, static_cast<std::streamsize>(Align8(entry.size) - entry.size));
+    }
+}
+
+BinaryScene::BinaryScene()
+    : data(nullptr), fileSize(0),
+      scene(nullptr), objects(nullptr), objectCount(0), lights(nullptr), lightCount(0),
+      meshes(nullptr), meshCount(0), components(nullptr), componentCount(0),
+      strings(nullptr), stringsSize(0) {
+}
+
+BinaryScene::~BinaryScene() {
+    Close();
+}
+
+bool BinaryScene::Open(const std::string& path) {
+    Close();
+
+    if (!file.Open(path) || !file.GetData()) {
+        std::cerr << "Error: Could not map binary scene file: " << path << std::endl;
+        return false;
+    }
+
+    data = file.GetData();
+    fileSize = file.GetSize();
+    if (!ReadTableOfContents()) {
+        std::cerr << "Error: Invalid binary scene file: " << path << std::endl;
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void BinaryScene::Close() {
+    file.Close();
+    data = nullptr;
+    fileSize = 0;
+    scene = nullptr;
+    objects = nullptr;
+    lights = nullptr;
+    meshes = nullptr;
+    components = nullptr;
+    strings = nullptr;
+    objectCount = lightCount = meshCount = componentCount = stringsSize = 0;
+}
+
+const char* BinaryScene::GetString(uint32_t offset) const {
+    if (offset == NO_STRING || offset >= stringsSize) {
+        return "";
+    }
+    return strings + offset;
+}
+
+bool BinaryScene::ToJson(nlohmann::json& json) const {
+    if (!IsOpen()) {
+        return false;
+    }
+
+    try {
+        json = scene->extra == NO_STRING ? nlohmann::json::object() : nlohmann::json::parse(GetString(scene->extra));
+        if (scene->name != NO_STRING) {
+            json["sceneName"] = GetString(scene->name);
+        }
+
+        std::vector<std::vector<size_t>> children(objectCount);
+        nlohmann::json roots = nlohmann::json::array();
+        for (size_t i = 0; i < objectCount; i++) {
+            if (objects[i].parent != NO_PARENT) {
+                children[objects[i].parent].push_back(i);
+            }
+        }
+        for (size_t i = 0; i < objectCount; i++) {
+            if (objects[i].parent == NO_PARENT) {
+                roots.push_back(ObjectToJson(i, children));
+            }
+        }
+        json["objects"] = roots;
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error converting binary scene to JSON: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+nlohmann::json BinaryScene::ObjectToJson(size_t index, const std::vector<std::vector<size_t>>& children) const {
+    const ObjectRecord& record = objects[index];
+    nlohmann::json json = record.extra == NO_STRING ? nlohmann::json::object() : nlohmann::json::parse(GetString(record.extra));
+
+    if (record.name != NO_STRING) {
+        json["name"] = GetString(record.name);
+    }
+    // The JSON text of a vector, if kept, is the exact one
+    if ((record.flags & HAS_POSITION) && !json.contains("position")) {
+        json["position"] = VectorToJson(record.position);
+    }
+    if ((record.flags & HAS_ROTATION) && !json.contains("rotation")) {
+        json["rotation"] = VectorToJson(record.rotation);
+    }
+    if ((record.flags & HAS_SCALE) && !json.contains("scale")) {
+        json["scale"] = VectorToJson(record.scale);
+    }
+
+    if (record.flags & HAS_COMPONENTS) {
+        nlohmann::json list = nlohmann::json::array();
+        for (uint32_t c = 0; c < record.componentCount; c++) {
+            const ComponentRecord& component = components[record.firstComponent + c];
+            nlohmann::json entry = component.data == NO_STRING ? nlohmann::json::object() : nlohmann::json::parse(GetString(component.data));
+            entry["type"] = GetString(component.type);
+            list.push_back(entry);
+        }
+        json["components"] = list;
+    }
+
+    if (record.flags & HAS_CHILDREN) {
+        nlohmann::json list = nlohmann::json::array();
+        for (size_t child : children[index]) {
+            list.push_back(ObjectToJson(child, children));
+        }
+        json["children"] = list;
+    }
+    return json;
+}
+
+bool BinaryScene::Write(const nlohmann::json& json, const std::string& path) {
+    auto objectsJson = json.find("objects");
+    if (!json.is_object() || objectsJson == json.end() || !objectsJson->is_array()) {
+        std::cerr << "Error: Scene document has no objects array" << std::endl;
+        return false;
+    }
+
+    Builder builder;
+    SceneRecord sceneRecord;
+    sceneRecord.name = NO_STRING;
+
+    nlohmann::json extra = nlohmann::json::object();
+    for (auto it = json.begin(); it != json.end(); ++it) {
+        if (it.key() == "objects") {
+            continue;
+        }
+        if (it.key() == "sceneName" && it.value().is_string()) {
+            sceneRecord.name = builder.strings.Add(it.value().get<std::string>());
+        } else {
+            extra[it.key()] = it.value();
+        }
+    }
+    sceneRecord.extra = builder.AddJson(extra);
+
+    for (const auto& objectJson : *objectsJson) {
+        if (!objectJson.is_object()) {
+            std::cerr << "Error: Scene objects must be JSON objects" << std::endl;
+            return false;
+        }
+        builder.AddObject(objectJson, NO_PARENT);
+    }
+
+    // Lay out the table of contents and sections
+    std::vector<SectionEntry> toc;
+    size_t cursor = Align8(sizeof(Header) + SECTION_COUNT * sizeof(SectionEntry));
+    AddSection(toc, cursor, SECTION_SCENE, sizeof(SceneRecord), 1, sizeof(SceneRecord));
+    AddSection(toc, cursor, SECTION_OBJECTS, sizeof(ObjectRecord), builder.objects.size(),
+               builder.objects.size() * sizeof(ObjectRecord));
+    AddSection(toc, cursor, SECTION_LIGHTS, sizeof(LightRecord), builder.lights.size(),
+               builder.lights.size() * sizeof(LightRecord));
+    AddSection(toc, cursor, SECTION_MESHES, sizeof(MeshRecord), builder.meshes.size(),
+               builder.meshes.size() * sizeof(MeshRecord));
+    AddSection(toc, cursor, SECTION_COMPONENTS, sizeof(ComponentRecord), builder.components.size(),
+               builder.components.size() * sizeof(ComponentRecord));
+    AddSection(toc, cursor, SECTION_STRINGS, 1, builder.strings.bytes.size(), builder.strings.bytes.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file for writing: " << path << std::endl;
+        return false;
+    }
+
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.sectionCount = static_cast<uint32_t>(toc.size());
+    header.reserved = 0;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(toc.data()), static_cast<std::streamsize>(toc.size() * sizeof(SectionEntry)));
+
+    WriteSection(file, toc[0], &sceneRecord);
+    WriteSection(file, toc[1], builder.objects.data());
+    WriteSection(file, toc[2], builder.lights.data());
+    WriteSection(file, toc[3], builder.meshes.data());
+    WriteSection(file, toc[4], builder.components.data());
+    WriteSection(file, toc[5], builder.strings.bytes.data());
+
+    if (!file.good()) {
+        std::cerr << "Error: Failed writing binary scene: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool BinaryScene::IsBinarySceneFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    uint32_t magic = 0;
+    file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    return file.good() && magic == MAGIC;
+}
+
+bool BinaryScene::ConvertJsonToBinary(const std::string& jsonPath, const std::string& binaryPath) {
+    try {
+        std::ifstream file(jsonPath);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open scene file: " << jsonPath << std::endl;
+            return false;
+        }
+        nlohmann::json json;
+        file >> json;
+        return Write(json, binaryPath);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error reading scene " << jsonPath << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool BinaryScene::ConvertBinaryToJson(const std::string& binaryPath, const std::string& jsonPath) {
+    BinaryScene binary;
+    nlohmann::json json;
+    if (!binary.Open(binaryPath) || !binary.ToJson(json)) {
+        return false;
+    }
+
+    std::ofstream file(jsonPath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file for writing: " << jsonPath << std::endl;
+        return false;
+    }
+    file << json.dump(2);
+    return file.good();
+}
+
+bool BinaryScene::ReadTableOfContents() {
+    if (fileSize < sizeof(Header)) {
+        return false;
+    }
+    const Header* header = reinterpret_cast<const Header*>(data);
+    if (header->magic != MAGIC || header->version != VERSION) {
+        return false;
+    }
+    if (header->sectionCount > (fileSize - sizeof(Header)) / sizeof(SectionEntry)) {
+        return false;
+    }
+
+    const SectionEntry* toc = reinterpret_cast<const SectionEntry*>(data + sizeof(Header));
+    for (uint32_t i = 0; i < header->sectionCount; i++) {
+        const SectionEntry& entry = toc[i];
+        if (entry.offset % 8 != 0 || entry.recordSize == 0 || entry.count != entry.size / entry.recordSize ||
+            (entry.size > 0 && (entry.offset > fileSize || entry.size > fileSize - entry.offset))) {
+            return false;
+        }
+        // Empty sections may point past the end of the file
+        const unsigned char* section = entry.size > 0 ? data + entry.offset : nullptr;
+        size_t count = static_cast<size_t>(entry.count);
+
+        // Unknown sections are skipped so newer writers can add data
+        switch (entry.type) {
+            case SECTION_SCENE:
+                if (entry.recordSize != sizeof(SceneRecord) || count != 1) return false;
+                scene = reinterpret_cast<const SceneRecord*>(section);
+                break;
+            case SECTION_OBJECTS:
+                if (entry.recordSize != sizeof(ObjectRecord)) return false;
+                objects = reinterpret_cast<const ObjectRecord*>(section);
+                objectCount = count;
+                break;
+            case SECTION_LIGHTS:
+                if (entry.recordSize != sizeof(LightRecord)) return false;
+                lights = reinterpret_cast<const LightRecord*>(section);
+                lightCount = count;
+                break;
+            case SECTION_MESHES:
+                if (entry.recordSize != sizeof(MeshRecord)) return false;
+                meshes = reinterpret_cast<const MeshRecord*>(section);
+                meshCount = count;
+                break;
+            case SECTION_COMPONENTS:
+                if (entry.recordSize != sizeof(ComponentRecord)) return false;
+                components = reinterpret_cast<const ComponentRecord*>(section);
+                componentCount = count;
+                break;
+            case SECTION_STRINGS:
+                // Must end in a terminator so no string runs off the table
+                if (count > 0 && section[count - 1] != '\0') return false;
+                strings = reinterpret_cast<const char*>(section);
+                stringsSize = count;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (!scene) {
+        return false;
+    }
+
+    // Check every index once here so users can trust the records
+    for (size_t i = 0; i < objectCount; i++) {
+        const ObjectRecord& record = objects[i];
+        if (record.parent != NO_PARENT && (record.parent < 0 || static_cast<size_t>(record.parent) >= i)) {
+            return false;
+        }
+        if (static_cast<size_t>(record.firstComponent) + record.componentCount > componentCount ||
+            static_cast<size_t>(record.firstLight) + record.lightCount > lightCount ||
+            static_cast<size_t>(record.firstMesh) + record.meshCount > meshCount) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,170 @@
+#ifndef BINARY_SCENE_H
+#define BINARY_SCENE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "ThirdParty/json/json.hpp"
+#include "MappedFile.h"
+
+// Binary scene file (.savscene), the compiled form of the JSON scene format
+// in Examples/RPG/Scenes.
+//
+// Layout (little-endian, every section 8-byte aligned):
+//     Header
+//     SectionEntry[header.sectionCount]      table of contents
+//     sections                               fixed-size records
+//
+// The file is memory mapped and the records are used in place;
+// SceneSerializer::LoadSceneFile builds GameObjects straight from them
+// without parsing. Objects are stored in pre-order with a parent index,
+// so children follow their parent.
+// Data the engine does not interpret (gameplay components, unknown keys)
+// is kept as JSON text so that JSON -> binary -> JSON is lossless. So is
+// any position, rotation or scale that a float does not reproduce exactly
+// (doubles, or 1.0 rather than 1); the record then holds it rounded.
+//
+//     BinaryScene::ConvertJsonToBinary("Scenes/cave.json", "Scenes/cave.savscene");
+//     SceneSerializer::LoadSceneFile("Scenes/cave.savscene", objects);
+class BinaryScene {
+public:
+    static const uint32_t MAGIC = 0x53564153;    // "SAVS"
+    static const uint32_t VERSION = 1;
+    static const uint32_t NO_STRING = 0xFFFFFFFFu;
+    static const int32_t NO_PARENT = -1;
+
+    // Section identifiers
+    enum SectionType : uint32_t {
+        SECTION_SCENE = 0x454E4353,       // "SCNE" one SceneRecord
+        SECTION_OBJECTS = 0x534A424F,     // "OBJS" ObjectRecord per object
+        SECTION_LIGHTS = 0x5448474C,      // "LGHT" LightRecord per point light
+        SECTION_MESHES = 0x4853454D,      // "MESH" MeshRecord per mesh reference
+        SECTION_COMPONENTS = 0x504D4F43,  // "COMP" ComponentRecord per component
+        SECTION_STRINGS = 0x53525453      // "STRS" null-terminated strings
+    };
+
+    // ObjectRecord::flags
+    enum ObjectFlags : uint32_t {
+        HAS_POSITION = 1u << 0,
+        HAS_ROTATION = 1u << 1,
+        HAS_SCALE = 1u << 2,
+        HAS_COMPONENTS = 1u << 3,   // "components" present, possibly empty
+        HAS_CHILDREN = 1u << 4      // "children" present, possibly empty
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t sectionCount;
+        uint32_t reserved;
+    };
+
+    struct SectionEntry {
+        uint32_t type;
+        uint32_t recordSize;
+        uint64_t offset;
+        uint64_t size;
+        uint64_t count;
+    };
+
+    struct SceneRecord {
+        uint32_t name;            // string
+        uint32_t extra;           // JSON text of the other top-level keys
+    };
+
+    struct ObjectRecord {
+        uint32_t name;            // string, NO_STRING for the default name
+        int32_t parent;           // object index or NO_PARENT
+        float position[3];
+        float rotation[3];
+        float scale[3];
+        uint32_t flags;
+        uint32_t firstComponent;
+        uint32_t componentCount;
+        uint32_t firstLight;
+        uint32_t lightCount;
+        uint32_t firstMesh;
+        uint32_t meshCount;
+        uint32_t extra;           // JSON text of unrecognised keys
+        uint32_t reserved;
+    };
+
+    struct LightRecord {
+        float color[3];
+        float intensity;
+        float range;
+    };
+
+    struct MeshRecord {
+        uint32_t model;           // string, path of the model file
+        uint32_t texture;         // string, NO_STRING if none
+    };
+
+    struct ComponentRecord {
+        uint32_t type;            // string
+        uint32_t data;            // JSON text of the component without "type"
+    };
+
+    BinaryScene();
+    ~BinaryScene();
+
+    // Map a .savscene file and validate its table of contents
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return data != nullptr; }
+
+    // Direct access to the mapped records. Indices and ranges are
+    // validated by Open.
+    const SceneRecord* GetScene() const { return scene; }
+    const ObjectRecord* GetObjects() const { return objects; }
+    size_t GetObjectCount() const { return objectCount; }
+    const LightRecord* GetLights() const { return lights; }
+    size_t GetLightCount() const { return lightCount; }
+    const MeshRecord* GetMeshes() const { return meshes; }
+    size_t GetMeshCount() const { return meshCount; }
+    const ComponentRecord* GetComponents() const { return components; }
+    size_t GetComponentCount() const { return componentCount; }
+
+    // String by table offset; empty for NO_STRING or a bad offset
+    const char* GetString(uint32_t offset) const;
+
+    // Rebuild the JSON scene document
+    bool ToJson(nlohmann::json& json) const;
+
+    // Write a JSON scene document as a binary scene
+    static bool Write(const nlohmann::json& json, const std::string& path);
+
+    // True if the file starts with the binary scene magic
+    static bool IsBinarySceneFile(const std::string& path);
+
+    // Converters in both directions
+    static bool ConvertJsonToBinary(const std::string& jsonPath, const std::string& binaryPath);
+    static bool ConvertBinaryToJson(const std::string& binaryPath, const std::string& jsonPath);
+
+private:
+    MappedFile file;
+    const unsigned char* data;
+    size_t fileSize;
+
+    const SceneRecord* scene;
+    const ObjectRecord* objects;
+    size_t objectCount;
+    const LightRecord* lights;
+    size_t lightCount;
+    const MeshRecord* meshes;
+    size_t meshCount;
+    const ComponentRecord* components;
+    size_t componentCount;
+    const char* strings;
+    size_t stringsSize;
+
+    // Non-copyable; owns the mapping
+    BinaryScene(const BinaryScene&);
+    BinaryScene& operator=(const BinaryScene&);
+
+    bool ReadTableOfContents();
+    nlohmann::json ObjectToJson(size_t index, const std::vector<std::vector<size_t>>& children) const;
+};
+
+#endif // BINARY_SCENE_H
@@ -0,0 +1,282 @@
+#include "Coroutine.h"
+
+#include <iostream>
+#include <algorithm>
+#include <exception>
+
+#if GAMEENGINE_COROUTINES
+void Coroutine::promise_type::unhandled_exception() {
+    // Keep the game running; the coroutine ends at its final suspend point
+    try {
+        std::rethrow_exception(std::current_exception());
+    } catch (const std::exception& e) {
+        std::cerr << "Coroutine " << id << " threw an exception: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "Coroutine " << id << " threw an unknown exception" << std::endl;
+    }
+}
+
+Coroutine& Coroutine::operator=(Coroutine&& other) noexcept {
+    if (this != &other) {
+        if (handle) {
+            handle.destroy();
+        }
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+Coroutine::~Coroutine() {
+    // A coroutine that was never started still owns its frame
+    if (handle) {
+        handle.destroy();
+    }
+}
+#endif // GAMEENGINE_COROUTINES
+
+void CoroutineTrigger::Fire() {
+    fired = true;
+
+    if (waiters.empty()) {
+        return;
+    }
+
+    CoroutineScheduler& scheduler = CoroutineScheduler::GetInstance();
+    for (CoroutineId id : waiters) {
+        scheduler.QueueResume(id);
+    }
+    waiters.clear();
+}
+
+// Initialize static instance
+CoroutineScheduler* CoroutineScheduler::instance = nullptr;
+
+CoroutineScheduler& CoroutineScheduler::GetInstance() {
+    if (!instance) {
+        instance = new CoroutineScheduler();
+    }
+    return *instance;
+}
+
+#if GAMEENGINE_COROUTINES
+CoroutineId CoroutineScheduler::Start(MonoBehaviourLike* owner, Coroutine routine) {
+    Coroutine::Handle handle = routine.Release();
+    if (!handle) {
+        return 0;
+    }
+
+    Record record;
+    record.handle = handle;
+    record.owner = owner;
+    record.timer = TimerWheel::INVALID_TIMER;
+    CoroutineId id = Add(owner, record);
+    handle.promise().id = id;
+
+    // Run synchronously up to the first co_await, like Unity's StartCoroutine
+    Resume(id);
+    return id;
+}
+#endif // GAMEENGINE_COROUTINES
+
+CoroutineId CoroutineScheduler::InvokeAfter(MonoBehaviourLike* owner, float seconds, Callback callback) {
+    Record record;
+    record.callback = std::move(callback);
+    record.owner = owner;
+    record.timer = TimerWheel::INVALID_TIMER;
+    CoroutineId id = Add(owner, std::move(record));
+
+    ResumeAfter(id, seconds);
+    return id;
+}
+
+CoroutineId CoroutineScheduler::InvokeWhen(MonoBehaviourLike* owner, CoroutineTrigger& trigger, Callback callback) {
+    // Like WaitUntil, an already fired trigger does not wait
+    if (trigger.IsFired()) {
+        callback();
+        return 0;
+    }
+
+    Record record;
+    record.callback = std::move(callback);
+    record.owner = owner;
+    record.timer = TimerWheel::INVALID_TIMER;
+    CoroutineId id = Add(owner, std::move(record));
+
+    ResumeWhen(id, trigger);
+    return id;
+}
+
+CoroutineId CoroutineScheduler::InvokeOnFixedUpdate(MonoBehaviourLike* owner, Callback callback) {
+    Record record;
+    record.callback = std::move(callback);
+    record.owner = owner;
+    record.timer = TimerWheel::INVALID_TIMER;
+    CoroutineId id = Add(owner, std::move(record));
+
+    ResumeOnFixedUpdate(id);
+    return id;
+}
+
+void CoroutineScheduler::Stop(CoroutineId id) {
+    // A coroutine cannot destroy its own frame while it is executing
+    if (id == runningId) {
+        stopRunning = true;
+        return;
+    }
+
+    auto it = routines.find(id);
+    if (it != routines.end()) {
+        Destroy(it);
+    }
+}
+
+void CoroutineScheduler::StopAll(MonoBehaviourLike* owner) {
+    auto ownerIt = routinesByOwner.find(owner);
+    if (ownerIt == routinesByOwner.end()) {
+        return;
+    }
+
+    std::vector<CoroutineId> ids;
+    ids.swap(ownerIt->second);
+    routinesByOwner.erase(ownerIt);
+
+    for (CoroutineId id : ids) {
+        Stop(id);
+    }
+}
+
+void CoroutineScheduler::Update(float deltaTime) {
+    // Expired timers move their coroutine onto the ready queue
+    timers.Advance(deltaTime);
+
+    if (readyQueue.empty()) {
+        return;
+    }
+
+    // Coroutines that suspend again while draining wait for the next frame
+    std::vector<CoroutineId> ready;
+    ready.swap(readyQueue);
+    for (CoroutineId id : ready) {
+        Resume(id);
+    }
+}
+
+void CoroutineScheduler::FixedUpdate() {
+    if (fixedUpdateQueue.empty()) {
+        return;
+    }
+
+    std::vector<CoroutineId> ready;
+    ready.swap(fixedUpdateQueue);
+    for (CoroutineId id : ready) {
+        Resume(id);
+    }
+}
+
+void CoroutineScheduler::Clear() {
+    while (!routines.empty()) {
+        Destroy(routines.begin());
+    }
+    routinesByOwner.clear();
+    readyQueue.clear();
+    fixedUpdateQueue.clear();
+    timers.Clear();
+}
+
+void CoroutineScheduler::ResumeAfter(CoroutineId id, float seconds) {
+    auto it = routines.find(id);
+    if (it == routines.end()) {
+        return;
+    }
+
+    it->second.timer = timers.Schedule(seconds, [this, id]() {
+        auto record = routines.find(id);
+        if (record != routines.end()) {
+            record->second.timer = TimerWheel::INVALID_TIMER;
+            readyQueue.push_back(id);
+        }
+    });
+}
+
+void CoroutineScheduler::ResumeOnFixedUpdate(CoroutineId id) {
+    fixedUpdateQueue.push_back(id);
+}
+
+void CoroutineScheduler::ResumeWhen(CoroutineId id, CoroutineTrigger& trigger) {
+    trigger.waiters.push_back(id);
+}
+
+void CoroutineScheduler::QueueResume(CoroutineId id) {
+    readyQueue.push_back(id);
+}
+
+CoroutineId CoroutineScheduler::Add(MonoBehaviourLike* owner, Record record) {
+    CoroutineId id = nextId++;
+    routines[id] = std::move(record);
+    routinesByOwner[owner].push_back(id);
+    return id;
+}
+
+void CoroutineScheduler::Resume(CoroutineId id) {
+    // Stopped coroutines leave stale ids in queues and trigger lists
+    auto it = routines.find(id);
+    if (it == routines.end()) {
+        return;
+    }
+
+    // Callbacks run once; take them out first so they may schedule more
+    if (it->second.callback) {
+        Callback callback = std::move(it->second.callback);
+        Destroy(it);
+        callback();
+        return;
+    }
+
+#if GAMEENGINE_COROUTINES
+    Coroutine::Handle handle = it->second.handle;
+    CoroutineId previousId = runningId;
+    bool previousStop = stopRunning;
+    runningId = id;
+    stopRunning = false;
+
+    handle.resume();
+
+    bool stopped = stopRunning;
+    runningId = previousId;
+    stopRunning = previousStop;
+
+    // The coroutine may have stopped itself or started others while running
+    if (handle.done() || stopped) {
+        it = routines.find(id);
+        if (it != routines.end()) {
+            Destroy(it);
+        }
+    }
+#endif
+}
+
+void CoroutineScheduler::Destroy(std::unordered_map<CoroutineId, Record>::iterator it) {
+    CoroutineId id = it->first;
+    Record record = std::move(it->second);
+    routines.erase(it);
+
+    if (record.timer != TimerWheel::INVALID_TIMER) {
+        timers.Cancel(record.timer);
+    }
+
+    auto ownerIt = routinesByOwner.find(record.owner);
+    if (ownerIt != routinesByOwner.end()) {
+        std::vector<CoroutineId>& ids = ownerIt->second;
+        ids.erase(std::remove(ids.begin(), ids.end(), id), ids.end());
+        if (ids.empty()) {
+            routinesByOwner.erase(ownerIt);
+        }
+    }
+
+#if GAMEENGINE_COROUTINES
+    if (record.handle) {
+        record.handle.destroy();
+    }
+#endif
+}
@@ -0,0 +1,210 @@
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+// Coroutine-based gameplay scripting
+//
+// Scripts wait on timers, triggers and physics steps without polling. The
+// waits are callbacks in every build; when the compiler has C++20
+// coroutines, Coroutine and the WaitSeconds/WaitUntil/WaitForFixedUpdate
+// awaitables are built on top of them.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define GAMEENGINE_COROUTINES 1
+#else
+#define GAMEENGINE_COROUTINES 0
+#endif
+
+#include <functional>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include "TimerWheel.h"
+
+#if GAMEENGINE_COROUTINES
+#include <coroutine>
+#endif
+
+class MonoBehaviourLike;
+
+typedef unsigned long long CoroutineId;
+
+#if GAMEENGINE_COROUTINES
+// Return type of a coroutine script, e.g.
+//
+//     Coroutine Blink() {
+//         while (true) {
+//             co_await WaitSeconds(0.5f);
+//             ToggleVisibility();
+//         }
+//     }
+//
+// Hand it to MonoBehaviourLike::StartCoroutine to run it.
+class Coroutine {
+public:
+    struct promise_type {
+        CoroutineId id = 0;
+
+        Coroutine get_return_object() {
+            return Coroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception();
+    };
+
+    typedef std::coroutine_handle<promise_type> Handle;
+
+    Coroutine(Coroutine&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    Coroutine& operator=(Coroutine&& other) noexcept;
+    Coroutine(const Coroutine&) = delete;
+    Coroutine& operator=(const Coroutine&) = delete;
+    ~Coroutine();
+
+    // Give up ownership of the frame (used by the scheduler)
+    Handle Release() { Handle h = handle; handle = nullptr; return h; }
+
+private:
+    explicit Coroutine(Handle h) : handle(h) {}
+    Handle handle;
+};
+#endif // GAMEENGINE_COROUTINES
+
+// One-shot latch a script can wait on, with WaitUntil in a coroutine or
+// MonoBehaviourLike::InvokeWhen otherwise. Waiting costs nothing per
+// frame; Fire() queues every waiter for the next scheduler update.
+class CoroutineTrigger {
+public:
+    CoroutineTrigger() : fired(false) {}
+
+    // Set the trigger and wake all waiters
+    void Fire();
+
+    // Re-arm the trigger so later waits suspend again
+    void Reset() { fired = false; }
+
+    bool IsFired() const { return fired; }
+
+private:
+    friend class CoroutineScheduler;
+    friend struct WaitUntil;
+
+    bool fired;
+    std::vector<CoroutineId> waiters;
+};
+
+// Scheduler that owns every waiting script: coroutines, and callbacks
+// scheduled with InvokeAfter, InvokeWhen and InvokeOnFixedUpdate. Waiters
+// live in the timer wheel, a trigger's waiter list or the fixed update
+// list and are not visited again until they are due. The callbacks work
+// in C++14 builds; coroutines are built on the same waits.
+class CoroutineScheduler {
+public:
+    typedef std::function<void()> Callback;
+
+    static CoroutineScheduler& GetInstance();
+
+#if GAMEENGINE_COROUTINES
+    // Take ownership of a coroutine and run it to its first suspension
+    CoroutineId Start(MonoBehaviourLike* owner, Coroutine routine);
+#endif
+
+    // Run a callback once, seconds of game time from now
+    CoroutineId InvokeAfter(MonoBehaviourLike* owner, float seconds, Callback callback);
+
+    // Run a callback once the trigger fires; right away if it already has
+    CoroutineId InvokeWhen(MonoBehaviourLike* owner, CoroutineTrigger& trigger, Callback callback);
+
+    // Run a callback after the next fixed physics step
+    CoroutineId InvokeOnFixedUpdate(MonoBehaviourLike* owner, Callback callback);
+
+    // Destroy a running coroutine or cancel a pending callback
+    void Stop(CoroutineId id);
+
+    // Stop everything started by the given behaviour
+    void StopAll(MonoBehaviourLike* owner);
+
+    // Advance timers and resume waiters that became ready (once per frame)
+    void Update(float deltaTime);
+
+    // Resume waiters of the fixed update (once per physics step)
+    void FixedUpdate();
+
+    // Drop all coroutines and callbacks
+    void Clear();
+
+    // Number of live coroutines and pending callbacks
+    size_t GetCoroutineCount() const { return routines.size(); }
+
+    // Used by the awaitables
+    void ResumeAfter(CoroutineId id, float seconds);
+    void ResumeOnFixedUpdate(CoroutineId id);
+    void ResumeWhen(CoroutineId id, CoroutineTrigger& trigger);
+    void QueueResume(CoroutineId id);
+
+private:
+    CoroutineScheduler() : nextId(1), runningId(0), stopRunning(false) {}
+
+    // A coroutine frame, or a callback run once when it is resumed
+    struct Record {
+#if GAMEENGINE_COROUTINES
+        Coroutine::Handle handle;
+#endif
+        Callback callback;
+        MonoBehaviourLike* owner;
+        TimerWheel::TimerId timer;
+    };
+
+    static CoroutineScheduler* instance;
+
+    std::unordered_map<CoroutineId, Record> routines;
+    std::unordered_map<MonoBehaviourLike*, std::vector<CoroutineId>> routinesByOwner;
+    std::vector<CoroutineId> readyQueue;
+    std::vector<CoroutineId> fixedUpdateQueue;
+    TimerWheel timers;
+    CoroutineId nextId;
+    CoroutineId runningId;
+    bool stopRunning;
+
+    CoroutineId Add(MonoBehaviourLike* owner, Record record);
+    void Resume(CoroutineId id);
+    void Destroy(std::unordered_map<CoroutineId, Record>::iterator it);
+};
+
+#if GAMEENGINE_COROUTINES
+// Suspend for a number of seconds of game time
+struct WaitSeconds {
+    float seconds;
+
+    explicit WaitSeconds(float seconds) : seconds(seconds) {}
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Coroutine::Handle h) {
+        CoroutineScheduler::GetInstance().ResumeAfter(h.promise().id, seconds);
+    }
+    void await_resume() const noexcept {}
+};
+
+// Suspend until the trigger fires (continues immediately if it already has)
+struct WaitUntil {
+    CoroutineTrigger& trigger;
+
+    explicit WaitUntil(CoroutineTrigger& trigger) : trigger(trigger) {}
+
+    bool await_ready() const noexcept { return trigger.fired; }
+    void await_suspend(Coroutine::Handle h) {
+        CoroutineScheduler::GetInstance().ResumeWhen(h.promise().id, trigger);
+    }
+    void await_resume() const noexcept {}
+};
+
+// Suspend until after the next fixed physics step
+struct WaitForFixedUpdate {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Coroutine::Handle h) {
+        CoroutineScheduler::GetInstance().ResumeOnFixedUpdate(h.promise().id);
+    }
+    void await_resume() const noexcept {}
+};
+#endif // GAMEENGINE_COROUTINES
+
+#endif // COROUTINE_H
@@ -9,6 +9,8 @@
 #include "../EngineCondition.h"
 #include "../Graphics/Core/GraphicsAPIFactory.h"
 #include "../TimeManager.h"
+#include "../SceneJournal.h"
+#include "../AssetHotReload.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -17,7 +19,7 @@
 // Initialize static instance
 Editor* Editor::instance = nullptr;
 
-Editor::Editor(int width, int height) : width(width), height(height), selectedGameObject(nullptr), windowOpen(false) {
+Editor::Editor(int width, int height) : width(width), height(height), selectedGameObject(nullptr), sceneJournal(nullptr), autosaveInterval(0.0f), autosaveTimer(0.0f), windowOpen(false) {
     std::cout << "Creating editor..." << std::endl;
     
     // Set instance
@@ -77,6 +79,12 @@ Editor::~Editor() {
         editorCamera = nullptr;
     }
     
+    // Delete autosave journal
+    if (sceneJournal) {
+        delete sceneJournal;
+        sceneJournal = nullptr;
+    }
+    
     // Delete scene
     if (scene) {
         delete scene;
@@ -102,11 +110,23 @@ void Editor::Update(float deltaTime) {
         // Update camera logic
     }
     
+    // Swap in assets saved since the last frame before anything draws them
+    AssetHotReload::GetInstance().Update();
+    
     // Update scene
     if (scene) {
         scene->Update(deltaTime);
     }
     
+    // Autosave; only changed objects are written, so this is cheap
+    if (sceneJournal && autosaveInterval > 0.0f) {
+        autosaveTimer += deltaTime;
+        if (autosaveTimer >= autosaveInterval) {
+            autosaveTimer = 0.0f;
+            SaveScene();
+        }
+    }
+    
     // Update panels
     if (hierarchyPanel) {
         // Update hierarchy panel with scene objects before updating
@@ -371,3 +391,37 @@ void Editor::RunMainLoop() {
         eventPollingThread.join();
     }
 }
+
+void Editor::SetAutosave(const std::string& path, float intervalSeconds) {
+    if (sceneJournal) {
+        delete sceneJournal;
+        sceneJournal = nullptr;
+    }
+    
+    autosaveInterval = intervalSeconds;
+    autosaveTimer = 0.0f;
+    if (!path.empty()) {
+        sceneJournal = new SceneJournal(path);
+    }
+}
+
+bool Editor::SaveScene() {
+    if (!sceneJournal || !scene) {
+        std::cerr << "Editor: no save path set" << std::endl;
+        return false;
+    }
+    
+    if (!sceneJournal->Save(scene->gameObjects)) {
+        std::cerr << "Editor: failed to save scene to " << sceneJournal->GetSnapshotPath() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void Editor::SetHotReload(const std::vector<std::string>& folders) {
+    AssetHotReload& hotReload = AssetHotReload::GetInstance();
+    hotReload.Stop();
+    if (!folders.empty() && !hotReload.Start(folders)) {
+        std::cerr << "Editor: none of the asset folders could be watched" << std::endl;
+    }
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../Vector3.h"
+#include <string>
+#include <vector>
 
 class Camera;
 class Scene;
@@ -9,6 +11,7 @@ class HierarchyPanel;
 class InspectorPanel;
 class ProjectPanel;
 class SceneViewPanel;
+class SceneJournal;
 
 class Editor {
 public:
@@ -26,6 +29,19 @@ public:
     void SetSelectedGameObject(GameObject* gameObject);
     GameObject* GetSelectedGameObject() const { return selectedGameObject; }
     
+    // Autosave the scene every intervalSeconds (0 turns autosave off).
+    // Saves go to a journal next to the snapshot at path and only contain
+    // the objects changed since the previous save (see SceneJournal).
+    void SetAutosave(const std::string& path, float intervalSeconds);
+    
+    // Save the scene's changes now
+    bool SaveScene();
+    
+    // Reload assets in place as files in these folders (usually the
+    // project's asset folders and Shaders) are saved; an empty list stops
+    // watching. See AssetHotReload.
+    void SetHotReload(const std::vector<std::string>& folders);
+    
     static Editor* GetInstance() { return instance; }
     
     void Initialize();
@@ -52,6 +68,11 @@ private:
     
     GameObject* selectedGameObject;
     
+    // Autosave
+    SceneJournal* sceneJournal;
+    float autosaveInterval;
+    float autosaveTimer;
+    
     // Window management
     bool windowOpen;
 };
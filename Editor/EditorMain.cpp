@@ -56,6 +56,9 @@ int main(int argc, char** argv) {
     // Initialize the editor
     InitializeEditor();
     
+    // Edited shaders show up without restarting
+    editor->SetHotReload(std::vector<std::string>{ "Shaders" });
+    
     // Run main loop
     if (windowCreated) {
         // Normal window-based main loop
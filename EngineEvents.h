@@ -0,0 +1,50 @@
+#ifndef ENGINE_EVENTS_H
+#define ENGINE_EVENTS_H
+
+#include "CollisionInfo.h"
+
+// Event types published by engine systems through the EventBus
+
+class RigidBody;
+class GameObject;
+class TriggerVolume;
+class NavMesh;
+
+enum class CollisionPhase {
+    ENTER,
+    STAY,
+    EXIT
+};
+
+// Published by RigidBody when it starts, keeps or stops touching another body
+struct CollisionEvent {
+    RigidBody* body;        // Body that received the contact
+    RigidBody* other;       // Body it collided with
+    CollisionInfo info;     // Contact data (default for EXIT)
+    CollisionPhase phase;
+
+    CollisionEvent() : body(nullptr), other(nullptr), phase(CollisionPhase::ENTER) {}
+    CollisionEvent(RigidBody* body, RigidBody* other, const CollisionInfo& info, CollisionPhase phase)
+        : body(body), other(other), info(info), phase(phase) {}
+};
+
+// Published by TriggerVolume when an object enters, stays in or leaves it
+struct TriggerEvent {
+    TriggerVolume* trigger;
+    GameObject* other;
+    CollisionPhase phase;
+
+    TriggerEvent() : trigger(nullptr), other(nullptr), phase(CollisionPhase::ENTER) {}
+    TriggerEvent(TriggerVolume* trigger, GameObject* other, CollisionPhase phase)
+        : trigger(trigger), other(other), phase(phase) {}
+};
+
+// Published by NavMeshManager after the navigation mesh was rebuilt or replaced
+struct NavMeshRefreshedEvent {
+    NavMesh* navMesh;
+
+    NavMeshRefreshedEvent() : navMesh(nullptr) {}
+    explicit NavMeshRefreshedEvent(NavMesh* navMesh) : navMesh(navMesh) {}
+};
+
+#endif // ENGINE_EVENTS_H
@@ -0,0 +1,78 @@
+#include "EventBus.h"
+#include <iostream>
+#include <cstdlib>
+
+// Initialize static instance
+EventBus* EventBus::instance = nullptr;
+
+EventBus::EventBus() : dispatchingAll(false), dispatchAllRequested(false), nextListenerId(1) {
+    for (size_t i = 0; i < MAX_EVENT_TYPES; i++) {
+        queues[i].store(nullptr);
+    }
+}
+
+EventBus::~EventBus() {
+    for (size_t i = 0; i < MAX_EVENT_TYPES; i++) {
+        delete queues[i].load();
+    }
+}
+
+EventBus& EventBus::GetInstance() {
+    if (!instance) {
+        instance = new EventBus();
+    }
+    return *instance;
+}
+
+size_t EventBus::NextEventTypeId() {
+    static std::atomic<size_t> counter(0);
+    size_t id = counter++;
+    if (id >= MAX_EVENT_TYPES) {
+        std::cerr << "EventBus: too many event types (max " << MAX_EVENT_TYPES << ")" << std::endl;
+        std::abort();
+    }
+    return id;
+}
+
+void EventBus::Unsubscribe(ListenerId id) {
+    if (id == INVALID_LISTENER) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (size_t type : dispatchOrder) {
+        if (queues[type].load()->RemoveListener(id)) {
+            return;
+        }
+    }
+}
+
+void EventBus::Dispatch() {
+    // dispatchScratch is being walked; go round again once it is done
+    if (dispatchingAll) {
+        dispatchAllRequested = true;
+        return;
+    }
+
+    dispatchingAll = true;
+    do {
+        dispatchAllRequested = false;
+        {
+            // Reused buffer, so steady-state dispatch does not allocate
+            std::lock_guard<std::mutex> lock(registryMutex);
+            dispatchScratch.assign(dispatchOrder.begin(), dispatchOrder.end());
+        }
+
+        for (size_t type : dispatchScratch) {
+            queues[type].load(std::memory_order_acquire)->Dispatch();
+        }
+    } while (dispatchAllRequested);
+    dispatchingAll = false;
+}
+
+void EventBus::Clear() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (size_t type : dispatchOrder) {
+        queues[type].load()->Clear();
+    }
+}
@@ -0,0 +1,250 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <utility>
+#include <cstddef>
+
+// Typed event bus with batched, deferred dispatch
+//
+// Events are appended to a contiguous queue per event type while a phase
+// runs (physics, navigation, ...). Dispatch() hands each listener the whole
+// batch for its type as one array, so there is one call per listener per
+// batch instead of one virtual call per event, and listeners never re-enter
+// the system that produced the events. Publish() is thread safe.
+// A listener may call Dispatch(): the request is queued and runs once the
+// batch being delivered is finished.
+//
+//     auto id = EventBus::GetInstance().Subscribe<CollisionEvent>(
+//         [](const CollisionEvent* events, size_t count) { ... });
+//     EventBus::GetInstance().Publish(CollisionEvent(a, b, info, CollisionPhase::ENTER));
+//     EventBus::GetInstance().Dispatch();
+class EventBus {
+public:
+    typedef unsigned int ListenerId;
+
+    static const ListenerId INVALID_LISTENER = 0;
+    static const size_t MAX_EVENT_TYPES = 64;
+
+    static EventBus& GetInstance();
+
+    // Queue an event for the next dispatch of its type
+    template<typename E>
+    void Publish(const E& event) {
+        EventQueue<E>& queue = GetQueue<E>();
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.pending.push_back(event);
+    }
+
+    // Queue several events under a single lock (e.g. from a worker thread)
+    template<typename E>
+    void PublishBatch(const E* events, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        EventQueue<E>& queue = GetQueue<E>();
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.pending.insert(queue.pending.end(), events, events + count);
+    }
+
+    // Register a batch listener for an event type
+    template<typename E>
+    ListenerId Subscribe(std::function<void(const E* events, size_t count)> listener) {
+        if (!listener) {
+            return INVALID_LISTENER;
+        }
+        ListenerId id = nextListenerId++;
+        GetQueue<E>().AddListener(id, std::move(listener));
+        return id;
+    }
+
+    // Remove a listener; safe to call from inside a dispatch
+    void Unsubscribe(ListenerId id);
+
+    // Dispatch every queued event type, in the order the types were first used.
+    // Called from a listener, runs again after the current pass instead.
+    void Dispatch();
+
+    // Dispatch only one event type
+    template<typename E>
+    void Dispatch() {
+        GetQueue<E>().Dispatch();
+    }
+
+    // Number of events waiting for the next dispatch
+    template<typename E>
+    size_t GetPendingCount() {
+        EventQueue<E>& queue = GetQueue<E>();
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        return queue.pending.size();
+    }
+
+    // Drop all queued events (listeners stay registered)
+    void Clear();
+
+    // Drop the queued events of one type that match a predicate, e.g. the
+    // events of objects that are about to be destroyed
+    template<typename E, typename Predicate>
+    void Discard(Predicate predicate) {
+        EventQueue<E>& queue = GetQueue<E>();
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.pending.erase(std::remove_if(queue.pending.begin(), queue.pending.end(), predicate),
+                            queue.pending.end());
+    }
+
+private:
+    EventBus();
+    ~EventBus();
+
+    // Type-erased queue so Dispatch() can walk every event type
+    class IEventQueue {
+    public:
+        virtual ~IEventQueue() {}
+        virtual void Dispatch() = 0;
+        virtual void Clear() = 0;
+        virtual bool RemoveListener(ListenerId id) = 0;
+    };
+
+    template<typename E>
+    class EventQueue : public IEventQueue {
+    public:
+        typedef std::function<void(const E*, size_t)> Listener;
+
+        std::mutex mutex;
+        std::vector<E> pending;
+        std::vector<E> dispatching;
+        std::vector<std::pair<ListenerId, Listener>> listeners;
+        std::vector<std::pair<ListenerId, Listener>> addedListeners;
+        bool listenersRemoved = false;
+        bool dispatchingNow = false;
+        bool dispatchRequested = false;
+
+        void AddListener(ListenerId id, Listener listener) {
+            // Never grow the list that is being iterated
+            if (dispatchingNow) {
+                addedListeners.push_back(std::make_pair(id, std::move(listener)));
+            } else {
+                listeners.push_back(std::make_pair(id, std::move(listener)));
+            }
+        }
+
+        void Dispatch() override {
+            // A listener asking for a dispatch gets the next batch once the
+            // current one is delivered
+            if (dispatchingNow) {
+                dispatchRequested = true;
+                return;
+            }
+            do {
+                dispatchRequested = false;
+                DispatchBatch();
+            } while (dispatchRequested);
+        }
+
+        void DispatchBatch() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (pending.empty()) {
+                    return;
+                }
+                // Events published by listeners land in the next batch
+                dispatching.swap(pending);
+            }
+
+            dispatchingNow = true;
+            for (auto& listener : listeners) {
+                if (listener.first != INVALID_LISTENER) {
+                    listener.second(dispatching.data(), dispatching.size());
+                }
+            }
+            dispatchingNow = false;
+
+            dispatching.clear();
+
+            // Listeners added during dispatch see the next batch
+            if (!addedListeners.empty()) {
+                for (auto& listener : addedListeners) {
+                    listeners.push_back(std::move(listener));
+                }
+                addedListeners.clear();
+            }
+
+            if (listenersRemoved) {
+                listenersRemoved = false;
+                std::vector<std::pair<ListenerId, Listener>> remaining;
+                for (auto& listener : listeners) {
+                    if (listener.first != INVALID_LISTENER) {
+                        remaining.push_back(std::move(listener));
+                    }
+                }
+                listeners.swap(remaining);
+            }
+        }
+
+        void Clear() override {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.clear();
+        }
+
+        bool RemoveListener(ListenerId id) override {
+            for (auto& listener : addedListeners) {
+                if (listener.first == id) {
+                    listener.first = INVALID_LISTENER;
+                    listenersRemoved = true;
+                    return true;
+                }
+            }
+            for (auto& listener : listeners) {
+                if (listener.first == id) {
+                    // Compacted after the current dispatch
+                    listener.first = INVALID_LISTENER;
+                    listenersRemoved = true;
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    static EventBus* instance;
+
+    // Dense id per event type
+    static size_t NextEventTypeId();
+
+    template<typename E>
+    static size_t EventTypeId() {
+        static const size_t id = NextEventTypeId();
+        return id;
+    }
+
+    template<typename E>
+    EventQueue<E>& GetQueue() {
+        size_t type = EventTypeId<E>();
+        IEventQueue* queue = queues[type].load(std::memory_order_acquire);
+        if (!queue) {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            queue = queues[type].load(std::memory_order_relaxed);
+            if (!queue) {
+                queue = new EventQueue<E>();
+                queues[type].store(queue, std::memory_order_release);
+                dispatchOrder.push_back(type);
+            }
+        }
+        return *static_cast<EventQueue<E>*>(queue);
+    }
+
+    std::atomic<IEventQueue*> queues[MAX_EVENT_TYPES];
+    std::vector<size_t> dispatchOrder;
+    std::vector<size_t> dispatchScratch;
+    bool dispatchingAll;
+    bool dispatchAllRequested;
+    std::mutex registryMutex;
+    ListenerId nextListenerId;
+};
+
+#endif // EVENT_BUS_H
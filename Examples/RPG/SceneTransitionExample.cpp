@@ -1,20 +1,36 @@
 #include "Scene.h"
 #include "GameObject.h"
 #include "SceneSerializer.h"
+#include "SceneLoadOperation.h"
+#include "SceneJournal.h"
 #include "MonoBehaviourLike.h"
+#include "EventBus.h"
 #include <iostream>
 #include <memory>
 
+// Published by the game's input handling when a key goes down
+struct KeyPressedEvent {
+    char key;
+
+    KeyPressedEvent() : key(0) {}
+    explicit KeyPressedEvent(char key) : key(key) {}
+};
+
 // Example RPG scene transition component
 class SceneTransitionTrigger : public MonoBehaviourLike {
 private:
     std::string targetScene;
     std::string spawnPoint;
     bool playerInRange;
+    Scene* loadingScene;
+    std::shared_ptr<SceneLoadOperation> loadingOperation;
+    CoroutineTrigger interactPressed;
+    EventBus::ListenerId keyListener;
 
 public:
     SceneTransitionTrigger(const std::string& targetScene, const std::string& spawnPoint)
-        : targetScene(targetScene), spawnPoint(spawnPoint), playerInRange(false) {}
+        : targetScene(targetScene), spawnPoint(spawnPoint), playerInRange(false), loadingScene(nullptr),
+          keyListener(EventBus::INVALID_LISTENER) {}
 
     void OnTriggerEnter() override {
         playerInRange = true;
@@ -25,54 +41,119 @@ public:
         playerInRange = false;
     }
 
-    void Update(float deltaTime) override {
-        // Check if player is in range and pressed the interaction key
-        if (playerInRange && IsKeyPressed('E')) {
-            // Save player state before transition
-            GameObject* player = GetScene()->FindGameObject("Player");
-            if (player) {
-                SceneSerializer::SaveObjectToJson(player, "player_persistence.json");
-                std::cout << "Saved player state to player_persistence.json" << std::endl;
+    void Start() override {
+        // Key presses arrive as events, so nothing runs per frame while the
+        // player is elsewhere
+        keyListener = EventBus::GetInstance().Subscribe<KeyPressedEvent>([this](const KeyPressedEvent* events, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                if (events[i].key == 'E') {
+                    OnInteractPressed();
+                }
             }
+        });
+        ArmTransition();
+    }
+
+    void OnDestroy() override {
+        EventBus::GetInstance().Unsubscribe(keyListener);
+        keyListener = EventBus::INVALID_LISTENER;
+    }
 
-            // Transition to the new scene
-            TransitionToScene(targetScene, spawnPoint);
+    // Sleep until the player interacts instead of polling the range check.
+    // The trigger fires once, so it is re-armed after a failed transition.
+    void ArmTransition() {
+        interactPressed.Reset();
+#if GAMEENGINE_COROUTINES
+        StartCoroutine(WaitForInteraction());
+#else
+        InvokeWhen(interactPressed, [this]() { SavePlayerAndTransition(); });
+#endif
+    }
+
+    // Called when 'E' is pressed
+    void OnInteractPressed() {
+        if (playerInRange) {
+            interactPressed.Fire();
         }
     }
 
-    void TransitionToScene(const std::string& scenePath, const std::string& spawnPointName) {
+#if GAMEENGINE_COROUTINES
+    Coroutine WaitForInteraction() {
+        co_await WaitUntil(interactPressed);
+        SavePlayerAndTransition();
+    }
+#endif
+
+    void SavePlayerAndTransition() {
+        // Carry the player over in memory rather than through
+        // player_persistence.json; write that file when saving the game
+        Scene* currentScene = GetScene();
+        GameObject* player = currentScene->FindGameObject("Player");
+        if (player) {
+            // Removing hands ownership of the player to us
+            currentScene->RemoveGameObject(player);
+        }
+
+        // Transition to the new scene
+        TransitionToScene(targetScene, spawnPoint, player);
+    }
+
+    void TransitionToScene(const std::string& scenePath, const std::string& spawnPointName, GameObject* player) {
         std::cout << "Transitioning to scene: " << scenePath << std::endl;
 
-        // Load the new scene
+        // Parse the new scene in the background; the current scene keeps
+        // running while the new one finalizes a little each frame
         Scene* newScene = new Scene();
-        newScene->Load(scenePath);
-
-        // Find the spawn point in the new scene
-        GameObject* spawnPointObj = newScene->FindGameObject(spawnPointName);
-        Vector3 spawnPosition = spawnPointObj ? spawnPointObj->GetPosition() : Vector3(0, 0, 0);
-
-        // Load the persistent player data
-        GameObject* persistentPlayer = SceneSerializer::LoadObjectFromJson("player_persistence.json");
-        if (persistentPlayer) {
-            // Position the player at the spawn point
-            persistentPlayer->SetPosition(spawnPosition);
-            
-            // Add the player to the new scene
-            newScene->AddGameObject(persistentPlayer);
-            std::cout << "Loaded persistent player data at spawn point: " << spawnPointName << std::endl;
-        }
+        newScene->Initialize();
+        loadingScene = newScene;
+        loadingOperation = newScene->LoadAsync(scenePath);
+
+        loadingOperation->OnComplete([this, newScene, spawnPointName, player](SceneLoadOperation& load) {
+            if (!load.Succeeded()) {
+                std::cerr << "Failed to load scene: " << load.GetPath() << std::endl;
+                if (player) {
+                    GetScene()->AddGameObject(player);
+                }
+                loadingScene = nullptr;
+                delete newScene;
+                ArmTransition();
+                return;
+            }
+
+            // Find the spawn point in the new scene
+            GameObject* spawnPointObj = newScene->FindGameObject(spawnPointName);
+            Vector3 spawnPosition = spawnPointObj ? spawnPointObj->GetPosition() : Vector3(0, 0, 0);
+
+            if (player) {
+                // Position the player at the spawn point
+                player->SetPosition(spawnPosition);
 
-        // Set the new scene as the active scene
-        // In a real implementation, this would be handled by a SceneManager
-        GetScene()->Shutdown();
-        delete GetScene();
-        SetActiveScene(newScene);
+                // Add the player to the new scene
+                newScene->AddGameObject(player);
+                std::cout << "Moved player to spawn point: " << spawnPointName << std::endl;
+            }
+
+            // Set the new scene as the active scene
+            // In a real implementation, this would be handled by a SceneManager
+            loadingScene = nullptr;
+            GetScene()->Shutdown();
+            delete GetScene();
+            SetActiveScene(newScene);
+        });
+    }
+
+    // Called once per frame by the game loop while a transition is in progress
+    void UpdateTransition() {
+        if (loadingScene) {
+            loadingScene->FinalizeLoads();
+            DrawLoadingBar(loadingOperation->GetProgress());
+        }
     }
 
     // Helper methods (would be implemented in a real game)
-    bool IsKeyPressed(char key) { return false; /* Placeholder */ }
     Scene* GetScene() { return nullptr; /* Placeholder */ }
     void SetActiveScene(Scene* scene) { /* Placeholder */ }
+    void DrawLoadingBar(float progress) { /* Placeholder */ }
 };
 
 // Example usage in main game code
@@ -81,8 +162,16 @@ int main() {
     Scene* mainWorld = new Scene();
     mainWorld->Load("Scenes/main_world.json");
 
+    // Save games are journaled: each save appends only the objects that
+    // changed since the previous one, and every few saves the journal is
+    // folded into a full snapshot
+    SceneJournal saveGame("Saves/main_world_save.json");
+
     // Game loop would run here
     // ...
+    //     if (savePressed) {
+    //         saveGame.Save(mainWorld->gameObjects);
+    //     }
 
     return 0;
 }
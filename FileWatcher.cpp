@@ -0,0 +1,269 @@
+#include "FileWatcher.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <iostream>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Files and subfolders directly inside a folder
+    void ListFolder(const std::string& folder, std::vector<std::string>& files, std::vector<std::string>& subfolders) {
+#if defined(_WIN32)
+        WIN32_FIND_DATAA found;
+        HANDLE search = FindFirstFileA((folder + "/*").c_str(), &found);
+        if (search == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        do {
+            std::string name = found.cFileName;
+            if (name == "." || name == "..") {
+                continue;
+            }
+            if (found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                subfolders.push_back(folder + "/" + name);
+            } else {
+                files.push_back(folder + "/" + name);
+            }
+        } while (FindNextFileA(search, &found));
+        FindClose(search);
+#else
+        DIR* dir = opendir(folder.c_str());
+        if (!dir) {
+            return;
+        }
+        while (dirent* entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name == "." || name == "..") {
+                continue;
+            }
+            std::string path = folder + "/" + name;
+            struct stat info;
+            if (stat(path.c_str(), &info) != 0) {
+                continue;
+            }
+            if (S_ISDIR(info.st_mode)) {
+                subfolders.push_back(path);
+            } else if (S_ISREG(info.st_mode)) {
+                files.push_back(path);
+            }
+        }
+        closedir(dir);
+#endif
+    }
+
+    bool IsFolder(const std::string& path) {
+        struct stat info;
+        return stat(path.c_str(), &info) == 0 && (info.st_mode & S_IFMT) == S_IFDIR;
+    }
+}
+
+FileWatcher::FileWatcher() : settleTime(0.1f), scanInterval(1.0f), lastScan(Clock::now()) {
+#if defined(__linux__)
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        std::cerr << "Warning: inotify unavailable, scanning watched folders instead" << std::endl;
+    }
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#if defined(__linux__)
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+    }
+#endif
+}
+
+bool FileWatcher::IsNative() const {
+#if defined(__linux__)
+    return inotifyFd >= 0;
+#else
+    return false;
+#endif
+}
+
+bool FileWatcher::AddFolder(const std::string& folder) {
+    std::string path = folder;
+    while (path.size() > 1 && (path.back() == '/' || path.back() == '\\')) {
+        path.pop_back();
+    }
+    if (!IsFolder(path)) {
+        std::cerr << "Error: Cannot watch missing folder: " << folder << std::endl;
+        return false;
+    }
+    if (std::find(folders.begin(), folders.end(), path) != folders.end()) {
+        return true;
+    }
+
+#if defined(__linux__)
+    if (IsNative()) {
+        if (!Watch(path, false)) {
+            return false;
+        }
+        folders.push_back(path);
+        return true;
+    }
+#endif
+
+    // What is there now is the baseline the next scans compare against
+    Scan(path, stamps);
+    folders.push_back(path);
+    return true;
+}
+
+void FileWatcher::Clear() {
+#if defined(__linux__)
+    for (const auto& watch : watches) {
+        inotify_rm_watch(inotifyFd, watch.first);
+    }
+    watches.clear();
+#endif
+    folders.clear();
+    stamps.clear();
+    pending.clear();
+}
+
+void FileWatcher::Poll(std::vector<std::string>& changed) {
+    changed.clear();
+    Clock::time_point now = Clock::now();
+
+    if (IsNative()) {
+#if defined(__linux__)
+        ReadEvents();
+#endif
+    } else if (std::chrono::duration<float>(now - lastScan).count() >= scanInterval) {
+        lastScan = now;
+        Stamps found;
+        for (const std::string& folder : folders) {
+            Scan(folder, found);
+        }
+        for (const auto& file : found) {
+            auto previous = stamps.find(file.first);
+            if (previous == stamps.end() || previous->second != file.second) {
+                MarkChanged(file.first, now);
+            }
+        }
+        stamps.swap(found);
+    }
+
+    for (auto it = pending.begin(); it != pending.end();) {
+        if (std::chrono::duration<float>(now - it->second).count() >= settleTime) {
+            changed.push_back(it->first);
+            it = pending.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    std::sort(changed.begin(), changed.end());
+}
+
+void FileWatcher::Scan(const std::string& folder, Stamps& found) const {
+    std::vector<std::string> files;
+    std::vector<std::string> subfolders;
+    ListFolder(folder, files, subfolders);
+
+    for (const std::string& file : files) {
+        struct stat info;
+        if (stat(file.c_str(), &info) != 0) {
+            continue;
+        }
+#if defined(__APPLE__)
+        int64_t time = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+        int64_t time = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#else
+        int64_t time = static_cast<int64_t>(info.st_mtime) * 1000000000;
+#endif
+        found[file] = std::make_pair(static_cast<int64_t>(info.st_size), time);
+    }
+    for (const std::string& subfolder : subfolders) {
+        Scan(subfolder, found);
+    }
+}
+
+void FileWatcher::MarkChanged(const std::string& path, Clock::time_point when) {
+    pending[path] = when;
+}
+
+#if defined(__linux__)
+bool FileWatcher::Watch(const std::string& folder, bool reportFiles) {
+    // Files are reported when closed after writing or renamed into place,
+    // never halfway through a write
+    int watch = inotify_add_watch(inotifyFd, folder.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+    if (watch < 0) {
+        std::cerr << "Error: Failed to watch folder " << folder << " (errno " << errno << ")" << std::endl;
+        return false;
+    }
+    watches[watch] = folder;
+
+    std::vector<std::string> files;
+    std::vector<std::string> subfolders;
+    ListFolder(folder, files, subfolders);
+    if (reportFiles) {
+        // A folder created or moved in may have been filled before its
+        // watch existed
+        Clock::time_point now = Clock::now();
+        for (const std::string& file : files) {
+            MarkChanged(file, now);
+        }
+    }
+    for (const std::string& subfolder : subfolders) {
+        Watch(subfolder, reportFiles);
+    }
+    return true;
+}
+
+void FileWatcher::ReadEvents() {
+    alignas(inotify_event) char buffer[16384];
+    for (;;) {
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            // EAGAIN: nothing more queued
+            return;
+        }
+
+        Clock::time_point now = Clock::now();
+        for (ssize_t offset = 0; offset < length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                std::cerr << "Warning: File change queue overflowed, some changes were missed" << std::endl;
+                continue;
+            }
+            auto folder = watches.find(event->wd);
+            if (folder == watches.end()) {
+                continue;
+            }
+            if (event->mask & IN_IGNORED) {
+                // The folder was deleted or moved away
+                watches.erase(folder);
+                continue;
+            }
+            if (event->len == 0) {
+                continue;
+            }
+
+            std::string path = folder->second + "/" + event->name;
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    Watch(path, true);
+                }
+            } else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                MarkChanged(path, now);
+            }
+        }
+    }
+}
+#endif
@@ -0,0 +1,87 @@
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Reports files that were written, created or renamed into a set of
+// folders, including folders created below them later.
+//
+//     FileWatcher watcher;
+//     watcher.AddFolder("Assets");
+//     ...
+//     std::vector<std::string> changed;
+//     watcher.Poll(changed);    // once a frame
+//
+// On Linux the kernel queues the changes (inotify), so Poll only reads what
+// happened and costs nothing while the folders are quiet, however many
+// files they hold. Elsewhere, or when inotify is unavailable, Poll rescans
+// the folders' sizes and modification times every GetScanInterval() seconds.
+//
+// A file is reported once it has been left alone for GetSettleTime()
+// seconds, so a tool writing it in several steps triggers one reload of
+// the finished file rather than several of partial ones.
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    // Watch a folder and everything below it
+    bool AddFolder(const std::string& folder);
+
+    // Stop watching every folder
+    void Clear();
+
+    // Files changed since the last call that have since settled
+    void Poll(std::vector<std::string>& changed);
+
+    // Seconds a file must go unchanged before it is reported
+    void SetSettleTime(float seconds) { settleTime = seconds; }
+    float GetSettleTime() const { return settleTime; }
+
+    // Seconds between scans where changes are not queued by the system
+    void SetScanInterval(float seconds) { scanInterval = seconds; }
+    float GetScanInterval() const { return scanInterval; }
+
+    // Whether the system reports changes, rather than Poll scanning for them
+    bool IsNative() const;
+
+    const std::vector<std::string>& GetFolders() const { return folders; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    FileWatcher(const FileWatcher&);
+    FileWatcher& operator=(const FileWatcher&);
+
+    std::vector<std::string> folders;
+    float settleTime;
+    float scanInterval;
+
+    // Changed files and when they last changed
+    std::unordered_map<std::string, Clock::time_point> pending;
+
+    // Size and modification time of every file, when scanning
+    typedef std::unordered_map<std::string, std::pair<int64_t, int64_t>> Stamps;
+    Stamps stamps;
+    Clock::time_point lastScan;
+
+    void Scan(const std::string& folder, Stamps& found) const;
+
+#if defined(__linux__)
+    int inotifyFd;
+    std::unordered_map<int, std::string> watches;    // watch descriptor -> folder
+
+    // Watch a folder and its subfolders, optionally reporting their files
+    bool Watch(const std::string& folder, bool reportFiles);
+    void ReadEvents();
+#endif
+
+    void MarkChanged(const std::string& path, Clock::time_point when);
+};
+
+#endif // FILE_WATCHER_H
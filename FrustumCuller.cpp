@@ -0,0 +1,358 @@
+#include "FrustumCuller.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define FRUSTUM_CULLER_AVX 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_CULLER_SSE2 1
+#endif
+
+namespace {
+    // Boxes a worker takes at a time
+    const size_t CHUNK_SIZE = 4096;
+
+    // A cull split into chunks. Workers and the calling thread take chunks
+    // until none are left, so a cull never waits for a worker busy with
+    // other jobs; workers that start after the last chunk was taken return
+    // without touching the boxes.
+    struct ParallelCull {
+        std::atomic<size_t> nextChunk;
+        size_t chunkCount;
+        size_t finishedChunks;
+        std::mutex mutex;
+        std::condition_variable finished;
+
+        ParallelCull(size_t chunks) : nextChunk(0), chunkCount(chunks), finishedChunks(0) {}
+    };
+
+    // Where the three planes meet
+    bool IntersectPlanes(const float* a, const float* b, const float* c, Vector3& point) {
+        Vector3 na(a[0], a[1], a[2]);
+        Vector3 nb(b[0], b[1], b[2]);
+        Vector3 nc(c[0], c[1], c[2]);
+        Vector3 bc = nb.cross(nc);
+        float determinant = na.dot(bc);
+        if (std::fabs(determinant) < 1e-12f) {
+            return false;
+        }
+        point = (bc * -a[3] + nc.cross(na) * -b[3] + na.cross(nb) * -c[3]) / determinant;
+        return true;
+    }
+}
+
+// Gribb and Hartmann: with the point multiplied from the left, clip
+// coordinate j is the dot product with column j, and each plane of the
+// clip volume (-w <= x, y, z <= w) is the w column plus or minus another
+FrustumCuller::Frustum FrustumCuller::Frustum::FromMatrices(const Matrix4x4& view, const Matrix4x4& projection) {
+    Matrix4x4 m = view * projection;
+    Frustum frustum;
+    for (int plane = 0; plane < 6; plane++) {
+        int column = plane / 2;
+        float sign = (plane % 2 == 0) ? 1.0f : -1.0f;
+        float* p = frustum.planes[plane];
+        for (int row = 0; row < 4; row++) {
+            p[row] = m.elements[row][3] + sign * m.elements[row][column];
+        }
+
+        // Unit normals, so the plane distance is a distance in world units
+        float length = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        if (length > 0.0f) {
+            for (int i = 0; i < 4; i++) {
+                p[i] /= length;
+            }
+        }
+    }
+    return frustum;
+}
+
+// A box is outside once its corner furthest along a plane's normal is
+// behind that plane
+bool FrustumCuller::Frustum::Intersects(const Vector3& boundsMin, const Vector3& boundsMax) const {
+    for (int plane = 0; plane < 6; plane++) {
+        const float* p = planes[plane];
+        float x = p[0] >= 0.0f ? boundsMax.x : boundsMin.x;
+        float y = p[1] >= 0.0f ? boundsMax.y : boundsMin.y;
+        float z = p[2] >= 0.0f ? boundsMax.z : boundsMin.z;
+        if (p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FrustumCuller::Frustum::GetCorners(Vector3 corners[8]) const {
+    int corner = 0;
+    for (int depth = 4; depth < 6; depth++) {
+        for (int vertical = 2; vertical < 4; vertical++) {
+            for (int horizontal = 0; horizontal < 2; horizontal++) {
+                if (!IntersectPlanes(planes[horizontal], planes[vertical], planes[depth], corners[corner++])) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// A frustum is convex, so it is inside another when its corners are
+bool FrustumCuller::Frustum::Contains(const Frustum& other) const {
+    Vector3 corners[8];
+    if (!other.GetCorners(corners)) {
+        return false;
+    }
+    for (int plane = 0; plane < 6; plane++) {
+        const float* p = planes[plane];
+        for (const Vector3& corner : corners) {
+            // Corners computed from the planes carry some rounding
+            float tolerance = 1e-4f * (1.0f + corner.magnitude());
+            if (p[0] * corner.x + p[1] * corner.y + p[2] * corner.z + p[3] < -tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+FrustumCuller::FrustumCuller() : resultCount(0) {
+}
+
+void FrustumCuller::Clear() {
+    boundsMinX.clear();
+    boundsMinY.clear();
+    boundsMinZ.clear();
+    boundsMaxX.clear();
+    boundsMaxY.clear();
+    boundsMaxZ.clear();
+    resultCount = 0;
+    stats = Stats();
+}
+
+size_t FrustumCuller::Add(const Vector3& boundsMin, const Vector3& boundsMax) {
+    boundsMinX.push_back(boundsMin.x);
+    boundsMinY.push_back(boundsMin.y);
+    boundsMinZ.push_back(boundsMin.z);
+    boundsMaxX.push_back(boundsMax.x);
+    boundsMaxY.push_back(boundsMax.y);
+    boundsMaxZ.push_back(boundsMax.z);
+    return boundsMinX.size() - 1;
+}
+
+const std::vector<uint8_t>& FrustumCuller::Cull(const Matrix4x4& view, const Matrix4x4& projection) {
+    return Cull(Frustum::FromMatrices(view, projection));
+}
+
+const std::vector<uint8_t>& FrustumCuller::Cull(const Frustum& frustum) {
+    stats.cameras++;
+
+    // Earlier cameras of this frame: the same frustum is the same result,
+    // and a frustum inside an earlier one can only see what that one saw.
+    // Narrow from the earlier result with the fewest visible boxes.
+    const CameraResult* narrowest = nullptr;
+    for (size_t i = 0; i < resultCount; i++) {
+        const CameraResult& earlier = results[i];
+        if (std::memcmp(earlier.frustum.planes, frustum.planes, sizeof(frustum.planes)) == 0) {
+            stats.sharedResults++;
+            stats.boxesVisible += earlier.visibleIndices.size();
+            return earlier.visible;
+        }
+        if ((!narrowest || earlier.visibleIndices.size() < narrowest->visibleIndices.size()) &&
+            earlier.frustum.Contains(frustum)) {
+            narrowest = &earlier;
+        }
+    }
+
+    if (resultCount == results.size()) {
+        results.emplace_back();
+    }
+    CameraResult& result = results[resultCount++];
+    result.frustum = frustum;
+    if (narrowest) {
+        stats.sharedResults++;
+        CullCandidates(frustum, narrowest->visibleIndices, result.visible);
+    } else {
+        CullAll(frustum, result.visible);
+    }
+
+    result.visibleIndices.clear();
+    for (size_t i = 0; i < result.visible.size(); i++) {
+        if (result.visible[i]) {
+            result.visibleIndices.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    stats.boxesVisible += result.visibleIndices.size();
+    return result.visible;
+}
+
+void FrustumCuller::CullAll(const Frustum& frustum, std::vector<uint8_t>& visible) {
+    size_t count = GetCount();
+    visible.resize(count);
+    stats.boxesTested += count;
+
+    size_t chunkCount = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    size_t threads = std::thread::hardware_concurrency();
+    if (count < PARALLEL_THRESHOLD || threads < 2) {
+        TestBoxes(frustum, boundsMinX.data(), boundsMinY.data(), boundsMinZ.data(), boundsMaxX.data(),
+                  boundsMaxY.data(), boundsMaxZ.data(), 0, count, visible.data());
+        return;
+    }
+
+    const float* minX = boundsMinX.data();
+    const float* minY = boundsMinY.data();
+    const float* minZ = boundsMinZ.data();
+    const float* maxX = boundsMaxX.data();
+    const float* maxY = boundsMaxY.data();
+    const float* maxZ = boundsMaxZ.data();
+    uint8_t* output = visible.data();
+
+    std::shared_ptr<ParallelCull> state = std::make_shared<ParallelCull>(chunkCount);
+    auto work = [state, frustum, count, minX, minY, minZ, maxX, maxY, maxZ, output]() {
+        size_t done = 0;
+        for (size_t chunk = state->nextChunk++; chunk < state->chunkCount; chunk = state->nextChunk++) {
+            size_t begin = chunk * CHUNK_SIZE;
+            TestBoxes(frustum, minX, minY, minZ, maxX, maxY, maxZ, begin, std::min(begin + CHUNK_SIZE, count), output);
+            done++;
+        }
+        if (done > 0) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finishedChunks += done;
+            if (state->finishedChunks == state->chunkCount) {
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    size_t helpers = std::min(chunkCount - 1, threads - 1);
+    for (size_t i = 0; i < helpers; i++) {
+        JobSystem::GetInstance().Submit(work);
+    }
+    work();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state]() { return state->finishedChunks == state->chunkCount; });
+}
+
+void FrustumCuller::CullCandidates(const Frustum& frustum, const std::vector<uint32_t>& candidates,
+                                   std::vector<uint8_t>& visible) {
+    visible.assign(GetCount(), 0);
+    stats.boxesTested += candidates.size();
+
+    const std::vector<float>* sources[6] = { &boundsMinX, &boundsMinY, &boundsMinZ, &boundsMaxX, &boundsMaxY, &boundsMaxZ };
+    for (int axis = 0; axis < 6; axis++) {
+        gathered[axis].resize(candidates.size());
+        const float* source = sources[axis]->data();
+        float* target = gathered[axis].data();
+        for (size_t i = 0; i < candidates.size(); i++) {
+            target[i] = source[candidates[i]];
+        }
+    }
+    gatheredVisible.resize(candidates.size());
+    TestBoxes(frustum, gathered[0].data(), gathered[1].data(), gathered[2].data(), gathered[3].data(),
+              gathered[4].data(), gathered[5].data(), 0, candidates.size(), gatheredVisible.data());
+
+    for (size_t i = 0; i < candidates.size(); i++) {
+        visible[candidates[i]] = gatheredVisible[i];
+    }
+}
+
+// Per plane, the corner furthest along the normal takes the max coordinate
+// where the normal is positive and the min one elsewhere. That choice is
+// the same for every box, so it picks arrays instead of blending lanes.
+void FrustumCuller::TestBoxes(const Frustum& frustum, const float* minX, const float* minY, const float* minZ,
+                              const float* maxX, const float* maxY, const float* maxZ,
+                              size_t begin, size_t end, uint8_t* visible) {
+    const float* cornerX[6];
+    const float* cornerY[6];
+    const float* cornerZ[6];
+    for (int plane = 0; plane < 6; plane++) {
+        const float* p = frustum.planes[plane];
+        cornerX[plane] = p[0] >= 0.0f ? maxX : minX;
+        cornerY[plane] = p[1] >= 0.0f ? maxY : minY;
+        cornerZ[plane] = p[2] >= 0.0f ? maxZ : minZ;
+    }
+
+    size_t i = begin;
+#ifdef FRUSTUM_CULLER_AVX
+    for (; i + 8 <= end; i += 8) {
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int plane = 0; plane < 6; plane++) {
+            const float* p = frustum.planes[plane];
+            __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p[0]), _mm256_loadu_ps(cornerX[plane] + i)),
+                              _mm256_mul_ps(_mm256_set1_ps(p[1]), _mm256_loadu_ps(cornerY[plane] + i))),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p[2]), _mm256_loadu_ps(cornerZ[plane] + i)),
+                              _mm256_set1_ps(p[3])));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        int mask = _mm256_movemask_ps(inside);
+        for (int lane = 0; lane < 8; lane++) {
+            visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+        }
+    }
+#endif
+#ifdef FRUSTUM_CULLER_SSE2
+    for (; i + 4 <= end; i += 4) {
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int plane = 0; plane < 6; plane++) {
+            const float* p = frustum.planes[plane];
+            __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[0]), _mm_loadu_ps(cornerX[plane] + i)),
+                           _mm_mul_ps(_mm_set1_ps(p[1]), _mm_loadu_ps(cornerY[plane] + i))),
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p[2]), _mm_loadu_ps(cornerZ[plane] + i)), _mm_set1_ps(p[3])));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+        }
+        int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; lane++) {
+            visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+        }
+    }
+#endif
+    for (; i < end; i++) {
+        uint8_t inside = 1;
+        for (int plane = 0; plane < 6 && inside; plane++) {
+            const float* p = frustum.planes[plane];
+            inside = p[0] * cornerX[plane][i] + p[1] * cornerY[plane][i] + p[2] * cornerZ[plane][i] + p[3] >= 0.0f;
+        }
+        visible[i] = inside;
+    }
+}
+
+void FrustumCuller::TransformBounds(const Vector3& localMin, const Vector3& localMax, const Vector3& position,
+                                    const Vector3& rotation, Vector3& worldMin, Vector3& worldMax) {
+    if (rotation.x == 0.0f && rotation.y == 0.0f && rotation.z == 0.0f) {
+        worldMin = localMin + position;
+        worldMax = localMax + position;
+        return;
+    }
+
+    // Arvo: the rotated box's half size along each axis sums the absolute
+    // contributions of the local half sizes
+    Matrix4x4 r = Matrix4x4::createRotation(rotation.x, rotation.y, rotation.z);
+    float center[3] = { (localMin.x + localMax.x) * 0.5f, (localMin.y + localMax.y) * 0.5f, (localMin.z + localMax.z) * 0.5f };
+    float extent[3] = { (localMax.x - localMin.x) * 0.5f, (localMax.y - localMin.y) * 0.5f, (localMax.z - localMin.z) * 0.5f };
+    float offset[3] = { position.x, position.y, position.z };
+    float low[3];
+    float high[3];
+    for (int row = 0; row < 3; row++) {
+        float worldCenter = offset[row];
+        float worldExtent = 0.0f;
+        for (int column = 0; column < 3; column++) {
+            worldCenter += r.elements[row][column] * center[column];
+            worldExtent += std::fabs(r.elements[row][column]) * extent[column];
+        }
+        low[row] = worldCenter - worldExtent;
+        high[row] = worldCenter + worldExtent;
+    }
+    worldMin = Vector3(low[0], low[1], low[2]);
+    worldMax = Vector3(high[0], high[1], high[2]);
+}
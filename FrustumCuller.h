@@ -0,0 +1,112 @@
+#ifndef FRUSTUM_CULLER_H
+#define FRUSTUM_CULLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "Vector3.h"
+#include "Matrix4x4.h"
+
+// Tests world-space boxes against camera frustums, several boxes at a time.
+//
+//     culler.Clear();
+//     culler.Add(boundsMin, boundsMax);                    // for every model, once a frame
+//     const std::vector<uint8_t>& visible = culler.Cull(view, projection);   // per camera
+//
+// Boxes are kept as separate arrays of min and max coordinates, so one
+// plane is tested against 4 boxes at once with SSE, or 8 when built with
+// AVX. Large frames are split across the JobSystem workers.
+//
+// Cameras culled in the same frame share their results: a camera with the
+// frustum of an earlier one gets its result back, and a camera whose
+// frustum lies inside an earlier one's (a zoomed view, a minimap inside
+// the main view) only tests the boxes that camera saw.
+class FrustumCuller {
+public:
+    // Six planes (left, right, bottom, top, near, far) as a, b, c, d with
+    // the normal pointing inwards, so points inside have a*x + b*y + c*z + d >= 0
+    struct Frustum {
+        float planes[6][4];
+
+        // Planes of the camera drawn with these matrices. The matrices are
+        // laid out as they are uploaded to the shaders, which makes the
+        // combined matrix view * projection in Matrix4x4's multiply.
+        static Frustum FromMatrices(const Matrix4x4& view, const Matrix4x4& projection);
+
+        // Whether the box is at least partly inside
+        bool Intersects(const Vector3& boundsMin, const Vector3& boundsMax) const;
+
+        // Whether the whole of another frustum is inside this one. False
+        // when the other's corners cannot be found (an infinite far plane).
+        bool Contains(const Frustum& other) const;
+
+        // Points where three planes meet, near ones first; false if the
+        // planes do not close
+        bool GetCorners(Vector3 corners[8]) const;
+    };
+
+    // What the culls since the last Clear did
+    struct Stats {
+        size_t cameras = 0;
+        size_t boxesTested = 0;     // Summed over cameras; shared results test fewer
+        size_t boxesVisible = 0;
+        size_t sharedResults = 0;   // Cameras that reused or narrowed an earlier result
+    };
+
+    // Below this many boxes a cull stays on the calling thread
+    static const size_t PARALLEL_THRESHOLD = 16384;
+
+    FrustumCuller();
+
+    // Forget the boxes and the results of the last frame
+    void Clear();
+
+    // Add a world-space box; returns its index in the results
+    size_t Add(const Vector3& boundsMin, const Vector3& boundsMax);
+
+    size_t GetCount() const { return boundsMinX.size(); }
+
+    // One byte per box, non-zero if the camera can see it. Valid until the
+    // next Clear.
+    const std::vector<uint8_t>& Cull(const Matrix4x4& view, const Matrix4x4& projection);
+    const std::vector<uint8_t>& Cull(const Frustum& frustum);
+
+    const Stats& GetStats() const { return stats; }
+
+    // Box of a model-space box after rotating it by rotation (as
+    // Matrix4x4::createRotation, in degrees) and moving it to position
+    static void TransformBounds(const Vector3& localMin, const Vector3& localMax, const Vector3& position,
+                                const Vector3& rotation, Vector3& worldMin, Vector3& worldMax);
+
+    // Test boxes [begin, end) of the arrays against the frustum, writing
+    // one byte per box to visible
+    static void TestBoxes(const Frustum& frustum, const float* minX, const float* minY, const float* minZ,
+                          const float* maxX, const float* maxY, const float* maxZ,
+                          size_t begin, size_t end, uint8_t* visible);
+
+private:
+    struct CameraResult {
+        Frustum frustum;
+        std::vector<uint8_t> visible;
+        std::vector<uint32_t> visibleIndices;
+    };
+
+    void CullAll(const Frustum& frustum, std::vector<uint8_t>& visible);
+    void CullCandidates(const Frustum& frustum, const std::vector<uint32_t>& candidates, std::vector<uint8_t>& visible);
+
+    std::vector<float> boundsMinX, boundsMinY, boundsMinZ;
+    std::vector<float> boundsMaxX, boundsMaxY, boundsMaxZ;
+
+    // Candidates of a narrowed cull, gathered so they test as a batch
+    std::vector<float> gathered[6];
+    std::vector<uint8_t> gatheredVisible;
+
+    // Results of this frame; a deque so earlier results stay in place
+    std::deque<CameraResult> results;
+    size_t resultCount;
+
+    Stats stats;
+};
+
+#endif // FRUSTUM_CULLER_H
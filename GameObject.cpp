@@ -23,11 +23,13 @@ void GameObject::Render(const std::vector<PointLight>& lightss) {
 // AddLight implementation
 void GameObject::AddLight(PointLight light) {
     lights.push_back(light);
+    MarkDirty(DIRTY_COMPONENTS);
 }
 
 // AddDirectionalLight implementation
 void GameObject::AddDirectionalLight(DirectionalLight light) {
     directionalLights.push_back(light);
+    MarkDirty(DIRTY_COMPONENTS);
 }
 
 void GameObject::UpdateComponents(float deltaTime) {
@@ -37,6 +39,27 @@ void GameObject::UpdateComponents(float deltaTime) {
     }
 }
 
+void GameObject::SendCollisionMessage(CollisionPhase phase) {
+    for (auto& component : components) {
+        switch (phase) {
+            case CollisionPhase::ENTER: component->OnCollisionEnter(); break;
+            case CollisionPhase::STAY:  component->OnCollisionStay();  break;
+            case CollisionPhase::EXIT:  component->OnCollisionExit();  break;
+        }
+    }
+}
+
+void GameObject::SendEnableMessage(bool enable) {
+    for (auto& component : components) {
+        if (enable) {
+            component->OnEnable();
+        } else {
+            component->OnDisable();
+            component->StopAllCoroutines();
+        }
+    }
+}
+
 Vector3 GameObject::GetPosition() const {
     return position;
 }
@@ -57,12 +80,14 @@ void GameObject::RemoveMesh(Model* mesh) {
     auto it = std::find(meshes.begin(), meshes.end(), mesh);
     if (it != meshes.end()) {
         meshes.erase(it);
+        MarkDirty(DIRTY_COMPONENTS);
     }
 }
 
 void GameObject::AddComponent(std::shared_ptr<MonoBehaviourLike> component) {
     if (component) {
         components.push_back(component);
+        MarkDirty(DIRTY_COMPONENTS);
     }
 }
 
@@ -74,28 +99,34 @@ void GameObject::RemoveComponent(std::shared_ptr<MonoBehaviourLike> component) {
     auto it = std::find(components.begin(), components.end(), component);
     if (it != components.end()) {
         components.erase(it);
+        MarkDirty(DIRTY_COMPONENTS);
     }
 }
 
 void GameObject::SetPosition(const Vector3& pos) {
     position = pos;
+    MarkDirty(DIRTY_TRANSFORM);
 }
 
 void GameObject::SetRotation(const Vector3& rot) {
     rotation = rot;
+    MarkDirty(DIRTY_TRANSFORM);
 }
 
 void GameObject::SetScale(const Vector3& scale) {
     size = scale;
+    MarkDirty(DIRTY_TRANSFORM);
 }
 
 void GameObject::SetName(const std::string& newName) {
     name = newName;
+    MarkDirty(DIRTY_PROPERTIES);
 }
 
 void GameObject::AddChild(GameObject* child) {
     if (child) {
         childGameObjects.push_back(child);
+        MarkDirty(DIRTY_HIERARCHY);
     }
 }
 
@@ -107,6 +138,7 @@ void GameObject::RemoveChild(GameObject* child) {
     auto it = std::find(childGameObjects.begin(), childGameObjects.end(), child);
     if (it != childGameObjects.end()) {
         childGameObjects.erase(it);
+        MarkDirty(DIRTY_HIERARCHY);
     }
 }
 
@@ -161,5 +193,8 @@ void GameObject::Shutdown() {
 }
 
 void GameObject::SetEnabled(bool enabled) {
-    this->enabled = enabled;
+    if (this->enabled != enabled) {
+        this->enabled = enabled;
+        MarkDirty(DIRTY_PROPERTIES);
+    }
 }
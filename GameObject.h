@@ -9,16 +9,43 @@
 #include "PointLight.h"
 #include "DirectionalLight.h"
 #include "Matrix4x4.h"
+#include "EngineEvents.h"
 
 // Forward declaration
 class Model;
 class MonoBehaviourLike;
+class Scene;
 
 class GameObject {
+public:
+    // What changed since the object was last saved (see SceneJournal).
+    // Set by the setters below; code that writes the public fields directly
+    // must call MarkDirty itself, or saves and snapshots will miss the change.
+    enum DirtyFlags : unsigned int {
+        DIRTY_TRANSFORM = 1 << 0,   // position, rotation, scale
+        DIRTY_COMPONENTS = 1 << 1,  // components, lights, meshes
+        DIRTY_HIERARCHY = 1 << 2,   // children added or removed
+        DIRTY_PROPERTIES = 1 << 3,  // name, enabled
+        DIRTY_ALL = DIRTY_TRANSFORM | DIRTY_COMPONENTS | DIRTY_HIERARCHY | DIRTY_PROPERTIES
+    };
+
 private:
     std::string name;
     std::vector<std::shared_ptr<MonoBehaviourLike>> components;
     bool enabled = true;
+    
+    // New objects have never been saved
+    unsigned int dirtyFlags = DIRTY_ALL;
+    
+    // Bumped by every MarkDirty and never cleared, so snapshots can spot
+    // changed objects without consuming the journal's dirty flags
+    unsigned int changeCount = 0;
+    
+    // Identifies the object across saves; 0 until it is first saved
+    unsigned int persistentId = 0;
+    
+    // Scene the object was added to, null while it is in none
+    Scene* scene = nullptr;
 public:
     Vector3 position;
     Vector3 rotation;
@@ -35,6 +62,13 @@ public:
     // Public method to update components
     void UpdateComponents(float deltaTime);
     
+    // Forward a dispatched collision to the OnCollision* hooks of all components
+    void SendCollisionMessage(CollisionPhase phase);
+    
+    // Call OnEnable or OnDisable on all components. Disabling also stops
+    // their coroutines and pending Invoke callbacks.
+    void SendEnableMessage(bool enable);
+    
     
     // Constructors
     GameObject() : name("GameObject"), position(0,0,0), rotation(0,0,0), size(1,1,1) {}
@@ -54,6 +88,7 @@ public:
     template<typename T>
     std::shared_ptr<T> AddComponent(std::shared_ptr<T> component) {
         components.push_back(component);
+        MarkDirty(DIRTY_COMPONENTS);
         return component;
     }
     
@@ -61,12 +96,14 @@ public:
     template<typename T>
     T* AddComponent(T* component) {
         components.push_back(std::shared_ptr<MonoBehaviourLike>(component));
+        MarkDirty(DIRTY_COMPONENTS);
         return component;
     }
     
     // Add a mesh to the GameObject
     void AddMesh(Model* mesh) {
         meshes.push_back(mesh);
+        MarkDirty(DIRTY_COMPONENTS);
     }
     
     // Get all components of a specific type
@@ -132,6 +169,20 @@ public:
     std::vector<GameObject*> GetChildren() const { return childGameObjects; }
     void Reset();
     void Shutdown();
+    
+    // Dirty tracking for incremental saves
+    unsigned int GetDirtyFlags() const { return dirtyFlags; }
+    bool IsDirty() const { return dirtyFlags != 0; }
+    void MarkDirty(unsigned int flags = DIRTY_ALL) { dirtyFlags |= flags; changeCount++; }
+    void ClearDirty() { dirtyFlags = 0; }
+    unsigned int GetChangeCount() const { return changeCount; }
+    
+    unsigned int GetPersistentId() const { return persistentId; }
+    void SetPersistentId(unsigned int id) { persistentId = id; }
+    
+    // Set by Scene when the object is added to or removed from it
+    Scene* GetScene() const { return scene; }
+    void SetScene(Scene* owner) { scene = owner; }
 };
 
 #endif // GAMEOBJECT_H
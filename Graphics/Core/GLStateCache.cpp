@@ -0,0 +1,246 @@
+#include "GLStateCache.h"
+
+namespace {
+    const unsigned int UNKNOWN = 0xFFFFFFFFu;
+}
+
+GLStateCache::GLStateCache(const GLFunctionTable& functions) : gl(functions) {
+    Invalidate();
+}
+
+int GLStateCache::GetTargetIndex(unsigned int target) {
+    switch (target) {
+        case ARRAY_BUFFER: return TARGET_ARRAY;
+        case ELEMENT_ARRAY_BUFFER: return TARGET_ELEMENT_ARRAY;
+        case UNIFORM_BUFFER: return TARGET_UNIFORM;
+        default: return -1;
+    }
+}
+
+int GLStateCache::GetCapabilityIndex(unsigned int capability) {
+    switch (capability) {
+        case DEPTH_TEST: return 0;
+        case CULL_FACE: return 1;
+        case BLEND: return 2;
+        default: return -1;
+    }
+}
+
+void GLStateCache::Issued() {
+    frameStats.issued++;
+    totalStats.issued++;
+}
+
+void GLStateCache::Filtered() {
+    frameStats.filtered++;
+    totalStats.filtered++;
+}
+
+void GLStateCache::BindVertexArray(unsigned int vao) {
+    if (vao == vertexArray) {
+        Filtered();
+        return;
+    }
+    gl.bindVertexArray(vao);
+    Issued();
+    vertexArray = vao;
+    // The element array binding is part of the vertex array
+    buffers[TARGET_ELEMENT_ARRAY] = UNKNOWN;
+}
+
+void GLStateCache::BindBuffer(unsigned int target, unsigned int buffer) {
+    int index = GetTargetIndex(target);
+    if (index >= 0 && buffers[index] == buffer) {
+        Filtered();
+        return;
+    }
+    gl.bindBuffer(target, buffer);
+    Issued();
+    if (index >= 0) {
+        buffers[index] = buffer;
+    }
+}
+
+void GLStateCache::BindBufferBase(unsigned int target, unsigned int index, unsigned int buffer) {
+    bool tracked = target == UNIFORM_BUFFER && index < static_cast<unsigned int>(MAX_UNIFORM_BINDINGS);
+    if (tracked && uniformBindings[index] == buffer) {
+        Filtered();
+        return;
+    }
+    gl.bindBufferBase(target, index, buffer);
+    Issued();
+    if (tracked) {
+        uniformBindings[index] = buffer;
+    }
+    // glBindBufferBase binds the generic target too
+    int targetIndex = GetTargetIndex(target);
+    if (targetIndex >= 0) {
+        buffers[targetIndex] = buffer;
+    }
+}
+
+void GLStateCache::UseProgram(unsigned int newProgram) {
+    if (newProgram == program) {
+        Filtered();
+        return;
+    }
+    gl.useProgram(newProgram);
+    Issued();
+    program = newProgram;
+}
+
+void GLStateCache::BindTexture(unsigned int unit, unsigned int texture) {
+    if (unit >= static_cast<unsigned int>(MAX_TEXTURE_UNITS)) {
+        gl.activeTexture(TEXTURE0 + unit);
+        gl.bindTexture(TEXTURE_2D, texture);
+        Issued();
+        Issued();
+        activeUnit = unit;
+        return;
+    }
+    if (textures[unit] == texture) {
+        Filtered();
+        return;
+    }
+    if (activeUnit != unit) {
+        gl.activeTexture(TEXTURE0 + unit);
+        Issued();
+        activeUnit = unit;
+    }
+    gl.bindTexture(TEXTURE_2D, texture);
+    Issued();
+    textures[unit] = texture;
+}
+
+void GLStateCache::SetEnabled(unsigned int capability, bool enabled) {
+    int index = GetCapabilityIndex(capability);
+    int state = enabled ? 1 : 0;
+    if (index >= 0 && capabilities[index] == state) {
+        Filtered();
+        return;
+    }
+    if (enabled) {
+        gl.enable(capability);
+    } else {
+        gl.disable(capability);
+    }
+    Issued();
+    if (index >= 0) {
+        capabilities[index] = state;
+    }
+}
+
+void GLStateCache::DepthFunc(unsigned int func) {
+    if (func == depthFunc) {
+        Filtered();
+        return;
+    }
+    gl.depthFunc(func);
+    Issued();
+    depthFunc = func;
+}
+
+void GLStateCache::CullFace(unsigned int mode) {
+    if (mode == cullFaceMode) {
+        Filtered();
+        return;
+    }
+    gl.cullFace(mode);
+    Issued();
+    cullFaceMode = mode;
+}
+
+void GLStateCache::BlendFunc(unsigned int source, unsigned int destination) {
+    if (source == blendSource && destination == blendDestination) {
+        Filtered();
+        return;
+    }
+    gl.blendFunc(source, destination);
+    Issued();
+    blendSource = source;
+    blendDestination = destination;
+}
+
+void GLStateCache::Viewport(int x, int y, int width, int height) {
+    if (viewportKnown && viewport[0] == x && viewport[1] == y && viewport[2] == width && viewport[3] == height) {
+        Filtered();
+        return;
+    }
+    gl.viewport(x, y, width, height);
+    Issued();
+    viewport[0] = x;
+    viewport[1] = y;
+    viewport[2] = width;
+    viewport[3] = height;
+    viewportKnown = true;
+}
+
+void GLStateCache::OnVertexArrayDeleted(unsigned int vao) {
+    if (vao != 0 && vertexArray == vao) {
+        vertexArray = 0;
+        buffers[TARGET_ELEMENT_ARRAY] = UNKNOWN;
+    }
+}
+
+void GLStateCache::OnBufferDeleted(unsigned int buffer) {
+    if (buffer == 0) {
+        return;
+    }
+    for (unsigned int& bound : buffers) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+    for (unsigned int& bound : uniformBindings) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+}
+
+void GLStateCache::OnProgramDeleted(unsigned int deleted) {
+    // A program in use stays current until another is used, so the
+    // binding is unchanged; only the name may come back for a new program
+    if (deleted != 0 && program == deleted) {
+        program = UNKNOWN;
+    }
+}
+
+void GLStateCache::OnTextureDeleted(unsigned int texture) {
+    if (texture == 0) {
+        return;
+    }
+    for (unsigned int& bound : textures) {
+        if (bound == texture) {
+            bound = 0;
+        }
+    }
+}
+
+void GLStateCache::Invalidate() {
+    vertexArray = UNKNOWN;
+    for (unsigned int& bound : buffers) {
+        bound = UNKNOWN;
+    }
+    for (unsigned int& bound : uniformBindings) {
+        bound = UNKNOWN;
+    }
+    program = UNKNOWN;
+    activeUnit = UNKNOWN;
+    for (unsigned int& bound : textures) {
+        bound = UNKNOWN;
+    }
+    for (int& state : capabilities) {
+        state = -1;
+    }
+    depthFunc = UNKNOWN;
+    cullFaceMode = UNKNOWN;
+    blendSource = UNKNOWN;
+    blendDestination = UNKNOWN;
+    viewportKnown = false;
+}
+
+void GLStateCache::EndFrame() {
+    lastFrameStats = frameStats;
+    frameStats = Stats();
+}
@@ -0,0 +1,119 @@
+#ifndef GAME_ENGINE_SAVI_GL_STATE_CACHE_H
+#define GAME_ENGINE_SAVI_GL_STATE_CACHE_H
+
+#include <cstddef>
+
+// The GL calls GLStateCache makes. OpenGLGraphicsAPI fills it with the real
+// functions; tests fill it with mocks and run without a context.
+struct GLFunctionTable {
+    void (*bindVertexArray)(unsigned int vao);
+    void (*bindBuffer)(unsigned int target, unsigned int buffer);
+    void (*bindBufferBase)(unsigned int target, unsigned int index, unsigned int buffer);
+    void (*useProgram)(unsigned int program);
+    void (*activeTexture)(unsigned int unit);   // GL_TEXTURE0 + unit
+    void (*bindTexture)(unsigned int target, unsigned int texture);
+    void (*enable)(unsigned int capability);
+    void (*disable)(unsigned int capability);
+    void (*depthFunc)(unsigned int func);
+    void (*cullFace)(unsigned int mode);
+    void (*blendFunc)(unsigned int source, unsigned int destination);
+    void (*viewport)(int x, int y, int width, int height);
+};
+
+// Shadow copy of the GL state OpenGLGraphicsAPI changes: the vertex array,
+// the buffer bound to each target and uniform binding, the program, the
+// texture of every unit, depth/cull/blend state and the viewport. A call
+// that would set what is already set is dropped.
+//
+// State starts out unknown, so the first call of each kind always reaches
+// GL. Code that changes GL state behind the cache's back (glPushAttrib,
+// a new context) has to call Invalidate afterwards.
+class GLStateCache {
+public:
+    // GL enums the cache needs, so that it does not need the GL headers
+    static const unsigned int TEXTURE_2D = 0x0DE1;
+    static const unsigned int TEXTURE0 = 0x84C0;
+    static const unsigned int ARRAY_BUFFER = 0x8892;
+    static const unsigned int ELEMENT_ARRAY_BUFFER = 0x8893;
+    static const unsigned int UNIFORM_BUFFER = 0x8A11;
+    static const unsigned int DEPTH_TEST = 0x0B71;
+    static const unsigned int CULL_FACE = 0x0B44;
+    static const unsigned int BLEND = 0x0BE2;
+
+    static const int MAX_TEXTURE_UNITS = 32;
+    static const int MAX_UNIFORM_BINDINGS = 16;
+
+    // GL calls made and dropped
+    struct Stats {
+        size_t issued = 0;
+        size_t filtered = 0;
+    };
+
+    explicit GLStateCache(const GLFunctionTable& functions);
+
+    void BindVertexArray(unsigned int vao);
+    void BindBuffer(unsigned int target, unsigned int buffer);
+    void BindBufferBase(unsigned int target, unsigned int index, unsigned int buffer);
+    void UseProgram(unsigned int program);
+    void BindTexture(unsigned int unit, unsigned int texture);
+    void SetEnabled(unsigned int capability, bool enabled);
+    void DepthFunc(unsigned int func);
+    void CullFace(unsigned int mode);
+    void BlendFunc(unsigned int source, unsigned int destination);
+    void Viewport(int x, int y, int width, int height);
+
+    // Deleted objects are unbound by GL; a new object can reuse the name
+    void OnVertexArrayDeleted(unsigned int vao);
+    void OnBufferDeleted(unsigned int buffer);
+    void OnProgramDeleted(unsigned int program);
+    void OnTextureDeleted(unsigned int texture);
+
+    // Forget all state; the next call of each kind reaches GL
+    void Invalidate();
+
+    // Counts of the frame in progress, of the last finished frame, and
+    // since the cache was created
+    const Stats& GetFrameStats() const { return frameStats; }
+    const Stats& GetLastFrameStats() const { return lastFrameStats; }
+    const Stats& GetTotalStats() const { return totalStats; }
+
+    // Finish the frame's counts; called when buffers are swapped
+    void EndFrame();
+
+private:
+    // Buffer targets the cache tracks
+    enum Target {
+        TARGET_ARRAY,
+        TARGET_ELEMENT_ARRAY,
+        TARGET_UNIFORM,
+        TARGET_COUNT
+    };
+
+    static int GetTargetIndex(unsigned int target);
+    static int GetCapabilityIndex(unsigned int capability);
+
+    void Issued();
+    void Filtered();
+
+    GLFunctionTable gl;
+
+    unsigned int vertexArray;
+    unsigned int buffers[TARGET_COUNT];
+    unsigned int uniformBindings[MAX_UNIFORM_BINDINGS];
+    unsigned int program;
+    unsigned int activeUnit;
+    unsigned int textures[MAX_TEXTURE_UNITS];
+    int capabilities[3];                // 1 enabled, 0 disabled, -1 unknown
+    unsigned int depthFunc;
+    unsigned int cullFaceMode;
+    unsigned int blendSource;
+    unsigned int blendDestination;
+    int viewport[4];
+    bool viewportKnown;
+
+    Stats frameStats;
+    Stats lastFrameStats;
+    Stats totalStats;
+};
+
+#endif // GAME_ENGINE_SAVI_GL_STATE_CACHE_H
@@ -1,6 +1,9 @@
 #include "GraphicsAPIFactory.h"
 #include "OpenGLGraphicsAPI.h"
+#include "NullGraphicsAPI.h"
+#include "RecordingGraphicsAPI.h"
 #include "../../platform.h"
+#include <cstdlib>
 #include <iostream>
 
 // Initialize static instance
@@ -13,7 +16,8 @@ GraphicsAPIFactory& GraphicsAPIFactory::GetInstance() {
     return *instance;
 }
 
-GraphicsAPIFactory::GraphicsAPIFactory() : graphicsAPI(nullptr) {
+GraphicsAPIFactory::GraphicsAPIFactory()
+    : graphicsAPI(nullptr), backend(GraphicsBackend::OPENGL), backendChosen(false), traceFileChosen(false) {
 }
 
 GraphicsAPIFactory::~GraphicsAPIFactory() {
@@ -23,17 +27,53 @@ GraphicsAPIFactory::~GraphicsAPIFactory() {
     }
 }
 
+void GraphicsAPIFactory::SetBackend(GraphicsBackend newBackend) {
+    backend = newBackend;
+    backendChosen = true;
+}
+
+void GraphicsAPIFactory::SetTraceFile(const std::string& path) {
+    traceFile = path;
+    traceFileChosen = true;
+}
+
 bool GraphicsAPIFactory::Initialize() {
-    // Create the graphics API using OpenGL on all platforms
+    GraphicsBackend selected = backend;
+    if (!backendChosen) {
+        const char* name = std::getenv("SAVI_GRAPHICS_BACKEND");
+        if (name && std::string(name) == "null") {
+            selected = GraphicsBackend::NULL_API;
+        } else if (name && std::string(name) != "opengl") {
+            std::cout << "Unknown graphics backend " << name << ", using OpenGL" << std::endl;
+        }
+    }
+    std::string trace = traceFile;
+    if (!traceFileChosen) {
+        const char* path = std::getenv("SAVI_GRAPHICS_TRACE");
+        trace = path ? path : "";
+    }
+    
     try {
-        graphicsAPI = std::make_shared<OpenGLGraphicsAPI>();
+        std::shared_ptr<IGraphicsAPI> api;
+        if (selected == GraphicsBackend::NULL_API) {
+            api = std::make_shared<NullGraphicsAPI>();
+        } else {
+            // OpenGL on all platforms
+            api = std::make_shared<OpenGLGraphicsAPI>();
+        }
+        if (!trace.empty()) {
+            std::cout << "Recording graphics calls to " << trace << std::endl;
+            api = std::make_shared<RecordingGraphicsAPI>(api, trace);
+        }
+        
+        graphicsAPI = api;
         if (!graphicsAPI->Initialize()) {
-            std::cout << "Failed to initialize OpenGL" << std::endl;
+            std::cout << "Failed to initialize " << graphicsAPI->GetAPIName() << std::endl;
             return false;
         }
-        std::cout << "Successfully initialized OpenGL graphics API" << std::endl;
+        std::cout << "Successfully initialized " << graphicsAPI->GetAPIName() << " graphics API" << std::endl;
     } catch (const std::exception& e) {
-        std::cout << "Exception initializing OpenGL: " << e.what() << std::endl;
+        std::cout << "Exception initializing graphics API: " << e.what() << std::endl;
         return false;
     }
     
@@ -2,13 +2,30 @@
 #define GRAPHICS_API_FACTORY_H
 
 #include <memory>
+#include <string>
 #include "IGraphicsAPI.h"
 
+// Graphics APIs the factory can create
+enum class GraphicsBackend {
+    OPENGL,
+    NULL_API    // Draws nothing, counts calls; see NullGraphicsAPI
+};
+
 class GraphicsAPIFactory {
 public:
     static GraphicsAPIFactory& GetInstance();
     
-    // Initialize the appropriate graphics API based on platform
+    // Choose the graphics API Initialize creates. Without a choice the
+    // SAVI_GRAPHICS_BACKEND environment variable ("opengl" or "null")
+    // decides, and OpenGL is the default.
+    void SetBackend(GraphicsBackend backend);
+    
+    // Record every graphics call to a trace file (see RecordingGraphicsAPI);
+    // an empty path records nothing. Without a choice the
+    // SAVI_GRAPHICS_TRACE environment variable names the file.
+    void SetTraceFile(const std::string& path);
+    
+    // Initialize the chosen graphics API
     bool Initialize();
     
     // Get the current graphics API
@@ -23,6 +40,11 @@ private:
     
     // Current graphics API
     std::shared_ptr<IGraphicsAPI> graphicsAPI;
+    
+    GraphicsBackend backend;
+    bool backendChosen;
+    std::string traceFile;
+    bool traceFileChosen;
 };
 
 #endif // GRAPHICS_API_FACTORY_H
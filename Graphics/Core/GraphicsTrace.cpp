@@ -0,0 +1,683 @@
+#include "GraphicsTrace.h"
+#include "IGraphicsAPI.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <utility>
+
+namespace {
+    const uint8_t MAGIC[4] = { 'S', 'G', 'T', 'R' };
+
+    const char* COMMAND_NAMES[] = {
+        "INVALID",
+        "CREATE_VERTEX_ARRAY", "BIND_VERTEX_ARRAY", "DELETE_VERTEX_ARRAY",
+        "CREATE_BUFFER", "BIND_BUFFER", "DELETE_BUFFER", "BUFFER_DATA",
+        "ENABLE_VERTEX_ATTRIB", "DISABLE_VERTEX_ATTRIB", "VERTEX_ATTRIB_POINTER",
+        "DRAW_ARRAYS", "DRAW_ELEMENTS",
+        "SET_VIEWPORT", "BEGIN_2D", "END_2D", "CLEAR", "SET_CLEAR_COLOR",
+        "SET_DEPTH_TEST", "SET_DEPTH_FUNC", "SET_CULL_FACE", "SET_CULL_FACE_MODE",
+        "USE_PROGRAM", "CREATE_SHADER", "DELETE_SHADER", "SHADER_SOURCE", "COMPILE_SHADER",
+        "ATTACH_SHADER", "LINK_PROGRAM", "CREATE_PROGRAM", "DELETE_PROGRAM",
+        "SET_UNIFORM_BY_NAME", "SET_UNIFORM", "GET_UNIFORM_LOCATION", "GET_ACTIVE_UNIFORMS",
+        "SET_UNIFORM_BLOCK_BINDING", "BIND_UNIFORM_BUFFER",
+        "CREATE_TEXTURE", "BIND_TEXTURE", "DELETE_TEXTURE", "TEX_IMAGE_2D",
+        "DRAW_DEBUG_LINE", "DRAW_DEBUG_AXES", "READ_PIXELS", "SWAP_BUFFERS",
+        "USE_DEFAULT_RED_SHADER", "SET_PROJECTION_MATRIX", "SET_VIEW_MATRIX", "SET_MODEL_MATRIX",
+        "VERTEX_ATTRIB_DIVISOR", "DRAW_ARRAYS_INSTANCED", "DRAW_ELEMENTS_INSTANCED",
+        "SET_TEXTURE_LEVELS", "TEX_IMAGE_LEVEL"
+    };
+    static_assert(sizeof(COMMAND_NAMES) / sizeof(COMMAND_NAMES[0]) == GraphicsTrace::COMMAND_COUNT,
+                  "Every command needs a name");
+
+    // Reads arguments back; past the end every read fails and returns 0
+    class Reader {
+    public:
+        Reader(const std::vector<uint8_t>& bytes, size_t offset) : bytes(bytes), offset(offset), failed(false) {}
+
+        bool AtEnd() const { return offset >= bytes.size(); }
+        bool Failed() const { return failed; }
+
+        uint8_t U8() {
+            if (!Need(1)) {
+                return 0;
+            }
+            return bytes[offset++];
+        }
+
+        bool Flag() { return U8() != 0; }
+
+        uint32_t U32() {
+            if (!Need(4)) {
+                return 0;
+            }
+            uint32_t value = 0;
+            for (int i = 0; i < 4; i++) {
+                value |= static_cast<uint32_t>(bytes[offset++]) << (8 * i);
+            }
+            return value;
+        }
+
+        int32_t I32() { return static_cast<int32_t>(U32()); }
+
+        uint64_t U64() {
+            uint64_t low = U32();
+            uint64_t high = U32();
+            return low | (high << 32);
+        }
+
+        float Float() {
+            uint32_t bits = U32();
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        void Floats(std::vector<float>& values, size_t count) {
+            // Four bytes a value have to be there before anything is allocated
+            values.clear();
+            if (!Need(count * 4)) {
+                return;
+            }
+            values.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                values[i] = Float();
+            }
+        }
+
+        void Ints(std::vector<int>& values, size_t count) {
+            values.clear();
+            if (!Need(count * 4)) {
+                return;
+            }
+            values.resize(count);
+            for (size_t i = 0; i < count; i++) {
+                values[i] = I32();
+            }
+        }
+
+        std::string String() {
+            uint32_t size = U32();
+            if (size == 0 || !Need(size)) {
+                return std::string();
+            }
+            std::string value(reinterpret_cast<const char*>(&bytes[offset]), size);
+            offset += size;
+            return value;
+        }
+
+        // Null when the writer had null data; size is set either way
+        const uint8_t* Data(size_t& size) {
+            bool present = Flag();
+            size = static_cast<size_t>(U64());
+            if (!present || failed) {
+                return nullptr;
+            }
+            if (!Need(size)) {
+                return nullptr;
+            }
+            if (size == 0) {
+                return bytes.data();
+            }
+            const uint8_t* data = &bytes[offset];
+            offset += size;
+            return data;
+        }
+
+    private:
+        bool Need(size_t size) {
+            if (failed || bytes.size() - offset < size) {
+                failed = true;
+                return false;
+            }
+            return true;
+        }
+
+        const std::vector<uint8_t>& bytes;
+        size_t offset;
+        bool failed;
+    };
+
+    // Trace handles and locations to those of the API replayed on. Names
+    // the trace did not create pass through unchanged.
+    class HandleMap {
+    public:
+        void Add(uint32_t traced, unsigned int actual) { handles[traced] = actual; }
+
+        unsigned int Get(uint32_t traced) const {
+            auto found = handles.find(traced);
+            return found == handles.end() ? traced : found->second;
+        }
+
+    private:
+        std::map<uint32_t, unsigned int> handles;
+    };
+
+    Matrix4x4 ReadMatrix(Reader& reader) {
+        Matrix4x4 matrix;
+        for (int row = 0; row < 4; row++) {
+            for (int column = 0; column < 4; column++) {
+                matrix.elements[row][column] = reader.Float();
+            }
+        }
+        return matrix;
+    }
+
+    Vector3 ReadVector(Reader& reader) {
+        float x = reader.Float();
+        float y = reader.Float();
+        float z = reader.Float();
+        return Vector3(x, y, z);
+    }
+}
+
+GraphicsTrace::Writer::Writer() : commandCount(0) {
+    bytes.insert(bytes.end(), MAGIC, MAGIC + 4);
+    U32(VERSION);
+}
+
+void GraphicsTrace::Writer::U32(uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void GraphicsTrace::Writer::U64(uint64_t value) {
+    U32(static_cast<uint32_t>(value));
+    U32(static_cast<uint32_t>(value >> 32));
+}
+
+void GraphicsTrace::Writer::Float(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    U32(bits);
+}
+
+void GraphicsTrace::Writer::Floats(const float* values, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        Float(values ? values[i] : 0.0f);
+    }
+}
+
+void GraphicsTrace::Writer::Ints(const int* values, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        I32(values ? values[i] : 0);
+    }
+}
+
+void GraphicsTrace::Writer::String(const std::string& value) {
+    U32(static_cast<uint32_t>(value.size()));
+    bytes.insert(bytes.end(), value.begin(), value.end());
+}
+
+void GraphicsTrace::Writer::Data(const void* data, size_t size) {
+    Flag(data != nullptr);
+    U64(size);
+    if (data) {
+        const uint8_t* begin = static_cast<const uint8_t*>(data);
+        bytes.insert(bytes.end(), begin, begin + size);
+    }
+}
+
+void GraphicsTrace::Writer::TakeBytes(std::vector<uint8_t>& out) {
+    out.swap(bytes);
+    bytes.clear();
+}
+
+bool GraphicsTrace::Load(const std::string& path, std::vector<uint8_t>& trace) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Cannot open graphics trace " << path << std::endl;
+        return false;
+    }
+    trace.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    if (trace.size() < HEADER_SIZE || std::memcmp(trace.data(), MAGIC, 4) != 0) {
+        std::cerr << path << " is not a graphics trace" << std::endl;
+        trace.clear();
+        return false;
+    }
+    uint32_t version = trace[4] | (trace[5] << 8) | (trace[6] << 16) | (static_cast<uint32_t>(trace[7]) << 24);
+    if (version != VERSION) {
+        std::cerr << path << " is a version " << version << " graphics trace, expected " << VERSION << std::endl;
+        trace.clear();
+        return false;
+    }
+    return true;
+}
+
+bool GraphicsTrace::Save(const std::string& path, const std::vector<uint8_t>& trace) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Cannot write graphics trace " << path << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(trace.data()), static_cast<std::streamsize>(trace.size()));
+    return static_cast<bool>(file);
+}
+
+const char* GraphicsTrace::GetCommandName(uint8_t command) {
+    if (command == 0 || command >= COMMAND_COUNT) {
+        return "INVALID";
+    }
+    return COMMAND_NAMES[command];
+}
+
+bool GraphicsTrace::Replay(const std::vector<uint8_t>& trace, IGraphicsAPI* graphics, ReplayResult& result) {
+    typedef std::chrono::high_resolution_clock Clock;
+
+    result = ReplayResult();
+    if (!graphics) {
+        result.error = "No graphics API to replay on";
+        return false;
+    }
+    if (trace.size() < HEADER_SIZE || std::memcmp(trace.data(), MAGIC, 4) != 0) {
+        result.error = "Not a graphics trace";
+        return false;
+    }
+
+    HandleMap vertexArrays, buffers, shaders, programs, textures;
+    // Uniform locations by trace program, as locations are per program
+    std::map<std::pair<uint32_t, int32_t>, int> locations;
+    uint32_t currentProgram = 0;
+    std::vector<float> floats;
+    std::vector<int> ints;
+    std::vector<unsigned char> pixels;
+
+    auto mapLocation = [&](int32_t location) -> int {
+        auto found = locations.find(std::make_pair(currentProgram, location));
+        return found == locations.end() ? location : found->second;
+    };
+
+    Reader reader(trace, HEADER_SIZE);
+    Clock::time_point start = Clock::now();
+    Clock::time_point frameStart = start;
+
+    while (!reader.AtEnd()) {
+        uint8_t command = reader.U8();
+        switch (command) {
+            case CREATE_VERTEX_ARRAY: {
+                uint32_t traced = reader.U32();
+                vertexArrays.Add(traced, graphics->CreateVertexArray());
+                break;
+            }
+            case BIND_VERTEX_ARRAY:
+                graphics->BindVertexArray(vertexArrays.Get(reader.U32()));
+                break;
+            case DELETE_VERTEX_ARRAY:
+                graphics->DeleteVertexArray(vertexArrays.Get(reader.U32()));
+                break;
+            case CREATE_BUFFER: {
+                uint32_t traced = reader.U32();
+                buffers.Add(traced, graphics->CreateBuffer());
+                break;
+            }
+            case BIND_BUFFER: {
+                BufferType type = static_cast<BufferType>(reader.U8());
+                graphics->BindBuffer(type, buffers.Get(reader.U32()));
+                break;
+            }
+            case DELETE_BUFFER:
+                graphics->DeleteBuffer(buffers.Get(reader.U32()));
+                break;
+            case BUFFER_DATA: {
+                BufferType type = static_cast<BufferType>(reader.U8());
+                bool dynamic = reader.Flag();
+                size_t size = 0;
+                const uint8_t* data = reader.Data(size);
+                if (!reader.Failed()) {
+                    graphics->BufferData(type, data, size, dynamic);
+                }
+                break;
+            }
+            case ENABLE_VERTEX_ATTRIB:
+                graphics->EnableVertexAttrib(reader.U32());
+                break;
+            case DISABLE_VERTEX_ATTRIB:
+                graphics->DisableVertexAttrib(reader.U32());
+                break;
+            case VERTEX_ATTRIB_POINTER: {
+                uint32_t index = reader.U32();
+                int32_t size = reader.I32();
+                AttribType type = static_cast<AttribType>(reader.U8());
+                bool normalized = reader.Flag();
+                size_t stride = static_cast<size_t>(reader.U64());
+                uintptr_t pointer = static_cast<uintptr_t>(reader.U64());
+                graphics->VertexAttribPointer(index, size, type, normalized, stride, reinterpret_cast<const void*>(pointer));
+                break;
+            }
+            case VERTEX_ATTRIB_DIVISOR: {
+                uint32_t index = reader.U32();
+                uint32_t divisor = reader.U32();
+                graphics->VertexAttribDivisor(index, divisor);
+                break;
+            }
+            case DRAW_ARRAYS: {
+                DrawMode mode = static_cast<DrawMode>(reader.U8());
+                int32_t first = reader.I32();
+                int32_t count = reader.I32();
+                graphics->DrawArrays(mode, first, count);
+                break;
+            }
+            case DRAW_ELEMENTS: {
+                DrawMode mode = static_cast<DrawMode>(reader.U8());
+                int32_t count = reader.I32();
+                IndexType type = static_cast<IndexType>(reader.U8());
+                uintptr_t indices = static_cast<uintptr_t>(reader.U64());
+                graphics->DrawElements(mode, count, type, reinterpret_cast<const void*>(indices));
+                break;
+            }
+            case DRAW_ARRAYS_INSTANCED: {
+                DrawMode mode = static_cast<DrawMode>(reader.U8());
+                int32_t first = reader.I32();
+                int32_t count = reader.I32();
+                int32_t instanceCount = reader.I32();
+                graphics->DrawArraysInstanced(mode, first, count, instanceCount);
+                break;
+            }
+            case DRAW_ELEMENTS_INSTANCED: {
+                DrawMode mode = static_cast<DrawMode>(reader.U8());
+                int32_t count = reader.I32();
+                IndexType type = static_cast<IndexType>(reader.U8());
+                uintptr_t indices = static_cast<uintptr_t>(reader.U64());
+                int32_t instanceCount = reader.I32();
+                graphics->DrawElementsInstanced(mode, count, type, reinterpret_cast<const void*>(indices), instanceCount);
+                break;
+            }
+            case SET_VIEWPORT: {
+                int32_t x = reader.I32();
+                int32_t y = reader.I32();
+                int32_t width = reader.I32();
+                int32_t height = reader.I32();
+                graphics->SetViewport(x, y, width, height);
+                break;
+            }
+            case BEGIN_2D:
+                graphics->Begin2D();
+                break;
+            case END_2D:
+                graphics->End2D();
+                break;
+            case CLEAR: {
+                bool color = reader.Flag();
+                bool depth = reader.Flag();
+                graphics->Clear(color, depth);
+                break;
+            }
+            case SET_CLEAR_COLOR:
+                reader.Floats(floats, 4);
+                if (!reader.Failed()) {
+                    graphics->SetClearColor(floats[0], floats[1], floats[2], floats[3]);
+                }
+                break;
+            case SET_DEPTH_TEST:
+                graphics->SetDepthTest(reader.Flag());
+                break;
+            case SET_DEPTH_FUNC:
+                graphics->SetDepthFunc(reader.I32());
+                break;
+            case SET_CULL_FACE:
+                graphics->SetCullFace(reader.Flag());
+                break;
+            case SET_CULL_FACE_MODE:
+                graphics->SetCullFaceMode(reader.I32());
+                break;
+            case USE_PROGRAM:
+                currentProgram = reader.U32();
+                graphics->UseProgram(programs.Get(currentProgram));
+                break;
+            case CREATE_SHADER: {
+                int32_t type = reader.I32();
+                uint32_t traced = reader.U32();
+                shaders.Add(traced, graphics->CreateShader(type));
+                break;
+            }
+            case DELETE_SHADER:
+                graphics->DeleteShader(shaders.Get(reader.U32()));
+                break;
+            case SHADER_SOURCE: {
+                uint32_t shader = reader.U32();
+                std::string source = reader.String();
+                graphics->ShaderSource(shaders.Get(shader), source);
+                break;
+            }
+            case COMPILE_SHADER:
+                graphics->CompileShader(shaders.Get(reader.U32()));
+                break;
+            case ATTACH_SHADER: {
+                uint32_t program = reader.U32();
+                uint32_t shader = reader.U32();
+                graphics->AttachShader(programs.Get(program), shaders.Get(shader));
+                break;
+            }
+            case LINK_PROGRAM:
+                graphics->LinkProgram(programs.Get(reader.U32()));
+                break;
+            case CREATE_PROGRAM: {
+                uint32_t traced = reader.U32();
+                programs.Add(traced, graphics->CreateProgram());
+                break;
+            }
+            case DELETE_PROGRAM:
+                graphics->DeleteProgram(programs.Get(reader.U32()));
+                break;
+            case SET_UNIFORM_BY_NAME:
+            case SET_UNIFORM: {
+                uint8_t kind = reader.U8();
+                unsigned int program = 0;
+                std::string name;
+                int location = -1;
+                if (command == SET_UNIFORM_BY_NAME) {
+                    program = programs.Get(reader.U32());
+                    name = reader.String();
+                } else {
+                    location = mapLocation(reader.I32());
+                }
+                bool byName = command == SET_UNIFORM_BY_NAME;
+
+                switch (kind) {
+                    case UNIFORM_FLOAT: {
+                        float value = reader.Float();
+                        if (byName) graphics->SetUniform1f(program, name, value);
+                        else graphics->SetUniform1f(location, value);
+                        break;
+                    }
+                    case UNIFORM_INT: {
+                        int32_t value = reader.I32();
+                        if (byName) graphics->SetUniform1i(program, name, value);
+                        else graphics->SetUniform1i(location, value);
+                        break;
+                    }
+                    case UNIFORM_VEC3:
+                        reader.Floats(floats, 3);
+                        if (reader.Failed()) break;
+                        if (byName) graphics->SetUniform3f(program, name, floats[0], floats[1], floats[2]);
+                        else graphics->SetUniform3f(location, floats[0], floats[1], floats[2]);
+                        break;
+                    case UNIFORM_VEC4:
+                        reader.Floats(floats, 4);
+                        if (reader.Failed()) break;
+                        if (byName) graphics->SetUniform4f(program, name, floats[0], floats[1], floats[2], floats[3]);
+                        else graphics->SetUniform4f(location, floats[0], floats[1], floats[2], floats[3]);
+                        break;
+                    case UNIFORM_MATRIX4: {
+                        bool transpose = reader.Flag();
+                        reader.Floats(floats, 16);
+                        if (reader.Failed()) break;
+                        if (byName) graphics->SetUniformMatrix4fv(program, name, floats.data(), transpose);
+                        else graphics->SetUniformMatrix4fv(location, floats.data(), transpose);
+                        break;
+                    }
+                    case UNIFORM_FLOAT_ARRAY:
+                    case UNIFORM_VEC3_ARRAY:
+                    case UNIFORM_MATRIX4_ARRAY: {
+                        bool transpose = kind == UNIFORM_MATRIX4_ARRAY ? reader.Flag() : false;
+                        int32_t count = reader.I32();
+                        size_t width = kind == UNIFORM_FLOAT_ARRAY ? 1 : (kind == UNIFORM_VEC3_ARRAY ? 3 : 16);
+                        reader.Floats(floats, count > 0 ? count * width : 0);
+                        if (reader.Failed()) break;
+                        const float* values = floats.data();
+                        if (kind == UNIFORM_FLOAT_ARRAY) {
+                            if (byName) graphics->SetUniformFloatArray(program, name, values, count);
+                            else graphics->SetUniformFloatArray(location, values, count);
+                        } else if (kind == UNIFORM_VEC3_ARRAY) {
+                            if (byName) graphics->SetUniformVec3Array(program, name, values, count);
+                            else graphics->SetUniformVec3Array(location, values, count);
+                        } else {
+                            if (byName) graphics->SetUniformMatrix4Array(program, name, values, count, transpose);
+                            else graphics->SetUniformMatrix4Array(location, values, count, transpose);
+                        }
+                        break;
+                    }
+                    case UNIFORM_INT_ARRAY: {
+                        int32_t count = reader.I32();
+                        reader.Ints(ints, count > 0 ? count : 0);
+                        if (reader.Failed()) break;
+                        if (byName) graphics->SetUniformIntArray(program, name, ints.data(), count);
+                        else graphics->SetUniformIntArray(location, ints.data(), count);
+                        break;
+                    }
+                    default:
+                        result.error = "Unknown uniform kind " + std::to_string(kind);
+                        return false;
+                }
+                break;
+            }
+            case GET_UNIFORM_LOCATION: {
+                uint32_t program = reader.U32();
+                std::string name = reader.String();
+                int32_t traced = reader.I32();
+                locations[std::make_pair(program, traced)] = graphics->GetUniformLocation(programs.Get(program), name);
+                break;
+            }
+            case GET_ACTIVE_UNIFORMS: {
+                uint32_t program = reader.U32();
+                uint32_t count = reader.U32();
+                std::vector<std::string> names;
+                std::vector<int> actual;
+                graphics->GetActiveUniforms(programs.Get(program), names, actual);
+                std::map<std::string, int> byName;
+                for (size_t i = 0; i < names.size() && i < actual.size(); i++) {
+                    byName[names[i]] = actual[i];
+                }
+                for (uint32_t i = 0; i < count && !reader.Failed(); i++) {
+                    std::string name = reader.String();
+                    int32_t traced = reader.I32();
+                    auto found = byName.find(name);
+                    locations[std::make_pair(program, traced)] = found == byName.end() ? -1 : found->second;
+                }
+                break;
+            }
+            case SET_UNIFORM_BLOCK_BINDING: {
+                uint32_t program = reader.U32();
+                std::string block = reader.String();
+                uint32_t binding = reader.U32();
+                graphics->SetUniformBlockBinding(programs.Get(program), block, binding);
+                break;
+            }
+            case BIND_UNIFORM_BUFFER: {
+                uint32_t binding = reader.U32();
+                uint32_t buffer = reader.U32();
+                graphics->BindUniformBuffer(binding, buffers.Get(buffer));
+                break;
+            }
+            case CREATE_TEXTURE: {
+                uint32_t traced = reader.U32();
+                textures.Add(traced, graphics->CreateTexture());
+                break;
+            }
+            case BIND_TEXTURE: {
+                uint32_t texture = reader.U32();
+                uint32_t unit = reader.U32();
+                graphics->BindTexture(textures.Get(texture), unit);
+                break;
+            }
+            case DELETE_TEXTURE:
+                graphics->DeleteTexture(textures.Get(reader.U32()));
+                break;
+            case TEX_IMAGE_2D: {
+                int32_t width = reader.I32();
+                int32_t height = reader.I32();
+                bool hasAlpha = reader.Flag();
+                size_t size = 0;
+                const uint8_t* data = reader.Data(size);
+                if (!reader.Failed()) {
+                    graphics->TexImage2D(width, height, data, hasAlpha);
+                }
+                break;
+            }
+            case SET_TEXTURE_LEVELS:
+                graphics->SetTextureLevels(reader.I32());
+                break;
+            case TEX_IMAGE_LEVEL: {
+                int32_t level = reader.I32();
+                TextureFormat format = static_cast<TextureFormat>(reader.U8());
+                int32_t width = reader.I32();
+                int32_t height = reader.I32();
+                size_t size = 0;
+                const uint8_t* data = reader.Data(size);
+                if (!reader.Failed()) {
+                    graphics->TexImageLevel(level, format, width, height, data, size);
+                }
+                break;
+            }
+            case DRAW_DEBUG_LINE: {
+                Vector3 from = ReadVector(reader);
+                Vector3 to = ReadVector(reader);
+                Vector3 color = ReadVector(reader);
+                graphics->DrawDebugLine(from, to, color);
+                break;
+            }
+            case DRAW_DEBUG_AXES:
+                graphics->DrawDebugAxes();
+                break;
+            case READ_PIXELS: {
+                int32_t x = reader.I32();
+                int32_t y = reader.I32();
+                int32_t width = reader.I32();
+                int32_t height = reader.I32();
+                if (width > 0 && height > 0) {
+                    pixels.resize(static_cast<size_t>(width) * height * 4);
+                    graphics->ReadPixels(x, y, width, height, pixels.data());
+                }
+                break;
+            }
+            case SWAP_BUFFERS: {
+                graphics->SwapBuffers();
+                Clock::time_point now = Clock::now();
+                result.frameMilliseconds.push_back(std::chrono::duration<double, std::milli>(now - frameStart).count());
+                result.frames++;
+                frameStart = now;
+                break;
+            }
+            case USE_DEFAULT_RED_SHADER:
+                currentProgram = 0;
+                graphics->UseDefaultRedShader();
+                break;
+            case SET_PROJECTION_MATRIX:
+                graphics->SetProjectionMatrix(ReadMatrix(reader));
+                break;
+            case SET_VIEW_MATRIX:
+                graphics->SetViewMatrix(ReadMatrix(reader));
+                break;
+            case SET_MODEL_MATRIX:
+                graphics->SetModelMatrix(ReadMatrix(reader));
+                break;
+            default:
+                result.error = "Unknown command " + std::to_string(command) + " after " +
+                               std::to_string(result.commands) + " commands";
+                return false;
+        }
+
+        if (reader.Failed()) {
+            result.error = std::string("Trace ends inside ") + GetCommandName(command) + " after " +
+                           std::to_string(result.commands) + " commands";
+            return false;
+        }
+        result.commands++;
+    }
+
+    result.milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return true;
+}
@@ -0,0 +1,148 @@
+#ifndef GAME_ENGINE_SAVI_GRAPHICS_TRACE_H
+#define GAME_ENGINE_SAVI_GRAPHICS_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class IGraphicsAPI;
+
+// Binary trace of IGraphicsAPI calls, written by RecordingGraphicsAPI and
+// fed back through any graphics API by Replay.
+//
+// A trace is an 8 byte header ("SGTR" and a version) followed by commands:
+// a command byte and its arguments, little endian. Strings and data are
+// prefixed with their size. Create calls store the handle they returned,
+// so replay can map the trace's handles to those of the API it replays
+// on; uniform location lookups are mapped the same way. Queries with no
+// effect (compile status, viewport, input) are not stored.
+class GraphicsTrace {
+public:
+    enum Command : uint8_t {
+        CREATE_VERTEX_ARRAY = 1,
+        BIND_VERTEX_ARRAY,
+        DELETE_VERTEX_ARRAY,
+        CREATE_BUFFER,
+        BIND_BUFFER,
+        DELETE_BUFFER,
+        BUFFER_DATA,
+        ENABLE_VERTEX_ATTRIB,
+        DISABLE_VERTEX_ATTRIB,
+        VERTEX_ATTRIB_POINTER,
+        DRAW_ARRAYS,
+        DRAW_ELEMENTS,
+        SET_VIEWPORT,
+        BEGIN_2D,
+        END_2D,
+        CLEAR,
+        SET_CLEAR_COLOR,
+        SET_DEPTH_TEST,
+        SET_DEPTH_FUNC,
+        SET_CULL_FACE,
+        SET_CULL_FACE_MODE,
+        USE_PROGRAM,
+        CREATE_SHADER,
+        DELETE_SHADER,
+        SHADER_SOURCE,
+        COMPILE_SHADER,
+        ATTACH_SHADER,
+        LINK_PROGRAM,
+        CREATE_PROGRAM,
+        DELETE_PROGRAM,
+        SET_UNIFORM_BY_NAME,        // Uniform kind, program, name, value
+        SET_UNIFORM,                // Uniform kind, location, value
+        GET_UNIFORM_LOCATION,
+        GET_ACTIVE_UNIFORMS,
+        SET_UNIFORM_BLOCK_BINDING,
+        BIND_UNIFORM_BUFFER,
+        CREATE_TEXTURE,
+        BIND_TEXTURE,
+        DELETE_TEXTURE,
+        TEX_IMAGE_2D,
+        DRAW_DEBUG_LINE,
+        DRAW_DEBUG_AXES,
+        READ_PIXELS,
+        SWAP_BUFFERS,               // Ends a frame
+        USE_DEFAULT_RED_SHADER,
+        SET_PROJECTION_MATRIX,
+        SET_VIEW_MATRIX,
+        SET_MODEL_MATRIX,
+        VERTEX_ATTRIB_DIVISOR,
+        DRAW_ARRAYS_INSTANCED,
+        DRAW_ELEMENTS_INSTANCED,
+        SET_TEXTURE_LEVELS,
+        TEX_IMAGE_LEVEL,            // Level, format, width, height, data
+        COMMAND_COUNT
+    };
+
+    // Value types of the uniform commands
+    enum UniformKind : uint8_t {
+        UNIFORM_FLOAT,
+        UNIFORM_INT,
+        UNIFORM_VEC3,
+        UNIFORM_VEC4,
+        UNIFORM_MATRIX4,
+        UNIFORM_FLOAT_ARRAY,
+        UNIFORM_INT_ARRAY,
+        UNIFORM_VEC3_ARRAY,
+        UNIFORM_MATRIX4_ARRAY
+    };
+
+    static const uint32_t VERSION = 1;
+    static const size_t HEADER_SIZE = 8;
+
+    // Appends commands to a trace held in memory
+    class Writer {
+    public:
+        Writer();
+
+        void Command(GraphicsTrace::Command command) { bytes.push_back(command); commandCount++; }
+        void U8(uint8_t value) { bytes.push_back(value); }
+        void Flag(bool value) { bytes.push_back(value ? 1 : 0); }
+        void U32(uint32_t value);
+        void I32(int32_t value) { U32(static_cast<uint32_t>(value)); }
+        void U64(uint64_t value);
+        void Float(float value);
+        void Floats(const float* values, size_t count);     // Zeros for null values
+        void Ints(const int* values, size_t count);
+        void String(const std::string& value);
+        void Data(const void* data, size_t size);           // Null data is kept as null
+
+        // The trace so far, header included
+        const std::vector<uint8_t>& GetBytes() const { return bytes; }
+        size_t GetCommandCount() const { return commandCount; }
+
+        // Move the bytes written so far, the header with the first ones, to
+        // out; for traces streamed to a file a piece at a time
+        void TakeBytes(std::vector<uint8_t>& out);
+
+    private:
+        std::vector<uint8_t> bytes;
+        size_t commandCount;
+    };
+
+    // What a replay did and how long it took
+    struct ReplayResult {
+        size_t commands = 0;
+        size_t frames = 0;
+        double milliseconds = 0.0;
+        std::vector<double> frameMilliseconds;  // Per finished frame
+        std::string error;
+    };
+
+    // Read a trace file; false, with a message on std::cerr, if it is not one
+    static bool Load(const std::string& path, std::vector<uint8_t>& trace);
+
+    // Write a trace held in memory
+    static bool Save(const std::string& path, const std::vector<uint8_t>& trace);
+
+    // Issue the trace's commands on graphics. False, with result.error set,
+    // if the trace is damaged; commands before the damage were issued.
+    static bool Replay(const std::vector<uint8_t>& trace, IGraphicsAPI* graphics, ReplayResult& result);
+
+    // Name of a command, for tools and errors
+    static const char* GetCommandName(uint8_t command);
+};
+
+#endif // GAME_ENGINE_SAVI_GRAPHICS_TRACE_H
@@ -16,7 +16,22 @@ enum class BufferType {
     VERTEX_BUFFER,
     INDEX_BUFFER,
     TEXTURE_COORD_BUFFER,
-    NORMAL_BUFFER
+    NORMAL_BUFFER,
+    UNIFORM_BUFFER
+};
+
+// Component types of vertex attributes
+enum class AttribType {
+    FLOAT,
+    HALF_FLOAT,
+    SHORT,
+    UNSIGNED_SHORT
+};
+
+// Index types
+enum class IndexType {
+    UNSIGNED_INT,
+    UNSIGNED_SHORT
 };
 
 // Draw modes
@@ -26,6 +41,14 @@ enum class DrawMode {
     POINTS
 };
 
+// Pixel formats of texture levels
+enum class TextureFormat {
+    RGBA8,
+    BC1,
+    BC3,
+    BC5
+};
+
 // Graphics API interface
 class IGraphicsAPI {
 public:
@@ -49,10 +72,21 @@ public:
     virtual void EnableVertexAttrib(unsigned int index) = 0;
     virtual void DisableVertexAttrib(unsigned int index) = 0;
     virtual void VertexAttribPointer(unsigned int index, int size, bool normalized, size_t stride, const void* pointer) = 0;
+    // Attributes stored as other types; normalized integers read as [-1, 1] or [0, 1]
+    virtual void VertexAttribPointer(unsigned int index, int size, AttribType type, bool normalized, size_t stride, const void* pointer) = 0;
+    // Advance the attribute once every divisor instances instead of once
+    // per vertex; 0 goes back to per vertex
+    virtual void VertexAttribDivisor(unsigned int index, unsigned int divisor) = 0;
     
     // Drawing
     virtual void DrawArrays(DrawMode mode, int first, int count) = 0;
     virtual void DrawElements(DrawMode mode, int count, const void* indices) = 0;
+    virtual void DrawElements(DrawMode mode, int count, IndexType type, const void* indices) = 0;
+    // Draw the same vertices instanceCount times; the shader tells the
+    // copies apart by gl_InstanceID and by attributes with a divisor
+    virtual void DrawArraysInstanced(DrawMode mode, int first, int count, int instanceCount) = 0;
+    virtual void DrawElementsInstanced(DrawMode mode, int count, IndexType type, const void* indices, int instanceCount) = 0;
+    virtual bool SupportsInstancing() const = 0;
     
     // Viewport and clear
     virtual void SetViewport(int x, int y, int width, int height) = 0;
@@ -69,6 +103,7 @@ public:
     
     // Shader management
     virtual void UseShaderProgram(ShaderProgram* program) = 0;
+    virtual void UseProgram(unsigned int program) = 0;     // By handle; 0 unbinds
     virtual unsigned int CreateShader(int shaderType) = 0;
     virtual void DeleteShader(unsigned int shader) = 0;
     virtual void ShaderSource(unsigned int shader, const std::string& source) = 0;
@@ -96,11 +131,39 @@ public:
     virtual void SetUniformMatrix4Array(unsigned int program, const std::string& name, const float* values, int count, bool transpose = false) = 0;
     virtual int GetUniformLocation(unsigned int program, const std::string& name) = 0;
     
+    // Uniform setters by location, for locations looked up once; they
+    // apply to the program in use and ignore -1
+    virtual void SetUniform1f(int location, float value) = 0;
+    virtual void SetUniform1i(int location, int value) = 0;
+    virtual void SetUniform3f(int location, float x, float y, float z) = 0;
+    virtual void SetUniform4f(int location, float x, float y, float z, float w) = 0;
+    virtual void SetUniformMatrix4fv(int location, const float* value, bool transpose = false) = 0;
+    virtual void SetUniformFloatArray(int location, const float* values, int count) = 0;
+    virtual void SetUniformIntArray(int location, const int* values, int count) = 0;
+    virtual void SetUniformVec3Array(int location, const float* values, int count) = 0;
+    virtual void SetUniformMatrix4Array(int location, const float* values, int count, bool transpose = false) = 0;
+    
+    // Every uniform of a linked program outside uniform blocks, with its
+    // location; each element of an array is listed ("weights[2]") along
+    // with the array's own name
+    virtual void GetActiveUniforms(unsigned int program, std::vector<std::string>& names,
+                                   std::vector<int>& locations) = 0;
+    
+    // Uniform buffers: a block of a program reads the buffer bound to the
+    // binding point the block is assigned to
+    virtual bool SetUniformBlockBinding(unsigned int program, const std::string& blockName, unsigned int binding) = 0;
+    virtual void BindUniformBuffer(unsigned int binding, unsigned int buffer) = 0;
+    
     // Texture management
     virtual unsigned int CreateTexture() = 0;
     virtual void BindTexture(unsigned int texture, unsigned int unit) = 0;
     virtual void DeleteTexture(unsigned int texture) = 0;
     virtual void TexImage2D(int width, int height, const void* data, bool hasAlpha) = 0;
+    // Repeats and filters the bound texture across its first levelCount mip levels
+    virtual void SetTextureLevels(int levelCount) = 0;
+    // Uploads one mip level of the bound texture; size is the byte count of data
+    virtual void TexImageLevel(int level, TextureFormat format, int width, int height,
+                               const void* data, size_t size) = 0;
     
     // Debug utilities
     virtual void DrawDebugLine(const Vector3& start, const Vector3& end, const Vector3& color) = 0;
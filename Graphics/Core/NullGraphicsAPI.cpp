@@ -0,0 +1,680 @@
+#include "NullGraphicsAPI.h"
+#include "../../Shaders/Core/ShaderProgram.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    const unsigned int UNKNOWN = 0xFFFFFFFFu;
+
+    // Split GLSL into identifiers, numbers and single punctuation
+    // characters, leaving out comments and preprocessor lines
+    std::vector<std::string> Tokenize(const std::string& source) {
+        std::vector<std::string> tokens;
+        size_t i = 0;
+        bool lineStart = true;
+        while (i < source.size()) {
+            char c = source[i];
+            if (c == '\n') {
+                lineStart = true;
+                i++;
+            } else if (std::isspace(static_cast<unsigned char>(c))) {
+                i++;
+            } else if (c == '#' && lineStart) {
+                while (i < source.size() && source[i] != '\n') {
+                    i++;
+                }
+            } else if (source.compare(i, 2, "//") == 0) {
+                while (i < source.size() && source[i] != '\n') {
+                    i++;
+                }
+            } else if (source.compare(i, 2, "/*") == 0) {
+                size_t end = source.find("*/", i + 2);
+                i = end == std::string::npos ? source.size() : end + 2;
+            } else if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+                size_t start = i;
+                while (i < source.size() && (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_')) {
+                    i++;
+                }
+                tokens.push_back(source.substr(start, i - start));
+                lineStart = false;
+            } else {
+                tokens.push_back(std::string(1, c));
+                lineStart = false;
+                i++;
+            }
+        }
+        return tokens;
+    }
+
+    // Whether a GLSL type is built in, so the uniform is not a struct
+    bool IsBasicType(const std::string& type) {
+        static const char* prefixes[] = { "vec", "ivec", "uvec", "bvec", "dvec", "mat", "dmat",
+                                          "sampler", "isampler", "usampler", "image" };
+        if (type == "float" || type == "int" || type == "uint" || type == "bool" || type == "double") {
+            return true;
+        }
+        for (const char* prefix : prefixes) {
+            if (type.compare(0, std::strlen(prefix), prefix) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool IsQualifier(const std::string& token) {
+        return token == "lowp" || token == "mediump" || token == "highp";
+    }
+
+    size_t BufferIndex(BufferType type) {
+        return static_cast<size_t>(type);
+    }
+}
+
+NullGraphicsAPI::NullGraphicsAPI() : nextHandle(1), windowOpen(false), frameCount(0) {
+    vertexArray = UNKNOWN;
+    for (unsigned int& buffer : buffers) {
+        buffer = UNKNOWN;
+    }
+    program = UNKNOWN;
+    depthTest = -1;
+    depthFunc = -1;
+    cullFace = -1;
+    cullFaceMode = -1;
+    viewport[0] = viewport[1] = viewport[2] = viewport[3] = 0;
+    clearColor[0] = clearColor[1] = clearColor[2] = clearColor[3] = -1.0f;
+}
+
+NullGraphicsAPI::~NullGraphicsAPI() {
+}
+
+void NullGraphicsAPI::Call() {
+    frameStats.calls++;
+    totalStats.calls++;
+}
+
+void NullGraphicsAPI::StateChange(bool changed) {
+    Call();
+    if (changed) {
+        frameStats.stateChanges++;
+        totalStats.stateChanges++;
+    } else {
+        frameStats.redundantStateChanges++;
+        totalStats.redundantStateChanges++;
+    }
+}
+
+void NullGraphicsAPI::UniformUpdate(int location, size_t bytes) {
+    Call();
+    // Like GL, -1 is quietly ignored
+    if (location == -1) {
+        return;
+    }
+    frameStats.uniformUpdates++;
+    totalStats.uniformUpdates++;
+    Upload(bytes);
+}
+
+void NullGraphicsAPI::Upload(size_t bytes) {
+    frameStats.bytesUploaded += bytes;
+    totalStats.bytesUploaded += bytes;
+}
+
+void NullGraphicsAPI::Draw(int count, int instanceCount) {
+    Call();
+    frameStats.drawCalls++;
+    totalStats.drawCalls++;
+    if (count > 0 && instanceCount > 0) {
+        frameStats.vertices += static_cast<size_t>(count) * instanceCount;
+        totalStats.vertices += static_cast<size_t>(count) * instanceCount;
+        frameStats.instances += instanceCount;
+        totalStats.instances += instanceCount;
+    }
+}
+
+bool NullGraphicsAPI::Initialize() {
+    std::cout << "Initializing null graphics API" << std::endl;
+    return true;
+}
+
+void NullGraphicsAPI::Shutdown() {
+    std::cout << "Shutting down null graphics API after " << frameCount << " frames, "
+              << totalStats.drawCalls << " draw calls" << std::endl;
+}
+
+// Buffer management
+unsigned int NullGraphicsAPI::CreateVertexArray() {
+    Call();
+    return nextHandle++;
+}
+
+void NullGraphicsAPI::BindVertexArray(unsigned int vao) {
+    StateChange(vertexArray != vao);
+    if (vertexArray != vao) {
+        // The index buffer binding belongs to the vertex array
+        buffers[BufferIndex(BufferType::INDEX_BUFFER)] = UNKNOWN;
+    }
+    vertexArray = vao;
+}
+
+void NullGraphicsAPI::DeleteVertexArray(unsigned int vao) {
+    Call();
+    if (vertexArray == vao) {
+        vertexArray = 0;
+    }
+}
+
+unsigned int NullGraphicsAPI::CreateBuffer() {
+    Call();
+    return nextHandle++;
+}
+
+void NullGraphicsAPI::BindBuffer(BufferType type, unsigned int buffer) {
+    unsigned int& bound = buffers[BufferIndex(type)];
+    StateChange(bound != buffer);
+    bound = buffer;
+}
+
+void NullGraphicsAPI::DeleteBuffer(unsigned int buffer) {
+    Call();
+    for (unsigned int& bound : buffers) {
+        if (bound == buffer) {
+            bound = 0;
+        }
+    }
+}
+
+void NullGraphicsAPI::BufferData(BufferType, const void*, size_t size, bool) {
+    Call();
+    Upload(size);
+}
+
+// Attribute configuration
+void NullGraphicsAPI::EnableVertexAttrib(unsigned int) {
+    Call();
+}
+
+void NullGraphicsAPI::DisableVertexAttrib(unsigned int) {
+    Call();
+}
+
+void NullGraphicsAPI::VertexAttribPointer(unsigned int, int, bool, size_t, const void*) {
+    Call();
+}
+
+void NullGraphicsAPI::VertexAttribPointer(unsigned int, int, AttribType, bool, size_t, const void*) {
+    Call();
+}
+
+void NullGraphicsAPI::VertexAttribDivisor(unsigned int, unsigned int) {
+    Call();
+}
+
+// Drawing
+void NullGraphicsAPI::DrawArrays(DrawMode, int, int count) {
+    Draw(count);
+}
+
+void NullGraphicsAPI::DrawElements(DrawMode, int count, const void*) {
+    Draw(count);
+}
+
+void NullGraphicsAPI::DrawElements(DrawMode, int count, IndexType, const void*) {
+    Draw(count);
+}
+
+void NullGraphicsAPI::DrawArraysInstanced(DrawMode, int, int count, int instanceCount) {
+    Draw(count, instanceCount);
+}
+
+void NullGraphicsAPI::DrawElementsInstanced(DrawMode, int count, IndexType, const void*, int instanceCount) {
+    Draw(count, instanceCount);
+}
+
+// Viewport and clear
+void NullGraphicsAPI::SetViewport(int x, int y, int width, int height) {
+    bool changed = viewport[0] != x || viewport[1] != y || viewport[2] != width || viewport[3] != height;
+    StateChange(changed);
+    viewport[0] = x;
+    viewport[1] = y;
+    viewport[2] = width;
+    viewport[3] = height;
+}
+
+void NullGraphicsAPI::Begin2D() {
+    Call();
+}
+
+void NullGraphicsAPI::End2D() {
+    Call();
+}
+
+void NullGraphicsAPI::Clear(bool, bool) {
+    Call();
+}
+
+void NullGraphicsAPI::SetClearColor(float r, float g, float b, float a) {
+    bool changed = clearColor[0] != r || clearColor[1] != g || clearColor[2] != b || clearColor[3] != a;
+    StateChange(changed);
+    clearColor[0] = r;
+    clearColor[1] = g;
+    clearColor[2] = b;
+    clearColor[3] = a;
+}
+
+// Depth and culling
+void NullGraphicsAPI::SetDepthTest(bool enable) {
+    StateChange(depthTest != (enable ? 1 : 0));
+    depthTest = enable ? 1 : 0;
+}
+
+void NullGraphicsAPI::SetDepthFunc(int func) {
+    StateChange(depthFunc != func);
+    depthFunc = func;
+}
+
+void NullGraphicsAPI::SetCullFace(bool enable) {
+    StateChange(cullFace != (enable ? 1 : 0));
+    cullFace = enable ? 1 : 0;
+}
+
+void NullGraphicsAPI::SetCullFaceMode(int mode) {
+    StateChange(cullFaceMode != mode);
+    cullFaceMode = mode;
+}
+
+// Shader management
+void NullGraphicsAPI::UseShaderProgram(ShaderProgram* shaderProgram) {
+    UseProgram(shaderProgram ? shaderProgram->GetHandle() : 0);
+}
+
+void NullGraphicsAPI::UseProgram(unsigned int newProgram) {
+    StateChange(program != newProgram);
+    program = newProgram;
+}
+
+unsigned int NullGraphicsAPI::CreateShader(int) {
+    Call();
+    unsigned int shader = nextHandle++;
+    shaderSources[shader] = std::string();
+    return shader;
+}
+
+void NullGraphicsAPI::DeleteShader(unsigned int shader) {
+    Call();
+    shaderSources.erase(shader);
+}
+
+void NullGraphicsAPI::ShaderSource(unsigned int shader, const std::string& source) {
+    Call();
+    shaderSources[shader] = source;
+}
+
+void NullGraphicsAPI::CompileShader(unsigned int) {
+    Call();
+}
+
+bool NullGraphicsAPI::GetShaderCompileStatus(unsigned int) {
+    return true;
+}
+
+std::string NullGraphicsAPI::GetShaderInfoLog(unsigned int) {
+    return std::string();
+}
+
+bool NullGraphicsAPI::GetProgramLinkStatus(unsigned int) {
+    return true;
+}
+
+std::string NullGraphicsAPI::GetProgramInfoLog(unsigned int) {
+    return std::string();
+}
+
+void NullGraphicsAPI::AttachShader(unsigned int programHandle, unsigned int shader) {
+    Call();
+    programs[programHandle].shaders.push_back(shader);
+}
+
+void NullGraphicsAPI::LinkProgram(unsigned int programHandle) {
+    Call();
+    Program& linked = programs[programHandle];
+    linked.uniforms.clear();
+    linked.declared.clear();
+    linked.blocks.clear();
+    linked.locations.clear();
+
+    // Shaders may be deleted once linked, so their declarations are read now
+    for (unsigned int shader : linked.shaders) {
+        auto source = shaderSources.find(shader);
+        if (source != shaderSources.end()) {
+            ScanUniforms(source->second, linked);
+        }
+    }
+    for (const std::string& name : linked.uniforms) {
+        if (linked.locations.find(name) == linked.locations.end()) {
+            int location = static_cast<int>(linked.locations.size());
+            linked.locations[name] = location;
+        }
+    }
+}
+
+void NullGraphicsAPI::ScanUniforms(const std::string& source, Program& program) {
+    std::vector<std::string> tokens = Tokenize(source);
+    int depth = 0;
+    for (size_t i = 0; i < tokens.size(); i++) {
+        const std::string& token = tokens[i];
+        if (token == "{") {
+            depth++;
+            continue;
+        }
+        if (token == "}") {
+            depth--;
+            continue;
+        }
+        if (depth != 0 || token != "uniform") {
+            continue;
+        }
+
+        size_t next = i + 1;
+        while (next < tokens.size() && IsQualifier(tokens[next])) {
+            next++;
+        }
+        if (next + 1 >= tokens.size()) {
+            break;
+        }
+
+        // uniform Block { ... }; the members are read from the block's buffer
+        if (tokens[next + 1] == "{") {
+            program.blocks.insert(tokens[next]);
+            i = next;
+            continue;
+        }
+
+        // uniform type name[N], other[M];
+        const std::string& type = tokens[next];
+        bool basic = IsBasicType(type);
+        size_t at = next + 1;
+        while (at < tokens.size() && tokens[at] != ";") {
+            const std::string& name = tokens[at];
+            int count = 0;
+            if (at + 3 < tokens.size() && tokens[at + 1] == "[" && tokens[at + 3] == "]") {
+                count = std::atoi(tokens[at + 2].c_str());
+                at += 3;
+            }
+            program.declared.insert(name);
+            if (basic) {
+                program.uniforms.push_back(name);
+                for (int element = 0; element < count; element++) {
+                    program.uniforms.push_back(name + "[" + std::to_string(element) + "]");
+                }
+            }
+            at++;
+            if (at < tokens.size() && tokens[at] == ",") {
+                at++;
+            }
+        }
+        i = at;
+    }
+}
+
+unsigned int NullGraphicsAPI::CreateProgram() {
+    Call();
+    unsigned int handle = nextHandle++;
+    programs[handle] = Program();
+    return handle;
+}
+
+void NullGraphicsAPI::DeleteProgram(unsigned int programHandle) {
+    Call();
+    programs.erase(programHandle);
+}
+
+// Uniform setters
+void NullGraphicsAPI::SetUniform1f(unsigned int program, const std::string& name, float) {
+    UniformUpdate(GetUniformLocation(program, name), sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniform1i(unsigned int program, const std::string& name, int) {
+    UniformUpdate(GetUniformLocation(program, name), sizeof(int));
+}
+
+void NullGraphicsAPI::SetUniform3f(unsigned int program, const std::string& name, float, float, float) {
+    UniformUpdate(GetUniformLocation(program, name), 3 * sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniform4f(unsigned int program, const std::string& name, float, float, float, float) {
+    UniformUpdate(GetUniformLocation(program, name), 4 * sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniformMatrix4fv(unsigned int program, const std::string& name, const float*, bool) {
+    UniformUpdate(GetUniformLocation(program, name), 16 * sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniformFloatArray(unsigned int program, const std::string& name, const float*, int count) {
+    UniformUpdate(GetUniformLocation(program, name), count * sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniformIntArray(unsigned int program, const std::string& name, const int*, int count) {
+    UniformUpdate(GetUniformLocation(program, name), count * sizeof(int));
+}
+
+void NullGraphicsAPI::SetUniformVec3Array(unsigned int program, const std::string& name, const float*, int count) {
+    UniformUpdate(GetUniformLocation(program, name), count * 3 * sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniformMatrix4Array(unsigned int program, const std::string& name, const float*, int count, bool) {
+    UniformUpdate(GetUniformLocation(program, name), count * 16 * sizeof(float));
+}
+
+int NullGraphicsAPI::GetUniformLocation(unsigned int programHandle, const std::string& name) {
+    auto found = programs.find(programHandle);
+    if (found == programs.end()) {
+        return -1;
+    }
+    Program& linked = found->second;
+    auto location = linked.locations.find(name);
+    if (location != linked.locations.end()) {
+        return location->second;
+    }
+
+    // Members and elements of declared structs and arrays
+    std::string base = name.substr(0, name.find_first_of("[."));
+    if (linked.declared.find(base) == linked.declared.end()) {
+        return -1;
+    }
+    int newLocation = static_cast<int>(linked.locations.size());
+    linked.locations[name] = newLocation;
+    return newLocation;
+}
+
+void NullGraphicsAPI::SetUniform1f(int location, float) {
+    UniformUpdate(location, sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniform1i(int location, int) {
+    UniformUpdate(location, sizeof(int));
+}
+
+void NullGraphicsAPI::SetUniform3f(int location, float, float, float) {
+    UniformUpdate(location, 3 * sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniform4f(int location, float, float, float, float) {
+    UniformUpdate(location, 4 * sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniformMatrix4fv(int location, const float*, bool) {
+    UniformUpdate(location, 16 * sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniformFloatArray(int location, const float*, int count) {
+    UniformUpdate(location, count * sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniformIntArray(int location, const int*, int count) {
+    UniformUpdate(location, count * sizeof(int));
+}
+
+void NullGraphicsAPI::SetUniformVec3Array(int location, const float*, int count) {
+    UniformUpdate(location, count * 3 * sizeof(float));
+}
+
+void NullGraphicsAPI::SetUniformMatrix4Array(int location, const float*, int count, bool) {
+    UniformUpdate(location, count * 16 * sizeof(float));
+}
+
+void NullGraphicsAPI::GetActiveUniforms(unsigned int programHandle, std::vector<std::string>& names,
+                                        std::vector<int>& locations) {
+    names.clear();
+    locations.clear();
+    auto found = programs.find(programHandle);
+    if (found == programs.end()) {
+        return;
+    }
+    for (const std::string& name : found->second.uniforms) {
+        names.push_back(name);
+        locations.push_back(found->second.locations[name]);
+    }
+}
+
+bool NullGraphicsAPI::SetUniformBlockBinding(unsigned int programHandle, const std::string& blockName, unsigned int) {
+    auto found = programs.find(programHandle);
+    if (found == programs.end() || found->second.blocks.find(blockName) == found->second.blocks.end()) {
+        return false;
+    }
+    Call();
+    return true;
+}
+
+void NullGraphicsAPI::BindUniformBuffer(unsigned int binding, unsigned int buffer) {
+    auto bound = uniformBuffers.find(binding);
+    bool changed = bound == uniformBuffers.end() || bound->second != buffer;
+    StateChange(changed);
+    uniformBuffers[binding] = buffer;
+    buffers[BufferIndex(BufferType::UNIFORM_BUFFER)] = buffer;
+}
+
+// Texture management
+unsigned int NullGraphicsAPI::CreateTexture() {
+    Call();
+    return nextHandle++;
+}
+
+void NullGraphicsAPI::BindTexture(unsigned int texture, unsigned int unit) {
+    auto bound = textures.find(unit);
+    bool changed = bound == textures.end() || bound->second != texture;
+    StateChange(changed);
+    textures[unit] = texture;
+}
+
+void NullGraphicsAPI::DeleteTexture(unsigned int texture) {
+    Call();
+    for (auto& bound : textures) {
+        if (bound.second == texture) {
+            bound.second = 0;
+        }
+    }
+}
+
+void NullGraphicsAPI::TexImage2D(int width, int height, const void*, bool hasAlpha) {
+    Call();
+    if (width > 0 && height > 0) {
+        Upload(static_cast<size_t>(width) * height * (hasAlpha ? 4 : 3));
+    }
+}
+
+void NullGraphicsAPI::SetTextureLevels(int) {
+    Call();
+}
+
+void NullGraphicsAPI::TexImageLevel(int, TextureFormat, int, int, const void*, size_t size) {
+    Call();
+    Upload(size);
+}
+
+// Debug utilities
+void NullGraphicsAPI::DrawDebugLine(const Vector3&, const Vector3&, const Vector3&) {
+    Draw(2);
+}
+
+void NullGraphicsAPI::DrawDebugAxes() {
+    for (int axis = 0; axis < 3; axis++) {
+        DrawDebugLine(Vector3(0, 0, 0), Vector3(0, 0, 0), Vector3(0, 0, 0));
+    }
+}
+
+// Framebuffer operations
+void NullGraphicsAPI::ReadPixels(int, int, int width, int height, unsigned char* pixels) {
+    Call();
+    if (pixels && width > 0 && height > 0) {
+        std::memset(pixels, 0, static_cast<size_t>(width) * height * 4);
+    }
+}
+
+void NullGraphicsAPI::GetViewport(int* result) {
+    for (int i = 0; i < 4; i++) {
+        result[i] = viewport[i];
+    }
+}
+
+// Window management
+bool NullGraphicsAPI::CreateWindow(int width, int height, const char*) {
+    Call();
+    windowOpen = true;
+    viewport[0] = 0;
+    viewport[1] = 0;
+    viewport[2] = width;
+    viewport[3] = height;
+    return true;
+}
+
+void NullGraphicsAPI::DestroyWindow() {
+    Call();
+    windowOpen = false;
+}
+
+void NullGraphicsAPI::MakeContextCurrent() {
+}
+
+bool NullGraphicsAPI::IsWindowOpen() {
+    return windowOpen;
+}
+
+void NullGraphicsAPI::PollEvents() {
+}
+
+void NullGraphicsAPI::SwapBuffers() {
+    Call();
+    frameCount++;
+    lastFrameStats = frameStats;
+    frameStats = Stats();
+}
+
+void NullGraphicsAPI::UseDefaultRedShader() {
+    StateChange(true);
+    program = UNKNOWN;
+}
+
+// Matrix operations
+void NullGraphicsAPI::SetProjectionMatrix(const Matrix4x4&) {
+    Call();
+}
+
+void NullGraphicsAPI::SetViewMatrix(const Matrix4x4&) {
+    Call();
+}
+
+void NullGraphicsAPI::SetModelMatrix(const Matrix4x4&) {
+    Call();
+}
+
+// Input handling
+void NullGraphicsAPI::GetMousePosition(int& x, int& y) {
+    x = 0;
+    y = 0;
+}
+
+bool NullGraphicsAPI::IsMouseButtonPressed(int) {
+    return false;
+}
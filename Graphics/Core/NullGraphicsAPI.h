@@ -0,0 +1,211 @@
+#ifndef GAME_ENGINE_SAVI_NULL_GRAPHICS_API_H
+#define GAME_ENGINE_SAVI_NULL_GRAPHICS_API_H
+
+#include "IGraphicsAPI.h"
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Graphics API that draws nothing. Every call is counted instead, so the
+// renderer's CPU side (scene traversal, sorting, uniform and state
+// traffic) can run and be measured on machines without a GPU.
+//
+// Objects get handles as GL would hand them out. Shader sources are
+// scanned for their uniform declarations, so programs link, report their
+// uniforms and find their uniform blocks as with a real driver.
+class NullGraphicsAPI : public IGraphicsAPI {
+public:
+    // What the renderer asked for
+    struct Stats {
+        size_t calls = 0;               // Every call but queries
+        size_t drawCalls = 0;
+        size_t vertices = 0;            // Vertices or indices drawn, times their instances
+        size_t instances = 0;           // Copies drawn, one for a plain draw
+        size_t bytesUploaded = 0;       // Buffer, texture and uniform data
+        size_t stateChanges = 0;        // Binds and render state that changed something
+        size_t redundantStateChanges = 0;   // ...and that set what was already set
+        size_t uniformUpdates = 0;
+    };
+
+    NullGraphicsAPI();
+    virtual ~NullGraphicsAPI();
+
+    // Counts of the frame in progress, of the last finished frame, and
+    // since the API was created
+    const Stats& GetFrameStats() const { return frameStats; }
+    const Stats& GetLastFrameStats() const { return lastFrameStats; }
+    const Stats& GetTotalStats() const { return totalStats; }
+    size_t GetFrameCount() const { return frameCount; }
+
+    // Initialization and cleanup
+    virtual bool Initialize() override;
+    virtual void Shutdown() override;
+
+    // Buffer management
+    virtual unsigned int CreateVertexArray() override;
+    virtual void BindVertexArray(unsigned int vao) override;
+    virtual void DeleteVertexArray(unsigned int vao) override;
+
+    virtual unsigned int CreateBuffer() override;
+    virtual void BindBuffer(BufferType type, unsigned int buffer) override;
+    virtual void DeleteBuffer(unsigned int buffer) override;
+    virtual void BufferData(BufferType type, const void* data, size_t size, bool dynamic = false) override;
+
+    // Attribute configuration
+    virtual void EnableVertexAttrib(unsigned int index) override;
+    virtual void DisableVertexAttrib(unsigned int index) override;
+    virtual void VertexAttribPointer(unsigned int index, int size, bool normalized, size_t stride, const void* pointer) override;
+    virtual void VertexAttribPointer(unsigned int index, int size, AttribType type, bool normalized, size_t stride, const void* pointer) override;
+    virtual void VertexAttribDivisor(unsigned int index, unsigned int divisor) override;
+
+    // Drawing
+    virtual void DrawArrays(DrawMode mode, int first, int count) override;
+    virtual void DrawElements(DrawMode mode, int count, const void* indices) override;
+    virtual void DrawElements(DrawMode mode, int count, IndexType type, const void* indices) override;
+    virtual void DrawArraysInstanced(DrawMode mode, int first, int count, int instanceCount) override;
+    virtual void DrawElementsInstanced(DrawMode mode, int count, IndexType type, const void* indices, int instanceCount) override;
+    virtual bool SupportsInstancing() const override { return true; }
+
+    // Viewport and clear
+    virtual void SetViewport(int x, int y, int width, int height) override;
+    virtual void Begin2D() override;
+    virtual void End2D() override;
+    virtual void Clear(bool colorBuffer, bool depthBuffer) override;
+    virtual void SetClearColor(float r, float g, float b, float a) override;
+
+    // Depth and culling
+    virtual void SetDepthTest(bool enable) override;
+    virtual void SetDepthFunc(int func) override;
+    virtual void SetCullFace(bool enable) override;
+    virtual void SetCullFaceMode(int mode) override;
+
+    // Shader management
+    virtual void UseShaderProgram(ShaderProgram* program) override;
+    virtual void UseProgram(unsigned int program) override;
+    virtual unsigned int CreateShader(int shaderType) override;
+    virtual void DeleteShader(unsigned int shader) override;
+    virtual void ShaderSource(unsigned int shader, const std::string& source) override;
+    virtual void CompileShader(unsigned int shader) override;
+    virtual bool GetShaderCompileStatus(unsigned int shader) override;
+    virtual std::string GetShaderInfoLog(unsigned int shader) override;
+    virtual bool GetProgramLinkStatus(unsigned int program) override;
+    virtual std::string GetProgramInfoLog(unsigned int program) override;
+    virtual void AttachShader(unsigned int program, unsigned int shader) override;
+    virtual void LinkProgram(unsigned int program) override;
+    virtual unsigned int CreateProgram() override;
+    virtual void DeleteProgram(unsigned int program) override;
+
+    // Uniform setters
+    virtual void SetUniform1f(unsigned int program, const std::string& name, float value) override;
+    virtual void SetUniform1i(unsigned int program, const std::string& name, int value) override;
+    virtual void SetUniform3f(unsigned int program, const std::string& name, float x, float y, float z) override;
+    virtual void SetUniform4f(unsigned int program, const std::string& name, float x, float y, float z, float w) override;
+    virtual void SetUniformMatrix4fv(unsigned int program, const std::string& name, const float* value, bool transpose = false) override;
+    virtual void SetUniformFloatArray(unsigned int program, const std::string& name, const float* values, int count) override;
+    virtual void SetUniformIntArray(unsigned int program, const std::string& name, const int* values, int count) override;
+    virtual void SetUniformVec3Array(unsigned int program, const std::string& name, const float* values, int count) override;
+    virtual void SetUniformMatrix4Array(unsigned int program, const std::string& name, const float* values, int count, bool transpose = false) override;
+    virtual int GetUniformLocation(unsigned int program, const std::string& name) override;
+
+    virtual void SetUniform1f(int location, float value) override;
+    virtual void SetUniform1i(int location, int value) override;
+    virtual void SetUniform3f(int location, float x, float y, float z) override;
+    virtual void SetUniform4f(int location, float x, float y, float z, float w) override;
+    virtual void SetUniformMatrix4fv(int location, const float* value, bool transpose = false) override;
+    virtual void SetUniformFloatArray(int location, const float* values, int count) override;
+    virtual void SetUniformIntArray(int location, const int* values, int count) override;
+    virtual void SetUniformVec3Array(int location, const float* values, int count) override;
+    virtual void SetUniformMatrix4Array(int location, const float* values, int count, bool transpose = false) override;
+
+    virtual void GetActiveUniforms(unsigned int program, std::vector<std::string>& names,
+                                   std::vector<int>& locations) override;
+    virtual bool SetUniformBlockBinding(unsigned int program, const std::string& blockName, unsigned int binding) override;
+    virtual void BindUniformBuffer(unsigned int binding, unsigned int buffer) override;
+
+    // Texture management
+    virtual unsigned int CreateTexture() override;
+    virtual void BindTexture(unsigned int texture, unsigned int unit) override;
+    virtual void DeleteTexture(unsigned int texture) override;
+    virtual void TexImage2D(int width, int height, const void* data, bool hasAlpha) override;
+    virtual void SetTextureLevels(int levelCount) override;
+    virtual void TexImageLevel(int level, TextureFormat format, int width, int height,
+                               const void* data, size_t size) override;
+
+    // Debug utilities
+    virtual void DrawDebugLine(const Vector3& start, const Vector3& end, const Vector3& color) override;
+    virtual void DrawDebugAxes() override;
+
+    // Framebuffer operations; pixels read back black
+    virtual void ReadPixels(int x, int y, int width, int height, unsigned char* pixels) override;
+    virtual void GetViewport(int* viewport) override;
+
+    // Window management; the window is imaginary but opens and closes
+    virtual bool CreateWindow(int width, int height, const char* title) override;
+    virtual void DestroyWindow() override;
+    virtual void MakeContextCurrent() override;
+    virtual bool IsWindowOpen() override;
+    virtual void PollEvents() override;
+
+    // Ends the frame's counts
+    virtual void SwapBuffers() override;
+
+    virtual const char* GetAPIName() const override { return "Null"; }
+
+    virtual void UseDefaultRedShader() override;
+
+    // Matrix operations
+    virtual void SetProjectionMatrix(const Matrix4x4& matrix) override;
+    virtual void SetViewMatrix(const Matrix4x4& matrix) override;
+    virtual void SetModelMatrix(const Matrix4x4& matrix) override;
+    virtual bool SupportsMatrixOperations() const override { return false; }
+
+    // Input handling; no input ever arrives
+    virtual void GetMousePosition(int& x, int& y) override;
+    virtual bool IsMouseButtonPressed(int button) override;
+
+private:
+    // What a linked program declares
+    struct Program {
+        std::vector<unsigned int> shaders;
+        std::vector<std::string> uniforms;      // Active uniforms, array elements included
+        std::set<std::string> declared;         // Names of all uniforms, structs and arrays too
+        std::set<std::string> blocks;
+        std::map<std::string, int> locations;
+    };
+
+    // Record a uniform declaration of a shader source
+    static void ScanUniforms(const std::string& source, Program& program);
+
+    void Call();
+    void StateChange(bool changed);
+    void UniformUpdate(int location, size_t bytes);
+    void Upload(size_t bytes);
+    void Draw(int count, int instanceCount = 1);
+
+    unsigned int nextHandle;
+    std::map<unsigned int, std::string> shaderSources;
+    std::map<unsigned int, Program> programs;
+
+    // Shadow state, for telling changes from repeats
+    unsigned int vertexArray;
+    unsigned int buffers[5];
+    unsigned int program;
+    std::map<unsigned int, unsigned int> textures;      // By unit
+    std::map<unsigned int, unsigned int> uniformBuffers; // By binding
+    int depthTest;
+    int depthFunc;
+    int cullFace;
+    int cullFaceMode;
+    int viewport[4];
+    float clearColor[4];
+
+    bool windowOpen;
+    size_t frameCount;
+    Stats frameStats;
+    Stats lastFrameStats;
+    Stats totalStats;
+};
+
+#endif // GAME_ENGINE_SAVI_NULL_GRAPHICS_API_H
@@ -21,8 +21,32 @@
 typedef GLXContext (*PFNGLXCREATECONTEXTATTRIBSARBPROC)(Display*, GLXFBConfig, GLXContext, Bool, const int*);
 #endif
 
+namespace {
+    // The GL calls the state cache filters
+    GLFunctionTable CreateFunctionTable() {
+        GLFunctionTable table;
+        table.bindVertexArray = [](unsigned int vao) { glBindVertexArray(vao); };
+        table.bindBuffer = [](unsigned int target, unsigned int buffer) { glBindBuffer(target, buffer); };
+        table.bindBufferBase = [](unsigned int target, unsigned int index, unsigned int buffer) {
+#ifndef PLATFORM_WINDOWS
+            glBindBufferBase(target, index, buffer);
+#endif
+        };
+        table.useProgram = [](unsigned int program) { glUseProgram(program); };
+        table.activeTexture = [](unsigned int unit) { glActiveTexture(unit); };
+        table.bindTexture = [](unsigned int target, unsigned int texture) { glBindTexture(target, texture); };
+        table.enable = [](unsigned int capability) { glEnable(capability); };
+        table.disable = [](unsigned int capability) { glDisable(capability); };
+        table.depthFunc = [](unsigned int func) { glDepthFunc(func); };
+        table.cullFace = [](unsigned int mode) { glCullFace(mode); };
+        table.blendFunc = [](unsigned int source, unsigned int destination) { glBlendFunc(source, destination); };
+        table.viewport = [](int x, int y, int width, int height) { glViewport(x, y, width, height); };
+        return table;
+    }
+}
+
 OpenGLGraphicsAPI::OpenGLGraphicsAPI()
-    : currentVAO(0), currentBuffer(0), currentShader(0), currentTexture(0), windowOpen(false)
+    : stateCache(CreateFunctionTable()), windowOpen(false)
 {
     std::cout << "OpenGLGraphicsAPI constructor called" << std::endl;
     
@@ -89,16 +113,11 @@ unsigned int OpenGLGraphicsAPI::CreateVertexArray() {
 }
 
 void OpenGLGraphicsAPI::BindVertexArray(unsigned int vao) {
-    if (currentVAO != vao) {
-        glBindVertexArray(vao);
-        currentVAO = vao;
-    }
+    stateCache.BindVertexArray(vao);
 }
 
 void OpenGLGraphicsAPI::DeleteVertexArray(unsigned int vao) {
-    if (currentVAO == vao) {
-        currentVAO = 0;
-    }
+    stateCache.OnVertexArrayDeleted(vao);
     glDeleteVertexArrays(1, &vao);
 }
 
@@ -109,14 +128,11 @@ unsigned int OpenGLGraphicsAPI::CreateBuffer() {
 }
 
 void OpenGLGraphicsAPI::BindBuffer(BufferType type, unsigned int buffer) {
-    glBindBuffer(ConvertBufferType(type), buffer);
-    currentBuffer = buffer;
+    stateCache.BindBuffer(ConvertBufferType(type), buffer);
 }
 
 void OpenGLGraphicsAPI::DeleteBuffer(unsigned int buffer) {
-    if (currentBuffer == buffer) {
-        currentBuffer = 0;
-    }
+    stateCache.OnBufferDeleted(buffer);
     glDeleteBuffers(1, &buffer);
 }
 
@@ -137,6 +153,29 @@ void OpenGLGraphicsAPI::VertexAttribPointer(unsigned int index, int size, bool n
     glVertexAttribPointer(index, size, GL_FLOAT, normalized ? GL_TRUE : GL_FALSE, stride, pointer);
 }
 
+void OpenGLGraphicsAPI::VertexAttribPointer(unsigned int index, int size, AttribType type, bool normalized,
+                                          size_t stride, const void* pointer) {
+    GLenum glType = GL_FLOAT;
+    switch (type) {
+        case AttribType::HALF_FLOAT:
+            glType = GL_HALF_FLOAT;
+            break;
+        case AttribType::SHORT:
+            glType = GL_SHORT;
+            break;
+        case AttribType::UNSIGNED_SHORT:
+            glType = GL_UNSIGNED_SHORT;
+            break;
+        default:
+            break;
+    }
+    glVertexAttribPointer(index, size, glType, normalized ? GL_TRUE : GL_FALSE, stride, pointer);
+}
+
+void OpenGLGraphicsAPI::VertexAttribDivisor(unsigned int index, unsigned int divisor) {
+    glVertexAttribDivisor(index, divisor);
+}
+
 unsigned int OpenGLGraphicsAPI::CreateShader(int shaderType) {
     GLenum glShaderType = GL_VERTEX_SHADER;
     switch (shaderType) {
@@ -205,19 +244,19 @@ void OpenGLGraphicsAPI::UseShaderProgram(ShaderProgram* program) {
         if (handle == 0) {
             std::cout << "OpenGLGraphicsAPI::UseShaderProgram - WARNING: Program handle is 0" << std::endl;
         }
-        glUseProgram(handle);
-        currentShader = handle;
+        UseProgram(handle);
     } else {
         std::cout << "OpenGLGraphicsAPI::UseShaderProgram - Unbinding shader program (using 0)" << std::endl;
-        glUseProgram(0);
-        currentShader = 0;
+        UseProgram(0);
     }
 }
 
+void OpenGLGraphicsAPI::UseProgram(unsigned int program) {
+    stateCache.UseProgram(program);
+}
+
 void OpenGLGraphicsAPI::DeleteProgram(unsigned int program) {
-    if (currentShader == program) {
-        currentShader = 0;
-    }
+    stateCache.OnProgramDeleted(program);
     glDeleteProgram(program);
 }
 
@@ -322,6 +361,129 @@ void OpenGLGraphicsAPI::SetUniformMatrix4Array(unsigned int program, const std::
 #endif
 }
 
+void OpenGLGraphicsAPI::SetUniform1f(int location, float value) {
+    if (location != -1) {
+        glUniform1f(location, value);
+    }
+}
+
+void OpenGLGraphicsAPI::SetUniform1i(int location, int value) {
+    if (location != -1) {
+        glUniform1i(location, value);
+    }
+}
+
+void OpenGLGraphicsAPI::SetUniform3f(int location, float x, float y, float z) {
+    if (location != -1) {
+        glUniform3f(location, x, y, z);
+    }
+}
+
+void OpenGLGraphicsAPI::SetUniform4f(int location, float x, float y, float z, float w) {
+    if (location != -1) {
+        glUniform4f(location, x, y, z, w);
+    }
+}
+
+void OpenGLGraphicsAPI::SetUniformMatrix4fv(int location, const float* value, bool transpose) {
+    if (location != -1) {
+        glUniformMatrix4fv(location, 1, transpose ? GL_TRUE : GL_FALSE, value);
+    }
+}
+
+void OpenGLGraphicsAPI::SetUniformFloatArray(int location, const float* values, int count) {
+#ifndef PLATFORM_WINDOWS
+    if (location != -1) {
+        glUniform1fv(location, count, values);
+    }
+#endif
+}
+
+void OpenGLGraphicsAPI::SetUniformIntArray(int location, const int* values, int count) {
+#ifndef PLATFORM_WINDOWS
+    if (location != -1) {
+        glUniform1iv(location, count, values);
+    }
+#endif
+}
+
+void OpenGLGraphicsAPI::SetUniformVec3Array(int location, const float* values, int count) {
+#ifndef PLATFORM_WINDOWS
+    if (location != -1) {
+        glUniform3fv(location, count, values);
+    }
+#endif
+}
+
+void OpenGLGraphicsAPI::SetUniformMatrix4Array(int location, const float* values, int count, bool transpose) {
+#ifndef PLATFORM_WINDOWS
+    if (location != -1) {
+        glUniformMatrix4fv(location, count, transpose ? GL_TRUE : GL_FALSE, values);
+    }
+#endif
+}
+
+// List the uniforms of a linked program with their locations
+void OpenGLGraphicsAPI::GetActiveUniforms(unsigned int program, std::vector<std::string>& names,
+                                          std::vector<int>& locations) {
+    names.clear();
+    locations.clear();
+#ifndef PLATFORM_WINDOWS
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<GLchar> buffer(maxLength > 0 ? maxLength : 1);
+    
+    for (GLint i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, i, static_cast<GLsizei>(buffer.size()), &length, &size, &type, buffer.data());
+        std::string name(buffer.data(), length);
+        
+        // Members of uniform blocks have no location
+        GLint location = glGetUniformLocation(program, name.c_str());
+        if (location == -1) {
+            continue;
+        }
+        names.push_back(name);
+        locations.push_back(location);
+        
+        // Arrays are reported once, as "name[0]"
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+            std::string base = name.substr(0, name.size() - 3);
+            names.push_back(base);
+            locations.push_back(location);
+            for (GLint element = 1; element < size; element++) {
+                std::string elementName = base + "[" + std::to_string(element) + "]";
+                names.push_back(elementName);
+                locations.push_back(glGetUniformLocation(program, elementName.c_str()));
+            }
+        }
+    }
+#endif
+}
+
+// Assign a program's uniform block to a binding point
+bool OpenGLGraphicsAPI::SetUniformBlockBinding(unsigned int program, const std::string& blockName, unsigned int binding) {
+#ifndef PLATFORM_WINDOWS
+    GLuint index = glGetUniformBlockIndex(program, blockName.c_str());
+    if (index == GL_INVALID_INDEX) {
+        return false;
+    }
+    glUniformBlockBinding(program, index, binding);
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Bind a uniform buffer to a binding point
+void OpenGLGraphicsAPI::BindUniformBuffer(unsigned int binding, unsigned int buffer) {
+    stateCache.BindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+}
+
 void OpenGLGraphicsAPI::Clear(bool colorBuffer, bool depthBuffer) {
     GLbitfield clearMask = 0;
     if (colorBuffer) clearMask |= GL_COLOR_BUFFER_BIT;
@@ -345,6 +507,26 @@ void OpenGLGraphicsAPI::DrawElements(DrawMode mode, int count, const void* indic
     glDrawElements(ConvertDrawMode(mode), count, GL_UNSIGNED_INT, indices);
 }
 
+void OpenGLGraphicsAPI::DrawElements(DrawMode mode, int count, IndexType type, const void* indices) {
+    glDrawElements(ConvertDrawMode(mode), count, type == IndexType::UNSIGNED_SHORT ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, indices);
+}
+
+void OpenGLGraphicsAPI::DrawArraysInstanced(DrawMode mode, int first, int count, int instanceCount) {
+    glDrawArraysInstanced(ConvertDrawMode(mode), first, count, instanceCount);
+}
+
+void OpenGLGraphicsAPI::DrawElementsInstanced(DrawMode mode, int count, IndexType type, const void* indices, int instanceCount) {
+    glDrawElementsInstanced(ConvertDrawMode(mode), count,
+                            type == IndexType::UNSIGNED_SHORT ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+                            indices, instanceCount);
+}
+
+// Instanced draws and attribute divisors are core in GL 3.3, which the
+// shaders already ask for; GLEW knows once a context exists
+bool OpenGLGraphicsAPI::SupportsInstancing() const {
+    return windowOpen && GLEW_VERSION_3_3;
+}
+
 unsigned int OpenGLGraphicsAPI::CreateTexture() {
     GLuint texture;
     glGenTextures(1, &texture);
@@ -352,15 +534,11 @@ unsigned int OpenGLGraphicsAPI::CreateTexture() {
 }
 
 void OpenGLGraphicsAPI::BindTexture(unsigned int texture, unsigned int unit) {
-    glActiveTexture(GL_TEXTURE0 + unit);
-    glBindTexture(GL_TEXTURE_2D, texture);
-    currentTexture = texture;
+    stateCache.BindTexture(unit, texture);
 }
 
 void OpenGLGraphicsAPI::DeleteTexture(unsigned int texture) {
-    if (currentTexture == texture) {
-        currentTexture = 0;
-    }
+    stateCache.OnTextureDeleted(texture);
     glDeleteTextures(1, &texture);
 }
 
@@ -375,8 +553,32 @@ void OpenGLGraphicsAPI::TexImage2D(int width, int height, const void* data, bool
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 }
 
+void OpenGLGraphicsAPI::SetTextureLevels(int levelCount) {
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+}
+
+void OpenGLGraphicsAPI::TexImageLevel(int level, TextureFormat format, int width, int height,
+                                      const void* data, size_t size) {
+    if (format == TextureFormat::RGBA8) {
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        return;
+    }
+    GLenum internalFormat = GL_COMPRESSED_RG_RGTC2;
+    if (format == TextureFormat::BC1) {
+        internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    } else if (format == TextureFormat::BC3) {
+        internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    }
+    glCompressedTexImage2D(GL_TEXTURE_2D, level, internalFormat, width, height, 0,
+                           static_cast<GLsizei>(size), data);
+}
+
 void OpenGLGraphicsAPI::SetViewport(int x, int y, int width, int height) {
-    glViewport(x, y, width, height);
+    stateCache.Viewport(x, y, width, height);
 }
 
 void OpenGLGraphicsAPI::Begin2D() {
@@ -384,7 +586,7 @@ void OpenGLGraphicsAPI::Begin2D() {
     glPushAttrib(GL_ENABLE_BIT | GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
     
     // Disable depth testing so GUI elements aren't occluded
-    glDisable(GL_DEPTH_TEST);
+    stateCache.SetEnabled(GL_DEPTH_TEST, false);
     
     // Set up orthographic projection for 2D rendering
     glMatrixMode(GL_PROJECTION);
@@ -400,8 +602,8 @@ void OpenGLGraphicsAPI::Begin2D() {
     glPushMatrix();
     glLoadIdentity();
     
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    stateCache.SetEnabled(GL_BLEND, true);
+    stateCache.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
 void OpenGLGraphicsAPI::End2D() {
@@ -413,8 +615,9 @@ void OpenGLGraphicsAPI::End2D() {
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
     
-    // Restore previous OpenGL state
+    // Restore previous OpenGL state, which the state cache did not see
     glPopAttrib();
+    stateCache.Invalidate();
 }
 
 GLenum OpenGLGraphicsAPI::ConvertBufferType(BufferType type) {
@@ -427,6 +630,8 @@ GLenum OpenGLGraphicsAPI::ConvertBufferType(BufferType type) {
             return GL_ARRAY_BUFFER;
         case BufferType::NORMAL_BUFFER:
             return GL_ARRAY_BUFFER;
+        case BufferType::UNIFORM_BUFFER:
+            return GL_UNIFORM_BUFFER;
         default:
             return GL_ARRAY_BUFFER;
     }
@@ -579,11 +784,7 @@ void OpenGLGraphicsAPI::DrawDebugAxes() {
 // Depth and culling
 void OpenGLGraphicsAPI::SetDepthTest(bool enable) {
 #ifndef PLATFORM_WINDOWS
-    if (enable) {
-        glEnable(GL_DEPTH_TEST);
-    } else {
-        glDisable(GL_DEPTH_TEST);
-    }
+    stateCache.SetEnabled(GL_DEPTH_TEST, enable);
 #endif
 }
 
@@ -600,17 +801,13 @@ void OpenGLGraphicsAPI::SetDepthFunc(int func) {
         case 6: glFunc = GL_GEQUAL; break;
         case 7: glFunc = GL_ALWAYS; break;
     }
-    glDepthFunc(glFunc);
+    stateCache.DepthFunc(glFunc);
 #endif
 }
 
 void OpenGLGraphicsAPI::SetCullFace(bool enable) {
 #ifndef PLATFORM_WINDOWS
-    if (enable) {
-        glEnable(GL_CULL_FACE);
-    } else {
-        glDisable(GL_CULL_FACE);
-    }
+    stateCache.SetEnabled(GL_CULL_FACE, enable);
 #endif
 }
 
@@ -622,7 +819,7 @@ void OpenGLGraphicsAPI::SetCullFaceMode(int mode) {
         case 1: glMode = GL_BACK; break;
         case 2: glMode = GL_FRONT_AND_BACK; break;
     }
-    glCullFace(glMode);
+    stateCache.CullFace(glMode);
 #endif
 }
 
@@ -681,6 +878,8 @@ bool OpenGLGraphicsAPI::CreateWindow(int width, int height, const char* title) {
     
     hRC = wglCreateContext(hDC);
     wglMakeCurrent(hDC, hRC);
+    // A new context starts from GL's defaults, not what was cached
+    stateCache.Invalidate();
     
     ShowWindow(hWnd, SW_SHOW);
     UpdateWindow(hWnd);
@@ -788,6 +987,8 @@ bool OpenGLGraphicsAPI::CreateWindow(int width, int height, const char* title) {
     }
     
     glXMakeCurrent(display, window, context);
+    // A new context starts from GL's defaults, not what was cached
+    stateCache.Invalidate();
     
     // Clean up
     XFree(fbConfigs);
@@ -947,6 +1148,8 @@ void OpenGLGraphicsAPI::PollEvents() {
 
 // Platform-specific operations
 void OpenGLGraphicsAPI::SwapBuffers() {
+    stateCache.EndFrame();
+
 #ifdef PLATFORM_WINDOWS
     ::SwapBuffers(hDC);
 #else
@@ -1008,7 +1211,7 @@ void OpenGLGraphicsAPI::UseDefaultRedShader() {
     }
     
     // Use the default red shader program
-    glUseProgram(defaultRedShaderProgram);
+    stateCache.UseProgram(defaultRedShaderProgram);
 }
 
 // Note: Uniform setters are already defined above
@@ -2,6 +2,7 @@
 #define GAME_ENGINE_SAVI_OPENGL_GRAPHICS_API_H
 
 #include "IGraphicsAPI.h"
+#include "GLStateCache.h"
 #include "../../ThirdParty/OpenGL/include/GL/gl_definitions.h"
 #include "../../Shaders/Core/ShaderProgram.h"
 #include <iostream>
@@ -40,10 +41,16 @@ public:
     virtual void EnableVertexAttrib(unsigned int index) override;
     virtual void DisableVertexAttrib(unsigned int index) override;
     virtual void VertexAttribPointer(unsigned int index, int size, bool normalized, size_t stride, const void* pointer) override;
+    virtual void VertexAttribPointer(unsigned int index, int size, AttribType type, bool normalized, size_t stride, const void* pointer) override;
+    virtual void VertexAttribDivisor(unsigned int index, unsigned int divisor) override;
     
     // Drawing
     virtual void DrawArrays(DrawMode mode, int first, int count) override;
     virtual void DrawElements(DrawMode mode, int count, const void* indices) override;
+    virtual void DrawElements(DrawMode mode, int count, IndexType type, const void* indices) override;
+    virtual void DrawArraysInstanced(DrawMode mode, int first, int count, int instanceCount) override;
+    virtual void DrawElementsInstanced(DrawMode mode, int count, IndexType type, const void* indices, int instanceCount) override;
+    virtual bool SupportsInstancing() const override;
     
     // Viewport and clear
     virtual void SetViewport(int x, int y, int width, int height) override;
@@ -60,6 +67,7 @@ public:
     
     // Shader management
     virtual void UseShaderProgram(ShaderProgram* program) override;
+    virtual void UseProgram(unsigned int program) override;
     virtual unsigned int CreateShader(int shaderType) override;
     virtual void DeleteShader(unsigned int shader) override;
     virtual void ShaderSource(unsigned int shader, const std::string& source) override;
@@ -87,11 +95,31 @@ public:
     virtual void SetUniformMatrix4Array(unsigned int program, const std::string& name, const float* values, int count, bool transpose = false) override;
     virtual int GetUniformLocation(unsigned int program, const std::string& name) override;
     
+    // Uniform setters by location
+    virtual void SetUniform1f(int location, float value) override;
+    virtual void SetUniform1i(int location, int value) override;
+    virtual void SetUniform3f(int location, float x, float y, float z) override;
+    virtual void SetUniform4f(int location, float x, float y, float z, float w) override;
+    virtual void SetUniformMatrix4fv(int location, const float* value, bool transpose = false) override;
+    virtual void SetUniformFloatArray(int location, const float* values, int count) override;
+    virtual void SetUniformIntArray(int location, const int* values, int count) override;
+    virtual void SetUniformVec3Array(int location, const float* values, int count) override;
+    virtual void SetUniformMatrix4Array(int location, const float* values, int count, bool transpose = false) override;
+    virtual void GetActiveUniforms(unsigned int program, std::vector<std::string>& names,
+                                   std::vector<int>& locations) override;
+    
+    // Uniform buffers
+    virtual bool SetUniformBlockBinding(unsigned int program, const std::string& blockName, unsigned int binding) override;
+    virtual void BindUniformBuffer(unsigned int binding, unsigned int buffer) override;
+    
     // Texture management
     virtual unsigned int CreateTexture() override;
     virtual void BindTexture(unsigned int texture, unsigned int unit) override;
     virtual void DeleteTexture(unsigned int texture) override;
     virtual void TexImage2D(int width, int height, const void* data, bool hasAlpha) override;
+    virtual void SetTextureLevels(int levelCount) override;
+    virtual void TexImageLevel(int level, TextureFormat format, int width, int height,
+                               const void* data, size_t size) override;
     
     // Debug utilities
     virtual void DrawDebugLine(const Vector3& start, const Vector3& end, const Vector3& color) override;
@@ -136,12 +164,13 @@ public:
     GLenum ConvertTextureParameter(int param);
     GLenum ConvertPixelFormat(bool hasAlpha);
 
+    // Bindings and render state set through this API, with counts of the
+    // calls it issued and filtered
+    GLStateCache& GetStateCache() { return stateCache; }
+
 private:
-    // Track current state to avoid redundant state changes
-    unsigned int currentVAO;
-    unsigned int currentBuffer;
-    unsigned int currentShader;
-    unsigned int currentTexture;
+    // Drops state changes that would set what is already set
+    GLStateCache stateCache;
     
     // Window management
     #ifdef PLATFORM_WINDOWS
@@ -0,0 +1,675 @@
+#include "RecordingGraphicsAPI.h"
+#include "../../Shaders/Core/ShaderProgram.h"
+#include <cstdint>
+#include <iostream>
+
+RecordingGraphicsAPI::RecordingGraphicsAPI(std::shared_ptr<IGraphicsAPI> target, const std::string& path)
+    : target(target), path(path), frameCount(0) {
+    if (!path.empty()) {
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            std::cerr << "Cannot write graphics trace " << path << ", keeping it in memory" << std::endl;
+        }
+    }
+}
+
+RecordingGraphicsAPI::~RecordingGraphicsAPI() {
+    Flush();
+}
+
+bool RecordingGraphicsAPI::Flush() {
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<uint8_t> bytes;
+    writer.TakeBytes(bytes);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    file.flush();
+    return static_cast<bool>(file);
+}
+
+// Initialization and cleanup
+bool RecordingGraphicsAPI::Initialize() {
+    return target->Initialize();
+}
+
+void RecordingGraphicsAPI::Shutdown() {
+    Flush();
+    if (file.is_open()) {
+        std::cout << "Recorded " << frameCount << " frames to " << path << std::endl;
+    }
+    target->Shutdown();
+}
+
+// Buffer management
+unsigned int RecordingGraphicsAPI::CreateVertexArray() {
+    unsigned int vao = target->CreateVertexArray();
+    writer.Command(GraphicsTrace::CREATE_VERTEX_ARRAY);
+    writer.U32(vao);
+    return vao;
+}
+
+void RecordingGraphicsAPI::BindVertexArray(unsigned int vao) {
+    writer.Command(GraphicsTrace::BIND_VERTEX_ARRAY);
+    writer.U32(vao);
+    target->BindVertexArray(vao);
+}
+
+void RecordingGraphicsAPI::DeleteVertexArray(unsigned int vao) {
+    writer.Command(GraphicsTrace::DELETE_VERTEX_ARRAY);
+    writer.U32(vao);
+    target->DeleteVertexArray(vao);
+}
+
+unsigned int RecordingGraphicsAPI::CreateBuffer() {
+    unsigned int buffer = target->CreateBuffer();
+    writer.Command(GraphicsTrace::CREATE_BUFFER);
+    writer.U32(buffer);
+    return buffer;
+}
+
+void RecordingGraphicsAPI::BindBuffer(BufferType type, unsigned int buffer) {
+    writer.Command(GraphicsTrace::BIND_BUFFER);
+    writer.U8(static_cast<uint8_t>(type));
+    writer.U32(buffer);
+    target->BindBuffer(type, buffer);
+}
+
+void RecordingGraphicsAPI::DeleteBuffer(unsigned int buffer) {
+    writer.Command(GraphicsTrace::DELETE_BUFFER);
+    writer.U32(buffer);
+    target->DeleteBuffer(buffer);
+}
+
+void RecordingGraphicsAPI::BufferData(BufferType type, const void* data, size_t size, bool dynamic) {
+    writer.Command(GraphicsTrace::BUFFER_DATA);
+    writer.U8(static_cast<uint8_t>(type));
+    writer.Flag(dynamic);
+    writer.Data(data, size);
+    target->BufferData(type, data, size, dynamic);
+}
+
+// Attribute configuration
+void RecordingGraphicsAPI::EnableVertexAttrib(unsigned int index) {
+    writer.Command(GraphicsTrace::ENABLE_VERTEX_ATTRIB);
+    writer.U32(index);
+    target->EnableVertexAttrib(index);
+}
+
+void RecordingGraphicsAPI::DisableVertexAttrib(unsigned int index) {
+    writer.Command(GraphicsTrace::DISABLE_VERTEX_ATTRIB);
+    writer.U32(index);
+    target->DisableVertexAttrib(index);
+}
+
+void RecordingGraphicsAPI::VertexAttribPointer(unsigned int index, int size, bool normalized, size_t stride, const void* pointer) {
+    writer.Command(GraphicsTrace::VERTEX_ATTRIB_POINTER);
+    writer.U32(index);
+    writer.I32(size);
+    writer.U8(static_cast<uint8_t>(AttribType::FLOAT));
+    writer.Flag(normalized);
+    writer.U64(stride);
+    writer.U64(reinterpret_cast<uintptr_t>(pointer));
+    target->VertexAttribPointer(index, size, normalized, stride, pointer);
+}
+
+void RecordingGraphicsAPI::VertexAttribPointer(unsigned int index, int size, AttribType type, bool normalized, size_t stride, const void* pointer) {
+    writer.Command(GraphicsTrace::VERTEX_ATTRIB_POINTER);
+    writer.U32(index);
+    writer.I32(size);
+    writer.U8(static_cast<uint8_t>(type));
+    writer.Flag(normalized);
+    writer.U64(stride);
+    writer.U64(reinterpret_cast<uintptr_t>(pointer));
+    target->VertexAttribPointer(index, size, type, normalized, stride, pointer);
+}
+
+void RecordingGraphicsAPI::VertexAttribDivisor(unsigned int index, unsigned int divisor) {
+    writer.Command(GraphicsTrace::VERTEX_ATTRIB_DIVISOR);
+    writer.U32(index);
+    writer.U32(divisor);
+    target->VertexAttribDivisor(index, divisor);
+}
+
+// Drawing
+void RecordingGraphicsAPI::DrawArrays(DrawMode mode, int first, int count) {
+    writer.Command(GraphicsTrace::DRAW_ARRAYS);
+    writer.U8(static_cast<uint8_t>(mode));
+    writer.I32(first);
+    writer.I32(count);
+    target->DrawArrays(mode, first, count);
+}
+
+void RecordingGraphicsAPI::DrawElements(DrawMode mode, int count, const void* indices) {
+    writer.Command(GraphicsTrace::DRAW_ELEMENTS);
+    writer.U8(static_cast<uint8_t>(mode));
+    writer.I32(count);
+    writer.U8(static_cast<uint8_t>(IndexType::UNSIGNED_INT));
+    writer.U64(reinterpret_cast<uintptr_t>(indices));
+    target->DrawElements(mode, count, indices);
+}
+
+void RecordingGraphicsAPI::DrawElements(DrawMode mode, int count, IndexType type, const void* indices) {
+    writer.Command(GraphicsTrace::DRAW_ELEMENTS);
+    writer.U8(static_cast<uint8_t>(mode));
+    writer.I32(count);
+    writer.U8(static_cast<uint8_t>(type));
+    writer.U64(reinterpret_cast<uintptr_t>(indices));
+    target->DrawElements(mode, count, type, indices);
+}
+
+void RecordingGraphicsAPI::DrawArraysInstanced(DrawMode mode, int first, int count, int instanceCount) {
+    writer.Command(GraphicsTrace::DRAW_ARRAYS_INSTANCED);
+    writer.U8(static_cast<uint8_t>(mode));
+    writer.I32(first);
+    writer.I32(count);
+    writer.I32(instanceCount);
+    target->DrawArraysInstanced(mode, first, count, instanceCount);
+}
+
+void RecordingGraphicsAPI::DrawElementsInstanced(DrawMode mode, int count, IndexType type, const void* indices, int instanceCount) {
+    writer.Command(GraphicsTrace::DRAW_ELEMENTS_INSTANCED);
+    writer.U8(static_cast<uint8_t>(mode));
+    writer.I32(count);
+    writer.U8(static_cast<uint8_t>(type));
+    writer.U64(reinterpret_cast<uintptr_t>(indices));
+    writer.I32(instanceCount);
+    target->DrawElementsInstanced(mode, count, type, indices, instanceCount);
+}
+
+// Viewport and clear
+void RecordingGraphicsAPI::SetViewport(int x, int y, int width, int height) {
+    writer.Command(GraphicsTrace::SET_VIEWPORT);
+    writer.I32(x);
+    writer.I32(y);
+    writer.I32(width);
+    writer.I32(height);
+    target->SetViewport(x, y, width, height);
+}
+
+void RecordingGraphicsAPI::Begin2D() {
+    writer.Command(GraphicsTrace::BEGIN_2D);
+    target->Begin2D();
+}
+
+void RecordingGraphicsAPI::End2D() {
+    writer.Command(GraphicsTrace::END_2D);
+    target->End2D();
+}
+
+void RecordingGraphicsAPI::Clear(bool colorBuffer, bool depthBuffer) {
+    writer.Command(GraphicsTrace::CLEAR);
+    writer.Flag(colorBuffer);
+    writer.Flag(depthBuffer);
+    target->Clear(colorBuffer, depthBuffer);
+}
+
+void RecordingGraphicsAPI::SetClearColor(float r, float g, float b, float a) {
+    writer.Command(GraphicsTrace::SET_CLEAR_COLOR);
+    writer.Float(r);
+    writer.Float(g);
+    writer.Float(b);
+    writer.Float(a);
+    target->SetClearColor(r, g, b, a);
+}
+
+// Depth and culling
+void RecordingGraphicsAPI::SetDepthTest(bool enable) {
+    writer.Command(GraphicsTrace::SET_DEPTH_TEST);
+    writer.Flag(enable);
+    target->SetDepthTest(enable);
+}
+
+void RecordingGraphicsAPI::SetDepthFunc(int func) {
+    writer.Command(GraphicsTrace::SET_DEPTH_FUNC);
+    writer.I32(func);
+    target->SetDepthFunc(func);
+}
+
+void RecordingGraphicsAPI::SetCullFace(bool enable) {
+    writer.Command(GraphicsTrace::SET_CULL_FACE);
+    writer.Flag(enable);
+    target->SetCullFace(enable);
+}
+
+void RecordingGraphicsAPI::SetCullFaceMode(int mode) {
+    writer.Command(GraphicsTrace::SET_CULL_FACE_MODE);
+    writer.I32(mode);
+    target->SetCullFaceMode(mode);
+}
+
+// Shader management
+void RecordingGraphicsAPI::UseShaderProgram(ShaderProgram* program) {
+    writer.Command(GraphicsTrace::USE_PROGRAM);
+    writer.U32(program ? program->GetHandle() : 0);
+    target->UseShaderProgram(program);
+}
+
+void RecordingGraphicsAPI::UseProgram(unsigned int program) {
+    writer.Command(GraphicsTrace::USE_PROGRAM);
+    writer.U32(program);
+    target->UseProgram(program);
+}
+
+unsigned int RecordingGraphicsAPI::CreateShader(int shaderType) {
+    unsigned int shader = target->CreateShader(shaderType);
+    writer.Command(GraphicsTrace::CREATE_SHADER);
+    writer.I32(shaderType);
+    writer.U32(shader);
+    return shader;
+}
+
+void RecordingGraphicsAPI::DeleteShader(unsigned int shader) {
+    writer.Command(GraphicsTrace::DELETE_SHADER);
+    writer.U32(shader);
+    target->DeleteShader(shader);
+}
+
+void RecordingGraphicsAPI::ShaderSource(unsigned int shader, const std::string& source) {
+    writer.Command(GraphicsTrace::SHADER_SOURCE);
+    writer.U32(shader);
+    writer.String(source);
+    target->ShaderSource(shader, source);
+}
+
+void RecordingGraphicsAPI::CompileShader(unsigned int shader) {
+    writer.Command(GraphicsTrace::COMPILE_SHADER);
+    writer.U32(shader);
+    target->CompileShader(shader);
+}
+
+bool RecordingGraphicsAPI::GetShaderCompileStatus(unsigned int shader) {
+    return target->GetShaderCompileStatus(shader);
+}
+
+std::string RecordingGraphicsAPI::GetShaderInfoLog(unsigned int shader) {
+    return target->GetShaderInfoLog(shader);
+}
+
+bool RecordingGraphicsAPI::GetProgramLinkStatus(unsigned int program) {
+    return target->GetProgramLinkStatus(program);
+}
+
+std::string RecordingGraphicsAPI::GetProgramInfoLog(unsigned int program) {
+    return target->GetProgramInfoLog(program);
+}
+
+void RecordingGraphicsAPI::AttachShader(unsigned int program, unsigned int shader) {
+    writer.Command(GraphicsTrace::ATTACH_SHADER);
+    writer.U32(program);
+    writer.U32(shader);
+    target->AttachShader(program, shader);
+}
+
+void RecordingGraphicsAPI::LinkProgram(unsigned int program) {
+    writer.Command(GraphicsTrace::LINK_PROGRAM);
+    writer.U32(program);
+    target->LinkProgram(program);
+}
+
+unsigned int RecordingGraphicsAPI::CreateProgram() {
+    unsigned int program = target->CreateProgram();
+    writer.Command(GraphicsTrace::CREATE_PROGRAM);
+    writer.U32(program);
+    return program;
+}
+
+void RecordingGraphicsAPI::DeleteProgram(unsigned int program) {
+    writer.Command(GraphicsTrace::DELETE_PROGRAM);
+    writer.U32(program);
+    target->DeleteProgram(program);
+}
+
+// Uniform setters by name
+void RecordingGraphicsAPI::SetUniform1f(unsigned int program, const std::string& name, float value) {
+    writer.Command(GraphicsTrace::SET_UNIFORM_BY_NAME);
+    writer.U8(GraphicsTrace::UNIFORM_FLOAT);
+    writer.U32(program);
+    writer.String(name);
+    writer.Float(value);
+    target->SetUniform1f(program, name, value);
+}
+
+void RecordingGraphicsAPI::SetUniform1i(unsigned int program, const std::string& name, int value) {
+    writer.Command(GraphicsTrace::SET_UNIFORM_BY_NAME);
+    writer.U8(GraphicsTrace::UNIFORM_INT);
+    writer.U32(program);
+    writer.String(name);
+    writer.I32(value);
+    target->SetUniform1i(program, name, value);
+}
+
+void RecordingGraphicsAPI::SetUniform3f(unsigned int program, const std::string& name, float x, float y, float z) {
+    writer.Command(GraphicsTrace::SET_UNIFORM_BY_NAME);
+    writer.U8(GraphicsTrace::UNIFORM_VEC3);
+    writer.U32(program);
+    writer.String(name);
+    writer.Float(x);
+    writer.Float(y);
+    writer.Float(z);
+    target->SetUniform3f(program, name, x, y, z);
+}
+
+void RecordingGraphicsAPI::SetUniform4f(unsigned int program, const std::string& name, float x, float y, float z, float w) {
+    writer.Command(GraphicsTrace::SET_UNIFORM_BY_NAME);
+    writer.U8(GraphicsTrace::UNIFORM_VEC4);
+    writer.U32(program);
+    writer.String(name);
+    writer.Float(x);
+    writer.Float(y);
+    writer.Float(z);
+    writer.Float(w);
+    target->SetUniform4f(program, name, x, y, z, w);
+}
+
+void RecordingGraphicsAPI::SetUniformMatrix4fv(unsigned int program, const std::string& name, const float* value, bool transpose) {
+    writer.Command(GraphicsTrace::SET_UNIFORM_BY_NAME);
+    writer.U8(GraphicsTrace::UNIFORM_MATRIX4);
+    writer.U32(program);
+    writer.String(name);
+    writer.Flag(transpose);
+    writer.Floats(value, 16);
+    target->SetUniformMatrix4fv(program, name, value, transpose);
+}
+
+void RecordingGraphicsAPI::SetUniformFloatArray(unsigned int program, const std::string& name, const float* values, int count) {
+    writer.Command(GraphicsTrace::SET_UNIFORM_BY_NAME);
+    writer.U8(GraphicsTrace::UNIFORM_FLOAT_ARRAY);
+    writer.U32(program);
+    writer.String(name);
+    writer.I32(count);
+    writer.Floats(values, count > 0 ? count : 0);
+    target->SetUniformFloatArray(program, name, values, count);
+}
+
+void RecordingGraphicsAPI::SetUniformIntArray(unsigned int program, const std::string& name, const int* values, int count) {
+    writer.Command(GraphicsTrace::SET_UNIFORM_BY_NAME);
+    writer.U8(GraphicsTrace::UNIFORM_INT_ARRAY);
+    writer.U32(program);
+    writer.String(name);
+    writer.I32(count);
+    writer.Ints(values, count > 0 ? count : 0);
+    target->SetUniformIntArray(program, name, values, count);
+}
+
+void RecordingGraphicsAPI::SetUniformVec3Array(unsigned int program, const std::string& name, const float* values, int count) {
+    writer.Command(GraphicsTrace::SET_UNIFORM_BY_NAME);
+    writer.U8(GraphicsTrace::UNIFORM_VEC3_ARRAY);
+    writer.U32(program);
+    writer.String(name);
+    writer.I32(count);
+    writer.Floats(values, count > 0 ? count * 3 : 0);
+    target->SetUniformVec3Array(program, name, values, count);
+}
+
+void RecordingGraphicsAPI::SetUniformMatrix4Array(unsigned int program, const std::string& name, const float* values, int count, bool transpose) {
+    writer.Command(GraphicsTrace::SET_UNIFORM_BY_NAME);
+    writer.U8(GraphicsTrace::UNIFORM_MATRIX4_ARRAY);
+    writer.U32(program);
+    writer.String(name);
+    writer.Flag(transpose);
+    writer.I32(count);
+    writer.Floats(values, count > 0 ? count * 16 : 0);
+    target->SetUniformMatrix4Array(program, name, values, count, transpose);
+}
+
+int RecordingGraphicsAPI::GetUniformLocation(unsigned int program, const std::string& name) {
+    int location = target->GetUniformLocation(program, name);
+    writer.Command(GraphicsTrace::GET_UNIFORM_LOCATION);
+    writer.U32(program);
+    writer.String(name);
+    writer.I32(location);
+    return location;
+}
+
+// Uniform setters by location
+void RecordingGraphicsAPI::SetUniform1f(int location, float value) {
+    writer.Command(GraphicsTrace::SET_UNIFORM);
+    writer.U8(GraphicsTrace::UNIFORM_FLOAT);
+    writer.I32(location);
+    writer.Float(value);
+    target->SetUniform1f(location, value);
+}
+
+void RecordingGraphicsAPI::SetUniform1i(int location, int value) {
+    writer.Command(GraphicsTrace::SET_UNIFORM);
+    writer.U8(GraphicsTrace::UNIFORM_INT);
+    writer.I32(location);
+    writer.I32(value);
+    target->SetUniform1i(location, value);
+}
+
+void RecordingGraphicsAPI::SetUniform3f(int location, float x, float y, float z) {
+    writer.Command(GraphicsTrace::SET_UNIFORM);
+    writer.U8(GraphicsTrace::UNIFORM_VEC3);
+    writer.I32(location);
+    writer.Float(x);
+    writer.Float(y);
+    writer.Float(z);
+    target->SetUniform3f(location, x, y, z);
+}
+
+void RecordingGraphicsAPI::SetUniform4f(int location, float x, float y, float z, float w) {
+    writer.Command(GraphicsTrace::SET_UNIFORM);
+    writer.U8(GraphicsTrace::UNIFORM_VEC4);
+    writer.I32(location);
+    writer.Float(x);
+    writer.Float(y);
+    writer.Float(z);
+    writer.Float(w);
+    target->SetUniform4f(location, x, y, z, w);
+}
+
+void RecordingGraphicsAPI::SetUniformMatrix4fv(int location, const float* value, bool transpose) {
+    writer.Command(GraphicsTrace::SET_UNIFORM);
+    writer.U8(GraphicsTrace::UNIFORM_MATRIX4);
+    writer.I32(location);
+    writer.Flag(transpose);
+    writer.Floats(value, 16);
+    target->SetUniformMatrix4fv(location, value, transpose);
+}
+
+void RecordingGraphicsAPI::SetUniformFloatArray(int location, const float* values, int count) {
+    writer.Command(GraphicsTrace::SET_UNIFORM);
+    writer.U8(GraphicsTrace::UNIFORM_FLOAT_ARRAY);
+    writer.I32(location);
+    writer.I32(count);
+    writer.Floats(values, count > 0 ? count : 0);
+    target->SetUniformFloatArray(location, values, count);
+}
+
+void RecordingGraphicsAPI::SetUniformIntArray(int location, const int* values, int count) {
+    writer.Command(GraphicsTrace::SET_UNIFORM);
+    writer.U8(GraphicsTrace::UNIFORM_INT_ARRAY);
+    writer.I32(location);
+    writer.I32(count);
+    writer.Ints(values, count > 0 ? count : 0);
+    target->SetUniformIntArray(location, values, count);
+}
+
+void RecordingGraphicsAPI::SetUniformVec3Array(int location, const float* values, int count) {
+    writer.Command(GraphicsTrace::SET_UNIFORM);
+    writer.U8(GraphicsTrace::UNIFORM_VEC3_ARRAY);
+    writer.I32(location);
+    writer.I32(count);
+    writer.Floats(values, count > 0 ? count * 3 : 0);
+    target->SetUniformVec3Array(location, values, count);
+}
+
+void RecordingGraphicsAPI::SetUniformMatrix4Array(int location, const float* values, int count, bool transpose) {
+    writer.Command(GraphicsTrace::SET_UNIFORM);
+    writer.U8(GraphicsTrace::UNIFORM_MATRIX4_ARRAY);
+    writer.I32(location);
+    writer.Flag(transpose);
+    writer.I32(count);
+    writer.Floats(values, count > 0 ? count * 16 : 0);
+    target->SetUniformMatrix4Array(location, values, count, transpose);
+}
+
+void RecordingGraphicsAPI::GetActiveUniforms(unsigned int program, std::vector<std::string>& names,
+                                             std::vector<int>& locations) {
+    target->GetActiveUniforms(program, names, locations);
+    size_t count = names.size() < locations.size() ? names.size() : locations.size();
+    writer.Command(GraphicsTrace::GET_ACTIVE_UNIFORMS);
+    writer.U32(program);
+    writer.U32(static_cast<uint32_t>(count));
+    for (size_t i = 0; i < count; i++) {
+        writer.String(names[i]);
+        writer.I32(locations[i]);
+    }
+}
+
+bool RecordingGraphicsAPI::SetUniformBlockBinding(unsigned int program, const std::string& blockName, unsigned int binding) {
+    writer.Command(GraphicsTrace::SET_UNIFORM_BLOCK_BINDING);
+    writer.U32(program);
+    writer.String(blockName);
+    writer.U32(binding);
+    return target->SetUniformBlockBinding(program, blockName, binding);
+}
+
+void RecordingGraphicsAPI::BindUniformBuffer(unsigned int binding, unsigned int buffer) {
+    writer.Command(GraphicsTrace::BIND_UNIFORM_BUFFER);
+    writer.U32(binding);
+    writer.U32(buffer);
+    target->BindUniformBuffer(binding, buffer);
+}
+
+// Texture management
+unsigned int RecordingGraphicsAPI::CreateTexture() {
+    unsigned int texture = target->CreateTexture();
+    writer.Command(GraphicsTrace::CREATE_TEXTURE);
+    writer.U32(texture);
+    return texture;
+}
+
+void RecordingGraphicsAPI::BindTexture(unsigned int texture, unsigned int unit) {
+    writer.Command(GraphicsTrace::BIND_TEXTURE);
+    writer.U32(texture);
+    writer.U32(unit);
+    target->BindTexture(texture, unit);
+}
+
+void RecordingGraphicsAPI::DeleteTexture(unsigned int texture) {
+    writer.Command(GraphicsTrace::DELETE_TEXTURE);
+    writer.U32(texture);
+    target->DeleteTexture(texture);
+}
+
+void RecordingGraphicsAPI::TexImage2D(int width, int height, const void* data, bool hasAlpha) {
+    size_t size = width > 0 && height > 0 ? static_cast<size_t>(width) * height * (hasAlpha ? 4 : 3) : 0;
+    writer.Command(GraphicsTrace::TEX_IMAGE_2D);
+    writer.I32(width);
+    writer.I32(height);
+    writer.Flag(hasAlpha);
+    writer.Data(data, size);
+    target->TexImage2D(width, height, data, hasAlpha);
+}
+
+void RecordingGraphicsAPI::SetTextureLevels(int levelCount) {
+    writer.Command(GraphicsTrace::SET_TEXTURE_LEVELS);
+    writer.I32(levelCount);
+    target->SetTextureLevels(levelCount);
+}
+
+void RecordingGraphicsAPI::TexImageLevel(int level, TextureFormat format, int width, int height,
+                                         const void* data, size_t size) {
+    writer.Command(GraphicsTrace::TEX_IMAGE_LEVEL);
+    writer.I32(level);
+    writer.U8(static_cast<uint8_t>(format));
+    writer.I32(width);
+    writer.I32(height);
+    writer.Data(data, size);
+    target->TexImageLevel(level, format, width, height, data, size);
+}
+
+// Debug utilities
+void RecordingGraphicsAPI::DrawDebugLine(const Vector3& start, const Vector3& end, const Vector3& color) {
+    writer.Command(GraphicsTrace::DRAW_DEBUG_LINE);
+    const Vector3* points[] = { &start, &end, &color };
+    for (const Vector3* point : points) {
+        writer.Float(point->x);
+        writer.Float(point->y);
+        writer.Float(point->z);
+    }
+    target->DrawDebugLine(start, end, color);
+}
+
+void RecordingGraphicsAPI::DrawDebugAxes() {
+    writer.Command(GraphicsTrace::DRAW_DEBUG_AXES);
+    target->DrawDebugAxes();
+}
+
+// Framebuffer operations
+void RecordingGraphicsAPI::ReadPixels(int x, int y, int width, int height, unsigned char* pixels) {
+    writer.Command(GraphicsTrace::READ_PIXELS);
+    writer.I32(x);
+    writer.I32(y);
+    writer.I32(width);
+    writer.I32(height);
+    target->ReadPixels(x, y, width, height, pixels);
+}
+
+void RecordingGraphicsAPI::GetViewport(int* viewport) {
+    target->GetViewport(viewport);
+}
+
+// Window management
+bool RecordingGraphicsAPI::CreateWindow(int width, int height, const char* title) {
+    return target->CreateWindow(width, height, title);
+}
+
+void RecordingGraphicsAPI::DestroyWindow() {
+    target->DestroyWindow();
+}
+
+void RecordingGraphicsAPI::MakeContextCurrent() {
+    target->MakeContextCurrent();
+}
+
+bool RecordingGraphicsAPI::IsWindowOpen() {
+    return target->IsWindowOpen();
+}
+
+void RecordingGraphicsAPI::PollEvents() {
+    target->PollEvents();
+}
+
+void RecordingGraphicsAPI::SwapBuffers() {
+    writer.Command(GraphicsTrace::SWAP_BUFFERS);
+    target->SwapBuffers();
+    frameCount++;
+    Flush();
+}
+
+void RecordingGraphicsAPI::UseDefaultRedShader() {
+    writer.Command(GraphicsTrace::USE_DEFAULT_RED_SHADER);
+    target->UseDefaultRedShader();
+}
+
+// Matrix operations
+void RecordingGraphicsAPI::SetProjectionMatrix(const Matrix4x4& matrix) {
+    writer.Command(GraphicsTrace::SET_PROJECTION_MATRIX);
+    writer.Floats(&matrix.elements[0][0], 16);
+    target->SetProjectionMatrix(matrix);
+}
+
+void RecordingGraphicsAPI::SetViewMatrix(const Matrix4x4& matrix) {
+    writer.Command(GraphicsTrace::SET_VIEW_MATRIX);
+    writer.Floats(&matrix.elements[0][0], 16);
+    target->SetViewMatrix(matrix);
+}
+
+void RecordingGraphicsAPI::SetModelMatrix(const Matrix4x4& matrix) {
+    writer.Command(GraphicsTrace::SET_MODEL_MATRIX);
+    writer.Floats(&matrix.elements[0][0], 16);
+    target->SetModelMatrix(matrix);
+}
+
+// Input handling
+void RecordingGraphicsAPI::GetMousePosition(int& x, int& y) {
+    target->GetMousePosition(x, y);
+}
+
+bool RecordingGraphicsAPI::IsMouseButtonPressed(int button) {
+    return target->IsMouseButtonPressed(button);
+}
@@ -0,0 +1,171 @@
+#ifndef GAME_ENGINE_SAVI_RECORDING_GRAPHICS_API_H
+#define GAME_ENGINE_SAVI_RECORDING_GRAPHICS_API_H
+
+#include "IGraphicsAPI.h"
+#include "GraphicsTrace.h"
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Graphics API that records every call into a GraphicsTrace and passes it
+// on to another API, which does the actual work. Recording on top of a
+// NullGraphicsAPI captures the renderer's command stream without a GPU.
+//
+//     auto recorder = std::make_shared<RecordingGraphicsAPI>(std::make_shared<NullGraphicsAPI>(), "frame.sgtr");
+//
+// With a path the trace is appended to the file as each frame ends, so
+// long runs do not hold it in memory; without one it stays in memory for
+// GetTrace. Start recording before anything is created: a trace replays
+// objects it did not see being created under their recorded handles.
+class RecordingGraphicsAPI : public IGraphicsAPI {
+public:
+    explicit RecordingGraphicsAPI(std::shared_ptr<IGraphicsAPI> target, const std::string& path = "");
+    virtual ~RecordingGraphicsAPI();
+
+    IGraphicsAPI* GetTarget() const { return target.get(); }
+
+    // The trace in memory: all of it without a file, the unfinished frame
+    // with one
+    const std::vector<uint8_t>& GetTrace() const { return writer.GetBytes(); }
+    size_t GetCommandCount() const { return writer.GetCommandCount(); }
+    size_t GetFrameCount() const { return frameCount; }
+
+    // Append what was recorded to the file; false if it cannot be written
+    bool Flush();
+
+    // Initialization and cleanup
+    virtual bool Initialize() override;
+    virtual void Shutdown() override;
+
+    // Buffer management
+    virtual unsigned int CreateVertexArray() override;
+    virtual void BindVertexArray(unsigned int vao) override;
+    virtual void DeleteVertexArray(unsigned int vao) override;
+
+    virtual unsigned int CreateBuffer() override;
+    virtual void BindBuffer(BufferType type, unsigned int buffer) override;
+    virtual void DeleteBuffer(unsigned int buffer) override;
+    virtual void BufferData(BufferType type, const void* data, size_t size, bool dynamic = false) override;
+
+    // Attribute configuration
+    virtual void EnableVertexAttrib(unsigned int index) override;
+    virtual void DisableVertexAttrib(unsigned int index) override;
+    virtual void VertexAttribPointer(unsigned int index, int size, bool normalized, size_t stride, const void* pointer) override;
+    virtual void VertexAttribPointer(unsigned int index, int size, AttribType type, bool normalized, size_t stride, const void* pointer) override;
+    virtual void VertexAttribDivisor(unsigned int index, unsigned int divisor) override;
+
+    // Drawing
+    virtual void DrawArrays(DrawMode mode, int first, int count) override;
+    virtual void DrawElements(DrawMode mode, int count, const void* indices) override;
+    virtual void DrawElements(DrawMode mode, int count, IndexType type, const void* indices) override;
+    virtual void DrawArraysInstanced(DrawMode mode, int first, int count, int instanceCount) override;
+    virtual void DrawElementsInstanced(DrawMode mode, int count, IndexType type, const void* indices, int instanceCount) override;
+    virtual bool SupportsInstancing() const override { return target->SupportsInstancing(); }
+
+    // Viewport and clear
+    virtual void SetViewport(int x, int y, int width, int height) override;
+    virtual void Begin2D() override;
+    virtual void End2D() override;
+    virtual void Clear(bool colorBuffer, bool depthBuffer) override;
+    virtual void SetClearColor(float r, float g, float b, float a) override;
+
+    // Depth and culling
+    virtual void SetDepthTest(bool enable) override;
+    virtual void SetDepthFunc(int func) override;
+    virtual void SetCullFace(bool enable) override;
+    virtual void SetCullFaceMode(int mode) override;
+
+    // Shader management
+    virtual void UseShaderProgram(ShaderProgram* program) override;
+    virtual void UseProgram(unsigned int program) override;
+    virtual unsigned int CreateShader(int shaderType) override;
+    virtual void DeleteShader(unsigned int shader) override;
+    virtual void ShaderSource(unsigned int shader, const std::string& source) override;
+    virtual void CompileShader(unsigned int shader) override;
+    virtual bool GetShaderCompileStatus(unsigned int shader) override;
+    virtual std::string GetShaderInfoLog(unsigned int shader) override;
+    virtual bool GetProgramLinkStatus(unsigned int program) override;
+    virtual std::string GetProgramInfoLog(unsigned int program) override;
+    virtual void AttachShader(unsigned int program, unsigned int shader) override;
+    virtual void LinkProgram(unsigned int program) override;
+    virtual unsigned int CreateProgram() override;
+    virtual void DeleteProgram(unsigned int program) override;
+
+    // Uniform setters
+    virtual void SetUniform1f(unsigned int program, const std::string& name, float value) override;
+    virtual void SetUniform1i(unsigned int program, const std::string& name, int value) override;
+    virtual void SetUniform3f(unsigned int program, const std::string& name, float x, float y, float z) override;
+    virtual void SetUniform4f(unsigned int program, const std::string& name, float x, float y, float z, float w) override;
+    virtual void SetUniformMatrix4fv(unsigned int program, const std::string& name, const float* value, bool transpose = false) override;
+    virtual void SetUniformFloatArray(unsigned int program, const std::string& name, const float* values, int count) override;
+    virtual void SetUniformIntArray(unsigned int program, const std::string& name, const int* values, int count) override;
+    virtual void SetUniformVec3Array(unsigned int program, const std::string& name, const float* values, int count) override;
+    virtual void SetUniformMatrix4Array(unsigned int program, const std::string& name, const float* values, int count, bool transpose = false) override;
+    virtual int GetUniformLocation(unsigned int program, const std::string& name) override;
+
+    virtual void SetUniform1f(int location, float value) override;
+    virtual void SetUniform1i(int location, int value) override;
+    virtual void SetUniform3f(int location, float x, float y, float z) override;
+    virtual void SetUniform4f(int location, float x, float y, float z, float w) override;
+    virtual void SetUniformMatrix4fv(int location, const float* value, bool transpose = false) override;
+    virtual void SetUniformFloatArray(int location, const float* values, int count) override;
+    virtual void SetUniformIntArray(int location, const int* values, int count) override;
+    virtual void SetUniformVec3Array(int location, const float* values, int count) override;
+    virtual void SetUniformMatrix4Array(int location, const float* values, int count, bool transpose = false) override;
+
+    virtual void GetActiveUniforms(unsigned int program, std::vector<std::string>& names,
+                                   std::vector<int>& locations) override;
+    virtual bool SetUniformBlockBinding(unsigned int program, const std::string& blockName, unsigned int binding) override;
+    virtual void BindUniformBuffer(unsigned int binding, unsigned int buffer) override;
+
+    // Texture management
+    virtual unsigned int CreateTexture() override;
+    virtual void BindTexture(unsigned int texture, unsigned int unit) override;
+    virtual void DeleteTexture(unsigned int texture) override;
+    virtual void TexImage2D(int width, int height, const void* data, bool hasAlpha) override;
+    virtual void SetTextureLevels(int levelCount) override;
+    virtual void TexImageLevel(int level, TextureFormat format, int width, int height,
+                               const void* data, size_t size) override;
+
+    // Debug utilities
+    virtual void DrawDebugLine(const Vector3& start, const Vector3& end, const Vector3& color) override;
+    virtual void DrawDebugAxes() override;
+
+    // Framebuffer operations
+    virtual void ReadPixels(int x, int y, int width, int height, unsigned char* pixels) override;
+    virtual void GetViewport(int* viewport) override;
+
+    // Window management, passed on without being recorded
+    virtual bool CreateWindow(int width, int height, const char* title) override;
+    virtual void DestroyWindow() override;
+    virtual void MakeContextCurrent() override;
+    virtual bool IsWindowOpen() override;
+    virtual void PollEvents() override;
+
+    // Ends the frame; a trace being written to a file gets the frame appended
+    virtual void SwapBuffers() override;
+
+    virtual const char* GetAPIName() const override { return "Recording"; }
+
+    virtual void UseDefaultRedShader() override;
+
+    // Matrix operations
+    virtual void SetProjectionMatrix(const Matrix4x4& matrix) override;
+    virtual void SetViewMatrix(const Matrix4x4& matrix) override;
+    virtual void SetModelMatrix(const Matrix4x4& matrix) override;
+    virtual bool SupportsMatrixOperations() const override { return target->SupportsMatrixOperations(); }
+
+    // Input handling
+    virtual void GetMousePosition(int& x, int& y) override;
+    virtual bool IsMouseButtonPressed(int button) override;
+
+private:
+    std::shared_ptr<IGraphicsAPI> target;
+    GraphicsTrace::Writer writer;
+    std::string path;
+    std::ofstream file;
+    size_t frameCount;
+};
+
+#endif // GAME_ENGINE_SAVI_RECORDING_GRAPHICS_API_H
@@ -0,0 +1,104 @@
+#include "JobSystem.h"
+#include <iostream>
+#include <exception>
+
+// Initialize static instance
+JobSystem* JobSystem::instance = nullptr;
+
+JobSystem::JobSystem() : workerCount(0), runningJobs(0), stopping(false) {
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+JobSystem& JobSystem::GetInstance() {
+    if (!instance) {
+        instance = new JobSystem();
+    }
+    return *instance;
+}
+
+void JobSystem::Submit(Job job) {
+    if (!job) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (workers.empty()) {
+            StartWorkers();
+        }
+        jobs.push_back(std::move(job));
+    }
+    jobAvailable.notify_one();
+}
+
+void JobSystem::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this]() { return jobs.empty() && runningJobs == 0; });
+}
+
+void JobSystem::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (workers.empty()) {
+            return;
+        }
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    workers.clear();
+    workerCount = 0;
+    stopping = false;
+}
+
+void JobSystem::StartWorkers() {
+    // Leave one core for the main thread
+    unsigned int cores = std::thread::hardware_concurrency();
+    workerCount = cores > 1 ? cores - 1 : 1;
+
+    for (size_t i = 0; i < workerCount; i++) {
+        workers.push_back(std::thread(&JobSystem::WorkerLoop, this));
+    }
+}
+
+void JobSystem::WorkerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this]() { return stopping || !jobs.empty(); });
+
+            // Drain the queue before stopping
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+            runningJobs++;
+        }
+
+        try {
+            job();
+        } catch (const std::exception& e) {
+            std::cerr << "JobSystem: job threw an exception: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "JobSystem: job threw an unknown exception" << std::endl;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            runningJobs--;
+            if (jobs.empty() && runningJobs == 0) {
+                idle.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+// Shared pool of worker threads for background work (file parsing, asset
+// decoding, ...). Jobs must not touch the graphics API or scene state that
+// the main thread is using; hand results back to the main thread instead.
+//
+//     JobSystem::GetInstance().Submit([]() { ... });
+class JobSystem {
+public:
+    typedef std::function<void()> Job;
+
+    static JobSystem& GetInstance();
+
+    // Queue a job for a worker thread. Workers are started on first use.
+    void Submit(Job job);
+
+    // Block until every queued and running job has finished
+    void WaitIdle();
+
+    // Finish outstanding jobs and stop the workers (Submit restarts them)
+    void Shutdown();
+
+    size_t GetWorkerCount() const { return workerCount; }
+
+private:
+    JobSystem();
+    ~JobSystem();
+
+    static JobSystem* instance;
+
+    std::vector<std::thread> workers;
+    std::deque<Job> jobs;
+    std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable idle;
+    size_t workerCount;
+    size_t runningJobs;
+    bool stopping;
+
+    void StartWorkers();
+    void WorkerLoop();
+};
+
+#endif // JOB_SYSTEM_H
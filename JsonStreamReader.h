@@ -0,0 +1,179 @@
+#ifndef JSON_STREAM_READER_H
+#define JSON_STREAM_READER_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <cstddef>
+#include "ThirdParty/json/json.hpp"
+
+// Event-based (SAX) JSON reader. Values are delivered to the virtual
+// handlers as they are parsed, with the path that leads to them, so a
+// loader can build its objects directly instead of going through an
+// nlohmann::json document. Memory use is independent of the file size.
+//
+// Depth() is the number of containers enclosing the current value and
+// KeyAt(i) the key used at container level i: the member name inside an
+// object, or "[]" inside an array. CurrentKey() is KeyAt(Depth() - 1).
+// OnBeginObject/OnBeginArray see the container's own key; so do the
+// matching OnEndObject/OnEndArray.
+//
+//     class Reader : public JsonStreamReader {
+//         bool OnNumber(double value) override {
+//             if (Depth() == 2 && KeyAt(0) == "physics" && CurrentKey() == "gravity") gravity = value;
+//             return true;
+//         }
+//     };
+//
+// Handlers return false to stop parsing; Parse then fails. A handler that
+// has read everything it needs returns Stop() instead, and Parse succeeds.
+class JsonStreamReader : public nlohmann::json_sax<nlohmann::json> {
+public:
+    virtual ~JsonStreamReader() {}
+
+    // Parse a stream or file, reporting problems on std::cerr
+    bool Parse(std::istream& input, const std::string& sourceName) {
+        frames.clear();
+        error.clear();
+        stopped = false;
+        source = &input;
+        sourceStart = input.tellg();
+        sourceSize = 0;
+        if (sourceStart >= 0 && input.seekg(0, std::ios::end)) {
+            sourceSize = input.tellg() - sourceStart;
+            input.seekg(sourceStart);
+        }
+        input.clear();
+        bool ok = nlohmann::json::sax_parse(input, this);
+        source = nullptr;
+        if (!ok && stopped) {
+            return true;
+        }
+        if (!ok && error.empty()) {
+            error = "parsing stopped";
+        }
+        if (!ok) {
+            std::cerr << "Error reading " << sourceName << ": " << error << std::endl;
+        }
+        return ok;
+    }
+
+    bool ParseFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open file for reading: " << path << std::endl;
+            return false;
+        }
+        return Parse(file, path);
+    }
+
+    const std::string& GetError() const { return error; }
+
+protected:
+    size_t Depth() const { return frames.size(); }
+    const std::string& KeyAt(size_t level) const { return frames[level].key; }
+    const std::string& CurrentKey() const { return frames.empty() ? emptyKey : frames.back().key; }
+
+    // Fraction of the input read so far, from 0 to 1; 0 for streams that
+    // cannot seek
+    float Progress() const {
+        if (!source || sourceSize <= 0) {
+            return 0.0f;
+        }
+        std::streamoff read = source->tellg() - sourceStart;
+        return read <= 0 ? 0.0f : read >= sourceSize ? 1.0f : static_cast<float>(read) / static_cast<float>(sourceSize);
+    }
+
+    // Stop with a message
+    bool Fail(const std::string& message) {
+        error = message;
+        return false;
+    }
+
+    // Stop without an error
+    bool Stop() {
+        stopped = true;
+        return false;
+    }
+
+    virtual bool OnBeginObject() { return true; }
+    virtual bool OnEndObject() { return true; }
+    virtual bool OnBeginArray() { return true; }
+    virtual bool OnEndArray() { return true; }
+    virtual bool OnString(const std::string& value) { (void)value; return true; }
+    virtual bool OnNumber(double value) { (void)value; return true; }
+    virtual bool OnBool(bool value) { (void)value; return true; }
+    virtual bool OnNull() { return true; }
+
+private:
+    struct Frame {
+        bool isArray;
+        std::string key;
+    };
+
+    std::vector<Frame> frames;
+    std::string error;
+    bool stopped = false;
+    const std::string emptyKey;
+    std::istream* source = nullptr;
+    std::streamoff sourceStart = 0;
+    std::streamoff sourceSize = 0;
+
+    void Push(bool isArray) {
+        Frame frame;
+        frame.isArray = isArray;
+        if (isArray) {
+            frame.key = "[]";
+        }
+        frames.push_back(frame);
+    }
+
+public:
+    // nlohmann::json_sax interface
+    bool null() override { return OnNull(); }
+    bool boolean(bool value) override { return OnBool(value); }
+    bool number_integer(number_integer_t value) override { return OnNumber(static_cast<double>(value)); }
+    bool number_unsigned(number_unsigned_t value) override { return OnNumber(static_cast<double>(value)); }
+    bool number_float(number_float_t value, const string_t&) override { return OnNumber(value); }
+    bool string(string_t& value) override { return OnString(value); }
+    bool binary(binary_t&) override { return true; }
+
+    bool start_object(std::size_t) override {
+        if (!OnBeginObject()) {
+            return false;
+        }
+        Push(false);
+        return true;
+    }
+
+    bool key(string_t& value) override {
+        frames.back().key.swap(value);
+        return true;
+    }
+
+    bool end_object() override {
+        frames.pop_back();
+        return OnEndObject();
+    }
+
+    bool start_array(std::size_t) override {
+        if (!OnBeginArray()) {
+            return false;
+        }
+        Push(true);
+        return true;
+    }
+
+    bool end_array() override {
+        frames.pop_back();
+        return OnEndArray();
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::json::exception& e) override {
+        error = e.what();
+        return false;
+    }
+};
+
+#endif // JSON_STREAM_READER_H
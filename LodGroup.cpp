@@ -0,0 +1,89 @@
+#include "LodGroup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+LodGroup::LodGroup() : hysteresis(0.1f), crossfadeDuration(0.0f) {
+    // Half the height for each level, as GenerateLods halves the triangles
+    transitions = { 0.4f, 0.2f, 0.1f };
+}
+
+void LodGroup::SetTransitions(const std::vector<float>& screenHeights) {
+    transitions = screenHeights;
+    std::sort(transitions.begin(), transitions.end(), [](float a, float b) { return a > b; });
+}
+
+LodGroup::Selection LodGroup::Select(const Camera* camera, float screenHeight, size_t levelCount) {
+    size_t lastLevel = levelCount > 0 ? levelCount - 1 : 0;
+
+    auto it = cameras.find(camera);
+    if (it == cameras.end()) {
+        // First sight: no previous level to hold on to or fade from
+        Selection selection;
+        selection.level = GetLevel(screenHeight, levelCount);
+        selection.fadeLevel = selection.level;
+        cameras[camera] = selection;
+        return selection;
+    }
+
+    Selection& state = it->second;
+    state.level = std::min(state.level, lastLevel);
+    state.fadeLevel = std::min(state.fadeLevel, lastLevel);
+
+    size_t level = state.level;
+    while (level < lastLevel && level < transitions.size() && screenHeight < transitions[level] * (1.0f - hysteresis)) {
+        ++level;
+    }
+    if (level == state.level) {
+        while (level > 0 && screenHeight > transitions[level - 1] * (1.0f + hysteresis)) {
+            --level;
+        }
+    }
+
+    if (level != state.level) {
+        if (crossfadeDuration > 0.0f) {
+            state.fadeLevel = state.level;
+            state.fade = 0.0f;
+        } else {
+            state.fadeLevel = level;
+        }
+        state.level = level;
+    }
+    return state;
+}
+
+void LodGroup::Update(float deltaTime) {
+    for (auto& entry : cameras) {
+        Selection& state = entry.second;
+        if (state.fade >= 1.0f) {
+            continue;
+        }
+        state.fade = crossfadeDuration > 0.0f ? std::min(1.0f, state.fade + deltaTime / crossfadeDuration) : 1.0f;
+        if (state.fade >= 1.0f) {
+            state.fadeLevel = state.level;
+        }
+    }
+}
+
+float LodGroup::GetScreenHeight(const Vector3& center, float radius, const Vector3& cameraPosition,
+                                const Matrix4x4& projection) {
+    // Orthographic projections scale by a constant
+    if (projection.elements[3][3] != 0.0f) {
+        return radius * std::fabs(projection.elements[1][1]);
+    }
+
+    float distance = (center - cameraPosition).magnitude();
+    if (distance <= radius) {
+        return std::numeric_limits<float>::max();
+    }
+    return radius * std::fabs(projection.elements[1][1]) / distance;
+}
+
+size_t LodGroup::GetLevel(float screenHeight, size_t levelCount) const {
+    size_t level = 0;
+    while (level + 1 < levelCount && level < transitions.size() && screenHeight < transitions[level]) {
+        ++level;
+    }
+    return level;
+}
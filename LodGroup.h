@@ -0,0 +1,73 @@
+#ifndef LOD_GROUP_H
+#define LOD_GROUP_H
+
+#include <cstddef>
+#include <map>
+#include <vector>
+#include "MonoBehaviourLike.h"
+#include "Matrix4x4.h"
+#include "Vector3.h"
+
+class Camera;
+
+// Chooses the level of detail a GameObject's models are drawn at from how
+// tall they appear on screen. Each camera keeps its own level, so the
+// minimap can draw a prop coarse while the main view draws it in full.
+//
+//     auto lod = std::make_shared<LodGroup>();
+//     lod->SetCrossfadeDuration(0.25f);
+//     gameObject->AddComponent(lod);
+//
+// Level i + 1 is drawn once the screen height, as a fraction of the
+// viewport height, falls below transition i. The height has to move
+// GetHysteresis() past a transition before the level changes back, so
+// objects resting near one do not flicker. With a crossfade, the old and
+// new levels are drawn together for a moment, each keeping the fragments
+// the other discards in a dither pattern.
+class LodGroup : public MonoBehaviourLike {
+public:
+    // What a camera draws this frame
+    struct Selection {
+        size_t level = 0;       // level fading in, or the only one drawn
+        size_t fadeLevel = 0;   // level fading out
+        float fade = 1.0f;      // crossfade progress; 1 once only level is drawn
+    };
+
+    LodGroup();
+
+    // Screen heights at which each coarser level takes over, decreasing
+    void SetTransitions(const std::vector<float>& screenHeights);
+    const std::vector<float>& GetTransitions() const { return transitions; }
+
+    // Fraction of a transition the height must cross it by, both ways
+    void SetHysteresis(float fraction) { hysteresis = fraction; }
+    float GetHysteresis() const { return hysteresis; }
+
+    // Seconds a level change is dithered over; 0 switches at once
+    void SetCrossfadeDuration(float seconds) { crossfadeDuration = seconds; }
+    float GetCrossfadeDuration() const { return crossfadeDuration; }
+
+    // Level for a camera this frame, for models with levelCount levels
+    Selection Select(const Camera* camera, float screenHeight, size_t levelCount);
+
+    // Advance crossfades
+    virtual void Update(float deltaTime) override;
+
+    // Forget the level a camera saw
+    void RemoveCamera(const Camera* camera) { cameras.erase(camera); }
+
+    // Height of a sphere on screen as a fraction of the viewport height
+    static float GetScreenHeight(const Vector3& center, float radius, const Vector3& cameraPosition,
+                                 const Matrix4x4& projection);
+
+private:
+    std::vector<float> transitions;
+    float hysteresis;
+    float crossfadeDuration;
+    std::map<const Camera*, Selection> cameras;
+
+    // Level for a height, ignoring what was drawn before
+    size_t GetLevel(float screenHeight, size_t levelCount) const;
+};
+
+#endif // LOD_GROUP_H
@@ -0,0 +1,37 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file (mmap, or MapViewOfFile on
+// Windows). The contents are paged in on demand and shared with the OS
+// file cache, so large files are used in place without a copy.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Map the file; an empty file opens with no data
+    bool Open(const std::string& path);
+    void Close();
+
+    bool IsOpen() const { return open; }
+    const unsigned char* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+
+private:
+    const unsigned char* data;
+    size_t size;
+    bool open;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+    // Non-copyable; owns the mapping
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+};
+
+#endif // MAPPED_FILE_H
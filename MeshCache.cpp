@@ -0,0 +1,453 @@
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "MappedFile.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+static_assert(sizeof(MeshCache::Header) == 96, "Header layout changed");
+static_assert(sizeof(MeshCache::SubmeshRecord) == 16, "SubmeshRecord layout changed");
+static_assert(sizeof(MeshCache::LodRecord) == 16, "LodRecord layout changed");
+
+namespace {
+    std::atomic<bool> cacheEnabled(true);
+
+    size_t Align8(size_t size) {
+        return (size + 7) & ~static_cast<size_t>(7);
+    }
+
+    bool GetSourceStamp(const std::string& path, uint64_t& size, int64_t& time) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) {
+            return false;
+        }
+        size = static_cast<uint64_t>(info.st_size);
+#if defined(__APPLE__)
+        time = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+        time = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#else
+        time = static_cast<int64_t>(info.st_mtime) * 1000000000;
+#endif
+        return true;
+    }
+
+    // Header of a cooked file if it looks valid
+    bool ReadHeader(const MappedFile& file, MeshCache::Header& header) {
+        if (file.GetSize() < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, file.GetData(), sizeof(header));
+        return header.magic == MeshCache::MAGIC && header.version == MeshCache::VERSION;
+    }
+
+    // Block-by-block view of a cooked file with bounds checking
+    class BlockReader {
+    public:
+        BlockReader(const MappedFile& file) : data(file.GetData()), size(file.GetSize()), offset(sizeof(MeshCache::Header)) {}
+
+        const unsigned char* Next(size_t bytes) {
+            if (offset > size || bytes > size - offset) {
+                return nullptr;
+            }
+            const unsigned char* block = data + offset;
+            offset = Align8(offset + bytes);
+            if (offset > size) {
+                offset = size;
+            }
+            return block;
+        }
+
+    private:
+        const unsigned char* data;
+        size_t size;
+        size_t offset;
+    };
+
+    template <typename T>
+    bool ReadArray(BlockReader& reader, size_t count, std::vector<T>& out) {
+        const unsigned char* block = reader.Next(count * sizeof(T));
+        if (!block) {
+            return false;
+        }
+        out.resize(count);
+        if (count > 0) {
+            std::memcpy(out.data(), block, count * sizeof(T));
+        }
+        return true;
+    }
+
+    bool ReadMesh(const MappedFile& file, const MeshCache::Header& header, ObjMeshData& mesh) {
+        mesh = ObjMeshData();
+
+        size_t vertices = header.vertexCount;
+        BlockReader reader(file);
+        if (!ReadArray(reader, vertices * 3, mesh.positions)) {
+            return false;
+        }
+        if ((header.flags & MeshCache::HAS_NORMALS) && !ReadArray(reader, vertices * 3, mesh.normals)) {
+            return false;
+        }
+        if ((header.flags & MeshCache::HAS_TEX_COORDS) && !ReadArray(reader, vertices * 2, mesh.texCoords)) {
+            return false;
+        }
+        if (!ReadArray(reader, header.indexCount, mesh.indices) ||
+            !ReadArray(reader, header.lodIndexCount, mesh.lodIndices)) {
+            return false;
+        }
+
+        std::vector<MeshCache::LodRecord> lods;
+        if (!ReadArray(reader, header.lodCount, lods)) {
+            return false;
+        }
+
+        std::vector<MeshCache::SubmeshRecord> submeshes;
+        std::vector<uint32_t> libraries;
+        std::vector<char> strings;
+        if (!ReadArray(reader, header.submeshCount, submeshes) ||
+            !ReadArray(reader, header.libraryCount, libraries) ||
+            !ReadArray(reader, header.stringsSize, strings)) {
+            return false;
+        }
+        if (!strings.empty() && strings.back() != '\0') {
+            return false;
+        }
+
+        auto stringAt = [&strings](uint32_t offset, std::string& out) {
+            if (offset >= strings.size()) {
+                return false;
+            }
+            out = &strings[offset];
+            return true;
+        };
+
+        for (size_t i = 0; i < mesh.indices.size(); ++i) {
+            if (mesh.indices[i] >= vertices) {
+                return false;
+            }
+        }
+        for (size_t i = 0; i < mesh.lodIndices.size(); ++i) {
+            if (mesh.lodIndices[i] >= vertices) {
+                return false;
+            }
+        }
+        for (const MeshCache::LodRecord& record : lods) {
+            if (static_cast<uint64_t>(record.firstIndex) + record.indexCount > mesh.lodIndices.size()) {
+                return false;
+            }
+            ObjMeshLod lod;
+            lod.firstIndex = record.firstIndex;
+            lod.indexCount = record.indexCount;
+            lod.error = record.error;
+            mesh.lods.push_back(lod);
+        }
+        for (const MeshCache::SubmeshRecord& record : submeshes) {
+            ObjSubmesh submesh;
+            if (!stringAt(record.material, submesh.material) ||
+                static_cast<uint64_t>(record.firstIndex) + record.indexCount > mesh.indices.size()) {
+                return false;
+            }
+            submesh.firstIndex = record.firstIndex;
+            submesh.indexCount = record.indexCount;
+            mesh.submeshes.push_back(submesh);
+        }
+        for (uint32_t offset : libraries) {
+            std::string library;
+            if (!stringAt(offset, library)) {
+                return false;
+            }
+            mesh.materialLibraries.push_back(library);
+        }
+        if (!mesh.submeshes.empty()) {
+            mesh.material = mesh.submeshes.back().material;
+        }
+
+        mesh.boundsMin = Vector3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+        mesh.boundsMax = Vector3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+        mesh.faceCorners = mesh.indices.size();
+        return true;
+    }
+
+    void WriteBlock(std::ofstream& file, const void* bytes, size_t size) {
+        static const char padding[8] = { 0 };
+        if (size > 0) {
+            file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+        }
+        file.write(padding, static_cast<std::streamsize>(Align8(size) - size));
+    }
+
+    // Record the source's new size and time in a cooked file whose contents
+    // are still current, so the next load can skip hashing
+    void UpdateStamp(const std::string& cookedPath, const MeshCache::Header& header) {
+        std::fstream file(cookedPath, std::ios::in | std::ios::out | std::ios::binary);
+        if (file.is_open()) {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+    }
+}
+
+// Parse an OBJ, optimize it for drawing and build its levels of detail
+static bool Import(const MappedFile& sourceFile, ObjMeshData& mesh, const std::string& sourcePath) {
+    if (!ObjLoader::Parse(reinterpret_cast<const char*>(sourceFile.GetData()), sourceFile.GetSize(), mesh, sourcePath)) {
+        return false;
+    }
+    MeshOptimizer::Optimize(mesh);
+    MeshSimplifier::GenerateLods(mesh);
+    return true;
+}
+
+bool MeshCache::Load(const std::string& sourcePath, ObjMeshData& mesh, bool* fromCache) {
+    if (fromCache) {
+        *fromCache = false;
+    }
+    if (!IsEnabled()) {
+        if (!ObjLoader::Load(sourcePath, mesh)) {
+            return false;
+        }
+        MeshOptimizer::Optimize(mesh);
+        MeshSimplifier::GenerateLods(mesh);
+        return true;
+    }
+
+    std::string cookedPath = GetCookedPath(sourcePath);
+    uint64_t settings = GetSettingsHash();
+
+    Header source;
+    std::memset(&source, 0, sizeof(source));
+    bool hasSource = GetSourceStamp(sourcePath, source.sourceSize, source.sourceTime);
+
+    MappedFile cooked;
+    Header header;
+    bool hasCooked = cooked.Open(cookedPath) && ReadHeader(cooked, header) && header.settingsHash == settings;
+
+    // Unchanged since it was cooked, or only the cooked file was shipped
+    if (hasCooked && (!hasSource || (header.sourceSize == source.sourceSize && header.sourceTime == source.sourceTime))) {
+        if (ReadMesh(cooked, header, mesh)) {
+            if (fromCache) {
+                *fromCache = true;
+            }
+            return true;
+        }
+        std::cerr << "Warning: Invalid cooked mesh, importing again: " << cookedPath << std::endl;
+        hasCooked = false;
+    }
+
+    MappedFile sourceFile;
+    if (!sourceFile.Open(sourcePath)) {
+        std::cerr << "Error: Could not open file " << sourcePath << std::endl;
+        return false;
+    }
+    source.contentHash = Hash(sourceFile.GetData(), sourceFile.GetSize());
+    source.settingsHash = settings;
+
+    // Touched but not changed
+    if (hasCooked && header.contentHash == source.contentHash && ReadMesh(cooked, header, mesh)) {
+        cooked.Close();
+        header.sourceSize = source.sourceSize;
+        header.sourceTime = source.sourceTime;
+        UpdateStamp(cookedPath, header);
+        if (fromCache) {
+            *fromCache = true;
+        }
+        return true;
+    }
+    cooked.Close();
+
+    if (!Import(sourceFile, mesh, sourcePath)) {
+        return false;
+    }
+
+    // A failed write only costs the next load an import
+    Write(cookedPath, mesh, source);
+    return true;
+}
+
+bool MeshCache::Cook(const std::string& sourcePath) {
+    MappedFile sourceFile;
+    if (!sourceFile.Open(sourcePath)) {
+        std::cerr << "Error: Could not open file " << sourcePath << std::endl;
+        return false;
+    }
+
+    Header source;
+    std::memset(&source, 0, sizeof(source));
+    GetSourceStamp(sourcePath, source.sourceSize, source.sourceTime);
+    source.contentHash = Hash(sourceFile.GetData(), sourceFile.GetSize());
+    source.settingsHash = GetSettingsHash();
+
+    ObjMeshData mesh;
+    if (!Import(sourceFile, mesh, sourcePath)) {
+        return false;
+    }
+    return Write(GetCookedPath(sourcePath), mesh, source);
+}
+
+bool MeshCache::Read(const std::string& cookedPath, ObjMeshData& mesh) {
+    MappedFile file;
+    Header header;
+    if (!file.Open(cookedPath)) {
+        std::cerr << "Error: Could not open file " << cookedPath << std::endl;
+        return false;
+    }
+    if (!ReadHeader(file, header) || !ReadMesh(file, header, mesh)) {
+        std::cerr << "Error: Invalid cooked mesh file: " << cookedPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool MeshCache::Write(const std::string& cookedPath, const ObjMeshData& mesh, const Header& source) {
+    size_t vertexCount = mesh.GetVertexCount();
+    bool hasNormals = !mesh.normals.empty();
+    bool hasTexCoords = !mesh.texCoords.empty();
+    if ((hasNormals && mesh.normals.size() != vertexCount * 3) ||
+        (hasTexCoords && mesh.texCoords.size() != vertexCount * 2) ||
+        vertexCount > 0xFFFFFFFFu || mesh.indices.size() > 0xFFFFFFFFu || mesh.lodIndices.size() > 0xFFFFFFFFu) {
+        std::cerr << "Error: Mesh cannot be cooked: " << cookedPath << std::endl;
+        return false;
+    }
+
+    // String table
+    std::vector<char> strings;
+    auto addString = [&strings](const std::string& text) {
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings.insert(strings.end(), text.begin(), text.end());
+        strings.push_back('\0');
+        return offset;
+    };
+
+    std::vector<SubmeshRecord> submeshes;
+    for (const ObjSubmesh& submesh : mesh.submeshes) {
+        SubmeshRecord record;
+        record.material = addString(submesh.material);
+        record.firstIndex = static_cast<uint32_t>(submesh.firstIndex);
+        record.indexCount = static_cast<uint32_t>(submesh.indexCount);
+        record.reserved = 0;
+        submeshes.push_back(record);
+    }
+    std::vector<LodRecord> lods;
+    for (const ObjMeshLod& lod : mesh.lods) {
+        LodRecord record;
+        record.firstIndex = static_cast<uint32_t>(lod.firstIndex);
+        record.indexCount = static_cast<uint32_t>(lod.indexCount);
+        record.error = lod.error;
+        record.reserved = 0;
+        lods.push_back(record);
+    }
+    std::vector<uint32_t> libraries;
+    for (const std::string& library : mesh.materialLibraries) {
+        libraries.push_back(addString(library));
+    }
+
+    Header header = source;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.vertexCount = static_cast<uint32_t>(vertexCount);
+    header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    header.submeshCount = static_cast<uint32_t>(submeshes.size());
+    header.libraryCount = static_cast<uint32_t>(libraries.size());
+    header.flags = (hasNormals ? HAS_NORMALS : 0u) | (hasTexCoords ? HAS_TEX_COORDS : 0u);
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+    header.lodCount = static_cast<uint32_t>(lods.size());
+    header.lodIndexCount = static_cast<uint32_t>(mesh.lodIndices.size());
+    header.boundsMin[0] = mesh.boundsMin.x;
+    header.boundsMin[1] = mesh.boundsMin.y;
+    header.boundsMin[2] = mesh.boundsMin.z;
+    header.boundsMax[0] = mesh.boundsMax.x;
+    header.boundsMax[1] = mesh.boundsMax.y;
+    header.boundsMax[2] = mesh.boundsMax.z;
+
+    // Written under a temporary name so that a reader never maps a
+    // half-written file; the name is per thread because the same model can
+    // be imported by two async loads at once
+    std::ostringstream temporaryPath;
+    temporaryPath << cookedPath << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+
+    {
+        std::ofstream file(temporaryPath.str(), std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Warning: Could not write cooked mesh: " << cookedPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        WriteBlock(file, mesh.positions.data(), mesh.positions.size() * sizeof(float));
+        if (hasNormals) {
+            WriteBlock(file, mesh.normals.data(), mesh.normals.size() * sizeof(float));
+        }
+        if (hasTexCoords) {
+            WriteBlock(file, mesh.texCoords.data(), mesh.texCoords.size() * sizeof(float));
+        }
+        WriteBlock(file, mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int));
+        WriteBlock(file, mesh.lodIndices.data(), mesh.lodIndices.size() * sizeof(unsigned int));
+        WriteBlock(file, lods.data(), lods.size() * sizeof(LodRecord));
+        WriteBlock(file, submeshes.data(), submeshes.size() * sizeof(SubmeshRecord));
+        WriteBlock(file, libraries.data(), libraries.size() * sizeof(uint32_t));
+        WriteBlock(file, strings.data(), strings.size());
+        if (!file.good()) {
+            std::cerr << "Warning: Failed writing cooked mesh: " << cookedPath << std::endl;
+            file.close();
+            std::remove(temporaryPath.str().c_str());
+            return false;
+        }
+    }
+
+    // rename does not replace an existing file on Windows
+    std::remove(cookedPath.c_str());
+    if (std::rename(temporaryPath.str().c_str(), cookedPath.c_str()) != 0) {
+        std::remove(temporaryPath.str().c_str());
+        std::cerr << "Warning: Could not write cooked mesh: " << cookedPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string MeshCache::GetCookedPath(const std::string& sourcePath) {
+    return sourcePath + ".savmesh";
+}
+
+uint64_t MeshCache::Hash(const void* data, size_t size, uint64_t seed) {
+    // Eight bytes per step; fast enough to hash a large OBJ in a fraction
+    // of the time it takes to parse it
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed ^ (static_cast<uint64_t>(size) * multiplier);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        word *= 0xC2B2AE3D27D4EB4FULL;
+        word ^= word >> 31;
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 29;
+    }
+    uint64_t tail = 0;
+    for (size_t shift = 0; i < size; ++i, shift += 8) {
+        tail |= static_cast<uint64_t>(bytes[i]) << shift;
+    }
+    hash = (hash ^ (tail * 0xC2B2AE3D27D4EB4FULL)) * multiplier;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t MeshCache::GetSettingsHash() {
+    uint32_t settings[2] = { IMPORT_VERSION, VERSION };
+    return Hash(settings, sizeof(settings));
+}
+
+void MeshCache::SetEnabled(bool enabled) {
+    cacheEnabled = enabled;
+}
+
+bool MeshCache::IsEnabled() {
+    return cacheEnabled;
+}
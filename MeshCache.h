@@ -0,0 +1,108 @@
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "ObjLoader.h"
+
+// Cooked mesh file (.savmesh), written next to an OBJ the first time it is
+// imported ("crate.obj" -> "crate.obj.savmesh") and loaded instead of the
+// OBJ from then on.
+//
+// Layout (little-endian, every block 8-byte aligned):
+//     Header
+//     float[3 * vertexCount]       positions
+//     float[3 * vertexCount]       normals (HAS_NORMALS)
+//     float[2 * vertexCount]       uvs (HAS_TEX_COORDS)
+//     uint32_t[indexCount]         indices
+//     uint32_t[lodIndexCount]      level of detail indices
+//     LodRecord[lodCount]
+//     SubmeshRecord[submeshCount]
+//     uint32_t[libraryCount]       mtllib names (string offsets)
+//     char[stringsSize]            null-terminated strings
+//
+// Each attribute is stored as its own stream, the way Model keeps and
+// uploads them, so loading is one mapping and a copy per stream.
+//
+// A cooked file is used when the source's size and modification time are
+// unchanged, or failing that when a hash of the source's contents still
+// matches; otherwise the OBJ is imported again and the file rewritten.
+// Imports are run through MeshOptimizer, so cooked meshes are already in
+// vertex cache order, and MeshSimplifier, so they carry their levels of
+// detail.
+// Shipped builds can leave the OBJ out and keep only the .savmesh.
+class MeshCache {
+public:
+    static const uint32_t MAGIC = 0x4D564153;    // "SAVM"
+    static const uint32_t VERSION = 2;
+
+    // Bump when the importer's output changes so old files are recooked
+    static const uint32_t IMPORT_VERSION = 3;
+
+    // Header::flags
+    enum MeshFlags : uint32_t {
+        HAS_NORMALS = 1u << 0,
+        HAS_TEX_COORDS = 1u << 1
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t contentHash;     // Hash of the source file
+        uint64_t settingsHash;    // GetSettingsHash() when cooked
+        uint64_t sourceSize;
+        int64_t sourceTime;       // source modification time (nanoseconds)
+        uint32_t vertexCount;
+        uint32_t indexCount;
+        uint32_t submeshCount;
+        uint32_t libraryCount;
+        uint32_t flags;
+        uint32_t stringsSize;
+        uint32_t lodCount;
+        uint32_t lodIndexCount;
+        float boundsMin[3];
+        float boundsMax[3];
+    };
+
+    struct SubmeshRecord {
+        uint32_t material;        // string
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        uint32_t reserved;
+    };
+
+    struct LodRecord {
+        uint32_t firstIndex;      // into the level of detail indices
+        uint32_t indexCount;
+        float error;
+        uint32_t reserved;
+    };
+
+    // Load an OBJ through its cooked file, importing and cooking it when
+    // the cooked file is missing or out of date. fromCache, if given, is
+    // set to whether the cooked file was used.
+    static bool Load(const std::string& sourcePath, ObjMeshData& mesh, bool* fromCache = nullptr);
+
+    // Import an OBJ and write its cooked file
+    static bool Cook(const std::string& sourcePath);
+
+    // Read and write cooked files directly
+    static bool Read(const std::string& cookedPath, ObjMeshData& mesh);
+    static bool Write(const std::string& cookedPath, const ObjMeshData& mesh, const Header& source);
+
+    // "<source>.savmesh"
+    static std::string GetCookedPath(const std::string& sourcePath);
+
+    // 64-bit hash of a block of memory
+    static uint64_t Hash(const void* data, size_t size, uint64_t seed = 0);
+
+    // Key for the import settings the cooked data depends on
+    static uint64_t GetSettingsHash();
+
+    // With the cache disabled Load always imports the OBJ and writes nothing
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+};
+
+#endif // MESH_CACHE_H
@@ -0,0 +1,466 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Entries of the cache Forsyth's scores model, and of the FIFO cache used to
+// measure cluster costs; both are typical of current hardware
+static const size_t SCORE_CACHE_SIZE = 32;
+static const unsigned int FIFO_CACHE_SIZE = 16;
+
+// Triangles a vertex may still be used by before the valence boost stops
+// growing
+static const unsigned int MAX_VALENCE_SCORE = 32;
+
+// Forsyth's vertex scores: recently used vertices score high (the last
+// triangle's a bit less, to avoid strips that double back), and vertices
+// with few triangles left score high so they are finished off and leave
+static struct VertexScoreTable {
+    float cache[SCORE_CACHE_SIZE];
+    float valence[MAX_VALENCE_SCORE + 1];
+
+    VertexScoreTable() {
+        for (size_t i = 0; i < SCORE_CACHE_SIZE; ++i) {
+            cache[i] = i < 3 ? 0.75f
+                             : std::pow(1.0f - static_cast<float>(i - 3) / (SCORE_CACHE_SIZE - 3), 1.5f);
+        }
+        valence[0] = 0.0f;
+        for (unsigned int i = 1; i <= MAX_VALENCE_SCORE; ++i) {
+            valence[i] = 2.0f / std::sqrt(static_cast<float>(i));
+        }
+    }
+} scoreTable;
+
+static float GetVertexScore(int cachePosition, unsigned int remaining) {
+    if (remaining == 0) {
+        return -1.0f;
+    }
+    float score = cachePosition >= 0 ? scoreTable.cache[cachePosition] : 0.0f;
+    return score + scoreTable.valence[std::min(remaining, MAX_VALENCE_SCORE)];
+}
+
+// Misses of one triangle in a FIFO cache kept as per-vertex timestamps
+static unsigned int SimulateTriangle(const unsigned int* triangle, std::vector<unsigned int>& stamps,
+                                     unsigned int& time) {
+    unsigned int misses = 0;
+    for (int corner = 0; corner < 3; ++corner) {
+        unsigned int vertex = triangle[corner];
+        if (time - stamps[vertex] > FIFO_CACHE_SIZE) {
+            stamps[vertex] = time++;
+            ++misses;
+        }
+    }
+    return misses;
+}
+
+// Index range [first, end) of a call; false if it holds under two triangles
+static bool GetRange(const std::vector<unsigned int>& indices, size_t first, size_t count, size_t& end) {
+    end = count == 0 ? indices.size() : std::min(indices.size(), first + count);
+    if (first >= end) {
+        return false;
+    }
+    end = first + (end - first) / 3 * 3;
+    return end - first >= 6;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount,
+                                        size_t first, size_t count) {
+    size_t end = 0;
+    if (!GetRange(indices, first, count, end)) {
+        return;
+    }
+    const std::vector<unsigned int> source(indices.begin() + first, indices.begin() + end);
+    const size_t triangleCount = source.size() / 3;
+
+    // Triangles of each vertex; the first remaining[v] are not emitted yet
+    std::vector<unsigned int> remaining(vertexCount, 0);
+    for (unsigned int vertex : source) {
+        ++remaining[vertex];
+    }
+    std::vector<size_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + remaining[v];
+    }
+    std::vector<unsigned int> adjacency(source.size());
+    {
+        std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < source.size(); ++i) {
+            adjacency[fill[source[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount, 0.0f);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScores[v] = GetVertexScore(-1, remaining[v]);
+    }
+    size_t best = 0;
+    float bestScore = -1.0f;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        float score = vertexScores[source[t * 3]] + vertexScores[source[t * 3 + 1]] + vertexScores[source[t * 3 + 2]];
+        if (score > bestScore) {
+            bestScore = score;
+            best = t;
+        }
+    }
+
+    std::vector<char> emitted(triangleCount, 0);
+    std::vector<unsigned int> cache;
+    std::vector<unsigned int> nextCache;
+    cache.reserve(SCORE_CACHE_SIZE + 3);
+    nextCache.reserve(SCORE_CACHE_SIZE + 3);
+    size_t output = first;
+    size_t scan = 0;
+
+    while (output < end) {
+        if (best == triangleCount) {
+            // Dead end: nothing in the cache has triangles left
+            while (emitted[scan]) {
+                ++scan;
+            }
+            best = scan;
+        }
+
+        const unsigned int* triangle = &source[best * 3];
+        emitted[best] = 1;
+        nextCache.assign(triangle, triangle + 3);
+        for (int corner = 0; corner < 3; ++corner) {
+            unsigned int vertex = triangle[corner];
+            indices[output++] = vertex;
+
+            // Drop the triangle from the vertex's remaining ones
+            unsigned int* live = &adjacency[offsets[vertex]];
+            for (unsigned int i = 0; i < remaining[vertex]; ++i) {
+                if (live[i] == best) {
+                    live[i] = live[remaining[vertex] - 1];
+                    --remaining[vertex];
+                    break;
+                }
+            }
+        }
+
+        // Emitted vertices move to the front; the cache keeps its size, and
+        // what falls out is rescored as uncached
+        for (unsigned int vertex : cache) {
+            if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2]) {
+                nextCache.push_back(vertex);
+            }
+        }
+        for (size_t i = 0; i < nextCache.size(); ++i) {
+            unsigned int vertex = nextCache[i];
+            cachePosition[vertex] = i < SCORE_CACHE_SIZE ? static_cast<int>(i) : -1;
+            vertexScores[vertex] = GetVertexScore(cachePosition[vertex], remaining[vertex]);
+        }
+
+        // Only triangles touching the cache changed score; the best of them
+        // goes next
+        best = triangleCount;
+        bestScore = -1.0f;
+        for (unsigned int vertex : nextCache) {
+            const unsigned int* live = &adjacency[offsets[vertex]];
+            for (unsigned int i = 0; i < remaining[vertex]; ++i) {
+                unsigned int t = live[i];
+                float score = vertexScores[source[t * 3]] + vertexScores[source[t * 3 + 1]] +
+                              vertexScores[source[t * 3 + 2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+
+        if (nextCache.size() > SCORE_CACHE_SIZE) {
+            nextCache.resize(SCORE_CACHE_SIZE);
+        }
+        cache.swap(nextCache);
+    }
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<float>& positions,
+                                     size_t first, size_t count, float threshold) {
+    size_t end = 0;
+    if (!GetRange(indices, first, count, end)) {
+        return;
+    }
+    const std::vector<unsigned int> source(indices.begin() + first, indices.begin() + end);
+    const size_t triangleCount = source.size() / 3;
+    const size_t vertexCount = positions.size() / 3;
+
+    // Hard boundaries: triangles that miss on every corner start over anyway
+    std::vector<size_t> hard;
+    {
+        std::vector<unsigned int> stamps(vertexCount, 0);
+        unsigned int time = FIFO_CACHE_SIZE + 1;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            if (SimulateTriangle(&source[t * 3], stamps, time) == 3 || t == 0) {
+                hard.push_back(t);
+            }
+        }
+    }
+    hard.push_back(triangleCount);
+
+    // Soft boundaries: split further wherever a cluster restarting the cache
+    // has already earned back the misses of the restart
+    std::vector<size_t> clusters;
+    std::vector<unsigned int> stamps(vertexCount, 0);
+    unsigned int time = FIFO_CACHE_SIZE + 1;
+    for (size_t h = 0; h + 1 < hard.size(); ++h) {
+        size_t start = hard[h];
+        size_t stop = hard[h + 1];
+
+        time += FIFO_CACHE_SIZE + 1;
+        unsigned int clusterMisses = 0;
+        for (size_t t = start; t < stop; ++t) {
+            clusterMisses += SimulateTriangle(&source[t * 3], stamps, time);
+        }
+        float limit = threshold * clusterMisses / (stop - start);
+
+        time += FIFO_CACHE_SIZE + 1;
+        clusters.push_back(start);
+        unsigned int misses = 0;
+        size_t begin = start;
+        for (size_t t = start; t < stop; ++t) {
+            misses += SimulateTriangle(&source[t * 3], stamps, time);
+            if (t + 1 < stop && static_cast<float>(misses) / (t + 1 - begin) <= limit) {
+                clusters.push_back(t + 1);
+                time += FIFO_CACHE_SIZE + 1;
+                misses = 0;
+                begin = t + 1;
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+    if (clusters.size() <= 2) {
+        return;
+    }
+
+    // Area-weighted centroid and normal of each cluster, and of the mesh
+    size_t clusterCount = clusters.size() - 1;
+    std::vector<Vector3> centroids(clusterCount);
+    std::vector<Vector3> clusterNormals(clusterCount);
+    Vector3 meshCentroid(0.0f, 0.0f, 0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusterCount; ++c) {
+        Vector3 centroid(0.0f, 0.0f, 0.0f);
+        Vector3 normal(0.0f, 0.0f, 0.0f);
+        float area = 0.0f;
+        for (size_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+            const float* a = &positions[source[t * 3] * 3];
+            const float* b = &positions[source[t * 3 + 1] * 3];
+            const float* p = &positions[source[t * 3 + 2] * 3];
+            Vector3 ab(b[0] - a[0], b[1] - a[1], b[2] - a[2]);
+            Vector3 ac(p[0] - a[0], p[1] - a[1], p[2] - a[2]);
+            Vector3 cross = ab.cross(ac);
+            float weight = cross.magnitude();
+            Vector3 center((a[0] + b[0] + p[0]) / 3.0f, (a[1] + b[1] + p[1]) / 3.0f, (a[2] + b[2] + p[2]) / 3.0f);
+            centroid = centroid + center * weight;
+            normal = normal + cross;
+            area += weight;
+        }
+        meshCentroid = meshCentroid + centroid;
+        meshArea += area;
+        centroids[c] = area > 0.0f ? centroid * (1.0f / area) : centroid;
+        clusterNormals[c] = normal;
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid = meshCentroid * (1.0f / meshArea);
+    }
+
+    // Clusters far out and facing away from the center are drawn first:
+    // they are the ones that cover the rest
+    std::vector<float> keys(clusterCount, 0.0f);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        float length = clusterNormals[c].magnitude();
+        if (length > 0.0f) {
+            keys[c] = (centroids[c] - meshCentroid).dot(clusterNormals[c] * (1.0f / length));
+        }
+    }
+    std::vector<size_t> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        order[c] = c;
+    }
+    std::stable_sort(order.begin(), order.end(), [&keys](size_t a, size_t b) { return keys[a] > keys[b]; });
+
+    size_t output = first;
+    for (size_t c : order) {
+        for (size_t i = clusters[c] * 3; i < clusters[c + 1] * 3; ++i) {
+            indices[output++] = source[i];
+        }
+    }
+}
+
+void MeshOptimizer::OptimizeVertexFetch(ObjMeshData& mesh) {
+    const size_t vertexCount = mesh.GetVertexCount();
+    const unsigned int unused = ~0u;
+    std::vector<unsigned int> remap(vertexCount, unused);
+    unsigned int next = 0;
+    for (unsigned int& vertex : mesh.indices) {
+        if (remap[vertex] == unused) {
+            remap[vertex] = next++;
+        }
+        vertex = remap[vertex];
+    }
+    for (unsigned int& target : remap) {
+        if (target == unused) {
+            target = next++;
+        }
+    }
+
+    // Move every attribute stream the same way
+    auto permute = [&remap, vertexCount](std::vector<float>& stream) {
+        if (stream.empty()) {
+            return;
+        }
+        size_t stride = stream.size() / vertexCount;
+        std::vector<float> moved(stream.size());
+        for (size_t v = 0; v < vertexCount; ++v) {
+            std::copy(stream.begin() + v * stride, stream.begin() + (v + 1) * stride,
+                      moved.begin() + remap[v] * stride);
+        }
+        stream.swap(moved);
+    };
+    for (unsigned int& vertex : mesh.lodIndices) {
+        vertex = remap[vertex];
+    }
+    permute(mesh.positions);
+    permute(mesh.normals);
+    permute(mesh.texCoords);
+}
+
+void MeshOptimizer::Optimize(ObjMeshData& mesh) {
+    const size_t vertexCount = mesh.GetVertexCount();
+    if (vertexCount == 0 || mesh.indices.empty()) {
+        return;
+    }
+
+    if (mesh.submeshes.empty()) {
+        OptimizeVertexCache(mesh.indices, vertexCount);
+        OptimizeOverdraw(mesh.indices, mesh.positions);
+    } else {
+        for (const ObjSubmesh& submesh : mesh.submeshes) {
+            if (submesh.indexCount == 0) {
+                continue;
+            }
+            OptimizeVertexCache(mesh.indices, vertexCount, submesh.firstIndex, submesh.indexCount);
+            OptimizeOverdraw(mesh.indices, mesh.positions, submesh.firstIndex, submesh.indexCount);
+        }
+    }
+    OptimizeVertexFetch(mesh);
+}
+
+float MeshOptimizer::GetACMR(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize) {
+    if (indices.size() < 3) {
+        return 0.0f;
+    }
+    std::vector<unsigned int> stamps(vertexCount, 0);
+    unsigned int time = cacheSize + 1;
+    size_t misses = 0;
+    for (unsigned int vertex : indices) {
+        if (time - stamps[vertex] > cacheSize) {
+            stamps[vertex] = time++;
+            ++misses;
+        }
+    }
+    return static_cast<float>(misses) / (indices.size() / 3);
+}
+
+MeshOptimizer::TexCoordFormat MeshOptimizer::GetTexCoordFormat(const std::vector<float>& texCoords) {
+    TexCoordFormat format = TEXCOORDS_UNORM16;
+    for (float coordinate : texCoords) {
+        if (!(coordinate >= -2.0f && coordinate <= 2.0f)) {
+            return TEXCOORDS_FLOAT;
+        }
+        if (coordinate < 0.0f || coordinate > 1.0f) {
+            format = TEXCOORDS_HALF;
+        }
+    }
+    return format;
+}
+
+void MeshOptimizer::QuantizeNormals(const std::vector<float>& normals, std::vector<int16_t>& packed) {
+    size_t vertexCount = normals.size() / 3;
+    packed.assign(vertexCount * 4, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        for (int axis = 0; axis < 3; ++axis) {
+            float value = std::max(-1.0f, std::min(1.0f, normals[v * 3 + axis]));
+            packed[v * 4 + axis] = static_cast<int16_t>(std::lround(value * 32767.0f));
+        }
+    }
+}
+
+void MeshOptimizer::QuantizeTexCoords(const std::vector<float>& texCoords, TexCoordFormat format,
+                                      std::vector<uint16_t>& packed) {
+    packed.resize(texCoords.size());
+    for (size_t i = 0; i < texCoords.size(); ++i) {
+        if (format == TEXCOORDS_UNORM16) {
+            float value = std::max(0.0f, std::min(1.0f, texCoords[i]));
+            packed[i] = static_cast<uint16_t>(std::lround(value * 65535.0f));
+        } else {
+            packed[i] = FloatToHalf(texCoords[i]);
+        }
+    }
+}
+
+size_t MeshOptimizer::GetUploadSize(const std::vector<float>& positions, const std::vector<float>& normals,
+                                    const std::vector<float>& texCoords, const std::vector<unsigned int>& indices) {
+    size_t texCoordSize = GetTexCoordFormat(texCoords) == TEXCOORDS_FLOAT ? sizeof(float) : sizeof(uint16_t);
+    size_t indexSize = CanUseShortIndices(positions.size() / 3) ? sizeof(uint16_t) : sizeof(unsigned int);
+    return positions.size() * sizeof(float) + normals.size() / 3 * 4 * sizeof(int16_t) +
+           texCoords.size() * texCoordSize + indices.size() * indexSize;
+}
+
+uint16_t MeshOptimizer::FloatToHalf(float value) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    uint32_t rawExponent = (bits >> 23) & 0xFF;
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (rawExponent == 0xFF) {
+        return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+    }
+    int exponent = static_cast<int>(rawExponent) - 127 + 15;
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00);
+    }
+
+    // Round to nearest, ties to even; a carry out of the mantissa correctly
+    // bumps the exponent
+    if (exponent <= 0) {
+        if (exponent < -10) {
+            return sign;
+        }
+        mantissa |= 0x800000;
+        int shift = 14 - exponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1))) {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+    uint32_t half = (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1FFF;
+    if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) {
+        ++half;
+    }
+    return static_cast<uint16_t>(sign | half);
+}
+
+float MeshOptimizer::HalfToFloat(uint16_t value) {
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1F;
+    uint32_t mantissa = value & 0x3FF;
+
+    if (exponent == 0) {
+        float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+    uint32_t bits = exponent == 31 ? (sign | 0x7F800000 | (mantissa << 13))
+                                   : (sign | ((exponent - 15 + 127) << 23) | (mantissa << 13));
+    float result = 0.0f;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
@@ -0,0 +1,75 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "ObjLoader.h"
+
+// Import-time mesh optimizations and the compact vertex formats meshes are
+// uploaded in.
+//
+// Optimize() reorders a mesh without changing what it draws:
+//   1. triangles for the post-transform vertex cache (Forsyth's algorithm),
+//   2. clusters of those triangles so outward-facing ones draw first and
+//      hide what is behind them (less overdraw), within a small cache cost,
+//   3. vertices in the order the triangles first use them, so vertex fetch
+//      walks the buffers forward.
+// Each submesh is reordered within its own index range.
+//
+// On upload, normals become snorm16 and texture coordinates unorm16 (or
+// half floats when they tile a little), and meshes of up to 65536 vertices
+// get 16-bit indices. Shaders read all of these as the same float vectors.
+class MeshOptimizer {
+public:
+    // Reorder the triangles of indices[first, first + count) for a vertex
+    // cache; count 0 means to the end
+    static void OptimizeVertexCache(std::vector<unsigned int>& indices, size_t vertexCount,
+                                    size_t first = 0, size_t count = 0);
+
+    // Reorder clusters of cache-ordered triangles front to back, as seen
+    // from outside. threshold bounds the cache misses the extra cluster
+    // boundaries may cost (1.05 allows 5% more).
+    static void OptimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<float>& positions,
+                                 size_t first = 0, size_t count = 0, float threshold = 1.05f);
+
+    // Renumber vertices in order of first use; unused vertices go last
+    static void OptimizeVertexFetch(ObjMeshData& mesh);
+
+    // Run every pass over each submesh
+    static void Optimize(ObjMeshData& mesh);
+
+    // Average cache miss ratio: vertices transformed per triangle with a
+    // FIFO cache of cacheSize entries. 0.5 is ideal for regular grids, 3 the
+    // worst case.
+    static float GetACMR(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize = 16);
+
+    // Vertex formats on the GPU
+    enum TexCoordFormat {
+        TEXCOORDS_UNORM16,  // all coordinates in [0, 1]
+        TEXCOORDS_HALF,     // within [-2, 2], where half floats keep 1/1024 precision
+        TEXCOORDS_FLOAT     // tiling further than that
+    };
+
+    static TexCoordFormat GetTexCoordFormat(const std::vector<float>& texCoords);
+
+    // xyz normals as snorm16 xyzw, w zero, so each vertex is 8 bytes
+    static void QuantizeNormals(const std::vector<float>& normals, std::vector<int16_t>& packed);
+
+    // uv pairs as unorm16 or half floats, as GetTexCoordFormat chose
+    static void QuantizeTexCoords(const std::vector<float>& texCoords, TexCoordFormat format,
+                                  std::vector<uint16_t>& packed);
+
+    // Whether indices fit in 16 bits
+    static bool CanUseShortIndices(size_t vertexCount) { return vertexCount <= 65536; }
+
+    // Bytes a mesh takes on the GPU in these formats
+    static size_t GetUploadSize(const std::vector<float>& positions, const std::vector<float>& normals,
+                                const std::vector<float>& texCoords, const std::vector<unsigned int>& indices);
+
+    // IEEE half float conversions, rounding to nearest
+    static uint16_t FloatToHalf(float value);
+    static float HalfToFloat(uint16_t value);
+};
+
+#endif // MESH_OPTIMIZER_H
@@ -0,0 +1,366 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+    // Sum of squared plane equations as a symmetric 4x4 matrix, and the
+    // triangle area they were weighted by
+    struct Quadric {
+        double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+        double a11 = 0, a12 = 0, a13 = 0;
+        double a22 = 0, a23 = 0;
+        double a33 = 0;
+        double weight = 0;
+
+        void AddPlane(double a, double b, double c, double d, double w) {
+            a00 += w * a * a; a01 += w * a * b; a02 += w * a * c; a03 += w * a * d;
+            a11 += w * b * b; a12 += w * b * c; a13 += w * b * d;
+            a22 += w * c * c; a23 += w * c * d;
+            a33 += w * d * d;
+            weight += w;
+        }
+
+        void Add(const Quadric& other) {
+            a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+            a11 += other.a11; a12 += other.a12; a13 += other.a13;
+            a22 += other.a22; a23 += other.a23;
+            a33 += other.a33;
+            weight += other.weight;
+        }
+
+        // Weighted sum of squared distances from the planes
+        double Evaluate(double x, double y, double z) const {
+            return x * x * a00 + y * y * a11 + z * z * a22 + 2 * (x * y * a01 + x * z * a02 + y * z * a12) +
+                   2 * (x * a03 + y * a13 + z * a23) + a33;
+        }
+    };
+
+    struct Collapse {
+        unsigned int from;
+        unsigned int to;
+        double cost;    // mean squared distance
+    };
+
+    void Cross(const float* a, const float* b, const float* c, double* normal) {
+        double e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        double e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+        normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+        normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+    }
+
+    // Lock vertices that may not move: those sharing a position with
+    // another vertex (uv or normal seams) and those on open or
+    // non-manifold edges
+    std::vector<char> FindLockedVertices(const std::vector<unsigned int>& indices, const std::vector<float>& positions) {
+        const size_t vertexCount = positions.size() / 3;
+
+        // Vertices of the same position share a group; sorting keeps this
+        // cheap for meshes of a million triangles
+        std::vector<char> used(vertexCount, 0);
+        for (unsigned int vertex : indices) {
+            used[vertex] = 1;
+        }
+        std::vector<unsigned int> order;
+        for (size_t v = 0; v < vertexCount; ++v) {
+            if (used[v]) {
+                order.push_back(static_cast<unsigned int>(v));
+            }
+        }
+        auto less = [&positions](unsigned int a, unsigned int b) {
+            return std::lexicographical_compare(&positions[a * 3], &positions[a * 3 + 3], &positions[b * 3],
+                                                &positions[b * 3 + 3]);
+        };
+        std::sort(order.begin(), order.end(), less);
+
+        std::vector<char> locked(vertexCount, 0);
+        std::vector<unsigned int> group(vertexCount, 0);
+        unsigned int groups = 0;
+        for (size_t i = 0; i < order.size();) {
+            size_t end = i + 1;
+            while (end < order.size() && !less(order[i], order[end])) {
+                ++end;
+            }
+            for (size_t j = i; j < end; ++j) {
+                group[order[j]] = groups;
+                locked[order[j]] = end - i > 1;
+            }
+            ++groups;
+            i = end;
+        }
+
+        // Edges between groups, so that seams do not count as borders; an
+        // edge not shared by exactly two triangles locks its groups
+        std::vector<uint64_t> edges;
+        edges.reserve(indices.size());
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            for (int corner = 0; corner < 3; ++corner) {
+                uint64_t a = group[indices[i + corner]];
+                uint64_t b = group[indices[i + (corner + 1) % 3]];
+                edges.push_back(std::min(a, b) << 32 | std::max(a, b));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        std::vector<char> lockedGroup(groups, 0);
+        for (size_t i = 0; i < edges.size();) {
+            size_t end = i + 1;
+            while (end < edges.size() && edges[end] == edges[i]) {
+                ++end;
+            }
+            if (end - i != 2) {
+                lockedGroup[edges[i] >> 32] = 1;
+                lockedGroup[edges[i] & 0xFFFFFFFFu] = 1;
+            }
+            i = end;
+        }
+        for (unsigned int vertex : order) {
+            locked[vertex] = locked[vertex] || lockedGroup[group[vertex]];
+        }
+        return locked;
+    }
+
+    // Corners of a triangle after this pass's collapses so far; false if
+    // the triangle has lost an edge
+    bool GetCorners(const std::vector<unsigned int>& indices, const std::vector<unsigned int>& target,
+                    unsigned int triangle, unsigned int* corners) {
+        for (int corner = 0; corner < 3; ++corner) {
+            corners[corner] = target[indices[triangle * 3 + corner]];
+        }
+        return corners[0] != corners[1] && corners[1] != corners[2] && corners[0] != corners[2];
+    }
+
+    // Whether moving from onto to turns over, or nearly flattens, any
+    // triangle around from that survives the collapse
+    bool FlipsTriangles(const std::vector<unsigned int>& indices, const std::vector<float>& positions,
+                        const std::vector<unsigned int>& offsets, const std::vector<unsigned int>& triangles,
+                        const std::vector<unsigned int>& target, unsigned int from, unsigned int to) {
+        for (unsigned int t = offsets[from]; t < offsets[from + 1]; ++t) {
+            unsigned int corners[3];
+            if (!GetCorners(indices, target, triangles[t], corners) || corners[0] == to || corners[1] == to ||
+                corners[2] == to) {
+                continue;
+            }
+            const float* before[3];
+            const float* after[3];
+            for (int corner = 0; corner < 3; ++corner) {
+                before[corner] = &positions[corners[corner] * 3];
+                after[corner] = corners[corner] == from ? &positions[to * 3] : before[corner];
+            }
+            double n0[3];
+            double n1[3];
+            Cross(before[0], before[1], before[2], n0);
+            Cross(after[0], after[1], after[2], n1);
+            double dot = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+            double lengths = std::sqrt((n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2]) *
+                                       (n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2]));
+            if (dot <= 0.25 * lengths) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+size_t MeshSimplifier::Simplify(const std::vector<unsigned int>& indices, const std::vector<float>& positions,
+                                size_t targetIndexCount, float maxError, std::vector<unsigned int>& result,
+                                float* error) {
+    const size_t vertexCount = positions.size() / 3;
+    result = indices;
+    if (error) {
+        *error = 0.0f;
+    }
+    if (indices.size() <= targetIndexCount || vertexCount == 0) {
+        return result.size();
+    }
+
+    // Each vertex starts with the planes of the triangles around it
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const float* p0 = &positions[indices[i] * 3];
+        double normal[3];
+        Cross(p0, &positions[indices[i + 1] * 3], &positions[indices[i + 2] * 3], normal);
+        double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (length == 0.0) {
+            continue;
+        }
+        double a = normal[0] / length;
+        double b = normal[1] / length;
+        double c = normal[2] / length;
+        double d = -(a * p0[0] + b * p0[1] + c * p0[2]);
+        for (int corner = 0; corner < 3; ++corner) {
+            quadrics[indices[i + corner]].AddPlane(a, b, c, d, length * 0.5);
+        }
+    }
+
+    std::vector<char> locked = FindLockedVertices(indices, positions);
+    const double maxCost = static_cast<double>(maxError) * maxError;
+    double worst = 0.0;
+
+    std::vector<unsigned int> offsets(vertexCount + 1);
+    std::vector<unsigned int> triangles;
+    std::vector<Collapse> collapses;
+    std::vector<char> touched(vertexCount);
+    std::vector<unsigned int> target(vertexCount);
+
+    // Each pass collapses the cheapest edges that do not touch each other
+    while (result.size() > targetIndexCount) {
+        const size_t triangleCount = result.size() / 3;
+
+        // Triangles around each vertex
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (unsigned int vertex : result) {
+            ++offsets[vertex + 1];
+        }
+        for (size_t v = 0; v < vertexCount; ++v) {
+            offsets[v + 1] += offsets[v];
+        }
+        triangles.resize(result.size());
+        std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < result.size(); ++i) {
+            triangles[fill[result[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+
+        // Each edge once, from the triangle that has it in increasing
+        // order, collapsed in its cheaper direction. Edges with the other
+        // order only are borders, whose vertices are locked anyway.
+        collapses.clear();
+        for (size_t i = 0; i < result.size(); i += 3) {
+            for (int corner = 0; corner < 3; ++corner) {
+                unsigned int a = result[i + corner];
+                unsigned int b = result[i + (corner + 1) % 3];
+                if (a > b || (locked[a] && locked[b])) {
+                    continue;
+                }
+                Quadric sum = quadrics[a];
+                sum.Add(quadrics[b]);
+                Collapse collapse = { 0, 0, 0.0 };
+                bool found = false;
+                for (int direction = 0; direction < 2; ++direction) {
+                    unsigned int from = direction == 0 ? a : b;
+                    unsigned int to = direction == 0 ? b : a;
+                    if (locked[from]) {
+                        continue;
+                    }
+                    const float* p = &positions[to * 3];
+                    double cost = sum.weight > 0.0 ? std::max(0.0, sum.Evaluate(p[0], p[1], p[2])) / sum.weight : 0.0;
+                    if (!found || cost < collapse.cost) {
+                        collapse.from = from;
+                        collapse.to = to;
+                        collapse.cost = cost;
+                        found = true;
+                    }
+                }
+                if (found && collapse.cost <= maxCost) {
+                    collapses.push_back(collapse);
+                }
+            }
+        }
+        std::sort(collapses.begin(), collapses.end(),
+                  [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+        std::fill(touched.begin(), touched.end(), 0);
+        for (size_t v = 0; v < vertexCount; ++v) {
+            target[v] = static_cast<unsigned int>(v);
+        }
+        size_t removed = 0;
+        const size_t toRemove = (result.size() - targetIndexCount + 2) / 3;
+        for (const Collapse& collapse : collapses) {
+            if (removed >= toRemove) {
+                break;
+            }
+            // Collapses in one pass share no vertex, so one step of
+            // target always gives a vertex's current replacement
+            if (touched[collapse.from] || touched[collapse.to] ||
+                FlipsTriangles(result, positions, offsets, triangles, target, collapse.from, collapse.to)) {
+                continue;
+            }
+            touched[collapse.from] = 1;
+            touched[collapse.to] = 1;
+
+            for (unsigned int t = offsets[collapse.from]; t < offsets[collapse.from + 1]; ++t) {
+                unsigned int corners[3];
+                if (GetCorners(result, target, triangles[t], corners) &&
+                    (corners[0] == collapse.to || corners[1] == collapse.to || corners[2] == collapse.to)) {
+                    ++removed;
+                }
+            }
+            target[collapse.from] = collapse.to;
+            quadrics[collapse.to].Add(quadrics[collapse.from]);
+            worst = std::max(worst, collapse.cost);
+        }
+        if (removed == 0) {
+            break;
+        }
+
+        // Drop the triangles that lost an edge
+        size_t kept = 0;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            unsigned int a = target[result[t * 3]];
+            unsigned int b = target[result[t * 3 + 1]];
+            unsigned int c = target[result[t * 3 + 2]];
+            if (a == b || b == c || a == c) {
+                continue;
+            }
+            result[kept++] = a;
+            result[kept++] = b;
+            result[kept++] = c;
+        }
+        result.resize(kept);
+    }
+
+    if (error) {
+        *error = static_cast<float>(std::sqrt(worst));
+    }
+    return result.size();
+}
+
+size_t MeshSimplifier::GenerateLods(ObjMeshData& mesh, size_t maxLods, float ratio, float maxError) {
+    mesh.lods.clear();
+    mesh.lodIndices.clear();
+    const size_t vertexCount = mesh.GetVertexCount();
+    if (mesh.GetTriangleCount() < MIN_TRIANGLES || vertexCount == 0) {
+        return 0;
+    }
+
+    // Errors are relative to the size of the mesh
+    float low[3] = { mesh.positions[0], mesh.positions[1], mesh.positions[2] };
+    float high[3] = { low[0], low[1], low[2] };
+    for (size_t i = 0; i < mesh.positions.size(); ++i) {
+        low[i % 3] = std::min(low[i % 3], mesh.positions[i]);
+        high[i % 3] = std::max(high[i % 3], mesh.positions[i]);
+    }
+    float extent = std::sqrt((high[0] - low[0]) * (high[0] - low[0]) + (high[1] - low[1]) * (high[1] - low[1]) +
+                             (high[2] - low[2]) * (high[2] - low[2]));
+    float budget = maxError * extent;
+
+    // Each level is simplified from the one before; its error is at most
+    // the sum of the steps
+    std::vector<unsigned int> previous = mesh.indices;
+    float error = 0.0f;
+    for (size_t level = 0; level < maxLods && error < budget; ++level) {
+        if (previous.size() / 3 < MIN_TRIANGLES) {
+            break;
+        }
+        size_t target = static_cast<size_t>(previous.size() / 3 * ratio) * 3;
+        std::vector<unsigned int> simplified;
+        float step = 0.0f;
+        Simplify(previous, mesh.positions, target, budget - error, simplified, &step);
+        if (simplified.empty() || simplified.size() * 10 > previous.size() * 9) {
+            break;
+        }
+        MeshOptimizer::OptimizeVertexCache(simplified, vertexCount);
+
+        error += step;
+        ObjMeshLod lod;
+        lod.firstIndex = mesh.lodIndices.size();
+        lod.indexCount = simplified.size();
+        lod.error = error;
+        mesh.lods.push_back(lod);
+        mesh.lodIndices.insert(mesh.lodIndices.end(), simplified.begin(), simplified.end());
+        previous.swap(simplified);
+    }
+    return mesh.lods.size();
+}
@@ -0,0 +1,39 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include <cstddef>
+#include <vector>
+#include "ObjLoader.h"
+
+// Levels of detail for imported meshes.
+//
+// Simplify() collapses edges in order of quadric error (Garland and
+// Heckbert): each vertex keeps the sum of the planes of the triangles
+// around it, and moving it costs the squared distance from those planes.
+// Vertices only move onto a neighbour, so every level indexes the
+// original vertex buffer and needs no vertex data of its own. Vertices on
+// open borders and on uv or normal seams stay where they are, which keeps
+// silhouettes and texture mapping intact.
+//
+// GenerateLods() builds a chain of such levels, each from the one before,
+// into the mesh's lodIndices and lods.
+class MeshSimplifier {
+public:
+    // Triangles of indices reduced to at most targetIndexCount indices
+    // without moving the surface more than maxError (mesh units). Writes
+    // the largest error reached to error if given; returns the index count.
+    static size_t Simplify(const std::vector<unsigned int>& indices, const std::vector<float>& positions,
+                           size_t targetIndexCount, float maxError, std::vector<unsigned int>& result,
+                           float* error = nullptr);
+
+    // Build up to maxLods levels, each with about ratio times the
+    // triangles of the last, stopping early once a level saves too little
+    // or would move the surface more than maxError times the size of the
+    // mesh. Replaces any levels the mesh had; returns how many were built.
+    static size_t GenerateLods(ObjMeshData& mesh, size_t maxLods = 3, float ratio = 0.5f, float maxError = 0.05f);
+
+    // Meshes with fewer triangles get no levels
+    static const size_t MIN_TRIANGLES = 64;
+};
+
+#endif // MESH_SIMPLIFIER_H
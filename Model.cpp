@@ -3,6 +3,10 @@
 #include "Graphics/Core/GraphicsAPIFactory.h"
 #include "PointLight.h"
 #include "DirectionalLight.h"
+#include "ObjLoader.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
+#include "Shaders/Core/ShaderUniforms.h"
 
 #include <iostream>
 #include <fstream>
@@ -10,7 +14,10 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
 #include <algorithm>
+#include <cstdio>
+#include <utility>
 
 // Constructor
 Model::Model() : vao(0), vbo(0), ebo(0), tbo(0), nbo(0), size(1, 1, 1) {
@@ -19,19 +26,122 @@ Model::Model() : vao(0), vbo(0), ebo(0), tbo(0), nbo(0), size(1, 1, 1) {
 
 // Destructor
 Model::~Model() {
+    // Nothing may call back into this model once it is gone
+    CancelStreaming();
+    
     // Clean up graphics resources
     CleanupGL();
 }
 
 // Load model from file
 bool Model::LoadFromFile(const std::string& filename) {
+    if (!ParseFromFile(filename)) {
+        return false;
+    }
+    
+    // Initialize graphics buffers
+    InitializeBuffers();
+    return true;
+}
+
+// Load model from file in the background
+bool Model::LoadFromFileAsync(const std::string& filename, float priority) {
+    std::string extension = filename.substr(filename.find_last_of(".") + 1);
+    if (extension != "obj" && extension != "savmesh") {
+        std::cerr << "Unsupported file format: " << extension << std::endl;
+        return false;
+    }
+    
+    CancelStreaming();
+    
+    std::shared_ptr<AssetRequest<MeshAsset>> request =
+        AssetStreamer::GetInstance().LoadAsync<MeshAsset>(filename, priority);
+    streamRequests.push_back(request);
+    
+    // Runs on the main thread during AssetStreamer::Update, with the mesh
+    // buffers already uploaded
+    request->OnComplete([this, filename, priority](AssetRequest<MeshAsset>& done) {
+        if (!done.Succeeded()) {
+            return;
+        }
+        
+        std::vector<float>().swap(vertices);
+        std::vector<float>().swap(normals);
+        std::vector<float>().swap(texCoords);
+        std::vector<unsigned int>().swap(indices);
+        sharedMesh = done.GetHandle();
+        sourcePath = filename;
+        
+        for (const std::string& texture : sharedMesh->texturePaths) {
+            streamTexture(texture, "albedo", priority);
+        }
+        
+        if (buffersInitialized) {
+            InitializeGL();
+        }
+    });
+    return true;
+}
+
+// Change the priority of the loads still in progress
+void Model::SetLoadPriority(float priority) {
+    for (const std::shared_ptr<AssetRequestBase>& request : streamRequests) {
+        if (!request->IsDone()) {
+            request->SetPriority(priority);
+        }
+    }
+}
+
+// Whether any streamed load is still in progress
+bool Model::IsLoading() const {
+    for (const std::shared_ptr<AssetRequestBase>& request : streamRequests) {
+        if (!request->IsDone()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Stream a texture in the background
+void Model::streamTexture(const std::string& path, const std::string& type, float priority) {
+    std::shared_ptr<AssetRequest<Texture>> request = AssetStreamer::GetInstance().LoadAsync<Texture>(path, priority);
+    streamRequests.push_back(request);
+    
+    request->OnComplete([this, type](AssetRequest<Texture>& done) {
+        if (!done.Succeeded()) {
+            return;
+        }
+        
+        if (type == "albedo") {
+            albedoTexture = done.GetHandle();
+        } else if (type == "normal") {
+            normalTexture = done.GetHandle();
+        } else if (type == "opacity") {
+            opacityTexture = done.GetHandle();
+        }
+    });
+}
+
+// Cancel the streamed loads
+void Model::CancelStreaming() {
+    for (const std::shared_ptr<AssetRequestBase>& request : streamRequests) {
+        request->Cancel();
+    }
+    streamRequests.clear();
+}
+
+// Load mesh data from file without creating graphics buffers
+bool Model::ParseFromFile(const std::string& filename) {
     std::cout << "Loading model from file: " << filename << std::endl;
     
     // Check file extension
     std::string extension = filename.substr(filename.find_last_of(".") + 1);
     
-    if (extension == "obj") {
-        loadOBJ(filename);
+    if (extension == "obj" || extension == "savmesh") {
+        if (!parseOBJ(filename)) {
+            return false;
+        }
+        sourcePath = filename;
         return true;
     } else {
         std::cerr << "Unsupported file format: " << extension << std::endl;
@@ -41,379 +151,307 @@ bool Model::LoadFromFile(const std::string& filename) {
 
 // Load OBJ file
 void Model::loadOBJ(std::string path) {
-    std::vector<Vector3> temp_vertices;
-    std::vector<Vector3> temp_normals;
-    std::vector<Vector2> temp_uvs;
-    std::vector<unsigned int> vertexIndices, uvIndices, normalIndices;
-    
-    // Material data
-    std::string mtlFilename;
-    std::map<std::string, Vector3> materials; // material name -> color
-    std::string currentMaterial;
-    
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << path << std::endl;
-        return;
+    if (parseOBJ(path)) {
+        // Initialize graphics buffers
+        InitializeBuffers();
+    }
+}
+
+// Parse OBJ file into the mesh data
+bool Model::parseOBJ(const std::string& path) {
+    // Every model loaded from the same file shares one mesh
+    AssetHandle<MeshAsset> mesh = AssetManager::GetInstance().LoadMesh(path);
+    if (!mesh) {
+        return false;
     }
     
-    std::string line;
-    while (std::getline(file, line)) {
-        // Skip empty lines and comments
-        if (line.empty() || line[0] == '#')
-            continue;
-            
-        std::istringstream iss(line);
-        std::string prefix;
-        iss >> prefix;
-        
-        if (prefix == "v") {
-            // Vertex position
-            Vector3 vertex;
-            iss >> vertex.x >> vertex.y >> vertex.z;
-            temp_vertices.push_back(vertex);
-        } else if (prefix == "vt") {
-            // Texture coordinate
-            Vector2 uv;
-            iss >> uv.x >> uv.y;
-            temp_uvs.push_back(uv);
-        } else if (prefix == "vn") {
-            // Vertex normal
-            Vector3 normal;
-            iss >> normal.x >> normal.y >> normal.z;
-            temp_normals.push_back(normal);
-        } else if (prefix == "f") {
-            // Face - support different formats (v, v/vt, v//vn, v/vt/vn)
-            std::string vertex1, vertex2, vertex3, vertex4;
-            iss >> vertex1 >> vertex2 >> vertex3 >> vertex4;
-            
-            // Parse vertex indices for the first three vertices (triangle)
-            parseVertexIndices(vertex1, vertex2, vertex3, 
-                             vertexIndices, uvIndices, normalIndices, 
-                             temp_vertices.size(), temp_uvs.size(), temp_normals.size());
-            
-            // If we have a fourth vertex, create another triangle (triangulate quad)
-            if (!vertex4.empty()) {
-                parseVertexIndices(vertex1, vertex3, vertex4, 
-                                 vertexIndices, uvIndices, normalIndices, 
-                                 temp_vertices.size(), temp_uvs.size(), temp_normals.size());
-            }
-        } else if (prefix == "mtllib") {
-            // Material library
-            iss >> mtlFilename;
-            loadMTL(mtlFilename, path, materials);
-        } else if (prefix == "usemtl") {
-            // Use material
-            iss >> currentMaterial;
-        }
+    // Drop data from a previous load or a generated shape
+    std::vector<float>().swap(vertices);
+    std::vector<float>().swap(normals);
+    std::vector<float>().swap(texCoords);
+    std::vector<unsigned int>().swap(indices);
+    sharedMesh = mesh;
+    
+    for (const std::string& texture : sharedMesh->texturePaths) {
+        loadTexture(texture, "albedo");
+    }
+    return true;
+}
+
+// Load texture
+void Model::loadTexture(const std::string& path, const std::string& type) {
+    // Textures are graphics objects, so they are created on the main thread
+    // in InitializeBuffers; ParseFromFile may run on a worker
+    if (!buffersInitialized) {
+        pendingTextures.push_back(std::make_pair(path, type));
+        return;
     }
     
-    file.close();
+    AssetHandle<Texture> texture = AssetManager::GetInstance().LoadTexture(path);
+    if (!texture) {
+        return;
+    }
     
-    // Process the data
-    processModelData(temp_vertices, temp_normals, temp_uvs, 
-                   vertexIndices, normalIndices, uvIndices, 
-                   materials, currentMaterial);
+    if (type == "albedo") {
+        albedoTexture = texture;
+    } else if (type == "normal") {
+        normalTexture = texture;
+    } else if (type == "opacity") {
+        opacityTexture = texture;
+    } else {
+        std::cerr << "Unknown texture type: " << type << std::endl;
+    }
+}
+
+// Copy the shared mesh into this model so it can be changed
+void Model::DetachSharedMesh() {
+    if (!sharedMesh) {
+        return;
+    }
     
-    // Initialize graphics buffers
-    InitializeBuffers();
+    vertices = sharedMesh->data.positions;
+    normals = sharedMesh->data.normals;
+    texCoords = sharedMesh->data.texCoords;
+    indices = sharedMesh->data.indices;
+    sharedMesh.Reset();
 }
 
-// Helper method to parse vertex indices from face definitions
-void Model::parseVertexIndices(const std::string& v1, const std::string& v2, const std::string& v3,
-                             std::vector<unsigned int>& vertexIndices, 
-                             std::vector<unsigned int>& uvIndices, 
-                             std::vector<unsigned int>& normalIndices,
-                             size_t vertexCount, size_t uvCount, size_t normalCount) {
-    // Parse each vertex string (v, v/vt, v//vn, or v/vt/vn)
-    parseVertex(v1, vertexIndices, uvIndices, normalIndices, vertexCount, uvCount, normalCount);
-    parseVertex(v2, vertexIndices, uvIndices, normalIndices, vertexCount, uvCount, normalCount);
-    parseVertex(v3, vertexIndices, uvIndices, normalIndices, vertexCount, uvCount, normalCount);
-}
-
-// Helper method to parse a single vertex string
-void Model::parseVertex(const std::string& vertexStr, 
-                      std::vector<unsigned int>& vertexIndices, 
-                      std::vector<unsigned int>& uvIndices, 
-                      std::vector<unsigned int>& normalIndices,
-                      size_t vertexCount, size_t uvCount, size_t normalCount) {
-    // Count slashes to determine format
-    size_t slashCount = std::count(vertexStr.begin(), vertexStr.end(), '/');
-    
-    if (slashCount == 0) {
-        // Format: v
-        int vertexIndex = 0;
-        sscanf(vertexStr.c_str(), "%d", &vertexIndex);
-        
-        // OBJ indices start at 1, convert to 0-based
-        if (vertexIndex > 0) vertexIndex -= 1;
-        else if (vertexIndex < 0) vertexIndex = vertexCount + vertexIndex; // Negative indices
-        
-        vertexIndices.push_back(vertexIndex);
-    } else if (slashCount == 1) {
-        // Format: v/vt
-        int vertexIndex = 0, uvIndex = 0;
-        sscanf(vertexStr.c_str(), "%d/%d", &vertexIndex, &uvIndex);
-        
-        // Convert to 0-based
-        if (vertexIndex > 0) vertexIndex -= 1;
-        else if (vertexIndex < 0) vertexIndex = vertexCount + vertexIndex;
-        
-        if (uvIndex > 0) uvIndex -= 1;
-        else if (uvIndex < 0) uvIndex = uvCount + uvIndex;
-        
-        vertexIndices.push_back(vertexIndex);
-        uvIndices.push_back(uvIndex);
-    } else if (slashCount == 2) {
-        // Check if format is v//vn or v/vt/vn
-        if (vertexStr.find("//") != std::string::npos) {
-            // Format: v//vn
-            int vertexIndex = 0, normalIndex = 0;
-            sscanf(vertexStr.c_str(), "%d//%d", &vertexIndex, &normalIndex);
-            
-            // Convert to 0-based
-            if (vertexIndex > 0) vertexIndex -= 1;
-            else if (vertexIndex < 0) vertexIndex = vertexCount + vertexIndex;
-            
-            if (normalIndex > 0) normalIndex -= 1;
-            else if (normalIndex < 0) normalIndex = normalCount + normalIndex;
-            
-            vertexIndices.push_back(vertexIndex);
-            normalIndices.push_back(normalIndex);
-        } else {
-            // Format: v/vt/vn
-            int vertexIndex = 0, uvIndex = 0, normalIndex = 0;
-            sscanf(vertexStr.c_str(), "%d/%d/%d", &vertexIndex, &uvIndex, &normalIndex);
-            
-            // Convert to 0-based
-            if (vertexIndex > 0) vertexIndex -= 1;
-            else if (vertexIndex < 0) vertexIndex = vertexCount + vertexIndex;
-            
-            if (uvIndex > 0) uvIndex -= 1;
-            else if (uvIndex < 0) uvIndex = uvCount + uvIndex;
-            
-            if (normalIndex > 0) normalIndex -= 1;
-            else if (normalIndex < 0) normalIndex = normalCount + normalIndex;
-            
-            vertexIndices.push_back(vertexIndex);
-            uvIndices.push_back(uvIndex);
-            normalIndices.push_back(normalIndex);
-        }
+// Choose the level of detail to draw
+void Model::SetLod(size_t level, float fade) {
+    lodLevel = std::min(level, GetLodCount() - 1);
+    lodFade = fade;
+}
+
+// Distance from the model's origin to the farthest corner of its bounds
+float Model::GetBoundingRadius() const {
+    if (sharedMesh) {
+        const Vector3& low = sharedMesh->data.boundsMin;
+        const Vector3& high = sharedMesh->data.boundsMax;
+        Vector3 corner(std::max(std::fabs(low.x), std::fabs(high.x)), std::max(std::fabs(low.y), std::fabs(high.y)),
+                       std::max(std::fabs(low.z), std::fabs(high.z)));
+        return corner.magnitude();
     }
+    
+    float radiusSquared = 0.0f;
+    for (size_t i = 0; i + 2 < vertices.size(); i += 3) {
+        radiusSquared = std::max(radiusSquared, vertices[i] * vertices[i] + vertices[i + 1] * vertices[i + 1] +
+                                                    vertices[i + 2] * vertices[i + 2]);
+    }
+    return std::sqrt(radiusSquared);
 }
 
-// Load MTL file
-void Model::loadMTL(const std::string& mtlFilename, const std::string& objPath, 
-                  std::map<std::string, Vector3>& materials) {
-    // Get directory of OBJ file
-    std::string directory = objPath.substr(0, objPath.find_last_of("/\\") + 1);
-    std::string mtlPath = directory + mtlFilename;
+// Loaded meshes keep their bounds; generated ones are measured
+bool Model::GetLocalBounds(Vector3& boundsMin, Vector3& boundsMax) const {
+    if (sharedMesh) {
+        boundsMin = sharedMesh->data.boundsMin;
+        boundsMax = sharedMesh->data.boundsMax;
+        return true;
+    }
+    if (vertices.size() < 3) {
+        return false;
+    }
     
-    std::ifstream file(mtlPath);
-    if (!file.is_open()) {
-        std::cerr << "Warning: Could not open material file " << mtlPath << std::endl;
-        return;
+    boundsMin = Vector3(vertices[0], vertices[1], vertices[2]);
+    boundsMax = boundsMin;
+    for (size_t i = 3; i + 2 < vertices.size(); i += 3) {
+        boundsMin.x = std::min(boundsMin.x, vertices[i]);
+        boundsMin.y = std::min(boundsMin.y, vertices[i + 1]);
+        boundsMin.z = std::min(boundsMin.z, vertices[i + 2]);
+        boundsMax.x = std::max(boundsMax.x, vertices[i]);
+        boundsMax.y = std::max(boundsMax.y, vertices[i + 1]);
+        boundsMax.z = std::max(boundsMax.z, vertices[i + 2]);
+    }
+    return true;
+}
+
+// Move the model onto a region of an atlas page
+bool Model::ApplyAtlas(const AssetHandle<Texture>& page, const AtlasRegion& region) {
+    if (!page || !TextureAtlas::CanRemap(GetTexCoords())) {
+        return false;
     }
     
-    std::string currentMaterial;
-    Vector3 diffuseColor(1.0f, 1.0f, 1.0f); // Default white
+    if (sharedMesh) {
+        // Every model of this mesh moved onto the same region shares one
+        // copy; the settings hold the region so the copy can be reloaded
+        char key[160];
+        std::snprintf(key, sizeof(key), "@%u,%u,%u,%u:%.9g,%.9g,%.9g,%.9g", region.x, region.y, region.width,
+                      region.height, region.u0, region.v0, region.u1, region.v1);
+        std::string settings = "atlas=" + page.GetPath() + key;
+        
+        AssetHandle<MeshAsset> remapped = AssetManager::GetInstance().Find<MeshAsset>(sharedMesh.GetPath(), settings);
+        if (!remapped) {
+            MeshAsset* mesh = new MeshAsset();
+            mesh->data = sharedMesh->data;
+            mesh->materials = sharedMesh->materials;
+            mesh->texturePaths = sharedMesh->texturePaths;
+            TextureAtlas::RemapTexCoords(mesh->data.texCoords, region);
+            remapped = AssetManager::GetInstance().Adopt<MeshAsset>(sharedMesh.GetPath(), settings, mesh);
+        }
+        sharedMesh = remapped;
+    } else {
+        TextureAtlas::RemapTexCoords(texCoords, region);
+    }
     
-    std::string line;
-    while (std::getline(file, line)) {
-        // Skip empty lines and comments
-        if (line.empty() || line[0] == '#')
+    albedoTexture = page;
+    if (buffersInitialized) {
+        InitializeGL();
+    }
+    return true;
+}
+
+// Pack small albedo textures into atlas pages, one set per shader program
+size_t Model::BuildTextureAtlases(const std::vector<Model*>& models, const TextureAtlas::Options& options) {
+    // Textures that tile, or are too large, keep their own texture
+    std::map<ShaderProgram*, std::vector<Model*>> groups;
+    for (Model* model : models) {
+        if (!model || !model->albedoTexture || !TextureAtlas::CanRemap(model->GetTexCoords())) {
+            continue;
+        }
+        const Texture& texture = *model->albedoTexture;
+        if (texture.width <= 0 || texture.height <= 0 ||
+            static_cast<uint32_t>(texture.width) > options.maxImageSize ||
+            static_cast<uint32_t>(texture.height) > options.maxImageSize) {
             continue;
-            
-        std::istringstream iss(line);
-        std::string prefix;
-        iss >> prefix;
-        
-        if (prefix == "newmtl") {
-            // New material
-            iss >> currentMaterial;
-        } else if (prefix == "Kd") {
-            // Diffuse color
-            iss >> diffuseColor.x >> diffuseColor.y >> diffuseColor.z;
-            materials[currentMaterial] = diffuseColor;
-        } else if (prefix == "map_Kd") {
-            // Diffuse texture map
-            std::string texturePath;
-            iss >> texturePath;
-            
-            // Get full path to texture
-            std::string fullTexturePath = directory + texturePath;
-            
-            // Load texture
-            loadTexture(fullTexturePath, "albedo");
         }
+        groups[model->shaderProgram].push_back(model);
     }
     
-    file.close();
-}
-
-// Process model data
-void Model::processModelData(const std::vector<Vector3>& temp_vertices,
-                           const std::vector<Vector3>& temp_normals,
-                           const std::vector<Vector2>& temp_uvs,
-                           const std::vector<unsigned int>& vertexIndices,
-                           const std::vector<unsigned int>& normalIndices,
-                           const std::vector<unsigned int>& uvIndices,
-                           const std::map<std::string, Vector3>& materials,
-                           const std::string& currentMaterial) {
-    // Clear existing data
-    vertices.clear();
-    normals.clear();
-    texCoords.clear();
-    indices.clear();
-    
-    // Process the data
-    for (unsigned int i = 0; i < vertexIndices.size(); i++) {
-        if (i < vertexIndices.size()) {
-            unsigned int vertexIndex = vertexIndices[i];
-            if (vertexIndex < temp_vertices.size()) {
-                Vector3 vertex = temp_vertices[vertexIndex];
-                vertices.push_back(vertex.x);
-                vertices.push_back(vertex.y);
-                vertices.push_back(vertex.z);
-            } else {
-                std::cerr << "Warning: Vertex index out of range: " << vertexIndex << std::endl;
+    static unsigned int atlasCount = 0;
+    size_t moved = 0;
+    for (const auto& group : groups) {
+        TextureAtlas atlas(options);
+        std::set<std::string> paths;
+        for (Model* model : group.second) {
+            const std::string& path = model->albedoTexture.GetPath();
+            if (paths.insert(path).second) {
+                atlas.AddFile(path);
             }
         }
         
-        if (!temp_normals.empty() && i < normalIndices.size()) {
-            unsigned int normalIndex = normalIndices[i];
-            if (normalIndex < temp_normals.size()) {
-                Vector3 normal = temp_normals[normalIndex];
-                normals.push_back(normal.x);
-                normals.push_back(normal.y);
-                normals.push_back(normal.z);
-            } else {
-                std::cerr << "Warning: Normal index out of range: " << normalIndex << std::endl;
+        // A single texture gains nothing
+        if (atlas.GetImageCount() < 2 || !atlas.Build()) {
+            continue;
+        }
+        
+        // Mips stop where they would bleed between images
+        std::string settings = "levels=" + std::to_string(atlas.GetMipLevels());
+        std::vector<AssetHandle<Texture>> pages;
+        std::string name = "atlas/" + std::to_string(++atlasCount) + "/page";
+        for (size_t i = 0; i < atlas.GetPages().size(); ++i) {
+            const TextureAtlas::Page& page = atlas.GetPages()[i];
+            Texture* texture = new Texture();
+            if (!texture->create(page.pixels.data(), page.width, page.height, settings)) {
+                std::cerr << "Failed to create atlas page " << i << std::endl;
+                delete texture;
+                pages.push_back(AssetHandle<Texture>());
+                continue;
             }
+            pages.push_back(AssetManager::GetInstance().Adopt<Texture>(name + std::to_string(i), settings, texture));
         }
         
-        if (!temp_uvs.empty() && i < uvIndices.size()) {
-            unsigned int uvIndex = uvIndices[i];
-            if (uvIndex < temp_uvs.size()) {
-                Vector2 uv = temp_uvs[uvIndex];
-                texCoords.push_back(uv.x);
-                texCoords.push_back(uv.y);
-            } else {
-                std::cerr << "Warning: UV index out of range: " << uvIndex << std::endl;
+        for (Model* model : group.second) {
+            AtlasRegion region;
+            if (atlas.Find(model->albedoTexture.GetPath(), region) && model->ApplyAtlas(pages[region.page], region)) {
+                ++moved;
             }
         }
     }
-    
-    // Set material color if available
-    if (!currentMaterial.empty() && materials.find(currentMaterial) != materials.end()) {
-        Vector3 color = materials.at(currentMaterial);
-        // Store material color for later use in shader
-        // This would typically be set as a uniform in the shader
-    }
+    return moved;
 }
 
-// Load texture
-void Model::loadTexture(const std::string& path, const std::string& type) {
-    // Simple implementation for testing
-    std::cout << "Loading texture: " << path << " of type: " << type << std::endl;
-    // In a real implementation, this would load the texture using stb_image or similar
-}
-
-// Initialize buffers
-void Model::InitializeBuffers() {
-    InitializeGL();
-}
-
-// Initialize graphics objects
-void Model::InitializeGL() {
-    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
-    if (!graphics) {
-        std::cerr << "Failed to get graphics API instance" << std::endl;
-        return;
+// Update vertices
+void Model::UpdateVertices(const std::vector<float>& newVertices) {
+    // Animated vertices belong to this model alone
+    DetachSharedMesh();
+    vertices = newVertices;
+    
+    if (buffersInitialized) {
+        InitializeGL();
     }
     
-    // Generate VAO
-    vao = graphics->CreateVertexArray();
-    graphics->BindVertexArray(vao);
-    
-    // Generate VBO for vertices
-    vbo = graphics->CreateBuffer();
+    if (onVerticesUpdated) {
+        onVerticesUpdated(this);
+    }
+}
+
+// Upload a mesh's streams into its buffers and point the bound vertex array
+// at them: positions as floats, normals as snorm16, texture coordinates as
+// unorm16 or half floats, and indices in 16 bits when they fit
+static void FillMeshBuffers(IGraphicsAPI* graphics, const std::vector<float>& vertices,
+                            const std::vector<float>& normals, const std::vector<float>& texCoords,
+                            const std::vector<unsigned int>& indices, unsigned int vbo, unsigned int nbo,
+                            unsigned int tbo, unsigned int ebo, bool& shortIndices) {
     graphics->BindBuffer(BufferType::VERTEX_BUFFER, vbo);
     graphics->BufferData(BufferType::VERTEX_BUFFER, vertices.data(), vertices.size() * sizeof(float));
-    
-    // Set vertex attributes
     graphics->EnableVertexAttrib(0);
     graphics->VertexAttribPointer(0, 3, false, 0, nullptr);
     
-    // If we have normals, create a buffer for them
-    if (!normals.empty()) {
-        nbo = graphics->CreateBuffer();
+    if (!normals.empty() && nbo != 0) {
+        std::vector<int16_t> packed;
+        MeshOptimizer::QuantizeNormals(normals, packed);
         graphics->BindBuffer(BufferType::VERTEX_BUFFER, nbo);
-        graphics->BufferData(BufferType::VERTEX_BUFFER, normals.data(), normals.size() * sizeof(float));
-        
+        graphics->BufferData(BufferType::VERTEX_BUFFER, packed.data(), packed.size() * sizeof(int16_t));
         graphics->EnableVertexAttrib(1);
-        graphics->VertexAttribPointer(1, 3, false, 0, nullptr);
+        graphics->VertexAttribPointer(1, 3, AttribType::SHORT, true, 4 * sizeof(int16_t), nullptr);
     }
     
-    // If we have texture coordinates, create a buffer for them
-    if (!texCoords.empty()) {
-        tbo = graphics->CreateBuffer();
+    if (!texCoords.empty() && tbo != 0) {
+        MeshOptimizer::TexCoordFormat format = MeshOptimizer::GetTexCoordFormat(texCoords);
         graphics->BindBuffer(BufferType::TEXTURE_COORD_BUFFER, tbo);
-        graphics->BufferData(BufferType::TEXTURE_COORD_BUFFER, texCoords.data(), texCoords.size() * sizeof(float));
-        
+        if (format == MeshOptimizer::TEXCOORDS_FLOAT) {
+            graphics->BufferData(BufferType::TEXTURE_COORD_BUFFER, texCoords.data(), texCoords.size() * sizeof(float));
+            graphics->VertexAttribPointer(2, 2, false, 0, nullptr);
+        } else {
+            std::vector<uint16_t> packed;
+            MeshOptimizer::QuantizeTexCoords(texCoords, format, packed);
+            graphics->BufferData(BufferType::TEXTURE_COORD_BUFFER, packed.data(), packed.size() * sizeof(uint16_t));
+            bool unorm = format == MeshOptimizer::TEXCOORDS_UNORM16;
+            graphics->VertexAttribPointer(2, 2, unorm ? AttribType::UNSIGNED_SHORT : AttribType::HALF_FLOAT, unorm,
+                                          0, nullptr);
+        }
         graphics->EnableVertexAttrib(2);
-        graphics->VertexAttribPointer(2, 2, false, 0, nullptr);
     }
     
-    // If we have indices, create an element buffer
-    if (!indices.empty()) {
-        ebo = graphics->CreateBuffer();
+    shortIndices = false;
+    if (!indices.empty() && ebo != 0) {
         graphics->BindBuffer(BufferType::INDEX_BUFFER, ebo);
-        graphics->BufferData(BufferType::INDEX_BUFFER, indices.data(), indices.size() * sizeof(unsigned int));
+        if (MeshOptimizer::CanUseShortIndices(vertices.size() / 3)) {
+            std::vector<uint16_t> packed(indices.begin(), indices.end());
+            graphics->BufferData(BufferType::INDEX_BUFFER, packed.data(), packed.size() * sizeof(uint16_t));
+            shortIndices = true;
+        } else {
+            graphics->BufferData(BufferType::INDEX_BUFFER, indices.data(), indices.size() * sizeof(unsigned int));
+        }
     }
-    
-    // Unbind VAO
-    graphics->BindVertexArray(0);
 }
 
-// Update graphics buffers
-void Model::UpdateBuffers() {
-    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
-    if (!graphics) {
-        std::cerr << "Failed to get graphics API instance" << std::endl;
-        return;
-    }
-    
-    // Update vertex buffer
-    graphics->BindBuffer(BufferType::VERTEX_BUFFER, vbo);
-    graphics->BufferData(BufferType::VERTEX_BUFFER, vertices.data(), vertices.size() * sizeof(float));
+// Upload a mesh into a new vertex array with one buffer per attribute
+static void CreateMeshBuffers(IGraphicsAPI* graphics, const std::vector<float>& vertices,
+                              const std::vector<float>& normals, const std::vector<float>& texCoords,
+                              const std::vector<unsigned int>& indices, unsigned int& vao, unsigned int& vbo,
+                              unsigned int& nbo, unsigned int& tbo, unsigned int& ebo, bool& shortIndices) {
+    vao = graphics->CreateVertexArray();
+    graphics->BindVertexArray(vao);
     
-    // Update normal buffer if we have normals
-    if (!normals.empty() && nbo != 0) {
-        graphics->BindBuffer(BufferType::VERTEX_BUFFER, nbo);
-        graphics->BufferData(BufferType::VERTEX_BUFFER, normals.data(), normals.size() * sizeof(float));
+    vbo = graphics->CreateBuffer();
+    if (!normals.empty()) {
+        nbo = graphics->CreateBuffer();
     }
-    
-    // Update texture coordinate buffer if we have texture coordinates
-    if (!texCoords.empty() && tbo != 0) {
-        graphics->BindBuffer(BufferType::TEXTURE_COORD_BUFFER, tbo);
-        graphics->BufferData(BufferType::TEXTURE_COORD_BUFFER, texCoords.data(), texCoords.size() * sizeof(float));
+    if (!texCoords.empty()) {
+        tbo = graphics->CreateBuffer();
     }
-    
-    // Update index buffer if we have indices
-    if (!indices.empty() && ebo != 0) {
-        graphics->BindBuffer(BufferType::INDEX_BUFFER, ebo);
-        graphics->BufferData(BufferType::INDEX_BUFFER, indices.data(), indices.size() * sizeof(unsigned int));
+    if (!indices.empty()) {
+        ebo = graphics->CreateBuffer();
     }
+    FillMeshBuffers(graphics, vertices, normals, texCoords, indices, vbo, nbo, tbo, ebo, shortIndices);
+    
+    // Unbind VAO
+    graphics->BindVertexArray(0);
 }
 
-// Clean up graphics objects
-void Model::CleanupGL() {
-    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
-    if (!graphics) {
-        return;
-    }
-    
+// Delete the objects created by CreateMeshBuffers
+static void DeleteMeshBuffers(IGraphicsAPI* graphics, unsigned int& vao, unsigned int& vbo, unsigned int& nbo,
+                              unsigned int& tbo, unsigned int& ebo) {
     if (vao != 0) {
         graphics->DeleteVertexArray(vao);
         vao = 0;
@@ -440,15 +478,213 @@ void Model::CleanupGL() {
     }
 }
 
+MeshAsset::~MeshAsset() {
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    if (graphics) {
+        DeleteMeshBuffers(graphics.get(), vao, vbo, nbo, tbo, ebo);
+    }
+}
+
+// Load mesh and material data
+bool MeshAsset::Load(const std::string& path) {
+    // Cooked meshes are read directly; OBJs go through the mesh cache,
+    // which imports them only when they changed since the last import
+    std::string extension = path.substr(path.find_last_of(".") + 1);
+    bool loaded = extension == "savmesh" ? MeshCache::Read(path, data) : MeshCache::Load(path, data);
+    if (!loaded) {
+        return false;
+    }
+    
+    // Material libraries are relative to the mesh
+    std::string directory = path.substr(0, path.find_last_of("/\\") + 1);
+    for (const std::string& mtlFilename : data.materialLibraries) {
+        std::map<std::string, ObjMaterial> library;
+        if (!ObjLoader::LoadMaterials(directory + mtlFilename, library)) {
+            continue;
+        }
+        
+        for (const auto& entry : library) {
+            materials[entry.first] = entry.second.diffuse;
+            
+            // Diffuse texture map
+            if (!entry.second.diffuseMap.empty()) {
+                texturePaths.push_back(directory + entry.second.diffuseMap);
+            }
+        }
+    }
+    return true;
+}
+
+// Full mesh and levels of detail in one index list, as they are uploaded
+static std::vector<unsigned int> GetAllIndices(const ObjMeshData& data) {
+    std::vector<unsigned int> indices;
+    indices.reserve(data.indices.size() + data.lodIndices.size());
+    indices.insert(indices.end(), data.indices.begin(), data.indices.end());
+    indices.insert(indices.end(), data.lodIndices.begin(), data.lodIndices.end());
+    return indices;
+}
+
+// Bytes of vertex and index data, in the formats they are uploaded in
+size_t MeshAsset::GetUploadSize() const {
+    if (data.lodIndices.empty()) {
+        return MeshOptimizer::GetUploadSize(data.positions, data.normals, data.texCoords, data.indices);
+    }
+    return MeshOptimizer::GetUploadSize(data.positions, data.normals, data.texCoords, GetAllIndices(data));
+}
+
+void MeshAsset::GetLodRange(size_t level, size_t& firstIndex, size_t& indexCount) const {
+    if (level == 0 || level > data.lods.size()) {
+        firstIndex = 0;
+        indexCount = data.indices.size();
+        return;
+    }
+    const ObjMeshLod& lod = data.lods[level - 1];
+    firstIndex = data.indices.size() + lod.firstIndex;
+    indexCount = lod.indexCount;
+}
+
+// Exchange contents and graphics buffers with another mesh
+void MeshAsset::Swap(MeshAsset& other) {
+    std::swap(data, other.data);
+    materials.swap(other.materials);
+    texturePaths.swap(other.texturePaths);
+    std::swap(vao, other.vao);
+    std::swap(vbo, other.vbo);
+    std::swap(ebo, other.ebo);
+    std::swap(tbo, other.tbo);
+    std::swap(nbo, other.nbo);
+    std::swap(shortIndices, other.shortIndices);
+}
+
+// Create the shared graphics buffers once
+void MeshAsset::InitializeBuffers() {
+    if (vao != 0) {
+        return;
+    }
+    
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    if (!graphics) {
+        std::cerr << "Failed to get graphics API instance" << std::endl;
+        return;
+    }
+    
+    if (data.lodIndices.empty()) {
+        CreateMeshBuffers(graphics.get(), data.positions, data.normals, data.texCoords, data.indices, vao, vbo, nbo, tbo,
+                          ebo, shortIndices);
+    } else {
+        CreateMeshBuffers(graphics.get(), data.positions, data.normals, data.texCoords, GetAllIndices(data), vao, vbo, nbo,
+                          tbo, ebo, shortIndices);
+    }
+}
+
+MeshAsset* AssetLoader<MeshAsset>::Load(const std::string& path, const std::string& settings) {
+    MeshAsset* mesh = new MeshAsset();
+    if (!mesh->Load(path)) {
+        delete mesh;
+        return nullptr;
+    }
+    
+    // Copies moved onto an atlas page by ApplyAtlas: "atlas=page@x,y,w,h:u0,v0,u1,v1"
+    std::string atlas = AssetManager::GetSetting(settings, "atlas");
+    if (!atlas.empty()) {
+        AtlasRegion region;
+        size_t at = atlas.rfind('@');
+        if (at == std::string::npos ||
+            std::sscanf(atlas.c_str() + at + 1, "%u,%u,%u,%u:%f,%f,%f,%f", &region.x, &region.y, &region.width,
+                        &region.height, &region.u0, &region.v0, &region.u1, &region.v1) != 8) {
+            std::cerr << "Invalid atlas region in mesh settings: " << settings << std::endl;
+            delete mesh;
+            return nullptr;
+        }
+        TextureAtlas::RemapTexCoords(mesh->data.texCoords, region);
+    }
+    return mesh;
+}
+
+bool AssetLoader<MeshAsset>::Reload(MeshAsset* mesh, const std::string& path, const std::string& settings) {
+    MeshAsset* fresh = Load(path, settings);
+    if (!fresh) {
+        return false;
+    }
+    
+    // Upload right away if the old version was, so models keep drawing
+    if (mesh->GetVertexArray() != 0) {
+        fresh->InitializeBuffers();
+    }
+    mesh->Swap(*fresh);
+    delete fresh;
+    return true;
+}
+
+void AssetLoader<MeshAsset>::Unload(MeshAsset* mesh) {
+    delete mesh;
+}
+
+// Initialize buffers
+void Model::InitializeBuffers() {
+    InitializeGL();
+}
+
+// Initialize graphics objects
+void Model::InitializeGL() {
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    if (!graphics) {
+        std::cerr << "Failed to get graphics API instance" << std::endl;
+        return;
+    }
+    
+    if (sharedMesh) {
+        // Uploaded by whichever model using the mesh gets here first
+        sharedMesh->InitializeBuffers();
+    } else if (vao != 0) {
+        UpdateBuffers();
+    } else {
+        CreateMeshBuffers(graphics.get(), vertices, normals, texCoords, indices, vao, vbo, nbo, tbo, ebo, shortIndices);
+    }
+    buffersInitialized = true;
+    
+    // Create the textures found while parsing
+    std::vector<std::pair<std::string, std::string>> textures;
+    textures.swap(pendingTextures);
+    for (const auto& texture : textures) {
+        loadTexture(texture.first, texture.second);
+    }
+}
+
+// Update graphics buffers
+void Model::UpdateBuffers() {
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    if (!graphics) {
+        std::cerr << "Failed to get graphics API instance" << std::endl;
+        return;
+    }
+    
+    // The formats may change with the data, so the attributes are set again
+    graphics->BindVertexArray(vao);
+    FillMeshBuffers(graphics.get(), vertices, normals, texCoords, indices, vbo, nbo, tbo, ebo, shortIndices);
+    graphics->BindVertexArray(0);
+}
+
+// Clean up graphics objects
+void Model::CleanupGL() {
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    if (!graphics) {
+        return;
+    }
+    
+    DeleteMeshBuffers(graphics.get(), vao, vbo, nbo, tbo, ebo);
+}
+
 // Render the model with both point lights and directional lights
 void Model::Render(const std::vector<PointLight>& pointLights, const std::vector<DirectionalLight>& directionalLights) {
     std::cout << "Model::Render - Starting render with " << pointLights.size() << " point lights and " 
               << directionalLights.size() << " directional lights" << std::endl;
     
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
-    if (!graphics || vao == 0) {
+    unsigned int vertexArray = GetVertexArray();
+    if (!graphics || vertexArray == 0) {
         std::cout << "Model::Render - ERROR: Graphics API or VAO is null (graphics=" 
-                  << (graphics ? "valid" : "null") << ", vao=" << vao << ")" << std::endl;
+                  << (graphics ? "valid" : "null") << ", vao=" << vertexArray << ")" << std::endl;
         return;
     }
     
@@ -477,9 +713,10 @@ void Model::Render(const std::vector<PointLight>& pointLights, const std::vector
               << directionalLights.size() << " directional lights and custom matrices" << std::endl;
     
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
-    if (!graphics || vao == 0) {
+    unsigned int vertexArray = GetVertexArray();
+    if (!graphics || vertexArray == 0) {
         std::cout << "Model::Render - ERROR: Graphics API or VAO is null (graphics=" 
-                  << (graphics ? "valid" : "null") << ", vao=" << vao << ")" << std::endl;
+                  << (graphics ? "valid" : "null") << ", vao=" << vertexArray << ")" << std::endl;
         return;
     }
     
@@ -492,84 +729,81 @@ void Model::Render(const std::vector<PointLight>& pointLights, const std::vector
         return; // Return early if no shader program is set to prevent segmentation fault
     }
     
-    Matrix4x4 modelMatrix;
-    modelMatrix.identity(); // Start with identity matrix
-    modelMatrix.translate(position.x, position.y, position.z);
-    
-    Matrix4x4 rotationMatrix = Matrix4x4::createRotation(rotation.x, rotation.y, rotation.z);
-    modelMatrix = modelMatrix * rotationMatrix;
-    
-    shaderProgram->SetUniform("model", modelMatrix);
-    shaderProgram->SetUniform("view", viewMatrix);
-    shaderProgram->SetUniform("projection", projectionMatrix);
-    
-    Vector3 viewPos = Vector3(0, 0, 0);
-    
-    float m00 = viewMatrix.elements[0][0];
-    float m01 = viewMatrix.elements[0][1];
-    float m02 = viewMatrix.elements[0][2];
-    float m10 = viewMatrix.elements[1][0];
-    float m11 = viewMatrix.elements[1][1];
-    float m12 = viewMatrix.elements[1][2];
-    float m20 = viewMatrix.elements[2][0];
-    float m21 = viewMatrix.elements[2][1];
-    float m22 = viewMatrix.elements[2][2];
-    
-    float tx = viewMatrix.elements[0][3];
-    float ty = viewMatrix.elements[1][3];
-    float tz = viewMatrix.elements[2][3];
-    
-    viewPos.x = -(tx * m00 + ty * m10 + tz * m20);
-    viewPos.y = -(tx * m01 + ty * m11 + tz * m21);
-    viewPos.z = -(tx * m02 + ty * m12 + tz * m22);
-    
-    shaderProgram->SetUniform("viewPos", viewPos);
-    
-    // Set point light uniforms
-    int pointLightCount = std::min((int)pointLights.size(), 8); // Limit to 8 point lights
-    std::cout << "Model::Render - Setting pointLightCount: " << pointLightCount << std::endl;
-    shaderProgram->SetUniform("pointLightCount", pointLightCount);
-    
-    for (int i = 0; i < pointLightCount; i++) {
-        std::string prefix = "pointLights[" + std::to_string(i) + "].";
-        Vector3 lightPos = pointLights[i].GetPosition();
-        Vector3 lightColor = pointLights[i].GetColor();
-        float intensity = pointLights[i].GetIntensity();
-        float range = pointLights[i].GetRange();
-        
-        std::cout << "Model::Render - Light[" << i << "] position: (" 
-                  << lightPos.x << ", " << lightPos.y << ", " << lightPos.z << ")" << std::endl;
-        std::cout << "Model::Render - Light[" << i << "] color: (" 
-                  << lightColor.x << ", " << lightColor.y << ", " << lightColor.z << ")" << std::endl;
-        std::cout << "Model::Render - Light[" << i << "] intensity: " << intensity << std::endl;
-        std::cout << "Model::Render - Light[" << i << "] range: " << range << std::endl;
-        
-        shaderProgram->SetUniform(prefix + "position", lightPos);
-        shaderProgram->SetUniform(prefix + "color", lightColor);
-        shaderProgram->SetUniform(prefix + "intensity", intensity);
-        shaderProgram->SetUniform(prefix + "range", range);
+    // Camera and lights go to the shared uniform blocks, which are only
+    // uploaded when they change; programs without the blocks get them as
+    // plain uniforms
+    ShaderUniforms& sharedUniforms = ShaderUniforms::GetInstance();
+    sharedUniforms.SetCamera(viewMatrix, projectionMatrix);
+    sharedUniforms.SetLights(pointLights, directionalLights);
+    sharedUniforms.Upload(graphics.get());
+    shaderProgram->SetSharedUniforms();
+    
+    if (albedoTexture) {
+        graphics->BindTexture(albedoTexture->id, 0);
     }
     
-    // Set directional light uniforms
-    int dirLightCount = std::min((int)directionalLights.size(), 4); // Limit to 4 directional lights
-    shaderProgram->SetUniform("numDirectionalLights", dirLightCount);
+    graphics->BindVertexArray(vertexArray);
+    Draw(graphics.get());
+    graphics->BindVertexArray(0);
+}
+
+// Draw with the program, texture and vertex array bound by the caller
+void Model::Draw(IGraphicsAPI* graphics) {
+    static const int modelId = ShaderUniforms::GetId("model");
+    static const int lodFadeId = ShaderUniforms::GetId("lodFade");
     
-    for (int i = 0; i < dirLightCount; i++) {
-        std::string prefix = "directionalLights[" + std::to_string(i) + "].";
-        shaderProgram->SetUniform(prefix + "direction", directionalLights[i].GetDirection());
-        shaderProgram->SetUniform(prefix + "color", directionalLights[i].GetColor());
-        shaderProgram->SetUniform(prefix + "intensity", directionalLights[i].GetIntensity());
+    shaderProgram->SetUniform(modelId, GetModelMatrix());
+    
+    // Crossfading levels of detail dither each other out
+    shaderProgram->SetUniform(lodFadeId, lodFade);
+    
+    int indexCount = 0;
+    const void* offset = nullptr;
+    if (GetDrawRange(indexCount, offset)) {
+        graphics->DrawElements(DrawMode::TRIANGLES, indexCount, GetIndexType(), offset);
+    } else {
+        graphics->DrawArrays(DrawMode::TRIANGLES, 0, GetVertices().size() / 3);
     }
+}
+
+void Model::DrawInstanced(IGraphicsAPI* graphics, int instanceCount) {
+    static const int lodFadeId = ShaderUniforms::GetId("lodFade");
     
-    graphics->BindVertexArray(vao);
+    // The uniforms go to the variant, which is the program bound
+    ShaderProgram* instanced = shaderProgram->GetInstancedVariant();
+    instanced->SetUniform(lodFadeId, lodFade);
     
-    if (!indices.empty()) {
-        graphics->DrawElements(DrawMode::TRIANGLES, indices.size(), nullptr);
+    int indexCount = 0;
+    const void* offset = nullptr;
+    if (GetDrawRange(indexCount, offset)) {
+        graphics->DrawElementsInstanced(DrawMode::TRIANGLES, indexCount, GetIndexType(), offset, instanceCount);
     } else {
-        graphics->DrawArrays(DrawMode::TRIANGLES, 0, vertices.size() / 3);
+        graphics->DrawArraysInstanced(DrawMode::TRIANGLES, 0, GetVertices().size() / 3, instanceCount);
     }
+}
+
+Matrix4x4 Model::GetModelMatrix() const {
+    Matrix4x4 modelMatrix;
+    modelMatrix.identity(); // Start with identity matrix
+    modelMatrix.translate(position.x, position.y, position.z);
     
-    graphics->BindVertexArray(0);
+    Matrix4x4 rotationMatrix = Matrix4x4::createRotation(rotation.x, rotation.y, rotation.z);
+    return modelMatrix * rotationMatrix;
+}
+
+bool Model::GetDrawRange(int& indexCount, const void*& offset) const {
+    if (GetIndices().empty()) {
+        return false;
+    }
+    size_t firstIndex = 0;
+    size_t count = GetIndices().size();
+    if (sharedMesh) {
+        sharedMesh->GetLodRange(lodLevel, firstIndex, count);
+    }
+    size_t indexSize = GetIndexType() == IndexType::UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int);
+    indexCount = static_cast<int>(count);
+    offset = reinterpret_cast<const void*>(firstIndex * indexSize);
+    return true;
 }
 
 // Render the model with only point lights
@@ -16,15 +16,99 @@ class Face;
 #include "Texture.h"
 #include "platform.h"
 #include "Graphics/Core/IGraphicsAPI.h"
+#include "ObjLoader.h"
+#include "AssetManager.h"
+#include "AssetStreamer.h"
+#include "TextureAtlas.h"
 #include <map>
+#include <memory>
+#include <cstddef>
 
 // Forward declarations
 class PointLight;
 class DirectionalLight;
 
+// Mesh data and graphics buffers shared by every Model loaded from the same
+// file. Loaded through the AssetManager, so a mesh placed a thousand times
+// is parsed and uploaded once.
+class MeshAsset {
+public:
+    ObjMeshData data;
+    
+    // Diffuse colors and texture maps from the mesh's material libraries
+    std::map<std::string, Vector3> materials;
+    std::vector<std::string> texturePaths;
+    
+    MeshAsset() {}
+    ~MeshAsset();
+    
+    // Load an OBJ through the mesh cache, or a cooked .savmesh directly.
+    // Makes no graphics calls.
+    bool Load(const std::string& path);
+    
+    // Create the graphics buffers the first time it is called; main thread only
+    void InitializeBuffers();
+    
+    unsigned int GetVertexArray() const { return vao; }
+    
+    // Type of the uploaded indices
+    IndexType GetIndexType() const { return shortIndices ? IndexType::UNSIGNED_SHORT : IndexType::UNSIGNED_INT; }
+    
+    // Bytes InitializeBuffers sends to the GPU
+    size_t GetUploadSize() const;
+    
+    // Index range of a level of detail in the uploaded index buffer; the
+    // levels follow the full mesh's indices
+    void GetLodRange(size_t level, size_t& firstIndex, size_t& indexCount) const;
+    
+    // Exchange contents and graphics buffers with another mesh, so a
+    // reloaded mesh can replace this one without invalidating pointers to it
+    void Swap(MeshAsset& other);
+    
+private:
+    MeshAsset(const MeshAsset&);
+    MeshAsset& operator=(const MeshAsset&);
+    
+    unsigned int vao = 0;
+    unsigned int vbo = 0;
+    unsigned int ebo = 0;
+    unsigned int tbo = 0;
+    unsigned int nbo = 0;
+    bool shortIndices = false;
+};
+
+// Meshes are streamed without a separate read: the mesh cache maps the
+// file while the worker decodes it
+template <>
+struct AssetStreamLoader<MeshAsset> {
+    static bool Read(const std::string& path, const std::string& settings, std::vector<unsigned char>& bytes) {
+        (void)path;
+        (void)settings;
+        (void)bytes;
+        return true;
+    }
+    
+    static MeshAsset* Decode(const std::string& path, const std::string& settings,
+                             const std::vector<unsigned char>& bytes) {
+        (void)bytes;
+        return AssetLoader<MeshAsset>::Load(path, settings);
+    }
+    
+    static size_t GetUploadSize(const MeshAsset& mesh) {
+        return mesh.GetUploadSize();
+    }
+    
+    static bool Upload(MeshAsset& mesh) {
+        mesh.InitializeBuffers();
+        return mesh.GetVertexArray() != 0;
+    }
+};
+
 class Model : public MonoBehaviourLike {
 public:
-    // Mesh data
+    // Mesh data of generated or animated models. Models loaded from a file
+    // share their mesh instead and leave these empty; read the mesh through
+    // GetVertices() and friends, and change it with UpdateVertices().
     std::vector<float> vertices; // Stores the vertices
     std::vector<unsigned int> indices; // Stores the indices representing triangles
     std::vector<float> texCoords; // Stores texture coordinates
@@ -44,6 +128,21 @@ public:
     // Load model from file
     bool LoadFromFile(const std::string& filename);
     
+    // Load model from file in the background. The model draws nothing until
+    // the mesh has arrived; its textures follow separately. Higher
+    // priorities load first, so pass e.g. the negative distance to the camera.
+    bool LoadFromFileAsync(const std::string& filename, float priority = 0.0f);
+    
+    // Change the priority of a LoadFromFileAsync still in progress
+    void SetLoadPriority(float priority);
+    
+    // Whether a LoadFromFileAsync is still waiting for its mesh or textures
+    bool IsLoading() const;
+    
+    // Load mesh data only. Makes no graphics calls, so it is safe on a worker
+    // thread; call InitializeBuffers on the main thread afterwards.
+    bool ParseFromFile(const std::string& filename);
+    
     // Load model from OBJ file
     void loadOBJ(std::string path);
     
@@ -86,6 +185,18 @@ public:
     // Render the model with directional lights and specific view/projection matrices
     void Render(const std::vector<PointLight>& pointLights, const std::vector<DirectionalLight>& directionalLights, const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix);
     
+    // Set the model's own uniforms and issue its draw call, with its
+    // program, texture and vertex array already bound (see RenderQueue)
+    void Draw(IGraphicsAPI* graphics);
+    
+    // Issue one draw call for instanceCount copies of the mesh, with the
+    // program's instanced variant bound and the copies' model matrices in
+    // attributes 3 to 6 of the vertex array (see RenderQueue)
+    void DrawInstanced(IGraphicsAPI* graphics, int instanceCount);
+    
+    // Model-space to world-space transform of position and rotation
+    Matrix4x4 GetModelMatrix() const;
+    
     // Update uniforms
     void UpdateUniforms(const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix);
     
@@ -95,6 +206,18 @@ public:
     // Initialize buffers
     void InitializeBuffers();
     
+    // Whether InitializeBuffers has created the graphics buffers
+    bool HasBuffers() const { return buffersInitialized; }
+    
+    // Mesh data, shared with other models loaded from the same file
+    const std::vector<float>& GetVertices() const { return sharedMesh ? sharedMesh->data.positions : vertices; }
+    const std::vector<float>& GetNormals() const { return sharedMesh ? sharedMesh->data.normals : normals; }
+    const std::vector<float>& GetTexCoords() const { return sharedMesh ? sharedMesh->data.texCoords : texCoords; }
+    const std::vector<unsigned int>& GetIndices() const { return sharedMesh ? sharedMesh->data.indices : indices; }
+    
+    // Loaded mesh this model draws, empty for generated models
+    const AssetHandle<MeshAsset>& GetSharedMesh() const { return sharedMesh; }
+    
     // Set shader program
     void SetShaderProgram(ShaderProgram* program);
     
@@ -107,17 +230,77 @@ public:
     // Get texture path
     const std::string& GetTexturePath() const { return texturePath; }
     
+    // Albedo texture, empty until it has loaded
+    const AssetHandle<Texture>& GetAlbedoTexture() const { return albedoTexture; }
+    
+    // Texture Render binds, 0 for none
+    unsigned int GetTextureId() const { return albedoTexture ? albedoTexture->id : 0; }
+    
+    // Whether the model blends over what is behind it and has to be drawn
+    // after opaque models, back to front
+    bool IsTransparent() const { return static_cast<bool>(opacityTexture); }
+    
+    // Vertex array to draw, shared or our own
+    unsigned int GetVertexArray() const { return sharedMesh ? sharedMesh->GetVertexArray() : vao; }
+    
+    // Draw with a region of an atlas page instead of the albedo texture.
+    // Remaps the texture coordinates, sharing the remapped mesh with other
+    // models of the same mesh and region; false if they leave [0, 1].
+    bool ApplyAtlas(const AssetHandle<Texture>& page, const AtlasRegion& region);
+    
+    // Pack the small albedo textures of models sharing a shader program
+    // into atlas pages and move the models onto them, so their draws bind
+    // one texture. Call once the textures have loaded; returns the number
+    // of models moved.
+    static size_t BuildTextureAtlases(const std::vector<Model*>& models,
+                                      const TextureAtlas::Options& options = TextureAtlas::Options());
+    
+    // File the model was parsed from, empty for generated models
+    const std::string& GetSourcePath() const { return sourcePath; }
+    
+    // Levels of detail the model can be drawn at, the full mesh included
+    size_t GetLodCount() const { return sharedMesh ? sharedMesh->data.lods.size() + 1 : 1; }
+    
+    // Level Render draws and its crossfade dither: a positive fade keeps
+    // the fragments whose dither value is at least fade, a negative one
+    // those below -fade, so two levels drawn with fade and -fade add up to
+    // one image. 0 draws every fragment.
+    void SetLod(size_t level, float fade = 0.0f);
+    size_t GetLodLevel() const { return lodLevel; }
+    float GetLodFade() const { return lodFade; }
+    
+    // Radius around the model's position that holds its whole mesh
+    float GetBoundingRadius() const;
+    
+    // Box around the mesh in model space; false if there is no mesh
+    bool GetLocalBounds(Vector3& boundsMin, Vector3& boundsMax) const;
+    
 private:
     // Texture data
     std::string texturePath;
     
+    // Path given to ParseFromFile
+    std::string sourcePath;
+    
     // Shader program
     ShaderProgram* shaderProgram = nullptr;
     
+    // Shared mesh loaded from sourcePath
+    AssetHandle<MeshAsset> sharedMesh;
+    
     // Textures
-    Texture* albedoTexture = nullptr;
-    Texture* normalTexture = nullptr;
-    Texture* opacityTexture = nullptr;
+    AssetHandle<Texture> albedoTexture;
+    AssetHandle<Texture> normalTexture;
+    AssetHandle<Texture> opacityTexture;
+    
+    // Textures requested before the buffers existed (path, type)
+    std::vector<std::pair<std::string, std::string>> pendingTextures;
+    
+    // Loads started by LoadFromFileAsync
+    std::vector<std::shared_ptr<AssetRequestBase>> streamRequests;
+    
+    // Set once InitializeBuffers has run with a graphics API
+    bool buffersInitialized = false;
     
     // Callback for when vertices are updated
     std::function<void(Model*)> onVerticesUpdated;
@@ -128,6 +311,11 @@ private:
     unsigned int ebo = 0;  // Element Buffer Object
     unsigned int tbo = 0;  // Texture Coordinate Buffer Object
     unsigned int nbo = 0;  // Normal Buffer Object
+    bool shortIndices = false; // Indices uploaded as 16 bits
+    
+    // Level of detail to draw, see SetLod
+    size_t lodLevel = 0;
+    float lodFade = 0.0f;
     
     // Calculate normal for a vertex
     Vector3 calculateNormal(size_t i) const {
@@ -154,27 +342,29 @@ private:
     // Clean up graphics objects
     void CleanupGL();
     
+    // Index range of the current level of detail, as a count and a byte
+    // offset into the index buffer; false for models without indices
+    bool GetDrawRange(int& indexCount, const void*& offset) const;
+    
+    // Type of the indices in the vertex array
+    IndexType GetIndexType() const {
+        if (sharedMesh) {
+            return sharedMesh->GetIndexType();
+        }
+        return shortIndices ? IndexType::UNSIGNED_SHORT : IndexType::UNSIGNED_INT;
+    }
+    
+    // Stream a texture in, assigning it once it has loaded
+    void streamTexture(const std::string& path, const std::string& type, float priority);
+    
+    // Cancel the loads started by LoadFromFileAsync
+    void CancelStreaming();
+    
+    // Copy the shared mesh into this model so it can be changed
+    void DetachSharedMesh();
+    
     // Helper methods for OBJ loading
-    void parseVertexIndices(const std::string& v1, const std::string& v2, const std::string& v3,
-                           std::vector<unsigned int>& vertexIndices, 
-                           std::vector<unsigned int>& uvIndices, 
-                           std::vector<unsigned int>& normalIndices,
-                           size_t vertexCount, size_t uvCount, size_t normalCount);
-    void parseVertex(const std::string& vertexStr, 
-                    std::vector<unsigned int>& vertexIndices, 
-                    std::vector<unsigned int>& uvIndices, 
-                    std::vector<unsigned int>& normalIndices,
-                    size_t vertexCount, size_t uvCount, size_t normalCount);
-    void loadMTL(const std::string& mtlFilename, const std::string& objPath, 
-                std::map<std::string, Vector3>& materials);
-    void processModelData(const std::vector<Vector3>& temp_vertices,
-                         const std::vector<Vector3>& temp_normals,
-                         const std::vector<Vector2>& temp_uvs,
-                         const std::vector<unsigned int>& vertexIndices,
-                         const std::vector<unsigned int>& normalIndices,
-                         const std::vector<unsigned int>& uvIndices,
-                         const std::map<std::string, Vector3>& materials,
-                         const std::string& currentMaterial);
+    bool parseOBJ(const std::string& path);
 };
 
 #endif // MODEL_H
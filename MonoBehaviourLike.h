@@ -1,6 +1,8 @@
 #ifndef MONOBEHAVIOURLIKE_H
 #define MONOBEHAVIOURLIKE_H
 
+#include "Coroutine.h"
+
 class MonoBehaviourLike
 {
 public:
@@ -32,8 +34,34 @@ public:
 
     // ... and many others depending on the level of detail you need
 
+    // Deferred script callbacks. A pending callback costs nothing per frame;
+    // the scheduler runs it once when its timer, trigger or physics step
+    // comes due.
+    CoroutineId InvokeAfter(float seconds, std::function<void()> callback) {
+        return CoroutineScheduler::GetInstance().InvokeAfter(this, seconds, std::move(callback));
+    }
+    CoroutineId InvokeWhen(CoroutineTrigger& trigger, std::function<void()> callback) {
+        return CoroutineScheduler::GetInstance().InvokeWhen(this, trigger, std::move(callback));
+    }
+    CoroutineId InvokeOnFixedUpdate(std::function<void()> callback) {
+        return CoroutineScheduler::GetInstance().InvokeOnFixedUpdate(this, std::move(callback));
+    }
+
+#if GAMEENGINE_COROUTINES
+    // Coroutines (C++20 builds only), resumed through the same waits
+    CoroutineId StartCoroutine(Coroutine routine) {
+        return CoroutineScheduler::GetInstance().Start(this, std::move(routine));
+    }
+#endif
+
+    // Stop a coroutine or cancel a pending callback
+    void StopCoroutine(CoroutineId id) { CoroutineScheduler::GetInstance().Stop(id); }
+    void StopAllCoroutines() { CoroutineScheduler::GetInstance().StopAll(this); }
+
     // Destructor to handle cleanup if necessary
-    virtual ~MonoBehaviourLike() {}
+    virtual ~MonoBehaviourLike() {
+        StopAllCoroutines();
+    }
 };
 
 #endif // MONOBEHAVIOURLIKE_H
@@ -1,6 +1,8 @@
 #include "NavMeshManager.h"
 #include "AIEntity.h"
 #include "ProjectSettings/ProjectSettings.h"
+#include "EventBus.h"
+#include "EngineEvents.h"
 #include <algorithm>
 
 // Initialize static instance
@@ -10,9 +12,19 @@ NavMeshManager::NavMeshManager()
     : navMesh(new NavMesh()),
       refreshRate(10.0f),
       timeSinceLastRefresh(0.0f) {
+    // Several refreshes in one batch only need one notification per entity
+    refreshListener = EventBus::GetInstance().Subscribe<NavMeshRefreshedEvent>(
+        [this](const NavMeshRefreshedEvent*, size_t) {
+            for (AIEntity* entity : aiEntities) {
+                if (entity) {
+                    entity->OnNavMeshRefresh();
+                }
+            }
+        });
 }
 
 NavMeshManager::~NavMeshManager() {
+    EventBus::GetInstance().Unsubscribe(refreshListener);
     aiEntities.clear();
     delete navMesh;
 }
@@ -47,6 +59,9 @@ void NavMeshManager::Update(float deltaTime) {
         RefreshNavMesh();
         timeSinceLastRefresh = 0.0f;
     }
+    
+    // Deliver refresh events raised this update (or by SetNavMesh)
+    EventBus::GetInstance().Dispatch<NavMeshRefreshedEvent>();
 }
 
 void NavMeshManager::RefreshNavMesh() {
@@ -71,11 +86,7 @@ void NavMeshManager::RefreshNavMesh() {
     navMesh->ConnectNodes(2, 3);
     
     // Notify all AI entities that the NavMesh has been refreshed
-    for (AIEntity* entity : aiEntities) {
-        if (entity) {
-            entity->OnNavMeshRefresh();
-        }
-    }
+    EventBus::GetInstance().Publish(NavMeshRefreshedEvent(navMesh));
 }
 
 NavMesh* NavMeshManager::GetNavMesh() const {
@@ -91,11 +102,7 @@ void NavMeshManager::SetNavMesh(NavMesh* mesh) {
         navMesh = mesh;
         
         // Notify all AI entities that the NavMesh has been updated
-        for (AIEntity* entity : aiEntities) {
-            if (entity) {
-                entity->OnNavMeshRefresh();
-            }
-        }
+        EventBus::GetInstance().Publish(NavMeshRefreshedEvent(navMesh));
     }
 }
 
@@ -14,6 +14,9 @@ private:
     float refreshRate;
     float timeSinceLastRefresh;
     
+    // EventBus listener that forwards NavMeshRefreshedEvent to the AI entities
+    unsigned int refreshListener;
+    
     // Singleton instance
     static NavMeshManager* instance;
     
@@ -27,10 +30,11 @@ public:
     // Initialize the navigation mesh manager
     void Initialize();
     
-    // Update the navigation mesh
+    // Update the navigation mesh and deliver pending refresh events
     void Update(float deltaTime);
     
-    // Refresh the navigation mesh
+    // Refresh the navigation mesh. AI entities are notified through a
+    // NavMeshRefreshedEvent at the next dispatch, once per batch.
     void RefreshNavMesh();
     
     // Get the navigation mesh
@@ -0,0 +1,674 @@
+#include "ObjLoader.h"
+#include "MappedFile.h"
+
+#include <iostream>
+#include <thread>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+namespace {
+    // Face corner as written in the file. Indices are 0-based; a component
+    // flagged in `relative` came from a negative index and is still relative
+    // to the start of its chunk.
+    struct Corner {
+        int v;
+        int t;
+        int n;
+        unsigned char relative;
+    };
+
+    const int MISSING = INT_MIN;
+    const unsigned char RELATIVE_V = 1;
+    const unsigned char RELATIVE_T = 2;
+    const unsigned char RELATIVE_N = 4;
+
+    // Results of parsing one line-aligned piece of the file
+    struct Chunk {
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        std::vector<float> positions;
+        std::vector<float> texCoords;
+        std::vector<float> normals;
+        std::vector<Corner> corners; // three per triangle
+        std::vector<std::string> libraries;
+        std::vector<std::pair<size_t, std::string>> materials; // usemtl by first corner
+        std::string material;
+        bool hasMaterial = false;
+        size_t badLines = 0;
+    };
+
+    inline bool IsSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    inline bool IsDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    inline void SkipSpaces(const char*& p, const char* end) {
+        while (p < end && IsSpace(*p)) {
+            ++p;
+        }
+    }
+
+    // Next whitespace separated word
+    std::string ReadWord(const char*& p, const char* end) {
+        SkipSpaces(p, end);
+        const char* start = p;
+        while (p < end && !IsSpace(*p)) {
+            ++p;
+        }
+        return std::string(start, p);
+    }
+
+    // Rest of the line without surrounding whitespace
+    std::string ReadRest(const char* p, const char* end) {
+        SkipSpaces(p, end);
+        while (end > p && IsSpace(end[-1])) {
+            --end;
+        }
+        return std::string(p, end);
+    }
+
+    // Slow path for numbers the fast parser does not handle (very long
+    // mantissas, huge exponents, inf/nan)
+    bool ParseFloatFallback(const char*& p, const char* end, float& value) {
+        char buffer[64];
+        size_t length = 0;
+        while (p + length < end && !IsSpace(p[length]) && length < sizeof(buffer) - 1) {
+            buffer[length] = p[length];
+            ++length;
+        }
+        buffer[length] = '\0';
+        char* parsedEnd = nullptr;
+        double result = std::strtod(buffer, &parsedEnd);
+        if (parsedEnd == buffer) {
+            return false;
+        }
+        p += parsedEnd - buffer;
+        value = static_cast<float>(result);
+        return true;
+    }
+
+    // Decimal number such as "-1.25e-3". The text is not null-terminated,
+    // so strtod cannot be used on it directly.
+    bool ParseFloat(const char*& p, const char* end, float& value) {
+        static const double powers[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        SkipSpaces(p, end);
+        const char* start = p;
+        const char* q = p;
+
+        bool negative = false;
+        if (q < end && (*q == '-' || *q == '+')) {
+            negative = *q == '-';
+            ++q;
+        }
+
+        uint64_t mantissa = 0;
+        int significant = 0;
+        int exponent = 0;
+        bool anyDigits = false;
+
+        for (; q < end && IsDigit(*q); ++q) {
+            anyDigits = true;
+            if (significant < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*q - '0');
+                if (mantissa != 0) {
+                    ++significant;
+                }
+            } else {
+                ++exponent;
+            }
+        }
+        if (q < end && *q == '.') {
+            ++q;
+            for (; q < end && IsDigit(*q); ++q) {
+                anyDigits = true;
+                if (significant < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*q - '0');
+                    if (mantissa != 0) {
+                        ++significant;
+                    }
+                    --exponent;
+                }
+            }
+        }
+        if (!anyDigits) {
+            return ParseFloatFallback(p, end, value);
+        }
+        if (q < end && (*q == 'e' || *q == 'E')) {
+            ++q;
+            bool negativeExponent = false;
+            if (q < end && (*q == '-' || *q == '+')) {
+                negativeExponent = *q == '-';
+                ++q;
+            }
+            if (q >= end || !IsDigit(*q)) {
+                p = start;
+                return ParseFloatFallback(p, end, value);
+            }
+            int written = 0;
+            for (; q < end && IsDigit(*q); ++q) {
+                if (written < 10000) {
+                    written = written * 10 + (*q - '0');
+                }
+            }
+            exponent += negativeExponent ? -written : written;
+        }
+        if (q < end && !IsSpace(*q) && *q != '\n') {
+            // Not a plain number after all
+            return ParseFloatFallback(p, end, value);
+        }
+        if (exponent < -22 || exponent > 22) {
+            return ParseFloatFallback(p, end, value);
+        }
+
+        double result = static_cast<double>(mantissa);
+        result = exponent < 0 ? result / powers[-exponent] : result * powers[exponent];
+        value = static_cast<float>(negative ? -result : result);
+        p = q;
+        return true;
+    }
+
+    bool ParseInt(const char*& p, const char* end, int& value) {
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negative = *p == '-';
+            ++p;
+        }
+        if (p >= end || !IsDigit(*p)) {
+            return false;
+        }
+        long long result = 0;
+        for (; p < end && IsDigit(*p); ++p) {
+            result = result * 10 + (*p - '0');
+            if (result > INT_MAX) {
+                return false;
+            }
+        }
+        value = static_cast<int>(negative ? -result : result);
+        return true;
+    }
+
+    // Convert one OBJ index to 0-based. Negative indices count back from the
+    // elements read so far in this chunk and are fixed up after merging.
+    bool ConvertIndex(int index, size_t count, int& out, unsigned char flag, unsigned char& relative) {
+        if (index > 0) {
+            out = index - 1;
+            return true;
+        }
+        if (index < 0) {
+            out = static_cast<int>(count) + index;
+            relative |= flag;
+            return true;
+        }
+        return false;
+    }
+
+    // Face corner: v, v/vt, v//vn or v/vt/vn
+    bool ParseCorner(const char*& p, const char* end, const Chunk& chunk, Corner& corner) {
+        corner.t = MISSING;
+        corner.n = MISSING;
+        corner.relative = 0;
+
+        int index = 0;
+        if (!ParseInt(p, end, index) ||
+            !ConvertIndex(index, chunk.positions.size() / 3, corner.v, RELATIVE_V, corner.relative)) {
+            return false;
+        }
+        if (p < end && *p == '/') {
+            ++p;
+            if (p < end && *p != '/') {
+                if (!ParseInt(p, end, index) ||
+                    !ConvertIndex(index, chunk.texCoords.size() / 2, corner.t, RELATIVE_T, corner.relative)) {
+                    return false;
+                }
+            }
+            if (p < end && *p == '/') {
+                ++p;
+                if (!ParseInt(p, end, index) ||
+                    !ConvertIndex(index, chunk.normals.size() / 3, corner.n, RELATIVE_N, corner.relative)) {
+                    return false;
+                }
+            }
+        }
+        return p >= end || IsSpace(*p);
+    }
+
+    bool ParseFace(const char* p, const char* end, Chunk& chunk) {
+        Corner first;
+        Corner previous;
+        Corner corner;
+        size_t count = 0;
+        size_t start = chunk.corners.size();
+
+        SkipSpaces(p, end);
+        while (p < end) {
+            if (!ParseCorner(p, end, chunk, corner)) {
+                chunk.corners.resize(start);
+                return false;
+            }
+            if (count == 0) {
+                first = corner;
+            } else if (count >= 2) {
+                // Fan triangulation
+                chunk.corners.push_back(first);
+                chunk.corners.push_back(previous);
+                chunk.corners.push_back(corner);
+            }
+            previous = corner;
+            ++count;
+            SkipSpaces(p, end);
+        }
+        if (count < 3) {
+            chunk.corners.resize(start);
+            return false;
+        }
+        return true;
+    }
+
+    bool ParseFloats(const char* p, const char* end, int required, int total, std::vector<float>& out) {
+        for (int i = 0; i < total; ++i) {
+            float value = 0.0f;
+            SkipSpaces(p, end);
+            if (p >= end) {
+                if (i < required) {
+                    return false;
+                }
+                out.push_back(0.0f);
+                continue;
+            }
+            if (!ParseFloat(p, end, value)) {
+                return false;
+            }
+            out.push_back(value);
+        }
+        return true;
+    }
+
+    void ParseLine(const char* p, const char* end, Chunk& chunk) {
+        SkipSpaces(p, end);
+        if (p >= end || *p == '#') {
+            return;
+        }
+
+        bool ok = true;
+        if (p[0] == 'v' && p + 1 < end && IsSpace(p[1])) {
+            ok = ParseFloats(p + 2, end, 3, 3, chunk.positions);
+            if (!ok) {
+                chunk.positions.resize(chunk.positions.size() / 3 * 3);
+                chunk.positions.resize(chunk.positions.size() + 3, 0.0f);
+            }
+        } else if (p[0] == 'v' && p + 2 < end && p[1] == 't' && IsSpace(p[2])) {
+            ok = ParseFloats(p + 3, end, 1, 2, chunk.texCoords);
+            if (!ok) {
+                chunk.texCoords.resize(chunk.texCoords.size() / 2 * 2);
+                chunk.texCoords.resize(chunk.texCoords.size() + 2, 0.0f);
+            }
+        } else if (p[0] == 'v' && p + 2 < end && p[1] == 'n' && IsSpace(p[2])) {
+            ok = ParseFloats(p + 3, end, 3, 3, chunk.normals);
+            if (!ok) {
+                chunk.normals.resize(chunk.normals.size() / 3 * 3);
+                chunk.normals.resize(chunk.normals.size() + 3, 0.0f);
+            }
+        } else if (p[0] == 'f' && p + 1 < end && IsSpace(p[1])) {
+            ok = ParseFace(p + 2, end, chunk);
+        } else if (end - p > 7 && std::memcmp(p, "mtllib", 6) == 0 && IsSpace(p[6])) {
+            p += 7;
+            while (true) {
+                std::string name = ReadWord(p, end);
+                if (name.empty()) {
+                    break;
+                }
+                chunk.libraries.push_back(name);
+            }
+        } else if (end - p > 7 && std::memcmp(p, "usemtl", 6) == 0 && IsSpace(p[6])) {
+            chunk.material = ReadRest(p + 7, end);
+            chunk.hasMaterial = true;
+            chunk.materials.push_back(std::make_pair(chunk.corners.size(), chunk.material));
+        }
+        // Groups, objects, smoothing groups and other statements are ignored
+
+        if (!ok) {
+            ++chunk.badLines;
+        }
+    }
+
+    void ParseChunk(Chunk* chunk) {
+        const char* p = chunk->begin;
+        const char* end = chunk->end;
+
+        // Rough guess from typical line lengths to avoid most regrowth
+        size_t bytes = static_cast<size_t>(end - p);
+        chunk->positions.reserve(bytes / 40 * 3);
+        chunk->corners.reserve(bytes / 30 * 3);
+
+        while (p < end) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+            if (!lineEnd) {
+                lineEnd = end;
+            }
+            ParseLine(p, lineEnd, *chunk);
+            p = lineEnd + 1;
+        }
+    }
+
+    inline size_t HashCorner(int v, int t, int n) {
+        uint64_t h = static_cast<uint32_t>(v) * 0x9E3779B97F4A7C15ULL;
+        h ^= (static_cast<uint64_t>(static_cast<uint32_t>(t)) + 0x7F4A7C15ULL) * 0xC2B2AE3D27D4EB4FULL;
+        h ^= (static_cast<uint64_t>(static_cast<uint32_t>(n)) + 0x165667B1ULL) * 0x165667B19E3779F9ULL;
+        h ^= h >> 29;
+        return static_cast<size_t>(h);
+    }
+
+    // Maps resolved (v, t, n) corners to vertex numbers. Open addressing
+    // with linear probing; slots hold vertex numbers and the keys live in
+    // `keys`, so growing the table does not move them.
+    class CornerTable {
+    public:
+        explicit CornerTable(size_t expected) {
+            size_t capacity = 64;
+            while (capacity < expected * 2) {
+                capacity <<= 1;
+            }
+            slots.assign(capacity, EMPTY);
+            keys.reserve(expected);
+        }
+
+        unsigned int Insert(int v, int t, int n) {
+            if ((keys.size() + 1) * 2 > slots.size()) {
+                Grow();
+            }
+            size_t mask = slots.size() - 1;
+            size_t slot = HashCorner(v, t, n) & mask;
+            while (slots[slot] != EMPTY) {
+                const Corner& key = keys[slots[slot]];
+                if (key.v == v && key.t == t && key.n == n) {
+                    return slots[slot];
+                }
+                slot = (slot + 1) & mask;
+            }
+            unsigned int vertex = static_cast<unsigned int>(keys.size());
+            Corner key;
+            key.v = v;
+            key.t = t;
+            key.n = n;
+            key.relative = 0;
+            keys.push_back(key);
+            slots[slot] = vertex;
+            return vertex;
+        }
+
+        const std::vector<Corner>& GetKeys() const { return keys; }
+
+    private:
+        enum : unsigned int { EMPTY = 0xFFFFFFFFu };
+        std::vector<unsigned int> slots;
+        std::vector<Corner> keys;
+
+        void Grow() {
+            std::vector<unsigned int> larger(slots.size() * 2, EMPTY);
+            size_t mask = larger.size() - 1;
+            for (unsigned int vertex = 0; vertex < keys.size(); ++vertex) {
+                const Corner& key = keys[vertex];
+                size_t slot = HashCorner(key.v, key.t, key.n) & mask;
+                while (larger[slot] != EMPTY) {
+                    slot = (slot + 1) & mask;
+                }
+                larger[slot] = vertex;
+            }
+            slots.swap(larger);
+        }
+    };
+
+    // Fix up a relative index and check the range; MISSING stays MISSING
+    inline bool ResolveIndex(int& index, bool relative, size_t offset, size_t count) {
+        if (index == MISSING) {
+            return true;
+        }
+        long long resolved = static_cast<long long>(index) + (relative ? static_cast<long long>(offset) : 0);
+        if (resolved < 0 || resolved >= static_cast<long long>(count)) {
+            return false;
+        }
+        index = static_cast<int>(resolved);
+        return true;
+    }
+
+    template <typename T>
+    void Append(std::vector<T>& target, const std::vector<T>& source) {
+        target.insert(target.end(), source.begin(), source.end());
+    }
+}
+
+bool ObjLoader::Load(const std::string& path, ObjMeshData& mesh, unsigned int threadCount) {
+    MappedFile file;
+    if (!file.Open(path)) {
+        std::cerr << "Error: Could not open file " << path << std::endl;
+        return false;
+    }
+    return Parse(reinterpret_cast<const char*>(file.GetData()), file.GetSize(), mesh, path, threadCount);
+}
+
+bool ObjLoader::Parse(const char* text, size_t length, ObjMeshData& mesh,
+                      const std::string& sourceName, unsigned int threadCount) {
+    mesh = ObjMeshData();
+
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    size_t chunkCount = length / MIN_CHUNK_SIZE;
+    if (chunkCount > threadCount) {
+        chunkCount = threadCount;
+    }
+    if (chunkCount == 0) {
+        chunkCount = 1;
+    }
+
+    // Split at line boundaries
+    std::vector<Chunk> chunks(chunkCount);
+    const char* end = text + length;
+    const char* start = text;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        const char* split = end;
+        if (i + 1 < chunkCount) {
+            split = text + length / chunkCount * (i + 1);
+            if (split < start) {
+                split = start;
+            }
+            const char* newline = static_cast<const char*>(std::memchr(split, '\n', static_cast<size_t>(end - split)));
+            split = newline ? newline + 1 : end;
+        }
+        chunks[i].begin = start;
+        chunks[i].end = split;
+        start = split;
+    }
+
+    // The calling thread takes the first chunk
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        workers.emplace_back(ParseChunk, &chunks[i]);
+    }
+    ParseChunk(&chunks[0]);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    // Merge element arrays; each chunk's relative indices are offset by the
+    // elements that came before it
+    std::vector<float> positions;
+    std::vector<float> texCoords;
+    std::vector<float> normals;
+    std::vector<size_t> positionOffsets(chunkCount);
+    std::vector<size_t> texCoordOffsets(chunkCount);
+    std::vector<size_t> normalOffsets(chunkCount);
+    size_t corners = 0;
+    size_t badLines = 0;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        positionOffsets[i] = positions.size() / 3;
+        texCoordOffsets[i] = texCoords.size() / 2;
+        normalOffsets[i] = normals.size() / 3;
+        Append(positions, chunks[i].positions);
+        Append(texCoords, chunks[i].texCoords);
+        Append(normals, chunks[i].normals);
+        std::vector<float>().swap(chunks[i].positions);
+        std::vector<float>().swap(chunks[i].texCoords);
+        std::vector<float>().swap(chunks[i].normals);
+
+        corners += chunks[i].corners.size();
+        badLines += chunks[i].badLines;
+        Append(mesh.materialLibraries, chunks[i].libraries);
+        if (chunks[i].hasMaterial) {
+            mesh.material = chunks[i].material;
+        }
+    }
+    size_t positionCount = positions.size() / 3;
+    size_t texCoordCount = texCoords.size() / 2;
+    size_t normalCount = normals.size() / 3;
+
+    // Deduplicate corners into indexed vertices. Closed meshes share each
+    // position between about six triangles, so expect far fewer vertices
+    // than corners.
+    CornerTable table(corners / 4);
+    mesh.indices.reserve(corners);
+    bool anyTexCoords = false;
+    bool anyNormals = false;
+    size_t droppedTriangles = 0;
+    ObjSubmesh submesh;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        const std::vector<Corner>& chunkCorners = chunks[i].corners;
+        const std::vector<std::pair<size_t, std::string>>& materials = chunks[i].materials;
+        size_t nextMaterial = 0;
+        for (size_t c = 0; c + 2 < chunkCorners.size() || nextMaterial < materials.size(); c += 3) {
+            // A usemtl before this triangle starts a new submesh
+            while (nextMaterial < materials.size() && materials[nextMaterial].first <= c) {
+                const std::string& material = materials[nextMaterial++].second;
+                if (material != submesh.material) {
+                    submesh.indexCount = mesh.indices.size() - submesh.firstIndex;
+                    if (submesh.indexCount > 0) {
+                        mesh.submeshes.push_back(submesh);
+                    }
+                    submesh.material = material;
+                    submesh.firstIndex = mesh.indices.size();
+                }
+            }
+            if (c + 2 >= chunkCorners.size()) {
+                break;
+            }
+            Corner triangle[3] = { chunkCorners[c], chunkCorners[c + 1], chunkCorners[c + 2] };
+            bool valid = true;
+            for (int k = 0; k < 3 && valid; ++k) {
+                Corner& corner = triangle[k];
+                valid = ResolveIndex(corner.v, (corner.relative & RELATIVE_V) != 0, positionOffsets[i], positionCount) &&
+                        ResolveIndex(corner.t, (corner.relative & RELATIVE_T) != 0, texCoordOffsets[i], texCoordCount) &&
+                        ResolveIndex(corner.n, (corner.relative & RELATIVE_N) != 0, normalOffsets[i], normalCount);
+            }
+            if (!valid) {
+                ++droppedTriangles;
+                continue;
+            }
+            for (int k = 0; k < 3; ++k) {
+                anyTexCoords = anyTexCoords || triangle[k].t != MISSING;
+                anyNormals = anyNormals || triangle[k].n != MISSING;
+                mesh.indices.push_back(table.Insert(triangle[k].v, triangle[k].t, triangle[k].n));
+            }
+        }
+        std::vector<Corner>().swap(chunks[i].corners);
+    }
+    mesh.faceCorners = mesh.indices.size();
+    submesh.indexCount = mesh.indices.size() - submesh.firstIndex;
+    if (submesh.indexCount > 0) {
+        mesh.submeshes.push_back(submesh);
+    }
+
+    // Build the vertex arrays
+    const std::vector<Corner>& keys = table.GetKeys();
+    mesh.positions.resize(keys.size() * 3);
+    if (anyTexCoords) {
+        mesh.texCoords.assign(keys.size() * 2, 0.0f);
+    }
+    if (anyNormals) {
+        mesh.normals.assign(keys.size() * 3, 0.0f);
+    }
+    for (size_t vertex = 0; vertex < keys.size(); ++vertex) {
+        const Corner& key = keys[vertex];
+        std::memcpy(&mesh.positions[vertex * 3], &positions[static_cast<size_t>(key.v) * 3], 3 * sizeof(float));
+        if (anyTexCoords && key.t != MISSING) {
+            std::memcpy(&mesh.texCoords[vertex * 2], &texCoords[static_cast<size_t>(key.t) * 2], 2 * sizeof(float));
+        }
+        if (anyNormals && key.n != MISSING) {
+            std::memcpy(&mesh.normals[vertex * 3], &normals[static_cast<size_t>(key.n) * 3], 3 * sizeof(float));
+        }
+    }
+
+    if (!mesh.positions.empty()) {
+        float bounds[6] = { mesh.positions[0], mesh.positions[1], mesh.positions[2],
+                            mesh.positions[0], mesh.positions[1], mesh.positions[2] };
+        for (size_t i = 0; i < mesh.positions.size(); i += 3) {
+            for (int k = 0; k < 3; ++k) {
+                float value = mesh.positions[i + k];
+                bounds[k] = value < bounds[k] ? value : bounds[k];
+                bounds[3 + k] = value > bounds[3 + k] ? value : bounds[3 + k];
+            }
+        }
+        mesh.boundsMin = Vector3(bounds[0], bounds[1], bounds[2]);
+        mesh.boundsMax = Vector3(bounds[3], bounds[4], bounds[5]);
+    }
+
+    if (badLines > 0) {
+        std::cerr << "Warning: Skipped " << badLines << " malformed line(s) in " << sourceName << std::endl;
+    }
+    if (droppedTriangles > 0) {
+        std::cerr << "Warning: Skipped " << droppedTriangles << " triangle(s) with out of range indices in "
+                  << sourceName << std::endl;
+    }
+    return true;
+}
+
+bool ObjLoader::LoadMaterials(const std::string& path, std::map<std::string, ObjMaterial>& materials) {
+    MappedFile file;
+    if (!file.Open(path)) {
+        std::cerr << "Warning: Could not open material file " << path << std::endl;
+        return false;
+    }
+
+    const char* p = reinterpret_cast<const char*>(file.GetData());
+    const char* end = p + file.GetSize();
+    ObjMaterial* current = nullptr;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+
+        const char* line = p;
+        std::string keyword = ReadWord(line, lineEnd);
+        if (keyword == "newmtl") {
+            current = &materials[ReadRest(line, lineEnd)];
+        } else if (keyword == "Kd" && current) {
+            std::vector<float> color;
+            if (ParseFloats(line, lineEnd, 3, 3, color)) {
+                current->diffuse = Vector3(color[0], color[1], color[2]);
+            }
+        } else if (keyword == "map_Kd" && current) {
+            // Options such as "-s 1 1 1" come before the file name
+            std::string word;
+            while (true) {
+                std::string next = ReadWord(line, lineEnd);
+                if (next.empty()) {
+                    break;
+                }
+                word = next;
+            }
+            current->diffuseMap = word;
+        }
+
+        p = lineEnd + 1;
+    }
+    return true;
+}
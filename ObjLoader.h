@@ -0,0 +1,85 @@
+#ifndef OBJ_LOADER_H
+#define OBJ_LOADER_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+#include "Vector3.h"
+
+// Range of triangles drawn with one material
+struct ObjSubmesh {
+    std::string material;   // usemtl name, empty before the first usemtl
+    size_t firstIndex = 0;
+    size_t indexCount = 0;
+};
+
+// Coarser version of a whole mesh, drawn from the same vertices
+struct ObjMeshLod {
+    size_t firstIndex = 0;  // into ObjMeshData::lodIndices
+    size_t indexCount = 0;
+    float error = 0.0f;     // distance from the full mesh, in mesh units
+};
+
+// Indexed triangle mesh read from a Wavefront OBJ file. Every distinct
+// position/uv/normal combination used by a face corner becomes one vertex,
+// so shared corners are stored once and referenced through indices.
+struct ObjMeshData {
+    std::vector<float> positions;       // xyz per vertex
+    std::vector<float> normals;         // xyz per vertex, empty if the file has none
+    std::vector<float> texCoords;       // uv per vertex, empty if the file has none
+    std::vector<unsigned int> indices;  // three per triangle
+
+    std::vector<std::string> materialLibraries; // mtllib names, relative to the OBJ
+    std::string material;                       // last usemtl in the file
+    std::vector<ObjSubmesh> submeshes;          // index ranges in usemtl order
+
+    // Simplified levels of detail, finest first, filled in on import
+    std::vector<unsigned int> lodIndices;
+    std::vector<ObjMeshLod> lods;
+
+    // Axis-aligned bounds of the positions, zero for an empty mesh
+    Vector3 boundsMin;
+    Vector3 boundsMax;
+
+    size_t faceCorners = 0; // triangle corners before deduplication
+
+    size_t GetVertexCount() const { return positions.size() / 3; }
+    size_t GetTriangleCount() const { return indices.size() / 3; }
+};
+
+// Material from an MTL file
+struct ObjMaterial {
+    Vector3 diffuse = Vector3(1.0f, 1.0f, 1.0f); // Kd
+    std::string diffuseMap;                        // map_Kd, relative to the MTL
+};
+
+// OBJ/MTL reader.
+//
+// The file is memory-mapped and split into line-aligned chunks that are
+// parsed on separate threads. Faces are fan-triangulated, negative
+// (relative) indices are resolved once every chunk's element counts are
+// known, and the corners are then deduplicated through a hash table.
+//
+//     ObjMeshData mesh;
+//     if (ObjLoader::Load("Assets/Models/crate.obj", mesh)) {
+//         // mesh.positions / mesh.indices ...
+//     }
+class ObjLoader {
+public:
+    // Load an OBJ file. threadCount 0 uses one thread per core; small files
+    // are always parsed on the calling thread.
+    static bool Load(const std::string& path, ObjMeshData& mesh, unsigned int threadCount = 0);
+
+    // Parse OBJ text already in memory; sourceName is used in messages
+    static bool Parse(const char* text, size_t length, ObjMeshData& mesh,
+                      const std::string& sourceName, unsigned int threadCount = 0);
+
+    // Read the materials of an MTL file, keyed by name
+    static bool LoadMaterials(const std::string& path, std::map<std::string, ObjMaterial>& materials);
+
+    // Bytes of OBJ text each parsing thread gets at least
+    static const size_t MIN_CHUNK_SIZE = 256 * 1024;
+};
+
+#endif // OBJ_LOADER_H
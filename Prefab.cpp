@@ -1,109 +1,295 @@
-#include "ThirdParty/OpenGL/include/GL/gl_definitions.h"
-#include <GL/glu.h>
-#include <windows.h>
-#include "Vector3.h"
-#include"Matrix4x4.h"
-#include<vector>
-#include"Triangle.h"
-#include"PointLight.h"
-#include"Face.h"
-#include <fstream>
-#include<string>
-#include <sstream>
-#include<math.h>
-#include<iostream>
-#include <cstdlib>
-#include <ctime>
-#include <chrono>
-#include <memory>
-#include <cmath>
-#include <thread>
+#include "Prefab.h"
+#include "Model.h"
+#include "MonoBehaviourLike.h"
 #include <algorithm>
-#include"Model.h"
-#include"MonobEhaviourLike.h"
-#include"GameObject.h"
-class Prefab
-{
-public:
-    std::vector<GameObject*> childGameObjects;
-    std::string name;
+#include <iostream>
 
-    std::vector<Model*> meshes;
-    Model* mainMesh;
-    std::vector<PointLight*> lights;
+Prefab::Prefab()
+    : name("Unnamed"), mainMesh(nullptr), generation(0), compiled(false)
+{
+}
 
-    Prefab()
-        : name("Unnamed"), mainMesh(nullptr)
-    {
+Prefab::~Prefab()
+{
+    for (auto& entry : instanceByRoot) {
+        Instance* instance = entry.second;
+        for (GameObject& node : instance->nodes) {
+            node.Shutdown();
+        }
+        delete instance;
     }
+}
 
-    void AddChild(GameObject* child)
-    {
+void Prefab::AddChild(GameObject* child)
+{
+    if (child) {
         childGameObjects.push_back(child);
+        compiled = false;
     }
+}
 
-    void AddMesh(Model* mesh)
-    {
-        if (mainMesh == nullptr)
-            mainMesh = mesh;
-        meshes.push_back(mesh);
-    }
+void Prefab::AddMesh(Model* mesh)
+{
+    if (mainMesh == nullptr)
+        mainMesh = mesh;
+    meshes.push_back(mesh);
+    compiled = false;
+}
 
-    void AddLight(PointLight* light)
-    {
+void Prefab::AddLight(PointLight* light)
+{
+    if (light) {
         lights.push_back(light);
+        compiled = false;
     }
+}
 
-    // Game object manipulation methods
-    void Move(const Vector3& position)
-    {
-        for (auto& child : childGameObjects) {
-            child->transform.position += position;
-        }
+void Prefab::AddComponent(ComponentFactory factory)
+{
+    if (factory) {
+        componentFactories.push_back(factory);
+        compiled = false;
     }
+}
 
-    void Rotate(const Vector3& rotation)
-    {
-        for (auto& child : childGameObjects) {
-            child->transform.rotation += rotation;
-        }
+// Game object manipulation methods
+void Prefab::Move(const Vector3& position)
+{
+    for (auto& child : childGameObjects) {
+        child->position = child->position + position;
+        child->MarkDirty(GameObject::DIRTY_TRANSFORM);
     }
+    compiled = false;
+}
 
-    void Resize(const Vector3& scale)
-    {
-        for (auto& child : childGameObjects) {
-            child->transform.scale *= scale;
-        }
+void Prefab::Rotate(const Vector3& rotation)
+{
+    for (auto& child : childGameObjects) {
+        child->rotation = child->rotation + rotation;
+        child->MarkDirty(GameObject::DIRTY_TRANSFORM);
     }
+    compiled = false;
+}
 
-    GameObject* Instantiate(const Vector3& position, const Vector3& rotation = Vector3(0, 0, 0), const Vector3& scale = Vector3(1, 1, 1))
-    {
-        GameObject* newObject = new GameObject();
-        newObject->transform.position = position;
-        newObject->transform.rotation = rotation;
-        newObject->transform.scale = scale;
-        
-        // Copy meshes
-        for (auto mesh : meshes) {
-            newObject->AddMesh(mesh);
+void Prefab::Resize(const Vector3& scale)
+{
+    for (auto& child : childGameObjects) {
+        child->size = Vector3(child->size.x * scale.x, child->size.y * scale.y, child->size.z * scale.z);
+        child->MarkDirty(GameObject::DIRTY_TRANSFORM);
+    }
+    compiled = false;
+}
+
+void Prefab::Compile()
+{
+    nodeTable.clear();
+    fixups.clear();
+    nameTable.clear();
+    meshTable.clear();
+    lightTable.clear();
+    directionalLightTable.clear();
+
+    // The root node is the prefab itself
+    NodeRecord root;
+    root.position = Vector3(0, 0, 0);
+    root.rotation = Vector3(0, 0, 0);
+    root.size = Vector3(1, 1, 1);
+    root.nameIndex = nameTable.size();
+    nameTable.push_back(name);
+    root.firstMesh = meshTable.size();
+    meshTable.insert(meshTable.end(), meshes.begin(), meshes.end());
+    root.meshCount = meshes.size();
+    root.firstLight = lightTable.size();
+    for (PointLight* light : lights) {
+        lightTable.push_back(*light);
+    }
+    root.lightCount = lights.size();
+    root.firstDirectionalLight = 0;
+    root.directionalLightCount = 0;
+    root.enabled = true;
+    nodeTable.push_back(root);
+
+    for (GameObject* child : childGameObjects) {
+        FlattenNode(child, 0);
+    }
+
+    // Idle instances have the old layout; live ones are deleted when returned
+    for (Instance* instance : freeList) {
+        instanceByRoot.erase(&instance->nodes[0]);
+        for (GameObject& node : instance->nodes) {
+            node.Shutdown();
         }
-        
-        // Copy lights
-        for (auto light : lights) {
-            PointLight* newLight = new PointLight(*light);
-            newObject->AddLight(newLight);
+        delete instance;
+    }
+    freeList.clear();
+
+    generation++;
+    compiled = true;
+}
+
+void Prefab::FlattenNode(GameObject* node, size_t parent)
+{
+    if (!node) {
+        return;
+    }
+
+    NodeRecord record;
+    record.position = node->position;
+    record.rotation = node->rotation;
+    record.size = node->size;
+    record.nameIndex = nameTable.size();
+    nameTable.push_back(node->GetName());
+    record.firstMesh = meshTable.size();
+    meshTable.insert(meshTable.end(), node->meshes.begin(), node->meshes.end());
+    record.meshCount = node->meshes.size();
+    record.firstLight = lightTable.size();
+    lightTable.insert(lightTable.end(), node->lights.begin(), node->lights.end());
+    record.lightCount = node->lights.size();
+    record.firstDirectionalLight = directionalLightTable.size();
+    directionalLightTable.insert(directionalLightTable.end(), node->directionalLights.begin(), node->directionalLights.end());
+    record.directionalLightCount = node->directionalLights.size();
+    record.enabled = node->IsEnabled();
+
+    size_t index = nodeTable.size();
+    nodeTable.push_back(record);
+
+    Fixup fixup;
+    fixup.parent = parent;
+    fixup.child = index;
+    fixups.push_back(fixup);
+
+    for (GameObject* child : node->childGameObjects) {
+        FlattenNode(child, index);
+    }
+}
+
+Prefab::Instance* Prefab::CreateInstance()
+{
+    Instance* instance = new Instance();
+    instance->nodes.resize(nodeTable.size());
+    instance->generation = generation;
+    instance->active = false;
+
+    for (size_t i = 0; i < nodeTable.size(); i++) {
+        instance->nodes[i].SetName(nameTable[nodeTable[i].nameIndex]);
+    }
+
+    // Components are constructed once per pooled instance
+    GameObject& root = instance->nodes[0];
+    for (ComponentFactory& factory : componentFactories) {
+        root.AddComponent(factory());
+    }
+
+    instanceByRoot[&root] = instance;
+    return instance;
+}
+
+void Prefab::ApplyTemplate(Instance* instance)
+{
+    // Every container below keeps its capacity across reuse, so after the
+    // first spawn this is a straight copy of the template tables
+    for (size_t i = 0; i < nodeTable.size(); i++) {
+        const NodeRecord& record = nodeTable[i];
+        GameObject& node = instance->nodes[i];
+
+        node.position = record.position;
+        node.rotation = record.rotation;
+        node.size = record.size;
+        node.MarkDirty(GameObject::DIRTY_TRANSFORM);
+        node.SetEnabled(record.enabled);
+
+        node.meshes.assign(meshTable.begin() + record.firstMesh,
+                           meshTable.begin() + record.firstMesh + record.meshCount);
+        node.lights.assign(lightTable.begin() + record.firstLight,
+                           lightTable.begin() + record.firstLight + record.lightCount);
+        node.directionalLights.assign(directionalLightTable.begin() + record.firstDirectionalLight,
+                                      directionalLightTable.begin() + record.firstDirectionalLight + record.directionalLightCount);
+        node.childGameObjects.clear();
+    }
+
+    for (const Fixup& fixup : fixups) {
+        instance->nodes[fixup.parent].childGameObjects.push_back(&instance->nodes[fixup.child]);
+    }
+}
+
+void Prefab::Prewarm(size_t count)
+{
+    if (!compiled) {
+        Compile();
+    }
+
+    while (freeList.size() < count) {
+        freeList.push_back(CreateInstance());
+    }
+}
+
+GameObject* Prefab::Instantiate(const Vector3& position, const Vector3& rotation, const Vector3& scale)
+{
+    if (!compiled) {
+        Compile();
+    }
+
+    Instance* instance;
+    bool reused = !freeList.empty();
+    if (reused) {
+        instance = freeList.back();
+        freeList.pop_back();
+    } else {
+        instance = CreateInstance();
+    }
+
+    ApplyTemplate(instance);
+    instance->active = true;
+
+    GameObject& root = instance->nodes[0];
+    root.position = position;
+    root.rotation = rotation;
+    root.size = scale;
+    root.MarkDirty(GameObject::DIRTY_TRANSFORM);
+
+    if (reused) {
+        for (GameObject& node : instance->nodes) {
+            node.SendEnableMessage(true);
         }
-        
-        return newObject;
     }
 
-    void Destroy(GameObject* gameObject)
-    {
-        // Remove from child list
-        auto it = std::find(childGameObjects.begin(), childGameObjects.end(), gameObject);
-        if (it != childGameObjects.end()) {
-            childGameObjects.erase(it);
-            delete gameObject;
+    return &root;
+}
+
+void Prefab::Destroy(GameObject* gameObject)
+{
+    auto it = instanceByRoot.find(gameObject);
+    if (it == instanceByRoot.end()) {
+        std::cerr << "Prefab '" << name << "': Destroy called with an object it does not own" << std::endl;
+        return;
+    }
+
+    Instance* instance = it->second;
+    if (!instance->active) {
+        return;
+    }
+    instance->active = false;
+
+    // Instances compiled against an older template are not reused
+    if (instance->generation != generation) {
+        instanceByRoot.erase(it);
+        for (GameObject& node : instance->nodes) {
+            node.SendEnableMessage(false);
+            node.Shutdown();
         }
+        delete instance;
+        return;
     }
-};        
\ No newline at end of file
+
+    // Disabled now, so pooled components run no scripts until re-spawned
+    for (GameObject& node : instance->nodes) {
+        node.SetEnabled(false);
+        node.SendEnableMessage(false);
+    }
+    freeList.push_back(instance);
+}
+
+bool Prefab::Owns(GameObject* gameObject) const
+{
+    return instanceByRoot.find(gameObject) != instanceByRoot.end();
+}
@@ -1,6 +1,35 @@
+#ifndef PREFAB_H
+#define PREFAB_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <cstddef>
+#include "Vector3.h"
+#include "PointLight.h"
+#include "DirectionalLight.h"
+#include "GameObject.h"
+
+class Model;
+class MonoBehaviourLike;
+
+// Reusable GameObject hierarchy.
+//
+// The prefab is built from its meshes, lights and child objects, then
+// compiled into a flat template: a table of plain node records (transform,
+// ranges into shared mesh/light tables) plus a fixup table that links the
+// nodes of an instance into a hierarchy. Instances live in a per-prefab pool.
+// Instantiate() copies the records over an idle pooled instance and
+// Destroy() hands it back, so steady-state spawning does not allocate.
+//
+// The prefab owns every instance it hands out and must outlive them.
 class Prefab
 {
 public:
+    typedef std::function<std::shared_ptr<MonoBehaviourLike>()> ComponentFactory;
+
     std::vector<GameObject*> childGameObjects;
     std::string name;
 
@@ -8,15 +37,88 @@ public:
     Model* mainMesh;
     std::vector<PointLight*> lights;
 
-    Prefab()
-        : name("Unnamed"), mainMesh(nullptr)
-    {
-    }
+    Prefab();
+    ~Prefab();
 
     void AddChild(GameObject* child);
     void AddMesh(Model* mesh);
 
     void AddLight(PointLight* light);
 
-    // Other methods for manipulating the game object...
-};  
\ No newline at end of file
+    // Components attached to the root of every instance. Called once per
+    // pooled instance; they get OnDisable when destroyed and OnEnable when reused.
+    void AddComponent(ComponentFactory factory);
+
+    // Template manipulation (takes effect on the next compile)
+    void Move(const Vector3& position);
+    void Rotate(const Vector3& rotation);
+    void Resize(const Vector3& scale);
+
+    // Flatten the template. Done lazily by Instantiate; call it explicitly
+    // after editing the template. Idle pooled instances are discarded.
+    void Compile();
+    bool IsCompiled() const { return compiled; }
+
+    // Fill the pool ahead of time so the first spawns do not allocate
+    void Prewarm(size_t count);
+
+    // Take an instance from the pool (growing it if empty)
+    GameObject* Instantiate(const Vector3& position, const Vector3& rotation = Vector3(0, 0, 0), const Vector3& scale = Vector3(1, 1, 1));
+
+    // Return an instance to the pool. The caller removes it from the scene.
+    void Destroy(GameObject* gameObject);
+
+    // True if the object is the root of an instance of this prefab
+    bool Owns(GameObject* gameObject) const;
+
+    size_t GetActiveCount() const { return instanceByRoot.size() - freeList.size(); }
+    size_t GetPooledCount() const { return freeList.size(); }
+
+private:
+    // One node of the flattened hierarchy; node 0 is the root
+    struct NodeRecord {
+        Vector3 position;
+        Vector3 rotation;
+        Vector3 size;
+        size_t nameIndex;
+        size_t firstMesh, meshCount;
+        size_t firstLight, lightCount;
+        size_t firstDirectionalLight, directionalLightCount;
+        bool enabled;
+    };
+
+    // Link node `child` under node `parent` inside an instance
+    struct Fixup {
+        size_t parent;
+        size_t child;
+    };
+
+    // All objects of one instance, allocated as one block
+    struct Instance {
+        std::vector<GameObject> nodes;
+        unsigned int generation;
+        bool active;
+    };
+
+    std::vector<NodeRecord> nodeTable;
+    std::vector<Fixup> fixups;
+    std::vector<std::string> nameTable;
+    std::vector<Model*> meshTable;
+    std::vector<PointLight> lightTable;
+    std::vector<DirectionalLight> directionalLightTable;
+    std::vector<ComponentFactory> componentFactories;
+
+    std::unordered_map<GameObject*, Instance*> instanceByRoot;
+    std::vector<Instance*> freeList;
+    unsigned int generation;
+    bool compiled;
+
+    void FlattenNode(GameObject* node, size_t parent);
+    Instance* CreateInstance();
+    void ApplyTemplate(Instance* instance);
+
+    Prefab(const Prefab&);
+    Prefab& operator=(const Prefab&);
+};
+
+#endif // PREFAB_H
@@ -1,5 +1,6 @@
 #include "ProjectSettings.h"
 #include "../ThirdParty/json/json.hpp"
+#include "../JsonStreamReader.h"
 #include <fstream>
 #include <iostream>
 #include <sys/stat.h>
@@ -68,74 +69,133 @@ ProjectSettings::ProjectSettings()
 
 // Load project settings from JSON file
 bool ProjectSettings::LoadFromFile(const std::string& filePath) {
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << filePath << std::endl;
-        return false;
-    }
-    
-    try {
-        json j;
-        file >> j;
-        
-        projectName = j["projectName"];
-        engineVersion = j["engineVersion"];
-        
-        // Load build settings
-        buildSettings.debugSymbols = j["buildSettings"]["debugSymbols"];
-        buildSettings.optimization = j["buildSettings"]["optimization"];
-        buildSettings.targetPlatforms = j["buildSettings"]["targetPlatforms"].get<std::vector<std::string>>();
-        buildSettings.outputDirectory = j["buildSettings"]["outputDirectory"];
-        
-        // Load physics settings
-        engineSettings.physics.fixedTimeStep = j["engineSettings"]["physics"]["fixedTimeStep"];
-        engineSettings.physics.gravity = j["engineSettings"]["physics"]["gravity"];
-        engineSettings.physics.enableCollisions = j["engineSettings"]["physics"]["enableCollisions"];
-        
-        // Load rendering settings
-        engineSettings.rendering.targetFPS = j["engineSettings"]["rendering"]["targetFPS"];
-        engineSettings.rendering.vsync = j["engineSettings"]["rendering"]["vsync"];
-        engineSettings.rendering.msaa = j["engineSettings"]["rendering"]["msaa"];
-        engineSettings.rendering.shadows = j["engineSettings"]["rendering"]["shadows"];
-        
-        // Load network settings if they exist
-        if (j["engineSettings"].contains("network")) {
-            engineSettings.network.enableNetworking = j["engineSettings"]["network"]["enableNetworking"];
-            engineSettings.network.defaultServerAddress = j["engineSettings"]["network"]["defaultServerAddress"];
-            engineSettings.network.defaultServerPort = j["engineSettings"]["network"]["defaultServerPort"];
-            engineSettings.network.enablePacketLogging = j["engineSettings"]["network"]["enablePacketLogging"];
-            engineSettings.network.simulatedLatency = j["engineSettings"]["network"]["simulatedLatency"];
-            engineSettings.network.simulatedPacketLoss = j["engineSettings"]["network"]["simulatedPacketLoss"];
-            engineSettings.network.preferP2P = j["engineSettings"]["network"]["preferP2P"];
+    // Reads the settings file as a stream, mapping each value by its path
+    // ("engineSettings.physics.gravity") onto copies of the current
+    // settings. Keys missing from the file keep their current values.
+    class SettingsReader : public JsonStreamReader {
+    public:
+        std::string projectName;
+        std::string engineVersion;
+        BuildSettings build;
+        EngineSettings engine;
+        std::map<std::string, std::string> assets;
+
+    protected:
+        bool OnBeginArray() override {
+            if (Path() == "buildSettings.targetPlatforms") {
+                build.targetPlatforms.clear();
+            }
+            return true;
         }
-        
-        // Load audio settings if they exist
-        if (j["engineSettings"].contains("audio")) {
-            engineSettings.audio.masterVolume = j["engineSettings"]["audio"]["masterVolume"];
-            engineSettings.audio.sampleRate = j["engineSettings"]["audio"]["sampleRate"];
-            engineSettings.audio.channels = j["engineSettings"]["audio"]["channels"];
-            engineSettings.audio.enableAudio = j["engineSettings"]["audio"]["enableAudio"];
+
+        bool OnString(const std::string& value) override {
+            std::string path = Path();
+            if (path == "projectName") {
+                projectName = value;
+            } else if (path == "engineVersion") {
+                engineVersion = value;
+            } else if (path == "buildSettings.targetPlatforms[]") {
+                build.targetPlatforms.push_back(value);
+            } else if (path == "buildSettings.outputDirectory") {
+                build.outputDirectory = value;
+            } else if (path == "engineSettings.network.defaultServerAddress") {
+                engine.network.defaultServerAddress = value;
+            } else if (Depth() == 2 && KeyAt(0) == "assetPaths") {
+                assets[CurrentKey()] = value;
+            }
+            return true;
         }
-        
-        // Load navigation settings if they exist
-        if (j["engineSettings"].contains("navigation")) {
-            engineSettings.navigation.navMeshRefreshRate = j["engineSettings"]["navigation"]["navMeshRefreshRate"];
-            engineSettings.navigation.maxAngleDiff = j["engineSettings"]["navigation"]["maxAngleDiff"];
-            engineSettings.navigation.maxDist = j["engineSettings"]["navigation"]["maxDist"];
+
+        bool OnNumber(double value) override {
+            std::string path = Path();
+            if (path == "engineSettings.physics.fixedTimeStep") {
+                engine.physics.fixedTimeStep = static_cast<float>(value);
+            } else if (path == "engineSettings.physics.gravity") {
+                engine.physics.gravity = static_cast<float>(value);
+            } else if (path == "engineSettings.rendering.targetFPS") {
+                engine.rendering.targetFPS = static_cast<int>(value);
+            } else if (path == "engineSettings.rendering.msaa") {
+                engine.rendering.msaa = static_cast<int>(value);
+            } else if (path == "engineSettings.network.defaultServerPort") {
+                engine.network.defaultServerPort = static_cast<int>(value);
+            } else if (path == "engineSettings.network.simulatedLatency") {
+                engine.network.simulatedLatency = static_cast<float>(value);
+            } else if (path == "engineSettings.network.simulatedPacketLoss") {
+                engine.network.simulatedPacketLoss = static_cast<float>(value);
+            } else if (path == "engineSettings.audio.masterVolume") {
+                engine.audio.masterVolume = static_cast<float>(value);
+            } else if (path == "engineSettings.audio.sampleRate") {
+                engine.audio.sampleRate = static_cast<int>(value);
+            } else if (path == "engineSettings.audio.channels") {
+                engine.audio.channels = static_cast<int>(value);
+            } else if (path == "engineSettings.navigation.navMeshRefreshRate") {
+                engine.navigation.navMeshRefreshRate = static_cast<float>(value);
+            } else if (path == "engineSettings.navigation.maxAngleDiff") {
+                engine.navigation.maxAngleDiff = static_cast<float>(value);
+            } else if (path == "engineSettings.navigation.maxDist") {
+                engine.navigation.maxDist = static_cast<float>(value);
+            }
+            return true;
         }
-        
-        // Load asset paths
-        auto assetPathsJson = j["assetPaths"];
-        for (auto it = assetPathsJson.begin(); it != assetPathsJson.end(); ++it) {
-            assetPaths[it.key()] = it.value();
+
+        bool OnBool(bool value) override {
+            std::string path = Path();
+            if (path == "buildSettings.debugSymbols") {
+                build.debugSymbols = value;
+            } else if (path == "buildSettings.optimization") {
+                build.optimization = value;
+            } else if (path == "engineSettings.physics.enableCollisions") {
+                engine.physics.enableCollisions = value;
+            } else if (path == "engineSettings.rendering.vsync") {
+                engine.rendering.vsync = value;
+            } else if (path == "engineSettings.rendering.shadows") {
+                engine.rendering.shadows = value;
+            } else if (path == "engineSettings.network.enableNetworking") {
+                engine.network.enableNetworking = value;
+            } else if (path == "engineSettings.network.enablePacketLogging") {
+                engine.network.enablePacketLogging = value;
+            } else if (path == "engineSettings.network.preferP2P") {
+                engine.network.preferP2P = value;
+            } else if (path == "engineSettings.audio.enableAudio") {
+                engine.audio.enableAudio = value;
+            }
+            return true;
         }
-        
-        std::cout << "Successfully loaded project settings from " << filePath << std::endl;
-        return true;
-    } catch (const std::exception& e) {
-        std::cerr << "Error loading project settings: " << e.what() << std::endl;
+
+    private:
+        // Dotted path of the current value; array elements end in "[]"
+        std::string Path() const {
+            std::string path;
+            for (size_t i = 0; i < Depth(); i++) {
+                if (i > 0 && KeyAt(i) != "[]") {
+                    path += '.';
+                }
+                path += KeyAt(i);
+            }
+            return path;
+        }
+    };
+
+    SettingsReader reader;
+    reader.projectName = projectName;
+    reader.engineVersion = engineVersion;
+    reader.build = buildSettings;
+    reader.engine = engineSettings;
+    reader.assets = assetPaths;
+
+    if (!reader.ParseFile(filePath)) {
         return false;
     }
+
+    // Only apply the settings once the whole file has been read
+    projectName = reader.projectName;
+    engineVersion = reader.engineVersion;
+    buildSettings = reader.build;
+    engineSettings = reader.engine;
+    assetPaths = reader.assets;
+
+    std::cout << "Successfully loaded project settings from " << filePath << std::endl;
+    return true;
 }
 
 // Save project settings to JSON file
@@ -423,6 +483,10 @@ void ProjectSettings::SetAssetPath(const std::string& type, const std::string& p
     assetPaths[type] = path;
 }
 
+const std::map<std::string, std::string>& ProjectSettings::GetAssetPaths() const {
+    return assetPaths;
+}
+
 // Navigation settings getters and setters
 float ProjectSettings::GetNavMeshRefreshRate() const {
     return engineSettings.navigation.navMeshRefreshRate;
@@ -161,6 +161,9 @@ public:
     
     std::string GetAssetPath(const std::string& type) const;
     void SetAssetPath(const std::string& type, const std::string& path);
+    
+    // Every asset folder, keyed by asset type
+    const std::map<std::string, std::string>& GetAssetPaths() const;
 };
 
 #endif // PROJECT_SETTINGS_H
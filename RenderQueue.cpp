@@ -0,0 +1,223 @@
+#include "RenderQueue.h"
+#include "Model.h"
+#include "Graphics/Core/IGraphicsAPI.h"
+#include "Shaders/Core/ShaderUniforms.h"
+#include <cstring>
+
+namespace {
+    const uint64_t PROGRAM_MASK = (1u << 13) - 1;
+    const uint64_t TEXTURE_MASK = (1u << 12) - 1;
+    const uint64_t VERTEX_ARRAY_MASK = (1u << 12) - 1;
+    const uint64_t DEPTH_MASK = (1u << 24) - 1;
+
+    // 24 bits that order like the distance. The bits of a non-negative
+    // float already sort like its value; the top 24 of its 31 are kept.
+    uint64_t QuantizeDepth(float depth) {
+        if (!(depth > 0.0f)) {
+            return 0;
+        }
+        uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(bits));
+        return (bits >> 7) & DEPTH_MASK;
+    }
+}
+
+bool RenderQueue::Add(Model* model, float depth, int layer) {
+    if (!model || !model->GetShaderProgram() || model->GetVertexArray() == 0) {
+        return false;
+    }
+
+    Pass pass = model->IsTransparent() ? TRANSPARENT_PASS : OPAQUE_PASS;
+    DrawPacket packet;
+    packet.key = MakeKey(layer, pass, model->GetShaderProgram()->GetHandle(), model->GetTextureId(),
+                         model->GetVertexArray(), depth);
+    packet.model = model;
+    packet.lodLevel = model->GetLodLevel();
+    packet.lodFade = model->GetLodFade();
+    packets.push_back(packet);
+    return true;
+}
+
+void RenderQueue::Sort() {
+    RadixSort(packets, scratch);
+}
+
+void RenderQueue::Submit(IGraphicsAPI* graphics) {
+    stats = Stats();
+    if (!graphics || packets.empty()) {
+        return;
+    }
+
+    // Camera, time and lights are the same for every draw
+    ShaderUniforms::GetInstance().Upload(graphics);
+
+    bool instancing = instancingEnabled && graphics->SupportsInstancing();
+    ShaderProgram* program = nullptr;
+    unsigned int texture = 0;
+    unsigned int vertexArray = 0;
+    for (size_t i = 0; i < packets.size();) {
+        const DrawPacket& packet = packets[i];
+        Model* model = packet.model;
+
+        // Repeats of the model right after it draw along with it
+        size_t end = instancing ? FindInstanceRun(i) : i + 1;
+        bool instanced = end - i >= MIN_INSTANCES;
+        ShaderProgram* modelProgram = instanced ? model->GetShaderProgram()->GetInstancedVariant()
+                                                : model->GetShaderProgram();
+
+        if (modelProgram != program) {
+            program = modelProgram;
+            graphics->UseShaderProgram(program);
+            program->SetSharedUniforms();
+            stats.programBinds++;
+        }
+
+        // Models without a texture sample whatever is bound, as Render does
+        unsigned int modelTexture = model->GetTextureId();
+        if (modelTexture != 0 && modelTexture != texture) {
+            texture = modelTexture;
+            graphics->BindTexture(texture, 0);
+            stats.textureBinds++;
+        }
+
+        if (model->GetVertexArray() != vertexArray) {
+            vertexArray = model->GetVertexArray();
+            graphics->BindVertexArray(vertexArray);
+            stats.vertexArrayBinds++;
+        }
+
+        if (instanced) {
+            DrawInstances(graphics, i, end);
+        } else {
+            // The same model can be queued twice at different levels while
+            // they crossfade
+            model->SetLod(packet.lodLevel, packet.lodFade);
+            model->Draw(graphics);
+            stats.draws++;
+        }
+        i = end;
+    }
+
+    graphics->BindVertexArray(0);
+}
+
+void RenderQueue::ReleaseBuffers(IGraphicsAPI* graphics) {
+    if (graphics && instanceBuffer != 0) {
+        graphics->DeleteBuffer(instanceBuffer);
+    }
+    instanceBuffer = 0;
+}
+
+size_t RenderQueue::FindInstanceRun(size_t begin) const {
+    const DrawPacket& first = packets[begin];
+    const Model* model = first.model;
+    if (!model->GetShaderProgram()->GetInstancedVariant()) {
+        return begin + 1;
+    }
+
+    // One vertex array holds one mesh, so equal arrays and levels draw the
+    // same indices
+    size_t end = begin + 1;
+    while (end < packets.size()) {
+        const DrawPacket& next = packets[end];
+        if (next.model->GetShaderProgram() != model->GetShaderProgram() ||
+            next.model->GetTextureId() != model->GetTextureId() ||
+            next.model->GetVertexArray() != model->GetVertexArray() ||
+            next.lodLevel != first.lodLevel || next.lodFade != first.lodFade) {
+            break;
+        }
+        end++;
+    }
+    return end;
+}
+
+void RenderQueue::DrawInstances(IGraphicsAPI* graphics, size_t begin, size_t end) {
+    const size_t floatsPerInstance = 16;
+    instanceData.resize((end - begin) * floatsPerInstance);
+    float* instance = instanceData.data();
+    for (size_t i = begin; i < end; i++) {
+        // Laid out as the model uniform is uploaded, a column per attribute
+        Matrix4x4 modelMatrix = packets[i].model->GetModelMatrix();
+        std::memcpy(instance, &modelMatrix.elements[0][0], floatsPerInstance * sizeof(float));
+        instance += floatsPerInstance;
+    }
+
+    if (instanceBuffer == 0) {
+        instanceBuffer = graphics->CreateBuffer();
+    }
+    graphics->BindBuffer(BufferType::VERTEX_BUFFER, instanceBuffer);
+    graphics->BufferData(BufferType::VERTEX_BUFFER, instanceData.data(), instanceData.size() * sizeof(float), true);
+    for (unsigned int column = 0; column < 4; column++) {
+        graphics->VertexAttribPointer(INSTANCE_ATTRIBUTE + column, 4, false, floatsPerInstance * sizeof(float),
+                                      reinterpret_cast<const void*>(column * 4 * sizeof(float)));
+        graphics->EnableVertexAttrib(INSTANCE_ATTRIBUTE + column);
+        graphics->VertexAttribDivisor(INSTANCE_ATTRIBUTE + column, 1);
+    }
+
+    const DrawPacket& first = packets[begin];
+    first.model->SetLod(first.lodLevel, first.lodFade);
+    first.model->DrawInstanced(graphics, static_cast<int>(end - begin));
+
+    // Draws of the vertex array without instancing leave these alone
+    for (unsigned int column = 0; column < 4; column++) {
+        graphics->DisableVertexAttrib(INSTANCE_ATTRIBUTE + column);
+    }
+
+    stats.draws++;
+    stats.instancedDraws++;
+    stats.instances += end - begin;
+}
+
+uint64_t RenderQueue::MakeKey(int layer, Pass pass, unsigned int program, unsigned int texture,
+                              unsigned int vertexArray, float depth) {
+    uint64_t key = static_cast<uint64_t>(layer & (LAYER_COUNT - 1)) << 62;
+    key |= static_cast<uint64_t>(pass) << 61;
+
+    uint64_t depthBits = QuantizeDepth(depth);
+    if (pass == TRANSPARENT_PASS) {
+        key |= (DEPTH_MASK - depthBits) << 37;
+        key |= (program & PROGRAM_MASK) << 24;
+        key |= (texture & TEXTURE_MASK) << 12;
+        key |= vertexArray & VERTEX_ARRAY_MASK;
+    } else {
+        key |= (program & PROGRAM_MASK) << 48;
+        key |= (texture & TEXTURE_MASK) << 36;
+        key |= (vertexArray & VERTEX_ARRAY_MASK) << 24;
+        key |= depthBits;
+    }
+    return key;
+}
+
+void RenderQueue::RadixSort(std::vector<DrawPacket>& packets, std::vector<DrawPacket>& scratch) {
+    if (packets.size() < 2) {
+        return;
+    }
+
+    // Bits that differ between keys; bytes without any are already sorted
+    uint64_t differing = 0;
+    for (const DrawPacket& packet : packets) {
+        differing |= packet.key ^ packets[0].key;
+    }
+
+    scratch.resize(packets.size());
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((differing >> shift) & 0xFF) == 0) {
+            continue;
+        }
+
+        size_t offsets[256] = {};
+        for (const DrawPacket& packet : packets) {
+            offsets[(packet.key >> shift) & 0xFF]++;
+        }
+        size_t total = 0;
+        for (size_t& offset : offsets) {
+            size_t count = offset;
+            offset = total;
+            total += count;
+        }
+        for (const DrawPacket& packet : packets) {
+            scratch[offsets[(packet.key >> shift) & 0xFF]++] = packet;
+        }
+        packets.swap(scratch);
+    }
+}
@@ -0,0 +1,123 @@
+#ifndef RENDER_QUEUE_H
+#define RENDER_QUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Model;
+class IGraphicsAPI;
+
+// Draws collected for one camera, sorted by a 64-bit key and submitted
+// with a state change only where consecutive draws differ.
+//
+//     queue.Clear();
+//     queue.Add(model, distanceToCamera);      // for every visible model
+//     queue.Sort();
+//     queue.Submit(graphics);
+//
+// Key, most significant bits first:
+//
+//     opaque:       layer:2 pass:1 program:13 texture:12 vertexArray:12 depth:24
+//     transparent:  layer:2 pass:1 depth:24 (inverted) program:13 texture:12 vertexArray:12
+//
+// Layers draw in order, and within a layer the opaque pass draws before
+// the transparent one. Opaque draws are grouped by program, texture and
+// vertex array so each is bound once per group, and front to back within
+// a group so the depth test rejects hidden fragments early. Transparent
+// draws have to blend over what is behind them, so they go back to front
+// whatever they bind. Handles wider than their field only make draws that
+// could have shared a bind land apart, never draw incorrectly: Submit
+// compares the actual state.
+//
+// Consecutive draws of the same mesh with the same program, texture and
+// level of detail are drawn as one instanced draw when the program has an
+// instanced variant (see ShaderProgram::GetInstancedVariant): their model
+// matrices go into a buffer read by attributes 3 to 6, one matrix per
+// instance. A forest of one tree mesh then costs one draw call instead of
+// one per tree, each with its own uniform upload.
+class RenderQueue {
+public:
+    enum Pass {
+        OPAQUE_PASS = 0,
+        TRANSPARENT_PASS = 1
+    };
+
+    static const int LAYER_COUNT = 4;
+
+    // Fewest consecutive draws worth an instanced draw
+    static const size_t MIN_INSTANCES = 2;
+
+    // First of the four attribute locations holding an instance's model
+    // matrix, one column each
+    static const unsigned int INSTANCE_ATTRIBUTE = 3;
+
+    struct DrawPacket {
+        uint64_t key;
+        Model* model;
+        size_t lodLevel;    // Level of detail and crossfade to draw at, see Model::SetLod
+        float lodFade;
+    };
+
+    // What the last Submit issued
+    struct Stats {
+        size_t draws = 0;               // Draw calls, an instanced draw counting once
+        size_t instancedDraws = 0;
+        size_t instances = 0;           // Models drawn by the instanced draws
+        size_t programBinds = 0;
+        size_t textureBinds = 0;
+        size_t vertexArrayBinds = 0;
+    };
+
+    // Queue a model at its current level of detail. depth is its distance
+    // from the camera. False, queueing nothing, if the model cannot draw yet.
+    bool Add(Model* model, float depth, int layer = 0);
+
+    // Order the packets by key; packets with equal keys keep their order
+    void Sort();
+
+    // Draw the packets in order, binding programs, textures and vertex
+    // arrays only when they change. Uploads the shared uniforms first.
+    void Submit(IGraphicsAPI* graphics);
+
+    // Drop the packets; their storage is kept for the next frame
+    void Clear() { packets.clear(); }
+
+    // Draw repeated models with instanced draws where the graphics API and
+    // their programs allow it; on by default
+    void SetInstancingEnabled(bool enabled) { instancingEnabled = enabled; }
+    bool IsInstancingEnabled() const { return instancingEnabled; }
+
+    // Delete the instance buffer Submit created on this graphics API
+    void ReleaseBuffers(IGraphicsAPI* graphics);
+
+    const std::vector<DrawPacket>& GetPackets() const { return packets; }
+    size_t GetSize() const { return packets.size(); }
+    const Stats& GetStats() const { return stats; }
+
+    // Sort key for a draw
+    static uint64_t MakeKey(int layer, Pass pass, unsigned int program, unsigned int texture,
+                            unsigned int vertexArray, float depth);
+
+    // Stable LSD radix sort on DrawPacket::key, a byte per pass; passes over
+    // bytes that are the same in every key are skipped
+    static void RadixSort(std::vector<DrawPacket>& packets, std::vector<DrawPacket>& scratch);
+
+private:
+    // End of the run of packets from begin that can share an instanced draw
+    size_t FindInstanceRun(size_t begin) const;
+
+    // Upload the model matrices of packets [begin, end) and draw them at once,
+    // with the instanced program, texture and vertex array bound
+    void DrawInstances(IGraphicsAPI* graphics, size_t begin, size_t end);
+
+    std::vector<DrawPacket> packets;
+    std::vector<DrawPacket> scratch;
+    Stats stats;
+
+    bool instancingEnabled = true;
+    unsigned int instanceBuffer = 0;
+    std::vector<float> instanceData;
+};
+
+#endif // RENDER_QUEUE_H
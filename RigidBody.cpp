@@ -1,5 +1,7 @@
 #include "RigidBody.h"
 #include "GameObject.h"
+#include "EventBus.h"
+#include "EngineEvents.h"
 #include <iostream>
 #include <algorithm>
 
@@ -126,9 +128,37 @@ void RigidBody::AddRelativeTorque(const Vector3& newTorque) {
 }
 
 void RigidBody::OnCollision(RigidBody* other, const CollisionInfo& info) {
-    // This is called by the physics system when a collision is detected
-    // We can use this to trigger the MonoBehaviourLike collision events
-    OnCollisionEnter();
+    // This is called by the physics system when a collision is detected.
+    // The event is queued and dispatched after the physics step, so
+    // listeners never re-enter the physics system.
+    CollisionPhase phase = CollisionPhase::STAY;
+    if (std::find(contacts.begin(), contacts.end(), other) == contacts.end()) {
+        contacts.push_back(other);
+        phase = CollisionPhase::ENTER;
+    }
+    touching.push_back(other);
+    
+    EventBus::GetInstance().Publish(CollisionEvent(this, other, info, phase));
+}
+
+void RigidBody::OnCollisionEnd(RigidBody* other) {
+    auto it = std::find(contacts.begin(), contacts.end(), other);
+    if (it == contacts.end()) {
+        return;
+    }
+    contacts.erase(it);
+    
+    EventBus::GetInstance().Publish(CollisionEvent(this, other, CollisionInfo(), CollisionPhase::EXIT));
+}
+
+void RigidBody::EndCollisionStep() {
+    for (size_t i = contacts.size(); i-- > 0;) {
+        RigidBody* other = contacts[i];
+        if (std::find(touching.begin(), touching.end(), other) == touching.end()) {
+            OnCollisionEnd(other);
+        }
+    }
+    touching.clear();
 }
 
 void RigidBody::Update(float deltaTime) {
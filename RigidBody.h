@@ -4,6 +4,7 @@
 #include "MonoBehaviourLike.h"
 #include "Vector3.h"
 #include "CollisionInfo.h"
+#include <vector>
 
 class GameObject;
 
@@ -91,9 +92,22 @@ public:
     // Add relative torque (in local space)
     void AddRelativeTorque(const Vector3& torque);
     
-    // Called when this rigid body collides with another
+    // Called when this rigid body collides with another. Publishes a
+    // CollisionEvent (ENTER or STAY) that is delivered at the next dispatch.
     void OnCollision(RigidBody* other, const CollisionInfo& info);
     
+    // Called when this rigid body stops touching another (publishes EXIT)
+    void OnCollisionEnd(RigidBody* other);
+    
+    // Called by the collision pass after it has reported the step's
+    // collisions: ends every contact OnCollision was not called for since
+    // the last step. The other body may have left the scene by then, so
+    // EXIT listeners should compare it, not dereference it.
+    void EndCollisionStep();
+    
+    // Bodies currently in contact with this one
+    const std::vector<RigidBody*>& GetContacts() const { return contacts; }
+    
     // Update physics
     virtual void Update(float deltaTime) override;
     
@@ -119,6 +133,12 @@ private:
     // The game object this rigid body is attached to
     GameObject* gameObject;
     
+    // Bodies we are touching, used to tell ENTER from STAY
+    std::vector<RigidBody*> contacts;
+    
+    // Bodies reported by OnCollision during the current step
+    std::vector<RigidBody*> touching;
+    
     // Calculate moment of inertia based on shape
     void CalculateInertiaTensor();
 };
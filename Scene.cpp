@@ -3,13 +3,42 @@
 #include <algorithm>
 #include <thread>
 #include <chrono>
+#include <unordered_set>
 #include "EngineCondition.h"
+#include "Coroutine.h"
+#include "EventBus.h"
+#include "EngineEvents.h"
+#include "RigidBody.h"
+#include "TriggerVolume.h"
+#include "WorldPartition.h"
+#include "SceneLoadOperation.h"
+#include "SceneSerializer.h"
+#include "JobSystem.h"
+#include "AssetStreamer.h"
+#include "Model.h"
+#include "LodGroup.h"
+#include "FrustumCuller.h"
+#include "Shaders/Core/ShaderUniforms.h"
 #include "Scene_includes.h"
 #include "platform.h"
 #include "Graphics/Core/GraphicsAPIFactory.h"
 
 // GameObject extensions included via GameObject.h
 
+// Create graphics buffers for meshes parsed off the main thread
+static void InitializeMeshBuffers(GameObject* gameObject) {
+    for (Model* mesh : gameObject->meshes) {
+        if (mesh && !mesh->HasBuffers()) {
+            mesh->InitializeBuffers();
+        }
+    }
+    for (GameObject* child : gameObject->childGameObjects) {
+        if (child) {
+            InitializeMeshBuffers(child);
+        }
+    }
+}
+
 void Scene::Initialize() {
     // Initialize time
     time = std::unique_ptr<TimeManager>(new TimeManager());
@@ -22,6 +51,9 @@ void Scene::Initialize() {
     // Initialize camera manager
     cameraManager = std::unique_ptr<CameraManager>(new CameraManager());
 
+    // Forward batched physics events to the MonoBehaviourLike hooks
+    SetLegacyEventHooksEnabled(legacyEventHooksEnabled);
+
     // Set running flag
     isRunning = true;
 
@@ -120,6 +152,8 @@ void Scene::AddGameObject(GameObject* gameObject) {
     if (it == gameObjects.end()) {
         // Add the game object to the scene
         gameObjects.push_back(gameObject);
+        gameObject->SetScene(this);
+        DropResetPoint();
 
         // Game object is already initialized via constructor
 
@@ -137,11 +171,138 @@ void Scene::RemoveGameObject(GameObject* gameObject) {
     if (it != gameObjects.end()) {
         // Remove the game object from the scene
         gameObjects.erase(it);
+        if (gameObject->GetScene() == this) {
+            gameObject->SetScene(nullptr);
+        }
+        DropResetPoint();
 
         std::cout << "Removed game object: " << gameObject->GetName() << std::endl;
     }
 }
 
+GameObject* Scene::FindGameObject(const std::string& name) const {
+    for (GameObject* gameObject : gameObjects) {
+        if (gameObject && gameObject->GetName() == name) {
+            return gameObject;
+        }
+    }
+    return nullptr;
+}
+
+void Scene::AddGameObjects(GameObject* const* objects, size_t count) {
+    gameObjects.reserve(gameObjects.size() + count);
+    for (size_t i = 0; i < count; i++) {
+        if (objects[i]) {
+            InitializeMeshBuffers(objects[i]);
+            gameObjects.push_back(objects[i]);
+            objects[i]->SetScene(this);
+        }
+    }
+    DropResetPoint();
+}
+
+void Scene::RemoveGameObjects(const std::vector<GameObject*>& objects) {
+    if (objects.empty()) {
+        return;
+    }
+
+    // One pass over the scene instead of one search per object
+    std::unordered_set<GameObject*> removed(objects.begin(), objects.end());
+    gameObjects.erase(std::remove_if(gameObjects.begin(), gameObjects.end(),
+                                     [&removed](GameObject* object) { return removed.count(object) != 0; }),
+                      gameObjects.end());
+    for (GameObject* object : objects) {
+        if (object && object->GetScene() == this) {
+            object->SetScene(nullptr);
+        }
+    }
+    DropResetPoint();
+}
+
+bool Scene::Load(const std::string& path) {
+    std::vector<GameObject*> objects;
+    if (!SceneSerializer::LoadSceneFile(path, objects)) {
+        SceneSerializer::DestroySceneObjects(objects);
+        return false;
+    }
+
+    AddGameObjects(objects.data(), objects.size());
+    loadedObjects.insert(loadedObjects.end(), objects.begin(), objects.end());
+    std::cout << "Loaded " << objects.size() << " objects from " << path << std::endl;
+    return true;
+}
+
+std::shared_ptr<SceneLoadOperation> Scene::LoadAsync(const std::string& path) {
+    std::shared_ptr<SceneLoadOperation> load = std::make_shared<SceneLoadOperation>(path);
+    pendingLoads.push_back(load);
+
+    // The job only sees the parse result, never the scene
+    std::shared_ptr<SceneLoadOperation::ParseResult> result = load->parseResult;
+    JobSystem::GetInstance().Submit([result, path]() {
+        std::vector<GameObject*> objects;
+        bool ok = SceneSerializer::LoadSceneFile(path, objects, &result->progress);
+
+        std::lock_guard<std::mutex> lock(result->mutex);
+        result->objects.swap(objects);
+        result->ok = ok;
+        result->complete = true;
+    });
+
+    return load;
+}
+
+void Scene::FinalizeLoads() {
+    if (pendingLoads.empty()) {
+        return;
+    }
+
+    // Callbacks run after the loop, so they can start new loads
+    std::vector<std::shared_ptr<SceneLoadOperation>> finished;
+    auto start = std::chrono::steady_clock::now();
+    bool outOfTime = false;
+
+    for (auto it = pendingLoads.begin(); it != pendingLoads.end() && !outOfTime;) {
+        SceneLoadOperation& load = **it;
+
+        if (load.GetStatus() == SceneLoadOperation::Status::PARSING && !load.CollectParseResult()) {
+            ++it;
+            continue;
+        }
+
+        if (load.GetStatus() == SceneLoadOperation::Status::FINALIZING) {
+            // One top-level object (and its children) at a time
+            size_t next = load.finalized;
+            while (next < load.objects.size()) {
+                InitializeMeshBuffers(load.objects[next]);
+                load.finalized = ++next;
+
+                float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+                if (elapsed >= loadBudgetMs) {
+                    break;
+                }
+            }
+
+            if (next < load.objects.size()) {
+                outOfTime = true;
+                continue;
+            }
+
+            // The scene only ever sees a complete load
+            AddGameObjects(load.objects.data(), load.objects.size());
+            loadedObjects.insert(loadedObjects.end(), load.objects.begin(), load.objects.end());
+            load.objects.clear();
+        }
+
+        finished.push_back(*it);
+        it = pendingLoads.erase(it);
+    }
+
+    for (auto& load : finished) {
+        load->Complete(load->GetStatus() == SceneLoadOperation::Status::FAILED ?
+                       SceneLoadOperation::Status::FAILED : SceneLoadOperation::Status::DONE);
+    }
+}
+
 void Scene::SetMainCamera(Camera* camera) {
     if (!camera) {
         return;
@@ -178,9 +339,25 @@ Vector3 Scene::GetGravity() const {
 // SetPhysicsTimeStep and GetPhysicsTimeStep are now inline in Scene.h
 
 void Scene::Update(float deltaTime) {
+    // Remember the starting state for Reset()
+    if (!resetSnapshot.IsValid()) {
+        SetResetPoint();
+    }
+
     // Update time
     time->Update();
 
+    // Stream world cells in and out around the camera
+    if (worldPartition && mainCamera) {
+        worldPartition->Update(mainCamera->GetPosition());
+    }
+
+    // Finish scenes loaded in the background
+    FinalizeLoads();
+
+    // Upload streamed assets within this frame's budget
+    AssetStreamer::GetInstance().Update();
+
     // Accumulate time for physics updates
     physicsAccumulator += deltaTime;
 
@@ -190,6 +367,11 @@ void Scene::Update(float deltaTime) {
         if (physicsSystem) {
             physicsSystem->Update(physicsTimeStep);
         }
+        DetectCollisions();
+
+        // Deliver the step's collision and trigger events in batches, after
+        // physics has finished so listeners cannot re-enter it
+        EventBus::GetInstance().Dispatch();
 
         // Update game objects with fixed timestep
         for (auto& gameObject : gameObjects) {
@@ -197,6 +379,9 @@ void Scene::Update(float deltaTime) {
             gameObject->UpdateComponents(physicsTimeStep);
         }
 
+        // Resume scripts waiting on the fixed step
+        CoroutineScheduler::GetInstance().FixedUpdate();
+
         physicsAccumulator -= physicsTimeStep;
     }
 
@@ -206,6 +391,12 @@ void Scene::Update(float deltaTime) {
         gameObject->UpdateComponents(deltaTime);
     }
 
+    // Advance script timers and resume scripts whose wait completed
+    CoroutineScheduler::GetInstance().Update(deltaTime);
+
+    // Deliver events raised by scripts during this frame
+    EventBus::GetInstance().Dispatch();
+
     // Update cameras
     if (mainCamera) {
         mainCamera->Update(deltaTime);
@@ -226,7 +417,8 @@ void Scene::Render() {
     RenderScene();
 }
 
-void Scene::RenderGameObject(GameObject* gameObject, const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix, const Vector3& cameraPosition) {
+void Scene::RenderGameObject(GameObject* gameObject, const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix, const Vector3& cameraPosition,
+                             const Camera* camera) {
     if (!gameObject) {
         return;
     }
@@ -236,24 +428,122 @@ void Scene::RenderGameObject(GameObject* gameObject, const Matrix4x4& viewMatrix
         return;
     }
 
-    // Get the model matrix
-    Matrix4x4 model = gameObject->GetModelMatrix();
+    // Pick the level of detail from the largest model's size on screen
+    std::vector<std::shared_ptr<LodGroup>> lodGroups = gameObject->GetComponents<LodGroup>();
+    LodGroup::Selection lod;
+    if (!lodGroups.empty()) {
+        float screenHeight = 0.0f;
+        size_t levelCount = 1;
+        for (auto& mesh : gameObject->GetMeshes()) {
+            if (mesh && mesh->GetLodCount() > 1) {
+                screenHeight = std::max(screenHeight, LodGroup::GetScreenHeight(mesh->position, mesh->GetBoundingRadius(),
+                                                                                cameraPosition, projectionMatrix));
+                levelCount = std::max(levelCount, mesh->GetLodCount());
+            }
+        }
+        if (levelCount > 1) {
+            lod = lodGroups[0]->Select(camera, screenHeight, levelCount);
+        }
+    }
 
-    // Render meshes
+    // Queue meshes
     for (auto& mesh : gameObject->GetMeshes()) {
-        if (mesh) {
-            RenderMesh(mesh, model, viewMatrix, projectionMatrix, cameraPosition);
+        if (!mesh || !IsVisible(mesh)) {
+            continue;
+        }
+        float depth = (mesh->position - cameraPosition).magnitude();
+        if (lod.fade < 1.0f) {
+            // The outgoing level keeps the dither values the incoming one does not
+            mesh->SetLod(lod.fadeLevel, lod.fade);
+            renderQueue.Add(mesh, depth);
+            if (lod.fade > 0.0f) {
+                mesh->SetLod(lod.level, -lod.fade);
+                renderQueue.Add(mesh, depth);
+            }
+        } else {
+            if (!lodGroups.empty()) {
+                mesh->SetLod(lod.level);
+            }
+            renderQueue.Add(mesh, depth);
         }
     }
 
-    // Render children
+    // Queue children
     for (auto& child : gameObject->GetChildren()) {
         if (child) {
-            RenderGameObject(child, viewMatrix, projectionMatrix, cameraPosition);
+            RenderGameObject(child, viewMatrix, projectionMatrix, cameraPosition, camera);
+        }
+    }
+}
+
+void Scene::CollectCullingBounds() {
+    frustumCuller.Clear();
+    cullingModels.clear();
+    culledCameras.clear();
+    cullingFrame = frameCount;
+
+    // Mirrors RenderGameObject's walk: disabled objects hide their children
+    std::vector<GameObject*> pending(gameObjects.rbegin(), gameObjects.rend());
+    while (!pending.empty()) {
+        GameObject* gameObject = pending.back();
+        pending.pop_back();
+        if (!gameObject || !gameObject->IsEnabled()) {
+            continue;
+        }
+        for (Model* mesh : gameObject->GetMeshes()) {
+            if (!mesh) {
+                continue;
+            }
+            Vector3 localMin;
+            Vector3 localMax;
+            Vector3 worldMin;
+            Vector3 worldMax;
+            if (mesh->GetLocalBounds(localMin, localMax)) {
+                FrustumCuller::TransformBounds(localMin, localMax, mesh->position, mesh->rotation, worldMin, worldMax);
+            } else {
+                // Nothing to draw yet (e.g. still loading); let the queue decide
+                float huge = 1e30f;
+                worldMin = Vector3(-huge, -huge, -huge);
+                worldMax = Vector3(huge, huge, huge);
+            }
+            frustumCuller.Add(worldMin, worldMax);
+            cullingModels.push_back(mesh);
         }
+        std::vector<GameObject*> children = gameObject->GetChildren();
+        pending.insert(pending.end(), children.rbegin(), children.rend());
     }
 }
 
+void Scene::CullForCamera(const Camera* camera, const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix) {
+    cameraVisibility = nullptr;
+    cullCursor = 0;
+    if (!frustumCullingEnabled) {
+        return;
+    }
+    // Cameras rendered in the same frame share the bounds and each other's
+    // results. A camera rendered again means a new frame, even when the
+    // scene is drawn without being updated (e.g. in the editor).
+    if (cullingFrame != frameCount ||
+        std::find(culledCameras.begin(), culledCameras.end(), camera) != culledCameras.end()) {
+        CollectCullingBounds();
+    }
+    culledCameras.push_back(camera);
+    cameraVisibility = &frustumCuller.Cull(viewMatrix, projectionMatrix);
+}
+
+// Models are met in the order they were gathered; anything that does not
+// line up (a model added since, or RenderGameObject called on its own) draws
+bool Scene::IsVisible(const Model* mesh) {
+    if (!cameraVisibility) {
+        return true;
+    }
+    size_t index = cullCursor++;
+    if (index >= cullingModels.size() || cullingModels[index] != mesh) {
+        return true;
+    }
+    return (*cameraVisibility)[index] != 0;
+}
+
 void Scene::RenderScene() {
     std::cout << "Scene::RenderScene - Starting scene rendering" << std::endl;
     
@@ -271,6 +561,11 @@ void Scene::RenderScene() {
         }
     }
 
+    CollectFrameUniforms();
+    if (frustumCullingEnabled) {
+        CollectCullingBounds();
+    }
+
     // Get active cameras
     std::cout << "Scene::RenderScene - Getting active cameras" << std::endl;
     std::vector<Camera*> cameras = cameraManager->GetActiveCameras();
@@ -314,16 +609,19 @@ void Scene::RenderScene() {
         // Get camera position
         Vector3 cameraPosition = camera->GetPosition();
 
-        // Render game objects
+        // Queue game objects, then draw them sorted
         std::cout << "Scene::RenderScene - Rendering " << gameObjects.size() << " game objects" << std::endl;
+        renderQueue.Clear();
+        CullForCamera(camera, viewMatrix, projectionMatrix);
         for (auto& gameObject : gameObjects) {
             if (gameObject) {
-                std::cout << "Scene::RenderScene - Rendering game object: " << gameObject->GetName() << std::endl;
-                RenderGameObject(gameObject, viewMatrix, projectionMatrix, cameraPosition);
+                RenderGameObject(gameObject, viewMatrix, projectionMatrix, cameraPosition, camera);
             } else {
                 std::cout << "Scene::RenderScene - WARNING: Skipping null game object" << std::endl;
             }
         }
+        cameraVisibility = nullptr;
+        SubmitRenderQueue(viewMatrix, projectionMatrix);
 
         // Draw coordinate axes for debugging (only in editor mode)
         if (EngineCondition::IsInEditor()) {
@@ -335,6 +633,13 @@ void Scene::RenderScene() {
     std::cout << "Scene::RenderScene - Scene rendering completed" << std::endl;
 }
 
+void Scene::SubmitRenderQueue(const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix) {
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    ShaderUniforms::GetInstance().SetCamera(viewMatrix, projectionMatrix);
+    renderQueue.Sort();
+    renderQueue.Submit(graphics.get());
+}
+
 void Scene::RenderMesh(Model* mesh, const Matrix4x4& modelMatrix, const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix, const Vector3& cameraPosition) {
     std::cout << "Scene::RenderMesh - Starting mesh rendering" << std::endl;
     
@@ -343,35 +648,10 @@ void Scene::RenderMesh(Model* mesh, const Matrix4x4& modelMatrix, const Matrix4x
         return;
     }
 
-    // Get all point lights in the scene
-    std::cout << "Scene::RenderMesh - Collecting point lights" << std::endl;
-    std::vector<PointLight> pointLights;
-    for (auto& gameObject : gameObjects) {
-        if (gameObject) {
-            for (auto& light : gameObject->lights) {
-                pointLights.push_back(light);
-            }
-        }
-    }
-    std::cout << "Scene::RenderMesh - Collected " << pointLights.size() << " point lights" << std::endl;
-
-    // Get all directional lights in the scene
-    std::cout << "Scene::RenderMesh - Collecting directional lights" << std::endl;
-    std::vector<DirectionalLight> dirLights;
-    for (auto& gameObject : gameObjects) {
-        if (gameObject) {
-            for (auto& light : gameObject->directionalLights) {
-                dirLights.push_back(light);
-            }
-        }
-    }
-    // Add scene-level directional lights
-    dirLights.insert(dirLights.end(), directionalLights.begin(), directionalLights.end());
-    std::cout << "Scene::RenderMesh - Collected " << dirLights.size() << " directional lights" << std::endl;
-
     // Render the mesh with the lights and camera matrices
-    std::cout << "Scene::RenderMesh - Calling mesh->Render with collected lights and matrices" << std::endl;
-    mesh->Render(pointLights, dirLights, viewMatrix, projectionMatrix);
+    std::cout << "Scene::RenderMesh - Calling mesh->Render with " << framePointLights.size() << " point lights and "
+              << frameDirectionalLights.size() << " directional lights" << std::endl;
+    mesh->Render(framePointLights, frameDirectionalLights, viewMatrix, projectionMatrix);
     std::cout << "Scene::RenderMesh - Mesh rendering completed" << std::endl;
 }
 
@@ -386,22 +666,37 @@ void Scene::DrawDebugAxes() {
     graphics->DrawDebugAxes();
 }
 
+void Scene::CollectFrameUniforms() {
+    framePointLights.clear();
+    frameDirectionalLights.clear();
+    for (auto& gameObject : gameObjects) {
+        if (gameObject) {
+            framePointLights.insert(framePointLights.end(), gameObject->lights.begin(), gameObject->lights.end());
+            frameDirectionalLights.insert(frameDirectionalLights.end(), gameObject->directionalLights.begin(),
+                                          gameObject->directionalLights.end());
+        }
+    }
+    // Add scene-level directional lights
+    frameDirectionalLights.insert(frameDirectionalLights.end(), directionalLights.begin(), directionalLights.end());
+
+    ShaderUniforms& sharedUniforms = ShaderUniforms::GetInstance();
+    if (time) {
+        sharedUniforms.SetTime(time->GetTime(), time->GetDeltaTime());
+    }
+    sharedUniforms.SetLights(framePointLights, frameDirectionalLights);
+}
+
 void Scene::SetGlobalShaderUniforms(ShaderProgram* program) {
     if (!program) {
         return;
     }
 
-    // Set time uniforms
+    ShaderUniforms& sharedUniforms = ShaderUniforms::GetInstance();
     if (time) {
-        program->SetUniform("time", time->GetTime());
-        program->SetUniform("deltaTime", time->GetDeltaTime());
+        sharedUniforms.SetTime(time->GetTime(), time->GetDeltaTime());
     }
-
-    // Set camera uniforms
     if (mainCamera) {
-         program->SetUniform("viewMatrix", mainCamera->GetViewMatrix());
-         program->SetUniform("projectionMatrix", mainCamera->GetProjectionMatrix());
-         program->SetUniform("cameraPosition", mainCamera->GetPosition());
+        sharedUniforms.SetCamera(mainCamera->GetViewMatrix(), mainCamera->GetProjectionMatrix());
     }
 
     // Set light uniforms
@@ -413,27 +708,10 @@ void Scene::UpdateLightUniforms(ShaderProgram* program) {
         return;
     }
 
-    // Get all point lights in the scene
-    std::vector<PointLight> pointLights;
-    for (auto& gameObject : gameObjects) {
-        if (gameObject) {
-            for (auto& light : gameObject->lights) {
-                pointLights.push_back(light);
-            }
-        }
-    }
-
-    // Set point light uniforms
-    int pointLightCount = std::min((int)pointLights.size(), 8); // Limit to 8 point lights
-     program->SetUniform("pointLightCount", pointLightCount);
-
-    for (int i = 0; i < pointLightCount; i++) {
-        std::string prefix = "pointLights[" + std::to_string(i) + "].";
-         program->SetUniform(prefix + "position", pointLights[i].GetPosition());
-         program->SetUniform(prefix + "color", pointLights[i].GetColor());
-         program->SetUniform(prefix + "intensity", pointLights[i].GetIntensity());
-         program->SetUniform(prefix + "range", pointLights[i].GetRange());
-    }
+    CollectFrameUniforms();
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    ShaderUniforms::GetInstance().Upload(graphics.get());
+    program->SetSharedUniforms();
 }
 
 void Scene::Reset() {
@@ -454,6 +732,11 @@ void Scene::Reset() {
     // Reset physics accumulator
     physicsAccumulator = 0.0f;
 
+    // Put objects back where they were at the reset point
+    if (resetSnapshot.IsValid()) {
+        RestoreSnapshot(resetSnapshot);
+    }
+
     // Reset game objects
     for (auto& gameObject : gameObjects) {
         if (gameObject) {
@@ -462,6 +745,136 @@ void Scene::Reset() {
     }
 }
 
+SceneSnapshot Scene::CaptureSnapshot() {
+    if (!snapshotter) {
+        snapshotter = std::unique_ptr<SceneSnapshotter>(new SceneSnapshotter(gameObjects));
+    }
+    return snapshotter->Capture();
+}
+
+void Scene::RestoreSnapshot(const SceneSnapshot& snapshot) {
+    if (!snapshotter) {
+        snapshotter = std::unique_ptr<SceneSnapshotter>(new SceneSnapshotter(gameObjects));
+    }
+    snapshotter->Restore(snapshot);
+}
+
+void Scene::DetectCollisions() {
+    struct Collider {
+        RigidBody* body;
+        TriggerVolume* trigger;
+        GameObject* object;
+        Vector3 min;
+        Vector3 max;
+    };
+    std::vector<Collider> colliders;
+    for (GameObject* gameObject : gameObjects) {
+        if (!gameObject || !gameObject->IsEnabled()) {
+            continue;
+        }
+        Vector3 position = gameObject->GetPosition();
+        Vector3 extent = gameObject->GetScale();
+        for (auto& body : gameObject->GetComponents<RigidBody>()) {
+            colliders.push_back({ body.get(), nullptr, gameObject, position - extent, position + extent });
+        }
+        for (auto& trigger : gameObject->GetComponents<TriggerVolume>()) {
+            colliders.push_back({ nullptr, trigger.get(), gameObject, position - extent, position + extent });
+        }
+    }
+    
+    // Sweep along x so only boxes that overlap there are compared
+    std::sort(colliders.begin(), colliders.end(), [](const Collider& a, const Collider& b) {
+        return a.min.x < b.min.x;
+    });
+    for (size_t i = 0; i < colliders.size(); i++) {
+        const Collider& a = colliders[i];
+        for (size_t j = i + 1; j < colliders.size() && colliders[j].min.x <= a.max.x; j++) {
+            const Collider& b = colliders[j];
+            if (a.object == b.object || (!a.body && !b.body) ||
+                a.min.y > b.max.y || b.min.y > a.max.y || a.min.z > b.max.z || b.min.z > a.max.z) {
+                continue;
+            }
+            
+            // Normal points from b to a, as CollisionInfo expects
+            CollisionInfo info;
+            Vector3 centerA = (a.min + a.max) * 0.5f;
+            Vector3 centerB = (b.min + b.max) * 0.5f;
+            if ((centerA - centerB).magnitude() > 0.0001f) {
+                info.normal = (centerA - centerB).normalized();
+            }
+            info.point = (centerA + centerB) * 0.5f;
+            info.depth = std::min(std::min(std::min(a.max.x, b.max.x) - std::max(a.min.x, b.min.x),
+                                           std::min(a.max.y, b.max.y) - std::max(a.min.y, b.min.y)),
+                                  std::min(a.max.z, b.max.z) - std::max(a.min.z, b.min.z));
+            CollisionInfo flipped = info;
+            flipped.normal = info.normal * -1.0f;
+            
+            if (a.body && b.body) {
+                a.body->OnCollision(b.body, info);
+                b.body->OnCollision(a.body, flipped);
+            } else if (a.trigger) {
+                a.trigger->OnCollision(b.body, flipped);
+            } else {
+                b.trigger->OnCollision(a.body, info);
+            }
+        }
+    }
+    
+    for (const Collider& collider : colliders) {
+        if (collider.body) {
+            collider.body->EndCollisionStep();
+        } else {
+            collider.trigger->EndCollisionStep();
+        }
+    }
+}
+
+void Scene::SetResetPoint() {
+    resetSnapshot = CaptureSnapshot();
+}
+
+void Scene::SetLegacyEventHooksEnabled(bool enabled) {
+    legacyEventHooksEnabled = enabled;
+
+    EventBus& bus = EventBus::GetInstance();
+    if (!enabled) {
+        bus.Unsubscribe(collisionHookListener);
+        bus.Unsubscribe(triggerHookListener);
+        collisionHookListener = 0;
+        triggerHookListener = 0;
+        return;
+    }
+
+    // Every scene has its own listeners on the shared bus, so each forwards
+    // only the events of its own objects
+    if (collisionHookListener == 0) {
+        collisionHookListener = bus.Subscribe<CollisionEvent>([this](const CollisionEvent* events, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                GameObject* owner = events[i].body ? events[i].body->GetGameObject() : nullptr;
+                if (owner && owner->GetScene() == this) {
+                    owner->SendCollisionMessage(events[i].phase);
+                }
+            }
+        });
+    }
+
+    if (triggerHookListener == 0) {
+        triggerHookListener = bus.Subscribe<TriggerEvent>([this](const TriggerEvent* events, size_t count) {
+            for (size_t i = 0; i < count; i++) {
+                if (!events[i].other || events[i].other->GetScene() != this) {
+                    continue;
+                }
+                TriggerVolume* trigger = events[i].trigger;
+                switch (events[i].phase) {
+                    case CollisionPhase::ENTER: trigger->OnTriggerEnter(); break;
+                    case CollisionPhase::STAY:  trigger->OnTriggerStay();  break;
+                    case CollisionPhase::EXIT:  trigger->OnTriggerExit();  break;
+                }
+            }
+        });
+    }
+}
+
 void Scene::Shutdown() {
     // Shutdown game objects
     for (auto& gameObject : gameObjects) {
@@ -470,8 +883,68 @@ void Scene::Shutdown() {
         }
     }
 
+    // Drop the pending events of our objects before any of them is freed,
+    // leaving other scenes' events queued. Compared by address only, as an
+    // event may name an object that is already gone.
+    std::unordered_set<const void*> ours;
+    for (GameObject* gameObject : gameObjects) {
+        if (!gameObject) {
+            continue;
+        }
+        ours.insert(gameObject);
+        for (auto& body : gameObject->GetComponents<RigidBody>()) {
+            ours.insert(body.get());
+        }
+        for (auto& trigger : gameObject->GetComponents<TriggerVolume>()) {
+            ours.insert(trigger.get());
+        }
+        if (gameObject->GetScene() == this) {
+            gameObject->SetScene(nullptr);
+        }
+    }
+    EventBus& bus = EventBus::GetInstance();
+    bus.Discard<CollisionEvent>([&ours](const CollisionEvent& event) {
+        return ours.count(event.body) != 0 || ours.count(event.other) != 0;
+    });
+    bus.Discard<TriggerEvent>([&ours](const TriggerEvent& event) {
+        return ours.count(event.trigger) != 0 || ours.count(event.other) != 0;
+    });
+
+    // Free loaded objects that are still ours; RemoveGameObject hands
+    // ownership back to the caller
+    if (!loadedObjects.empty()) {
+        std::unordered_set<GameObject*> inScene(gameObjects.begin(), gameObjects.end());
+        std::vector<GameObject*> owned;
+        for (GameObject* object : loadedObjects) {
+            if (inScene.count(object) != 0) {
+                owned.push_back(object);
+            }
+        }
+        loadedObjects.clear();
+        SceneSerializer::DestroySceneObjects(owned);
+    }
+
+    // Abandon loads still in flight
+    std::vector<std::shared_ptr<SceneLoadOperation>> abandoned;
+    abandoned.swap(pendingLoads);
+    for (auto& load : abandoned) {
+        load->Complete(SceneLoadOperation::Status::FAILED);
+    }
+
     // Clear game objects
     gameObjects.clear();
+    renderQueue.Clear();
+    renderQueue.ReleaseBuffers(GraphicsAPIFactory::GetInstance().GetGraphicsAPI().get());
+
+    // Snapshots refer to the objects that were just shut down
+    resetSnapshot = SceneSnapshot();
+    snapshotter.reset();
+
+    // Only our own listeners; other scenes keep theirs
+    bus.Unsubscribe(collisionHookListener);
+    bus.Unsubscribe(triggerHookListener);
+    collisionHookListener = 0;
+    triggerHookListener = 0;
 
     // Reset main camera
     mainCamera = nullptr;
@@ -547,7 +1020,7 @@ ShaderProgram* Scene::CreateDefaultShaderProgram() {
         "    float range;\n"
         "};\n"
         "\n"
-        "uniform int pointLightCount;\n"
+        "uniform int numPointLights;\n"
         "uniform PointLight pointLights[8];\n"
         "\n"
         "void main()\n"
@@ -569,7 +1042,7 @@ ShaderProgram* Scene::CreateDefaultShaderProgram() {
         "   vec3 specular = vec3(0.0);\n"
         "   \n"
         "   // Calculate lighting for each point light\n"
-        "   for(int i = 0; i < pointLightCount; i++) {\n"
+        "   for(int i = 0; i < numPointLights; i++) {\n"
         "       // Calculate light direction and distance\n"
         "       vec3 lightDir = normalize(pointLights[i].position - FragPos);\n"
         "       float distance = length(pointLights[i].position - FragPos);\n"
@@ -591,7 +1064,7 @@ ShaderProgram* Scene::CreateDefaultShaderProgram() {
         "   }\n"
         "   \n"
         "   // If no lights, use a fallback light\n"
-        "   if(pointLightCount == 0) {\n"
+        "   if(numPointLights == 0) {\n"
         "       vec3 lightDir = normalize(vec3(0.0, 1.0, 5.0) - FragPos);\n"
         "       float diff = max(dot(norm, lightDir), 0.0);\n"
         "       diffuse = diff * vec3(1.0);\n"
@@ -634,6 +1107,8 @@ void Scene::RenderFromCamera(Camera* camera) {
         return;
     }
 
+    CollectFrameUniforms();
+
     // Set viewport using the graphics API
     int viewportX = 0;
     int viewportY = 0;
@@ -652,12 +1127,16 @@ void Scene::RenderFromCamera(Camera* camera) {
     // Get camera position
     Vector3 cameraPosition = camera->GetPosition();
 
-    // Render game objects
+    // Queue game objects, then draw them sorted
+    renderQueue.Clear();
+    CullForCamera(camera, viewMatrix, projectionMatrix);
     for (auto& gameObject : gameObjects) {
         if (gameObject) {
-            RenderGameObject(gameObject, viewMatrix, projectionMatrix, cameraPosition);
+            RenderGameObject(gameObject, viewMatrix, projectionMatrix, cameraPosition, camera);
         }
     }
+    cameraVisibility = nullptr;
+    SubmitRenderQueue(viewMatrix, projectionMatrix);
 }
 
 void Scene::SetMinimapCamera(Camera* camera) {
@@ -2,18 +2,25 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 #include "Vector3.h"
 #include "Matrix4x4.h"
 #include "TimeManager.h"
 #include "PhysicsSystem.h"
 #include "CameraManager.h"
+#include "PointLight.h"
 #include "DirectionalLight.h"
 #include "Graphics/Core/IGraphicsAPI.h"
+#include "SceneSnapshot.h"
+#include "RenderQueue.h"
+#include "FrustumCuller.h"
 
 class GameObject;
 class Camera;
 class Model;
 class ShaderProgram;
+class WorldPartition;
+class SceneLoadOperation;
 
 class Scene {
 public:
@@ -25,7 +32,7 @@ public:
     bool isRunning;
     std::vector<DirectionalLight> directionalLights;
     
-    Scene() : physicsTimeStep(1.0f / 60.0f), physicsAccumulator(0.0f), frameCount(0), createDefaultObjects(true), isRunning(false), mainCamera(nullptr), minimapCamera(nullptr) {}
+    Scene() : physicsTimeStep(1.0f / 60.0f), physicsAccumulator(0.0f), frameCount(0), createDefaultObjects(true), isRunning(false), mainCamera(nullptr), minimapCamera(nullptr), legacyEventHooksEnabled(true), collisionHookListener(0), triggerHookListener(0), worldPartition(nullptr), loadBudgetMs(2.0f), frustumCullingEnabled(true), cullingFrame(-1), cameraVisibility(nullptr), cullCursor(0) {}
     ~Scene();
     
     void Initialize();
@@ -34,6 +41,10 @@ public:
     
     void AddGameObject(GameObject* gameObject);
     void RemoveGameObject(GameObject* gameObject);
+    
+    // Bulk versions for streaming; no per-object duplicate check or logging
+    void AddGameObjects(GameObject* const* objects, size_t count);
+    void RemoveGameObjects(const std::vector<GameObject*>& objects);
     GameObject* FindGameObject(const std::string& name) const;
     void AddCamera(Camera* camera);
     
@@ -50,6 +61,12 @@ public:
     void SetGravity(const Vector3& gravity);
     Vector3 GetGravity() const;
     
+    // Report every pair of enabled objects whose boxes (position +/- scale)
+    // overlap to their rigid bodies and trigger volumes, then end the
+    // contacts that no longer overlap. Update calls it every physics step;
+    // the events are published, not dispatched.
+    void DetectCollisions();
+    
     void SetCreateDefaultObjects(bool create) { createDefaultObjects = create; }
     bool GetCreateDefaultObjects() const { return createDefaultObjects; }
     
@@ -58,9 +75,20 @@ public:
     
     void RenderScene();
     void RenderFromCamera(Camera* camera);
-    void RenderGameObject(GameObject* gameObject, const Matrix4x4& view, const Matrix4x4& projection, const Vector3& cameraPosition);
+    // Queue the meshes of a game object and its children for the camera
+    // being rendered; RenderScene and RenderFromCamera draw the queue
+    void RenderGameObject(GameObject* gameObject, const Matrix4x4& view, const Matrix4x4& projection, const Vector3& cameraPosition,
+                          const Camera* camera = nullptr);
     void RenderMesh(Model* mesh, const Matrix4x4& model, const Matrix4x4& view, const Matrix4x4& projection, const Vector3& cameraPosition);
     void DrawDebugAxes();
+    // The queue the last camera was drawn through; its stats cover that submit
+    const RenderQueue& GetRenderQueue() const { return renderQueue; }
+    
+    // Skip models outside the camera's view before they are queued. On by
+    // default; the culler's stats cover the cameras of the last frame.
+    void SetFrustumCullingEnabled(bool enabled) { frustumCullingEnabled = enabled; }
+    bool IsFrustumCullingEnabled() const { return frustumCullingEnabled; }
+    const FrustumCuller& GetFrustumCuller() const { return frustumCuller; }
     
     void SetMinimapCamera(Camera* camera);
     Camera* GetMinimapCamera() const { return minimapCamera; }
@@ -80,15 +108,100 @@ public:
     void Reset();
     void Shutdown();
     
+    // Copy-on-write snapshots of object state (transforms, enabled flags,
+    // rigid body velocities). Cheap enough to take every tick; used for
+    // Reset, editor play mode and rollback.
+    SceneSnapshot CaptureSnapshot();
+    void RestoreSnapshot(const SceneSnapshot& snapshot);
+    
+    // Make the current state the one Reset() returns to. Taken automatically
+    // on the first update if never set, and again on the first update after
+    // objects are added or removed.
+    void SetResetPoint();
+    
+    // Stream world partition cells around the main camera during Update.
+    // The partition is not owned by the scene.
+    void SetWorldPartition(WorldPartition* partition) { worldPartition = partition; }
+    WorldPartition* GetWorldPartition() const { return worldPartition; }
+    
+    // Add every object of a scene file, JSON or binary (see SceneSerializer::LoadSceneFile).
+    // Blocks until the file is parsed and all mesh buffers are created.
+    // Loaded objects are owned by the scene and freed in Shutdown unless
+    // removed from it first.
+    bool Load(const std::string& path);
+    
+    // Parse a scene file on a worker thread, then create its mesh buffers
+    // on the main thread within the load budget each Update. The objects
+    // are added together once all of them are ready.
+    std::shared_ptr<SceneLoadOperation> LoadAsync(const std::string& path);
+    
+    // Main-thread time spent finalizing background loads per Update
+    void SetLoadBudget(float milliseconds) { loadBudgetMs = milliseconds; }
+    float GetLoadBudget() const { return loadBudgetMs; }
+    
+    // Advance background loads; called by Update. Call it directly to
+    // load a scene that is not being updated yet (e.g. behind a loading screen).
+    void FinalizeLoads();
+    
+    // Deliver collision and trigger events to the virtual MonoBehaviourLike
+    // hooks (OnCollisionEnter, OnTriggerEnter, ...). Code that subscribes to
+    // the EventBus directly can turn this off to skip per-event virtual calls.
+    void SetLegacyEventHooksEnabled(bool enabled);
+    bool GetLegacyEventHooksEnabled() const { return legacyEventHooksEnabled; }
+    
 private:
     std::unique_ptr<TimeManager> time;
     std::unique_ptr<PhysicsSystem> physicsSystem;
     std::unique_ptr<CameraManager> cameraManager;
     
+    // Gather the lights once per frame for every mesh drawn and hand them
+    // and the time to the shared shader uniforms
+    void CollectFrameUniforms();
+    std::vector<PointLight> framePointLights;
+    std::vector<DirectionalLight> frameDirectionalLights;
+    
+    // Draws of the camera being rendered, sorted before they are submitted
+    RenderQueue renderQueue;
+    void SubmitRenderQueue(const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix);
+    
+    // World bounds of every model that could be drawn, gathered once a
+    // frame in the order RenderGameObject visits them and culled per camera
+    void CollectCullingBounds();
+    void CullForCamera(const Camera* camera, const Matrix4x4& viewMatrix, const Matrix4x4& projectionMatrix);
+    bool IsVisible(const Model* mesh);
+    
     float physicsAccumulator;
     int frameCount;
     bool resolutionChangeAllowed;
     
     Camera* mainCamera;
     Camera* minimapCamera;
+    
+    // EventBus listeners forwarding the events of this scene's objects to
+    // the legacy virtual hooks
+    bool legacyEventHooksEnabled;
+    unsigned int collisionHookListener;
+    unsigned int triggerHookListener;
+    
+    std::unique_ptr<SceneSnapshotter> snapshotter;
+    SceneSnapshot resetSnapshot;
+    
+    // Called when objects enter or leave the scene. The reset point may
+    // refer to objects that are about to be deleted, so it is dropped and
+    // retaken on the next update.
+    void DropResetPoint() { resetSnapshot = SceneSnapshot(); }
+    
+    WorldPartition* worldPartition;
+    
+    float loadBudgetMs;
+    std::vector<std::shared_ptr<SceneLoadOperation>> pendingLoads;
+    std::vector<GameObject*> loadedObjects;
+    
+    bool frustumCullingEnabled;
+    FrustumCuller frustumCuller;
+    std::vector<const Model*> cullingModels;
+    int cullingFrame;
+    std::vector<const Camera*> culledCameras;
+    const std::vector<uint8_t>* cameraVisibility;   // Result of the camera being queued, null to draw everything
+    size_t cullCursor;
 };
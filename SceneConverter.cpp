@@ -0,0 +1,37 @@
+#include "BinaryScene.h"
+#include <iostream>
+#include <string>
+
+// Converts scenes between the JSON format and the binary .savscene format.
+// The direction is picked from the input file.
+//
+//     SceneConverter Scenes/cave.json Scenes/cave.savscene
+//     SceneConverter Scenes/cave.savscene Scenes/cave.json
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cout << "Usage: SceneConverter <input> <output>" << std::endl;
+        std::cout << "  JSON input is written as a binary scene, binary input as JSON." << std::endl;
+        return 1;
+    }
+
+    std::string input = argv[1];
+    std::string output = argv[2];
+
+    bool ok;
+    if (BinaryScene::IsBinarySceneFile(input)) {
+        std::cout << "Converting binary scene " << input << " to JSON " << output << std::endl;
+        ok = BinaryScene::ConvertBinaryToJson(input, output);
+    } else {
+        std::cout << "Converting JSON scene " << input << " to binary " << output << std::endl;
+        ok = BinaryScene::ConvertJsonToBinary(input, output);
+    }
+
+    if (!ok) {
+        std::cerr << "Conversion failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Done." << std::endl;
+    return 0;
+}
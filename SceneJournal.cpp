@@ -0,0 +1,481 @@
+#include "SceneJournal.h"
+#include "SceneSerializer.h"
+#include "JsonStreamReader.h"
+#include "GameObject.h"
+#include "Model.h"
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+// Reads "journalGeneration" from the head of a snapshot without parsing the objects
+class GenerationReader : public JsonStreamReader {
+public:
+    unsigned int generation = 0;
+
+protected:
+    bool OnNumber(double value) override {
+        if (Depth() == 1 && CurrentKey() == "journalGeneration") {
+            generation = static_cast<unsigned int>(value);
+            return Stop();
+        }
+        return true;
+    }
+
+    bool OnBeginArray() override {
+        // The generation is written before the objects
+        return Depth() == 1 && CurrentKey() == "objects" ? Stop() : true;
+    }
+};
+
+void Flatten(GameObject* object, std::vector<GameObject*>& flattened) {
+    flattened.push_back(object);
+    for (GameObject* child : object->childGameObjects) {
+        Flatten(child, flattened);
+    }
+}
+
+nlohmann::json VectorJson(const Vector3& vec) {
+    return { {"x", vec.x}, {"y", vec.y}, {"z", vec.z} };
+}
+
+Vector3 VectorFromJson(const nlohmann::json& json, const Vector3& current) {
+    if (!json.is_object()) {
+        return current;
+    }
+    return Vector3(json.value("x", current.x), json.value("y", current.y), json.value("z", current.z));
+}
+
+// Journal record for the parts of an object named by the dirty flags
+nlohmann::json DeltaRecord(const GameObject* object, unsigned int flags) {
+    nlohmann::json record;
+    record["id"] = object->GetPersistentId();
+    if (flags & GameObject::DIRTY_PROPERTIES) {
+        record["name"] = object->GetName();
+        record["enabled"] = object->IsEnabled();
+    }
+    if (flags & GameObject::DIRTY_TRANSFORM) {
+        record["position"] = VectorJson(object->position);
+        record["rotation"] = VectorJson(object->rotation);
+        record["scale"] = VectorJson(object->size);
+    }
+    if (flags & GameObject::DIRTY_COMPONENTS) {
+        record["components"] = SceneSerializer::SerializeSceneComponents(object);
+    }
+    if (flags & GameObject::DIRTY_HIERARCHY) {
+        nlohmann::json children = nlohmann::json::array();
+        for (const GameObject* child : object->childGameObjects) {
+            children.push_back(child->GetPersistentId());
+        }
+        record["childIds"] = children;
+    }
+    return record;
+}
+
+// Replaces the lights and meshes of an object with a components array
+void ApplyComponents(GameObject* object, const nlohmann::json& components) {
+    object->lights.clear();
+    for (Model* mesh : object->meshes) {
+        delete mesh;
+    }
+    object->meshes.clear();
+
+    for (const auto& component : components) {
+        if (!component.is_object() || !component.contains("properties")) {
+            continue;
+        }
+        std::string type = component.value("type", std::string());
+        const nlohmann::json& properties = component["properties"];
+
+        if (type == "Mesh") {
+            std::string modelPath = properties.value("model", std::string());
+            Model* model = new Model();
+            if (modelPath.empty() || !model->ParseFromFile(modelPath)) {
+                std::cerr << "Error: Could not load mesh '" << modelPath << "' for " << object->GetName() << std::endl;
+                delete model;
+                continue;
+            }
+            model->SetTexturePath(properties.value("texture", std::string()));
+            object->AddMesh(model);
+        } else if (type == "Light" && properties.value("type", std::string("point")) == "point") {
+            PointLight light;
+            if (properties.contains("color")) {
+                const nlohmann::json& color = properties["color"];
+                light.SetColor(Vector3(color.value("r", 1.0f), color.value("g", 1.0f), color.value("b", 1.0f)));
+            }
+            light.SetIntensity(properties.value("intensity", 1.0f));
+            light.SetRange(properties.value("range", 10.0f));
+            object->AddLight(light);
+        }
+    }
+}
+
+// Deletes one object and its meshes but not its children
+void DestroyObject(GameObject* object) {
+    object->childGameObjects.clear();
+    std::vector<GameObject*> single(1, object);
+    SceneSerializer::DestroySceneObjects(single);
+}
+
+std::vector<unsigned int> IdsOf(const std::vector<GameObject*>& objects) {
+    std::vector<unsigned int> ids;
+    ids.reserve(objects.size());
+    for (const GameObject* object : objects) {
+        ids.push_back(object->GetPersistentId());
+    }
+    return ids;
+}
+
+bool FileExists(const std::string& path) {
+    std::ifstream file(path);
+    return file.good();
+}
+
+} // namespace
+
+SceneJournal::SceneJournal(const std::string& snapshotPath)
+    : snapshotPath(snapshotPath), journalPath(snapshotPath + ".journal"), compactionLimit(64),
+      entryCount(0), lastSavedObjects(0), hasBaseline(false), nextId(1), generation(0) {
+}
+
+bool SceneJournal::Load(std::vector<GameObject*>& objects) {
+    // A compaction interrupted between removing the old snapshot and
+    // renaming the new one leaves only the temporary file
+    std::string path = snapshotPath;
+    if (!FileExists(path) && FileExists(snapshotPath + ".tmp")) {
+        path = snapshotPath + ".tmp";
+    }
+
+    std::vector<GameObject*> loaded;
+    if (!SceneSerializer::LoadSceneFromJson(path, loaded)) {
+        return false;
+    }
+
+    GenerationReader header;
+    header.ParseFile(path);
+    generation = header.generation;
+
+    bool complete = Replay(loaded);
+
+    std::vector<GameObject*> flattened;
+    for (GameObject* object : loaded) {
+        Flatten(object, flattened);
+    }
+    bool allIds = true;
+    for (GameObject* object : flattened) {
+        allIds = allIds && object->GetPersistentId() != 0;
+        nextId = std::max(nextId, object->GetPersistentId() + 1);
+        object->ClearDirty();
+    }
+    SetBaseline(loaded, flattened);
+
+    // The files do not describe the scene exactly (a torn journal, a stale
+    // journal or objects without ids): rewrite them on the next save
+    hasBaseline = complete && allIds;
+
+    objects.insert(objects.end(), loaded.begin(), loaded.end());
+    std::cout << "Loaded " << snapshotPath << " with " << entryCount << " journal entries" << std::endl;
+    return true;
+}
+
+bool SceneJournal::Save(const std::vector<GameObject*>& objects) {
+    if (!hasBaseline || entryCount >= compactionLimit) {
+        return Compact(objects);
+    }
+
+    std::vector<GameObject*> flattened;
+    AssignIds(objects, flattened);
+
+    nlohmann::json records = nlohmann::json::array();
+    std::vector<GameObject*> written;
+    std::unordered_set<unsigned int> currentIds;
+    currentIds.reserve(flattened.size());
+
+    for (GameObject* object : flattened) {
+        unsigned int id = object->GetPersistentId();
+        currentIds.insert(id);
+
+        unsigned int flags = savedIds.count(id) ? object->GetDirtyFlags() : static_cast<unsigned int>(GameObject::DIRTY_ALL);
+        if (!(flags & GameObject::DIRTY_HIERARCHY)) {
+            // A child the journal has not seen means the child list changed,
+            // even if it was edited without AddChild
+            for (const GameObject* child : object->childGameObjects) {
+                if (!savedIds.count(child->GetPersistentId())) {
+                    flags |= GameObject::DIRTY_HIERARCHY;
+                    break;
+                }
+            }
+        }
+        if (flags == 0) {
+            continue;
+        }
+        records.push_back(DeltaRecord(object, flags));
+        written.push_back(object);
+    }
+
+    std::vector<unsigned int> roots = IdsOf(objects);
+    nlohmann::json removed = nlohmann::json::array();
+    for (unsigned int id : savedIds) {
+        if (!currentIds.count(id)) {
+            removed.push_back(id);
+        }
+    }
+
+    lastSavedObjects = written.size();
+    if (records.empty() && removed.empty() && roots == savedRoots) {
+        return true;
+    }
+
+    nlohmann::json entry;
+    entry["objects"] = records;
+    if (roots != savedRoots) {
+        entry["roots"] = roots;
+    }
+    if (!removed.empty()) {
+        entry["removed"] = removed;
+    }
+
+    std::ofstream journal(journalPath, std::ios::app | std::ios::binary);
+    if (!journal.is_open()) {
+        std::cerr << "Error: Could not open scene journal: " << journalPath << std::endl;
+        return false;
+    }
+    journal << entry.dump() << '\n';
+    journal.flush();
+    if (!journal) {
+        // The journal may end in a partial line now; start over from a snapshot
+        std::cerr << "Error: Failed writing scene journal: " << journalPath << std::endl;
+        hasBaseline = false;
+        return false;
+    }
+
+    for (GameObject* object : written) {
+        object->ClearDirty();
+    }
+    savedIds.swap(currentIds);
+    savedRoots.swap(roots);
+    entryCount++;
+    return true;
+}
+
+bool SceneJournal::Compact(const std::vector<GameObject*>& objects) {
+    std::vector<GameObject*> flattened;
+    AssignIds(objects, flattened);
+
+    // The generation ties the journal to its snapshot, so a journal left
+    // over from before a compaction is never replayed onto the new one
+    unsigned int newGeneration = generation + 1;
+    nlohmann::json header;
+    header["journalGeneration"] = newGeneration;
+
+    std::string temporaryPath = snapshotPath + ".tmp";
+    if (!SceneSerializer::SaveSceneToJson(objects, temporaryPath, header)) {
+        hasBaseline = false;
+        return false;
+    }
+    std::remove(snapshotPath.c_str());
+    if (std::rename(temporaryPath.c_str(), snapshotPath.c_str()) != 0) {
+        std::cerr << "Error: Could not replace scene snapshot: " << snapshotPath << std::endl;
+        hasBaseline = false;
+        return false;
+    }
+    generation = newGeneration;
+
+    std::ofstream journal(journalPath, std::ios::trunc | std::ios::binary);
+    journal << header.dump() << '\n';
+    journal.flush();
+    if (!journal) {
+        std::cerr << "Error: Could not reset scene journal: " << journalPath << std::endl;
+        hasBaseline = false;
+        return false;
+    }
+
+    for (GameObject* object : flattened) {
+        object->ClearDirty();
+    }
+    SetBaseline(objects, flattened);
+    hasBaseline = true;
+    entryCount = 0;
+    lastSavedObjects = flattened.size();
+    return true;
+}
+
+void SceneJournal::AssignIds(const std::vector<GameObject*>& objects, std::vector<GameObject*>& flattened) {
+    flattened.clear();
+    for (GameObject* object : objects) {
+        Flatten(object, flattened);
+    }
+    for (GameObject* object : flattened) {
+        nextId = std::max(nextId, object->GetPersistentId() + 1);
+    }
+
+    std::unordered_set<unsigned int> seen;
+    seen.reserve(flattened.size());
+    for (GameObject* object : flattened) {
+        unsigned int id = object->GetPersistentId();
+        if (id == 0 || !seen.insert(id).second) {
+            // New, or copied from another object
+            object->SetPersistentId(nextId);
+            seen.insert(nextId);
+            nextId++;
+            object->MarkDirty();
+        }
+    }
+}
+
+bool SceneJournal::Replay(std::vector<GameObject*>& objects) {
+    entryCount = 0;
+
+    std::ifstream journal(journalPath, std::ios::binary);
+    if (!journal.is_open()) {
+        return true;
+    }
+
+    std::string line;
+    if (!std::getline(journal, line)) {
+        return true;
+    }
+    nlohmann::json header = nlohmann::json::parse(line, nullptr, false);
+    if (header.is_discarded() || !header.is_object() || header.value("journalGeneration", 0u) != generation) {
+        std::cerr << "Warning: Ignoring scene journal that does not belong to " << snapshotPath << std::endl;
+        return false;
+    }
+
+    struct Node {
+        GameObject* object = nullptr;
+        std::vector<unsigned int> childIds;
+    };
+    std::unordered_map<unsigned int, Node> nodes;
+
+    std::vector<GameObject*> flattened;
+    for (GameObject* object : objects) {
+        Flatten(object, flattened);
+    }
+    for (GameObject* object : flattened) {
+        if (object->GetPersistentId() == 0) {
+            // Hand-written snapshot; the journal cannot refer to these objects
+            std::cerr << "Warning: Ignoring scene journal for a snapshot without object ids: " << snapshotPath << std::endl;
+            return false;
+        }
+        Node& node = nodes[object->GetPersistentId()];
+        node.object = object;
+        node.childIds = IdsOf(object->childGameObjects);
+    }
+    std::vector<unsigned int> roots = IdsOf(objects);
+
+    bool complete = true;
+    while (std::getline(journal, line)) {
+        nlohmann::json entry = nlohmann::json::parse(line, nullptr, false);
+        if (entry.is_discarded() || !entry.is_object()) {
+            // Torn write from an interrupted save; later lines cannot be trusted
+            std::cerr << "Warning: Scene journal " << journalPath << " is damaged after entry " << entryCount << std::endl;
+            complete = false;
+            break;
+        }
+
+        if (entry.contains("objects") && entry["objects"].is_array()) {
+            for (const auto& record : entry["objects"]) {
+                unsigned int id = record.value("id", 0u);
+                if (id == 0) {
+                    continue;
+                }
+                Node& node = nodes[id];
+                if (!node.object) {
+                    node.object = new GameObject();
+                    node.object->SetPersistentId(id);
+                }
+                GameObject* object = node.object;
+
+                if (record.contains("name") && record["name"].is_string()) {
+                    object->SetName(record["name"].get<std::string>());
+                }
+                if (record.contains("enabled") && record["enabled"].is_boolean()) {
+                    object->SetEnabled(record["enabled"].get<bool>());
+                }
+                if (record.contains("position")) {
+                    object->SetPosition(VectorFromJson(record["position"], object->position));
+                }
+                if (record.contains("rotation")) {
+                    object->SetRotation(VectorFromJson(record["rotation"], object->rotation));
+                }
+                if (record.contains("scale")) {
+                    object->SetScale(VectorFromJson(record["scale"], object->size));
+                }
+                if (record.contains("components") && record["components"].is_array()) {
+                    ApplyComponents(object, record["components"]);
+                }
+                if (record.contains("childIds") && record["childIds"].is_array()) {
+                    node.childIds = record["childIds"].get<std::vector<unsigned int>>();
+                }
+            }
+        }
+
+        if (entry.contains("roots") && entry["roots"].is_array()) {
+            roots = entry["roots"].get<std::vector<unsigned int>>();
+        }
+
+        if (entry.contains("removed") && entry["removed"].is_array()) {
+            for (const auto& removed : entry["removed"]) {
+                auto it = nodes.find(removed.get<unsigned int>());
+                if (it != nodes.end()) {
+                    DestroyObject(it->second.object);
+                    nodes.erase(it);
+                }
+            }
+        }
+
+        entryCount++;
+    }
+
+    // Rebuild the hierarchy from the final child lists. An object is only
+    // attached once, so a stale list cannot give it two parents.
+    std::unordered_set<unsigned int> attached;
+    std::vector<GameObject*> result;
+    for (unsigned int id : roots) {
+        auto it = nodes.find(id);
+        if (it != nodes.end() && attached.insert(id).second) {
+            result.push_back(it->second.object);
+        }
+    }
+    for (auto& pair : nodes) {
+        GameObject* object = pair.second.object;
+        object->childGameObjects.clear();
+        for (unsigned int childId : pair.second.childIds) {
+            auto child = nodes.find(childId);
+            if (child != nodes.end() && attached.insert(childId).second) {
+                object->childGameObjects.push_back(child->second.object);
+            }
+        }
+        // Lights sit at their object's position
+        for (PointLight& light : object->lights) {
+            light.SetPosition(object->position);
+        }
+    }
+
+    // Objects no longer reachable from the roots were removed
+    std::vector<GameObject*> reachable;
+    for (GameObject* object : result) {
+        Flatten(object, reachable);
+    }
+    std::unordered_set<GameObject*> kept(reachable.begin(), reachable.end());
+    for (auto& pair : nodes) {
+        if (!kept.count(pair.second.object)) {
+            DestroyObject(pair.second.object);
+        }
+    }
+
+    objects.swap(result);
+    return complete;
+}
+
+void SceneJournal::SetBaseline(const std::vector<GameObject*>& objects, const std::vector<GameObject*>& flattened) {
+    savedIds.clear();
+    savedIds.reserve(flattened.size());
+    for (const GameObject* object : flattened) {
+        savedIds.insert(object->GetPersistentId());
+    }
+    savedRoots = IdsOf(objects);
+}
@@ -0,0 +1,86 @@
+#ifndef SCENE_JOURNAL_H
+#define SCENE_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <cstddef>
+
+class GameObject;
+
+// Incremental scene saving.
+//
+// A journaled save is a full snapshot (a scene file in the format read by
+// SceneSerializer::LoadSceneFromJson) plus an append-only journal next to
+// it ("<snapshot>.journal"). Save writes one journal line holding only the
+// objects whose dirty flags are set (see GameObject::DirtyFlags), and only
+// the parts that changed, so its cost follows the size of the edit rather
+// than the size of the scene. Every few saves the journal is compacted
+// into a new snapshot.
+//
+// Objects are identified across saves by their persistent id, which Save
+// assigns the first time it sees an object.
+//
+//     SceneJournal autosave("Saves/level.json");
+//     autosave.Load(scene->gameObjects);     // snapshot + journal replay
+//     ...
+//     autosave.Save(scene->gameObjects);     // appends the changes
+//
+// A save interrupted part way through leaves a torn last line, which Load
+// ignores: the scene comes back as of the previous save.
+class SceneJournal {
+public:
+    explicit SceneJournal(const std::string& snapshotPath);
+
+    // Load the snapshot, replay the journal and make the result the
+    // baseline for the next Save. The caller owns the returned objects
+    // (free them with SceneSerializer::DestroySceneObjects).
+    bool Load(std::vector<GameObject*>& objects);
+
+    // Append the changes since the last save; writes a full snapshot on the
+    // first save and when compaction is due
+    bool Save(const std::vector<GameObject*>& objects);
+
+    // Write every object to a new snapshot and empty the journal
+    bool Compact(const std::vector<GameObject*>& objects);
+
+    // Number of journal entries after which Save compacts (default 64)
+    void SetCompactionLimit(size_t entries) { compactionLimit = entries; }
+    size_t GetCompactionLimit() const { return compactionLimit; }
+
+    const std::string& GetSnapshotPath() const { return snapshotPath; }
+    const std::string& GetJournalPath() const { return journalPath; }
+
+    // Entries in the journal since the last compaction
+    size_t GetJournalEntryCount() const { return entryCount; }
+
+    // Objects written by the last Save or Compact
+    size_t GetLastSavedObjectCount() const { return lastSavedObjects; }
+
+private:
+    std::string snapshotPath;
+    std::string journalPath;
+    size_t compactionLimit;
+    size_t entryCount;
+    size_t lastSavedObjects;
+
+    // What the files on disk describe, to find removed objects and root changes
+    bool hasBaseline;
+    std::unordered_set<unsigned int> savedIds;
+    std::vector<unsigned int> savedRoots;
+    unsigned int nextId;
+
+    // Compaction count, stored in both files so a stale journal is ignored
+    unsigned int generation;
+
+    // Gives every object in the hierarchy a unique persistent id. Objects
+    // without one (or sharing one) get a fresh id and are marked dirty.
+    void AssignIds(const std::vector<GameObject*>& objects, std::vector<GameObject*>& flattened);
+
+    // Replay the journal onto the loaded objects
+    bool Replay(std::vector<GameObject*>& objects);
+
+    void SetBaseline(const std::vector<GameObject*>& objects, const std::vector<GameObject*>& flattened);
+};
+
+#endif // SCENE_JOURNAL_H
@@ -0,0 +1,78 @@
+#include "SceneLoadOperation.h"
+#include "SceneSerializer.h"
+
+SceneLoadOperation::ParseResult::~ParseResult() {
+    // Parsed but never collected; no graphics buffers exist yet
+    SceneSerializer::DestroySceneObjects(objects);
+}
+
+SceneLoadOperation::SceneLoadOperation(const std::string& path)
+    : path(path), status(Status::PARSING), parseResult(std::make_shared<ParseResult>()),
+      objectCount(0), finalized(0) {
+}
+
+SceneLoadOperation::~SceneLoadOperation() {
+    // Collected but never added to the scene
+    SceneSerializer::DestroySceneObjects(objects);
+}
+
+bool SceneLoadOperation::IsDone() const {
+    Status current = GetStatus();
+    return current == Status::DONE || current == Status::FAILED;
+}
+
+float SceneLoadOperation::GetProgress() const {
+    switch (GetStatus()) {
+        case Status::PARSING:
+            return 0.5f * parseResult->progress.load();
+        case Status::FINALIZING: {
+            size_t count = objectCount.load();
+            if (count == 0) {
+                return 1.0f;
+            }
+            return 0.5f + 0.5f * static_cast<float>(finalized.load()) / static_cast<float>(count);
+        }
+        default:
+            return 1.0f;
+    }
+}
+
+void SceneLoadOperation::OnComplete(CompletionCallback completion) {
+    if (IsDone()) {
+        if (completion) {
+            completion(*this);
+        }
+        return;
+    }
+    callback = completion;
+}
+
+bool SceneLoadOperation::CollectParseResult() {
+    {
+        std::lock_guard<std::mutex> lock(parseResult->mutex);
+        if (!parseResult->complete) {
+            return false;
+        }
+        objects.swap(parseResult->objects);
+        status = parseResult->ok ? Status::FINALIZING : Status::FAILED;
+    }
+
+    if (GetStatus() == Status::FAILED) {
+        SceneSerializer::DestroySceneObjects(objects);
+    }
+    objectCount = objects.size();
+    return true;
+}
+
+void SceneLoadOperation::Complete(Status result) {
+    status = result;
+    if (result == Status::FAILED) {
+        SceneSerializer::DestroySceneObjects(objects);
+    }
+
+    CompletionCallback completion;
+    completion.swap(callback);
+    if (completion) {
+        completion(*this);
+    }
+}
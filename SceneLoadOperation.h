@@ -0,0 +1,84 @@
+#ifndef SCENE_LOAD_OPERATION_H
+#define SCENE_LOAD_OPERATION_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <cstddef>
+
+class GameObject;
+
+// Handle to a scene file being loaded by Scene::LoadAsync.
+//
+// The file (JSON and referenced meshes) is parsed on a JobSystem worker.
+// The scene then finalizes the result on the main thread during
+// Scene::Update (or Scene::FinalizeLoads), creating mesh buffers under a
+// per-frame time budget, and adds every object in one step at the end.
+//
+//     auto load = scene->LoadAsync("Scenes/cave.json");
+//     load->OnComplete([](SceneLoadOperation& op) { ... });
+//     ...
+//     DrawLoadingBar(load->GetProgress());
+class SceneLoadOperation {
+public:
+    enum class Status {
+        PARSING,     // reading the file on a worker
+        FINALIZING,  // creating graphics buffers on the main thread
+        DONE,        // objects are in the scene
+        FAILED       // file missing or invalid, or the scene shut down
+    };
+
+    typedef std::function<void(SceneLoadOperation&)> CompletionCallback;
+
+    explicit SceneLoadOperation(const std::string& path);
+    ~SceneLoadOperation();
+
+    const std::string& GetPath() const { return path; }
+    Status GetStatus() const { return status.load(); }
+    bool IsDone() const;
+    bool Succeeded() const { return GetStatus() == Status::DONE; }
+
+    // 0 to 0.5 while parsing (the share of the file read, or of binary
+    // records built), 0.5 to 1 while finalizing.
+    // Safe to read from any thread.
+    float GetProgress() const;
+
+    // Called on the main thread once the load is done or has failed.
+    // Called immediately if that has already happened.
+    void OnComplete(CompletionCallback callback);
+
+private:
+    friend class Scene;
+
+    // Written by the worker; the operation collects it on the main thread.
+    // Shared with the job so the worker never outlives its destination.
+    struct ParseResult {
+        std::mutex mutex;
+        bool complete = false;
+        bool ok = false;
+        std::vector<GameObject*> objects;
+        // Set by the worker as it goes, without the mutex
+        std::atomic<float> progress{0.0f};
+        ~ParseResult();
+    };
+
+    std::string path;
+    std::atomic<Status> status;
+    // Kept after collection so GetProgress can read it from any thread
+    std::shared_ptr<ParseResult> parseResult;
+
+    // Main thread only
+    std::vector<GameObject*> objects;
+    std::atomic<size_t> objectCount;
+    std::atomic<size_t> finalized;
+    CompletionCallback callback;
+
+    // Move a finished parse into objects; false while still parsing
+    bool CollectParseResult();
+    void Complete(Status result);
+};
+
+#endif // SCENE_LOAD_OPERATION_H
@@ -1,6 +1,318 @@
 #include "SceneSerializer.h"
+#include "Model.h"
+#include "BinaryScene.h"
 #include <fstream>
 #include <iostream>
+#include <atomic>
+#include "JsonStreamReader.h"
+
+namespace {
+
+// Sets one coordinate of a {"x", "y", "z"} vector
+void SetAxis(Vector3& vec, const std::string& axis, float value) {
+    if (axis == "x") {
+        vec.x = value;
+    } else if (axis == "y") {
+        vec.y = value;
+    } else if (axis == "z") {
+        vec.z = value;
+    }
+}
+
+// Builds scene objects (the Examples/RPG/Scenes format) while the file is
+// parsed. Each object under "objects" or "children" is created when its
+// '{' is read and filled in as its members arrive; it is attached to its
+// parent, or to the results, when its '}' is read.
+class SceneStreamReader : public JsonStreamReader {
+public:
+    explicit SceneStreamReader(std::atomic<float>* progress = nullptr) : progress(progress) {}
+
+    ~SceneStreamReader() {
+        // Only non-empty if parsing failed part way through
+        for (OpenObject& open : stack) {
+            std::vector<GameObject*> object(1, open.object);
+            SceneSerializer::DestroySceneObjects(object);
+        }
+        SceneSerializer::DestroySceneObjects(results);
+    }
+
+    bool FoundObjects() const { return foundObjects; }
+
+    // Hands the finished top-level objects to the caller
+    void TakeObjects(std::vector<GameObject*>& objects) {
+        objects.insert(objects.end(), results.begin(), results.end());
+        results.clear();
+    }
+
+protected:
+    bool OnBeginArray() override {
+        if (Depth() == 1 && CurrentKey() == "objects") {
+            foundObjects = true;
+        }
+        return true;
+    }
+
+    bool OnBeginObject() override {
+        size_t depth = Depth();
+        bool isObject = stack.empty()
+            ? depth == 2 && KeyAt(0) == "objects" && CurrentKey() == "[]"
+            : depth == Top().frame + 2 && KeyAt(Top().frame) == "children" && CurrentKey() == "[]";
+        if (isObject) {
+            OpenObject open;
+            open.object = new GameObject();
+            open.frame = depth;
+            stack.push_back(open);
+            return true;
+        }
+
+        if (!stack.empty() && depth == Top().frame + 2 && KeyAt(Top().frame) == "components" && CurrentKey() == "[]") {
+            Top().component = PendingComponent();
+        }
+        return true;
+    }
+
+    bool OnEndObject() override {
+        if (stack.empty()) {
+            return true;
+        }
+
+        size_t depth = Depth();
+        size_t frame = Top().frame;
+        if (depth == frame) {
+            CloseObject();
+        } else if (depth == frame + 2 && KeyAt(frame) == "components") {
+            CloseComponent();
+        } else if (depth == frame + 3 && KeyAt(frame) == "components" && CurrentKey() == "properties") {
+            Top().component.hasProperties = true;
+        }
+        return true;
+    }
+
+    bool OnString(const std::string& value) override {
+        if (stack.empty()) {
+            return true;
+        }
+
+        OpenObject& top = Top();
+        size_t depth = Depth();
+        if (depth == top.frame + 1 && CurrentKey() == "name") {
+            top.object->SetName(value);
+        } else if (depth == top.frame + 3 && KeyAt(top.frame) == "components" && CurrentKey() == "type") {
+            top.component.type = value;
+        } else if (depth == top.frame + 4 && KeyAt(top.frame) == "components" && KeyAt(top.frame + 2) == "properties") {
+            const std::string& key = CurrentKey();
+            if (key == "model") {
+                top.component.model = value;
+            } else if (key == "texture") {
+                top.component.texture = value;
+            } else if (key == "type") {
+                top.component.lightType = value;
+            }
+        }
+        return true;
+    }
+
+    bool OnBool(bool value) override {
+        if (!stack.empty() && Depth() == Top().frame + 1 && CurrentKey() == "enabled") {
+            Top().object->SetEnabled(value);
+        }
+        return true;
+    }
+
+    bool OnNumber(double number) override {
+        if (stack.empty()) {
+            return true;
+        }
+
+        OpenObject& top = Top();
+        size_t depth = Depth();
+        float value = static_cast<float>(number);
+        if (depth == top.frame + 1 && CurrentKey() == "id") {
+            top.object->SetPersistentId(static_cast<unsigned int>(number));
+        } else if (depth == top.frame + 2) {
+            const std::string& member = KeyAt(top.frame);
+            if (member == "position") {
+                SetAxis(top.object->position, CurrentKey(), value);
+            } else if (member == "rotation") {
+                SetAxis(top.object->rotation, CurrentKey(), value);
+            } else if (member == "scale") {
+                SetAxis(top.object->size, CurrentKey(), value);
+            }
+        } else if (depth == top.frame + 4 && KeyAt(top.frame) == "components" && KeyAt(top.frame + 2) == "properties") {
+            if (CurrentKey() == "intensity") {
+                top.component.intensity = value;
+            } else if (CurrentKey() == "range") {
+                top.component.range = value;
+            }
+        } else if (depth == top.frame + 5 && KeyAt(top.frame) == "components" &&
+                   KeyAt(top.frame + 2) == "properties" && KeyAt(top.frame + 3) == "color") {
+            top.component.hasColor = true;
+            const std::string& channel = CurrentKey();
+            if (channel == "r") {
+                top.component.color.x = value;
+            } else if (channel == "g") {
+                top.component.color.y = value;
+            } else if (channel == "b") {
+                top.component.color.z = value;
+            }
+        }
+        return true;
+    }
+
+private:
+    // The properties of the component being read that the engine understands
+    struct PendingComponent {
+        std::string type;
+        std::string lightType = "point";
+        std::string model;
+        std::string texture;
+        Vector3 color = Vector3(1, 1, 1);
+        bool hasColor = false;
+        float intensity = 1.0f;
+        float range = 10.0f;
+        bool hasProperties = false;
+    };
+
+    struct OpenObject {
+        GameObject* object;
+        size_t frame;  // Depth() at the object's opening brace
+        PendingComponent component;
+        std::vector<PointLight> lights;
+    };
+
+    std::vector<OpenObject> stack;
+    std::vector<GameObject*> results;
+    bool foundObjects = false;
+    std::atomic<float>* progress;
+
+    OpenObject& Top() { return stack.back(); }
+
+    // Light components become point lights and Mesh components become
+    // models; other component types are gameplay specific and attached by
+    // the game after loading
+    void CloseComponent() {
+        OpenObject& top = Top();
+        const PendingComponent& component = top.component;
+        if (!component.hasProperties) {
+            return;
+        }
+
+        if (component.type == "Mesh") {
+            Model* model = new Model();
+            if (component.model.empty() || !model->ParseFromFile(component.model)) {
+                std::cerr << "Error: Could not load mesh '" << component.model << "' for " << top.object->GetName() << std::endl;
+                delete model;
+                return;
+            }
+            model->SetTexturePath(component.texture);
+            top.object->AddMesh(model);
+        } else if (component.type == "Light" && component.lightType == "point") {
+            PointLight light;
+            if (component.hasColor) {
+                light.SetColor(component.color);
+            }
+            light.SetIntensity(component.intensity);
+            light.SetRange(component.range);
+            top.lights.push_back(light);
+        }
+    }
+
+    void CloseObject() {
+        OpenObject open = stack.back();
+        stack.pop_back();
+
+        // Lights sit at the object's position, which may have been read
+        // after its components
+        for (PointLight& light : open.lights) {
+            light.SetPosition(open.object->position);
+            open.object->AddLight(light);
+        }
+
+        if (stack.empty()) {
+            results.push_back(open.object);
+            if (progress) {
+                progress->store(Progress());
+            }
+        } else {
+            Top().object->AddChild(open.object);
+        }
+    }
+};
+
+// Reads the single-object persistence format written by SaveObjectToJson
+class ObjectStreamReader : public JsonStreamReader {
+public:
+    ObjectStreamReader() : object(new GameObject()) {}
+
+    ~ObjectStreamReader() {
+        delete object;
+    }
+
+    GameObject* TakeObject() {
+        GameObject* result = object;
+        object = nullptr;
+        return result;
+    }
+
+protected:
+    bool OnBeginObject() override {
+        if (Depth() == 2 && KeyAt(0) == "lights" && CurrentKey() == "[]") {
+            light = PointLight();
+        }
+        return true;
+    }
+
+    bool OnEndObject() override {
+        if (Depth() == 2 && KeyAt(0) == "lights") {
+            object->AddLight(light);
+        }
+        return true;
+    }
+
+    bool OnString(const std::string& value) override {
+        if (Depth() == 1 && CurrentKey() == "name") {
+            object->SetName(value);
+        }
+        return true;
+    }
+
+    bool OnNumber(double number) override {
+        float value = static_cast<float>(number);
+        if (Depth() == 2) {
+            const std::string& member = KeyAt(0);
+            if (member == "position") {
+                SetAxis(object->position, CurrentKey(), value);
+            } else if (member == "rotation") {
+                SetAxis(object->rotation, CurrentKey(), value);
+            } else if (member == "size" || member == "scale") {
+                SetAxis(object->size, CurrentKey(), value);
+            }
+        } else if (Depth() == 3 && KeyAt(0) == "lights") {
+            if (CurrentKey() == "intensity") {
+                light.SetIntensity(value);
+            } else if (CurrentKey() == "range") {
+                light.SetRange(value);
+            }
+        } else if (Depth() == 4 && KeyAt(0) == "lights") {
+            if (KeyAt(2) == "position") {
+                Vector3 position = light.GetPosition();
+                SetAxis(position, CurrentKey(), value);
+                light.SetPosition(position);
+            } else if (KeyAt(2) == "color") {
+                Vector3 color = light.GetColor();
+                SetAxis(color, CurrentKey(), value);
+                light.SetColor(color);
+            }
+        }
+        return true;
+    }
+
+private:
+    GameObject* object;
+    PointLight light;
+};
+
+} // namespace
 
 void SceneSerializer::SaveObjectToJson(const GameObject* obj, const std::string& filepath) {
     if (!obj) {
@@ -40,40 +352,198 @@ void SceneSerializer::SaveObjectToJson(const GameObject* obj, const std::string&
 }
 
 GameObject* SceneSerializer::LoadObjectFromJson(const std::string& filepath) {
-    try {
-        // Open file
-        std::ifstream file(filepath);
-        if (!file.is_open()) {
-            std::cerr << "Error: Could not open file for reading: " << filepath << std::endl;
-            return nullptr;
+    ObjectStreamReader reader;
+    if (!reader.ParseFile(filepath)) {
+        return nullptr;
+    }
+
+    std::cout << "GameObject loaded from: " << filepath << std::endl;
+    return reader.TakeObject();
+}
+
+bool SceneSerializer::LoadSceneFromJson(const std::string& filepath, std::vector<GameObject*>& objects,
+                                        std::atomic<float>* progress) {
+    SceneStreamReader reader(progress);
+    if (!reader.ParseFile(filepath)) {
+        return false;
+    }
+    if (!reader.FoundObjects()) {
+        std::cerr << "Error: Scene file has no objects array: " << filepath << std::endl;
+        return false;
+    }
+
+    reader.TakeObjects(objects);
+    if (progress) {
+        progress->store(1.0f);
+    }
+    return true;
+}
+
+bool SceneSerializer::LoadSceneFile(const std::string& filepath, std::vector<GameObject*>& objects,
+                                    std::atomic<float>* progress) {
+    if (!BinaryScene::IsBinarySceneFile(filepath)) {
+        return LoadSceneFromJson(filepath, objects, progress);
+    }
+
+    BinaryScene scene;
+    return scene.Open(filepath) && InstantiateBinaryScene(scene, objects, progress);
+}
+
+bool SceneSerializer::InstantiateBinaryScene(const BinaryScene& scene, std::vector<GameObject*>& result,
+                                             std::atomic<float>* progress) {
+    const BinaryScene::ObjectRecord* objects = scene.GetObjects();
+    const BinaryScene::LightRecord* lights = scene.GetLights();
+    const BinaryScene::MeshRecord* meshes = scene.GetMeshes();
+    size_t objectCount = scene.GetObjectCount();
+
+    std::vector<GameObject*> created(objectCount, nullptr);
+    for (size_t i = 0; i < objectCount; i++) {
+        const BinaryScene::ObjectRecord& record = objects[i];
+
+        Vector3 position(0, 0, 0);
+        Vector3 rotation(0, 0, 0);
+        Vector3 scale(1, 1, 1);
+        if (record.flags & BinaryScene::HAS_POSITION) {
+            position = Vector3(record.position[0], record.position[1], record.position[2]);
         }
-        
-        // Parse JSON
-        nlohmann::json j;
-        file >> j;
-        
-        // Create GameObject
-        std::string name = j["name"].get<std::string>();
-        Vector3 position = DeserializeVector3(j["position"]);
-        Vector3 rotation = DeserializeVector3(j["rotation"]);
-        Vector3 size = DeserializeVector3(j["size"]);
-        
-        GameObject* gameObject = new GameObject(name, position, rotation, size);
-        
-        // Deserialize lights
-        if (j.contains("lights") && j["lights"].is_array()) {
-            for (const auto& lightJson : j["lights"]) {
-                gameObject->AddLight(DeserializePointLight(lightJson));
+        if (record.flags & BinaryScene::HAS_ROTATION) {
+            rotation = Vector3(record.rotation[0], record.rotation[1], record.rotation[2]);
+        }
+        if (record.flags & BinaryScene::HAS_SCALE) {
+            scale = Vector3(record.scale[0], record.scale[1], record.scale[2]);
+        }
+
+        std::string name = record.name == BinaryScene::NO_STRING ? std::string("GameObject") : std::string(scene.GetString(record.name));
+        GameObject* gameObject = new GameObject(name, position, rotation, scale);
+        created[i] = gameObject;
+
+        for (uint32_t l = 0; l < record.lightCount; l++) {
+            const BinaryScene::LightRecord& source = lights[record.firstLight + l];
+            PointLight light;
+            light.SetPosition(position);
+            light.SetColor(Vector3(source.color[0], source.color[1], source.color[2]));
+            light.SetIntensity(source.intensity);
+            light.SetRange(source.range);
+            gameObject->AddLight(light);
+        }
+
+        for (uint32_t m = 0; m < record.meshCount; m++) {
+            const BinaryScene::MeshRecord& source = meshes[record.firstMesh + m];
+            Model* model = new Model();
+            if (!model->ParseFromFile(scene.GetString(source.model))) {
+                std::cerr << "Error: Could not load mesh '" << scene.GetString(source.model) << "' for " << name << std::endl;
+                delete model;
+                continue;
             }
+            model->SetTexturePath(scene.GetString(source.texture));
+            gameObject->AddMesh(model);
+        }
+
+        // Parents precede their children (checked by BinaryScene::Open)
+        if (record.parent == BinaryScene::NO_PARENT) {
+            result.push_back(gameObject);
+        } else {
+            created[record.parent]->AddChild(gameObject);
+        }
+        if (progress) {
+            progress->store(static_cast<float>(i + 1) / static_cast<float>(objectCount));
         }
-        
-        std::cout << "GameObject loaded from: " << filepath << std::endl;
-        return gameObject;
     }
-    catch (const std::exception& e) {
-        std::cerr << "Error deserializing GameObject: " << e.what() << std::endl;
-        return nullptr;
+    if (progress) {
+        progress->store(1.0f);
+    }
+    return true;
+}
+
+bool SceneSerializer::SaveSceneToJson(const std::vector<GameObject*>& objects, const std::string& filepath,
+                                      const nlohmann::json& header) {
+    std::ofstream file(filepath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open scene file for writing: " << filepath << std::endl;
+        return false;
+    }
+
+    file << "{\n";
+    for (auto it = header.begin(); it != header.end(); ++it) {
+        file << nlohmann::json(it.key()).dump() << ": " << it.value().dump() << ",\n";
+    }
+    file << "\"objects\": [";
+    for (size_t i = 0; i < objects.size(); i++) {
+        file << (i > 0 ? ",\n" : "\n") << SerializeSceneObject(objects[i], true).dump();
+    }
+    file << "\n]\n}\n";
+
+    file.flush();
+    if (!file) {
+        std::cerr << "Error: Failed writing scene file: " << filepath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+nlohmann::json SceneSerializer::SerializeSceneObject(const GameObject* obj, bool includeChildren) {
+    nlohmann::json j;
+    if (obj->GetPersistentId() != 0) {
+        j["id"] = obj->GetPersistentId();
+    }
+    j["name"] = obj->GetName();
+    if (!obj->IsEnabled()) {
+        j["enabled"] = false;
+    }
+    j["position"] = SerializeVector3(obj->position);
+    j["rotation"] = SerializeVector3(obj->rotation);
+    j["scale"] = SerializeVector3(obj->size);
+
+    nlohmann::json components = SerializeSceneComponents(obj);
+    if (!components.empty()) {
+        j["components"] = components;
     }
+
+    if (includeChildren && !obj->childGameObjects.empty()) {
+        nlohmann::json children = nlohmann::json::array();
+        for (const GameObject* child : obj->childGameObjects) {
+            children.push_back(SerializeSceneObject(child, true));
+        }
+        j["children"] = children;
+    }
+    return j;
+}
+
+nlohmann::json SceneSerializer::SerializeSceneComponents(const GameObject* obj) {
+    nlohmann::json components = nlohmann::json::array();
+    for (const PointLight& light : obj->lights) {
+        nlohmann::json properties;
+        properties["type"] = "point";
+        properties["color"] = { {"r", light.GetColor().x}, {"g", light.GetColor().y}, {"b", light.GetColor().z} };
+        properties["intensity"] = light.GetIntensity();
+        properties["range"] = light.GetRange();
+        components.push_back({ {"type", "Light"}, {"properties", properties} });
+    }
+    for (const Model* mesh : obj->meshes) {
+        // Generated meshes have no file to reference
+        if (!mesh || mesh->GetSourcePath().empty()) {
+            continue;
+        }
+        nlohmann::json properties;
+        properties["model"] = mesh->GetSourcePath();
+        properties["texture"] = mesh->GetTexturePath();
+        components.push_back({ {"type", "Mesh"}, {"properties", properties} });
+    }
+    return components;
+}
+
+void SceneSerializer::DestroySceneObjects(std::vector<GameObject*>& objects) {
+    for (GameObject* object : objects) {
+        if (!object) {
+            continue;
+        }
+        DestroySceneObjects(object->childGameObjects);
+        for (Model* mesh : object->meshes) {
+            delete mesh;
+        }
+        delete object;
+    }
+    objects.clear();
 }
 
 nlohmann::json SceneSerializer::SerializeVector3(const Vector3& vec) {
@@ -84,28 +554,11 @@ nlohmann::json SceneSerializer::SerializeVector3(const Vector3& vec) {
     return j;
 }
 
-Vector3 SceneSerializer::DeserializeVector3(const nlohmann::json& json) {
-    return Vector3(
-        json["x"].get<float>(),
-        json["y"].get<float>(),
-        json["z"].get<float>()
-    );
-}
-
 nlohmann::json SceneSerializer::SerializePointLight(const PointLight& light) {
     nlohmann::json j;
-    j["position"] = SerializeVector3(light.position);
-    j["color"] = SerializeVector3(light.color);
-    j["intensity"] = light.intensity;
-    j["range"] = light.range;
+    j["position"] = SerializeVector3(light.GetPosition());
+    j["color"] = SerializeVector3(light.GetColor());
+    j["intensity"] = light.GetIntensity();
+    j["range"] = light.GetRange();
     return j;
 }
-
-PointLight SceneSerializer::DeserializePointLight(const nlohmann::json& json) {
-    PointLight light;
-    light.position = DeserializeVector3(json["position"]);
-    light.color = DeserializeVector3(json["color"]);
-    light.intensity = json["intensity"].get<float>();
-    light.range = json["range"].get<float>();
-    return light;
-}
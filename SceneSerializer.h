@@ -3,11 +3,15 @@
 
 #include <string>
 #include <memory>
+#include <vector>
+#include <atomic>
 #include "GameObject.h"
 #include "Vector3.h"
 #include "PointLight.h"
 #include "ThirdParty/json/json.hpp"
 
+class BinaryScene;
+
 /**
  * @class SceneSerializer
  * @brief Handles serialization and deserialization of scene objects to/from JSON
@@ -31,7 +35,84 @@ public:
      */
     static GameObject* LoadObjectFromJson(const std::string& filepath);
     
+    /**
+     * @brief Loads every object of a scene file (the Examples/RPG/Scenes format)
+     * @param filepath The path to the scene JSON file
+     * @param objects Receives the loaded top-level objects; the caller owns them
+     * @param progress If set, the fraction of the file read so far (0 to 1),
+     *        updated after each top-level object; other threads may read it
+     * @return True if the file was read and parsed
+     *
+     * The file is read as a stream (see JsonStreamReader): objects are
+     * built while parsing, without an intermediate JSON document.
+     * "Mesh" components are parsed into Models without creating graphics
+     * buffers. Nothing here touches a Scene or the graphics API, so it is
+     * safe to call from a worker thread; call Model::InitializeBuffers on
+     * the main thread before rendering (Scene::Load does this).
+     */
+    static bool LoadSceneFromJson(const std::string& filepath, std::vector<GameObject*>& objects,
+                                  std::atomic<float>* progress = nullptr);
+    
+    /**
+     * @brief Loads a scene file in either format
+     * @param filepath A JSON scene or a binary scene (see BinaryScene)
+     * @param objects Receives the loaded top-level objects; the caller owns them
+     * @param progress If set, the fraction of the scene loaded so far (0 to 1):
+     *        bytes read for JSON, objects built for binary scenes
+     * @return True if the file was read and parsed
+     *
+     * The format is detected from the file contents. Safe to call from a
+     * worker thread, like LoadSceneFromJson.
+     */
+    static bool LoadSceneFile(const std::string& filepath, std::vector<GameObject*>& objects,
+                              std::atomic<float>* progress = nullptr);
+    
+    /**
+     * @brief Writes objects in the scene file format read by LoadSceneFromJson
+     * @param objects The top-level objects; children are written nested
+     * @param filepath The path of the scene file
+     * @param header Extra top-level members, written before "objects"
+     * @return True if the file was written
+     *
+     * Objects are written one at a time, so no document for the whole scene
+     * is built. Light and Mesh components are saved; gameplay components are
+     * not serializable and are left out.
+     */
+    static bool SaveSceneToJson(const std::vector<GameObject*>& objects, const std::string& filepath,
+                                const nlohmann::json& header = nlohmann::json::object());
+    
+    /**
+     * @brief Serializes one object in the scene file format
+     * @param obj The object to serialize
+     * @param includeChildren Whether to nest the object's children
+     * @return The object entry
+     */
+    static nlohmann::json SerializeSceneObject(const GameObject* obj, bool includeChildren);
+    
+    /**
+     * @brief Serializes the Light and Mesh components of an object
+     * @param obj The object whose lights and meshes are written
+     * @return The "components" array of a scene object entry
+     */
+    static nlohmann::json SerializeSceneComponents(const GameObject* obj);
+    
+    /**
+     * @brief Deletes objects returned by LoadSceneFromJson, with their children and meshes
+     * @param objects The objects to delete; cleared on return
+     */
+    static void DestroySceneObjects(std::vector<GameObject*>& objects);
+    
 private:
+    /**
+     * @brief Builds the top-level objects of a binary scene from its mapped records
+     * @param scene An open binary scene
+     * @param objects Receives the top-level objects
+     * @param progress If set, the fraction of the records built so far
+     * @return True on success
+     */
+    static bool InstantiateBinaryScene(const BinaryScene& scene, std::vector<GameObject*>& objects,
+                                       std::atomic<float>* progress = nullptr);
+    
     /**
      * @brief Serializes a Vector3 to JSON
      * @param vec The Vector3 to serialize
@@ -39,26 +120,12 @@ private:
      */
     static nlohmann::json SerializeVector3(const Vector3& vec);
     
-    /**
-     * @brief Deserializes a Vector3 from JSON
-     * @param json The JSON object containing Vector3 data
-     * @return The deserialized Vector3
-     */
-    static Vector3 DeserializeVector3(const nlohmann::json& json);
-    
     /**
      * @brief Serializes a PointLight to JSON
      * @param light The PointLight to serialize
      * @return JSON object representing the PointLight
      */
     static nlohmann::json SerializePointLight(const PointLight& light);
-    
-    /**
-     * @brief Deserializes a PointLight from JSON
-     * @param json The JSON object containing PointLight data
-     * @return The deserialized PointLight
-     */
-    static PointLight DeserializePointLight(const nlohmann::json& json);
 };
 
 #endif // SCENE_SERIALIZER_H
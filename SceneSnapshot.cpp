@@ -0,0 +1,271 @@
+#include "SceneSnapshot.h"
+#include "GameObject.h"
+#include "RigidBody.h"
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+    const unsigned int STATE_ENABLED = 1u << 0;
+
+    void Flatten(GameObject* object, std::vector<GameObject*>& out) {
+        if (!object) {
+            return;
+        }
+        out.push_back(object);
+        for (GameObject* child : object->childGameObjects) {
+            Flatten(child, out);
+        }
+    }
+
+    // Bitwise difference of two vectors (zero when equal). Integer compares
+    // are cheaper than float ones and treat an unchanged NaN as unchanged.
+    inline unsigned int Difference(const Vector3& a, const Vector3& b) {
+        unsigned int x[6];
+        std::memcpy(x, &a, sizeof(Vector3));
+        std::memcpy(x + 3, &b, sizeof(Vector3));
+        return (x[0] ^ x[3]) | (x[1] ^ x[4]) | (x[2] ^ x[5]);
+    }
+
+    inline unsigned int Difference(const SnapshotObjectState& state, const GameObject* object) {
+        return Difference(state.position, object->position) |
+               Difference(state.rotation, object->rotation) |
+               Difference(state.size, object->size) |
+               (state.flags ^ (object->IsEnabled() ? STATE_ENABLED : 0u));
+    }
+
+    inline void Store(SnapshotObjectState& state, const GameObject* object) {
+        state.position = object->position;
+        state.rotation = object->rotation;
+        state.size = object->size;
+        state.flags = object->IsEnabled() ? STATE_ENABLED : 0u;
+    }
+
+    inline void Apply(const SnapshotObjectState& state, GameObject* object) {
+        if (object->position != state.position || object->rotation != state.rotation || object->size != state.size) {
+            object->position = state.position;
+            object->rotation = state.rotation;
+            object->size = state.size;
+            object->MarkDirty(GameObject::DIRTY_TRANSFORM);
+        }
+        object->SetEnabled((state.flags & STATE_ENABLED) != 0);
+    }
+
+    inline void Apply(const SnapshotBodyState& state, RigidBody* body) {
+        body->velocity = state.velocity;
+        body->angularVelocity = state.angularVelocity;
+        body->force = Vector3();
+        body->torque = Vector3();
+    }
+
+    inline const SnapshotObjectState& StateAt(const SceneSnapshot::Chunk* const* chunks, size_t index) {
+        return chunks[index / SceneSnapshot::CHUNK_SIZE]->states[index % SceneSnapshot::CHUNK_SIZE];
+    }
+}
+
+size_t SceneSnapshot::CountSharedChunks(const SceneSnapshot& other) const {
+    size_t shared = 0;
+    size_t count = std::min(chunks.size(), other.chunks.size());
+    for (size_t i = 0; i < count; i++) {
+        if (chunks[i] == other.chunks[i]) {
+            shared++;
+        }
+    }
+    return shared;
+}
+
+SceneSnapshot SceneSnapshotter::Capture() {
+    if (LayoutChanged()) {
+        RebuildLayout();
+    }
+
+    SceneSnapshot snapshot;
+    snapshot.objects = layout;
+    snapshot.bodyIndices = bodyIndices;
+    snapshot.objectCount = layout->size();
+
+    const std::vector<GameObject*>& objects = *layout;
+    const size_t count = objects.size();
+    const size_t chunkCount = (count + SceneSnapshot::CHUNK_SIZE - 1) / SceneSnapshot::CHUNK_SIZE;
+    const bool sameLayout = (last.objects == layout);
+    snapshot.chunks.reserve(chunkCount);
+
+    for (size_t c = 0; c < chunkCount; c++) {
+        size_t begin = c * SceneSnapshot::CHUNK_SIZE;
+        size_t end = std::min(count, begin + SceneSnapshot::CHUNK_SIZE);
+
+        // Compare in place against the previous capture; most chunks are
+        // unchanged and are shared without being copied
+        std::shared_ptr<SceneSnapshot::Chunk> chunk;
+        size_t firstChanged = begin;
+        if (sameLayout && c < last.chunks.size()) {
+            // Only objects marked dirty since the last capture are compared
+            const SceneSnapshot::Chunk& previous = *last.chunks[c];
+            for (; firstChanged < end; firstChanged++) {
+                const GameObject* object = objects[firstChanged];
+                unsigned int changes = object->GetChangeCount();
+                if (changes != seenChanges[firstChanged]) {
+                    if (Difference(previous.states[firstChanged - begin], object) != 0) {
+                        break;
+                    }
+                    seenChanges[firstChanged] = changes;
+                }
+            }
+            if (firstChanged == end) {
+                snapshot.chunks.push_back(last.chunks[c]);
+                continue;
+            }
+            // Entries before the first change come along with the copy
+            chunk = std::make_shared<SceneSnapshot::Chunk>(previous);
+        } else {
+            // Value-initialized, so unused tail entries are zero
+            chunk = std::make_shared<SceneSnapshot::Chunk>();
+        }
+
+        for (size_t i = firstChanged; i < end; i++) {
+            Store(chunk->states[i - begin], objects[i]);
+            seenChanges[i] = objects[i]->GetChangeCount();
+        }
+        snapshot.chunks.push_back(chunk);
+    }
+
+    const std::vector<size_t>& indices = *bodyIndices;
+    snapshot.bodies.resize(indices.size());
+    for (size_t j = 0; j < indices.size(); j++) {
+        const RigidBody* body = bodies[indices[j]];
+        snapshot.bodies[j].velocity = body->velocity;
+        snapshot.bodies[j].angularVelocity = body->angularVelocity;
+    }
+
+    last = snapshot;
+    return snapshot;
+}
+
+void SceneSnapshotter::Restore(const SceneSnapshot& snapshot) {
+    if (!snapshot.IsValid()) {
+        return;
+    }
+
+    if (LayoutChanged()) {
+        RebuildLayout();
+    }
+
+    std::vector<const SceneSnapshot::Chunk*> chunks(snapshot.chunks.size());
+    for (size_t c = 0; c < chunks.size(); c++) {
+        chunks[c] = snapshot.chunks[c].get();
+    }
+    const std::vector<size_t>& snapshotBodies = *snapshot.bodyIndices;
+
+    if (snapshot.objects == layout) {
+        const std::vector<GameObject*>& objects = *layout;
+        for (size_t i = 0; i < objects.size(); i++) {
+            Apply(StateAt(chunks.data(), i), objects[i]);
+            seenChanges[i] = objects[i]->GetChangeCount();
+        }
+        for (size_t j = 0; j < snapshotBodies.size(); j++) {
+            Apply(snapshot.bodies[j], bodies[snapshotBodies[j]]);
+        }
+
+        // The scene now matches the snapshot, so the next capture can share all of it
+        last = snapshot;
+        return;
+    }
+
+    // Objects were added or removed since the capture; only those still in
+    // the scene are restored, using their current rigid bodies
+    std::unordered_map<GameObject*, size_t> present;
+    present.reserve(layout->size());
+    for (size_t i = 0; i < layout->size(); i++) {
+        present[(*layout)[i]] = i;
+    }
+
+    const std::vector<GameObject*>& captured = *snapshot.objects;
+    for (size_t i = 0; i < captured.size(); i++) {
+        auto it = present.find(captured[i]);
+        if (it != present.end()) {
+            Apply(StateAt(chunks.data(), i), captured[i]);
+        }
+    }
+    for (size_t j = 0; j < snapshotBodies.size(); j++) {
+        auto it = present.find(captured[snapshotBodies[j]]);
+        if (it != present.end() && bodies[it->second]) {
+            Apply(snapshot.bodies[j], bodies[it->second]);
+        }
+    }
+}
+
+bool SceneSnapshotter::LayoutChanged() const {
+    if (!layout || sceneObjects.size() != layoutSceneObjects.size()) {
+        return true;
+    }
+    // Compared as raw memory; an element-wise loop costs a third of a capture
+    return !sceneObjects.empty() &&
+           std::memcmp(sceneObjects.data(), layoutSceneObjects.data(), sceneObjects.size() * sizeof(GameObject*)) != 0;
+}
+
+void SceneSnapshotter::RebuildLayout() {
+    std::shared_ptr<std::vector<GameObject*>> flattened = std::make_shared<std::vector<GameObject*>>();
+    for (GameObject* object : sceneObjects) {
+        Flatten(object, *flattened);
+    }
+    layout = flattened;
+    layoutSceneObjects = sceneObjects;
+    seenChanges.assign(layout->size(), 0);
+
+    // Component lookup is slow, so it only happens when the layout changes
+    std::shared_ptr<std::vector<size_t>> indices = std::make_shared<std::vector<size_t>>();
+    bodies.assign(layout->size(), nullptr);
+    for (size_t i = 0; i < layout->size(); i++) {
+        std::vector<std::shared_ptr<RigidBody>> found = (*layout)[i]->GetComponents<RigidBody>();
+        if (!found.empty()) {
+            bodies[i] = found[0].get();
+            indices->push_back(i);
+        }
+    }
+    bodyIndices = indices;
+}
+
+SceneSnapshotHistory::SceneSnapshotHistory(size_t capacity)
+    : entries(std::max<size_t>(capacity, 1)), head(0), count(0) {
+}
+
+void SceneSnapshotHistory::Push(unsigned int tick, const SceneSnapshot& snapshot) {
+    size_t index = (head + count) % entries.size();
+    if (count == entries.size()) {
+        head = (head + 1) % entries.size();
+    } else {
+        count++;
+    }
+    entries[index].tick = tick;
+    entries[index].snapshot = snapshot;
+}
+
+const SceneSnapshot* SceneSnapshotHistory::Find(unsigned int tick) const {
+    for (size_t i = 0; i < count; i++) {
+        const Entry& entry = entries[(head + i) % entries.size()];
+        if (entry.tick == tick) {
+            return &entry.snapshot;
+        }
+    }
+    return nullptr;
+}
+
+void SceneSnapshotHistory::DiscardAfter(unsigned int tick) {
+    // Ticks are pushed in increasing order, so drop from the newest end
+    while (count > 0) {
+        Entry& newest = entries[(head + count - 1) % entries.size()];
+        if (newest.tick <= tick) {
+            break;
+        }
+        newest.snapshot = SceneSnapshot();
+        count--;
+    }
+}
+
+void SceneSnapshotHistory::Clear() {
+    for (Entry& entry : entries) {
+        entry.snapshot = SceneSnapshot();
+    }
+    head = 0;
+    count = 0;
+}
@@ -0,0 +1,139 @@
+#ifndef SCENE_SNAPSHOT_H
+#define SCENE_SNAPSHOT_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "Vector3.h"
+
+class GameObject;
+class RigidBody;
+
+// State of one object as stored in a snapshot. Plain floats only, so chunks
+// can be compared and copied with memcmp/memcpy.
+struct SnapshotObjectState {
+    Vector3 position;
+    Vector3 rotation;
+    Vector3 size;
+    unsigned int flags;
+};
+
+// Rigid body state, kept apart from the object states because few objects
+// have a body
+struct SnapshotBodyState {
+    Vector3 velocity;
+    Vector3 angularVelocity;
+};
+
+// Immutable copy of a scene's object state.
+//
+// Object state is stored in fixed-size chunks that are shared between
+// snapshots: a chunk in which no object changed since the previous capture
+// is reused by reference instead of copied. Copying a snapshot only copies
+// the chunk pointers.
+class SceneSnapshot {
+public:
+    // Small, so moving one object copies little
+    static const size_t CHUNK_SIZE = 16;
+
+    struct Chunk {
+        SnapshotObjectState states[CHUNK_SIZE];
+    };
+
+    SceneSnapshot() : objectCount(0) {}
+
+    bool IsValid() const { return objects != nullptr; }
+    size_t GetObjectCount() const { return objectCount; }
+    size_t GetChunkCount() const { return chunks.size(); }
+
+    // Number of chunks stored by both snapshots
+    size_t CountSharedChunks(const SceneSnapshot& other) const;
+
+private:
+    friend class SceneSnapshotter;
+
+    // Objects in capture order and the indices of those with a rigid body;
+    // shared while the scene layout is unchanged
+    std::shared_ptr<const std::vector<GameObject*>> objects;
+    std::shared_ptr<const std::vector<size_t>> bodyIndices;
+    std::vector<std::shared_ptr<const Chunk>> chunks;
+    std::vector<SnapshotBodyState> bodies;
+    size_t objectCount;
+};
+
+// Takes and restores snapshots of one scene's object list. Captures
+// transforms, the enabled flag and rigid body velocities of the objects
+// and their children.
+//
+// A capture only compares objects whose GameObject::GetChangeCount moved
+// since the previous one, so code that writes the public transform fields
+// directly must call MarkDirty. Rigid body velocities are always copied.
+//
+// Restoring only writes state back into objects that are still in the
+// scene: objects added after the capture keep their state and objects
+// removed since are skipped. The scene's object list is never changed.
+// Pointers are matched by address, so a snapshot must not outlive objects
+// that are deleted while it is held (Scene drops its reset point whenever
+// objects are added or removed).
+class SceneSnapshotter {
+public:
+    explicit SceneSnapshotter(std::vector<GameObject*>& sceneObjects) : sceneObjects(sceneObjects) {}
+
+    // Capture the current state, sharing unchanged chunks with the last capture
+    SceneSnapshot Capture();
+
+    // Write a snapshot back into the objects still in the scene
+    void Restore(const SceneSnapshot& snapshot);
+
+    // Rebuild the object list on the next capture (after reparenting or
+    // adding components; adding and removing scene objects is detected)
+    void InvalidateLayout() { layout.reset(); }
+
+private:
+    std::vector<GameObject*>& sceneObjects;
+
+    // Flattened scene hierarchy and the rigid body of each object
+    std::shared_ptr<const std::vector<GameObject*>> layout;
+    std::shared_ptr<const std::vector<size_t>> bodyIndices;
+    std::vector<GameObject*> layoutSceneObjects;
+    std::vector<RigidBody*> bodies;
+
+    // Change count of each object when it was stored into the last capture
+    std::vector<unsigned int> seenChanges;
+
+    SceneSnapshot last;
+
+    bool LayoutChanged() const;
+    void RebuildLayout();
+};
+
+// Fixed-size history of snapshots keyed by simulation tick, for rollback
+// in networked prediction. Consecutive snapshots share most of their chunks.
+class SceneSnapshotHistory {
+public:
+    explicit SceneSnapshotHistory(size_t capacity = 64);
+
+    // Store a snapshot for a tick, dropping the oldest when full
+    void Push(unsigned int tick, const SceneSnapshot& snapshot);
+
+    // Snapshot stored for a tick, or nullptr
+    const SceneSnapshot* Find(unsigned int tick) const;
+
+    // Forget every snapshot newer than the tick (after rolling back to it)
+    void DiscardAfter(unsigned int tick);
+
+    void Clear();
+    size_t GetCount() const { return count; }
+
+private:
+    struct Entry {
+        unsigned int tick;
+        SceneSnapshot snapshot;
+    };
+
+    std::vector<Entry> entries;
+    size_t head;
+    size_t count;
+};
+
+#endif // SCENE_SNAPSHOT_H
@@ -1,13 +1,19 @@
 #include "ShaderAsset.h"
+#include "../Core/Shader.h"
 #include "../Core/ShaderError.h"
+#include "../Core/ShaderSourceCache.h"
 #include "../../Debugger.h"
+#include <algorithm>
 #include <iostream>
+#include <set>
 #include <stdexcept>
 
 namespace Shaders {
 
 // Initialize static member
-std::unordered_map<std::string, ShaderProgram*> ShaderAsset::shaderPrograms;
+std::unordered_map<std::string, AssetHandle<ShaderProgram>> ShaderAsset::shaderPrograms;
+std::unordered_map<uint64_t, AssetHandle<ShaderProgram>> ShaderAsset::variantPrograms;
+std::unordered_map<std::string, uint64_t> ShaderAsset::variantHashes;
 
 ShaderProgram* ShaderAsset::LoadProgram(const std::string& vertPath, 
                                        const std::string& fragPath,
@@ -21,7 +27,142 @@ ShaderProgram* ShaderAsset::LoadProgram(const std::string& vertPath,
     // Check if we already have this shader program
     auto it = shaderPrograms.find(key);
     if (it != shaderPrograms.end()) {
-        return it->second;
+        return it->second.Get();
+    }
+    
+    // Load through the asset manager, which shares programs built from
+    // the same files
+    AssetHandle<ShaderProgram> program = AssetManager::GetInstance().LoadShaderProgram(vertPath, fragPath, geomPath);
+    if (!program) {
+        return nullptr;
+    }
+    
+    shaderPrograms[key] = program;
+    AttachInstancedVariant(program.Get(), vertPath, fragPath, std::vector<std::string>(), geomPath);
+    return program.Get();
+}
+
+ShaderProgram* ShaderAsset::LoadVariant(const std::string& vertPath,
+                                       const std::string& fragPath,
+                                       const std::vector<std::string>& keywords,
+                                       const std::string& geomPath) {
+    std::string joined = ShaderPreprocessor::JoinKeywords(keywords);
+    std::string key = vertPath + ":" + fragPath;
+    if (!geomPath.empty()) {
+        key += ":" + geomPath;
+    }
+    key += "|" + joined;
+    
+    auto known = variantHashes.find(key);
+    if (known != variantHashes.end()) {
+        return variantPrograms[known->second].Get();
+    }
+    
+    // Preprocess every stage (usually straight from the source cache) to
+    // find out which program this keyword set really builds
+    std::vector<std::string> stages = { vertPath, fragPath };
+    if (!geomPath.empty()) {
+        stages.push_back(geomPath);
+    }
+    uint64_t hash = 0;
+    std::set<std::string> declared;
+    for (const std::string& stage : stages) {
+        ShaderPreprocessor::Result preprocessed;
+        if (!ShaderSourceCache::GetInstance().Get(stage, keywords, preprocessed)) {
+            return nullptr;
+        }
+        hash ^= ShaderSourceCache::Hash(preprocessed.source) + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+        declared.insert(preprocessed.keywords.begin(), preprocessed.keywords.end());
+    }
+    
+    for (const std::string& keyword : ShaderPreprocessor::Canonicalize(keywords)) {
+        if (declared.count(keyword) == 0) {
+            std::cerr << "Error: Unknown shader keyword " << keyword << " for " << key << std::endl;
+            return nullptr;
+        }
+    }
+    
+    // Another keyword set may already have built the same sources
+    auto shared = variantPrograms.find(hash);
+    if (shared != variantPrograms.end()) {
+        variantHashes[key] = hash;
+        return shared->second.Get();
+    }
+    
+    AssetHandle<ShaderProgram> program =
+        AssetManager::GetInstance().LoadShaderProgram(vertPath, fragPath, geomPath, joined);
+    if (!program) {
+        return nullptr;
+    }
+    
+    variantPrograms[hash] = program;
+    variantHashes[key] = hash;
+    AttachInstancedVariant(program.Get(), vertPath, fragPath, keywords, geomPath);
+    return program.Get();
+}
+
+void ShaderAsset::AttachInstancedVariant(ShaderProgram* program,
+                                         const std::string& vertPath,
+                                         const std::string& fragPath,
+                                         const std::vector<std::string>& keywords,
+                                         const std::string& geomPath) {
+    static const std::string INSTANCING = "INSTANCING";
+    if (!program || program->GetInstancedVariant() ||
+        std::find(keywords.begin(), keywords.end(), INSTANCING) != keywords.end()) {
+        return;
+    }
+    
+    ShaderPreprocessor::Result vertex;
+    if (!ShaderSourceCache::GetInstance().Get(vertPath, keywords, vertex) ||
+        !std::binary_search(vertex.keywords.begin(), vertex.keywords.end(), INSTANCING)) {
+        return;
+    }
+    
+    // A variant that fails to build only costs the program its batching
+    std::vector<std::string> instancedKeywords = keywords;
+    instancedKeywords.push_back(INSTANCING);
+    ShaderProgram* instanced = LoadVariant(vertPath, fragPath, instancedKeywords, geomPath);
+    if (instanced && instanced != program) {
+        program->SetInstancedVariant(instanced);
+    }
+}
+
+ShaderProgram* ShaderAsset::GetProgram(const std::string& name) {
+    auto it = shaderPrograms.find(name);
+    if (it != shaderPrograms.end()) {
+        return it->second.Get();
+    }
+    return nullptr;
+}
+
+void ShaderAsset::Cleanup() {
+    // Instanced variants may be released below while their programs live on
+    for (auto& entry : shaderPrograms) {
+        entry.second->SetInstancedVariant(nullptr);
+    }
+    for (auto& entry : variantPrograms) {
+        entry.second->SetInstancedVariant(nullptr);
+    }
+    shaderPrograms.clear();
+    variantPrograms.clear();
+    variantHashes.clear();
+}
+
+} // namespace Shaders
+
+// Builds one program for the AssetManager. path is the vertex shader, the
+// other stages come from the settings written by LoadShaderProgram.
+ShaderProgram* AssetLoader<ShaderProgram>::Load(const std::string& path, const std::string& settings) {
+    const std::string& vertPath = path;
+    std::string fragPath = AssetManager::GetSetting(settings, "fragment");
+    std::string geomPath = AssetManager::GetSetting(settings, "geometry");
+    std::vector<std::string> keywords = ShaderPreprocessor::SplitKeywords(AssetManager::GetSetting(settings, "keywords"));
+    std::string key = vertPath + ":" + fragPath;
+    if (!geomPath.empty()) {
+        key += ":" + geomPath;
+    }
+    if (!keywords.empty()) {
+        key += "|" + ShaderPreprocessor::JoinKeywords(keywords);
     }
     
     // Use TryImport to handle errors
@@ -32,7 +173,7 @@ ShaderProgram* ShaderAsset::LoadProgram(const std::string& vertPath,
         
         // Create and compile vertex shader
         Shader* vertexShader = new Shader(Shader::VERTEX);
-        if (!vertexShader->LoadFromFile(vertPath)) {
+        if (!vertexShader->LoadFromFile(vertPath, keywords)) {
             throw std::runtime_error("Failed to load vertex shader from " + vertPath);
         }
         
@@ -42,7 +183,7 @@ ShaderProgram* ShaderAsset::LoadProgram(const std::string& vertPath,
         
         // Create and compile fragment shader
         Shader* fragmentShader = new Shader(Shader::FRAGMENT);
-        if (!fragmentShader->LoadFromFile(fragPath)) {
+        if (!fragmentShader->LoadFromFile(fragPath, keywords)) {
             delete vertexShader;
             throw std::runtime_error("Failed to load fragment shader from " + fragPath);
         }
@@ -60,7 +201,7 @@ ShaderProgram* ShaderAsset::LoadProgram(const std::string& vertPath,
         Shader* geometryShader = nullptr;
         if (!geomPath.empty()) {
             geometryShader = new Shader(Shader::GEOMETRY);
-            if (!geometryShader->LoadFromFile(geomPath)) {
+            if (!geometryShader->LoadFromFile(geomPath, keywords)) {
                 throw std::runtime_error("Failed to load geometry shader from " + geomPath);
             }
             
@@ -76,9 +217,6 @@ ShaderProgram* ShaderAsset::LoadProgram(const std::string& vertPath,
             throw std::runtime_error("Failed to link shader program: " + program->GetError());
         }
         
-        // Store in cache
-        shaderPrograms[key] = program;
-        
         // Log success
         std::cout << "Shader program loaded successfully: " << key << std::endl;
         
@@ -90,22 +228,20 @@ ShaderProgram* ShaderAsset::LoadProgram(const std::string& vertPath,
         program = nullptr;
     }
     
-    return success ? shaderPrograms[key] : nullptr;
+    return success ? program : nullptr;
 }
 
-ShaderProgram* ShaderAsset::GetProgram(const std::string& name) {
-    auto it = shaderPrograms.find(name);
-    if (it != shaderPrograms.end()) {
-        return it->second;
+bool AssetLoader<ShaderProgram>::Reload(ShaderProgram* program, const std::string& path, const std::string& settings) {
+    // A shader that no longer compiles leaves the running program alone
+    ShaderProgram* fresh = Load(path, settings);
+    if (!fresh) {
+        return false;
     }
-    return nullptr;
+    program->Swap(*fresh);
+    delete fresh;
+    return true;
 }
 
-void ShaderAsset::Cleanup() {
-    for (auto& pair : shaderPrograms) {
-        delete pair.second;
-    }
-    shaderPrograms.clear();
+void AssetLoader<ShaderProgram>::Unload(ShaderProgram* program) {
+    delete program;
 }
-
-} // namespace Shaders
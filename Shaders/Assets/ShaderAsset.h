@@ -2,8 +2,11 @@
 #define SHADER_ASSET_H
 
 #include "../Core/ShaderProgram.h"
+#include "../../AssetManager.h"
+#include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace Shaders {
 
@@ -24,6 +27,21 @@ public:
                                      const std::string& fragPath,
                                      const std::string& geomPath = "");
     
+    /**
+     * Load a variant of a shader program with some keywords enabled.
+     * Variants are compiled the first time they are asked for, and keyword
+     * sets that preprocess to the same sources share one program.
+     * @param vertPath Path to the vertex shader file
+     * @param fragPath Path to the fragment shader file
+     * @param keywords Keywords to define, each declared by at least one stage
+     * @param geomPath Path to the geometry shader file (optional)
+     * @return Pointer to the shader program, or nullptr if loading failed
+     */
+    static ShaderProgram* LoadVariant(const std::string& vertPath,
+                                      const std::string& fragPath,
+                                      const std::vector<std::string>& keywords,
+                                      const std::string& geomPath = "");
+    
     /**
      * Get a shader program by name
      * @param name Name of the shader program
@@ -32,13 +50,27 @@ public:
     static ShaderProgram* GetProgram(const std::string& name);
     
     /**
-     * Clean up all shader programs
+     * Release all shader programs held by name; programs still referenced
+     * elsewhere stay loaded in the AssetManager
      */
     static void Cleanup();
     
 private:
-    // Map of shader programs
-    static std::unordered_map<std::string, ShaderProgram*> shaderPrograms;
+    // Build the INSTANCING variant of a program whose vertex stage declares
+    // the keyword and hand it to the program, see ShaderProgram::GetInstancedVariant
+    static void AttachInstancedVariant(ShaderProgram* program,
+                                       const std::string& vertPath,
+                                       const std::string& fragPath,
+                                       const std::vector<std::string>& keywords,
+                                       const std::string& geomPath);
+    
+    // Shader programs by name ("vert:frag[:geom]")
+    static std::unordered_map<std::string, AssetHandle<ShaderProgram>> shaderPrograms;
+    
+    // Variants by the hash of their preprocessed sources, and the hash of
+    // each variant asked for by name ("vert:frag[:geom]|A,B")
+    static std::unordered_map<uint64_t, AssetHandle<ShaderProgram>> variantPrograms;
+    static std::unordered_map<std::string, uint64_t> variantHashes;
 };
 
 } // namespace Shaders
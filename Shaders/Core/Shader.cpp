@@ -1,10 +1,9 @@
 #include "Shader.h"
 #include "ShaderError.h"
+#include "ShaderSourceCache.h"
 #include "../../Debugger.h"
 #include "../../Graphics/Core/GraphicsAPIFactory.h"
 #include <iostream>
-#include <fstream>
-#include <sstream>
 #include <stdexcept>
 
 // Constructor
@@ -28,23 +27,16 @@ Shader::~Shader() {
 }
 
 // Load shader from file
-bool Shader::LoadFromFile(const std::string& filename) {
+bool Shader::LoadFromFile(const std::string& filename, const std::vector<std::string>& keywords) {
     return Debugger::GetInstance().TryImport([&]() -> bool {
-        // Open the file
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            throw std::runtime_error("Could not open shader file: " + filename);
+        // Expand includes and keywords, or reuse the cached expansion
+        ShaderPreprocessor::Result preprocessed;
+        if (!ShaderSourceCache::GetInstance().Get(filename, keywords, preprocessed)) {
+            throw std::runtime_error("Could not preprocess shader file: " + filename);
         }
         
-        // Read the file contents
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        
-        // Close the file
-        file.close();
-        
         // Load the shader from the string
-        return LoadFromString(buffer.str());
+        return LoadFromString(preprocessed.source);
     }, filename, "shader");
 }
 
@@ -75,14 +67,15 @@ bool Shader::Compile() {
     // Check if compilation was successful
     if (!graphics->GetShaderCompileStatus(handle)) {
         // Get the error message
-        std::string errorMessage = graphics->GetShaderInfoLog(handle);
+        error = graphics->GetShaderInfoLog(handle);
         
         // Print the error message
-        std::cerr << "Error compiling shader: " << errorMessage << std::endl;
+        std::cerr << "Error compiling shader: " << error << std::endl;
         
         return false;
     }
     
+    error.clear();
     return true;
 }
 
@@ -101,6 +94,12 @@ int Shader::GetShaderType() const {
             #else
             return 2; // D3D11_PIXEL_SHADER
             #endif
+        case GEOMETRY:
+            #ifndef PLATFORM_WINDOWS
+            return 0x8DD9; // GL_GEOMETRY_SHADER
+            #else
+            return 3; // D3D11_GEOMETRY_SHADER
+            #endif
         default:
             #ifndef PLATFORM_WINDOWS
             return 0x8B31; // GL_VERTEX_SHADER
@@ -1,29 +1,38 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "../../Graphics/Core/IGraphicsAPI.h"
 
 class Shader {
 public:
     enum Type {
         VERTEX,
-        FRAGMENT
+        FRAGMENT,
+        GEOMETRY
     };
     
     Shader(Type type);
     ~Shader();
     
-    bool LoadFromFile(const std::string& filename);
+    // Load a shader through the preprocessor, with the given keywords of
+    // its #pragma keywords line defined
+    bool LoadFromFile(const std::string& filename, const std::vector<std::string>& keywords = {});
     bool LoadFromString(const std::string& source, int shaderType = 0);
     bool Compile();
     
     unsigned int GetHandle() const { return handle; }
     Type GetType() const { return type; }
+    const std::string& GetSource() const { return source; }
+    
+    // Info log of the last failed compile
+    const std::string& GetError() const { return error; }
     
 private:
     unsigned int handle;
     Type type;
     std::string source;
+    std::string error;
     
     int GetShaderType() const;
 };
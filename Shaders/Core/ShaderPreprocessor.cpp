@@ -0,0 +1,199 @@
+#include "ShaderPreprocessor.h"
+#include "../../AssetManager.h"
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace {
+    struct State {
+        std::vector<std::string> files;
+        std::set<std::string> included;
+        std::set<std::string> declared;
+        std::string version;
+        std::string error;
+    };
+
+    bool ReadFile(const std::string& path, std::string& text) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        text = buffer.str();
+        return true;
+    }
+
+    // The directive on a line ("include", "pragma", ...) and what follows it;
+    // false for lines that are not directives
+    bool ParseDirective(const std::string& line, std::string& directive, std::string& rest) {
+        size_t i = line.find_first_not_of(" \t");
+        if (i == std::string::npos || line[i] != '#') {
+            return false;
+        }
+        i = line.find_first_not_of(" \t", i + 1);
+        if (i == std::string::npos) {
+            return false;
+        }
+        size_t end = i;
+        while (end < line.size() && (std::isalnum(static_cast<unsigned char>(line[end])) || line[end] == '_')) {
+            ++end;
+        }
+        directive = line.substr(i, end - i);
+        rest = line.substr(end);
+        return true;
+    }
+
+    std::vector<std::string> SplitWords(const std::string& text) {
+        std::vector<std::string> words;
+        std::istringstream stream(text);
+        std::string word;
+        while (stream >> word) {
+            words.push_back(word);
+        }
+        return words;
+    }
+
+    // Append a file to output. includedFrom is "file:line" of the #include
+    // directive, empty for the shader itself
+    bool Expand(const std::string& path, const std::string& includedFrom, State& state, std::string& output) {
+        std::string text;
+        if (!ReadFile(path, text)) {
+            state.error = "Could not open shader file: " + path;
+            if (!includedFrom.empty()) {
+                state.error += " (included from " + includedFrom + ")";
+            }
+            return false;
+        }
+
+        int fileIndex = static_cast<int>(state.files.size());
+        state.files.push_back(path);
+        state.included.insert(path);
+
+        size_t slash = path.find_last_of('/');
+        std::string folder = slash == std::string::npos ? "" : path.substr(0, slash + 1);
+
+        std::istringstream lines(text);
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(lines, line)) {
+            ++lineNumber;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+
+            // Directives are replaced by blank lines so line numbers still match
+            std::string directive;
+            std::string rest;
+            if (!ParseDirective(line, directive, rest)) {
+                output += line + "\n";
+                continue;
+            }
+
+            if (directive == "version") {
+                if (fileIndex != 0) {
+                    state.error = path + ":" + std::to_string(lineNumber) + ": #version in an included file";
+                    return false;
+                }
+                state.version = line;
+                output += "\n";
+            } else if (directive == "include") {
+                size_t open = rest.find_first_of("\"<");
+                size_t close = open == std::string::npos ? open : rest.find_first_of("\">", open + 1);
+                if (close == std::string::npos || close == open + 1) {
+                    state.error = path + ":" + std::to_string(lineNumber) + ": malformed #include";
+                    return false;
+                }
+                std::string include = AssetManager::NormalizePath(folder + rest.substr(open + 1, close - open - 1));
+                if (state.included.count(include) > 0) {
+                    output += "\n";
+                    continue;
+                }
+                output += "#line 1 " + std::to_string(state.files.size()) + "\n";
+                if (!Expand(include, path + ":" + std::to_string(lineNumber), state, output)) {
+                    return false;
+                }
+                output += "#line " + std::to_string(lineNumber + 1) + " " + std::to_string(fileIndex) + "\n";
+            } else if (directive == "pragma" && !SplitWords(rest).empty() && SplitWords(rest)[0] == "keywords") {
+                std::vector<std::string> words = SplitWords(rest);
+                state.declared.insert(words.begin() + 1, words.end());
+                output += "\n";
+            } else {
+                output += line + "\n";
+            }
+        }
+        return true;
+    }
+}
+
+bool ShaderPreprocessor::Process(const std::string& path, const std::vector<std::string>& keywords, Result& result,
+                                 std::string* error) {
+    State state;
+    std::string body;
+    if (!Expand(AssetManager::NormalizePath(path), "", state, body)) {
+        if (error) {
+            *error = state.error;
+        }
+        return false;
+    }
+
+    std::vector<std::string> enabled;
+    for (const std::string& keyword : Canonicalize(keywords)) {
+        if (state.declared.count(keyword) > 0) {
+            enabled.push_back(keyword);
+        }
+    }
+
+    // #version has to come first; the defines go between it and the body
+    std::string source;
+    if (!state.version.empty()) {
+        source += state.version + "\n";
+    }
+    for (const std::string& keyword : enabled) {
+        source += "#define " + keyword + " 1\n";
+    }
+    source += "#line 1 0\n";
+    source += body;
+
+    result.source = source;
+    result.files = state.files;
+    result.keywords.assign(state.declared.begin(), state.declared.end());
+    return true;
+}
+
+std::vector<std::string> ShaderPreprocessor::Canonicalize(const std::vector<std::string>& keywords) {
+    std::vector<std::string> sorted;
+    for (const std::string& keyword : keywords) {
+        if (!keyword.empty()) {
+            sorted.push_back(keyword);
+        }
+    }
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    return sorted;
+}
+
+std::string ShaderPreprocessor::JoinKeywords(const std::vector<std::string>& keywords) {
+    std::string joined;
+    for (const std::string& keyword : Canonicalize(keywords)) {
+        if (!joined.empty()) {
+            joined += ",";
+        }
+        joined += keyword;
+    }
+    return joined;
+}
+
+std::vector<std::string> ShaderPreprocessor::SplitKeywords(const std::string& keywords) {
+    std::vector<std::string> split;
+    std::istringstream stream(keywords);
+    std::string keyword;
+    while (std::getline(stream, keyword, ',')) {
+        keyword.erase(0, keyword.find_first_not_of(" \t"));
+        keyword.erase(keyword.find_last_not_of(" \t") + 1);
+        split.push_back(keyword);
+    }
+    return Canonicalize(split);
+}
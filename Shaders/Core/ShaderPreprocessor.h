@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Expands a GLSL file before it is compiled. Does not touch the graphics API,
+// so it can run on loader threads and in tests without a context.
+//
+//   #include "Include/lod_fade.glsl"   pasted in place, relative to the file;
+//                                      each file is included once, so
+//                                      cycles are harmless
+//   #pragma keywords NORMAL_MAP FOG    keywords a variant may enable
+//
+// Enabled keywords are defined right after #version. Those the file does
+// not declare are left out, so every stage of a program can be given the
+// same set and a stage that ignores it stays one variant.
+//
+// #line directives keep compiler errors pointing at the right line; the
+// second number is the index of the file in Result::files.
+class ShaderPreprocessor {
+public:
+    struct Result {
+        std::string source;                 // Ready to compile
+        std::vector<std::string> files;     // The file itself, then each include
+        std::vector<std::string> keywords;  // Declared by #pragma keywords, sorted
+    };
+
+    // Preprocess a file with some of its keywords enabled. Fails on missing
+    // files and malformed directives.
+    static bool Process(const std::string& path, const std::vector<std::string>& keywords, Result& result,
+                        std::string* error = nullptr);
+
+    // Sorted keywords without duplicates or empty names, so that every
+    // ordering of the same set names the same variant
+    static std::vector<std::string> Canonicalize(const std::vector<std::string>& keywords);
+
+    // "A,B" for a keyword set and back
+    static std::string JoinKeywords(const std::vector<std::string>& keywords);
+    static std::vector<std::string> SplitKeywords(const std::string& keywords);
+};
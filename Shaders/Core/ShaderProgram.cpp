@@ -4,10 +4,58 @@
 #include "../../Graphics/Core/GraphicsAPIFactory.h"
 #include "../../ThirdParty/OpenGL/include/GL/gl_definitions.h"
 #include <iostream>
+#include <mutex>
+#include <utility>
 #include <vector>
 
+namespace {
+    // Location of a uniform that has not been looked up yet
+    const int UNRESOLVED = -2;
+
+    // Ids of the uniforms the shared blocks stand in for
+    struct SharedUniformIds {
+        int time;
+        int deltaTime;
+        int numPointLights;
+        int numDirectionalLights;
+        int pointLights[ShaderUniforms::MAX_POINT_LIGHTS][4];
+        int directionalLights[ShaderUniforms::MAX_DIRECTIONAL_LIGHTS][3];
+        int view;
+        int projection;
+        int viewPos;
+    };
+
+    const SharedUniformIds& GetSharedUniformIds() {
+        static SharedUniformIds ids;
+        static std::once_flag once;
+        std::call_once(once, []() {
+            ids.time = ShaderUniforms::GetId("time");
+            ids.deltaTime = ShaderUniforms::GetId("deltaTime");
+            ids.numPointLights = ShaderUniforms::GetId("numPointLights");
+            ids.numDirectionalLights = ShaderUniforms::GetId("numDirectionalLights");
+            for (int i = 0; i < ShaderUniforms::MAX_POINT_LIGHTS; i++) {
+                std::string prefix = "pointLights[" + std::to_string(i) + "].";
+                ids.pointLights[i][0] = ShaderUniforms::GetId(prefix + "position");
+                ids.pointLights[i][1] = ShaderUniforms::GetId(prefix + "color");
+                ids.pointLights[i][2] = ShaderUniforms::GetId(prefix + "intensity");
+                ids.pointLights[i][3] = ShaderUniforms::GetId(prefix + "range");
+            }
+            for (int i = 0; i < ShaderUniforms::MAX_DIRECTIONAL_LIGHTS; i++) {
+                std::string prefix = "directionalLights[" + std::to_string(i) + "].";
+                ids.directionalLights[i][0] = ShaderUniforms::GetId(prefix + "direction");
+                ids.directionalLights[i][1] = ShaderUniforms::GetId(prefix + "color");
+                ids.directionalLights[i][2] = ShaderUniforms::GetId(prefix + "intensity");
+            }
+            ids.view = ShaderUniforms::GetId("view");
+            ids.projection = ShaderUniforms::GetId("projection");
+            ids.viewPos = ShaderUniforms::GetId("viewPos");
+        });
+        return ids;
+    }
+}
+
 // Constructor
-ShaderProgram::ShaderProgram() : handle(0) {
+ShaderProgram::ShaderProgram() : handle(0), blockMask(0), instancedVariant(nullptr) {
     // Create a new shader program
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
     if (graphics) {
@@ -55,14 +103,16 @@ bool ShaderProgram::Link() {
     // Check if linking was successful
     if (!graphics->GetProgramLinkStatus(handle)) {
         // Get the error message
-        std::string errorMessage = graphics->GetProgramInfoLog(handle);
+        error = graphics->GetProgramInfoLog(handle);
         
         // Print the error message
-        std::cerr << "Error linking shader program: " << errorMessage << std::endl;
+        std::cerr << "Error linking shader program: " << error << std::endl;
         
         return false;
     }
     
+    error.clear();
+    ResolveUniforms();
     return true;
 }
 
@@ -76,90 +126,209 @@ void ShaderProgram::Use() const {
     }
 }
 
+// Exchange program objects and their uniform locations
+void ShaderProgram::Swap(ShaderProgram& other) {
+    std::swap(handle, other.handle);
+    locations.swap(other.locations);
+    std::swap(blockMask, other.blockMask);
+}
+
+// Adopt a program handle
+void ShaderProgram::SetHandle(unsigned int h) {
+    handle = h;
+    ResolveUniforms();
+}
+
+// Resolve uniform locations and uniform block bindings
+void ShaderProgram::ResolveUniforms() {
+    locations.clear();
+    blockMask = 0;
+    
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    if (!graphics || handle == 0) {
+        return;
+    }
+    
+    std::vector<std::string> names;
+    std::vector<int> active;
+    graphics->GetActiveUniforms(handle, names, active);
+    
+    // Every id known so far is resolved; inactive ones are -1
+    std::vector<int> ids;
+    ids.reserve(names.size());
+    for (const std::string& name : names) {
+        ids.push_back(ShaderUniforms::GetId(name));
+    }
+    locations.assign(ShaderUniforms::GetIdCount(), -1);
+    for (size_t i = 0; i < ids.size(); i++) {
+        locations[ids[i]] = active[i];
+    }
+    
+    for (int block = 0; block < ShaderUniforms::BLOCK_COUNT; block++) {
+        ShaderUniforms::Block sharedBlock = static_cast<ShaderUniforms::Block>(block);
+        if (graphics->SetUniformBlockBinding(handle, ShaderUniforms::GetBlockName(sharedBlock), block)) {
+            blockMask |= 1u << block;
+        }
+    }
+}
+
+// Set the shared uniforms this program has no block for
+void ShaderProgram::SetSharedUniforms() {
+    const SharedUniformIds& ids = GetSharedUniformIds();
+    ShaderUniforms& shared = ShaderUniforms::GetInstance();
+    
+    if (!HasUniformBlock(ShaderUniforms::FRAME_BLOCK)) {
+        const ShaderUniforms::FrameData& frame = shared.GetFrameData();
+        SetUniform(ids.time, frame.time);
+        SetUniform(ids.deltaTime, frame.deltaTime);
+        
+        SetUniform(ids.numPointLights, frame.numPointLights);
+        for (int i = 0; i < frame.numPointLights; i++) {
+            const ShaderUniforms::PointLightData& light = frame.pointLights[i];
+            SetUniform(ids.pointLights[i][0], light.position[0], light.position[1], light.position[2]);
+            SetUniform(ids.pointLights[i][1], light.color[0], light.color[1], light.color[2]);
+            SetUniform(ids.pointLights[i][2], light.intensity);
+            SetUniform(ids.pointLights[i][3], light.range);
+        }
+        
+        SetUniform(ids.numDirectionalLights, frame.numDirectionalLights);
+        for (int i = 0; i < frame.numDirectionalLights; i++) {
+            const ShaderUniforms::DirectionalLightData& light = frame.directionalLights[i];
+            SetUniform(ids.directionalLights[i][0], light.direction[0], light.direction[1], light.direction[2]);
+            SetUniform(ids.directionalLights[i][1], light.color[0], light.color[1], light.color[2]);
+            SetUniform(ids.directionalLights[i][2], light.intensity);
+        }
+    }
+    
+    if (!HasUniformBlock(ShaderUniforms::CAMERA_BLOCK)) {
+        const ShaderUniforms::CameraData& camera = shared.GetCameraData();
+        auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+        if (graphics) {
+            graphics->SetUniformMatrix4fv(GetUniformLocation(ids.view), camera.view);
+            graphics->SetUniformMatrix4fv(GetUniformLocation(ids.projection), camera.projection);
+        }
+        SetUniform(ids.viewPos, camera.viewPos[0], camera.viewPos[1], camera.viewPos[2]);
+    }
+}
+
 // Get the location of a uniform
 int ShaderProgram::GetUniformLocation(const std::string& name) {
-    // Check if we already have the location cached
-    auto it = uniformLocations.find(name);
-    if (it != uniformLocations.end()) {
-        return it->second;
+    return GetUniformLocation(ShaderUniforms::GetId(name));
+}
+
+// Get the location of a uniform by id
+int ShaderProgram::GetUniformLocation(int id) {
+    if (id < 0) {
+        return -1;
+    }
+    if (id < static_cast<int>(locations.size()) && locations[id] != UNRESOLVED) {
+        return locations[id];
     }
     
-    // Get the location using the graphics API
+    // Names first used after the program linked, or programs that were
+    // never resolved, are looked up once
+    if (id >= static_cast<int>(locations.size())) {
+        locations.resize(id + 1, UNRESOLVED);
+    }
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
     int location = -1;
-    
-    if (graphics) {
-        // Use the graphics API to get the uniform location
-        location = graphics->GetUniformLocation(handle, name);
+    if (graphics && handle != 0) {
+        location = graphics->GetUniformLocation(handle, ShaderUniforms::GetName(id));
     }
-    
-    // Cache the location
-    uniformLocations[name] = location;
-    
+    locations[id] = location;
     return location;
 }
 
-// Set a float uniform
-void ShaderProgram::SetUniform(const std::string& name, float value) {
+// Set a float uniform by id
+void ShaderProgram::SetUniform(int id, float value) {
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
     if (graphics) {
-        graphics->SetUniform1f(handle, name, value);
+        graphics->SetUniform1f(GetUniformLocation(id), value);
     }
 }
 
-// Set an int uniform
-void ShaderProgram::SetUniform(const std::string& name, int value) {
+// Set an int uniform by id
+void ShaderProgram::SetUniform(int id, int value) {
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
     if (graphics) {
-        graphics->SetUniform1i(handle, name, value);
+        graphics->SetUniform1i(GetUniformLocation(id), value);
     }
 }
 
-// Set a bool uniform
-void ShaderProgram::SetUniform(const std::string& name, bool value) {
+// Set a bool uniform by id
+void ShaderProgram::SetUniform(int id, bool value) {
+    SetUniform(id, value ? 1 : 0);
+}
+
+// Set a vec3 uniform by id
+void ShaderProgram::SetUniform(int id, float x, float y, float z) {
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
     if (graphics) {
-        graphics->SetUniform1i(handle, name, value ? 1 : 0);
+        graphics->SetUniform3f(GetUniformLocation(id), x, y, z);
     }
 }
 
-// Set a vec3 uniform
-void ShaderProgram::SetUniform(const std::string& name, float x, float y, float z) {
+// Set a vec4 uniform by id
+void ShaderProgram::SetUniform(int id, float x, float y, float z, float w) {
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
     if (graphics) {
-        graphics->SetUniform3f(handle, name, x, y, z);
+        graphics->SetUniform4f(GetUniformLocation(id), x, y, z, w);
     }
 }
 
-// Set a vec4 uniform
-void ShaderProgram::SetUniform(const std::string& name, float x, float y, float z, float w) {
+// Set a Vector3 uniform by id
+void ShaderProgram::SetUniform(int id, const Vector3& value) {
+    SetUniform(id, value.x, value.y, value.z);
+}
+
+// Set a Matrix4x4 uniform by id
+void ShaderProgram::SetUniform(int id, const Matrix4x4& value) {
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
     if (graphics) {
-        graphics->SetUniform4f(handle, name, x, y, z, w);
+        graphics->SetUniformMatrix4fv(GetUniformLocation(id), &value.elements[0][0]);
     }
 }
 
+// Set a float uniform
+void ShaderProgram::SetUniform(const std::string& name, float value) {
+    SetUniform(ShaderUniforms::GetId(name), value);
+}
+
+// Set an int uniform
+void ShaderProgram::SetUniform(const std::string& name, int value) {
+    SetUniform(ShaderUniforms::GetId(name), value);
+}
+
+// Set a bool uniform
+void ShaderProgram::SetUniform(const std::string& name, bool value) {
+    SetUniform(ShaderUniforms::GetId(name), value);
+}
+
+// Set a vec3 uniform
+void ShaderProgram::SetUniform(const std::string& name, float x, float y, float z) {
+    SetUniform(ShaderUniforms::GetId(name), x, y, z);
+}
+
+// Set a vec4 uniform
+void ShaderProgram::SetUniform(const std::string& name, float x, float y, float z, float w) {
+    SetUniform(ShaderUniforms::GetId(name), x, y, z, w);
+}
+
 // Set a Vector3 uniform
 void ShaderProgram::SetUniform(const std::string& name, const Vector3& value) {
-    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
-    if (graphics) {
-        graphics->SetUniform3f(handle, name, value.x, value.y, value.z);
-    }
+    SetUniform(ShaderUniforms::GetId(name), value);
 }
 
 // Set a Matrix4x4 uniform
 void ShaderProgram::SetUniform(const std::string& name, const Matrix4x4& value) {
-    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
-    if (graphics) {
-        graphics->SetUniformMatrix4fv(handle, name, &value.elements[0][0]);
-    }
+    SetUniform(ShaderUniforms::GetId(name), value);
 }
 
 // Set a matrix uniform
 void ShaderProgram::SetUniform(const std::string& name, const float* matrix, bool transpose) {
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
     if (graphics) {
-        graphics->SetUniformMatrix4fv(handle, name, matrix, transpose);
+        graphics->SetUniformMatrix4fv(GetUniformLocation(name), matrix, transpose);
     }
 }
 
@@ -168,7 +337,7 @@ void ShaderProgram::SetUniform(const std::string& name, GLuint textureID, GLuint
     auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
     if (graphics) {
         graphics->BindTexture(textureID, textureUnit);
-        graphics->SetUniform1i(handle, name, textureUnit);
+        graphics->SetUniform1i(GetUniformLocation(name), textureUnit);
     }
 }
 
@@ -178,7 +347,7 @@ void ShaderProgram::SetUniformArray(const std::string& name, const float* values
     if (location != -1) {
         auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
         if (graphics) {
-            graphics->SetUniformFloatArray(handle, name, values, count);
+            graphics->SetUniformFloatArray(location, values, count);
         }
     }
 }
@@ -189,7 +358,7 @@ void ShaderProgram::SetUniformArray(const std::string& name, const int* values,
     if (location != -1) {
         auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
         if (graphics) {
-            graphics->SetUniformIntArray(handle, name, values, count);
+            graphics->SetUniformIntArray(location, values, count);
         }
     }
 }
@@ -208,7 +377,7 @@ void ShaderProgram::SetUniformArray(const std::string& name, const Vector3* valu
         
         auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
         if (graphics) {
-            graphics->SetUniformVec3Array(handle, name, floatValues, count);
+            graphics->SetUniformVec3Array(location, floatValues, count);
         }
         
         delete[] floatValues;
@@ -231,7 +400,7 @@ void ShaderProgram::SetUniformArray(const std::string& name, const Matrix4x4* va
         
         auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
         if (graphics) {
-            graphics->SetUniformMatrix4Array(handle, name, floatValues, count, false);
+            graphics->SetUniformMatrix4Array(location, floatValues, count, false);
         }
         
         delete[] floatValues;
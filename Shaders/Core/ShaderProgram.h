@@ -1,7 +1,8 @@
 #pragma once
 
 #include <string>
-#include <unordered_map>
+#include <vector>
+#include "ShaderUniforms.h"
 #include "../../Graphics/Core/IGraphicsAPI.h"
 #include "../../Vector3.h"
 #include "../../Matrix4x4.h"
@@ -17,12 +18,47 @@ public:
     bool Link();
     void Use() const;
     
+    // Exchange linked programs with another ShaderProgram, so a reloaded
+    // program can replace this one without invalidating pointers to it
+    void Swap(ShaderProgram& other);
+    
     unsigned int GetHandle() const { return handle; }
-    void SetHandle(unsigned int h) { handle = h; }
-    void SetProgramId(unsigned int id) { handle = id; }
     
-    // Uniform setters
+    // Adopt a program linked elsewhere; its uniforms are resolved again
+    void SetHandle(unsigned int h);
+    void SetProgramId(unsigned int id) { SetHandle(id); }
+    
+    // Info log of the last failed link
+    const std::string& GetError() const { return error; }
+    
+    // Whether the program declares a shared uniform block and reads it from
+    // its binding point rather than from plain uniforms
+    bool HasUniformBlock(ShaderUniforms::Block block) const { return (blockMask & (1u << block)) != 0; }
+    
+    // Set the shared uniforms one by one for the blocks the program does not
+    // declare, so older shaders keep working
+    void SetSharedUniforms();
+    
+    // Program drawing many copies of a mesh in one call, reading each copy's
+    // model matrix from attributes 3 to 6 instead of the model uniform.
+    // Null if the program has none; ShaderAsset sets it for shaders that
+    // declare the INSTANCING keyword.
+    ShaderProgram* GetInstancedVariant() const { return instancedVariant; }
+    void SetInstancedVariant(ShaderProgram* program) { instancedVariant = program; }
+    
+    // Uniform setters. Locations are resolved when the program links and
+    // indexed by the ids of ShaderUniforms::GetId; setting by name looks the
+    // id up first.
     int GetUniformLocation(const std::string& name);
+    int GetUniformLocation(int id);
+    
+    void SetUniform(int id, float value);
+    void SetUniform(int id, int value);
+    void SetUniform(int id, bool value);
+    void SetUniform(int id, float x, float y, float z);
+    void SetUniform(int id, float x, float y, float z, float w);
+    void SetUniform(int id, const Vector3& value);
+    void SetUniform(int id, const Matrix4x4& value);
     
     void SetUniform(const std::string& name, float value);
     void SetUniform(const std::string& name, int value);
@@ -41,6 +77,13 @@ public:
     void SetUniformArray(const std::string& name, const Matrix4x4* values, int count);
     
 private:
+    // Look up the locations of every active uniform and assign the shared
+    // blocks to their binding points
+    void ResolveUniforms();
+    
     unsigned int handle;
-    std::unordered_map<std::string, int> uniformLocations;
+    std::string error;
+    std::vector<int> locations;     // By uniform id; UNRESOLVED until looked up
+    unsigned int blockMask;
+    ShaderProgram* instancedVariant;
 };
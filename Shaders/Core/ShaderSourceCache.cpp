@@ -0,0 +1,275 @@
+#include "ShaderSourceCache.h"
+#include "../../AssetManager.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+namespace {
+    std::atomic<bool> cacheEnabled(true);
+
+    bool GetSourceStamp(const std::string& path, uint64_t& size, int64_t& time) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) {
+            return false;
+        }
+        size = static_cast<uint64_t>(info.st_size);
+#if defined(__APPLE__)
+        time = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+        time = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#else
+        time = static_cast<int64_t>(info.st_mtime) * 1000000000;
+#endif
+        return true;
+    }
+
+    template <typename T>
+    void WriteValue(std::ofstream& file, T value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void WriteString(std::ofstream& file, const std::string& text) {
+        WriteValue(file, static_cast<uint32_t>(text.size()));
+        file.write(text.data(), text.size());
+    }
+
+    // Bounds-checked reads over a whole cache file
+    struct Reader {
+        const std::string& bytes;
+        size_t offset;
+
+        template <typename T>
+        bool Read(T& value) {
+            if (bytes.size() - offset < sizeof(value)) {
+                return false;
+            }
+            std::memcpy(&value, bytes.data() + offset, sizeof(value));
+            offset += sizeof(value);
+            return true;
+        }
+
+        bool ReadString(std::string& text) {
+            uint32_t length = 0;
+            if (!Read(length) || bytes.size() - offset < length) {
+                return false;
+            }
+            text.assign(bytes.data() + offset, length);
+            offset += length;
+            return true;
+        }
+    };
+}
+
+ShaderSourceCache& ShaderSourceCache::GetInstance() {
+    static ShaderSourceCache instance;
+    return instance;
+}
+
+bool ShaderSourceCache::Get(const std::string& path, const std::vector<std::string>& keywords,
+                            ShaderPreprocessor::Result& result, bool* fromCache) {
+    std::string normalized = AssetManager::NormalizePath(path);
+    std::string key = ShaderPreprocessor::JoinKeywords(keywords);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ShaderEntry& shader = shaders[normalized];
+    if (!shader.fileRead && IsEnabled()) {
+        ReadFile(GetCachePath(normalized), shader.variants);
+    }
+    shader.fileRead = true;
+
+    auto it = shader.variants.find(key);
+    if (it != shader.variants.end() && IsCurrent(it->second)) {
+        result = it->second.result;
+        if (fromCache) {
+            *fromCache = true;
+        }
+        return true;
+    }
+
+    Variant variant;
+    std::string error;
+    preprocessCount++;
+    if (!ShaderPreprocessor::Process(normalized, keywords, variant.result, &error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return false;
+    }
+
+    // A file that changes while it is being read gets a stamp that no longer
+    // matches, so the variant is simply preprocessed again next time
+    for (const std::string& file : variant.result.files) {
+        Stamp stamp;
+        stamp.path = file;
+        if (!GetSourceStamp(file, stamp.size, stamp.time)) {
+            stamp.size = 0;
+            stamp.time = 0;
+        }
+        variant.stamps.push_back(stamp);
+    }
+
+    result = variant.result;
+    shader.variants[key] = variant;
+    if (IsEnabled()) {
+        WriteFile(GetCachePath(normalized), shader.variants);
+    }
+    if (fromCache) {
+        *fromCache = false;
+    }
+    return true;
+}
+
+std::vector<std::string> ShaderSourceCache::GetDependents(const std::string& path) {
+    std::string normalized = AssetManager::NormalizePath(path);
+    std::vector<std::string> dependents;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& shader : shaders) {
+        bool includes = false;
+        for (const auto& variant : shader.second.variants) {
+            const std::vector<std::string>& files = variant.second.result.files;
+            for (size_t i = 1; i < files.size() && !includes; ++i) {
+                includes = files[i] == normalized;
+            }
+        }
+        if (includes) {
+            dependents.push_back(shader.first);
+        }
+    }
+    return dependents;
+}
+
+void ShaderSourceCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    shaders.clear();
+}
+
+size_t ShaderSourceCache::GetPreprocessCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return preprocessCount;
+}
+
+uint64_t ShaderSourceCache::Hash(const std::string& source) {
+    // FNV-1a; sources are a few kilobytes and hashed once per program load
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (unsigned char c : source) {
+        hash = (hash ^ c) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+std::string ShaderSourceCache::GetCachePath(const std::string& path) {
+    return path + ".savshader";
+}
+
+void ShaderSourceCache::SetEnabled(bool enabled) {
+    cacheEnabled = enabled;
+}
+
+bool ShaderSourceCache::IsEnabled() {
+    return cacheEnabled;
+}
+
+bool ShaderSourceCache::IsCurrent(const Variant& variant) {
+    for (const Stamp& stamp : variant.stamps) {
+        uint64_t size = 0;
+        int64_t time = 0;
+        if (!GetSourceStamp(stamp.path, size, time) || size != stamp.size || time != stamp.time) {
+            return false;
+        }
+    }
+    return !variant.stamps.empty();
+}
+
+bool ShaderSourceCache::ReadFile(const std::string& cachePath, std::map<std::string, Variant>& variants) {
+    std::ifstream file(cachePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Reader reader = { bytes, 0 };
+    Header header;
+    if (!reader.Read(header) || header.magic != MAGIC || header.version != VERSION) {
+        return false;
+    }
+
+    // Nothing is kept from a file that is cut short or corrupt
+    std::map<std::string, Variant> read;
+    for (uint32_t i = 0; i < header.variantCount; ++i) {
+        std::string key;
+        uint32_t fileCount = 0;
+        if (!reader.ReadString(key) || !reader.Read(fileCount) || fileCount > bytes.size()) {
+            return false;
+        }
+
+        Variant variant;
+        for (uint32_t j = 0; j < fileCount; ++j) {
+            Stamp stamp;
+            if (!reader.ReadString(stamp.path) || !reader.Read(stamp.size) || !reader.Read(stamp.time)) {
+                return false;
+            }
+            variant.result.files.push_back(stamp.path);
+            variant.stamps.push_back(stamp);
+        }
+
+        std::string declared;
+        if (!reader.ReadString(declared) || !reader.ReadString(variant.result.source)) {
+            return false;
+        }
+        variant.result.keywords = ShaderPreprocessor::SplitKeywords(declared);
+        read[key] = variant;
+    }
+
+    variants.insert(read.begin(), read.end());
+    return true;
+}
+
+bool ShaderSourceCache::WriteFile(const std::string& cachePath, const std::map<std::string, Variant>& variants) {
+    Header header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.variantCount = static_cast<uint32_t>(variants.size());
+    header.reserved = 0;
+
+    // Written under a temporary name so that a reader never sees a
+    // half-written file
+    std::string temporaryPath = cachePath + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Warning: Could not write shader cache: " << cachePath << std::endl;
+            return false;
+        }
+        WriteValue(file, header);
+        for (const auto& variant : variants) {
+            WriteString(file, variant.first);
+            WriteValue(file, static_cast<uint32_t>(variant.second.stamps.size()));
+            for (const Stamp& stamp : variant.second.stamps) {
+                WriteString(file, stamp.path);
+                WriteValue(file, stamp.size);
+                WriteValue(file, stamp.time);
+            }
+            WriteString(file, ShaderPreprocessor::JoinKeywords(variant.second.result.keywords));
+            WriteString(file, variant.second.result.source);
+        }
+        if (!file.good()) {
+            std::cerr << "Warning: Failed writing shader cache: " << cachePath << std::endl;
+            file.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    // rename does not replace an existing file on Windows
+    std::remove(cachePath.c_str());
+    if (std::rename(temporaryPath.c_str(), cachePath.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        std::cerr << "Warning: Could not write shader cache: " << cachePath << std::endl;
+        return false;
+    }
+    return true;
+}
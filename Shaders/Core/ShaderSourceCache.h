@@ -0,0 +1,96 @@
+#pragma once
+
+#include "ShaderPreprocessor.h"
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Preprocessed shader sources, one per file and keyword set, kept in memory
+// and in a cache file next to the shader ("standard.frag" ->
+// "standard.frag.savshader") holding every variant of it used so far.
+//
+// A variant is used again as long as the size and modification time of
+// every file it was built from (the shader and its includes) are the same,
+// so a warm start reads the cache file once and neither opens the includes
+// nor checks the keywords again.
+//
+// Layout (little-endian):
+//     Header
+//     per variant:
+//         string keywords              "A,B"
+//         uint32 fileCount
+//         per file: string path, uint64 size, int64 time
+//         string declared keywords     "A,B,C"
+//         string source
+// where a string is a uint32 length followed by its bytes.
+class ShaderSourceCache {
+public:
+    static const uint32_t MAGIC = 0x53564153;    // "SAVS"
+    static const uint32_t VERSION = 1;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t variantCount;
+        uint32_t reserved;
+    };
+
+    static ShaderSourceCache& GetInstance();
+
+    // Source of a shader with some of its keywords enabled, preprocessed
+    // only when no cached copy is current. fromCache, if given, is set to
+    // whether a cached copy was used.
+    bool Get(const std::string& path, const std::vector<std::string>& keywords, ShaderPreprocessor::Result& result,
+             bool* fromCache = nullptr);
+
+    // Shaders that include a file, for reloading them when it changes
+    std::vector<std::string> GetDependents(const std::string& path);
+
+    // Forget what is in memory; cache files are read again when needed
+    void Clear();
+
+    // Number of times a shader was actually preprocessed
+    size_t GetPreprocessCount();
+
+    // Key for a preprocessed source; equal sources compile to equal programs
+    static uint64_t Hash(const std::string& source);
+
+    // "<shader>.savshader"
+    static std::string GetCachePath(const std::string& path);
+
+    // With the cache disabled nothing is read from or written to disk
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+
+private:
+    struct Stamp {
+        std::string path;
+        uint64_t size;
+        int64_t time;
+    };
+
+    struct Variant {
+        ShaderPreprocessor::Result result;
+        std::vector<Stamp> stamps;
+    };
+
+    // Variants of one shader by keywords ("A,B")
+    struct ShaderEntry {
+        bool fileRead = false;
+        std::map<std::string, Variant> variants;
+    };
+
+    ShaderSourceCache() = default;
+    ShaderSourceCache(const ShaderSourceCache&) = delete;
+    ShaderSourceCache& operator=(const ShaderSourceCache&) = delete;
+
+    static bool IsCurrent(const Variant& variant);
+    static bool ReadFile(const std::string& cachePath, std::map<std::string, Variant>& variants);
+    static bool WriteFile(const std::string& cachePath, const std::map<std::string, Variant>& variants);
+
+    std::mutex mutex;
+    std::map<std::string, ShaderEntry> shaders;
+    size_t preprocessCount = 0;
+};
@@ -0,0 +1,190 @@
+#include "ShaderUniforms.h"
+#include "../../PointLight.h"
+#include "../../DirectionalLight.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+    struct UniformNames {
+        std::mutex mutex;
+        std::unordered_map<std::string, int> ids;
+        std::vector<std::string> names;
+    };
+
+    UniformNames& GetUniformNames() {
+        static UniformNames names;
+        return names;
+    }
+
+    void CopyVector(float* destination, const Vector3& value) {
+        destination[0] = value.x;
+        destination[1] = value.y;
+        destination[2] = value.z;
+    }
+}
+
+ShaderUniforms& ShaderUniforms::GetInstance() {
+    static ShaderUniforms instance;
+    return instance;
+}
+
+ShaderUniforms::ShaderUniforms() : uploadCount(0) {
+    // Zeroed padding lets whole blocks be compared with memcmp
+    std::memset(&frame, 0, sizeof(frame));
+    std::memset(&camera, 0, sizeof(camera));
+    for (int i = 0; i < BLOCK_COUNT; i++) {
+        buffers[i] = 0;
+        dirty[i] = true;
+    }
+}
+
+int ShaderUniforms::GetId(const std::string& name) {
+    UniformNames& names = GetUniformNames();
+    std::lock_guard<std::mutex> lock(names.mutex);
+    auto it = names.ids.find(name);
+    if (it != names.ids.end()) {
+        return it->second;
+    }
+    int id = static_cast<int>(names.names.size());
+    names.ids[name] = id;
+    names.names.push_back(name);
+    return id;
+}
+
+std::string ShaderUniforms::GetName(int id) {
+    UniformNames& names = GetUniformNames();
+    std::lock_guard<std::mutex> lock(names.mutex);
+    if (id < 0 || id >= static_cast<int>(names.names.size())) {
+        return "";
+    }
+    return names.names[id];
+}
+
+int ShaderUniforms::GetIdCount() {
+    UniformNames& names = GetUniformNames();
+    std::lock_guard<std::mutex> lock(names.mutex);
+    return static_cast<int>(names.names.size());
+}
+
+const char* ShaderUniforms::GetBlockName(Block block) {
+    switch (block) {
+        case FRAME_BLOCK:
+            return "FrameUniforms";
+        case CAMERA_BLOCK:
+            return "CameraUniforms";
+        default:
+            return "";
+    }
+}
+
+// Set the time uniforms
+bool ShaderUniforms::SetTime(float time, float deltaTime) {
+    if (frame.time == time && frame.deltaTime == deltaTime) {
+        return false;
+    }
+    frame.time = time;
+    frame.deltaTime = deltaTime;
+    dirty[FRAME_BLOCK] = true;
+    return true;
+}
+
+// Set the lights, up to MAX_POINT_LIGHTS and MAX_DIRECTIONAL_LIGHTS of them
+bool ShaderUniforms::SetLights(const std::vector<PointLight>& pointLights,
+                               const std::vector<DirectionalLight>& directionalLights) {
+    FrameData data = frame;
+    std::memset(data.pointLights, 0, sizeof(data.pointLights));
+    std::memset(data.directionalLights, 0, sizeof(data.directionalLights));
+
+    data.numPointLights = std::min(static_cast<int>(pointLights.size()), static_cast<int>(MAX_POINT_LIGHTS));
+    for (int i = 0; i < data.numPointLights; i++) {
+        PointLightData& light = data.pointLights[i];
+        CopyVector(light.position, pointLights[i].GetPosition());
+        CopyVector(light.color, pointLights[i].GetColor());
+        light.range = pointLights[i].GetRange();
+        light.intensity = pointLights[i].GetIntensity();
+    }
+
+    data.numDirectionalLights = std::min(static_cast<int>(directionalLights.size()),
+                                         static_cast<int>(MAX_DIRECTIONAL_LIGHTS));
+    for (int i = 0; i < data.numDirectionalLights; i++) {
+        DirectionalLightData& light = data.directionalLights[i];
+        CopyVector(light.direction, directionalLights[i].GetDirection());
+        CopyVector(light.color, directionalLights[i].GetColor());
+        light.intensity = directionalLights[i].GetIntensity();
+    }
+
+    if (std::memcmp(&data, &frame, sizeof(frame)) == 0) {
+        return false;
+    }
+    frame = data;
+    dirty[FRAME_BLOCK] = true;
+    return true;
+}
+
+// Set the camera matrices; the camera position is taken from the view matrix
+bool ShaderUniforms::SetCamera(const Matrix4x4& view, const Matrix4x4& projection) {
+    CameraData data;
+    std::memset(&data, 0, sizeof(data));
+    std::memcpy(data.view, &view.elements[0][0], sizeof(data.view));
+    std::memcpy(data.projection, &projection.elements[0][0], sizeof(data.projection));
+
+    const float (*m)[4] = view.elements;
+    float tx = m[0][3];
+    float ty = m[1][3];
+    float tz = m[2][3];
+    data.viewPos[0] = -(tx * m[0][0] + ty * m[1][0] + tz * m[2][0]);
+    data.viewPos[1] = -(tx * m[0][1] + ty * m[1][1] + tz * m[2][1]);
+    data.viewPos[2] = -(tx * m[0][2] + ty * m[1][2] + tz * m[2][2]);
+
+    if (std::memcmp(&data, &camera, sizeof(camera)) == 0) {
+        return false;
+    }
+    camera = data;
+    dirty[CAMERA_BLOCK] = true;
+    return true;
+}
+
+// Upload the blocks that changed
+void ShaderUniforms::Upload(IGraphicsAPI* graphics) {
+    if (!graphics) {
+        return;
+    }
+
+    const void* data[BLOCK_COUNT] = { &frame, &camera };
+    const size_t sizes[BLOCK_COUNT] = { sizeof(frame), sizeof(camera) };
+
+    for (int block = 0; block < BLOCK_COUNT; block++) {
+        if (buffers[block] == 0) {
+            buffers[block] = graphics->CreateBuffer();
+            if (buffers[block] == 0) {
+                continue;
+            }
+            dirty[block] = true;
+        }
+        if (!dirty[block]) {
+            continue;
+        }
+
+        // Respecifying the whole buffer lets the driver hand out fresh
+        // storage instead of waiting for draws still reading the old data
+        graphics->BindBuffer(BufferType::UNIFORM_BUFFER, buffers[block]);
+        graphics->BufferData(BufferType::UNIFORM_BUFFER, data[block], sizes[block], true);
+        graphics->BindBuffer(BufferType::UNIFORM_BUFFER, 0);
+        graphics->BindUniformBuffer(block, buffers[block]);
+        dirty[block] = false;
+        uploadCount++;
+    }
+}
+
+// Release the uniform buffers
+void ShaderUniforms::Release(IGraphicsAPI* graphics) {
+    for (int block = 0; block < BLOCK_COUNT; block++) {
+        if (graphics && buffers[block] != 0) {
+            graphics->DeleteBuffer(buffers[block]);
+        }
+        buffers[block] = 0;
+        dirty[block] = true;
+    }
+}
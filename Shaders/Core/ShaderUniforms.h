@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../../Graphics/Core/IGraphicsAPI.h"
+#include "../../Matrix4x4.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class PointLight;
+class DirectionalLight;
+
+// Uniforms shared by every program.
+//
+// Uniform names are interned once into small integer ids, so that a program
+// can resolve all its locations when it links and be indexed by id while
+// drawing instead of looking names up.
+//
+// Time, lights and the camera live in two std140 uniform blocks declared by
+// Shaders/Defaults/Include/globals.glsl. Their data is kept here, compared
+// with what was last set and uploaded only when it changed: the frame block
+// once per frame, the camera block once per camera, however many programs
+// and draws read them.
+class ShaderUniforms {
+public:
+    // Uniform blocks; the value is the binding point of the block
+    enum Block {
+        FRAME_BLOCK = 0,
+        CAMERA_BLOCK = 1,
+        BLOCK_COUNT = 2
+    };
+
+    static const int MAX_POINT_LIGHTS = 8;
+    static const int MAX_DIRECTIONAL_LIGHTS = 4;
+
+    // std140 layouts of the blocks; vec3s are padded to 16 bytes by the
+    // float that follows them
+    struct PointLightData {
+        float position[3];
+        float range;
+        float color[3];
+        float intensity;
+    };
+
+    struct DirectionalLightData {
+        float direction[3];
+        float intensity;
+        float color[3];
+        float padding;
+    };
+
+    struct FrameData {
+        float time;
+        float deltaTime;
+        int numPointLights;
+        int numDirectionalLights;
+        PointLightData pointLights[MAX_POINT_LIGHTS];
+        DirectionalLightData directionalLights[MAX_DIRECTIONAL_LIGHTS];
+    };
+
+    // Matrices are stored as Matrix4x4 passes them to SetUniform
+    struct CameraData {
+        float view[16];
+        float projection[16];
+        float viewPos[3];
+        float padding;
+    };
+
+    static ShaderUniforms& GetInstance();
+
+    // Id of a uniform name, the same for every program; ids are dense and
+    // start at 0
+    static int GetId(const std::string& name);
+    static std::string GetName(int id);
+    static int GetIdCount();
+
+    // Name of a block in GLSL ("FrameUniforms", "CameraUniforms")
+    static const char* GetBlockName(Block block);
+
+    // Each returns whether the data changed since it was last set
+    bool SetTime(float time, float deltaTime);
+    bool SetLights(const std::vector<PointLight>& pointLights,
+                   const std::vector<DirectionalLight>& directionalLights);
+    bool SetCamera(const Matrix4x4& view, const Matrix4x4& projection);
+
+    // Upload the blocks that changed and bind both to their binding points.
+    // Buffers are created on first use; without a graphics API nothing
+    // happens.
+    void Upload(IGraphicsAPI* graphics);
+
+    // Release the buffers, for when the context goes away
+    void Release(IGraphicsAPI* graphics);
+
+    const FrameData& GetFrameData() const { return frame; }
+    const CameraData& GetCameraData() const { return camera; }
+
+    // Number of block uploads so far
+    size_t GetUploadCount() const { return uploadCount; }
+
+private:
+    ShaderUniforms();
+    ShaderUniforms(const ShaderUniforms&) = delete;
+    ShaderUniforms& operator=(const ShaderUniforms&) = delete;
+
+    FrameData frame;
+    CameraData camera;
+    unsigned int buffers[BLOCK_COUNT];
+    bool dirty[BLOCK_COUNT];
+    size_t uploadCount;
+};
+
+static_assert(sizeof(ShaderUniforms::PointLightData) == 32, "PointLight must match std140");
+static_assert(sizeof(ShaderUniforms::DirectionalLightData) == 32, "DirectionalLight must match std140");
+static_assert(sizeof(ShaderUniforms::FrameData) == 400, "FrameUniforms must match std140");
+static_assert(sizeof(ShaderUniforms::CameraData) == 144, "CameraUniforms must match std140");
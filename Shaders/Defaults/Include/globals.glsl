@@ -0,0 +1,33 @@
+// Uniforms shared by every program, uploaded once per frame and once per
+// camera (ShaderUniforms). The layouts must match the structs there.
+
+struct PointLight {
+    vec3 position;
+    float range;
+    vec3 color;
+    float intensity;
+};
+
+struct DirectionalLight {
+    vec3 direction;
+    float intensity;
+    vec3 color;
+};
+
+#define MAX_POINT_LIGHTS 8
+#define MAX_DIRECTIONAL_LIGHTS 4
+
+layout (std140) uniform FrameUniforms {
+    float time;
+    float deltaTime;
+    int numPointLights;
+    int numDirectionalLights;
+    PointLight pointLights[MAX_POINT_LIGHTS];
+    DirectionalLight directionalLights[MAX_DIRECTIONAL_LIGHTS];
+};
+
+layout (std140) uniform CameraUniforms {
+    mat4 view;
+    mat4 projection;
+    vec3 viewPos;
+};
@@ -0,0 +1,21 @@
+// Level of detail crossfade: positive keeps the fragments whose dither
+// value is at least lodFade, negative those below -lodFade, 0 keeps all
+uniform float lodFade = 0.0;
+
+// 4x4 ordered dither value in (0, 1) for a pixel
+float lodDither(vec2 pixel) {
+    const float bayer[16] = float[16](0.0, 8.0, 2.0, 10.0, 12.0, 4.0, 14.0, 6.0,
+                                      3.0, 11.0, 1.0, 9.0, 15.0, 7.0, 13.0, 5.0);
+    ivec2 cell = ivec2(mod(pixel, 4.0));
+    return (bayer[cell.y * 4 + cell.x] + 0.5) / 16.0;
+}
+
+// Discard the fragments the other level of detail draws
+void applyLodFade() {
+    if (lodFade != 0.0) {
+        float dither = lodDither(gl_FragCoord.xy);
+        if (lodFade > 0.0 ? dither < lodFade : dither >= -lodFade) {
+            discard;
+        }
+    }
+}
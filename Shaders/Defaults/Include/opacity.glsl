@@ -0,0 +1,15 @@
+// Opacity from a separate texture, enabled by the OPACITY_MAP keyword
+#ifdef OPACITY_MAP
+uniform sampler2D opacityTexture;
+#endif
+
+// Replace the alpha of a color by the opacity map
+void applyOpacity(inout vec4 albedo, vec2 texCoord) {
+#ifdef OPACITY_MAP
+    float opacity = texture(opacityTexture, texCoord).r;
+    if (opacity < 0.1) {
+        discard; // Discard fragment if opacity is too low
+    }
+    albedo.a = opacity;
+#endif
+}
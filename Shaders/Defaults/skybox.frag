@@ -1,4 +1,5 @@
 #version 330 core
+#pragma keywords EQUIRECTANGULAR
 
 // Input data from vertex shader
 in vec3 TexCoords;
@@ -6,10 +7,24 @@ in vec3 TexCoords;
 // Output data
 out vec4 FragColor;
 
+#ifdef EQUIRECTANGULAR
+// Skybox as one latitude-longitude panorama
+uniform sampler2D skybox;
+
+const float PI = 3.14159265359;
+#else
 // Skybox texture
 uniform samplerCube skybox;
+#endif
 
 void main() {
+#ifdef EQUIRECTANGULAR
+    // Direction to panorama coordinates
+    vec3 direction = normalize(TexCoords);
+    vec2 uv = vec2(atan(direction.z, direction.x) / (2.0 * PI) + 0.5, asin(clamp(direction.y, -1.0, 1.0)) / PI + 0.5);
+    FragColor = texture(skybox, uv);
+#else
     // Sample skybox texture
     FragColor = texture(skybox, TexCoords);
+#endif
 }
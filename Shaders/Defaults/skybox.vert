@@ -3,9 +3,8 @@
 // Input vertex data
 layout (location = 0) in vec3 aPos;
 
-// Uniforms for transformation matrices
-uniform mat4 view;
-uniform mat4 projection;
+// Camera matrices
+#include "Include/globals.glsl"
 
 // Output data to fragment shader
 out vec3 TexCoords;
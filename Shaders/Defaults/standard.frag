@@ -1,4 +1,5 @@
 #version 330 core
+#pragma keywords NORMAL_MAP OPACITY_MAP
 
 // Input data from vertex shader
 in vec2 TexCoord;
@@ -10,36 +11,14 @@ out vec4 FragColor;
 
 // Material properties
 uniform sampler2D albedoTexture;
+#ifdef NORMAL_MAP
 uniform sampler2D normalTexture;
-uniform sampler2D opacityTexture;
-uniform bool useNormalMap = false;
-uniform bool useOpacityMap = false;
+#endif
 uniform float shininess = 32.0;
 
-// Light properties
-struct PointLight {
-    vec3 position;
-    vec3 color;
-    float intensity;
-    float range;
-};
-
-struct DirectionalLight {
-    vec3 direction;
-    vec3 color;
-    float intensity;
-};
-
-#define MAX_POINT_LIGHTS 8
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
-uniform int numPointLights = 0;
-
-#define MAX_DIRECTIONAL_LIGHTS 4
-uniform DirectionalLight directionalLights[MAX_DIRECTIONAL_LIGHTS];
-uniform int numDirectionalLights = 0;
-
-// Camera position
-uniform vec3 viewPos;
+#include "Include/globals.glsl"
+#include "Include/lod_fade.glsl"
+#include "Include/opacity.glsl"
 
 // Calculate lighting for a point light
 vec3 calculatePointLight(PointLight light, vec3 normal, vec3 fragPos, vec3 viewDir, vec3 albedo) {
@@ -86,27 +65,22 @@ vec3 calculateDirectionalLight(DirectionalLight light, vec3 normal, vec3 viewDir
 }
 
 void main() {
+    applyLodFade();
+    
     // Sample albedo texture
     vec4 albedoColor = texture(albedoTexture, TexCoord);
     
     // Apply opacity if using opacity map
-    if (useOpacityMap) {
-        float opacity = texture(opacityTexture, TexCoord).r;
-        if (opacity < 0.1) {
-            discard; // Discard fragment if opacity is too low
-        }
-        albedoColor.a = opacity;
-    }
+    applyOpacity(albedoColor, TexCoord);
     
     // Calculate normal
-    vec3 normal;
-    if (useNormalMap) {
-        // Sample normal map and convert from [0,1] to [-1,1] range
-        normal = texture(normalTexture, TexCoord).rgb;
-        normal = normalize(normal * 2.0 - 1.0);
-    } else {
-        normal = normalize(Normal);
-    }
+#ifdef NORMAL_MAP
+    // Sample normal map and convert from [0,1] to [-1,1] range
+    vec3 normal = texture(normalTexture, TexCoord).rgb;
+    normal = normalize(normal * 2.0 - 1.0);
+#else
+    vec3 normal = normalize(Normal);
+#endif
     
     // Calculate view direction
     vec3 viewDir = normalize(viewPos - FragPos);
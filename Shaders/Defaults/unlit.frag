@@ -1,4 +1,5 @@
 #version 330 core
+#pragma keywords OPACITY_MAP
 
 // Input data from vertex shader
 in vec2 TexCoord;
@@ -8,22 +9,19 @@ out vec4 FragColor;
 
 // Material properties
 uniform sampler2D albedoTexture;
-uniform sampler2D opacityTexture;
-uniform bool useOpacityMap = false;
 uniform vec4 color = vec4(1.0, 1.0, 1.0, 1.0);
 
+#include "Include/lod_fade.glsl"
+#include "Include/opacity.glsl"
+
 void main() {
+    applyLodFade();
+    
     // Sample albedo texture
     vec4 albedoColor = texture(albedoTexture, TexCoord) * color;
     
     // Apply opacity if using opacity map
-    if (useOpacityMap) {
-        float opacity = texture(opacityTexture, TexCoord).r;
-        if (opacity < 0.1) {
-            discard; // Discard fragment if opacity is too low
-        }
-        albedoColor.a = opacity;
-    }
+    applyOpacity(albedoColor, TexCoord);
     
     // Output final color
     FragColor = albedoColor;
@@ -1,13 +1,20 @@
 #version 330 core
+#pragma keywords INSTANCING
 
 // Input vertex data
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
 
+#include "Include/globals.glsl"
+
 // Uniforms for transformation matrices
+#ifdef INSTANCING
+// One transform per instance, a column per location (see RenderQueue)
+layout (location = 3) in mat4 instanceModel;
+#define model instanceModel
+#else
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+#endif
 
 // Output data to fragment shader
 out vec2 TexCoord;
@@ -2,7 +2,7 @@
 echo Building GameEngineSavi Test Suite...
 
 REM Engine source files needed for tests
-set ENGINE_SOURCES=..\Vector3.cpp ..\PhysicsSystem.cpp ..\RigidBody.cpp ..\GameObject.cpp ..\CollisionSystem.cpp ..\Time.cpp ..\Scene.cpp ..\EngineCondition.cpp
+set ENGINE_SOURCES=..\Vector3.cpp ..\PhysicsSystem.cpp ..\RigidBody.cpp ..\GameObject.cpp ..\CollisionSystem.cpp ..\Time.cpp ..\Scene.cpp ..\Coroutine.cpp ..\TimerWheel.cpp ..\FrustumCuller.cpp ..\RenderQueue.cpp ..\LodGroup.cpp ..\EngineCondition.cpp
 
 REM Compile the test suite with engine sources
 g++ -std=c++11 -Wall -I../ src\TestRunner.cpp %ENGINE_SOURCES% -o run_tests.exe
@@ -11,7 +11,10 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #include "Debugger.h"
+#include "AssetManager.h"
+#include "Graphics/Core/GraphicsAPIFactory.h"
 #include <iostream>
+#include <utility>
 #include <stdexcept>
 
 Texture::Texture() : id(0), width(0), height(0), channels(0), tiling_x(1.0f), tiling_y(1.0f) {
@@ -19,48 +22,149 @@ Texture::Texture() : id(0), width(0), height(0), channels(0), tiling_x(1.0f), ti
 
 Texture::~Texture() {
     if (id != 0) {
-        glDeleteTextures(1, &id);
+        // Through the graphics API, so its state cache forgets the name
+        // before GL hands it out again
+        auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+        if (graphics) {
+            graphics->DeleteTexture(id);
+        } else {
+            glDeleteTextures(1, &id);
+        }
     }
 }
 
-bool Texture::load(const std::string& path) {
+bool Texture::load(const std::string& path, const std::string& settings) {
     return Debugger::GetInstance().TryImport([&]() -> bool {
-        // Load image using stb_image
-        unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-        if (!data) {
+        // Cooked mip chain, compressed the first time the image is loaded
+        if (!TextureCache::Load(path, TextureCache::ParseOptions(settings), pending)) {
             throw std::runtime_error("Failed to load texture: " + path);
         }
         
-        // Generate OpenGL texture
-        glGenTextures(1, &id);
-        glBindTexture(GL_TEXTURE_2D, id);
-        
-        // Set texture parameters
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        
-        // Upload texture data
-        GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        
-        // Free image data
-        stbi_image_free(data);
-        
-        return true;
+        return upload();
     }, path, "texture");
 }
 
+bool Texture::decode(const std::string& path, const unsigned char* data, size_t size, const std::string& settings) {
+    if (TextureCache::IsCooked(data, size)) {
+        return TextureCache::Parse(data, size, pending);
+    }
+    return TextureCache::LoadFromMemory(path, data, size, TextureCache::ParseOptions(settings), pending);
+}
+
+bool Texture::create(const unsigned char* rgba, uint32_t width, uint32_t height, const std::string& settings) {
+    if (!rgba || width == 0 || height == 0) {
+        return false;
+    }
+    TextureCache::Encode(rgba, width, height, 4, TextureCache::ParseOptions(settings), pending);
+    return upload();
+}
+
+// Graphics API format of a cooked texture
+static TextureFormat GetTextureFormat(uint32_t format) {
+    switch (format) {
+        case TextureCache::FORMAT_BC1:
+            return TextureFormat::BC1;
+        case TextureCache::FORMAT_BC3:
+            return TextureFormat::BC3;
+        case TextureCache::FORMAT_BC5:
+            return TextureFormat::BC5;
+        default:
+            return TextureFormat::RGBA8;
+    }
+}
+
+bool Texture::upload() {
+    if (pending.levels.empty()) {
+        return false;
+    }
+    
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    if (!graphics) {
+        std::cerr << "Failed to get graphics API instance" << std::endl;
+        return false;
+    }
+    
+    width = static_cast<int>(pending.width);
+    height = static_cast<int>(pending.height);
+    channels = static_cast<int>(pending.channels);
+    
+    // Create the texture through the graphics API so its state cache knows
+    // what unit 0 now holds and the null backend counts the upload
+    id = graphics->CreateTexture();
+    graphics->BindTexture(id, 0);
+    
+    int levelCount = static_cast<int>(pending.levels.size());
+    graphics->SetTextureLevels(levelCount);
+    
+    // Upload every level as cooked
+    TextureFormat format = GetTextureFormat(pending.format);
+    for (int i = 0; i < levelCount; ++i) {
+        const CookedTexture::Level& level = pending.levels[i];
+        graphics->TexImageLevel(i, format, static_cast<int>(level.width), static_cast<int>(level.height),
+                                pending.data.data() + level.offset, level.size);
+    }
+    
+    // Free the levels
+    pending = CookedTexture();
+    
+    return true;
+}
+
+size_t Texture::getPendingUploadSize() const {
+    size_t size = 0;
+    for (const CookedTexture::Level& level : pending.levels) {
+        size += level.size;
+    }
+    return size;
+}
+
 void Texture::bind() {
-    glBindTexture(GL_TEXTURE_2D, id);
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    if (graphics) {
+        graphics->BindTexture(id, 0);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, id);
+    }
 }
 
 void Texture::unbind() {
-    glBindTexture(GL_TEXTURE_2D, 0);
+    auto graphics = GraphicsAPIFactory::GetInstance().GetGraphicsAPI();
+    if (graphics) {
+        graphics->BindTexture(0, 0);
+    } else {
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
 }
 
 void Texture::setTiling(float x, float y) {
     tiling_x = x;
     tiling_y = y;
 }
+
+Texture* AssetLoader<Texture>::Load(const std::string& path, const std::string& settings) {
+    Texture* texture = new Texture();
+    if (!texture->load(path, settings)) {
+        delete texture;
+        return nullptr;
+    }
+    return texture;
+}
+
+bool AssetLoader<Texture>::Reload(Texture* texture, const std::string& path, const std::string& settings) {
+    Texture* fresh = Load(path, settings);
+    if (!fresh) {
+        return false;
+    }
+    
+    // Take the new texture object; the old one is deleted with fresh
+    std::swap(texture->id, fresh->id);
+    std::swap(texture->width, fresh->width);
+    std::swap(texture->height, fresh->height);
+    std::swap(texture->channels, fresh->channels);
+    delete fresh;
+    return true;
+}
+
+void AssetLoader<Texture>::Unload(Texture* texture) {
+    delete texture;
+}
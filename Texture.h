@@ -2,8 +2,13 @@
 #define TEXTURE_H
 
 #include <string>
+#include <vector>
+#include <iostream>
+#include <cstddef>
 #include "platform.h" // Include platform.h for platform-specific macros
 #include "ThirdParty/OpenGL/include/GL/gl_definitions.h" // Use our centralized GL definitions
+#include "AssetStreamer.h"
+#include "TextureCache.h"
 
 class Texture {
 public:
@@ -14,10 +19,67 @@ public:
     Texture();
     ~Texture();
     
-    bool load(const std::string& path);
+    // Load through the texture cache; settings are import settings such as
+    // "format=bc5;mips=0" (see TextureCache::ParseOptions)
+    bool load(const std::string& path, const std::string& settings = "");
+    
+    // Decode an image file, or a cooked texture file, held in memory and
+    // keep the levels for upload. Makes no graphics calls, so it is safe
+    // on a worker thread.
+    bool decode(const std::string& path, const unsigned char* data, size_t size, const std::string& settings = "");
+    
+    // Cook RGBA8 pixels built in memory, such as an atlas page, and upload
+    // them; settings as for load()
+    bool create(const unsigned char* rgba, uint32_t width, uint32_t height, const std::string& settings = "");
+    
+    // Create the texture object from the decoded levels and free them
+    bool upload();
+    
+    // Bytes upload() will send, 0 once uploaded
+    size_t getPendingUploadSize() const;
+    
+    // Raw binds, unseen by the graphics API's state cache; renderers
+    // should bind through IGraphicsAPI::BindTexture instead
     void bind();
     void unbind();
     void setTiling(float x, float y);
+    
+private:
+    // Levels waiting for upload()
+    CookedTexture pending;
+    
+    Texture(const Texture&);
+    Texture& operator=(const Texture&);
+};
+
+// Images are read on the I/O thread, decoded (or cooked) on a worker and
+// uploaded on the main thread
+template <>
+struct AssetStreamLoader<Texture> {
+    // Reads the cooked file when it is current, the image otherwise
+    static bool Read(const std::string& path, const std::string& settings, std::vector<unsigned char>& bytes) {
+        TextureCache::Options options = TextureCache::ParseOptions(settings);
+        if (TextureCache::IsEnabled() && TextureCache::IsCurrent(path, options) &&
+            AssetStreamer::ReadFile(TextureCache::GetCookedPath(path, options), bytes)) {
+            return true;
+        }
+        return AssetStreamer::ReadFile(path, bytes);
+    }
+    
+    static Texture* Decode(const std::string& path, const std::string& settings,
+                           const std::vector<unsigned char>& bytes) {
+        Texture* texture = new Texture();
+        if (bytes.empty() || !texture->decode(path, bytes.data(), bytes.size(), settings)) {
+            std::cerr << "Failed to decode texture: " << path << std::endl;
+            delete texture;
+            return nullptr;
+        }
+        return texture;
+    }
+    
+    static size_t GetUploadSize(const Texture& texture) { return texture.getPendingUploadSize(); }
+    
+    static bool Upload(Texture& texture) { return texture.upload(); }
 };
 
 #endif // TEXTURE_H
@@ -0,0 +1,274 @@
+#include "TextureAtlas.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <iostream>
+
+// One segment of a page's skyline: the top of everything placed below it
+struct SkylineNode {
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+};
+
+// Lowest y at which a rectangle fits with its left edge on a skyline node
+static bool FitSkyline(const std::vector<SkylineNode>& skyline, size_t index, uint32_t width, uint32_t height,
+                       uint32_t pageWidth, uint32_t pageHeight, uint32_t& y) {
+    if (skyline[index].x + width > pageWidth) {
+        return false;
+    }
+
+    // The nodes cover the page's width, so the rectangle's span ends on one
+    uint32_t remaining = width;
+    y = 0;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = std::max(y, skyline[i].y);
+        if (y + height > pageHeight) {
+            return false;
+        }
+        remaining -= std::min(remaining, skyline[i].width);
+    }
+    return true;
+}
+
+// Raise the skyline over a rectangle placed at node index
+static void AddToSkyline(std::vector<SkylineNode>& skyline, size_t index, uint32_t width, uint32_t top) {
+    SkylineNode node = { skyline[index].x, top, width };
+    skyline.insert(skyline.begin() + index, node);
+
+    // Cut away what the new node covers
+    size_t i = index + 1;
+    while (i < skyline.size()) {
+        uint32_t end = skyline[i - 1].x + skyline[i - 1].width;
+        if (skyline[i].x >= end) {
+            break;
+        }
+        uint32_t overlap = end - skyline[i].x;
+        if (skyline[i].width <= overlap) {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+        skyline[i].x += overlap;
+        skyline[i].width -= overlap;
+        break;
+    }
+
+    // Merge neighbours at the same height
+    for (size_t j = 0; j + 1 < skyline.size();) {
+        if (skyline[j].y == skyline[j + 1].y) {
+            skyline[j].width += skyline[j + 1].width;
+            skyline.erase(skyline.begin() + j + 1);
+        } else {
+            ++j;
+        }
+    }
+}
+
+// Smallest power of two not below size
+static uint32_t NextPowerOfTwo(uint32_t size) {
+    uint32_t result = 1;
+    while (result < size) {
+        result *= 2;
+    }
+    return result;
+}
+
+TextureAtlas::TextureAtlas(const Options& options) : options(options) {
+    if (this->options.alignment == 0) {
+        this->options.alignment = 1;
+    }
+}
+
+bool TextureAtlas::Add(const std::string& name, const unsigned char* rgba, uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0 || width > options.maxImageSize || height > options.maxImageSize) {
+        return false;
+    }
+    if (GetSlotSize(width) > options.pageSize || GetSlotSize(height) > options.pageSize) {
+        return false;
+    }
+    if (images.count(name) != 0) {
+        return false;
+    }
+
+    Image& image = images[name];
+    image.width = width;
+    image.height = height;
+    image.pixels.assign(rgba, rgba + static_cast<size_t>(width) * height * 4);
+    return true;
+}
+
+bool TextureAtlas::AddFile(const std::string& path) {
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+    if (!pixels) {
+        std::cerr << "Error: Could not load image for atlas: " << path << std::endl;
+        return false;
+    }
+
+    bool added = Add(path, pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+    stbi_image_free(pixels);
+    return added;
+}
+
+bool TextureAtlas::Build() {
+    pages.clear();
+    regions.clear();
+
+    std::vector<Rect> slots;
+    slots.reserve(images.size());
+    for (const auto& entry : images) {
+        Rect slot = { GetSlotSize(entry.second.width), GetSlotSize(entry.second.height), 0, 0, 0 };
+        slots.push_back(slot);
+    }
+    if (!Pack(slots, options.pageSize, options.pageSize)) {
+        std::cerr << "Error: Atlas images do not fit on a " << options.pageSize << " page" << std::endl;
+        return false;
+    }
+
+    // Pages are only as tall as their contents
+    for (const Rect& slot : slots) {
+        if (slot.page >= pages.size()) {
+            pages.resize(slot.page + 1);
+        }
+        Page& page = pages[slot.page];
+        page.width = options.pageSize;
+        page.height = std::max(page.height, std::min(options.pageSize, NextPowerOfTwo(slot.y + slot.height)));
+    }
+    for (Page& page : pages) {
+        page.pixels.assign(static_cast<size_t>(page.width) * page.height * 4, 0);
+    }
+
+    size_t index = 0;
+    for (const auto& entry : images) {
+        const Rect& slot = slots[index++];
+        Page& page = pages[slot.page];
+        Blit(entry.second, page, slot, options.padding);
+
+        AtlasRegion region;
+        region.page = slot.page;
+        region.x = slot.x + options.padding;
+        region.y = slot.y + options.padding;
+        region.width = entry.second.width;
+        region.height = entry.second.height;
+        region.u0 = static_cast<float>(region.x) / page.width;
+        region.v0 = static_cast<float>(region.y) / page.height;
+        region.u1 = static_cast<float>(region.x + region.width) / page.width;
+        region.v1 = static_cast<float>(region.y + region.height) / page.height;
+        regions[entry.first] = region;
+    }
+    return true;
+}
+
+bool TextureAtlas::Find(const std::string& name, AtlasRegion& region) const {
+    auto it = regions.find(name);
+    if (it == regions.end()) {
+        return false;
+    }
+    region = it->second;
+    return true;
+}
+
+uint32_t TextureAtlas::GetMipLevels() const {
+    // A level is clean while its texels, 2^level pixels wide, line up with
+    // the slots and the border is at least one of them wide
+    uint32_t levels = 1;
+    for (uint32_t step = 2; step <= options.padding; step *= 2) {
+        if (options.padding % step != 0 || options.alignment % step != 0) {
+            break;
+        }
+        ++levels;
+    }
+    return levels;
+}
+
+bool TextureAtlas::CanRemap(const std::vector<float>& texCoords) {
+    for (float coordinate : texCoords) {
+        if (!(coordinate >= 0.0f && coordinate <= 1.0f)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void TextureAtlas::RemapTexCoords(std::vector<float>& texCoords, const AtlasRegion& region) {
+    for (size_t i = 0; i + 1 < texCoords.size(); i += 2) {
+        texCoords[i] = region.u0 + texCoords[i] * (region.u1 - region.u0);
+        texCoords[i + 1] = region.v0 + texCoords[i + 1] * (region.v1 - region.v0);
+    }
+}
+
+bool TextureAtlas::Pack(std::vector<Rect>& rects, uint32_t pageWidth, uint32_t pageHeight) {
+    // Tallest first keeps the skyline flat
+    std::vector<size_t> order(rects.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&rects](size_t a, size_t b) {
+        if (rects[a].height != rects[b].height) {
+            return rects[a].height > rects[b].height;
+        }
+        return rects[a].width > rects[b].width;
+    });
+
+    std::vector<std::vector<SkylineNode>> skylines;
+    for (size_t index : order) {
+        Rect& rect = rects[index];
+        if (rect.width > pageWidth || rect.height > pageHeight) {
+            return false;
+        }
+
+        bool placed = false;
+        for (size_t page = 0; page <= skylines.size() && !placed; ++page) {
+            if (page == skylines.size()) {
+                SkylineNode empty = { 0, 0, pageWidth };
+                skylines.push_back(std::vector<SkylineNode>(1, empty));
+            }
+            std::vector<SkylineNode>& skyline = skylines[page];
+
+            // Lowest top, then leftmost
+            size_t bestNode = skyline.size();
+            uint32_t bestY = 0;
+            for (size_t i = 0; i < skyline.size(); ++i) {
+                uint32_t y = 0;
+                if (FitSkyline(skyline, i, rect.width, rect.height, pageWidth, pageHeight, y) &&
+                    (bestNode == skyline.size() || y < bestY)) {
+                    bestNode = i;
+                    bestY = y;
+                }
+            }
+            if (bestNode == skyline.size()) {
+                continue;
+            }
+
+            rect.page = static_cast<uint32_t>(page);
+            rect.x = skyline[bestNode].x;
+            rect.y = bestY;
+            AddToSkyline(skyline, bestNode, rect.width, bestY + rect.height);
+            placed = true;
+        }
+    }
+    return true;
+}
+
+uint32_t TextureAtlas::GetSlotSize(uint32_t size) const {
+    uint32_t slot = size + options.padding * 2;
+    return (slot + options.alignment - 1) / options.alignment * options.alignment;
+}
+
+void TextureAtlas::Blit(const Image& image, Page& page, const Rect& slot, uint32_t padding) {
+    for (uint32_t row = 0; row < slot.height; ++row) {
+        int sourceRow = static_cast<int>(row) - static_cast<int>(padding);
+        sourceRow = std::max(0, std::min(sourceRow, static_cast<int>(image.height) - 1));
+        unsigned char* target = &page.pixels[((static_cast<size_t>(slot.y) + row) * page.width + slot.x) * 4];
+
+        for (uint32_t column = 0; column < slot.width; ++column) {
+            int sourceColumn = static_cast<int>(column) - static_cast<int>(padding);
+            sourceColumn = std::max(0, std::min(sourceColumn, static_cast<int>(image.width) - 1));
+            const unsigned char* source =
+                &image.pixels[(static_cast<size_t>(sourceRow) * image.width + sourceColumn) * 4];
+            std::copy(source, source + 4, target + column * 4);
+        }
+    }
+}
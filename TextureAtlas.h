@@ -0,0 +1,112 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+// Where an image ended up in an atlas
+struct AtlasRegion {
+    uint32_t page = 0;
+    uint32_t x = 0;             // top-left pixel of the image on the page
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    float u0 = 0.0f;            // texture coordinates of the image's corners
+    float v0 = 0.0f;
+    float u1 = 1.0f;
+    float v1 = 1.0f;
+};
+
+// Packs small images into a few large pages so draws that used one texture
+// each can share a texture, and be batched.
+//
+// Every image sits in a slot with its edge pixels copied outward into a
+// border, and slots start and end on multiples of the alignment. Filtering
+// at the image's edge then samples its own border instead of a neighbour,
+// and the same holds on every mip level whose texels stay inside a slot:
+// GetMipLevels() of them. An alignment of 4 also keeps BC blocks on the
+// base level from mixing images.
+//
+// Only coordinates inside [0, 1] can be remapped; images that tile need a
+// texture of their own.
+class TextureAtlas {
+public:
+    struct Options {
+        uint32_t pageSize;          // width and largest height of a page
+        uint32_t padding;           // border pixels around each image
+        uint32_t alignment;         // slot alignment in pixels
+        uint32_t maxImageSize;      // larger images are left out
+
+        Options() : pageSize(2048), padding(4), alignment(4), maxImageSize(256) {}
+    };
+
+    struct Page {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<unsigned char> pixels;  // RGBA8, row by row
+    };
+
+    explicit TextureAtlas(const Options& options = Options());
+
+    // Add an RGBA8 image; false if it is too large or the name is taken
+    bool Add(const std::string& name, const unsigned char* rgba, uint32_t width, uint32_t height);
+
+    // Add an image file, named by its path
+    bool AddFile(const std::string& path);
+
+    // Pack the images added so far into pages. Pages are pageSize wide and
+    // only as tall (a power of two) as their contents need.
+    bool Build();
+
+    // Region of an image after Build()
+    bool Find(const std::string& name, AtlasRegion& region) const;
+
+    const std::vector<Page>& GetPages() const { return pages; }
+    size_t GetImageCount() const { return images.size(); }
+
+    // Mip levels that do not bleed between images
+    uint32_t GetMipLevels() const;
+
+    const Options& GetOptions() const { return options; }
+
+    // Whether texture coordinates (u, v pairs) all lie inside [0, 1]
+    static bool CanRemap(const std::vector<float>& texCoords);
+
+    // Map [0, 1] texture coordinates onto a region
+    static void RemapTexCoords(std::vector<float>& texCoords, const AtlasRegion& region);
+
+    // Place rectangles on pages of pageWidth x pageHeight, largest first,
+    // with a skyline bottom-left packer. Returns false if a rectangle is
+    // larger than a page.
+    struct Rect {
+        uint32_t width;
+        uint32_t height;
+        uint32_t page;              // set by Pack
+        uint32_t x;
+        uint32_t y;
+    };
+    static bool Pack(std::vector<Rect>& rects, uint32_t pageWidth, uint32_t pageHeight);
+
+private:
+    struct Image {
+        uint32_t width;
+        uint32_t height;
+        std::vector<unsigned char> pixels;
+    };
+
+    Options options;
+    std::map<std::string, Image> images;
+    std::map<std::string, AtlasRegion> regions;
+    std::vector<Page> pages;
+
+    // Slot size of an image, border and alignment included
+    uint32_t GetSlotSize(uint32_t size) const;
+
+    // Fill a slot with an image, its edge pixels extruded to the slot's edges
+    static void Blit(const Image& image, Page& page, const Rect& slot, uint32_t padding);
+};
+
+#endif // TEXTURE_ATLAS_H
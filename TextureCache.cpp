@@ -0,0 +1,895 @@
+#include "TextureCache.h"
+#include "MeshCache.h"
+#include "AssetManager.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TEXTURE_CACHE_SSE2 1
+#endif
+
+static_assert(sizeof(TextureCache::Header) == 64, "Header layout changed");
+static_assert(sizeof(TextureCache::LevelRecord) == 24, "LevelRecord layout changed");
+
+namespace {
+    std::atomic<bool> cacheEnabled(true);
+
+    const uint32_t MAX_LEVELS = 32;
+
+    size_t Align8(size_t size) {
+        return (size + 7) & ~static_cast<size_t>(7);
+    }
+
+    bool GetSourceStamp(const std::string& path, uint64_t& size, int64_t& time) {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0) {
+            return false;
+        }
+        size = static_cast<uint64_t>(info.st_size);
+#if defined(__APPLE__)
+        time = static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+        time = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#else
+        time = static_cast<int64_t>(info.st_mtime) * 1000000000;
+#endif
+        return true;
+    }
+
+    // Whole file in one read
+    bool ReadFile(const std::string& path, std::vector<unsigned char>& bytes) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        std::streamoff size = file.tellg();
+        if (size < 0) {
+            return false;
+        }
+        bytes.resize(static_cast<size_t>(size));
+        file.seekg(0, std::ios::beg);
+        return size == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(&bytes[0]), size));
+    }
+
+    bool ReadHeader(const unsigned char* bytes, size_t size, TextureCache::Header& header) {
+        if (size < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, bytes, sizeof(header));
+        return header.magic == TextureCache::MAGIC && header.version == TextureCache::VERSION;
+    }
+
+    bool ReadHeader(const std::string& cookedPath, TextureCache::Header& header) {
+        std::ifstream file(cookedPath, std::ios::binary);
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            return false;
+        }
+        return header.magic == TextureCache::MAGIC && header.version == TextureCache::VERSION;
+    }
+
+    // Point the texture at the levels of the cooked file it holds in data
+    bool ParseLevels(CookedTexture& texture) {
+        TextureCache::Header header;
+        if (!ReadHeader(texture.data.data(), texture.data.size(), header) || header.levelCount == 0 ||
+            header.levelCount > MAX_LEVELS || header.format < TextureCache::FORMAT_RGBA8 ||
+            header.format > TextureCache::FORMAT_BC5) {
+            return false;
+        }
+
+        size_t recordsSize = header.levelCount * sizeof(TextureCache::LevelRecord);
+        if (texture.data.size() - sizeof(header) < recordsSize) {
+            return false;
+        }
+        std::vector<TextureCache::LevelRecord> records(header.levelCount);
+        std::memcpy(records.data(), texture.data.data() + sizeof(header), recordsSize);
+
+        TextureCache::Format format = static_cast<TextureCache::Format>(header.format);
+        texture.levels.clear();
+        for (const TextureCache::LevelRecord& record : records) {
+            if (record.width == 0 || record.height == 0 ||
+                record.size != TextureCache::GetLevelSize(format, record.width, record.height) ||
+                record.offset > texture.data.size() || record.size > texture.data.size() - record.offset) {
+                return false;
+            }
+            CookedTexture::Level level;
+            level.width = record.width;
+            level.height = record.height;
+            level.offset = static_cast<size_t>(record.offset);
+            level.size = static_cast<size_t>(record.size);
+            texture.levels.push_back(level);
+        }
+
+        texture.format = header.format;
+        texture.width = header.width;
+        texture.height = header.height;
+        texture.channels = header.channels;
+        return true;
+    }
+
+    void WriteBlock(std::ofstream& file, const void* bytes, size_t size) {
+        static const char padding[8] = { 0 };
+        if (size > 0) {
+            file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+        }
+        file.write(padding, static_cast<std::streamsize>(Align8(size) - size));
+    }
+
+    // Record the source's new size and time in a cooked file whose contents
+    // are still current, so the next load can skip hashing
+    void UpdateStamp(const std::string& cookedPath, const TextureCache::Header& header) {
+        std::fstream file(cookedPath, std::ios::in | std::ios::out | std::ios::binary);
+        if (file.is_open()) {
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+    }
+
+    // sRGB <-> linear, exact for every 8-bit value
+    struct SrgbTable {
+        float toLinear[256];
+        float thresholds[255];    // linear values halfway between codes
+
+        SrgbTable() {
+            for (int i = 0; i < 256; ++i) {
+                toLinear[i] = Decode(i / 255.0);
+            }
+            for (int i = 0; i < 255; ++i) {
+                thresholds[i] = Decode((i + 0.5) / 255.0);
+            }
+        }
+
+        static float Decode(double value) {
+            return static_cast<float>(value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4));
+        }
+
+        unsigned char ToSrgb(float linear) const {
+            return static_cast<unsigned char>(std::upper_bound(thresholds, thresholds + 255, linear) - thresholds);
+        }
+    };
+
+    const SrgbTable& GetSrgbTable() {
+        static const SrgbTable table;
+        return table;
+    }
+
+    unsigned char ToByte(float value) {
+        float scaled = value * 255.0f + 0.5f;
+        return static_cast<unsigned char>(scaled <= 0.0f ? 0.0f : (scaled >= 255.0f ? 255.0f : scaled));
+    }
+
+    // Source pixels and weights covering one destination pixel
+    struct Tap {
+        uint32_t index;
+        float weight;
+    };
+
+    void BuildTaps(uint32_t sourceSize, uint32_t targetSize, std::vector<std::vector<Tap>>& taps) {
+        double scale = static_cast<double>(sourceSize) / targetSize;
+        taps.assign(targetSize, std::vector<Tap>());
+        for (uint32_t target = 0; target < targetSize; ++target) {
+            double start = target * scale;
+            double end = (target + 1) * scale;
+            for (uint32_t source = static_cast<uint32_t>(start); source < sourceSize && source < end; ++source) {
+                double overlap = std::min(end, source + 1.0) - std::max(start, static_cast<double>(source));
+                if (overlap > 0.0) {
+                    Tap tap = { source, static_cast<float>(overlap / scale) };
+                    taps[target].push_back(tap);
+                }
+            }
+        }
+    }
+
+    // Quantize to 5:6:5 and back
+    uint16_t Pack565(int r, int g, int b) {
+        return static_cast<uint16_t>((((r * 31 + 127) / 255) << 11) | (((g * 63 + 127) / 255) << 5) |
+                                     ((b * 31 + 127) / 255));
+    }
+
+    void Unpack565(uint16_t color, int* rgb) {
+        int r = (color >> 11) & 31;
+        int g = (color >> 5) & 63;
+        int b = color & 31;
+        rgb[0] = (r << 3) | (r >> 2);
+        rgb[1] = (g << 2) | (g >> 4);
+        rgb[2] = (b << 3) | (b >> 2);
+    }
+
+    // Position of each pixel along the line from start to end, rounded to
+    // one of four steps (0 at start, 3 at end)
+    void ProjectColors(const unsigned char* rgba, const int* start, const int* end, int* steps) {
+        int direction[3] = { end[0] - start[0], end[1] - start[1], end[2] - start[2] };
+        int lengthSquared = direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2];
+        float scale = 3.0f / static_cast<float>(lengthSquared);
+
+#ifdef TEXTURE_CACHE_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i origin = _mm_setr_epi16(static_cast<short>(start[0]), static_cast<short>(start[1]),
+                                              static_cast<short>(start[2]), 0, static_cast<short>(start[0]),
+                                              static_cast<short>(start[1]), static_cast<short>(start[2]), 0);
+        const __m128i axis = _mm_setr_epi16(static_cast<short>(direction[0]), static_cast<short>(direction[1]),
+                                            static_cast<short>(direction[2]), 0, static_cast<short>(direction[0]),
+                                            static_cast<short>(direction[1]), static_cast<short>(direction[2]), 0);
+        const __m128 scales = _mm_set1_ps(scale);
+        const __m128 half = _mm_set1_ps(0.5f);
+
+        __m128i rows[4];
+        for (int row = 0; row < 4; ++row) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + row * 16));
+
+            // Two pixels per register as 16-bit channels; madd sums r*dr+g*dg and b*db+0
+            __m128i low = _mm_madd_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(pixels, zero), origin), axis);
+            __m128i high = _mm_madd_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(pixels, zero), origin), axis);
+            low = _mm_add_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+            high = _mm_add_epi32(high, _mm_shuffle_epi32(high, _MM_SHUFFLE(2, 3, 0, 1)));
+            __m128i dots = _mm_unpacklo_epi64(_mm_shuffle_epi32(low, _MM_SHUFFLE(3, 1, 2, 0)),
+                                              _mm_shuffle_epi32(high, _MM_SHUFFLE(3, 1, 2, 0)));
+
+            __m128 positions = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(dots), scales), half);
+            rows[row] = _mm_cvttps_epi32(positions);
+        }
+
+        __m128i packed[2] = { _mm_packs_epi32(rows[0], rows[1]), _mm_packs_epi32(rows[2], rows[3]) };
+        short clamped[16];
+        for (int i = 0; i < 2; ++i) {
+            packed[i] = _mm_min_epi16(_mm_max_epi16(packed[i], zero), _mm_set1_epi16(3));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(clamped + i * 8), packed[i]);
+        }
+        for (int i = 0; i < 16; ++i) {
+            steps[i] = clamped[i];
+        }
+#else
+        for (int i = 0; i < 16; ++i) {
+            const unsigned char* pixel = rgba + i * 4;
+            int dot = (pixel[0] - start[0]) * direction[0] + (pixel[1] - start[1]) * direction[1] +
+                      (pixel[2] - start[2]) * direction[2];
+            int step = static_cast<int>(static_cast<float>(dot) * scale + 0.5f);
+            steps[i] = step < 0 ? 0 : (step > 3 ? 3 : step);
+        }
+#endif
+    }
+
+    // Per-channel minimum and maximum of a block
+    void ColorBounds(const unsigned char* rgba, unsigned char* minimum, unsigned char* maximum) {
+#ifdef TEXTURE_CACHE_SSE2
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba));
+        __m128i high = low;
+        for (int row = 1; row < 4; ++row) {
+            __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + row * 16));
+            low = _mm_min_epu8(low, pixels);
+            high = _mm_max_epu8(high, pixels);
+        }
+        low = _mm_min_epu8(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+        low = _mm_min_epu8(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+        high = _mm_max_epu8(high, _mm_shuffle_epi32(high, _MM_SHUFFLE(1, 0, 3, 2)));
+        high = _mm_max_epu8(high, _mm_shuffle_epi32(high, _MM_SHUFFLE(2, 3, 0, 1)));
+        int lowBits = _mm_cvtsi128_si32(low);
+        int highBits = _mm_cvtsi128_si32(high);
+        std::memcpy(minimum, &lowBits, 4);
+        std::memcpy(maximum, &highBits, 4);
+#else
+        for (int channel = 0; channel < 4; ++channel) {
+            minimum[channel] = 255;
+            maximum[channel] = 0;
+        }
+        for (int i = 0; i < 16; ++i) {
+            for (int channel = 0; channel < 4; ++channel) {
+                minimum[channel] = std::min(minimum[channel], rgba[i * 4 + channel]);
+                maximum[channel] = std::max(maximum[channel], rgba[i * 4 + channel]);
+            }
+        }
+#endif
+    }
+
+    // BC1 color block; BC3 uses the same block for its color
+    void CompressColorBlock(const unsigned char* rgba, unsigned char* block) {
+        unsigned char minimum[4];
+        unsigned char maximum[4];
+        ColorBounds(rgba, minimum, maximum);
+
+        // Use the bounding box diagonal that follows the colors: flip red
+        // or blue when they fall while green rises
+        int center[3] = { (minimum[0] + maximum[0]) / 2, (minimum[1] + maximum[1]) / 2, (minimum[2] + maximum[2]) / 2 };
+        int redGreen = 0;
+        int blueGreen = 0;
+        for (int i = 0; i < 16; ++i) {
+            int green = rgba[i * 4 + 1] - center[1];
+            redGreen += (rgba[i * 4] - center[0]) * green;
+            blueGreen += (rgba[i * 4 + 2] - center[2]) * green;
+        }
+        int high[3] = { maximum[0], maximum[1], maximum[2] };
+        int low[3] = { minimum[0], minimum[1], minimum[2] };
+        if (redGreen < 0) {
+            std::swap(high[0], low[0]);
+        }
+        if (blueGreen < 0) {
+            std::swap(high[2], low[2]);
+        }
+
+        // Inset the endpoints; the extremes are usually outliers
+        for (int channel = 0; channel < 3; ++channel) {
+            int inset = (high[channel] - low[channel]) / 16;
+            high[channel] -= inset;
+            low[channel] += inset;
+        }
+
+        uint16_t color0 = Pack565(high[0], high[1], high[2]);
+        uint16_t color1 = Pack565(low[0], low[1], low[2]);
+        uint32_t indices = 0;
+        if (color0 != color1) {
+            // Four-color mode needs color0 > color1
+            if (color0 < color1) {
+                std::swap(color0, color1);
+            }
+            int start[3];
+            int end[3];
+            Unpack565(color0, start);
+            Unpack565(color1, end);
+
+            // Steps along the line to palette entries: color0, 2/3 color0 +
+            // 1/3 color1, 1/3 color0 + 2/3 color1, color1
+            static const uint32_t stepToIndex[4] = { 0, 2, 3, 1 };
+            int steps[16];
+            ProjectColors(rgba, start, end, steps);
+            for (int i = 0; i < 16; ++i) {
+                indices |= stepToIndex[steps[i]] << (i * 2);
+            }
+        }
+
+        block[0] = static_cast<unsigned char>(color0 & 0xFF);
+        block[1] = static_cast<unsigned char>(color0 >> 8);
+        block[2] = static_cast<unsigned char>(color1 & 0xFF);
+        block[3] = static_cast<unsigned char>(color1 >> 8);
+        for (int i = 0; i < 4; ++i) {
+            block[4 + i] = static_cast<unsigned char>(indices >> (i * 8));
+        }
+    }
+
+    // BC4 block of one channel (BC3 alpha, BC5 red and green)
+    void CompressChannelBlock(const unsigned char* rgba, int channel, unsigned char* block) {
+        int minimum = 255;
+        int maximum = 0;
+        for (int i = 0; i < 16; ++i) {
+            minimum = std::min(minimum, static_cast<int>(rgba[i * 4 + channel]));
+            maximum = std::max(maximum, static_cast<int>(rgba[i * 4 + channel]));
+        }
+
+        // Eight-value mode (value0 > value1): value0, value1, then six steps
+        // from value0 to value1
+        uint64_t indices = 0;
+        if (maximum > minimum) {
+            int range = maximum - minimum;
+            for (int i = 0; i < 16; ++i) {
+                int step = ((rgba[i * 4 + channel] - minimum) * 7 + range / 2) / range;
+                uint64_t index = step == 7 ? 0 : (step == 0 ? 1 : 8 - step);
+                indices |= index << (i * 3);
+            }
+        }
+
+        block[0] = static_cast<unsigned char>(maximum);
+        block[1] = static_cast<unsigned char>(minimum);
+        for (int i = 0; i < 6; ++i) {
+            block[2 + i] = static_cast<unsigned char>(indices >> (i * 8));
+        }
+    }
+
+    void DecompressColorBlock(const unsigned char* block, bool allowTransparent, unsigned char* rgba) {
+        uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+        uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+        int palette[4][4];
+        Unpack565(color0, palette[0]);
+        Unpack565(color1, palette[1]);
+        palette[0][3] = palette[1][3] = 255;
+        for (int channel = 0; channel < 3; ++channel) {
+            if (color0 > color1 || !allowTransparent) {
+                palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+                palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+            } else {
+                palette[2][channel] = (palette[0][channel] + palette[1][channel]) / 2;
+                palette[3][channel] = 0;
+            }
+        }
+        palette[2][3] = 255;
+        palette[3][3] = (color0 > color1 || !allowTransparent) ? 255 : 0;
+
+        uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+        for (int i = 0; i < 16; ++i) {
+            const int* color = palette[(indices >> (i * 2)) & 3];
+            for (int channel = 0; channel < 4; ++channel) {
+                rgba[i * 4 + channel] = static_cast<unsigned char>(color[channel]);
+            }
+        }
+    }
+
+    void DecompressChannelBlock(const unsigned char* block, int channel, unsigned char* rgba) {
+        int values[8];
+        values[0] = block[0];
+        values[1] = block[1];
+        if (values[0] > values[1]) {
+            for (int i = 1; i < 7; ++i) {
+                values[i + 1] = ((7 - i) * values[0] + i * values[1]) / 7;
+            }
+        } else {
+            for (int i = 1; i < 5; ++i) {
+                values[i + 1] = ((5 - i) * values[0] + i * values[1]) / 5;
+            }
+            values[6] = 0;
+            values[7] = 255;
+        }
+
+        uint64_t indices = 0;
+        for (int i = 0; i < 6; ++i) {
+            indices |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+        }
+        for (int i = 0; i < 16; ++i) {
+            rgba[i * 4 + channel] = static_cast<unsigned char>(values[(indices >> (i * 3)) & 7]);
+        }
+    }
+
+    size_t GetBlockSize(TextureCache::Format format) {
+        return format == TextureCache::FORMAT_BC1 ? 8 : 16;
+    }
+
+    // Append one level to the texture in its format
+    void AddLevel(const std::vector<unsigned char>& rgba, uint32_t width, uint32_t height,
+                  TextureCache::Format format, CookedTexture& texture) {
+        CookedTexture::Level level;
+        level.width = width;
+        level.height = height;
+        level.offset = texture.data.size();
+        level.size = TextureCache::GetLevelSize(format, width, height);
+        texture.data.resize(Align8(level.offset + level.size));
+        texture.levels.push_back(level);
+
+        unsigned char* out = texture.data.data() + level.offset;
+        if (format == TextureCache::FORMAT_RGBA8) {
+            std::memcpy(out, rgba.data(), level.size);
+            return;
+        }
+
+        size_t blockSize = GetBlockSize(format);
+        unsigned char pixels[64];
+        for (uint32_t blockY = 0; blockY < height; blockY += 4) {
+            for (uint32_t blockX = 0; blockX < width; blockX += 4) {
+                // Edge blocks repeat the last row and column
+                for (uint32_t y = 0; y < 4; ++y) {
+                    uint32_t sourceY = std::min(blockY + y, height - 1);
+                    for (uint32_t x = 0; x < 4; ++x) {
+                        uint32_t sourceX = std::min(blockX + x, width - 1);
+                        std::memcpy(pixels + (y * 4 + x) * 4, &rgba[(static_cast<size_t>(sourceY) * width + sourceX) * 4], 4);
+                    }
+                }
+
+                if (format == TextureCache::FORMAT_BC1) {
+                    TextureCache::CompressBC1Block(pixels, out);
+                } else if (format == TextureCache::FORMAT_BC3) {
+                    TextureCache::CompressBC3Block(pixels, out);
+                } else {
+                    TextureCache::CompressBC5Block(pixels, out);
+                }
+                out += blockSize;
+            }
+        }
+    }
+
+    // Decode an image file and cook it
+    bool CookImage(const std::string& sourcePath, const unsigned char* bytes, size_t size,
+                   const TextureCache::Options& options, CookedTexture& texture) {
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        unsigned char* pixels = stbi_load_from_memory(bytes, static_cast<int>(size), &width, &height, &channels, 4);
+        if (!pixels) {
+            std::cerr << "Error: Could not decode image " << sourcePath << ": " << stbi_failure_reason() << std::endl;
+            return false;
+        }
+
+        TextureCache::Encode(pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+                             static_cast<uint32_t>(channels), options, texture);
+        stbi_image_free(pixels);
+        return true;
+    }
+}
+
+bool TextureCache::Load(const std::string& sourcePath, const Options& options, CookedTexture& texture,
+                        bool* fromCache) {
+    if (fromCache) {
+        *fromCache = false;
+    }
+
+    // Unchanged since it was cooked, or only the cooked file was shipped
+    if (IsEnabled() && IsCurrent(sourcePath, options)) {
+        if (Read(GetCookedPath(sourcePath, options), texture)) {
+            if (fromCache) {
+                *fromCache = true;
+            }
+            return true;
+        }
+        std::cerr << "Warning: Invalid cooked texture, cooking again: " << GetCookedPath(sourcePath, options)
+                  << std::endl;
+    }
+
+    std::vector<unsigned char> bytes;
+    if (!ReadFile(sourcePath, bytes)) {
+        std::cerr << "Error: Could not open file " << sourcePath << std::endl;
+        return false;
+    }
+    return LoadFromMemory(sourcePath, bytes.data(), bytes.size(), options, texture, fromCache);
+}
+
+bool TextureCache::LoadFromMemory(const std::string& sourcePath, const unsigned char* bytes, size_t size,
+                                  const Options& options, CookedTexture& texture, bool* fromCache) {
+    if (fromCache) {
+        *fromCache = false;
+    }
+    if (!IsEnabled()) {
+        return CookImage(sourcePath, bytes, size, options, texture);
+    }
+
+    std::string cookedPath = GetCookedPath(sourcePath, options);
+    Header source;
+    std::memset(&source, 0, sizeof(source));
+    GetSourceStamp(sourcePath, source.sourceSize, source.sourceTime);
+    source.contentHash = MeshCache::Hash(bytes, size);
+    source.settingsHash = GetSettingsHash(options);
+
+    // Touched but not changed
+    Header header;
+    if (ReadHeader(cookedPath, header) && header.settingsHash == source.settingsHash &&
+        header.contentHash == source.contentHash && Read(cookedPath, texture)) {
+        header.sourceSize = source.sourceSize;
+        header.sourceTime = source.sourceTime;
+        UpdateStamp(cookedPath, header);
+        if (fromCache) {
+            *fromCache = true;
+        }
+        return true;
+    }
+
+    if (!CookImage(sourcePath, bytes, size, options, texture)) {
+        return false;
+    }
+
+    // A failed write only costs the next load a cook
+    Write(cookedPath, texture, source);
+    return true;
+}
+
+bool TextureCache::Cook(const std::string& sourcePath, const Options& options) {
+    std::vector<unsigned char> bytes;
+    if (!ReadFile(sourcePath, bytes)) {
+        std::cerr << "Error: Could not open file " << sourcePath << std::endl;
+        return false;
+    }
+
+    Header source;
+    std::memset(&source, 0, sizeof(source));
+    GetSourceStamp(sourcePath, source.sourceSize, source.sourceTime);
+    source.contentHash = MeshCache::Hash(bytes.data(), bytes.size());
+    source.settingsHash = GetSettingsHash(options);
+
+    CookedTexture texture;
+    if (!CookImage(sourcePath, bytes.data(), bytes.size(), options, texture)) {
+        return false;
+    }
+    return Write(GetCookedPath(sourcePath, options), texture, source);
+}
+
+bool TextureCache::Read(const std::string& cookedPath, CookedTexture& texture) {
+    // The file becomes the texture's data as it is
+    if (!ReadFile(cookedPath, texture.data)) {
+        std::cerr << "Error: Could not open file " << cookedPath << std::endl;
+        return false;
+    }
+    if (!ParseLevels(texture)) {
+        std::cerr << "Error: Invalid cooked texture file: " << cookedPath << std::endl;
+        texture = CookedTexture();
+        return false;
+    }
+    return true;
+}
+
+bool TextureCache::Parse(const unsigned char* bytes, size_t size, CookedTexture& texture) {
+    texture.data.assign(bytes, bytes + size);
+    if (!ParseLevels(texture)) {
+        texture = CookedTexture();
+        return false;
+    }
+    return true;
+}
+
+bool TextureCache::IsCooked(const unsigned char* bytes, size_t size) {
+    Header header;
+    return ReadHeader(bytes, size, header);
+}
+
+bool TextureCache::IsCurrent(const std::string& sourcePath, const Options& options) {
+    Header header;
+    if (!ReadHeader(GetCookedPath(sourcePath, options), header) || header.settingsHash != GetSettingsHash(options)) {
+        return false;
+    }
+
+    uint64_t size = 0;
+    int64_t time = 0;
+    if (!GetSourceStamp(sourcePath, size, time)) {
+        return true;
+    }
+    return header.sourceSize == size && header.sourceTime == time;
+}
+
+bool TextureCache::Write(const std::string& cookedPath, const CookedTexture& texture, const Header& source) {
+    if (texture.levels.empty() || texture.levels.size() > MAX_LEVELS) {
+        std::cerr << "Error: Texture cannot be cooked: " << cookedPath << std::endl;
+        return false;
+    }
+
+    Header header = source;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.format = texture.format;
+    header.width = texture.width;
+    header.height = texture.height;
+    header.channels = texture.channels;
+    header.levelCount = static_cast<uint32_t>(texture.levels.size());
+    header.reserved = 0;
+
+    std::vector<LevelRecord> records;
+    uint64_t offset = Align8(sizeof(Header) + texture.levels.size() * sizeof(LevelRecord));
+    for (const CookedTexture::Level& level : texture.levels) {
+        LevelRecord record;
+        record.width = level.width;
+        record.height = level.height;
+        record.offset = offset;
+        record.size = level.size;
+        records.push_back(record);
+        offset += Align8(level.size);
+    }
+
+    // Written under a temporary name so that a reader never reads a
+    // half-written file; the name is per thread because the same texture
+    // can be streamed by two workers at once
+    std::ostringstream temporaryPath;
+    temporaryPath << cookedPath << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+
+    {
+        std::ofstream file(temporaryPath.str(), std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Warning: Could not write cooked texture: " << cookedPath << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        WriteBlock(file, records.data(), records.size() * sizeof(LevelRecord));
+        for (const CookedTexture::Level& level : texture.levels) {
+            WriteBlock(file, texture.data.data() + level.offset, level.size);
+        }
+        if (!file.good()) {
+            std::cerr << "Warning: Failed writing cooked texture: " << cookedPath << std::endl;
+            file.close();
+            std::remove(temporaryPath.str().c_str());
+            return false;
+        }
+    }
+
+    // rename does not replace an existing file on Windows
+    std::remove(cookedPath.c_str());
+    if (std::rename(temporaryPath.str().c_str(), cookedPath.c_str()) != 0) {
+        std::remove(temporaryPath.str().c_str());
+        std::cerr << "Warning: Could not write cooked texture: " << cookedPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void TextureCache::Encode(const unsigned char* rgba, uint32_t width, uint32_t height, uint32_t channels,
+                          const Options& options, CookedTexture& texture) {
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    Format format = options.format;
+    if (format == FORMAT_AUTO) {
+        bool transparent = false;
+        for (size_t i = 0; i < pixelCount && !transparent; ++i) {
+            transparent = rgba[i * 4 + 3] != 255;
+        }
+        format = transparent ? FORMAT_BC3 : FORMAT_BC1;
+    }
+
+    texture = CookedTexture();
+    texture.format = format;
+    texture.width = width;
+    texture.height = height;
+    texture.channels = channels;
+
+    // Normal maps are vectors, not colors
+    bool normalMap = format == FORMAT_BC5;
+    bool srgb = options.srgb && !normalMap;
+
+    std::vector<unsigned char> level(rgba, rgba + pixelCount * 4);
+    std::vector<unsigned char> next;
+    while (true) {
+        AddLevel(level, width, height, format, texture);
+        if (!options.mipmaps || (width == 1 && height == 1) || texture.levels.size() == options.maxLevels) {
+            break;
+        }
+        Downsample(level.data(), width, height, srgb, normalMap, next, width, height);
+        level.swap(next);
+    }
+}
+
+void TextureCache::Downsample(const unsigned char* rgba, uint32_t width, uint32_t height, bool srgb, bool normalMap,
+                              std::vector<unsigned char>& result, uint32_t& resultWidth, uint32_t& resultHeight) {
+    uint32_t targetWidth = std::max(1u, width / 2);
+    uint32_t targetHeight = std::max(1u, height / 2);
+    std::vector<std::vector<Tap>> columns;
+    std::vector<std::vector<Tap>> rows;
+    BuildTaps(width, targetWidth, columns);
+    BuildTaps(height, targetHeight, rows);
+
+    // Convert once to the space the filter averages in
+    const SrgbTable& table = GetSrgbTable();
+    size_t pixelCount = static_cast<size_t>(width) * height;
+    std::vector<float> values(pixelCount * 4);
+    for (size_t i = 0; i < pixelCount; ++i) {
+        for (int channel = 0; channel < 3; ++channel) {
+            unsigned char value = rgba[i * 4 + channel];
+            if (normalMap) {
+                values[i * 4 + channel] = value / 127.5f - 1.0f;
+            } else {
+                values[i * 4 + channel] = srgb ? table.toLinear[value] : value / 255.0f;
+            }
+        }
+        values[i * 4 + 3] = rgba[i * 4 + 3] / 255.0f;
+    }
+
+    result.resize(static_cast<size_t>(targetWidth) * targetHeight * 4);
+    for (uint32_t y = 0; y < targetHeight; ++y) {
+        for (uint32_t x = 0; x < targetWidth; ++x) {
+            float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            for (const Tap& row : rows[y]) {
+                for (const Tap& column : columns[x]) {
+                    float weight = row.weight * column.weight;
+                    const float* pixel = &values[(static_cast<size_t>(row.index) * width + column.index) * 4];
+                    for (int channel = 0; channel < 4; ++channel) {
+                        sum[channel] += pixel[channel] * weight;
+                    }
+                }
+            }
+
+            unsigned char* out = &result[(static_cast<size_t>(y) * targetWidth + x) * 4];
+            if (normalMap) {
+                float length = std::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2]);
+                if (length > 0.0f) {
+                    for (int channel = 0; channel < 3; ++channel) {
+                        out[channel] = ToByte((sum[channel] / length + 1.0f) * 0.5f);
+                    }
+                } else {
+                    out[0] = out[1] = 128;
+                    out[2] = 255;
+                }
+            } else {
+                for (int channel = 0; channel < 3; ++channel) {
+                    out[channel] = srgb ? table.ToSrgb(sum[channel]) : ToByte(sum[channel]);
+                }
+            }
+            out[3] = ToByte(sum[3]);
+        }
+    }
+
+    resultWidth = targetWidth;
+    resultHeight = targetHeight;
+}
+
+void TextureCache::CompressBC1Block(const unsigned char* rgba, unsigned char* block) {
+    CompressColorBlock(rgba, block);
+}
+
+void TextureCache::CompressBC3Block(const unsigned char* rgba, unsigned char* block) {
+    CompressChannelBlock(rgba, 3, block);
+    CompressColorBlock(rgba, block + 8);
+}
+
+void TextureCache::CompressBC5Block(const unsigned char* rgba, unsigned char* block) {
+    CompressChannelBlock(rgba, 0, block);
+    CompressChannelBlock(rgba, 1, block + 8);
+}
+
+void TextureCache::Decompress(Format format, const unsigned char* blocks, uint32_t width, uint32_t height,
+                              std::vector<unsigned char>& rgba) {
+    rgba.resize(static_cast<size_t>(width) * height * 4);
+    if (format == FORMAT_RGBA8) {
+        std::memcpy(rgba.data(), blocks, rgba.size());
+        return;
+    }
+
+    size_t blockSize = GetBlockSize(format);
+    unsigned char pixels[64];
+    for (uint32_t blockY = 0; blockY < height; blockY += 4) {
+        for (uint32_t blockX = 0; blockX < width; blockX += 4) {
+            if (format == FORMAT_BC1) {
+                DecompressColorBlock(blocks, true, pixels);
+            } else if (format == FORMAT_BC3) {
+                DecompressColorBlock(blocks + 8, false, pixels);
+                DecompressChannelBlock(blocks, 3, pixels);
+            } else {
+                DecompressChannelBlock(blocks, 0, pixels);
+                DecompressChannelBlock(blocks + 8, 1, pixels);
+                for (int i = 0; i < 16; ++i) {
+                    pixels[i * 4 + 2] = 0;
+                    pixels[i * 4 + 3] = 255;
+                }
+            }
+            blocks += blockSize;
+
+            for (uint32_t y = 0; y < 4 && blockY + y < height; ++y) {
+                for (uint32_t x = 0; x < 4 && blockX + x < width; ++x) {
+                    std::memcpy(&rgba[((static_cast<size_t>(blockY) + y) * width + blockX + x) * 4],
+                                pixels + (y * 4 + x) * 4, 4);
+                }
+            }
+        }
+    }
+}
+
+size_t TextureCache::GetLevelSize(Format format, uint32_t width, uint32_t height) {
+    if (format == FORMAT_RGBA8) {
+        return static_cast<size_t>(width) * height * 4;
+    }
+    size_t blocks = static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4);
+    return blocks * GetBlockSize(format);
+}
+
+TextureCache::Options TextureCache::ParseOptions(const std::string& settings) {
+    Options options;
+    std::string format = AssetManager::GetSetting(settings, "format");
+    if (format == "bc1") {
+        options.format = FORMAT_BC1;
+    } else if (format == "bc3") {
+        options.format = FORMAT_BC3;
+    } else if (format == "bc5") {
+        options.format = FORMAT_BC5;
+    } else if (format == "rgba8") {
+        options.format = FORMAT_RGBA8;
+    } else if (!format.empty() && format != "auto") {
+        std::cerr << "Warning: Unknown texture format \"" << format << "\", using auto" << std::endl;
+    }
+    options.mipmaps = AssetManager::GetSetting(settings, "mips") != "0";
+    options.srgb = AssetManager::GetSetting(settings, "srgb") != "0";
+    options.maxLevels = static_cast<uint32_t>(std::strtoul(AssetManager::GetSetting(settings, "levels").c_str(), nullptr, 10));
+    return options;
+}
+
+std::string TextureCache::GetCookedPath(const std::string& sourcePath, const Options& options) {
+    Options defaults;
+    if (options.format == defaults.format && options.mipmaps == defaults.mipmaps && options.srgb == defaults.srgb &&
+        options.maxLevels == defaults.maxLevels) {
+        return sourcePath + ".savtex";
+    }
+
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), "%08x", static_cast<unsigned int>(GetSettingsHash(options) & 0xFFFFFFFFu));
+    return sourcePath + "." + suffix + ".savtex";
+}
+
+uint64_t TextureCache::GetSettingsHash(const Options& options) {
+    uint32_t settings[6] = { IMPORT_VERSION, VERSION, static_cast<uint32_t>(options.format),
+                             options.mipmaps ? 1u : 0u, options.srgb ? 1u : 0u, options.maxLevels };
+    return MeshCache::Hash(settings, sizeof(settings));
+}
+
+void TextureCache::SetEnabled(bool enabled) {
+    cacheEnabled = enabled;
+}
+
+bool TextureCache::IsEnabled() {
+    return cacheEnabled;
+}
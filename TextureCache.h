@@ -0,0 +1,156 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// A texture ready for upload: every mip level, already in the format the
+// GPU samples from
+struct CookedTexture {
+    struct Level {
+        uint32_t width;
+        uint32_t height;
+        size_t offset;      // into data
+        size_t size;
+    };
+
+    uint32_t format = 0;    // TextureCache::Format
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t channels = 0;  // of the source image
+    std::vector<Level> levels;
+    std::vector<unsigned char> data;
+};
+
+// Cooked texture file (.savtex), written next to an image the first time it
+// is loaded ("bark.png" -> "bark.png.savtex") and loaded instead of the
+// image from then on.
+//
+// Layout (little-endian, every block 8-byte aligned):
+//     Header
+//     LevelRecord[levelCount]      largest level first
+//     level data                   BC blocks or RGBA8 pixels
+//
+// The whole file is read with one read and the levels are uploaded as they
+// are, so loading costs no image decoding, no mip generation and no
+// compression. BC1 is 8:1 against RGBA8 (6:1 against RGB8), BC3 and BC5
+// 4:1, in memory and in bandwidth alike.
+//
+// Staleness works as for cooked meshes: size and modification time of the
+// source first, then a hash of its contents. Different import settings
+// ("format=bc5;mips=0") cook different files.
+class TextureCache {
+public:
+    static const uint32_t MAGIC = 0x54564153;    // "SAVT"
+    static const uint32_t VERSION = 1;
+
+    // Bump when the cooker's output changes so old files are recooked
+    static const uint32_t IMPORT_VERSION = 1;
+
+    enum Format : uint32_t {
+        FORMAT_AUTO = 0,    // BC1, or BC3 when the image has transparency
+        FORMAT_RGBA8 = 1,
+        FORMAT_BC1 = 2,     // RGB, 4 bits per pixel
+        FORMAT_BC3 = 3,     // RGBA, 8 bits per pixel
+        FORMAT_BC5 = 4      // two channels (normal map XY), 8 bits per pixel
+    };
+
+    struct Options {
+        Format format;
+        bool mipmaps;
+        bool srgb;              // filter color in linear space
+        uint32_t maxLevels;     // longest mip chain to build, 0 for all
+
+        Options() : format(FORMAT_AUTO), mipmaps(true), srgb(true), maxLevels(0) {}
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t contentHash;     // Hash of the source file
+        uint64_t settingsHash;    // GetSettingsHash() when cooked
+        uint64_t sourceSize;
+        int64_t sourceTime;       // source modification time (nanoseconds)
+        uint32_t format;
+        uint32_t width;
+        uint32_t height;
+        uint32_t channels;
+        uint32_t levelCount;
+        uint32_t reserved;
+    };
+
+    struct LevelRecord {
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;          // from the start of the file
+        uint64_t size;
+    };
+
+    // Load an image through its cooked file, cooking it when the cooked
+    // file is missing or out of date. fromCache, if given, is set to
+    // whether the cooked file was used.
+    static bool Load(const std::string& sourcePath, const Options& options, CookedTexture& texture,
+                     bool* fromCache = nullptr);
+
+    // Cook an image ahead of time
+    static bool Cook(const std::string& sourcePath, const Options& options = Options());
+
+    // Load an image file already read into memory: its cooked file is used
+    // if it was cooked from the same contents, otherwise the image is
+    // cooked (and the cooked file written, unless the cache is disabled)
+    static bool LoadFromMemory(const std::string& sourcePath, const unsigned char* bytes, size_t size,
+                               const Options& options, CookedTexture& texture, bool* fromCache = nullptr);
+
+    // Read and write cooked files directly
+    static bool Read(const std::string& cookedPath, CookedTexture& texture);
+    static bool Write(const std::string& cookedPath, const CookedTexture& texture, const Header& source);
+
+    // Parse a cooked file held in memory
+    static bool Parse(const unsigned char* bytes, size_t size, CookedTexture& texture);
+    static bool IsCooked(const unsigned char* bytes, size_t size);
+
+    // Whether the cooked file of an image can be used without looking at
+    // the image's contents (it is unchanged, or only the cooked file exists)
+    static bool IsCurrent(const std::string& sourcePath, const Options& options);
+
+    // Build the mip chain of RGBA8 pixels and compress every level
+    static void Encode(const unsigned char* rgba, uint32_t width, uint32_t height, uint32_t channels,
+                       const Options& options, CookedTexture& texture);
+
+    // Next mip level, a box filter over the exact source footprint so odd
+    // sizes filter correctly. With srgb, RGB is averaged in linear space;
+    // normalMap renormalizes the averaged vectors.
+    static void Downsample(const unsigned char* rgba, uint32_t width, uint32_t height, bool srgb, bool normalMap,
+                           std::vector<unsigned char>& result, uint32_t& resultWidth, uint32_t& resultHeight);
+
+    // Compress one 4x4 block of RGBA8 pixels (row by row)
+    static void CompressBC1Block(const unsigned char* rgba, unsigned char* block);
+    static void CompressBC3Block(const unsigned char* rgba, unsigned char* block);
+    static void CompressBC5Block(const unsigned char* rgba, unsigned char* block);
+
+    // Expand a compressed level to RGBA8, for tools and tests
+    static void Decompress(Format format, const unsigned char* blocks, uint32_t width, uint32_t height,
+                           std::vector<unsigned char>& rgba);
+
+    // Bytes of one level
+    static size_t GetLevelSize(Format format, uint32_t width, uint32_t height);
+
+    // Options from import settings: "format=bc1|bc3|bc5|rgba8", "mips=0",
+    // "srgb=0", "levels=3"
+    static Options ParseOptions(const std::string& settings);
+
+    // "<source>.savtex"; cooks with other options than the default get
+    // the settings hash in the name so they do not overwrite each other
+    static std::string GetCookedPath(const std::string& sourcePath, const Options& options = Options());
+
+    // Key for the options and cooker version the cooked data depends on
+    static uint64_t GetSettingsHash(const Options& options);
+
+    // With the cache disabled Load always cooks in memory and writes nothing
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+};
+
+#endif // TEXTURE_CACHE_H
@@ -0,0 +1,149 @@
+#include "TimerWheel.h"
+#include <cmath>
+#include <utility>
+
+TimerWheel::TimerWheel(float tickSeconds)
+    : tickSeconds(tickSeconds > 0.0f ? tickSeconds : 0.001f),
+      accumulator(0.0f),
+      currentTick(0),
+      nextId(1) {
+}
+
+TimerWheel::TimerId TimerWheel::Schedule(float delaySeconds, Callback callback) {
+    if (!callback) {
+        return INVALID_TIMER;
+    }
+
+    // Round up so a timer never fires early; always wait at least one tick
+    unsigned long long ticks = 1;
+    if (delaySeconds > 0.0f) {
+        ticks = static_cast<unsigned long long>(std::ceil(delaySeconds / tickSeconds));
+        if (ticks == 0) {
+            ticks = 1;
+        }
+    }
+
+    Timer timer;
+    timer.id = nextId++;
+    timer.expiry = currentTick + ticks;
+    timer.callback = std::move(callback);
+
+    TimerId id = timer.id;
+    Insert(std::move(timer));
+    active.insert(id);
+    return id;
+}
+
+bool TimerWheel::Cancel(TimerId id) {
+    // The timer itself stays in its slot and is dropped when the slot comes up
+    return active.erase(id) > 0;
+}
+
+void TimerWheel::Advance(float deltaSeconds) {
+    if (deltaSeconds <= 0.0f) {
+        return;
+    }
+
+    accumulator += deltaSeconds;
+    unsigned long long ticks = static_cast<unsigned long long>(accumulator / tickSeconds);
+    accumulator -= ticks * tickSeconds;
+
+    // Nothing pending: jump straight to the new time
+    if (active.empty()) {
+        currentTick += ticks;
+        return;
+    }
+
+    for (unsigned long long i = 0; i < ticks; i++) {
+        Tick();
+
+        if (active.empty()) {
+            currentTick += ticks - i - 1;
+            break;
+        }
+    }
+}
+
+void TimerWheel::Clear() {
+    for (int level = 0; level < LEVELS; level++) {
+        for (int slot = 0; slot < SLOTS; slot++) {
+            slots[level][slot].clear();
+        }
+    }
+    active.clear();
+}
+
+void TimerWheel::Insert(Timer&& timer) {
+    unsigned long long delta = timer.expiry > currentTick ? timer.expiry - currentTick : 0;
+
+    for (int level = 0; level < LEVELS; level++) {
+        unsigned long long span = 1ULL << (SLOT_BITS * (level + 1));
+        if (delta < span) {
+            size_t slot = (timer.expiry >> (SLOT_BITS * level)) & SLOT_MASK;
+            slots[level][slot].push_back(std::move(timer));
+            return;
+        }
+    }
+
+    // Beyond the wheel range: park in the top-level slot visited last, the
+    // timer is re-inserted with its real expiry when that slot cascades
+    int top = LEVELS - 1;
+    size_t slot = ((currentTick >> (SLOT_BITS * top)) - 1) & SLOT_MASK;
+    slots[top][slot].push_back(std::move(timer));
+}
+
+void TimerWheel::Cascade(int level) {
+    size_t slot = (currentTick >> (SLOT_BITS * level)) & SLOT_MASK;
+
+    std::vector<Timer> bucket;
+    bucket.swap(slots[level][slot]);
+
+    for (auto& timer : bucket) {
+        if (active.find(timer.id) == active.end()) {
+            continue;
+        }
+        Insert(std::move(timer));
+    }
+}
+
+void TimerWheel::Tick() {
+    currentTick++;
+
+    // Cascade higher levels whose lower digits just wrapped to zero,
+    // starting from the highest so timers trickle all the way down
+    int highest = 0;
+    for (int level = 1; level < LEVELS; level++) {
+        unsigned long long mask = (1ULL << (SLOT_BITS * level)) - 1;
+        if ((currentTick & mask) != 0) {
+            break;
+        }
+        highest = level;
+    }
+    for (int level = highest; level >= 1; level--) {
+        Cascade(level);
+    }
+
+    std::vector<Timer>& current = slots[0][currentTick & SLOT_MASK];
+    if (current.empty()) {
+        return;
+    }
+
+    // Callbacks may schedule new timers, so fire from a detached bucket
+    std::vector<Timer> expired;
+    expired.swap(current);
+
+    for (auto& timer : expired) {
+        if (active.find(timer.id) == active.end()) {
+            continue;
+        }
+
+        if (timer.expiry > currentTick) {
+            // Parked overflow timer that landed here early
+            Insert(std::move(timer));
+            continue;
+        }
+
+        active.erase(timer.id);
+        timer.callback();
+    }
+}
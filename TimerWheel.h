@@ -0,0 +1,75 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <vector>
+#include <functional>
+#include <unordered_set>
+#include <cstddef>
+
+// Hierarchical timer wheel
+//
+// Timers are bucketed by expiry tick into four levels of 64 slots each.
+// Advancing the wheel only touches the slot for the current tick (plus an
+// occasional cascade from a higher level), so the cost of a pending timer
+// is zero until it is about to expire, no matter how many are waiting.
+class TimerWheel {
+public:
+    typedef unsigned long long TimerId;
+    typedef std::function<void()> Callback;
+
+    static const TimerId INVALID_TIMER = 0;
+
+    // tickSeconds is the wheel resolution; delays are rounded up to it
+    explicit TimerWheel(float tickSeconds = 0.001f);
+
+    // Schedule a callback to run once after delaySeconds
+    TimerId Schedule(float delaySeconds, Callback callback);
+
+    // Cancel a pending timer; returns false if it already fired or is unknown
+    bool Cancel(TimerId id);
+
+    // Advance the wheel by deltaSeconds and run every timer that expired
+    void Advance(float deltaSeconds);
+
+    // Drop all pending timers without running them
+    void Clear();
+
+    // Number of timers still waiting to fire
+    size_t GetPendingCount() const { return active.size(); }
+
+    // Current time in ticks since construction
+    unsigned long long GetCurrentTick() const { return currentTick; }
+
+    float GetTickSeconds() const { return tickSeconds; }
+
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 6;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const unsigned long long SLOT_MASK = SLOTS - 1;
+
+    struct Timer {
+        TimerId id;
+        unsigned long long expiry;
+        Callback callback;
+    };
+
+    std::vector<Timer> slots[LEVELS][SLOTS];
+    std::unordered_set<TimerId> active;
+
+    float tickSeconds;
+    float accumulator;
+    unsigned long long currentTick;
+    TimerId nextId;
+
+    // Place a timer in the level/slot matching its distance from now
+    void Insert(Timer&& timer);
+
+    // Re-distribute one higher-level slot into the lower levels
+    void Cascade(int level);
+
+    // Move one tick forward and fire the level 0 slot
+    void Tick();
+};
+
+#endif // TIMER_WHEEL_H
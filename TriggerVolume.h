@@ -4,6 +4,8 @@
 #include "MonoBehaviourLike.h"
 #include "GameObject.h"
 #include "RigidBody.h"
+#include "EventBus.h"
+#include "EngineEvents.h"
 #include <vector>
 #include <algorithm>
 
@@ -11,6 +13,7 @@ class TriggerVolume : public MonoBehaviourLike {
 private:
     bool isEnabled;
     std::vector<GameObject*> objectsInTrigger;
+    std::vector<GameObject*> touching;     // Reported by OnCollision this step
     
 public:
     TriggerVolume() : isEnabled(true) {}
@@ -30,20 +33,22 @@ public:
     }
     
     // Called when a collision is detected
-    void OnCollision(RigidBody* other, const CollisionInfo& info) {
+    void OnCollision(RigidBody* other, const CollisionInfo&) {
         if (!isEnabled || !other) return;
         
         GameObject* otherObj = other->GetGameObject();
         if (!otherObj) return;
         
-        // Check if this is a new object entering the trigger
+        // Check if this is a new object entering the trigger; the
+        // OnTrigger* hooks run when the TriggerEvent is dispatched
         if (!IsObjectInTrigger(otherObj)) {
             objectsInTrigger.push_back(otherObj);
-            OnTriggerEnter();
+            EventBus::GetInstance().Publish(TriggerEvent(this, otherObj, CollisionPhase::ENTER));
         } else {
             // Object is still in the trigger
-            OnTriggerStay();
+            EventBus::GetInstance().Publish(TriggerEvent(this, otherObj, CollisionPhase::STAY));
         }
+        touching.push_back(otherObj);
     }
     
     // Called when a collision ends
@@ -56,10 +61,23 @@ public:
         auto it = std::find(objectsInTrigger.begin(), objectsInTrigger.end(), otherObj);
         if (it != objectsInTrigger.end()) {
             objectsInTrigger.erase(it);
-            OnTriggerExit();
+            EventBus::GetInstance().Publish(TriggerEvent(this, otherObj, CollisionPhase::EXIT));
         }
     }
     
+    // Called by the collision pass after it has reported the step's
+    // collisions: every object OnCollision was not called for has left
+    void EndCollisionStep() {
+        for (size_t i = objectsInTrigger.size(); i-- > 0;) {
+            GameObject* obj = objectsInTrigger[i];
+            if (std::find(touching.begin(), touching.end(), obj) == touching.end()) {
+                objectsInTrigger.erase(objectsInTrigger.begin() + i);
+                EventBus::GetInstance().Publish(TriggerEvent(this, obj, CollisionPhase::EXIT));
+            }
+        }
+        touching.clear();
+    }
+    
     // Override MonoBehaviourLike trigger events for custom behavior
     void OnTriggerEnter() override {}
     void OnTriggerExit() override {}
@@ -0,0 +1,269 @@
+#include "WorldPartition.h"
+#include "Scene.h"
+#include "GameObject.h"
+#include "SceneSerializer.h"
+#include "JobSystem.h"
+#include "ThirdParty/json/json.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+namespace {
+    // Objects added between two clock reads while activating
+    const size_t ACTIVATION_BATCH = 16;
+}
+
+WorldPartition::PendingLoads::~PendingLoads() {
+    // Results nobody collected
+    for (LoadResult& result : results) {
+        SceneSerializer::DestroySceneObjects(result.objects);
+    }
+}
+
+WorldPartition::WorldPartition(Scene* scene)
+    : scene(scene), cellSize(64.0f), loadRadius(128.0f), unloadRadius(160.0f),
+      activationBudgetMs(2.0f), pending(std::make_shared<PendingLoads>()) {
+}
+
+WorldPartition::~WorldPartition() {
+    Clear();
+}
+
+bool WorldPartition::LoadManifest(const std::string& path) {
+    try {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "WorldPartition: could not open manifest " << path << std::endl;
+            return false;
+        }
+
+        nlohmann::json j;
+        file >> j;
+
+        cellSize = j.value("cellSize", cellSize);
+        SetStreamingRadii(j.value("loadRadius", loadRadius), j.value("unloadRadius", unloadRadius));
+
+        std::string directory;
+        size_t slash = path.find_last_of("/\\");
+        if (slash != std::string::npos) {
+            directory = path.substr(0, slash + 1);
+        }
+
+        if (j.contains("cells") && j["cells"].is_array()) {
+            for (const auto& cell : j["cells"]) {
+                std::string scenePath = cell.value("scene", std::string());
+                if (scenePath.empty()) {
+                    continue;
+                }
+                bool absolute = scenePath[0] == '/' || scenePath[0] == '\\' ||
+                                (scenePath.size() > 1 && scenePath[1] == ':');
+                AddCell(cell.value("x", 0), cell.value("z", 0), absolute ? scenePath : directory + scenePath);
+            }
+        }
+
+        std::cout << "WorldPartition: " << cells.size() << " cells from " << path << std::endl;
+        return true;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "WorldPartition: error reading manifest " << path << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void WorldPartition::AddCell(int x, int z, const std::string& scenePath) {
+    long long key = Key(x, z);
+    if (cellLookup.find(key) != cellLookup.end()) {
+        std::cerr << "WorldPartition: cell (" << x << ", " << z << ") already registered" << std::endl;
+        return;
+    }
+
+    Cell cell;
+    cell.x = x;
+    cell.z = z;
+    cell.scenePath = scenePath;
+    cell.state = CellState::UNLOADED;
+    cell.activated = 0;
+    cell.ticket = 0;
+
+    cellLookup[key] = cells.size();
+    cells.push_back(cell);
+}
+
+void WorldPartition::SetStreamingRadii(float load, float unload) {
+    loadRadius = load;
+    // Without a gap cells on the border would thrash
+    unloadRadius = std::max(unload, load);
+}
+
+void WorldPartition::Update(const Vector3& viewerPosition) {
+    CollectResults();
+
+    std::vector<std::pair<float, size_t>> activation;
+    for (size_t i = 0; i < cells.size(); i++) {
+        Cell& cell = cells[i];
+        float distance = DistanceToCell(cell, viewerPosition);
+
+        if (distance > unloadRadius) {
+            if (cell.state != CellState::UNLOADED && cell.state != CellState::FAILED) {
+                Unload(cell);
+            }
+            continue;
+        }
+
+        if (distance <= loadRadius && cell.state == CellState::UNLOADED) {
+            RequestLoad(i);
+        }
+
+        // Cells already loaded finish activating even inside the hysteresis band
+        if (cell.state == CellState::LOADED || cell.state == CellState::ACTIVATING) {
+            activation.push_back(std::make_pair(distance, i));
+        }
+    }
+
+    if (activation.empty()) {
+        return;
+    }
+
+    // Nearest cells first, within the frame budget
+    std::sort(activation.begin(), activation.end());
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& entry : activation) {
+        Cell& cell = cells[entry.second];
+        cell.state = CellState::ACTIVATING;
+
+        while (cell.activated < cell.objects.size()) {
+            size_t count = std::min(ACTIVATION_BATCH, cell.objects.size() - cell.activated);
+            scene->AddGameObjects(&cell.objects[cell.activated], count);
+            cell.activated += count;
+
+            float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (elapsed >= activationBudgetMs) {
+                break;
+            }
+        }
+
+        if (cell.activated < cell.objects.size()) {
+            return;
+        }
+        cell.state = CellState::ACTIVE;
+    }
+}
+
+void WorldPartition::Clear() {
+    for (Cell& cell : cells) {
+        if (cell.state != CellState::UNLOADED) {
+            Unload(cell);
+        }
+    }
+
+    // Free results that arrived for cells that are no longer wanted
+    CollectResults();
+}
+
+WorldPartition::CellState WorldPartition::GetCellState(int x, int z) const {
+    auto it = cellLookup.find(Key(x, z));
+    if (it == cellLookup.end()) {
+        return CellState::UNLOADED;
+    }
+    return cells[it->second].state;
+}
+
+size_t WorldPartition::GetActiveCellCount() const {
+    size_t count = 0;
+    for (const Cell& cell : cells) {
+        if (cell.state == CellState::ACTIVE) {
+            count++;
+        }
+    }
+    return count;
+}
+
+size_t WorldPartition::GetResidentObjectCount() const {
+    size_t count = 0;
+    for (const Cell& cell : cells) {
+        count += cell.objects.size();
+    }
+    return count;
+}
+
+long long WorldPartition::Key(int x, int z) {
+    unsigned long long high = static_cast<unsigned int>(x);
+    return static_cast<long long>((high << 32) | static_cast<unsigned int>(z));
+}
+
+float WorldPartition::DistanceToCell(const Cell& cell, const Vector3& position) const {
+    // Distance on the XZ plane to the nearest point of the cell
+    float minX = cell.x * cellSize;
+    float minZ = cell.z * cellSize;
+    float dx = std::max(std::max(minX - position.x, 0.0f), position.x - (minX + cellSize));
+    float dz = std::max(std::max(minZ - position.z, 0.0f), position.z - (minZ + cellSize));
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+void WorldPartition::CollectResults() {
+    std::vector<LoadResult> results;
+    {
+        std::lock_guard<std::mutex> lock(pending->mutex);
+        results.swap(pending->results);
+    }
+
+    for (LoadResult& result : results) {
+        Cell& cell = cells[result.cell];
+
+        // The cell was unloaded (or reloaded) while this result was in flight
+        if (cell.state != CellState::LOADING || cell.ticket != result.ticket) {
+            SceneSerializer::DestroySceneObjects(result.objects);
+            continue;
+        }
+
+        if (!result.ok) {
+            SceneSerializer::DestroySceneObjects(result.objects);
+            cell.state = CellState::FAILED;
+            continue;
+        }
+
+        cell.objects.swap(result.objects);
+        cell.activated = 0;
+        cell.state = CellState::LOADED;
+    }
+}
+
+void WorldPartition::RequestLoad(size_t index) {
+    Cell& cell = cells[index];
+    cell.state = CellState::LOADING;
+    unsigned int ticket = ++cell.ticket;
+
+    std::shared_ptr<PendingLoads> sink = pending;
+    std::string path = cell.scenePath;
+    JobSystem::GetInstance().Submit([sink, index, ticket, path]() {
+        LoadResult result;
+        result.cell = index;
+        result.ticket = ticket;
+        result.ok = SceneSerializer::LoadSceneFile(path, result.objects);
+
+        std::lock_guard<std::mutex> lock(sink->mutex);
+        sink->results.push_back(std::move(result));
+    });
+}
+
+void WorldPartition::Unload(Cell& cell) {
+    if (cell.state == CellState::LOADING) {
+        // Invalidate the result still in flight
+        cell.ticket++;
+        cell.state = CellState::UNLOADED;
+        return;
+    }
+
+    if (cell.activated > 0) {
+        std::vector<GameObject*> inScene(cell.objects.begin(), cell.objects.begin() + cell.activated);
+        scene->RemoveGameObjects(inScene);
+    }
+
+    SceneSerializer::DestroySceneObjects(cell.objects);
+    cell.activated = 0;
+    cell.state = CellState::UNLOADED;
+}
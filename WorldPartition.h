@@ -0,0 +1,115 @@
+#ifndef WORLD_PARTITION_H
+#define WORLD_PARTITION_H
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstddef>
+#include "Vector3.h"
+
+class Scene;
+class GameObject;
+
+// Streams a large level that is split into a grid of cells on the XZ plane.
+// Each cell is its own scene file in either scene format (see SceneSerializer::LoadSceneFile).
+//
+// Cells within the load radius of the viewer are parsed on JobSystem
+// workers, then added to the scene a few objects at a time under a
+// per-frame time budget. Cells beyond the (larger) unload radius leave the
+// scene and are freed. The gap between the two radii stops cells on a
+// border from loading and unloading every frame.
+//
+//     WorldPartition world(scene);
+//     world.LoadManifest("Worlds/overworld.json");
+//     scene->SetWorldPartition(&world);   // Scene::Update streams around the main camera
+class WorldPartition {
+public:
+    enum class CellState {
+        UNLOADED,
+        LOADING,     // being parsed on a worker
+        LOADED,      // parsed, waiting to be activated
+        ACTIVATING,  // partially added to the scene
+        ACTIVE,      // fully in the scene
+        FAILED       // file missing or invalid; not retried
+    };
+
+    explicit WorldPartition(Scene* scene);
+    ~WorldPartition();
+
+    // Read a manifest:
+    //     { "cellSize": 64, "loadRadius": 128, "unloadRadius": 160,
+    //       "cells": [ { "x": 0, "z": 0, "scene": "cells/0_0.json" } ] }
+    // Relative cell paths are resolved against the manifest's directory.
+    bool LoadManifest(const std::string& path);
+
+    // Register a cell by grid coordinate
+    void AddCell(int x, int z, const std::string& scenePath);
+
+    void SetCellSize(float size) { cellSize = size; }
+    float GetCellSize() const { return cellSize; }
+
+    // Cells load inside loadRadius and unload outside unloadRadius
+    void SetStreamingRadii(float load, float unload);
+    float GetLoadRadius() const { return loadRadius; }
+    float GetUnloadRadius() const { return unloadRadius; }
+
+    // Main-thread time spent adding loaded objects to the scene per Update
+    void SetActivationBudget(float milliseconds) { activationBudgetMs = milliseconds; }
+    float GetActivationBudget() const { return activationBudgetMs; }
+
+    // Stream cells around the viewer. Main thread only.
+    void Update(const Vector3& viewerPosition);
+
+    // Remove and free every cell; loads in flight are discarded
+    void Clear();
+
+    CellState GetCellState(int x, int z) const;
+    size_t GetCellCount() const { return cells.size(); }
+    size_t GetActiveCellCount() const;
+    size_t GetResidentObjectCount() const;
+
+private:
+    struct Cell {
+        int x;
+        int z;
+        std::string scenePath;
+        CellState state;
+        std::vector<GameObject*> objects;
+        size_t activated;        // objects already in the scene
+        unsigned int ticket;     // matches a load result to the request
+    };
+
+    struct LoadResult {
+        size_t cell;
+        unsigned int ticket;
+        bool ok;
+        std::vector<GameObject*> objects;
+    };
+
+    // Shared with in-flight jobs so they never outlive their destination
+    struct PendingLoads {
+        std::mutex mutex;
+        std::vector<LoadResult> results;
+        ~PendingLoads();
+    };
+
+    Scene* scene;
+    float cellSize;
+    float loadRadius;
+    float unloadRadius;
+    float activationBudgetMs;
+
+    std::vector<Cell> cells;
+    std::unordered_map<long long, size_t> cellLookup;
+    std::shared_ptr<PendingLoads> pending;
+
+    static long long Key(int x, int z);
+    float DistanceToCell(const Cell& cell, const Vector3& position) const;
+    void CollectResults();
+    void RequestLoad(size_t index);
+    void Unload(Cell& cell);
+};
+
+#endif // WORLD_PARTITION_H
@@ -38,6 +38,22 @@ echo "Compiling OpenGLGraphicsAPI..."
 g++ $CFLAGS $INCLUDES $DEFINES -c Graphics/Core/OpenGLGraphicsAPI.cpp -o bin/linux/OpenGLGraphicsAPI.o
 check_status "OpenGLGraphicsAPI compilation"
 
+echo "Compiling GLStateCache..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Graphics/Core/GLStateCache.cpp -o bin/linux/GLStateCache.o
+check_status "GLStateCache compilation"
+
+
+echo "Compiling NullGraphicsAPI..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Graphics/Core/NullGraphicsAPI.cpp -o bin/linux/NullGraphicsAPI.o
+check_status "NullGraphicsAPI compilation"
+
+echo "Compiling RecordingGraphicsAPI..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Graphics/Core/RecordingGraphicsAPI.cpp -o bin/linux/RecordingGraphicsAPI.o
+check_status "RecordingGraphicsAPI compilation"
+
+echo "Compiling GraphicsTrace..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Graphics/Core/GraphicsTrace.cpp -o bin/linux/GraphicsTrace.o
+check_status "GraphicsTrace compilation"
 
 echo "Compiling GraphicsAPIFactory..."
 g++ $CFLAGS $INCLUDES $DEFINES -c Graphics/Core/GraphicsAPIFactory.cpp -o bin/linux/GraphicsAPIFactory.o
@@ -61,11 +77,95 @@ echo "Compiling Model..."
 g++ $CFLAGS $INCLUDES $DEFINES -c Model.cpp -o bin/linux/Model.o
 check_status "Model compilation"
 
+echo "Compiling ObjLoader..."
+g++ $CFLAGS $INCLUDES $DEFINES -c ObjLoader.cpp -o bin/linux/ObjLoader.o
+check_status "ObjLoader compilation"
+
+echo "Compiling MeshCache..."
+g++ $CFLAGS $INCLUDES $DEFINES -c MeshCache.cpp -o bin/linux/MeshCache.o
+check_status "MeshCache compilation"
+
+echo "Compiling MeshOptimizer..."
+g++ $CFLAGS $INCLUDES $DEFINES -c MeshOptimizer.cpp -o bin/linux/MeshOptimizer.o
+check_status "MeshOptimizer compilation"
+
+echo "Compiling MeshSimplifier..."
+g++ $CFLAGS $INCLUDES $DEFINES -c MeshSimplifier.cpp -o bin/linux/MeshSimplifier.o
+check_status "MeshSimplifier compilation"
+
+echo "Compiling LodGroup..."
+g++ $CFLAGS $INCLUDES $DEFINES -c LodGroup.cpp -o bin/linux/LodGroup.o
+check_status "LodGroup compilation"
+
+echo "Compiling RenderQueue..."
+g++ $CFLAGS $INCLUDES $DEFINES -c RenderQueue.cpp -o bin/linux/RenderQueue.o
+check_status "RenderQueue compilation"
+
+echo "Compiling FrustumCuller..."
+g++ $CFLAGS $INCLUDES $DEFINES -c FrustumCuller.cpp -o bin/linux/FrustumCuller.o
+check_status "FrustumCuller compilation"
+
+echo "Compiling AssetManager..."
+g++ $CFLAGS $INCLUDES $DEFINES -c AssetManager.cpp -o bin/linux/AssetManager.o
+check_status "AssetManager compilation"
+
+echo "Compiling AssetHotReload..."
+g++ $CFLAGS $INCLUDES $DEFINES -c AssetHotReload.cpp -o bin/linux/AssetHotReload.o
+check_status "AssetHotReload compilation"
+
+echo "Compiling ShaderPreprocessor..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Shaders/Core/ShaderPreprocessor.cpp -o bin/linux/ShaderPreprocessor.o
+check_status "ShaderPreprocessor compilation"
+
+echo "Compiling ShaderSourceCache..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Shaders/Core/ShaderSourceCache.cpp -o bin/linux/ShaderSourceCache.o
+check_status "ShaderSourceCache compilation"
+
+echo "Compiling ShaderUniforms..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Shaders/Core/ShaderUniforms.cpp -o bin/linux/ShaderUniforms.o
+check_status "ShaderUniforms compilation"
+
+echo "Compiling FileWatcher..."
+g++ $CFLAGS $INCLUDES $DEFINES -c FileWatcher.cpp -o bin/linux/FileWatcher.o
+check_status "FileWatcher compilation"
+
+echo "Compiling AssetStreamer..."
+g++ $CFLAGS $INCLUDES $DEFINES -c AssetStreamer.cpp -o bin/linux/AssetStreamer.o
+check_status "AssetStreamer compilation"
+
+echo "Compiling Texture..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Texture.cpp -o bin/linux/Texture.o
+check_status "Texture compilation"
+
+echo "Compiling TextureCache..."
+g++ $CFLAGS $INCLUDES $DEFINES -c TextureCache.cpp -o bin/linux/TextureCache.o
+check_status "TextureCache compilation"
+
+echo "Compiling TextureAtlas..."
+g++ $CFLAGS $INCLUDES $DEFINES -c TextureAtlas.cpp -o bin/linux/TextureAtlas.o
+check_status "TextureAtlas compilation"
+
+echo "Compiling Debugger..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Debugger.cpp -o bin/linux/Debugger.o
+check_status "Debugger compilation"
+
+echo "Compiling MappedFile..."
+g++ $CFLAGS $INCLUDES $DEFINES -c MappedFile.cpp -o bin/linux/MappedFile.o
+check_status "MappedFile compilation"
+
 # Compile GameObject and related components
 echo "Compiling GameObject..."
 g++ $CFLAGS $INCLUDES $DEFINES -c GameObject.cpp -o bin/linux/GameObject.o
 check_status "GameObject compilation"
 
+echo "Compiling TimerWheel..."
+g++ $CFLAGS $INCLUDES $DEFINES -c TimerWheel.cpp -o bin/linux/TimerWheel.o
+check_status "TimerWheel compilation"
+
+echo "Compiling Coroutine..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Coroutine.cpp -o bin/linux/Coroutine.o
+check_status "Coroutine compilation"
+
 echo "Compiling Camera..."
 g++ $CFLAGS $INCLUDES $DEFINES -c Camera.cpp -o bin/linux/Camera.o
 check_status "Camera compilation"
@@ -91,6 +191,46 @@ g++ $CFLAGS $INCLUDES $DEFINES -c CollisionSystem.cpp -o bin/linux/CollisionSyst
 echo "Compiling PhysicsSystem..."
 g++ $CFLAGS $INCLUDES $DEFINES -c PhysicsSystem.cpp -o bin/linux/PhysicsSystem.o || echo "Warning: PhysicsSystem compilation failed, but continuing..."
 
+# Compile the event bus used by physics, triggers and navigation
+echo "Compiling EventBus..."
+g++ $CFLAGS $INCLUDES $DEFINES -c EventBus.cpp -o bin/linux/EventBus.o
+check_status "EventBus compilation"
+
+# Compile prefabs and instance pooling
+echo "Compiling Prefab..."
+g++ $CFLAGS $INCLUDES $DEFINES -c Prefab.cpp -o bin/linux/Prefab.o
+check_status "Prefab compilation"
+
+# Compile copy-on-write scene snapshots
+echo "Compiling SceneSnapshot..."
+g++ $CFLAGS $INCLUDES $DEFINES -c SceneSnapshot.cpp -o bin/linux/SceneSnapshot.o
+check_status "SceneSnapshot compilation"
+
+# Compile scene loading and world streaming
+echo "Compiling SceneSerializer..."
+g++ $CFLAGS $INCLUDES $DEFINES -c SceneSerializer.cpp -o bin/linux/SceneSerializer.o
+check_status "SceneSerializer compilation"
+
+echo "Compiling BinaryScene..."
+g++ $CFLAGS $INCLUDES $DEFINES -c BinaryScene.cpp -o bin/linux/BinaryScene.o
+check_status "BinaryScene compilation"
+
+echo "Compiling JobSystem..."
+g++ $CFLAGS $INCLUDES $DEFINES -c JobSystem.cpp -o bin/linux/JobSystem.o
+check_status "JobSystem compilation"
+
+echo "Compiling WorldPartition..."
+g++ $CFLAGS $INCLUDES $DEFINES -c WorldPartition.cpp -o bin/linux/WorldPartition.o
+check_status "WorldPartition compilation"
+
+echo "Compiling SceneLoadOperation..."
+g++ $CFLAGS $INCLUDES $DEFINES -c SceneLoadOperation.cpp -o bin/linux/SceneLoadOperation.o
+check_status "SceneLoadOperation compilation"
+
+echo "Compiling SceneJournal..."
+g++ $CFLAGS $INCLUDES $DEFINES -c SceneJournal.cpp -o bin/linux/SceneJournal.o
+check_status "SceneJournal compilation"
+
 # Compile navigation mesh components
 echo "Compiling NavMesh..."
 g++ $CFLAGS $INCLUDES $DEFINES -c NavMesh.cpp -o bin/linux/NavMesh.o
@@ -119,7 +259,7 @@ g++ $CFLAGS $INCLUDES $DEFINES -c Profiler.cpp -o bin/linux/Profiler.o || echo "
 
 # Create a static library with the components that compiled successfully
 echo "Creating static library..."
-ar rcs bin/linux/libGameEngineSavi.a bin/linux/OpenGLGraphicsAPI.o bin/linux/GraphicsAPIFactory.o bin/linux/Vector3.o bin/linux/Matrix4x4.o bin/linux/Model.o bin/linux/GameObject.o bin/linux/Camera.o bin/linux/DirectionalLight.o bin/linux/Raycast.o bin/linux/TimeManager.o bin/linux/NavMesh.o bin/linux/NavMeshManager.o bin/linux/AIEntity.o bin/linux/ProjectSettings.o
+ar rcs bin/linux/libGameEngineSavi.a bin/linux/OpenGLGraphicsAPI.o bin/linux/GLStateCache.o bin/linux/GraphicsAPIFactory.o bin/linux/NullGraphicsAPI.o bin/linux/RecordingGraphicsAPI.o bin/linux/GraphicsTrace.o bin/linux/Vector3.o bin/linux/Matrix4x4.o bin/linux/Model.o bin/linux/ObjLoader.o bin/linux/MeshCache.o bin/linux/MeshOptimizer.o bin/linux/MeshSimplifier.o bin/linux/LodGroup.o bin/linux/RenderQueue.o bin/linux/FrustumCuller.o bin/linux/AssetManager.o bin/linux/AssetHotReload.o bin/linux/ShaderPreprocessor.o bin/linux/ShaderSourceCache.o bin/linux/ShaderUniforms.o bin/linux/FileWatcher.o bin/linux/AssetStreamer.o bin/linux/Texture.o bin/linux/TextureCache.o bin/linux/TextureAtlas.o bin/linux/Debugger.o bin/linux/MappedFile.o bin/linux/GameObject.o bin/linux/TimerWheel.o bin/linux/Coroutine.o bin/linux/Camera.o bin/linux/DirectionalLight.o bin/linux/Raycast.o bin/linux/TimeManager.o bin/linux/EventBus.o bin/linux/Prefab.o bin/linux/SceneSnapshot.o bin/linux/SceneSerializer.o bin/linux/BinaryScene.o bin/linux/JobSystem.o bin/linux/WorldPartition.o bin/linux/SceneLoadOperation.o bin/linux/SceneJournal.o bin/linux/NavMesh.o bin/linux/NavMeshManager.o bin/linux/AIEntity.o bin/linux/ProjectSettings.o
 if [ -f bin/linux/RigidBody.o ]; then
     ar rcs bin/linux/libGameEngineSavi.a bin/linux/RigidBody.o
 fi
@@ -29,6 +29,34 @@ if %ERRORLEVEL% NEQ 0 (
     exit /b 1
 )
 
+echo Compiling GLStateCache...
+g++ %CFLAGS% %INCLUDES% -c Graphics\Core\GLStateCache.cpp -o bin\windows\GLStateCache.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: GLStateCache compilation failed
+    exit /b 1
+)
+
+echo Compiling NullGraphicsAPI...
+g++ %CFLAGS% %INCLUDES% -c Graphics\Core\NullGraphicsAPI.cpp -o bin\windows\NullGraphicsAPI.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: NullGraphicsAPI compilation failed
+    exit /b 1
+)
+
+echo Compiling RecordingGraphicsAPI...
+g++ %CFLAGS% %INCLUDES% -c Graphics\Core\RecordingGraphicsAPI.cpp -o bin\windows\RecordingGraphicsAPI.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: RecordingGraphicsAPI compilation failed
+    exit /b 1
+)
+
+echo Compiling GraphicsTrace...
+g++ %CFLAGS% %INCLUDES% -c Graphics\Core\GraphicsTrace.cpp -o bin\windows\GraphicsTrace.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: GraphicsTrace compilation failed
+    exit /b 1
+)
+
 echo Compiling GraphicsAPIFactory...
 g++ %CFLAGS% %INCLUDES% -c Graphics\Core\GraphicsAPIFactory.cpp -o bin\windows\GraphicsAPIFactory.o -DPLATFORM_WINDOWS
 if %ERRORLEVEL% NEQ 0 (
@@ -66,6 +94,139 @@ if %ERRORLEVEL% NEQ 0 (
     exit /b 1
 )
 
+echo Compiling ObjLoader...
+g++ %CFLAGS% %INCLUDES% -c ObjLoader.cpp -o bin\windows\ObjLoader.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: ObjLoader compilation failed
+    exit /b 1
+)
+
+echo Compiling MeshCache...
+g++ %CFLAGS% %INCLUDES% -c MeshCache.cpp -o bin\windows\MeshCache.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: MeshCache compilation failed
+    exit /b 1
+)
+
+echo Compiling MeshOptimizer...
+g++ %CFLAGS% %INCLUDES% -c MeshOptimizer.cpp -o bin\windows\MeshOptimizer.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: MeshOptimizer compilation failed
+    exit /b 1
+)
+
+echo Compiling MeshSimplifier...
+g++ %CFLAGS% %INCLUDES% -c MeshSimplifier.cpp -o bin\windows\MeshSimplifier.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: MeshSimplifier compilation failed
+    exit /b 1
+)
+
+echo Compiling LodGroup...
+g++ %CFLAGS% %INCLUDES% -c LodGroup.cpp -o bin\windows\LodGroup.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: LodGroup compilation failed
+    exit /b 1
+)
+
+echo Compiling RenderQueue...
+g++ %CFLAGS% %INCLUDES% -c RenderQueue.cpp -o bin\windows\RenderQueue.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: RenderQueue compilation failed
+    exit /b 1
+)
+
+echo Compiling FrustumCuller...
+g++ %CFLAGS% %INCLUDES% -c FrustumCuller.cpp -o bin\windows\FrustumCuller.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: FrustumCuller compilation failed
+    exit /b 1
+)
+
+echo Compiling AssetManager...
+g++ %CFLAGS% %INCLUDES% -c AssetManager.cpp -o bin\windows\AssetManager.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: AssetManager compilation failed
+    exit /b 1
+)
+
+echo Compiling AssetHotReload...
+g++ %CFLAGS% %INCLUDES% -c AssetHotReload.cpp -o bin\windows\AssetHotReload.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: AssetHotReload compilation failed
+    exit /b 1
+)
+
+echo Compiling ShaderPreprocessor...
+g++ %CFLAGS% %INCLUDES% -c Shaders\Core\ShaderPreprocessor.cpp -o bin\windows\ShaderPreprocessor.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: ShaderPreprocessor compilation failed
+    exit /b 1
+)
+
+echo Compiling ShaderSourceCache...
+g++ %CFLAGS% %INCLUDES% -c Shaders\Core\ShaderSourceCache.cpp -o bin\windows\ShaderSourceCache.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: ShaderSourceCache compilation failed
+    exit /b 1
+)
+
+echo Compiling ShaderUniforms...
+g++ %CFLAGS% %INCLUDES% -c Shaders\Core\ShaderUniforms.cpp -o bin\windows\ShaderUniforms.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: ShaderUniforms compilation failed
+    exit /b 1
+)
+
+echo Compiling FileWatcher...
+g++ %CFLAGS% %INCLUDES% -c FileWatcher.cpp -o bin\windows\FileWatcher.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: FileWatcher compilation failed
+    exit /b 1
+)
+
+echo Compiling AssetStreamer...
+g++ %CFLAGS% %INCLUDES% -c AssetStreamer.cpp -o bin\windows\AssetStreamer.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: AssetStreamer compilation failed
+    exit /b 1
+)
+
+echo Compiling Texture...
+g++ %CFLAGS% %INCLUDES% -c Texture.cpp -o bin\windows\Texture.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: Texture compilation failed
+    exit /b 1
+)
+
+echo Compiling TextureCache...
+g++ %CFLAGS% %INCLUDES% -c TextureCache.cpp -o bin\windows\TextureCache.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: TextureCache compilation failed
+    exit /b 1
+)
+
+echo Compiling TextureAtlas...
+g++ %CFLAGS% %INCLUDES% -c TextureAtlas.cpp -o bin\windows\TextureAtlas.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: TextureAtlas compilation failed
+    exit /b 1
+)
+
+echo Compiling Debugger...
+g++ %CFLAGS% %INCLUDES% -c Debugger.cpp -o bin\windows\Debugger.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: Debugger compilation failed
+    exit /b 1
+)
+
+echo Compiling MappedFile...
+g++ %CFLAGS% %INCLUDES% -c MappedFile.cpp -o bin\windows\MappedFile.o -DPLATFORM_WINDOWS
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: MappedFile compilation failed
+    exit /b 1
+)
+
 REM Compile GameObject and related components
 echo Compiling GameObject...
 g++ %CFLAGS% %INCLUDES% -c GameObject.cpp -o bin\windows\GameObject.o
@@ -74,6 +235,20 @@ if %ERRORLEVEL% NEQ 0 (
     exit /b 1
 )
 
+echo Compiling TimerWheel...
+g++ %CFLAGS% %INCLUDES% -c TimerWheel.cpp -o bin\windows\TimerWheel.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: TimerWheel compilation failed
+    exit /b 1
+)
+
+echo Compiling Coroutine...
+g++ %CFLAGS% %INCLUDES% -c Coroutine.cpp -o bin\windows\Coroutine.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: Coroutine compilation failed
+    exit /b 1
+)
+
 echo Compiling Camera...
 g++ %CFLAGS% %INCLUDES% -c Camera.cpp -o bin\windows\Camera.o
 if %ERRORLEVEL% NEQ 0 (
@@ -117,6 +292,73 @@ if %ERRORLEVEL% NEQ 0 (
     echo Warning: PhysicsSystem compilation failed, but continuing...
 )
 
+REM Compile the event bus used by physics, triggers and navigation
+echo Compiling EventBus...
+g++ %CFLAGS% %INCLUDES% -c EventBus.cpp -o bin\windows\EventBus.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: EventBus compilation failed
+    exit /b 1
+)
+
+REM Compile prefabs and instance pooling
+echo Compiling Prefab...
+g++ %CFLAGS% %INCLUDES% -c Prefab.cpp -o bin\windows\Prefab.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: Prefab compilation failed
+    exit /b 1
+)
+
+REM Compile copy-on-write scene snapshots
+echo Compiling SceneSnapshot...
+g++ %CFLAGS% %INCLUDES% -c SceneSnapshot.cpp -o bin\windows\SceneSnapshot.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: SceneSnapshot compilation failed
+    exit /b 1
+)
+
+REM Compile scene loading and world streaming
+echo Compiling SceneSerializer...
+g++ %CFLAGS% %INCLUDES% -c SceneSerializer.cpp -o bin\windows\SceneSerializer.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: SceneSerializer compilation failed
+    exit /b 1
+)
+
+echo Compiling BinaryScene...
+g++ %CFLAGS% %INCLUDES% -c BinaryScene.cpp -o bin\windows\BinaryScene.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: BinaryScene compilation failed
+    exit /b 1
+)
+
+echo Compiling JobSystem...
+g++ %CFLAGS% %INCLUDES% -c JobSystem.cpp -o bin\windows\JobSystem.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: JobSystem compilation failed
+    exit /b 1
+)
+
+echo Compiling WorldPartition...
+g++ %CFLAGS% %INCLUDES% -c WorldPartition.cpp -o bin\windows\WorldPartition.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: WorldPartition compilation failed
+    exit /b 1
+)
+
+echo Compiling SceneLoadOperation...
+g++ %CFLAGS% %INCLUDES% -c SceneLoadOperation.cpp -o bin\windows\SceneLoadOperation.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: SceneLoadOperation compilation failed
+    exit /b 1
+)
+
+echo Compiling SceneJournal...
+g++ %CFLAGS% %INCLUDES% -c SceneJournal.cpp -o bin\windows\SceneJournal.o
+if %ERRORLEVEL% NEQ 0 (
+    echo Error: SceneJournal compilation failed
+    exit /b 1
+)
+
 REM Compile navigation mesh components
 echo Compiling NavMesh...
 g++ %CFLAGS% %INCLUDES% -c NavMesh.cpp -o bin\windows\NavMesh.o
@@ -163,7 +405,7 @@ if %ERRORLEVEL% NEQ 0 (
 
 REM Create a static library with the components that compiled successfully
 echo Creating static library...
-ar rcs bin\windows\libGameEngineSavi.a bin\windows\OpenGLGraphicsAPI.o bin\windows\GraphicsAPIFactory.o bin\windows\Vector3.o bin\windows\Matrix4x4.o bin\windows\Model.o bin\windows\GameObject.o bin\windows\Camera.o bin\windows\DirectionalLight.o bin\windows\Raycast.o bin\windows\TimeManager.o bin\windows\NavMesh.o bin\windows\NavMeshManager.o bin\windows\AIEntity.o bin\windows\ProjectSettings.o
+ar rcs bin\windows\libGameEngineSavi.a bin\windows\OpenGLGraphicsAPI.o bin\windows\GLStateCache.o bin\windows\GraphicsAPIFactory.o bin\windows\NullGraphicsAPI.o bin\windows\RecordingGraphicsAPI.o bin\windows\GraphicsTrace.o bin\windows\Vector3.o bin\windows\Matrix4x4.o bin\windows\Model.o bin\windows\ObjLoader.o bin\windows\MeshCache.o bin\windows\MeshOptimizer.o bin\windows\MeshSimplifier.o bin\windows\LodGroup.o bin\windows\RenderQueue.o bin\windows\FrustumCuller.o bin\windows\AssetManager.o bin\windows\AssetHotReload.o bin\windows\ShaderPreprocessor.o bin\windows\ShaderSourceCache.o bin\windows\ShaderUniforms.o bin\windows\FileWatcher.o bin\windows\AssetStreamer.o bin\windows\Texture.o bin\windows\TextureCache.o bin\windows\TextureAtlas.o bin\windows\Debugger.o bin\windows\MappedFile.o bin\windows\GameObject.o bin\windows\TimerWheel.o bin\windows\Coroutine.o bin\windows\Camera.o bin\windows\DirectionalLight.o bin\windows\Raycast.o bin\windows\TimeManager.o bin\windows\EventBus.o bin\windows\Prefab.o bin\windows\SceneSnapshot.o bin\windows\SceneSerializer.o bin\windows\BinaryScene.o bin\windows\JobSystem.o bin\windows\WorldPartition.o bin\windows\SceneLoadOperation.o bin\windows\SceneJournal.o bin\windows\NavMesh.o bin\windows\NavMeshManager.o bin\windows\AIEntity.o bin\windows\ProjectSettings.o
 
 REM Add optional components if they compiled successfully
 if exist bin\windows\RigidBody.o (
@@ -229,10 +471,24 @@ g++ %CFLAGS% %INCLUDES% -o bin\windows\editor.exe ^
     Editor\Vector3Field.cpp ^
     Editor\TextField.cpp ^
     GameObject.cpp ^
+    TimerWheel.cpp ^
+    Coroutine.cpp ^
     Vector3.cpp ^
     Matrix4x4.cpp ^
     Camera.cpp ^
     Model.cpp ^
+    ObjLoader.cpp ^
+    MeshCache.cpp ^
+    MeshOptimizer.cpp ^
+    MeshSimplifier.cpp ^
+    LodGroup.cpp ^
+    RenderQueue.cpp ^
+    AssetManager.cpp ^
+    AssetHotReload.cpp ^
+    FileWatcher.cpp ^
+    AssetStreamer.cpp ^
+    JobSystem.cpp ^
+    MappedFile.cpp ^
     MonoBehaviourLike.cpp ^
     TimeManager.cpp ^
     Raycast.cpp ^
@@ -240,12 +496,22 @@ g++ %CFLAGS% %INCLUDES% -o bin\windows\editor.exe ^
     CollisionSystem.cpp ^
     PhysicsSystem.cpp ^
     Scene.cpp ^
+    FrustumCuller.cpp ^
+    SceneJournal.cpp ^
+    SceneSerializer.cpp ^
+    BinaryScene.cpp ^
     PointLight.cpp ^
     CameraManager.cpp ^
     Shaders\Core\ShaderProgram.cpp ^
     Shaders\Core\Shader.cpp ^
+    Shaders\Core\ShaderPreprocessor.cpp ^
+    Shaders\Core\ShaderSourceCache.cpp ^
+    Shaders\Core\ShaderUniforms.cpp ^
     Shaders\Core\ShaderError.cpp ^
     Texture.cpp ^
+    TextureCache.cpp ^
+    TextureAtlas.cpp ^
+    Debugger.cpp ^
     EngineCondition.cpp ^
     FrameCapture.cpp ^
     ProjectSettings\ProjectSettings.cpp ^
@@ -10,7 +10,7 @@ REM Set include paths
 set INCLUDES=-I.
 
 REM Set source files
-set SOURCES=AStarDemo.cpp NavMesh.cpp NavMeshManager.cpp AIEntity.cpp TimeManager.cpp Vector3.cpp GameObject.cpp Scene.cpp Camera.cpp Model.cpp MonoBehaviourLike.cpp
+set SOURCES=AStarDemo.cpp NavMesh.cpp NavMeshManager.cpp EventBus.cpp AIEntity.cpp TimeManager.cpp Vector3.cpp GameObject.cpp Scene.cpp Coroutine.cpp TimerWheel.cpp FrustumCuller.cpp LodGroup.cpp SceneSnapshot.cpp WorldPartition.cpp SceneSerializer.cpp BinaryScene.cpp JobSystem.cpp SceneLoadOperation.cpp Camera.cpp Model.cpp ObjLoader.cpp MeshCache.cpp MeshOptimizer.cpp MeshSimplifier.cpp AssetManager.cpp AssetStreamer.cpp Texture.cpp TextureCache.cpp TextureAtlas.cpp Debugger.cpp MappedFile.cpp MonoBehaviourLike.cpp
 
 REM Set output file
 set OUTPUT=bin\windows\AStarDemo.exe
@@ -10,7 +10,7 @@ CFLAGS="-std=c++11 -Wall -Wextra -g"
 INCLUDES="-I. -IThirdParty/OpenGL/include"
 
 # Set source files
-SOURCES="NavMesh.cpp NavMeshManager.cpp AIEntity.cpp TimeManager.cpp Vector3.cpp GameObject.cpp Scene.cpp Camera.cpp Model.cpp MonoBehaviourLike.cpp"
+SOURCES="NavMesh.cpp NavMeshManager.cpp EventBus.cpp AIEntity.cpp TimeManager.cpp Vector3.cpp GameObject.cpp Scene.cpp Coroutine.cpp TimerWheel.cpp FrustumCuller.cpp LodGroup.cpp SceneSnapshot.cpp WorldPartition.cpp SceneSerializer.cpp BinaryScene.cpp JobSystem.cpp SceneLoadOperation.cpp Camera.cpp Model.cpp ObjLoader.cpp MeshCache.cpp MeshOptimizer.cpp MeshSimplifier.cpp AssetManager.cpp AssetStreamer.cpp Texture.cpp TextureCache.cpp TextureAtlas.cpp Debugger.cpp MappedFile.cpp MonoBehaviourLike.cpp"
 
 # Set output file
 OUTPUT="bin/linux/AStarDemo"
@@ -19,7 +19,7 @@ OUTPUT="bin/linux/AStarDemo"
 mkdir -p bin/linux
 
 # Compile
-g++ $CFLAGS $INCLUDES $SOURCES -o $OUTPUT -DGL_GLEXT_PROTOTYPES -lGL -lGLU -lglut
+g++ $CFLAGS $INCLUDES $SOURCES -o $OUTPUT -DGL_GLEXT_PROTOTYPES -lGL -lGLU -lglut -pthread
 
 echo "Build complete."
 
@@ -12,6 +12,14 @@ g++ -std=c++11 -o bin\windows\Editor_extern_display.exe ^
     Matrix4x4.cpp ^
     Camera.cpp ^
     Model.cpp ^
+    ObjLoader.cpp ^
+    MeshCache.cpp ^
+    MeshOptimizer.cpp ^
+    MeshSimplifier.cpp ^
+    AssetManager.cpp ^
+    AssetStreamer.cpp ^
+    JobSystem.cpp ^
+    MappedFile.cpp ^
     MonoBehaviourLike.cpp ^
     TimeManager.cpp ^
     Raycast.cpp ^
@@ -19,12 +27,19 @@ g++ -std=c++11 -o bin\windows\Editor_extern_display.exe ^
     CollisionSystem.cpp ^
     PhysicsSystem.cpp ^
     Scene.cpp ^
+    FrustumCuller.cpp ^
+    LodGroup.cpp ^
     PointLight.cpp ^
     CameraManager.cpp ^
     Shaders\Core\ShaderProgram.cpp ^
+    Shaders\Core\ShaderUniforms.cpp ^
     Shaders\Core\Shader.cpp ^
+    Shaders\Core\ShaderPreprocessor.cpp ^
+    Shaders\Core\ShaderSourceCache.cpp ^
     Shaders\Core\ShaderError.cpp ^
     Texture.cpp ^
+    TextureCache.cpp ^
+    TextureAtlas.cpp ^
     EngineCondition.cpp ^
     ProjectSettings\ProjectSettings.cpp ^
     ProjectSettings\ProjectManager.cpp ^
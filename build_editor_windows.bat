@@ -7,21 +7,41 @@ echo Building editor...
 g++ -o build\editor.exe ^
     Editor\EditorMain.cpp ^
     Scene.cpp ^
+    Coroutine.cpp ^
+    TimerWheel.cpp ^
+    FrustumCuller.cpp ^
+    LodGroup.cpp ^
     GameObject.cpp ^
     Vector3.cpp ^
     Matrix4x4.cpp ^
     Camera.cpp ^
     CameraManager.cpp ^
     Model.cpp ^
+    ObjLoader.cpp ^
+    MeshCache.cpp ^
+    MeshOptimizer.cpp ^
+    MeshSimplifier.cpp ^
+    AssetManager.cpp ^
+    AssetStreamer.cpp ^
+    JobSystem.cpp ^
+    MappedFile.cpp ^
     Texture.cpp ^
+    TextureCache.cpp ^
+    TextureAtlas.cpp ^
     PointLight.cpp ^
     Debugger.cpp ^
     FrameCapture.cpp ^
     FrameCapture_png.cpp ^
     Graphics\Core\DirectXGraphicsAPI.cpp ^
     Graphics\Core\GraphicsAPIFactory.cpp ^
+    Graphics\Core\NullGraphicsAPI.cpp ^
+    Graphics\Core\RecordingGraphicsAPI.cpp ^
+    Graphics\Core\GraphicsTrace.cpp ^
     Shaders\Core\ShaderProgram.cpp ^
+    Shaders\Core\ShaderUniforms.cpp ^
     Shaders\Core\Shader.cpp ^
+    Shaders\Core\ShaderPreprocessor.cpp ^
+    Shaders\Core\ShaderSourceCache.cpp ^
     Shaders\Core\ShaderError.cpp ^
     -std=c++11 ^
     -I. ^
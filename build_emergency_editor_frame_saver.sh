@@ -20,6 +20,16 @@ g++ -std=c++11 -o bin/linux/EmergencyEditor_frame_saver \
     Matrix4x4.cpp \
     Camera.cpp \
     Model.cpp \
+    ObjLoader.cpp \
+    MeshCache.cpp \
+    MeshOptimizer.cpp \
+    MeshSimplifier.cpp \
+    AssetManager.cpp \
+    AssetHotReload.cpp \
+    FileWatcher.cpp \
+    AssetStreamer.cpp \
+    JobSystem.cpp \
+    MappedFile.cpp \
     MonoBehaviourLike.cpp \
     TimeManager.cpp \
     Raycast.cpp \
@@ -27,13 +37,22 @@ g++ -std=c++11 -o bin/linux/EmergencyEditor_frame_saver \
     CollisionSystem.cpp \
     PhysicsSystem.cpp \
     Scene.cpp \
+    Coroutine.cpp \
+    TimerWheel.cpp \
+    FrustumCuller.cpp \
+    LodGroup.cpp \
     PointLight.cpp \
     CameraManager.cpp \
     Shaders/Core/ShaderProgram.cpp \
+    Shaders/Core/ShaderUniforms.cpp \
     Shaders/Core/Shader.cpp \
+    Shaders/Core/ShaderPreprocessor.cpp \
+    Shaders/Core/ShaderSourceCache.cpp \
     Shaders/Core/ShaderError.cpp \
     Editor/TextField.cpp \
     Texture.cpp \
+    TextureCache.cpp \
+    TextureAtlas.cpp \
     EngineCondition.cpp \
     FrameCapture_png.cpp \
     ProjectSettings/ProjectSettings.cpp \
@@ -42,7 +61,11 @@ g++ -std=c++11 -o bin/linux/EmergencyEditor_frame_saver \
     Debugger.cpp \
     RedundancyDetector.cpp \
     Graphics/Core/GraphicsAPIFactory.cpp \
+    Graphics/Core/NullGraphicsAPI.cpp \
+    Graphics/Core/RecordingGraphicsAPI.cpp \
+    Graphics/Core/GraphicsTrace.cpp \
     Graphics/Core/OpenGLGraphicsAPI.cpp \
+    Graphics/Core/GLStateCache.cpp \
     ThirdParty/stb/stb_image_write_impl.cpp \
     -I. \
     -IThirdParty/OpenGL/include \
@@ -22,6 +22,9 @@ g++ %CFLAGS% %INCLUDES% -o bin\windows\EmergencyEditor_red_cube.exe ^
     TimeManager.cpp ^
     Graphics\Core\DirectXGraphicsAPI.cpp ^
     Graphics\Core\GraphicsAPIFactory.cpp ^
+    Graphics\Core\NullGraphicsAPI.cpp ^
+    Graphics\Core\RecordingGraphicsAPI.cpp ^
+    Graphics\Core\GraphicsTrace.cpp ^
     -DPLATFORM_WINDOWS -DUSE_DIRECTX ^
     -L./ThirdParty/DirectX/lib -ld3d11 -ldxgi -ld3dcompiler
 
@@ -38,7 +41,11 @@ if %ERRORLEVEL% NEQ 0 (
         Matrix4x4.cpp ^
         TimeManager.cpp ^
         Graphics\Core\OpenGLGraphicsAPI.cpp ^
+        Graphics\Core\GLStateCache.cpp ^
         Graphics\Core\GraphicsAPIFactory.cpp ^
+        Graphics\Core\NullGraphicsAPI.cpp ^
+        Graphics\Core\RecordingGraphicsAPI.cpp ^
+        Graphics\Core\GraphicsTrace.cpp ^
         -DPLATFORM_WINDOWS ^
         -lopengl32 -lglu32
     
@@ -11,7 +11,11 @@ g++ -std=c++11 -o bin/linux/EmergencyEditor_red_cube \
     Matrix4x4.cpp \
     TimeManager.cpp \
     Graphics/Core/OpenGLGraphicsAPI.cpp \
+    Graphics/Core/GLStateCache.cpp \
     Graphics/Core/GraphicsAPIFactory.cpp \
+    Graphics/Core/NullGraphicsAPI.cpp \
+    Graphics/Core/RecordingGraphicsAPI.cpp \
+    Graphics/Core/GraphicsTrace.cpp \
     -I. \
     -IThirdParty/OpenGL/include \
     -DGL_GLEXT_PROTOTYPES \
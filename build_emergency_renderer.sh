@@ -17,6 +17,16 @@ g++ -std=c++11 -o bin/linux/Editor_emergency \
     Matrix4x4.cpp \
     Camera.cpp \
     Model.cpp \
+    ObjLoader.cpp \
+    MeshCache.cpp \
+    MeshOptimizer.cpp \
+    MeshSimplifier.cpp \
+    AssetManager.cpp \
+    AssetHotReload.cpp \
+    FileWatcher.cpp \
+    AssetStreamer.cpp \
+    JobSystem.cpp \
+    MappedFile.cpp \
     MonoBehaviourLike.cpp \
     TimeManager.cpp \
     Raycast.cpp \
@@ -24,13 +34,22 @@ g++ -std=c++11 -o bin/linux/Editor_emergency \
     CollisionSystem.cpp \
     PhysicsSystem.cpp \
     Scene.cpp \
+    Coroutine.cpp \
+    TimerWheel.cpp \
+    FrustumCuller.cpp \
+    LodGroup.cpp \
     PointLight.cpp \
     CameraManager.cpp \
     Shaders/Core/ShaderProgram.cpp \
+    Shaders/Core/ShaderUniforms.cpp \
     Shaders/Core/Shader.cpp \
+    Shaders/Core/ShaderPreprocessor.cpp \
+    Shaders/Core/ShaderSourceCache.cpp \
     Shaders/Core/ShaderError.cpp \
     Editor/TextField.cpp \
     Texture.cpp \
+    TextureCache.cpp \
+    TextureAtlas.cpp \
     EngineCondition.cpp \
     FrameCapture.cpp \
     ProjectSettings/ProjectSettings.cpp \
@@ -18,6 +18,16 @@ g++ -std=c++11 -o bin/linux/Editor_emergency_png \
     Matrix4x4.cpp \
     Camera.cpp \
     Model.cpp \
+    ObjLoader.cpp \
+    MeshCache.cpp \
+    MeshOptimizer.cpp \
+    MeshSimplifier.cpp \
+    AssetManager.cpp \
+    AssetHotReload.cpp \
+    FileWatcher.cpp \
+    AssetStreamer.cpp \
+    JobSystem.cpp \
+    MappedFile.cpp \
     MonoBehaviourLike.cpp \
     TimeManager.cpp \
     Raycast.cpp \
@@ -25,13 +35,25 @@ g++ -std=c++11 -o bin/linux/Editor_emergency_png \
     CollisionSystem.cpp \
     PhysicsSystem.cpp \
     Scene.cpp \
+    Coroutine.cpp \
+    TimerWheel.cpp \
+    FrustumCuller.cpp \
+    LodGroup.cpp \
+    SceneJournal.cpp \
+    SceneSerializer.cpp \
+    BinaryScene.cpp \
     PointLight.cpp \
     CameraManager.cpp \
     Shaders/Core/ShaderProgram.cpp \
+    Shaders/Core/ShaderUniforms.cpp \
     Shaders/Core/Shader.cpp \
+    Shaders/Core/ShaderPreprocessor.cpp \
+    Shaders/Core/ShaderSourceCache.cpp \
     Shaders/Core/ShaderError.cpp \
     Editor/TextField.cpp \
     Texture.cpp \
+    TextureCache.cpp \
+    TextureAtlas.cpp \
     EngineCondition.cpp \
     ProjectSettings/ProjectSettings.cpp \
     ProjectSettings/ProjectManager.cpp \
@@ -11,8 +11,13 @@ g++ -std=c++11 -o bin/linux/EmergencyEditor_standalone \
     Matrix4x4.cpp \
     TimeManager.cpp \
     Graphics/Core/OpenGLGraphicsAPI.cpp \
+    Graphics/Core/GLStateCache.cpp \
     Graphics/Core/GraphicsAPIFactory.cpp \
+    Graphics/Core/NullGraphicsAPI.cpp \
+    Graphics/Core/RecordingGraphicsAPI.cpp \
+    Graphics/Core/GraphicsTrace.cpp \
     Shaders/Core/ShaderProgram.cpp \
+    Shaders/Core/ShaderUniforms.cpp \
     -I. \
     -IThirdParty/OpenGL/include \
     -DGL_GLEXT_PROTOTYPES \
@@ -19,6 +19,16 @@ cl.exe /EHsc /std:c++14 /Fe:bin\windows\EnhancedEmergencyEditor.exe ^
     Matrix4x4.cpp ^
     Camera.cpp ^
     Model.cpp ^
+    ObjLoader.cpp ^
+    MeshCache.cpp ^
+    MeshOptimizer.cpp ^
+    MeshSimplifier.cpp ^
+    AssetManager.cpp ^
+    AssetHotReload.cpp ^
+    FileWatcher.cpp ^
+    AssetStreamer.cpp ^
+    JobSystem.cpp ^
+    MappedFile.cpp ^
     MonoBehaviourLike.cpp ^
     TimeManager.cpp ^
     Raycast.cpp ^
@@ -26,13 +36,22 @@ cl.exe /EHsc /std:c++14 /Fe:bin\windows\EnhancedEmergencyEditor.exe ^
     CollisionSystem.cpp ^
     PhysicsSystem.cpp ^
     Scene.cpp ^
+    Coroutine.cpp ^
+    TimerWheel.cpp ^
+    FrustumCuller.cpp ^
+    LodGroup.cpp ^
     PointLight.cpp ^
     CameraManager.cpp ^
     Shaders\Core\ShaderProgram.cpp ^
+    Shaders\Core\ShaderUniforms.cpp ^
     Shaders\Core\Shader.cpp ^
+    Shaders\Core\ShaderPreprocessor.cpp ^
+    Shaders\Core\ShaderSourceCache.cpp ^
     Shaders\Core\ShaderError.cpp ^
     Editor\TextField.cpp ^
     Texture.cpp ^
+    TextureCache.cpp ^
+    TextureAtlas.cpp ^
     EngineCondition.cpp ^
     FrameCapture_png.cpp ^
     ProjectSettings\ProjectSettings.cpp ^
@@ -41,6 +60,9 @@ cl.exe /EHsc /std:c++14 /Fe:bin\windows\EnhancedEmergencyEditor.exe ^
     Debugger.cpp ^
     RedundancyDetector.cpp ^
     Graphics\Core\GraphicsAPIFactory.cpp ^
+    Graphics\Core\NullGraphicsAPI.cpp ^
+    Graphics\Core\RecordingGraphicsAPI.cpp ^
+    Graphics\Core\GraphicsTrace.cpp ^
     Graphics\Core\DirectXGraphicsAPI.cpp ^
     /I. ^
     /IThirdParty\DirectX\include ^
@@ -21,6 +21,16 @@ g++ -std=c++11 -o bin\windows\FrameSavingEditor.exe ^
     Matrix4x4.cpp ^
     Camera.cpp ^
     Model.cpp ^
+    ObjLoader.cpp ^
+    MeshCache.cpp ^
+    MeshOptimizer.cpp ^
+    MeshSimplifier.cpp ^
+    AssetManager.cpp ^
+    AssetHotReload.cpp ^
+    FileWatcher.cpp ^
+    AssetStreamer.cpp ^
+    JobSystem.cpp ^
+    MappedFile.cpp ^
     MonoBehaviourLike.cpp ^
     TimeManager.cpp ^
     Raycast.cpp ^
@@ -28,13 +38,25 @@ g++ -std=c++11 -o bin\windows\FrameSavingEditor.exe ^
     CollisionSystem.cpp ^
     PhysicsSystem.cpp ^
     Scene.cpp ^
+    Coroutine.cpp ^
+    TimerWheel.cpp ^
+    FrustumCuller.cpp ^
+    LodGroup.cpp ^
+    SceneJournal.cpp ^
+    SceneSerializer.cpp ^
+    BinaryScene.cpp ^
     PointLight.cpp ^
     CameraManager.cpp ^
     Shaders\Core\ShaderProgram.cpp ^
+    Shaders\Core\ShaderUniforms.cpp ^
     Shaders\Core\Shader.cpp ^
+    Shaders\Core\ShaderPreprocessor.cpp ^
+    Shaders\Core\ShaderSourceCache.cpp ^
     Shaders\Core\ShaderError.cpp ^
     Editor\TextField.cpp ^
     Texture.cpp ^
+    TextureCache.cpp ^
+    TextureAtlas.cpp ^
     EngineCondition.cpp ^
     FrameCapture_png.cpp ^
     ProjectSettings\ProjectSettings.cpp ^
@@ -43,7 +65,11 @@ g++ -std=c++11 -o bin\windows\FrameSavingEditor.exe ^
     Debugger.cpp ^
     RedundancyDetector.cpp ^
     Graphics\Core\GraphicsAPIFactory.cpp ^
+    Graphics\Core\NullGraphicsAPI.cpp ^
+    Graphics\Core\RecordingGraphicsAPI.cpp ^
+    Graphics\Core\GraphicsTrace.cpp ^
     Graphics\Core\OpenGLGraphicsAPI.cpp ^
+    Graphics\Core\GLStateCache.cpp ^
     -I. ^
     -IThirdParty\OpenGL\include ^
     -DGL_GLEXT_PROTOTYPES ^
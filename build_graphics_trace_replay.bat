@@ -0,0 +1,29 @@
+@echo off
+REM build_graphics_trace_replay.bat
+
+echo Building Graphics Trace Replay...
+
+REM Set compiler options
+set CFLAGS=-std=c++14 -Wall -Wextra -O2
+
+REM Set include paths
+set INCLUDES=-I.
+
+REM Set source files
+set SOURCES=GraphicsTraceReplay.cpp Graphics\Core\GraphicsTrace.cpp Graphics\Core\NullGraphicsAPI.cpp Graphics\Core\OpenGLGraphicsAPI.cpp Graphics\Core\GLStateCache.cpp
+
+REM Set output file
+set OUTPUT=bin\windows\GraphicsTraceReplay.exe
+
+REM Create output directory if it doesn't exist
+if not exist bin\windows mkdir bin\windows
+
+REM Compile
+g++ %CFLAGS% %INCLUDES% %SOURCES% -o %OUTPUT% -DPLATFORM_WINDOWS -lglew32 -lopengl32 -lglu32 -lgdi32
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed.
+    exit /b 1
+)
+
+echo Build successful. Run with: %OUTPUT% trace [--backend null^|opengl] [--repeat N]
@@ -0,0 +1,28 @@
+#!/bin/bash
+# build_graphics_trace_replay.sh
+
+echo "Building Graphics Trace Replay..."
+
+# Set compiler options
+CFLAGS="-std=c++14 -Wall -Wextra -O2"
+
+# Set include paths
+INCLUDES="-I."
+
+# Set source files
+SOURCES="GraphicsTraceReplay.cpp Graphics/Core/GraphicsTrace.cpp Graphics/Core/NullGraphicsAPI.cpp Graphics/Core/OpenGLGraphicsAPI.cpp Graphics/Core/GLStateCache.cpp"
+
+# Set output file
+OUTPUT="bin/linux/GraphicsTraceReplay"
+
+# Create output directory if it doesn't exist
+mkdir -p bin/linux
+
+# Compile
+g++ $CFLAGS $INCLUDES $SOURCES -o $OUTPUT -DPLATFORM_LINUX -lGLEW -lGL -lGLU -lX11
+
+if [ $? -eq 0 ]; then
+    echo "Build successful. Run with: $OUTPUT <trace> [--backend null|opengl] [--repeat N]"
+else
+    echo "Build failed."
+fi
@@ -22,19 +22,41 @@ g++ %CFLAGS% %INCLUDES% -o bin\windows\main_editor_window.exe ^
     TimeManager.cpp ^
     Graphics\Core\DirectXGraphicsAPI.cpp ^
     Graphics\Core\GraphicsAPIFactory.cpp ^
+    Graphics\Core\NullGraphicsAPI.cpp ^
+    Graphics\Core\RecordingGraphicsAPI.cpp ^
+    Graphics\Core\GraphicsTrace.cpp ^
     Editor\Editor.cpp ^
     Editor\HierarchyPanel.cpp ^
     Editor\InspectorPanel.cpp ^
     Editor\ProjectPanel.cpp ^
     Editor\SceneViewPanel.cpp ^
     Scene.cpp ^
+    Coroutine.cpp ^
+    TimerWheel.cpp ^
+    FrustumCuller.cpp ^
+    LodGroup.cpp ^
     GameObject.cpp ^
     Camera.cpp ^
     PhysicsSystem.cpp ^
     CameraManager.cpp ^
     Model.cpp ^
+    ObjLoader.cpp ^
+    MeshCache.cpp ^
+    MeshOptimizer.cpp ^
+    MeshSimplifier.cpp ^
+    AssetManager.cpp ^
+    AssetHotReload.cpp ^
+    FileWatcher.cpp ^
+    AssetStreamer.cpp ^
+    JobSystem.cpp ^
+    Texture.cpp ^
+    TextureCache.cpp ^
+    TextureAtlas.cpp ^
+    Debugger.cpp ^
+    MappedFile.cpp ^
     EngineCondition.cpp ^
     Shaders\Core\ShaderProgram.cpp ^
+    Shaders\Core\ShaderUniforms.cpp ^
     -DPLATFORM_WINDOWS -DUSE_DIRECTX ^
     -L./ThirdParty/DirectX/lib -ld3d11 -ldxgi -ld3dcompiler
 
@@ -51,20 +73,43 @@ if %ERRORLEVEL% NEQ 0 (
         Matrix4x4.cpp ^
         TimeManager.cpp ^
         Graphics\Core\OpenGLGraphicsAPI.cpp ^
+        Graphics\Core\GLStateCache.cpp ^
         Graphics\Core\GraphicsAPIFactory.cpp ^
+        Graphics\Core\NullGraphicsAPI.cpp ^
+        Graphics\Core\RecordingGraphicsAPI.cpp ^
+        Graphics\Core\GraphicsTrace.cpp ^
         Editor\Editor.cpp ^
         Editor\HierarchyPanel.cpp ^
         Editor\InspectorPanel.cpp ^
         Editor\ProjectPanel.cpp ^
         Editor\SceneViewPanel.cpp ^
         Scene.cpp ^
+        Coroutine.cpp ^
+        TimerWheel.cpp ^
+        FrustumCuller.cpp ^
+        LodGroup.cpp ^
         GameObject.cpp ^
         Camera.cpp ^
         PhysicsSystem.cpp ^
         CameraManager.cpp ^
         Model.cpp ^
+        ObjLoader.cpp ^
+        MeshCache.cpp ^
+        MeshOptimizer.cpp ^
+        MeshSimplifier.cpp ^
+        AssetManager.cpp ^
+        AssetHotReload.cpp ^
+        FileWatcher.cpp ^
+        AssetStreamer.cpp ^
+        JobSystem.cpp ^
+        Texture.cpp ^
+        TextureCache.cpp ^
+        TextureAtlas.cpp ^
+        Debugger.cpp ^
+        MappedFile.cpp ^
         EngineCondition.cpp ^
         Shaders\Core\ShaderProgram.cpp ^
+        Shaders\Core\ShaderUniforms.cpp ^
         -DPLATFORM_WINDOWS ^
         -lopengl32 -lglu32 -lglew32
     
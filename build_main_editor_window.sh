@@ -11,20 +11,46 @@ g++ -std=c++11 -o bin/linux/main_editor_window \
     Matrix4x4.cpp \
     TimeManager.cpp \
     Graphics/Core/OpenGLGraphicsAPI.cpp \
+    Graphics/Core/GLStateCache.cpp \
     Graphics/Core/GraphicsAPIFactory.cpp \
+    Graphics/Core/NullGraphicsAPI.cpp \
+    Graphics/Core/RecordingGraphicsAPI.cpp \
+    Graphics/Core/GraphicsTrace.cpp \
     Editor/Editor.cpp \
     Editor/HierarchyPanel.cpp \
     Editor/InspectorPanel.cpp \
     Editor/ProjectPanel.cpp \
     Editor/SceneViewPanel.cpp \
     Scene.cpp \
+    Coroutine.cpp \
+    TimerWheel.cpp \
+    FrustumCuller.cpp \
+    LodGroup.cpp \
+    SceneJournal.cpp \
+    SceneSerializer.cpp \
+    BinaryScene.cpp \
     GameObject.cpp \
     Camera.cpp \
     PhysicsSystem.cpp \
     CameraManager.cpp \
     Model.cpp \
+    ObjLoader.cpp \
+    MeshCache.cpp \
+    MeshOptimizer.cpp \
+    MeshSimplifier.cpp \
+    AssetManager.cpp \
+    AssetHotReload.cpp \
+    FileWatcher.cpp \
+    AssetStreamer.cpp \
+    JobSystem.cpp \
+    Texture.cpp \
+    TextureCache.cpp \
+    TextureAtlas.cpp \
+    Debugger.cpp \
+    MappedFile.cpp \
     EngineCondition.cpp \
     Shaders/Core/ShaderProgram.cpp \
+    Shaders/Core/ShaderUniforms.cpp \
     -I. \
     -IThirdParty/OpenGL/include \
     -DGL_GLEXT_PROTOTYPES \
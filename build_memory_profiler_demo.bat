@@ -17,7 +17,7 @@ REM Compile the demo
 g++ %CFLAGS% %INCLUDES% -c MemoryProfilerDemo.cpp -o bin\windows\MemoryProfilerDemo.o
 
 REM Link the demo with the engine components
-g++ bin\windows\MemoryProfilerDemo.o bin\windows\Profiler.o bin\windows\Vector3.o bin\windows\Matrix4x4.o bin\windows\Model.o bin\windows\GameObject.o bin\windows\Camera.o bin\windows\Scene.o bin\windows\Raycast.o bin\windows\PhysicsSystem.o bin\windows\CollisionSystem.o bin\windows\TimeManager.o bin\windows\NavMesh.o bin\windows\NavMeshManager.o bin\windows\AIEntity.o bin\windows\ProjectSettings.o bin\windows\RigidBody.o -o bin\windows\MemoryProfilerDemo.exe
+g++ bin\windows\MemoryProfilerDemo.o bin\windows\Profiler.o bin\windows\Vector3.o bin\windows\Matrix4x4.o bin\windows\Model.o bin\windows\GameObject.o bin\windows\Camera.o bin\windows\Scene.o bin\windows\Coroutine.o bin\windows\TimerWheel.o bin\windows\Raycast.o bin\windows\PhysicsSystem.o bin\windows\CollisionSystem.o bin\windows\TimeManager.o bin\windows\NavMesh.o bin\windows\NavMeshManager.o bin\windows\AIEntity.o bin\windows\ProjectSettings.o bin\windows\RigidBody.o -o bin\windows\MemoryProfilerDemo.exe
 
 if %ERRORLEVEL% == 0 (
     echo Build successful. Run with: bin\windows\MemoryProfilerDemo.exe
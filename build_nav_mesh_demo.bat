@@ -10,7 +10,7 @@ REM Set include paths
 set INCLUDES=-I.
 
 REM Set source files
-set SOURCES=NavMeshDemo.cpp NavMesh.cpp NavMeshManager.cpp AIEntity.cpp Raycast.cpp
+set SOURCES=NavMeshDemo.cpp NavMesh.cpp NavMeshManager.cpp EventBus.cpp AIEntity.cpp Raycast.cpp
 
 REM Set output file
 set OUTPUT=bin\windows\NavMeshDemo.exe
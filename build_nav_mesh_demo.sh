@@ -10,7 +10,7 @@ CFLAGS="-std=c++11 -Wall -Wextra -g"
 INCLUDES="-I."
 
 # Set source files
-SOURCES="NavMeshDemo.cpp NavMesh.cpp NavMeshManager.cpp AIEntity.cpp Raycast.cpp"
+SOURCES="NavMeshDemo.cpp NavMesh.cpp NavMeshManager.cpp EventBus.cpp AIEntity.cpp Raycast.cpp"
 
 # Set output file
 OUTPUT="bin/linux/NavMeshDemo"
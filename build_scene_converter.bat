@@ -0,0 +1,29 @@
+@echo off
+REM build_scene_converter.bat
+
+echo Building Scene Converter...
+
+REM Set compiler options
+set CFLAGS=-std=c++14 -Wall -Wextra -O2
+
+REM Set include paths
+set INCLUDES=-I.
+
+REM Set source files
+set SOURCES=SceneConverter.cpp BinaryScene.cpp MappedFile.cpp
+
+REM Set output file
+set OUTPUT=bin\windows\SceneConverter.exe
+
+REM Create output directory if it doesn't exist
+if not exist bin\windows mkdir bin\windows
+
+REM Compile
+g++ %CFLAGS% %INCLUDES% %SOURCES% -o %OUTPUT%
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed.
+    exit /b 1
+)
+
+echo Build successful. Run with: %OUTPUT% input output
@@ -0,0 +1,28 @@
+#!/bin/bash
+# build_scene_converter.sh
+
+echo "Building Scene Converter..."
+
+# Set compiler options
+CFLAGS="-std=c++14 -Wall -Wextra -O2"
+
+# Set include paths
+INCLUDES="-I."
+
+# Set source files
+SOURCES="SceneConverter.cpp BinaryScene.cpp MappedFile.cpp"
+
+# Set output file
+OUTPUT="bin/linux/SceneConverter"
+
+# Create output directory if it doesn't exist
+mkdir -p bin/linux
+
+# Compile
+g++ $CFLAGS $INCLUDES $SOURCES -o $OUTPUT
+
+if [ $? -eq 0 ]; then
+    echo "Build successful. Run with: $OUTPUT <input> <output>"
+else
+    echo "Build failed."
+fi
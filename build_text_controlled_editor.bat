@@ -6,7 +6,11 @@ REM Compile the text controlled editor
 g++ -std=c++11 -o bin/text_controlled_editor.exe ^
     Editor/TextControlledEditor.cpp ^
     Graphics/Core/GraphicsAPIFactory.cpp ^
+    Graphics/Core/NullGraphicsAPI.cpp ^
+    Graphics/Core/RecordingGraphicsAPI.cpp ^
+    Graphics/Core/GraphicsTrace.cpp ^
     Graphics/Core/OpenGLGraphicsAPI.cpp ^
+    Graphics/Core/GLStateCache.cpp ^
     Graphics/Core/DirectXGraphicsAPI.cpp ^
     TimeManager.cpp ^
     Vector3.cpp ^
@@ -18,15 +22,35 @@ g++ -std=c++11 -o bin/text_controlled_editor.exe ^
     Editor/ProjectPanel.cpp ^
     Editor/SceneViewPanel.cpp ^
     Scene.cpp ^
+    Coroutine.cpp ^
+    TimerWheel.cpp ^
+    FrustumCuller.cpp ^
+    LodGroup.cpp ^
     Camera.cpp ^
     CameraManager.cpp ^
     GameObject.cpp ^
     Model.cpp ^
+    ObjLoader.cpp ^
+    MeshCache.cpp ^
+    MeshOptimizer.cpp ^
+    MeshSimplifier.cpp ^
+    AssetManager.cpp ^
+    AssetHotReload.cpp ^
+    FileWatcher.cpp ^
+    AssetStreamer.cpp ^
+    JobSystem.cpp ^
+    Debugger.cpp ^
+    MappedFile.cpp ^
     Texture.cpp ^
+    TextureCache.cpp ^
+    TextureAtlas.cpp ^
     Matrix4x4.cpp ^
     MonoBehaviourLike.cpp ^
     Shaders/Core/ShaderProgram.cpp ^
+    Shaders/Core/ShaderUniforms.cpp ^
     Shaders/Core/Shader.cpp ^
+    Shaders/Core/ShaderPreprocessor.cpp ^
+    Shaders/Core/ShaderSourceCache.cpp ^
     Shaders/Core/ShaderError.cpp ^
     -I. ^
     -DGL_GLEXT_PROTOTYPES ^
@@ -7,7 +7,11 @@ mkdir -p bin
 g++ -std=c++11 -o bin/text_controlled_editor \
     Editor/TextControlledEditor.cpp \
     Graphics/Core/GraphicsAPIFactory.cpp \
+    Graphics/Core/NullGraphicsAPI.cpp \
+    Graphics/Core/RecordingGraphicsAPI.cpp \
+    Graphics/Core/GraphicsTrace.cpp \
     Graphics/Core/OpenGLGraphicsAPI.cpp \
+    Graphics/Core/GLStateCache.cpp \
     TimeManager.cpp \
     Vector3.cpp \
     FrameCapture_png.cpp \
@@ -18,15 +22,35 @@ g++ -std=c++11 -o bin/text_controlled_editor \
     Editor/ProjectPanel.cpp \
     Editor/SceneViewPanel.cpp \
     Scene.cpp \
+    Coroutine.cpp \
+    TimerWheel.cpp \
+    FrustumCuller.cpp \
+    LodGroup.cpp \
     Camera.cpp \
     CameraManager.cpp \
     GameObject.cpp \
     Model.cpp \
+    ObjLoader.cpp \
+    MeshCache.cpp \
+    MeshOptimizer.cpp \
+    MeshSimplifier.cpp \
+    AssetManager.cpp \
+    AssetHotReload.cpp \
+    FileWatcher.cpp \
+    AssetStreamer.cpp \
+    JobSystem.cpp \
+    Debugger.cpp \
+    MappedFile.cpp \
     Texture.cpp \
+    TextureCache.cpp \
+    TextureAtlas.cpp \
     Matrix4x4.cpp \
     MonoBehaviourLike.cpp \
     Shaders/Core/ShaderProgram.cpp \
+    Shaders/Core/ShaderUniforms.cpp \
     Shaders/Core/Shader.cpp \
+    Shaders/Core/ShaderPreprocessor.cpp \
+    Shaders/Core/ShaderSourceCache.cpp \
     Shaders/Core/ShaderError.cpp \
     -I. \
     -DGL_GLEXT_PROTOTYPES \
@@ -16,11 +16,27 @@ g++ $CXXFLAGS \
     Animation/AnimationComponent.cpp \
     Animation/AnimationLoader.cpp \
     Model.cpp \
+    ObjLoader.cpp \
+    MeshCache.cpp \
+    MeshOptimizer.cpp \
+    MeshSimplifier.cpp \
+    AssetManager.cpp \
+    AssetStreamer.cpp \
+    JobSystem.cpp \
+    Texture.cpp \
+    TextureCache.cpp \
+    TextureAtlas.cpp \
+    Debugger.cpp \
+    MappedFile.cpp \
     Vector3.cpp \
     CollisionSystem.cpp \
     RigidBody.cpp \
     GameObject.cpp \
     Scene.cpp \
+    Coroutine.cpp \
+    TimerWheel.cpp \
+    FrustumCuller.cpp \
+    LodGroup.cpp \
     PhysicsSystem.cpp \
     -o bin/linux/AnimationCollisionTest
 
@@ -0,0 +1,181 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#include "../AssetManager.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the reference-counted asset manager
+// Build with build_asset_manager_test.sh
+
+// Asset type that records how often it is loaded and unloaded
+struct TestAsset {
+    std::string path;
+    std::string settings;
+};
+
+static std::atomic<int> loads(0);
+static std::atomic<int> unloads(0);
+
+template <>
+struct AssetLoader<TestAsset> {
+    static TestAsset* Load(const std::string& path, const std::string& settings) {
+        loads++;
+        if (AssetManager::GetSetting(settings, "delay") == "1") {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+        if (path.find("missing") != std::string::npos) {
+            return nullptr;
+        }
+        if (path.find("throws") != std::string::npos) {
+            throw std::runtime_error("corrupt file");
+        }
+        TestAsset* asset = new TestAsset();
+        asset->path = path;
+        asset->settings = settings;
+        return asset;
+    }
+
+    static void Unload(TestAsset* asset) {
+        unloads++;
+        delete asset;
+    }
+};
+
+int main() {
+    std::cout << "=== Asset Manager Tests ===" << std::endl;
+
+    AssetManager& assets = AssetManager::GetInstance();
+
+    // Path normalization
+    Check(AssetManager::NormalizePath("./Textures//wood/../bark.png") == "Textures/bark.png",
+          "Dot components and duplicate slashes are removed");
+    Check(AssetManager::NormalizePath("Textures\\bark.png") == "Textures/bark.png", "Backslashes become slashes");
+    Check(AssetManager::NormalizePath("../shared/a.png") == "../shared/a.png" &&
+          AssetManager::NormalizePath("/../a.png") == "/a.png", "Leading .. is kept for relative paths only");
+
+    Check(AssetManager::GetSetting("fragment=a.frag;geometry=b.geom", "geometry") == "b.geom" &&
+          AssetManager::GetSetting("fragment=a.frag", "geometry").empty() &&
+          AssetManager::GetSetting("mips=0;mip=1", "mip") == "1", "Import settings are looked up by name");
+
+    // Deduplication and reference counts
+    {
+        loads = 0;
+        unloads = 0;
+        AssetHandle<TestAsset> first = assets.Load<TestAsset>("Models/crate.obj");
+        AssetHandle<TestAsset> second = assets.Load<TestAsset>(".\\Models\\crate.obj");
+        Check(first && first == second && first.Get() == second.Get() && loads == 1,
+              "Equivalent paths share one loaded asset");
+        Check(first.GetPath() == "Models/crate.obj", "Handles report the normalized path");
+        Check(assets.GetRefCount<TestAsset>("Models/crate.obj") == 2, "Each handle holds a reference");
+
+        AssetHandle<TestAsset> other = assets.Load<TestAsset>("Models/crate.obj", "scale=2");
+        Check(other && other != first && loads == 2, "Different import settings load a separate asset");
+
+        {
+            AssetHandle<TestAsset> copy = first;
+            AssetHandle<TestAsset> moved(std::move(copy));
+            Check(!copy && assets.GetRefCount<TestAsset>("Models/crate.obj") == 3,
+                  "Copies add a reference and moves transfer it");
+        }
+        Check(assets.GetRefCount<TestAsset>("Models/crate.obj") == 2, "Destroyed handles release their reference");
+
+        second.Reset();
+        Check(unloads == 0 && first->path == "Models/crate.obj", "The asset stays loaded while a handle remains");
+
+        first = other;
+        Check(unloads == 1 && assets.GetRefCount<TestAsset>("Models/crate.obj") == 0,
+              "The asset is unloaded when its last handle goes away");
+
+        AssetHandle<TestAsset> again = assets.Load<TestAsset>("Models/crate.obj");
+        Check(again && loads == 3, "An unloaded asset is loaded again on the next request");
+    }
+    Check(assets.GetLoadedCount() == 0 && unloads == 3, "Nothing stays loaded once every handle is gone");
+
+    // Concurrent requests for the same asset
+    {
+        loads = 0;
+        const int threadCount = 8;
+        std::vector<AssetHandle<TestAsset>> handles(threadCount);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.push_back(std::thread([&handles, &assets, i]() {
+                handles[i] = assets.Load<TestAsset>("Sounds/step.wav", "delay=1");
+            }));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        bool shared = true;
+        for (int i = 0; i < threadCount; ++i) {
+            shared = shared && handles[i] && handles[i] == handles[0];
+        }
+        Check(shared && loads == 1, "Concurrent requests wait for a single load");
+        Check(assets.GetRefCount<TestAsset>("Sounds/step.wav", "delay=1") == threadCount,
+              "Every waiting request holds a reference");
+
+        // Release from several threads at once
+        threads.clear();
+        unloads = 0;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.push_back(std::thread([&handles, i]() { handles[i].Reset(); }));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        Check(unloads == 1 && assets.GetLoadedCount() == 0, "Concurrent releases unload the asset once");
+    }
+
+    // Failed loads
+    {
+        loads = 0;
+        AssetHandle<TestAsset> missing = assets.Load<TestAsset>("Textures/missing.png");
+        Check(!missing && assets.GetLoadedCount() == 0, "A failed load returns an empty handle");
+
+        missing = assets.Load<TestAsset>("Textures/missing.png");
+        Check(!missing && loads == 2, "Failures are not cached, so the next request tries again");
+
+        AssetHandle<TestAsset> thrown = assets.Load<TestAsset>("Textures/throws.png");
+        Check(!thrown && assets.GetLoadedCount() == 0, "Loader exceptions are reported as failures");
+
+        loads = 0;
+        std::vector<AssetHandle<TestAsset>> handles(4);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 4; ++i) {
+            threads.push_back(std::thread([&handles, &assets, i]() {
+                handles[i] = assets.Load<TestAsset>("Textures/missing.png", "delay=1");
+            }));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        bool allEmpty = true;
+        for (const AssetHandle<TestAsset>& handle : handles) {
+            allEmpty = allEmpty && !handle;
+        }
+        Check(allEmpty && loads >= 1 && assets.GetLoadedCount() == 0,
+              "Requests waiting on a failed load get empty handles");
+    }
+
+    // Many users of the same few assets
+    {
+        loads = 0;
+        std::vector<AssetHandle<TestAsset>> handles;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 100000; ++i) {
+            handles.push_back(assets.Load<TestAsset>("Textures/tile" + std::to_string(i % 16) + ".png"));
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        Check(loads == 16 && assets.GetLoadedCount() == 16, "100000 requests for 16 files load 16 assets");
+        std::cout << "100000 requests: " << std::chrono::duration<double, std::milli>(end - start).count()
+                  << " ms" << std::endl;
+        handles.clear();
+        Check(assets.GetLoadedCount() == 0, "All of them are unloaded with their handles");
+    }
+
+    return TestSummary();
+}
@@ -0,0 +1,17 @@
+@echo off
+echo Building asset manager test program...
+
+REM Build asset manager test
+g++ -std=c++14 -O2 -I.. ^
+    AssetManagerTest.cpp ^
+    ..\AssetManager.cpp ^
+    -o asset_manager_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run asset_manager_test.exe from this folder to test the asset manager.
+pause
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Build asset manager test
+echo "Building asset manager test program..."
+g++ -std=c++14 -O2 -I.. \
+    AssetManagerTest.cpp \
+    ../AssetManager.cpp \
+    -pthread -o asset_manager_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x asset_manager_test
+
+echo "Build complete. Run ./asset_manager_test from this folder to test the asset manager."
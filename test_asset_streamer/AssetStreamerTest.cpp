@@ -0,0 +1,321 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <functional>
+#include "../AssetStreamer.h"
+#include "../JobSystem.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the background asset streamer
+// Build with build_asset_streamer_test.sh
+
+// Asset type that records which thread ran each stage
+struct TestAsset {
+    std::string path;
+    size_t uploadSize = 0;
+    bool uploaded = false;
+};
+
+static std::mutex recordMutex;
+static std::vector<std::string> readOrder;
+static std::vector<std::thread::id> readThreads;
+static std::vector<std::thread::id> decodeThreads;
+static std::vector<std::thread::id> uploadThreads;
+static std::atomic<int> decodes(0);
+static std::atomic<int> unloads(0);
+
+// Reads of "gate" files block until the gate opens, holding up the I/O thread
+static std::atomic<bool> gateOpen(true);
+static std::atomic<bool> gateReading(false);
+
+template <>
+struct AssetLoader<TestAsset> {
+    static TestAsset* Load(const std::string& path, const std::string& settings) {
+        (void)settings;
+        TestAsset* asset = new TestAsset();
+        asset->path = path;
+        asset->uploaded = true;
+        return asset;
+    }
+
+    static void Unload(TestAsset* asset) {
+        unloads++;
+        delete asset;
+    }
+};
+
+template <>
+struct AssetStreamLoader<TestAsset> {
+    static bool Read(const std::string& path, const std::string& settings, std::vector<unsigned char>& bytes) {
+        (void)settings;
+        {
+            std::lock_guard<std::mutex> lock(recordMutex);
+            readOrder.push_back(path);
+            readThreads.push_back(std::this_thread::get_id());
+        }
+        if (path.find("gate") != std::string::npos) {
+            gateReading = true;
+            while (!gateOpen) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            gateReading = false;
+        }
+        if (path.find("missing") != std::string::npos) {
+            return false;
+        }
+        bytes.assign(path.begin(), path.end());
+        return true;
+    }
+
+    static TestAsset* Decode(const std::string& path, const std::string& settings,
+                             const std::vector<unsigned char>& bytes) {
+        {
+            std::lock_guard<std::mutex> lock(recordMutex);
+            decodeThreads.push_back(std::this_thread::get_id());
+        }
+        TestAsset* asset = nullptr;
+        if (path.find("corrupt") == std::string::npos && std::string(bytes.begin(), bytes.end()) == path) {
+            asset = new TestAsset();
+            asset->path = path;
+            std::string size = AssetManager::GetSetting(settings, "size");
+            asset->uploadSize = size.empty() ? 0 : static_cast<size_t>(std::stoul(size));
+        }
+        decodes++;
+        return asset;
+    }
+
+    static size_t GetUploadSize(const TestAsset& asset) {
+        return asset.uploadSize;
+    }
+
+    static bool Upload(TestAsset& asset) {
+        std::lock_guard<std::mutex> lock(recordMutex);
+        uploadThreads.push_back(std::this_thread::get_id());
+        asset.uploaded = true;
+        return true;
+    }
+};
+
+// Poll until a condition holds, for at most two seconds
+static bool WaitFor(const std::function<bool()>& condition) {
+    for (int i = 0; i < 2000; ++i) {
+        if (condition()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return condition();
+}
+
+static void ResetRecords() {
+    std::lock_guard<std::mutex> lock(recordMutex);
+    readOrder.clear();
+    readThreads.clear();
+    decodeThreads.clear();
+    uploadThreads.clear();
+    decodes = 0;
+    unloads = 0;
+}
+
+// Hold up the I/O thread on a gate file so the next requests queue behind it
+static std::shared_ptr<AssetRequest<TestAsset>> CloseGate(const std::string& name) {
+    gateOpen = false;
+    std::shared_ptr<AssetRequest<TestAsset>> gate = AssetStreamer::GetInstance().LoadAsync<TestAsset>(name, 1000.0f);
+    WaitFor([]() { return gateReading.load(); });
+    return gate;
+}
+
+int main() {
+    std::cout << "=== Asset Streamer Tests ===" << std::endl;
+
+    AssetStreamer& streamer = AssetStreamer::GetInstance();
+    AssetManager& assets = AssetManager::GetInstance();
+    std::thread::id mainThread = std::this_thread::get_id();
+
+    // Assets that are already loaded
+    {
+        ResetRecords();
+        AssetHandle<TestAsset> loaded = assets.Load<TestAsset>("Models/crate.obj");
+        std::shared_ptr<AssetRequest<TestAsset>> request = streamer.LoadAsync<TestAsset>("./Models/crate.obj");
+        bool called = false;
+        request->OnComplete([&called](AssetRequest<TestAsset>& done) { called = done.Succeeded(); });
+        Check(request->Succeeded() && called && request->GetHandle() == loaded && readOrder.empty(),
+              "A request for a loaded asset completes at once without reading");
+    }
+
+    // Stages run on their own threads
+    {
+        ResetRecords();
+        std::shared_ptr<AssetRequest<TestAsset>> request = streamer.LoadAsync<TestAsset>("Textures/bark.png");
+        AssetHandle<TestAsset> result;
+        request->OnComplete([&result](AssetRequest<TestAsset>& done) { result = done.GetHandle(); });
+        Check(!request->IsDone(), "Requests are not finished before the streamer updates");
+
+        streamer.Flush();
+        Check(request->Succeeded() && result && result->uploaded && result->path == "Textures/bark.png",
+              "Flush finishes the request and calls its callback");
+        Check(readThreads.size() == 1 && readThreads[0] != mainThread, "Files are read on the I/O thread");
+        Check(decodeThreads.size() == 1 && decodeThreads[0] != mainThread && decodeThreads[0] != readThreads[0],
+              "Decoding runs on a worker thread");
+        Check(uploadThreads.size() == 1 && uploadThreads[0] == mainThread, "Uploads run on the main thread");
+        Check(assets.GetRefCount<TestAsset>("Textures/bark.png") == 2,
+              "Streamed assets are shared through the asset manager");
+    }
+
+    // Priorities
+    {
+        ResetRecords();
+        std::shared_ptr<AssetRequest<TestAsset>> gate = CloseGate("Textures/gate1.png");
+        std::shared_ptr<AssetRequest<TestAsset>> far = streamer.LoadAsync<TestAsset>("Textures/far.png", -100.0f);
+        std::shared_ptr<AssetRequest<TestAsset>> near = streamer.LoadAsync<TestAsset>("Textures/near.png", -1.0f);
+        std::shared_ptr<AssetRequest<TestAsset>> middle = streamer.LoadAsync<TestAsset>("Textures/middle.png", -10.0f);
+        std::shared_ptr<AssetRequest<TestAsset>> moved = streamer.LoadAsync<TestAsset>("Textures/moved.png", -50.0f);
+        Check(far->GetStatus() == AssetRequestBase::Status::QUEUED, "Requests wait in the queue behind a busy reader");
+
+        moved->SetPriority(5.0f);
+        Check(moved->GetPriority() == 5.0f, "Priorities can change while queued");
+
+        gateOpen = true;
+        streamer.Flush();
+        std::vector<std::string> expected = { "Textures/gate1.png", "Textures/moved.png", "Textures/near.png",
+                                              "Textures/middle.png", "Textures/far.png" };
+        Check(readOrder == expected, "Files are read highest priority first");
+        Check(far->Succeeded() && near->Succeeded() && middle->Succeeded() && moved->Succeeded() && gate->Succeeded(),
+              "Every queued request finishes");
+    }
+
+    // Several requests for one asset
+    {
+        ResetRecords();
+        std::shared_ptr<AssetRequest<TestAsset>> gate = CloseGate("Textures/gate2.png");
+        std::shared_ptr<AssetRequest<TestAsset>> first = streamer.LoadAsync<TestAsset>("Sounds/step.wav", -5.0f);
+        std::shared_ptr<AssetRequest<TestAsset>> second = streamer.LoadAsync<TestAsset>("Sounds\\step.wav", 2.0f);
+        Check(streamer.GetPendingCount() == 2, "Requests for the same asset share one load");
+
+        gateOpen = true;
+        streamer.Flush();
+        Check(readOrder.size() == 2 && first->Succeeded() && first->GetHandle() == second->GetHandle(),
+              "The shared load is read once and completes every request");
+    }
+
+    // Cancellation
+    {
+        ResetRecords();
+        std::shared_ptr<AssetRequest<TestAsset>> gate = CloseGate("Textures/gate3.png");
+        std::shared_ptr<AssetRequest<TestAsset>> dropped = streamer.LoadAsync<TestAsset>("Textures/dropped.png");
+        std::shared_ptr<AssetRequest<TestAsset>> kept = streamer.LoadAsync<TestAsset>("Textures/kept.png");
+        std::shared_ptr<AssetRequest<TestAsset>> keptToo = streamer.LoadAsync<TestAsset>("Textures/kept.png");
+        bool droppedCalled = false;
+        dropped->OnComplete([&droppedCalled](AssetRequest<TestAsset>&) { droppedCalled = true; });
+        dropped->Cancel();
+        kept->Cancel();
+
+        gateOpen = true;
+        streamer.Flush();
+        bool droppedRead = false;
+        for (const std::string& path : readOrder) {
+            droppedRead = droppedRead || path == "Textures/dropped.png";
+        }
+        Check(dropped->GetStatus() == AssetRequestBase::Status::CANCELLED && !droppedCalled && !droppedRead,
+              "A cancelled request is not read and its callback is not called");
+        Check(kept->GetStatus() == AssetRequestBase::Status::CANCELLED && !kept->GetHandle() && keptToo->Succeeded(),
+              "Cancelling one request leaves the others for the same asset loading");
+
+        // Cancelled after decoding, before the upload
+        ResetRecords();
+        std::shared_ptr<AssetRequest<TestAsset>> late = streamer.LoadAsync<TestAsset>("Textures/late.png");
+        WaitFor([]() { return decodes.load() == 1; });
+        late->Cancel();
+        streamer.Update();
+        bool freed = WaitFor([]() { return unloads.load() == 1; });
+        Check(uploadThreads.empty() && freed && streamer.GetPendingCount() == 0,
+              "A cancelled asset is freed instead of uploaded");
+    }
+
+    // Upload budget
+    {
+        ResetRecords();
+        streamer.SetUploadBudget(100);
+        std::vector<std::shared_ptr<AssetRequest<TestAsset>>> requests;
+        for (int i = 0; i < 4; ++i) {
+            requests.push_back(streamer.LoadAsync<TestAsset>("Models/rock" + std::to_string(i) + ".obj", 0.0f,
+                                                             "size=" + std::to_string(i == 0 ? 500 : 40)));
+        }
+        WaitFor([]() { return decodes.load() == 4; });
+
+        streamer.Update();
+        Check(uploadThreads.size() == 1 && requests[0]->Succeeded(),
+              "An asset over the budget still uploads, alone in its frame");
+        streamer.Update();
+        Check(uploadThreads.size() == 3, "Later frames upload as many assets as fit the budget");
+        streamer.Update();
+        Check(uploadThreads.size() == 4 && requests[3]->Succeeded() && streamer.GetPendingCount() == 0,
+              "Every asset is uploaded over a few frames");
+        streamer.SetUploadBudget(8 * 1024 * 1024);
+    }
+
+    // Failures
+    {
+        ResetRecords();
+        std::shared_ptr<AssetRequest<TestAsset>> missing = streamer.LoadAsync<TestAsset>("Textures/missing.png");
+        std::shared_ptr<AssetRequest<TestAsset>> corrupt = streamer.LoadAsync<TestAsset>("Textures/corrupt.png");
+        int failed = 0;
+        missing->OnComplete([&failed](AssetRequest<TestAsset>& done) { failed += done.GetHandle() ? 0 : 1; });
+        corrupt->OnComplete([&failed](AssetRequest<TestAsset>& done) { failed += done.GetHandle() ? 0 : 1; });
+        streamer.Flush();
+        Check(missing->GetStatus() == AssetRequestBase::Status::FAILED &&
+              corrupt->GetStatus() == AssetRequestBase::Status::FAILED && failed == 2,
+              "Failed reads and decodes complete their requests with empty handles");
+        Check(assets.GetRefCount<TestAsset>("Textures/missing.png") == 0, "Failures are not kept");
+    }
+
+    // Shutdown
+    {
+        ResetRecords();
+        std::shared_ptr<AssetRequest<TestAsset>> gate = CloseGate("Textures/gate4.png");
+        std::shared_ptr<AssetRequest<TestAsset>> waiting = streamer.LoadAsync<TestAsset>("Textures/waiting.png");
+        std::thread opener([]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            gateOpen = true;
+        });
+        streamer.Shutdown();
+        opener.join();
+        Check(waiting->GetStatus() == AssetRequestBase::Status::FAILED && gate->IsDone() &&
+              streamer.GetPendingCount() == 0, "Shutdown fails the loads it interrupts");
+
+        std::shared_ptr<AssetRequest<TestAsset>> restarted = streamer.LoadAsync<TestAsset>("Textures/waiting.png");
+        streamer.Flush();
+        Check(restarted->Succeeded(), "Loading again restarts the streamer");
+    }
+
+    // Many small assets
+    {
+        ResetRecords();
+        const int count = 2000;
+        std::vector<std::shared_ptr<AssetRequest<TestAsset>>> requests;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < count; ++i) {
+            requests.push_back(streamer.LoadAsync<TestAsset>("Props/prop" + std::to_string(i) + ".obj",
+                                                             static_cast<float>(i % 7)));
+        }
+        streamer.Flush();
+        auto end = std::chrono::high_resolution_clock::now();
+
+        bool allLoaded = true;
+        for (const auto& request : requests) {
+            allLoaded = allLoaded && request->Succeeded();
+        }
+        Check(allLoaded && decodes == count, "2000 streamed assets all load");
+        std::cout << "2000 assets: " << std::chrono::duration<double, std::milli>(end - start).count() << " ms"
+                  << std::endl;
+    }
+
+    streamer.Shutdown();
+    JobSystem::GetInstance().Shutdown();
+
+    return TestSummary();
+}
@@ -0,0 +1,19 @@
+@echo off
+echo Building asset streamer test program...
+
+REM Build asset streamer test
+g++ -std=c++14 -O2 -I.. ^
+    AssetStreamerTest.cpp ^
+    ..\AssetStreamer.cpp ^
+    ..\AssetManager.cpp ^
+    ..\JobSystem.cpp ^
+    -o asset_streamer_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run asset_streamer_test.exe from this folder to test background asset loading.
+pause
@@ -0,0 +1,20 @@
+#!/bin/bash
+
+# Build asset streamer test
+echo "Building asset streamer test program..."
+g++ -std=c++14 -O2 -I.. \
+    AssetStreamerTest.cpp \
+    ../AssetStreamer.cpp \
+    ../AssetManager.cpp \
+    ../JobSystem.cpp \
+    -pthread -o asset_streamer_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x asset_streamer_test
+
+echo "Build complete. Run ./asset_streamer_test from this folder to test background asset loading."
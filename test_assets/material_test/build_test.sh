@@ -7,14 +7,32 @@ mkdir -p bin
 g++ -std=c++11 -o bin/test_obj_loader \
     test_obj_loader.cpp \
     ../../Model.cpp \
+    ../../ObjLoader.cpp \
+    ../../MeshCache.cpp \
+    ../../MeshOptimizer.cpp \
+    ../../MeshSimplifier.cpp \
+    ../../AssetManager.cpp \
+    ../../AssetStreamer.cpp \
+    ../../JobSystem.cpp \
+    ../../Debugger.cpp \
+    ../../MappedFile.cpp \
     ../../Vector3.cpp \
     ../../Matrix4x4.cpp \
     ../../Graphics/Core/GraphicsAPIFactory.cpp \
+    ../../Graphics/Core/NullGraphicsAPI.cpp \
+    ../../Graphics/Core/RecordingGraphicsAPI.cpp \
+    ../../Graphics/Core/GraphicsTrace.cpp \
     ../../Graphics/Core/OpenGLGraphicsAPI.cpp \
+    ../../Graphics/Core/GLStateCache.cpp \
     ../../Texture.cpp \
+    ../../TextureCache.cpp \
+    ../../TextureAtlas.cpp \
     ../../MonoBehaviourLike.cpp \
     ../../Shaders/Core/ShaderProgram.cpp \
+    ../../Shaders/Core/ShaderUniforms.cpp \
     ../../Shaders/Core/Shader.cpp \
+    ../../Shaders/Core/ShaderPreprocessor.cpp \
+    ../../Shaders/Core/ShaderSourceCache.cpp \
     ../../Shaders/Core/ShaderError.cpp \
     -I../.. \
     -DGL_GLEXT_PROTOTYPES \
@@ -21,9 +21,9 @@ int main() {
     
     if (success) {
         std::cout << "OBJ file loaded successfully!" << std::endl;
-        std::cout << "Vertices: " << model.vertices.size() / 3 << std::endl;
-        std::cout << "Normals: " << model.normals.size() / 3 << std::endl;
-        std::cout << "Texture coordinates: " << model.texCoords.size() / 2 << std::endl;
+        std::cout << "Vertices: " << model.GetVertices().size() / 3 << std::endl;
+        std::cout << "Normals: " << model.GetNormals().size() / 3 << std::endl;
+        std::cout << "Texture coordinates: " << model.GetTexCoords().size() / 2 << std::endl;
     } else {
         std::cerr << "Failed to load OBJ file!" << std::endl;
     }
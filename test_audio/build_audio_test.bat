@@ -6,7 +6,7 @@ if not exist bin mkdir bin
 if not exist bin\windows mkdir bin\windows
 
 REM Build audio test program
-g++ -std=c++14 AudioTest.cpp ..\Audio\*.cpp ..\Scene.cpp ..\GameObject.cpp ..\MonoBehaviourLike.cpp ^
+g++ -std=c++14 AudioTest.cpp ..\Audio\*.cpp ..\Scene.cpp ..\Coroutine.cpp ..\TimerWheel.cpp ..\FrustumCuller.cpp ..\RenderQueue.cpp ..\LodGroup.cpp ..\GameObject.cpp ..\MonoBehaviourLike.cpp ^
     -I.. -lmingw32 -lSDL2main -lSDL2 -lSDL2_mixer -o audio_test.exe
 
 if %ERRORLEVEL% NEQ 0 (
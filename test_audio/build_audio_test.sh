@@ -2,7 +2,7 @@
 
 # Build audio test program
 echo "Building audio test program..."
-g++ -std=c++14 AudioTest.cpp ../Audio/*.cpp ../Scene.cpp ../GameObject.cpp ../MonoBehaviourLike.cpp \
+g++ -std=c++14 AudioTest.cpp ../Audio/*.cpp ../Scene.cpp ../Coroutine.cpp ../TimerWheel.cpp ../FrustumCuller.cpp ../RenderQueue.cpp ../LodGroup.cpp ../GameObject.cpp ../MonoBehaviourLike.cpp \
     -I.. -I/usr/include/SDL2 -lSDL2 -lSDL2_mixer -o audio_test
 
 # Make executable
@@ -2,7 +2,7 @@
 echo Building comprehensive audio test program...
 
 REM Build comprehensive audio test program
-g++ -std=c++14 ComprehensiveAudioTest.cpp ..\Audio\*.cpp ^
+g++ -std=c++14 ComprehensiveAudioTest.cpp ..\Audio\*.cpp ..\Coroutine.cpp ..\TimerWheel.cpp ..\AssetManager.cpp ^
     -I.. -DHEADLESS_ENVIRONMENT=1 -o comprehensive_audio_test.exe
 
 if %ERRORLEVEL% NEQ 0 (
@@ -2,7 +2,7 @@
 
 # Build dummy audio test program
 echo "Building dummy audio test program..."
-g++ -std=c++14 DummyAudioTest.cpp ../Audio/*.cpp \
+g++ -std=c++14 DummyAudioTest.cpp ../Audio/*.cpp ../Coroutine.cpp ../TimerWheel.cpp ../AssetManager.cpp \
     -I.. -DHEADLESS_ENVIRONMENT=1 -o dummy_audio_test
 
 # Make executable
@@ -2,7 +2,7 @@
 echo Building simple audio test program...
 
 REM Build simple audio test program
-g++ -std=c++14 SimpleAudioTest.cpp ..\Audio\*.cpp ^
+g++ -std=c++14 SimpleAudioTest.cpp ..\Audio\*.cpp ..\Coroutine.cpp ..\TimerWheel.cpp ..\AssetManager.cpp ^
     -I.. -lmingw32 -lSDL2main -lSDL2 -lSDL2_mixer -o simple_audio_test.exe
 
 if %ERRORLEVEL% NEQ 0 (
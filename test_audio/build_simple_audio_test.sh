@@ -2,7 +2,7 @@
 
 # Build simple audio test program
 echo "Building simple audio test program..."
-g++ -std=c++14 SimpleAudioTest.cpp ../Audio/*.cpp \
+g++ -std=c++14 SimpleAudioTest.cpp ../Audio/*.cpp ../Coroutine.cpp ../TimerWheel.cpp ../AssetManager.cpp \
     -I.. -I/usr/include/SDL2 -lSDL2 -lSDL2_mixer -o simple_audio_test
 
 # Make executable
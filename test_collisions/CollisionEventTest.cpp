@@ -0,0 +1,173 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../Scene.h"
+#include "../GameObject.h"
+#include "../RigidBody.h"
+#include "../TriggerVolume.h"
+#include "../EventBus.h"
+#include "../EngineEvents.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the collision pass: ENTER, STAY and EXIT events per contact
+// Build with build_collision_event_test.sh
+
+// A game object with a rigid body attached to it
+static RigidBody* AddBody(GameObject& object) {
+    RigidBody* body = object.AddComponent(new RigidBody());
+    body->SetGameObject(&object);
+    return body;
+}
+
+// Counts the legacy hooks a scene forwards to its components
+class HookCounter : public MonoBehaviourLike {
+public:
+    int enters = 0;
+    int stays = 0;
+    void OnCollisionEnter() override { enters++; }
+    void OnCollisionStay() override { stays++; }
+};
+
+static int Count(const std::vector<CollisionEvent>& events, RigidBody* body, CollisionPhase phase) {
+    int count = 0;
+    for (const CollisionEvent& event : events) {
+        if (event.body == body && event.phase == phase) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int main() {
+    std::cout << "Collision Event Test" << std::endl;
+    std::cout << "====================" << std::endl;
+
+    EventBus& bus = EventBus::GetInstance();
+    std::vector<CollisionEvent> collisions;
+    std::vector<TriggerEvent> triggers;
+    EventBus::ListenerId collisionListener = bus.Subscribe<CollisionEvent>([&](const CollisionEvent* events, size_t count) {
+        collisions.insert(collisions.end(), events, events + count);
+    });
+    EventBus::ListenerId triggerListener = bus.Subscribe<TriggerEvent>([&](const TriggerEvent* events, size_t count) {
+        triggers.insert(triggers.end(), events, events + count);
+    });
+
+    // Two bodies touching, then pulled apart
+    {
+        Scene scene;
+        GameObject a("a", Vector3(0, 0, 0), Vector3(0, 0, 0), Vector3(1, 1, 1));
+        GameObject b("b", Vector3(1.5f, 0, 0), Vector3(0, 0, 0), Vector3(1, 1, 1));
+        RigidBody* bodyA = AddBody(a);
+        RigidBody* bodyB = AddBody(b);
+        scene.AddGameObject(&a);
+        scene.AddGameObject(&b);
+
+        collisions.clear();
+        scene.DetectCollisions();
+        bus.Dispatch();
+        Check(Count(collisions, bodyA, CollisionPhase::ENTER) == 1 && Count(collisions, bodyB, CollisionPhase::ENTER) == 1,
+              "Overlapping bodies both enter");
+        Check(bodyA->GetContacts().size() == 1 && bodyA->GetContacts()[0] == bodyB, "Contact is recorded");
+
+        collisions.clear();
+        scene.DetectCollisions();
+        bus.Dispatch();
+        Check(Count(collisions, bodyA, CollisionPhase::STAY) == 1 && Count(collisions, bodyB, CollisionPhase::STAY) == 1,
+              "Bodies still overlapping stay");
+
+        b.SetPosition(Vector3(10, 0, 0));
+        collisions.clear();
+        scene.DetectCollisions();
+        bus.Dispatch();
+        Check(Count(collisions, bodyA, CollisionPhase::EXIT) == 1 && Count(collisions, bodyB, CollisionPhase::EXIT) == 1,
+              "Separated bodies both exit");
+        Check(bodyA->GetContacts().empty() && bodyB->GetContacts().empty(), "Exit clears the contacts");
+
+        collisions.clear();
+        scene.DetectCollisions();
+        bus.Dispatch();
+        Check(collisions.empty(), "Bodies apart raise no events");
+        scene.Shutdown();
+    }
+
+    // A body whose object leaves the scene while touching
+    {
+        Scene scene;
+        GameObject a("a", Vector3(0, 0, 0), Vector3(0, 0, 0), Vector3(1, 1, 1));
+        GameObject b("b", Vector3(0, 1, 0), Vector3(0, 0, 0), Vector3(1, 1, 1));
+        RigidBody* bodyA = AddBody(a);
+        RigidBody* bodyB = AddBody(b);
+        scene.AddGameObject(&a);
+        scene.AddGameObject(&b);
+        scene.DetectCollisions();
+        bus.Dispatch();
+
+        scene.RemoveGameObject(&b);
+        collisions.clear();
+        scene.DetectCollisions();
+        bus.Dispatch();
+        Check(Count(collisions, bodyA, CollisionPhase::EXIT) == 1 && bodyA->GetContacts().empty(),
+              "Removing an object ends the contacts with it");
+        Check(collisions.size() == 1 && collisions[0].other == bodyB, "Exit names the removed body");
+        scene.Shutdown();
+    }
+
+    // An object walking through a trigger volume
+    {
+        Scene scene;
+        GameObject volume("volume", Vector3(0, 0, 0), Vector3(0, 0, 0), Vector3(2, 2, 2));
+        TriggerVolume* trigger = volume.AddComponent(new TriggerVolume());
+        GameObject walker("walker", Vector3(1, 0, 0), Vector3(0, 0, 0), Vector3(0.5f, 0.5f, 0.5f));
+        AddBody(walker);
+        scene.AddGameObject(&volume);
+        scene.AddGameObject(&walker);
+
+        triggers.clear();
+        scene.DetectCollisions();
+        bus.Dispatch();
+        Check(triggers.size() == 1 && triggers[0].phase == CollisionPhase::ENTER && triggers[0].other == &walker,
+              "Object entering a trigger raises ENTER");
+        Check(trigger->IsObjectInTrigger(&walker), "Trigger tracks the object");
+
+        walker.SetPosition(Vector3(5, 0, 0));
+        triggers.clear();
+        scene.DetectCollisions();
+        bus.Dispatch();
+        Check(triggers.size() == 1 && triggers[0].phase == CollisionPhase::EXIT, "Object leaving a trigger raises EXIT");
+        Check(!trigger->IsObjectInTrigger(&walker), "Trigger forgets the object");
+        scene.Shutdown();
+    }
+
+    // Two live scenes share the bus
+    {
+        Scene scene;
+        Scene other;
+        scene.Initialize();
+        other.Initialize();
+        GameObject a("a", Vector3(0, 0, 0), Vector3(0, 0, 0), Vector3(1, 1, 1));
+        GameObject b("b", Vector3(1, 0, 0), Vector3(0, 0, 0), Vector3(1, 1, 1));
+        HookCounter* hooks = a.AddComponent(new HookCounter());
+        AddBody(a);
+        AddBody(b);
+        scene.AddGameObject(&a);
+        scene.AddGameObject(&b);
+
+        scene.DetectCollisions();
+        bus.Dispatch();
+        Check(hooks->enters == 1, "Only the owning scene forwards a collision to the hooks");
+
+        collisions.clear();
+        scene.DetectCollisions();
+        other.Shutdown();
+        bus.Dispatch();
+        Check(collisions.size() == 2 && hooks->stays == 1,
+              "Shutting down one scene keeps the other's listeners and pending events");
+        scene.Shutdown();
+        Check(a.GetScene() == nullptr, "Shutdown detaches the objects from the scene");
+    }
+
+    bus.Unsubscribe(collisionListener);
+    bus.Unsubscribe(triggerListener);
+
+    return TestSummary();
+}
@@ -0,0 +1,63 @@
+@echo off
+echo Building collision event test program...
+
+REM Build collision event test
+g++ -std=c++14 -I.. ^
+    CollisionEventTest.cpp ^
+    ..\WorldPartition.cpp ^
+    ..\JobSystem.cpp ^
+    ..\SceneSerializer.cpp ^
+    ..\BinaryScene.cpp ^
+    ..\Scene.cpp ^
+    ..\FrustumCuller.cpp ^
+    ..\RenderQueue.cpp ^
+    ..\LodGroup.cpp ^
+    ..\SceneLoadOperation.cpp ^
+    ..\SceneSnapshot.cpp ^
+    ..\EventBus.cpp ^
+    ..\Coroutine.cpp ^
+    ..\TimerWheel.cpp ^
+    ..\Camera.cpp ^
+    ..\CameraManager.cpp ^
+    ..\GameObject.cpp ^
+    ..\RigidBody.cpp ^
+    ..\TriggerVolume.cpp ^
+    ..\PhysicsSystem.cpp ^
+    ..\TimeManager.cpp ^
+    ..\EngineCondition.cpp ^
+    ..\Vector3.cpp ^
+    ..\Matrix4x4.cpp ^
+    ..\Model.cpp ^
+    ..\ObjLoader.cpp ^
+    ..\MeshCache.cpp ^
+    ..\MeshOptimizer.cpp ^
+    ..\MeshSimplifier.cpp ^
+    ..\AssetManager.cpp ^
+    ..\AssetStreamer.cpp ^
+    ..\Texture.cpp ^
+    ..\TextureCache.cpp ^
+    ..\TextureAtlas.cpp ^
+    ..\Debugger.cpp ^
+    ..\MappedFile.cpp ^
+    ..\Shaders\Core\Shader.cpp ^
+    ..\Shaders\Core\ShaderPreprocessor.cpp ^
+    ..\Shaders\Core\ShaderSourceCache.cpp ^
+    ..\Shaders\Core\ShaderProgram.cpp ^
+    ..\Shaders\Core\ShaderUniforms.cpp ^
+    ..\Shaders\Core\ShaderError.cpp ^
+    ..\Graphics\Core\GraphicsAPIFactory.cpp ^
+    ..\Graphics\Core\NullGraphicsAPI.cpp ^
+    ..\Graphics\Core\RecordingGraphicsAPI.cpp ^
+    ..\Graphics\Core\GraphicsTrace.cpp ^
+    ..\Graphics\Core\OpenGLGraphicsAPI.cpp ^
+    ..\Graphics\Core\GLStateCache.cpp ^
+    -lopengl32 -lglew32 -o collision_event_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run collision_event_test.exe to test collision events.
+pause
@@ -0,0 +1,35 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <iostream>
+#include <string>
+
+// Pass/fail reporting shared by the test programs in the test_* folders.
+// Each program calls Check for every expectation and returns
+// TestSummary() from main, so scripts can rely on the exit code.
+
+inline int& TestFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void Check(bool condition, const std::string& message) {
+    if (condition) {
+        std::cout << "[PASS] " << message << std::endl;
+    } else {
+        std::cout << "[FAIL] " << message << std::endl;
+        TestFailures()++;
+    }
+}
+
+// Print the result and return the exit code for main
+inline int TestSummary() {
+    if (TestFailures() > 0) {
+        std::cout << "\n" << TestFailures() << " test(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "\nAll tests passed!" << std::endl;
+    return 0;
+}
+
+#endif // TEST_CHECK_H
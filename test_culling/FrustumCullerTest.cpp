@@ -0,0 +1,161 @@
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../FrustumCuller.h"
+#include "../Camera.h"
+#include "../JobSystem.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the frustum culler: plane extraction, the batched box tests
+// against a plain one, parallel culls and results shared between cameras
+// Build with build_frustum_culler_test.sh
+
+static float Random(float low, float high) {
+    return low + (high - low) * (static_cast<float>(std::rand()) / static_cast<float>(RAND_MAX));
+}
+
+// Boxes scattered around the origin, some large enough to straddle planes
+static void AddRandomBoxes(FrustumCuller& culler, std::vector<Vector3>& mins, std::vector<Vector3>& maxs, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        Vector3 center(Random(-300.0f, 300.0f), Random(-100.0f, 100.0f), Random(-300.0f, 300.0f));
+        Vector3 half(Random(0.1f, 20.0f), Random(0.1f, 20.0f), Random(0.1f, 20.0f));
+        mins.push_back(center - half);
+        maxs.push_back(center + half);
+        culler.Add(center - half, center + half);
+    }
+}
+
+static bool MatchesPlainTest(const FrustumCuller::Frustum& frustum, const std::vector<uint8_t>& visible,
+                             const std::vector<Vector3>& mins, const std::vector<Vector3>& maxs) {
+    if (visible.size() != mins.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < mins.size(); i++) {
+        if ((visible[i] != 0) != frustum.Intersects(mins[i], maxs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t CountVisible(const std::vector<uint8_t>& visible) {
+    size_t count = 0;
+    for (uint8_t flag : visible) {
+        count += flag ? 1 : 0;
+    }
+    return count;
+}
+
+int main() {
+    std::cout << "Frustum Culler Test" << std::endl;
+    std::cout << "===================" << std::endl;
+    std::srand(1234);
+
+    // The default camera sits at the origin looking down +z
+    Camera camera;
+    camera.SetAspectRatio(1.0f);
+    FrustumCuller::Frustum frustum = FrustumCuller::Frustum::FromMatrices(camera.GetViewMatrix(), camera.GetProjectionMatrix());
+    Vector3 unit(1.0f, 1.0f, 1.0f);
+    Check(frustum.Intersects(Vector3(0, 0, 10) - unit, Vector3(0, 0, 10) + unit), "Box in front is visible");
+    Check(!frustum.Intersects(Vector3(0, 0, -10) - unit, Vector3(0, 0, -10) + unit), "Box behind is culled");
+    Check(!frustum.Intersects(Vector3(100, 0, 10) - unit, Vector3(100, 0, 10) + unit), "Box to the side is culled");
+    Check(!frustum.Intersects(Vector3(0, 0, 2000) - unit, Vector3(0, 0, 2000) + unit), "Box beyond the far plane is culled");
+    Check(frustum.Intersects(Vector3(-1000, -1, 9), Vector3(0, 1, 11)), "Box across a plane is visible");
+
+    // The far plane comes out of a float projection, so it is only close
+    Vector3 corners[8];
+    bool closed = frustum.GetCorners(corners);
+    Check(closed && std::fabs(corners[0].z - camera.GetNearPlane()) < 1e-3f &&
+          std::fabs(corners[7].z - camera.GetFarPlane()) < 1.0f, "Corners lie on the near and far planes");
+
+    // Batched tests agree with the plain one, tails included
+    {
+        FrustumCuller culler;
+        std::vector<Vector3> mins;
+        std::vector<Vector3> maxs;
+        AddRandomBoxes(culler, mins, maxs, 1003);
+        const std::vector<uint8_t>& visible = culler.Cull(camera.GetViewMatrix(), camera.GetProjectionMatrix());
+        Check(MatchesPlainTest(frustum, visible, mins, maxs), "Batched cull matches the plain test");
+        size_t count = CountVisible(visible);
+        Check(count > 0 && count < mins.size(), "Some boxes are culled and some are not");
+        Check(culler.GetStats().boxesTested == mins.size(), "Every box is tested once");
+    }
+
+    // Large frames are split across workers
+    {
+        FrustumCuller culler;
+        std::vector<Vector3> mins;
+        std::vector<Vector3> maxs;
+        AddRandomBoxes(culler, mins, maxs, FrustumCuller::PARALLEL_THRESHOLD * 3 + 5);
+        const std::vector<uint8_t>& visible = culler.Cull(frustum);
+        Check(MatchesPlainTest(frustum, visible, mins, maxs), "Parallel cull matches the plain test");
+    }
+
+    // Cameras of one frame share results
+    {
+        FrustumCuller culler;
+        std::vector<Vector3> mins;
+        std::vector<Vector3> maxs;
+        AddRandomBoxes(culler, mins, maxs, 5000);
+
+        std::vector<uint8_t> mainVisible = culler.Cull(frustum);
+
+        Camera zoomed;
+        zoomed.SetAspectRatio(1.0f);
+        zoomed.SetFieldOfView(30.0f);
+        zoomed.SetNearPlane(1.0f);
+        zoomed.SetFarPlane(500.0f);
+        FrustumCuller::Frustum inner = FrustumCuller::Frustum::FromMatrices(zoomed.GetViewMatrix(), zoomed.GetProjectionMatrix());
+        Check(frustum.Contains(inner) && !inner.Contains(frustum), "Narrower view is inside the wider one");
+
+        size_t testedBefore = culler.GetStats().boxesTested;
+        const std::vector<uint8_t>& zoomedVisible = culler.Cull(inner);
+        Check(MatchesPlainTest(inner, zoomedVisible, mins, maxs), "Nested camera gets the right result");
+        Check(culler.GetStats().sharedResults == 1 &&
+              culler.GetStats().boxesTested - testedBefore == CountVisible(mainVisible),
+              "Nested camera only tests what the outer camera saw");
+
+        testedBefore = culler.GetStats().boxesTested;
+        const std::vector<uint8_t>& again = culler.Cull(frustum);
+        Check(again == mainVisible && culler.GetStats().boxesTested == testedBefore,
+              "Same frustum reuses its result");
+
+        Camera behind;
+        behind.SetAspectRatio(1.0f);
+        behind.SetRotation(Vector3(0.0f, 180.0f, 0.0f));
+        FrustumCuller::Frustum opposite = FrustumCuller::Frustum::FromMatrices(behind.GetViewMatrix(), behind.GetProjectionMatrix());
+        size_t sharedBefore = culler.GetStats().sharedResults;
+        const std::vector<uint8_t>& behindVisible = culler.Cull(opposite);
+        Check(culler.GetStats().sharedResults == sharedBefore && MatchesPlainTest(opposite, behindVisible, mins, maxs),
+              "Unrelated camera is culled on its own");
+        Check(culler.GetStats().cameras == 4, "Cameras counted");
+
+        culler.Clear();
+        Check(culler.GetCount() == 0 && culler.GetStats().cameras == 0, "Clear starts a new frame");
+    }
+
+    // World bounds of rotated models
+    {
+        Vector3 worldMin;
+        Vector3 worldMax;
+        FrustumCuller::TransformBounds(Vector3(-2, -1, -1), Vector3(2, 1, 1), Vector3(10, 0, 0), Vector3(0, 0, 0),
+                                       worldMin, worldMax);
+        Check(worldMin == Vector3(8, -1, -1) && worldMax == Vector3(12, 1, 1), "Unrotated bounds are moved");
+
+        FrustumCuller::TransformBounds(Vector3(-2, -1, -1), Vector3(2, 1, 1), Vector3(0, 0, 0), Vector3(0, 90, 0),
+                                       worldMin, worldMax);
+        Check(std::fabs(worldMax.x - 1.0f) < 1e-3f && std::fabs(worldMax.z - 2.0f) < 1e-3f &&
+              std::fabs(worldMin.z + 2.0f) < 1e-3f, "Quarter turn swaps the extents");
+
+        FrustumCuller::TransformBounds(Vector3(-1, -1, -1), Vector3(1, 1, 1), Vector3(0, 0, 0), Vector3(0, 45, 0),
+                                       worldMin, worldMax);
+        Check(std::fabs(worldMax.x - std::sqrt(2.0f)) < 1e-3f && std::fabs(worldMax.y - 1.0f) < 1e-3f,
+              "Turned box grows to hold its corners");
+    }
+
+    JobSystem::GetInstance().Shutdown();
+
+    return TestSummary();
+}
@@ -0,0 +1,21 @@
+@echo off
+echo Building frustum culler test program...
+
+REM Build frustum culler test
+REM Boxes are culled against camera matrices only, so no GL or window is needed
+g++ -std=c++14 -O2 -I.. ^
+    FrustumCullerTest.cpp ^
+    ..\FrustumCuller.cpp ^
+    ..\JobSystem.cpp ^
+    ..\Matrix4x4.cpp ^
+    ..\Vector3.cpp ^
+    -pthread -o frustum_culler_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run frustum_culler_test.exe to test frustum culling.
+pause
@@ -0,0 +1,22 @@
+#!/bin/bash
+
+# Build frustum culler test
+# Boxes are culled against camera matrices only, so no GL or window is needed
+echo "Building frustum culler test program..."
+g++ -std=c++14 -O2 -I.. \
+    FrustumCullerTest.cpp \
+    ../FrustumCuller.cpp \
+    ../JobSystem.cpp \
+    ../Matrix4x4.cpp \
+    ../Vector3.cpp \
+    -pthread -o frustum_culler_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x frustum_culler_test
+
+echo "Build complete. Run ./frustum_culler_test to test frustum culling."
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include "../EventBus.h"
+#include "../EngineEvents.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the typed event bus
+// Build with build_event_bus_test.sh
+
+struct ScoreEvent {
+    int points;
+    explicit ScoreEvent(int points = 0) : points(points) {}
+};
+
+int main() {
+    std::cout << "Event Bus Test" << std::endl;
+    std::cout << "==============" << std::endl;
+
+    EventBus& bus = EventBus::GetInstance();
+
+    // Batched delivery: one listener call for the whole batch
+    int calls = 0;
+    int total = 0;
+    EventBus::ListenerId scoreListener = bus.Subscribe<ScoreEvent>([&](const ScoreEvent* events, size_t count) {
+        calls++;
+        for (size_t i = 0; i < count; i++) {
+            total += events[i].points;
+        }
+    });
+
+    for (int i = 1; i <= 100; i++) {
+        bus.Publish(ScoreEvent(i));
+    }
+    Check(calls == 0 && bus.GetPendingCount<ScoreEvent>() == 100, "Events are deferred until dispatch");
+
+    bus.Dispatch();
+    Check(calls == 1 && total == 5050, "One listener call per batch");
+
+    // Types are dispatched independently
+    int collisionEnters = 0;
+    bus.Subscribe<CollisionEvent>([&](const CollisionEvent* events, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            if (events[i].phase == CollisionPhase::ENTER) {
+                collisionEnters++;
+            }
+        }
+    });
+    bus.Publish(CollisionEvent(nullptr, nullptr, CollisionInfo(), CollisionPhase::ENTER));
+    bus.Publish(CollisionEvent(nullptr, nullptr, CollisionInfo(), CollisionPhase::STAY));
+    bus.Dispatch<CollisionEvent>();
+    Check(collisionEnters == 1, "Typed dispatch delivers collision events");
+
+    // Events raised while dispatching go into the next batch
+    int reentrant = 0;
+    EventBus::ListenerId chain = bus.Subscribe<NavMeshRefreshedEvent>([&](const NavMeshRefreshedEvent*, size_t count) {
+        reentrant += static_cast<int>(count);
+        if (reentrant < 3) {
+            EventBus::GetInstance().Publish(NavMeshRefreshedEvent());
+        }
+    });
+    bus.Publish(NavMeshRefreshedEvent());
+    bus.Dispatch();
+    Check(reentrant == 1, "Events published during dispatch are deferred");
+    bus.Dispatch();
+    Check(reentrant == 2, "Deferred events arrive on the next dispatch");
+    bus.Unsubscribe(chain);
+    bus.Dispatch();
+    Check(reentrant == 2, "Unsubscribed listener is not called");
+
+    // A listener that dispatches gets the next batch after the current one
+    std::vector<int> order;
+    EventBus::ListenerId nested = bus.Subscribe<ScoreEvent>([&](const ScoreEvent* events, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            order.push_back(events[i].points);
+            if (events[i].points == 1) {
+                EventBus::GetInstance().Publish(ScoreEvent(2));
+                EventBus::GetInstance().Dispatch();
+                EventBus::GetInstance().Dispatch<ScoreEvent>();
+                order.push_back(-1);
+            }
+        }
+    });
+    bus.Publish(ScoreEvent(1));
+    bus.Dispatch();
+    Check(order.size() == 3 && order[0] == 1 && order[1] == -1 && order[2] == 2,
+          "Dispatch from a listener runs after the current batch");
+    bus.Unsubscribe(nested);
+
+    // Publishing from several threads
+    bus.Unsubscribe(scoreListener);
+    total = 0;
+    bus.Subscribe<ScoreEvent>([&](const ScoreEvent* events, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            total += events[i].points;
+        }
+    });
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; t++) {
+        workers.push_back(std::thread([&bus]() {
+            std::vector<ScoreEvent> local(1000, ScoreEvent(1));
+            bus.PublishBatch(local.data(), local.size());
+            for (int i = 0; i < 1000; i++) {
+                bus.Publish(ScoreEvent(1));
+            }
+        }));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    bus.Dispatch();
+    Check(total == 8000, "Publishing is thread safe");
+
+    return TestSummary();
+}
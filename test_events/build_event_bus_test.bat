@@ -0,0 +1,17 @@
+@echo off
+echo Building event bus test program...
+
+REM Build event bus test
+g++ -std=c++14 -I.. ^
+    EventBusTest.cpp ^
+    ..\EventBus.cpp ^
+    -o event_bus_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run event_bus_test.exe to test the event bus.
+pause
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Build event bus test
+echo "Building event bus test program..."
+g++ -std=c++14 -I.. \
+    EventBusTest.cpp \
+    ../EventBus.cpp \
+    -pthread -o event_bus_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x event_bus_test
+
+echo "Build complete. Run ./event_bus_test to test the event bus."
@@ -0,0 +1,183 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../Graphics/Core/GLStateCache.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the GL state cache, run against a mock function table
+// Build with build_gl_state_cache_test.sh
+
+// Every call the cache lets through, by name
+static std::vector<std::string> calls;
+
+static GLFunctionTable CreateMockTable() {
+    GLFunctionTable table;
+    table.bindVertexArray = [](unsigned int) { calls.push_back("bindVertexArray"); };
+    table.bindBuffer = [](unsigned int, unsigned int) { calls.push_back("bindBuffer"); };
+    table.bindBufferBase = [](unsigned int, unsigned int, unsigned int) { calls.push_back("bindBufferBase"); };
+    table.useProgram = [](unsigned int) { calls.push_back("useProgram"); };
+    table.activeTexture = [](unsigned int) { calls.push_back("activeTexture"); };
+    table.bindTexture = [](unsigned int, unsigned int) { calls.push_back("bindTexture"); };
+    table.enable = [](unsigned int) { calls.push_back("enable"); };
+    table.disable = [](unsigned int) { calls.push_back("disable"); };
+    table.depthFunc = [](unsigned int) { calls.push_back("depthFunc"); };
+    table.cullFace = [](unsigned int) { calls.push_back("cullFace"); };
+    table.blendFunc = [](unsigned int, unsigned int) { calls.push_back("blendFunc"); };
+    table.viewport = [](int, int, int, int) { calls.push_back("viewport"); };
+    return table;
+}
+
+int main() {
+    std::cout << "GL State Cache Test" << std::endl;
+    std::cout << "===================" << std::endl;
+
+    // Bindings
+    {
+        GLStateCache cache(CreateMockTable());
+        calls.clear();
+
+        cache.UseProgram(0);
+        Check(calls.size() == 1, "The first call reaches GL even when it sets a default");
+        cache.UseProgram(0);
+        cache.UseProgram(3);
+        cache.UseProgram(3);
+        Check(calls.size() == 2, "Using the current program is filtered");
+
+        calls.clear();
+        cache.BindBuffer(GLStateCache::ARRAY_BUFFER, 5);
+        cache.BindBuffer(GLStateCache::ELEMENT_ARRAY_BUFFER, 5);
+        cache.BindBuffer(GLStateCache::ARRAY_BUFFER, 5);
+        Check(calls.size() == 2, "Buffers are cached per target");
+
+        calls.clear();
+        cache.BindVertexArray(1);
+        cache.BindVertexArray(1);
+        cache.BindBuffer(GLStateCache::ARRAY_BUFFER, 5);
+        cache.BindBuffer(GLStateCache::ELEMENT_ARRAY_BUFFER, 5);
+        Check(calls.size() == 2 && calls[1] == "bindBuffer",
+              "A new vertex array forgets the element buffer, not the array buffer");
+
+        calls.clear();
+        cache.BindBufferBase(GLStateCache::UNIFORM_BUFFER, 0, 7);
+        cache.BindBufferBase(GLStateCache::UNIFORM_BUFFER, 0, 7);
+        cache.BindBufferBase(GLStateCache::UNIFORM_BUFFER, 1, 7);
+        cache.BindBuffer(GLStateCache::UNIFORM_BUFFER, 7);
+        Check(calls.size() == 2, "Uniform bindings are cached per index and bind the generic target");
+    }
+
+    // Textures
+    {
+        GLStateCache cache(CreateMockTable());
+        calls.clear();
+
+        cache.BindTexture(0, 10);
+        Check(calls.size() == 2 && calls[0] == "activeTexture", "The first bind selects the unit");
+        cache.BindTexture(0, 10);
+        Check(calls.size() == 2, "Binding the bound texture is filtered");
+
+        calls.clear();
+        cache.BindTexture(0, 11);
+        Check(calls.size() == 1 && calls[0] == "bindTexture", "The active unit is not selected again");
+
+        calls.clear();
+        cache.BindTexture(3, 11);
+        cache.BindTexture(0, 11);
+        cache.BindTexture(3, 12);
+        Check(calls.size() == 3, "Every unit keeps its own texture");
+
+        calls.clear();
+        cache.BindTexture(GLStateCache::MAX_TEXTURE_UNITS + 1, 11);
+        cache.BindTexture(GLStateCache::MAX_TEXTURE_UNITS + 1, 11);
+        Check(calls.size() == 4, "Units past the cache always reach GL");
+        cache.BindTexture(3, 13);
+        Check(calls.size() == 6 && calls[4] == "activeTexture",
+              "Units past the cache still move the active unit");
+    }
+
+    // Render state
+    {
+        GLStateCache cache(CreateMockTable());
+        calls.clear();
+
+        cache.SetEnabled(GLStateCache::DEPTH_TEST, true);
+        cache.SetEnabled(GLStateCache::DEPTH_TEST, true);
+        cache.SetEnabled(GLStateCache::CULL_FACE, true);
+        cache.SetEnabled(GLStateCache::DEPTH_TEST, false);
+        Check(calls.size() == 3 && calls[2] == "disable", "Capabilities are cached one by one");
+
+        calls.clear();
+        cache.DepthFunc(0x0203);
+        cache.DepthFunc(0x0203);
+        cache.CullFace(0x0405);
+        cache.CullFace(0x0405);
+        cache.BlendFunc(0x0302, 0x0303);
+        cache.BlendFunc(0x0302, 0x0303);
+        cache.BlendFunc(0x0302, 0x0001);
+        Check(calls.size() == 4, "Depth, cull and blend functions are cached");
+
+        calls.clear();
+        cache.Viewport(0, 0, 800, 600);
+        cache.Viewport(0, 0, 800, 600);
+        cache.Viewport(0, 0, 400, 600);
+        Check(calls.size() == 2, "The viewport is cached");
+    }
+
+    // Deletion and invalidation
+    {
+        GLStateCache cache(CreateMockTable());
+        cache.BindVertexArray(4);
+        cache.BindBuffer(GLStateCache::ARRAY_BUFFER, 8);
+        cache.UseProgram(2);
+        cache.BindTexture(0, 6);
+        calls.clear();
+
+        cache.OnBufferDeleted(8);
+        cache.BindBuffer(GLStateCache::ARRAY_BUFFER, 0);
+        Check(calls.empty(), "A deleted buffer counts as unbound");
+
+        cache.OnTextureDeleted(6);
+        cache.BindTexture(0, 0);
+        Check(calls.empty(), "A deleted texture counts as unbound");
+
+        cache.OnVertexArrayDeleted(4);
+        cache.BindVertexArray(4);
+        Check(calls.size() == 1, "A reused vertex array name is bound again");
+
+        calls.clear();
+        cache.OnProgramDeleted(2);
+        cache.UseProgram(2);
+        Check(calls.size() == 1, "A reused program name is used again");
+
+        calls.clear();
+        cache.Invalidate();
+        cache.BindVertexArray(4);
+        cache.UseProgram(2);
+        cache.SetEnabled(GLStateCache::BLEND, false);
+        cache.Viewport(0, 0, 400, 600);
+        Check(calls.size() == 4, "Everything reaches GL again after Invalidate");
+    }
+
+    // Statistics
+    {
+        GLStateCache cache(CreateMockTable());
+        cache.UseProgram(1);
+        cache.UseProgram(1);
+        cache.UseProgram(1);
+        cache.BindTexture(0, 5);
+        Check(cache.GetFrameStats().issued == 3 && cache.GetFrameStats().filtered == 2,
+              "Issued and filtered calls are counted");
+
+        cache.EndFrame();
+        Check(cache.GetFrameStats().issued == 0 && cache.GetLastFrameStats().issued == 3 &&
+              cache.GetLastFrameStats().filtered == 2,
+              "EndFrame moves the counts to the last frame");
+
+        cache.UseProgram(1);
+        cache.EndFrame();
+        Check(cache.GetLastFrameStats().issued == 0 && cache.GetLastFrameStats().filtered == 1 &&
+              cache.GetTotalStats().issued == 3 && cache.GetTotalStats().filtered == 3,
+              "Totals span frames");
+    }
+
+    return TestSummary();
+}
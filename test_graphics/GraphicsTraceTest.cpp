@@ -0,0 +1,290 @@
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Graphics/Core/GraphicsTrace.h"
+#include "../Graphics/Core/NullGraphicsAPI.h"
+#include "../Graphics/Core/RecordingGraphicsAPI.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the null graphics API and for recording and replaying traces
+// Build with build_graphics_trace_test.sh
+
+// GL shader type values, passed through untouched by the null API
+static const int VERTEX_SHADER = 0x8B31;
+static const int FRAGMENT_SHADER = 0x8B30;
+
+static const char* VERTEX_SOURCE =
+    "#version 330 core\n"
+    "layout (location = 0) in vec3 aPos;\n"
+    "uniform mat4 model;\n"
+    "uniform highp vec3 offsets[2], tint;\n"
+    "layout (std140) uniform CameraData {\n"
+    "    mat4 view;\n"
+    "    mat4 projection;\n"
+    "};\n"
+    "// uniform float commented;\n"
+    "void main() { gl_Position = vec4(aPos, 1.0); }\n";
+
+static const char* FRAGMENT_SOURCE =
+    "#version 330 core\n"
+    "struct Light { vec3 color; float intensity; };\n"
+    "uniform Light lights[4];\n"
+    "uniform sampler2D albedo;\n"
+    "out vec4 FragColor;\n"
+    "void main() { FragColor = texture(albedo, vec2(0.0)) * lights[0].intensity; }\n";
+
+static unsigned int BuildProgram(IGraphicsAPI& graphics) {
+    unsigned int vertex = graphics.CreateShader(VERTEX_SHADER);
+    graphics.ShaderSource(vertex, VERTEX_SOURCE);
+    graphics.CompileShader(vertex);
+    unsigned int fragment = graphics.CreateShader(FRAGMENT_SHADER);
+    graphics.ShaderSource(fragment, FRAGMENT_SOURCE);
+    graphics.CompileShader(fragment);
+
+    unsigned int program = graphics.CreateProgram();
+    graphics.AttachShader(program, vertex);
+    graphics.AttachShader(program, fragment);
+    graphics.LinkProgram(program);
+    graphics.DeleteShader(vertex);
+    graphics.DeleteShader(fragment);
+    return program;
+}
+
+// A few frames as the renderer would draw them
+static void DrawFrames(IGraphicsAPI& graphics, int frames) {
+    const float vertices[] = { 0.0f, 0.5f, 0.0f, -0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f };
+    const unsigned int indices[] = { 0, 1, 2 };
+    const float identity[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+
+    unsigned int program = BuildProgram(graphics);
+    graphics.SetUniformBlockBinding(program, "CameraData", 0);
+    int model = graphics.GetUniformLocation(program, "model");
+    int intensity = graphics.GetUniformLocation(program, "lights[0].intensity");
+
+    unsigned int vao = graphics.CreateVertexArray();
+    graphics.BindVertexArray(vao);
+    unsigned int vbo = graphics.CreateBuffer();
+    graphics.BindBuffer(BufferType::VERTEX_BUFFER, vbo);
+    graphics.BufferData(BufferType::VERTEX_BUFFER, vertices, sizeof(vertices));
+    unsigned int ebo = graphics.CreateBuffer();
+    graphics.BindBuffer(BufferType::INDEX_BUFFER, ebo);
+    graphics.BufferData(BufferType::INDEX_BUFFER, indices, sizeof(indices));
+    graphics.VertexAttribPointer(0, 3, false, 3 * sizeof(float), nullptr);
+    graphics.EnableVertexAttrib(0);
+    graphics.BindVertexArray(0);
+
+    unsigned int texture = graphics.CreateTexture();
+    graphics.BindTexture(texture, 0);
+    unsigned char pixels[4 * 4 * 3] = { 0 };
+    graphics.TexImage2D(4, 4, pixels, false);
+
+    // A cooked BC1 chain: one 8 byte block per level
+    unsigned int cooked = graphics.CreateTexture();
+    graphics.BindTexture(cooked, 1);
+    unsigned char blocks[16] = { 0 };
+    graphics.SetTextureLevels(2);
+    graphics.TexImageLevel(0, TextureFormat::BC1, 4, 4, blocks, 8);
+    graphics.TexImageLevel(1, TextureFormat::BC1, 2, 2, blocks + 8, 8);
+
+    for (int frame = 0; frame < frames; frame++) {
+        graphics.SetClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        graphics.Clear(true, true);
+        graphics.SetDepthTest(true);
+        graphics.UseProgram(program);
+        graphics.SetUniformMatrix4fv(model, identity);
+        graphics.SetUniform1f(intensity, 0.5f * frame);
+        graphics.SetUniform1i(program, "albedo", 0);
+        graphics.BindTexture(texture, 0);
+        graphics.BindVertexArray(vao);
+        for (int draw = 0; draw < 3; draw++) {
+            graphics.DrawElements(DrawMode::TRIANGLES, 3, nullptr);
+        }
+        graphics.BindVertexArray(0);
+        graphics.SwapBuffers();
+    }
+
+    graphics.DeleteTexture(cooked);
+    graphics.DeleteTexture(texture);
+    graphics.DeleteBuffer(ebo);
+    graphics.DeleteBuffer(vbo);
+    graphics.DeleteVertexArray(vao);
+    graphics.DeleteProgram(program);
+}
+
+static bool Contains(const std::vector<std::string>& names, const std::string& name) {
+    for (const std::string& entry : names) {
+        if (entry == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool SameStats(const NullGraphicsAPI::Stats& a, const NullGraphicsAPI::Stats& b) {
+    return a.calls == b.calls && a.drawCalls == b.drawCalls && a.vertices == b.vertices && a.instances == b.instances &&
+           a.bytesUploaded == b.bytesUploaded && a.stateChanges == b.stateChanges &&
+           a.redundantStateChanges == b.redundantStateChanges && a.uniformUpdates == b.uniformUpdates;
+}
+
+int main() {
+    std::cout << "Graphics Trace Test" << std::endl;
+    std::cout << "===================" << std::endl;
+
+    // Uniforms declared by the shader sources
+    {
+        NullGraphicsAPI graphics;
+        unsigned int program = BuildProgram(graphics);
+        Check(graphics.GetProgramLinkStatus(program), "Null program links");
+
+        std::vector<std::string> names;
+        std::vector<int> locations;
+        graphics.GetActiveUniforms(program, names, locations);
+        Check(Contains(names, "model") && Contains(names, "tint") && Contains(names, "albedo"),
+              "Plain uniforms are active");
+        Check(Contains(names, "offsets[1]"), "Array elements are active");
+        Check(!Contains(names, "commented"), "Commented uniforms are ignored");
+        Check(!Contains(names, "view"), "Block members are not plain uniforms");
+        Check(names.size() == locations.size(), "Every active uniform has a location");
+
+        Check(graphics.GetUniformLocation(program, "model") >= 0, "Declared uniform has a location");
+        Check(graphics.GetUniformLocation(program, "missing") == -1, "Undeclared uniform is -1");
+        int member = graphics.GetUniformLocation(program, "lights[2].color");
+        Check(member >= 0 && member == graphics.GetUniformLocation(program, "lights[2].color"),
+              "Struct members get a stable location");
+        Check(graphics.SetUniformBlockBinding(program, "CameraData", 0), "Declared block binds");
+        Check(!graphics.SetUniformBlockBinding(program, "Missing", 0), "Undeclared block does not bind");
+    }
+
+    // Counts of a frame
+    {
+        NullGraphicsAPI graphics;
+        graphics.CreateWindow(320, 240, "Null");
+        DrawFrames(graphics, 2);
+        const NullGraphicsAPI::Stats& frame = graphics.GetLastFrameStats();
+        Check(graphics.GetFrameCount() == 2, "SwapBuffers ends frames");
+        Check(frame.drawCalls == 3, "Frame draw calls counted");
+        Check(frame.vertices == 9, "Frame vertices counted");
+        Check(frame.uniformUpdates == 3, "Frame uniform updates counted");
+        // Clear color, depth test, program and texture are as the first frame left them
+        Check(frame.redundantStateChanges == 4, "Repeated state is counted as redundant");
+        Check(graphics.GetTotalStats().bytesUploaded >= 9 * sizeof(float) + 3 * sizeof(unsigned int) + 48 + 16,
+              "Uploads counted");
+
+        NullGraphicsAPI uploads;
+        uploads.TexImageLevel(0, TextureFormat::BC3, 4, 4, nullptr, 16);
+        Check(uploads.GetTotalStats().bytesUploaded == 16, "Texture levels count as uploads");
+
+        int viewport[4];
+        graphics.GetViewport(viewport);
+        Check(viewport[2] == 320 && viewport[3] == 240, "Window sets the viewport");
+    }
+
+    // Record onto one API and replay onto another
+    std::vector<uint8_t> trace;
+    NullGraphicsAPI::Stats recordedStats;
+    {
+        std::shared_ptr<NullGraphicsAPI> target = std::make_shared<NullGraphicsAPI>();
+        RecordingGraphicsAPI recorder(target);
+        DrawFrames(recorder, 3);
+        trace = recorder.GetTrace();
+        recordedStats = target->GetTotalStats();
+        Check(recorder.GetFrameCount() == 3, "Recorder counts frames");
+        Check(target->GetFrameCount() == 3, "Recorder forwards calls");
+        Check(recorder.GetCommandCount() > 0 && trace.size() > GraphicsTrace::HEADER_SIZE, "Trace has commands");
+    }
+    {
+        NullGraphicsAPI replayed;
+        // Used handles, so the trace's handles have to be mapped
+        replayed.CreateBuffer();
+        replayed.CreateBuffer();
+        GraphicsTrace::ReplayResult result;
+        bool ok = GraphicsTrace::Replay(trace, &replayed, result);
+        Check(ok && result.error.empty(), "Trace replays");
+        Check(result.frames == 3 && result.frameMilliseconds.size() == 3, "Replay times every frame");
+        Check(replayed.GetLastFrameStats().drawCalls == 3 && replayed.GetLastFrameStats().uniformUpdates == 3,
+              "Replayed program and uniform handles are mapped");
+        Check(replayed.GetLastFrameStats().redundantStateChanges == 4,
+              "Replayed state matches the recorded frame");
+        NullGraphicsAPI::Stats replayedStats = replayed.GetTotalStats();
+        Check(replayedStats.drawCalls == recordedStats.drawCalls &&
+              replayedStats.bytesUploaded == recordedStats.bytesUploaded,
+              "Replay issues the recorded work");
+    }
+    {
+        // Same API, so the counts agree to the call
+        NullGraphicsAPI fresh;
+        GraphicsTrace::ReplayResult result;
+        GraphicsTrace::Replay(trace, &fresh, result);
+        Check(SameStats(fresh.GetTotalStats(), recordedStats), "Replay on a fresh API counts the same");
+    }
+
+    // Instanced draws
+    {
+        std::shared_ptr<NullGraphicsAPI> target = std::make_shared<NullGraphicsAPI>();
+        RecordingGraphicsAPI recorder(target);
+        Check(recorder.SupportsInstancing(), "Null API supports instancing");
+        const float matrices[2 * 16] = { 0 };
+        unsigned int vao = recorder.CreateVertexArray();
+        recorder.BindVertexArray(vao);
+        unsigned int instances = recorder.CreateBuffer();
+        recorder.BindBuffer(BufferType::VERTEX_BUFFER, instances);
+        recorder.BufferData(BufferType::VERTEX_BUFFER, matrices, sizeof(matrices), true);
+        for (unsigned int column = 0; column < 4; column++) {
+            recorder.VertexAttribPointer(3 + column, 4, false, 16 * sizeof(float),
+                                         reinterpret_cast<const void*>(column * 4 * sizeof(float)));
+            recorder.EnableVertexAttrib(3 + column);
+            recorder.VertexAttribDivisor(3 + column, 1);
+        }
+        recorder.DrawElementsInstanced(DrawMode::TRIANGLES, 36, IndexType::UNSIGNED_SHORT, nullptr, 2);
+        recorder.DrawArraysInstanced(DrawMode::TRIANGLES, 0, 3, 5);
+        recorder.SwapBuffers();
+        Check(target->GetLastFrameStats().drawCalls == 2 && target->GetLastFrameStats().instances == 7 &&
+              target->GetLastFrameStats().vertices == 36 * 2 + 3 * 5, "Instanced draws count every copy");
+
+        NullGraphicsAPI replayed;
+        GraphicsTrace::ReplayResult result;
+        Check(GraphicsTrace::Replay(recorder.GetTrace(), &replayed, result) &&
+              SameStats(replayed.GetTotalStats(), target->GetTotalStats()), "Instanced draws replay");
+    }
+
+    // Damaged traces
+    {
+        NullGraphicsAPI graphics;
+        GraphicsTrace::ReplayResult result;
+        std::vector<uint8_t> truncated(trace.begin(), trace.begin() + trace.size() / 2);
+        Check(!GraphicsTrace::Replay(truncated, &graphics, result) && !result.error.empty(),
+              "Truncated trace is an error");
+
+        std::vector<uint8_t> badMagic = trace;
+        badMagic[0] = 'X';
+        result = GraphicsTrace::ReplayResult();
+        Check(!GraphicsTrace::Replay(badMagic, &graphics, result) && result.commands == 0,
+              "Trace without the header is rejected");
+
+        std::vector<uint8_t> badCommand = trace;
+        badCommand[GraphicsTrace::HEADER_SIZE] = 0xFF;
+        result = GraphicsTrace::ReplayResult();
+        Check(!GraphicsTrace::Replay(badCommand, &graphics, result), "Unknown command is an error");
+    }
+
+    // Streamed to a file
+    {
+        const std::string path = "graphics_trace_test.sgtr";
+        {
+            std::shared_ptr<NullGraphicsAPI> target = std::make_shared<NullGraphicsAPI>();
+            RecordingGraphicsAPI recorder(target, path);
+            DrawFrames(recorder, 3);
+            recorder.Shutdown();
+        }
+        std::vector<uint8_t> loaded;
+        Check(GraphicsTrace::Load(path, loaded), "Trace file loads");
+        Check(loaded == trace, "Streamed trace matches the one kept in memory");
+        std::remove(path.c_str());
+
+        Check(!GraphicsTrace::Load("missing_trace.sgtr", loaded), "Missing trace file fails");
+    }
+
+    return TestSummary();
+}
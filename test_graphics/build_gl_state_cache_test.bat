@@ -0,0 +1,18 @@
+@echo off
+echo Building GL state cache test program...
+
+REM Build GL state cache test
+REM The cache is tested through a mock function table, so no GL or window is needed
+g++ -std=c++14 -I.. ^
+    GLStateCacheTest.cpp ^
+    ..\Graphics\Core\GLStateCache.cpp ^
+    -o gl_state_cache_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run gl_state_cache_test.exe to test the GL state cache.
+pause
@@ -0,0 +1,19 @@
+#!/bin/bash
+
+# Build GL state cache test
+# The cache is tested through a mock function table, so no GL or window is needed
+echo "Building GL state cache test program..."
+g++ -std=c++14 -I.. \
+    GLStateCacheTest.cpp \
+    ../Graphics/Core/GLStateCache.cpp \
+    -o gl_state_cache_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x gl_state_cache_test
+
+echo "Build complete. Run ./gl_state_cache_test to test the GL state cache."
@@ -0,0 +1,22 @@
+@echo off
+echo Building graphics trace test program...
+
+REM Build graphics trace test
+REM Traces are recorded onto and replayed on the null graphics API, so no GL or window is needed
+g++ -std=c++14 -I.. ^
+    GraphicsTraceTest.cpp ^
+    ..\Graphics\Core\GraphicsTrace.cpp ^
+    ..\Graphics\Core\NullGraphicsAPI.cpp ^
+    ..\Graphics\Core\RecordingGraphicsAPI.cpp ^
+    ..\Matrix4x4.cpp ^
+    ..\Vector3.cpp ^
+    -o graphics_trace_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run graphics_trace_test.exe to test graphics traces.
+pause
@@ -0,0 +1,23 @@
+#!/bin/bash
+
+# Build graphics trace test
+# Traces are recorded onto and replayed on the null graphics API, so no GL or window is needed
+echo "Building graphics trace test program..."
+g++ -std=c++14 -I.. \
+    GraphicsTraceTest.cpp \
+    ../Graphics/Core/GraphicsTrace.cpp \
+    ../Graphics/Core/NullGraphicsAPI.cpp \
+    ../Graphics/Core/RecordingGraphicsAPI.cpp \
+    ../Matrix4x4.cpp \
+    ../Vector3.cpp \
+    -o graphics_trace_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x graphics_trace_test
+
+echo "Build complete. Run ./graphics_trace_test to test graphics traces."
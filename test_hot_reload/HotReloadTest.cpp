@@ -0,0 +1,273 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <sys/stat.h>
+#include "../AssetManager.h"
+#include "../AssetHotReload.h"
+#include "../FileWatcher.h"
+#include "../test_common/TestCheck.h"
+
+#if defined(_WIN32)
+#include <direct.h>
+#define MakeFolder(path) _mkdir(path)
+#define RemoveFolder(path) _rmdir(path)
+#else
+#include <unistd.h>
+#define MakeFolder(path) mkdir(path, 0755)
+#define RemoveFolder(path) rmdir(path)
+#endif
+
+// Tests for the file watcher and reloading assets in place
+// Build with build_hot_reload_test.sh
+
+// Asset holding the text of its file, and of the file named by its "other"
+// setting if there is one
+struct TextAsset {
+    std::string text;
+};
+
+// Same, but its loader cannot reload
+struct FixedAsset {
+    std::string text;
+};
+
+static std::string ReadText(const std::string& path) {
+    std::ifstream file(path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+static void WriteText(const std::string& path, const std::string& text) {
+    std::ofstream file(path);
+    file << text;
+}
+
+static bool Contains(const std::vector<std::string>& files, const std::string& file) {
+    return std::find(files.begin(), files.end(), file) != files.end();
+}
+
+template <>
+struct AssetLoader<TextAsset> {
+    static TextAsset* Load(const std::string& path, const std::string& settings) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            return nullptr;
+        }
+        std::string text = ReadText(path);
+        if (text == "broken") {
+            return nullptr;
+        }
+        std::string other = AssetManager::GetSetting(settings, "other");
+        if (!other.empty()) {
+            text += "+" + ReadText(other);
+        }
+        TextAsset* asset = new TextAsset();
+        asset->text = text;
+        return asset;
+    }
+
+    static bool Reload(TextAsset* asset, const std::string& path, const std::string& settings) {
+        TextAsset* fresh = Load(path, settings);
+        if (!fresh) {
+            return false;
+        }
+        asset->text = fresh->text;
+        delete fresh;
+        return true;
+    }
+
+    static void Unload(TextAsset* asset) {
+        delete asset;
+    }
+};
+
+template <>
+struct AssetLoader<FixedAsset> {
+    static FixedAsset* Load(const std::string& path, const std::string& settings) {
+        (void)settings;
+        FixedAsset* asset = new FixedAsset();
+        asset->text = ReadText(path);
+        return asset;
+    }
+
+    static void Unload(FixedAsset* asset) {
+        delete asset;
+    }
+};
+
+// Poll until a file shows up or a second passes
+static bool WaitFor(FileWatcher& watcher, const std::string& file, std::vector<std::string>& changed) {
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        std::vector<std::string> batch;
+        watcher.Poll(batch);
+        changed.insert(changed.end(), batch.begin(), batch.end());
+        if (Contains(changed, file)) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+int main() {
+    std::cout << "=== Hot Reload Tests ===" << std::endl;
+
+    MakeFolder("temp_hot_reload");
+    MakeFolder("temp_hot_reload/Shaders");
+    WriteText("temp_hot_reload/crate.txt", "wood");
+    WriteText("temp_hot_reload/Shaders/lit.vert", "vertex");
+    WriteText("temp_hot_reload/Shaders/lit.frag", "red");
+
+    AssetManager& assets = AssetManager::GetInstance();
+
+    // Reloading in place
+    {
+        AssetHandle<TextAsset> crate = assets.Load<TextAsset>("temp_hot_reload/crate.txt");
+        AssetHandle<TextAsset> copy = crate;
+        TextAsset* before = crate.Get();
+        Check(crate && crate->text == "wood" && crate.GetVersion() == 0, "Asset loads at version 0");
+
+        WriteText("temp_hot_reload/crate.txt", "metal");
+        size_t reloaded = assets.Reload("./temp_hot_reload//crate.txt");
+        Check(reloaded == 1 && crate.Get() == before && crate->text == "metal",
+              "Reload loads the file again into the same object");
+        Check(crate.GetVersion() == 1 && copy.GetVersion() == 1 && copy->text == "metal",
+              "Every handle sees the new version");
+
+        WriteText("temp_hot_reload/crate.txt", "broken");
+        Check(assets.Reload("temp_hot_reload/crate.txt") == 0 && crate->text == "metal" && crate.GetVersion() == 1,
+              "A file that fails to load keeps the previous version");
+
+        Check(assets.Reload("temp_hot_reload/other.txt") == 0, "Files nothing loaded reload nothing");
+        WriteText("temp_hot_reload/crate.txt", "wood");
+    }
+
+    // Assets naming the file in their settings
+    {
+        AssetHandle<TextAsset> program =
+            assets.Load<TextAsset>("temp_hot_reload/Shaders/lit.vert", "other=temp_hot_reload/Shaders/lit.frag");
+        Check(program && program->text == "vertex+red", "Program loads both stages");
+
+        WriteText("temp_hot_reload/Shaders/lit.frag", "blue");
+        Check(assets.Reload("temp_hot_reload/Shaders/lit.frag") == 1 && program->text == "vertex+blue",
+              "Changing a file named in the settings reloads the asset");
+    }
+
+    // Loaders without Reload
+    {
+        AssetHandle<FixedAsset> fixed = assets.Load<FixedAsset>("temp_hot_reload/crate.txt");
+        WriteText("temp_hot_reload/crate.txt", "stone");
+        Check(assets.Reload("temp_hot_reload/crate.txt") == 0 && fixed->text == "wood",
+              "Assets whose loader has no Reload are left alone");
+    }
+
+    // Watching folders
+    {
+        FileWatcher watcher;
+        watcher.SetSettleTime(0.0f);
+        watcher.SetScanInterval(0.0f);
+        Check(watcher.AddFolder("temp_hot_reload"), "Folder is watched");
+        Check(!watcher.AddFolder("temp_hot_reload/missing"), "Missing folders cannot be watched");
+#if defined(__linux__)
+        Check(watcher.IsNative(), "Linux uses inotify");
+#endif
+
+        std::vector<std::string> changed;
+        watcher.Poll(changed);
+        Check(changed.empty(), "Nothing is reported before anything changes");
+
+        // Scans compare modification times, which may be coarse
+        if (!watcher.IsNative()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        }
+
+        changed.clear();
+        WriteText("temp_hot_reload/crate.txt", "glass");
+        Check(WaitFor(watcher, "temp_hot_reload/crate.txt", changed), "Written file is reported");
+
+        changed.clear();
+        WriteText("temp_hot_reload/Shaders/lit.frag", "green");
+        Check(WaitFor(watcher, "temp_hot_reload/Shaders/lit.frag", changed), "Files in subfolders are reported");
+
+        changed.clear();
+        MakeFolder("temp_hot_reload/Props");
+        WriteText("temp_hot_reload/Props/barrel.txt", "oak");
+        Check(WaitFor(watcher, "temp_hot_reload/Props/barrel.txt", changed), "Folders created later are watched");
+
+        // Editors often save to a temporary file and rename it over the original
+        changed.clear();
+        WriteText("temp_hot_reload/crate.txt.saving", "steel");
+        std::remove("temp_hot_reload/crate.txt");
+        std::rename("temp_hot_reload/crate.txt.saving", "temp_hot_reload/crate.txt");
+        Check(WaitFor(watcher, "temp_hot_reload/crate.txt", changed), "File renamed into place is reported");
+
+        // Settling
+        watcher.SetSettleTime(0.2f);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        changed.clear();
+        watcher.Poll(changed);
+        WriteText("temp_hot_reload/crate.txt", "iron");
+        std::vector<std::string> early;
+        watcher.Poll(early);
+        Check(!Contains(early, "temp_hot_reload/crate.txt"), "A file is not reported while it may still be written");
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        changed.clear();
+        Check(WaitFor(watcher, "temp_hot_reload/crate.txt", changed) &&
+              std::count(changed.begin(), changed.end(), "temp_hot_reload/crate.txt") == 1,
+              "It is reported once it settles");
+    }
+
+    // End to end
+    {
+        AssetHotReload::GetInstance().GetWatcher().SetSettleTime(0.0f);
+        AssetHotReload::GetInstance().GetWatcher().SetScanInterval(0.0f);
+        Check(!AssetHotReload::GetInstance().Start(std::vector<std::string>{ "temp_hot_reload/missing" }),
+              "Starting without any watchable folder fails");
+        Check(AssetHotReload::GetInstance().Start(std::vector<std::string>{ "temp_hot_reload" }) &&
+              AssetHotReload::GetInstance().IsRunning(), "Hot reload starts");
+
+        AssetHandle<TextAsset> crate = assets.Load<TextAsset>("temp_hot_reload/crate.txt");
+        if (!AssetHotReload::GetInstance().GetWatcher().IsNative()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+        }
+        WriteText("temp_hot_reload/crate.txt", "gold");
+        WriteText("temp_hot_reload/crate.txt.savmesh", "cooked");
+
+        size_t reloaded = 0;
+        for (int attempt = 0; attempt < 100 && reloaded == 0; ++attempt) {
+            reloaded = AssetHotReload::GetInstance().Update();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        Check(reloaded == 1 && crate->text == "gold" && crate.GetVersion() == 1,
+              "Saving a loaded file reloads it without reloading anything else");
+        Check(AssetHotReload::GetInstance().GetReloadCount() == 1, "Reloads are counted");
+
+        AssetHotReload::GetInstance().Stop();
+        Check(!AssetHotReload::GetInstance().IsRunning() && AssetHotReload::GetInstance().Update() == 0,
+              "Stopped hot reload does nothing");
+    }
+
+    Check(AssetHotReload::IsIgnored("Models/crate.obj.savmesh") && AssetHotReload::IsIgnored("bark.png.bc5.savtex") &&
+          AssetHotReload::IsIgnored("Shaders/lit.frag.savshader") &&
+          AssetHotReload::IsIgnored("Shaders/.#lit.frag") && AssetHotReload::IsIgnored("Shaders/lit.frag~") &&
+          AssetHotReload::IsIgnored("Shaders/.lit.frag.swp") && !AssetHotReload::IsIgnored("Shaders/lit.frag"),
+          "Cooked and editor temporary files are ignored");
+
+    std::remove("temp_hot_reload/crate.txt");
+    std::remove("temp_hot_reload/crate.txt.savmesh");
+    std::remove("temp_hot_reload/Props/barrel.txt");
+    std::remove("temp_hot_reload/Shaders/lit.vert");
+    std::remove("temp_hot_reload/Shaders/lit.frag");
+    RemoveFolder("temp_hot_reload/Props");
+    RemoveFolder("temp_hot_reload/Shaders");
+    RemoveFolder("temp_hot_reload");
+
+    return TestSummary();
+}
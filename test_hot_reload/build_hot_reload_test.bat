@@ -0,0 +1,21 @@
+@echo off
+echo Building hot reload test program...
+
+REM Build hot reload test
+g++ -std=c++14 -O2 -I.. ^
+    HotReloadTest.cpp ^
+    ..\AssetHotReload.cpp ^
+    ..\FileWatcher.cpp ^
+    ..\AssetManager.cpp ^
+    ..\Shaders\Core\ShaderPreprocessor.cpp ^
+    ..\Shaders\Core\ShaderSourceCache.cpp ^
+    -o hot_reload_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run hot_reload_test.exe from this folder to test hot reloading.
+pause
@@ -0,0 +1,22 @@
+#!/bin/bash
+
+# Build hot reload test
+echo "Building hot reload test program..."
+g++ -std=c++14 -O2 -I.. \
+    HotReloadTest.cpp \
+    ../AssetHotReload.cpp \
+    ../FileWatcher.cpp \
+    ../AssetManager.cpp \
+    ../Shaders/Core/ShaderPreprocessor.cpp \
+    ../Shaders/Core/ShaderSourceCache.cpp \
+    -pthread -o hot_reload_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x hot_reload_test
+
+echo "Build complete. Run ./hot_reload_test from this folder to test hot reloading."
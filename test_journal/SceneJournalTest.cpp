@@ -0,0 +1,207 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include "../SceneJournal.h"
+#include "../SceneSerializer.h"
+#include "../GameObject.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for dirty tracking and journaled scene saves
+// Build with build_scene_journal_test.sh
+
+static bool SameObject(const GameObject* a, const GameObject* b) {
+    if (a->GetName() != b->GetName() || a->IsEnabled() != b->IsEnabled() ||
+        a->GetPersistentId() != b->GetPersistentId() || a->GetPosition() != b->GetPosition() ||
+        a->GetRotation() != b->GetRotation() || a->GetScale() != b->GetScale() ||
+        a->lights.size() != b->lights.size() || a->childGameObjects.size() != b->childGameObjects.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a->lights.size(); i++) {
+        if (a->lights[i].GetPosition() != b->lights[i].GetPosition() ||
+            a->lights[i].GetColor() != b->lights[i].GetColor() ||
+            a->lights[i].GetIntensity() != b->lights[i].GetIntensity() ||
+            a->lights[i].GetRange() != b->lights[i].GetRange()) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < a->childGameObjects.size(); i++) {
+        if (!SameObject(a->childGameObjects[i], b->childGameObjects[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool SameScene(const std::vector<GameObject*>& a, const std::vector<GameObject*>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (!SameObject(a[i], b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Loads the journaled scene from disk and compares it with the one in memory
+static bool ReloadsAs(const std::vector<GameObject*>& expected) {
+    SceneJournal journal("journal_test.json");
+    std::vector<GameObject*> loaded;
+    bool same = journal.Load(loaded) && SameScene(expected, loaded);
+    SceneSerializer::DestroySceneObjects(loaded);
+    return same;
+}
+
+static void RemoveFiles() {
+    std::remove("journal_test.json");
+    std::remove("journal_test.json.journal");
+    std::remove("journal_test.json.tmp");
+}
+
+int main() {
+    std::cout << "Scene Journal Test" << std::endl;
+    std::cout << "==================" << std::endl;
+    RemoveFiles();
+
+    // Dirty flags follow the setters
+    {
+        GameObject object("Crate");
+        Check(object.GetDirtyFlags() == GameObject::DIRTY_ALL, "New objects are dirty");
+        object.ClearDirty();
+        object.SetPosition(Vector3(1, 0, 0));
+        Check(object.GetDirtyFlags() == GameObject::DIRTY_TRANSFORM, "SetPosition marks the transform");
+        object.ClearDirty();
+        object.AddLight(PointLight());
+        Check(object.GetDirtyFlags() == GameObject::DIRTY_COMPONENTS, "AddLight marks the components");
+        object.ClearDirty();
+        GameObject child("Child");
+        object.AddChild(&child);
+        object.RemoveChild(&child);
+        Check(object.GetDirtyFlags() == GameObject::DIRTY_HIERARCHY, "AddChild/RemoveChild mark the hierarchy");
+        object.ClearDirty();
+        object.SetEnabled(true);
+        Check(!object.IsDirty(), "Setting an unchanged enabled flag keeps the object clean");
+        object.SetName("Box");
+        Check(object.GetDirtyFlags() == GameObject::DIRTY_PROPERTIES, "SetName marks the properties");
+    }
+
+    std::vector<GameObject*> scene;
+    for (int i = 0; i < 10; i++) {
+        scene.push_back(new GameObject("Object" + std::to_string(i), Vector3(i, 0, 0)));
+    }
+    GameObject* lamp = new GameObject("Lamp", Vector3(0, 3, 0));
+    PointLight light;
+    light.SetPosition(lamp->GetPosition());
+    light.SetColor(Vector3(1, 0.5f, 0.25f));
+    light.SetRange(7);
+    lamp->AddLight(light);
+    scene[0]->AddChild(lamp);
+
+    SceneJournal journal("journal_test.json");
+
+    // The first save is a full snapshot
+    Check(journal.Save(scene) && journal.GetJournalEntryCount() == 0 && journal.GetLastSavedObjectCount() == 11,
+          "First save writes a snapshot");
+    Check(!scene[3]->IsDirty() && scene[3]->GetPersistentId() != 0, "Saved objects are clean and have ids");
+    Check(ReloadsAs(scene), "Snapshot reloads");
+
+    // Only changed objects go to the journal
+    scene[3]->SetPosition(Vector3(3, 5, 0));
+    Check(journal.Save(scene) && journal.GetJournalEntryCount() == 1 && journal.GetLastSavedObjectCount() == 1,
+          "Moving one object appends one record");
+    Check(journal.Save(scene) && journal.GetJournalEntryCount() == 1 && journal.GetLastSavedObjectCount() == 0,
+          "Saving an unchanged scene appends nothing");
+    Check(ReloadsAs(scene), "Journaled move reloads");
+
+    // Hierarchy, component and property changes
+    GameObject* spark = new GameObject("Spark", Vector3(0, 1, 0));
+    lamp->AddChild(spark);
+    lamp->lights[0].SetIntensity(4);
+    lamp->MarkDirty(GameObject::DIRTY_COMPONENTS);
+    scene[5]->SetName("Renamed");
+    scene[6]->SetEnabled(false);
+    std::vector<GameObject*> removed(1, scene[9]);
+    scene.pop_back();
+    SceneSerializer::DestroySceneObjects(removed);
+    scene.push_back(new GameObject("Spawned", Vector3(0, 0, 9)));
+    Check(journal.Save(scene) && journal.GetJournalEntryCount() == 2 && journal.GetLastSavedObjectCount() == 5,
+          "Edits append the changed and new objects");
+    Check(ReloadsAs(scene), "Added, removed, renamed and disabled objects reload");
+
+    // Reparenting
+    lamp->RemoveChild(spark);
+    scene[1]->AddChild(spark);
+    std::swap(scene[1], scene[2]);
+    Check(journal.Save(scene) && ReloadsAs(scene), "Reparenting and reordering reload");
+
+    // A torn last line is ignored and the next save rewrites the files
+    scene[4]->SetPosition(Vector3(4, 4, 4));
+    journal.Save(scene);
+    {
+        std::ofstream file("journal_test.json.journal", std::ios::app | std::ios::binary);
+        file << "{\"objects\":[{\"id\":1,\"posi";
+    }
+    {
+        SceneJournal reloaded("journal_test.json");
+        std::vector<GameObject*> loaded;
+        Check(reloaded.Load(loaded) && SameScene(scene, loaded), "Torn journal entry is ignored");
+        loaded[0]->SetPosition(Vector3(-1, 0, 0));
+        Check(reloaded.Save(loaded) && reloaded.GetJournalEntryCount() == 0, "Save after a torn journal compacts");
+        SceneSerializer::DestroySceneObjects(loaded);
+    }
+
+    // Periodic compaction
+    {
+        SceneJournal compacting("journal_test.json");
+        std::vector<GameObject*> loaded;
+        compacting.Load(loaded);
+        compacting.SetCompactionLimit(2);
+        for (int i = 0; i < 3; i++) {
+            loaded[0]->SetPosition(Vector3(static_cast<float>(i), 0, 0));
+            compacting.Save(loaded);
+        }
+        Check(compacting.GetJournalEntryCount() == 0, "Journal is compacted after the limit");
+        Check(ReloadsAs(loaded), "Compacted snapshot reloads");
+
+        // A journal from before the compaction is not replayed onto it
+        std::ofstream file("journal_test.json.journal", std::ios::trunc | std::ios::binary);
+        file << "{\"journalGeneration\":1}\n{\"objects\":[{\"id\":1,\"name\":\"Stale\"}]}\n";
+        file.close();
+        Check(ReloadsAs(loaded), "Stale journal is ignored");
+        SceneSerializer::DestroySceneObjects(loaded);
+    }
+
+    SceneSerializer::DestroySceneObjects(scene);
+    RemoveFiles();
+
+    // Large scene: a small edit costs a small save
+    {
+        std::vector<GameObject*> big;
+        for (int i = 0; i < 50000; i++) {
+            big.push_back(new GameObject("Object" + std::to_string(i), Vector3(i * 0.5f, 0, 0)));
+        }
+        SceneJournal bigJournal("journal_test.json");
+
+        auto start = std::chrono::steady_clock::now();
+        bigJournal.Save(big);
+        double fullMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        for (int i = 0; i < 10; i++) {
+            big[i * 5000]->SetPosition(Vector3(0, 1, 0));
+        }
+        start = std::chrono::steady_clock::now();
+        bool ok = bigJournal.Save(big);
+        double deltaMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "50000 objects: full save " << fullMs << " ms, delta save of 10 objects " << deltaMs << " ms" << std::endl;
+        Check(ok && bigJournal.GetLastSavedObjectCount() == 10 && ReloadsAs(big), "Large scene delta save");
+        SceneSerializer::DestroySceneObjects(big);
+    }
+    RemoveFiles();
+
+    return TestSummary();
+}
@@ -0,0 +1,49 @@
+@echo off
+echo Building scene journal test program...
+
+REM Build scene journal test
+g++ -std=c++14 -I.. ^
+    SceneJournalTest.cpp ^
+    ..\BinaryScene.cpp ^
+    ..\SceneSerializer.cpp ^
+    ..\SceneJournal.cpp ^
+    ..\GameObject.cpp ^
+    ..\Coroutine.cpp ^
+    ..\TimerWheel.cpp ^
+    ..\Vector3.cpp ^
+    ..\Matrix4x4.cpp ^
+    ..\Model.cpp ^
+    ..\ObjLoader.cpp ^
+    ..\MeshCache.cpp ^
+    ..\MeshOptimizer.cpp ^
+    ..\MeshSimplifier.cpp ^
+    ..\AssetManager.cpp ^
+    ..\AssetStreamer.cpp ^
+    ..\JobSystem.cpp ^
+    ..\Texture.cpp ^
+    ..\TextureCache.cpp ^
+    ..\TextureAtlas.cpp ^
+    ..\Debugger.cpp ^
+    ..\MappedFile.cpp ^
+    ..\Shaders\Core\Shader.cpp ^
+    ..\Shaders\Core\ShaderPreprocessor.cpp ^
+    ..\Shaders\Core\ShaderSourceCache.cpp ^
+    ..\Shaders\Core\ShaderProgram.cpp ^
+    ..\Shaders\Core\ShaderUniforms.cpp ^
+    ..\Shaders\Core\ShaderError.cpp ^
+    ..\Graphics\Core\GraphicsAPIFactory.cpp ^
+    ..\Graphics\Core\NullGraphicsAPI.cpp ^
+    ..\Graphics\Core\RecordingGraphicsAPI.cpp ^
+    ..\Graphics\Core\GraphicsTrace.cpp ^
+    ..\Graphics\Core\OpenGLGraphicsAPI.cpp ^
+    ..\Graphics\Core\GLStateCache.cpp ^
+    -lopengl32 -lglew32 -o scene_journal_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run scene_journal_test.exe to test journaled scene saves.
+pause
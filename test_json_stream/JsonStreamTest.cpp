@@ -0,0 +1,220 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <atomic>
+#include "../SceneSerializer.h"
+#include "../BinaryScene.h"
+#include "../JsonStreamReader.h"
+#include "../GameObject.h"
+#include "../ProjectSettings/ProjectSettings.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the streaming JSON readers used by SceneSerializer and ProjectSettings
+// Build with build_json_stream_test.sh
+
+static void WriteText(const std::string& path, const std::string& text) {
+    std::ofstream file(path);
+    file << text;
+}
+
+static bool SameObject(const GameObject* a, const GameObject* b) {
+    if (a->GetName() != b->GetName() || a->GetPosition() != b->GetPosition() ||
+        a->GetRotation() != b->GetRotation() || a->GetScale() != b->GetScale() ||
+        a->lights.size() != b->lights.size() || a->childGameObjects.size() != b->childGameObjects.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a->lights.size(); i++) {
+        if (a->lights[i].GetPosition() != b->lights[i].GetPosition() ||
+            a->lights[i].GetColor() != b->lights[i].GetColor() ||
+            a->lights[i].GetIntensity() != b->lights[i].GetIntensity() ||
+            a->lights[i].GetRange() != b->lights[i].GetRange()) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < a->childGameObjects.size(); i++) {
+        if (!SameObject(a->childGameObjects[i], b->childGameObjects[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Records how much of the input was read as each top-level object ends
+class ProgressReader : public JsonStreamReader {
+public:
+    std::vector<float> samples;
+
+protected:
+    bool OnEndObject() override {
+        if (Depth() == 1) {
+            samples.push_back(Progress());
+        }
+        return true;
+    }
+};
+
+// The streamed JSON scene matches the binary scene built from the same file
+static bool MatchesBinary(const std::string& path) {
+    std::vector<GameObject*> fromJson;
+    std::vector<GameObject*> fromBinary;
+    bool ok = BinaryScene::ConvertJsonToBinary(path, "json_stream_test.savscene") &&
+              SceneSerializer::LoadSceneFromJson(path, fromJson) &&
+              SceneSerializer::LoadSceneFile("json_stream_test.savscene", fromBinary) &&
+              fromJson.size() == fromBinary.size() && !fromJson.empty();
+    for (size_t i = 0; ok && i < fromJson.size(); i++) {
+        ok = SameObject(fromJson[i], fromBinary[i]);
+    }
+    SceneSerializer::DestroySceneObjects(fromJson);
+    SceneSerializer::DestroySceneObjects(fromBinary);
+    return ok;
+}
+
+int main() {
+    std::cout << "JSON Stream Test" << std::endl;
+    std::cout << "================" << std::endl;
+
+    // Example scenes
+    Check(MatchesBinary("../Examples/RPG/Scenes/main_world.json"), "main_world.json streams to the same objects");
+    Check(MatchesBinary("../Examples/RPG/Scenes/cave.json"), "cave.json streams to the same objects");
+
+    // Nested children, unknown members and components before the transform
+    WriteText("json_stream_level.json", R"({
+        "sceneName": "Level",
+        "environment": { "objects": [ { "name": "NotAnObject" } ] },
+        "objects": [
+            { "name": "Root", "tag": { "name": "ignored", "position": {"x": 9} }, "children": [
+                { "name": "Child", "rotation": {"x": 0, "y": 45, "z": 0}, "children": [ { "name": "Leaf" } ] },
+                { "components": [
+                    { "type": "Light", "properties": { "color": {"r": 0.3, "g": 0.6, "b": 0.9}, "intensity": 2, "range": 5,
+                                                       "extra": { "range": 99 } } },
+                    { "type": "Light", "properties": { "type": "spot" } },
+                    { "type": "Marker", "properties": { "id": 7, "children": [ { "name": "Nope" } ] } } ],
+                  "name": "Lamp", "position": {"x": 1, "y": 2, "z": 3} } ],
+              "position": {"x": 0.5, "y": -2.5, "z": 3} },
+            { "scale": {"x": 2, "y": 1, "z": 0.5} }
+        ]
+    })");
+    Check(MatchesBinary("json_stream_level.json"), "Hierarchy and components stream to the same objects");
+    {
+        std::vector<GameObject*> objects;
+        SceneSerializer::LoadSceneFromJson("json_stream_level.json", objects);
+        bool shaped = objects.size() == 2 && objects[0]->childGameObjects.size() == 2 &&
+                      objects[0]->childGameObjects[0]->childGameObjects.size() == 1 &&
+                      objects[1]->GetName() == "GameObject" && objects[1]->GetScale() == Vector3(2, 1, 0.5f);
+        Check(shaped, "Objects are attached to the right parents");
+        if (shaped) {
+            const GameObject* lamp = objects[0]->childGameObjects[1];
+            Check(lamp->GetName() == "Lamp" && lamp->lights.size() == 1 &&
+                  lamp->lights[0].GetPosition() == Vector3(1, 2, 3) && lamp->lights[0].GetRange() == 5.0f,
+                  "Lights use the object's final position");
+            Check(objects[0]->GetPosition() == Vector3(0.5f, -2.5f, 3), "Members of unknown keys are ignored");
+        }
+        SceneSerializer::DestroySceneObjects(objects);
+    }
+
+    // Broken files fail without handing out partial objects
+    {
+        WriteText("json_stream_broken.json", R"({ "objects": [ { "name": "A", "children": [ { "name": "B", )");
+        std::vector<GameObject*> objects;
+        Check(!SceneSerializer::LoadSceneFromJson("json_stream_broken.json", objects) && objects.empty(),
+              "Truncated scene is rejected");
+
+        WriteText("json_stream_broken.json", R"({ "sceneName": "Empty" })");
+        Check(!SceneSerializer::LoadSceneFromJson("json_stream_broken.json", objects) && objects.empty(),
+              "Scene without an objects array is rejected");
+        Check(!SceneSerializer::LoadSceneFromJson("json_stream_missing.json", objects), "Missing file is rejected");
+    }
+
+    // Object persistence format
+    {
+        GameObject player("Player", Vector3(1, 2, 3), Vector3(0, 90, 0), Vector3(2, 2, 2));
+        PointLight light;
+        light.SetPosition(Vector3(4, 5, 6));
+        light.SetColor(Vector3(1, 0.5f, 0.25f));
+        light.SetIntensity(3);
+        light.SetRange(12);
+        player.AddLight(light);
+        SceneSerializer::SaveObjectToJson(&player, "json_stream_object.json");
+
+        GameObject* loaded = SceneSerializer::LoadObjectFromJson("json_stream_object.json");
+        Check(loaded && SameObject(&player, loaded), "Saved object loads back unchanged");
+        delete loaded;
+
+        loaded = SceneSerializer::LoadObjectFromJson("json_stream_broken.json");
+        Check(loaded && loaded->GetName() == "GameObject", "Object file with defaults loads");
+        delete loaded;
+        WriteText("json_stream_broken.json", R"({ "name": "Player", "position": {"x": 1)");
+        Check(SceneSerializer::LoadObjectFromJson("json_stream_broken.json") == nullptr, "Truncated object is rejected");
+    }
+
+    // Project settings
+    {
+        ProjectSettings& settings = ProjectSettings::GetInstance();
+        WriteText("json_stream_project.json", R"({
+            "projectName": "Streamed",
+            "buildSettings": { "targetPlatforms": ["Linux"], "optimization": true },
+            "engineSettings": { "physics": { "gravity": -3.5 }, "rendering": { "targetFPS": 144 } },
+            "assetPaths": { "models": "Content/Models", "levels": "Content/Levels" }
+        })");
+        Check(settings.LoadFromFile("json_stream_project.json"), "Project settings load");
+        Check(settings.GetProjectName() == "Streamed" && settings.GetGravity() == -3.5f &&
+              settings.GetTargetFPS() == 144 && settings.GetOptimization() &&
+              settings.GetTargetPlatforms() == std::vector<std::string>{"Linux"} &&
+              settings.GetAssetPath("models") == "Content/Models" && settings.GetAssetPath("levels") == "Content/Levels",
+              "Values are read from their paths");
+        Check(settings.GetEngineVersion() == "1.0.0" && settings.GetMSAA() == 4 &&
+              settings.GetAssetPath("textures") == "Assets/Textures", "Missing keys keep their values");
+
+        WriteText("json_stream_project.json", R"({ "projectName": "Broken", "engineSettings": { "physics": { "gravity": )");
+        Check(!settings.LoadFromFile("json_stream_project.json") && settings.GetProjectName() == "Streamed" &&
+              settings.GetGravity() == -3.5f, "Broken settings file leaves the settings untouched");
+    }
+
+    // Progress follows the bytes read
+    {
+        std::istringstream input("[{\"a\":1},{\"a\":2},{\"a\":3},{\"a\":4}]");
+        ProgressReader reader;
+        bool ok = reader.Parse(input, "progress");
+        bool rising = reader.samples.size() == 4 && reader.samples[0] > 0.0f && reader.samples[3] <= 1.0f;
+        for (size_t i = 1; rising && i < reader.samples.size(); i++) {
+            rising = reader.samples[i] > reader.samples[i - 1];
+        }
+        Check(ok && rising, "Progress rises as the input is read");
+    }
+
+    // Large scene
+    {
+        std::ofstream file("json_stream_big.json");
+        file << "{\"sceneName\":\"Big\",\"objects\":[";
+        for (int i = 0; i < 50000; i++) {
+            file << (i ? "," : "") << "{\"name\":\"Object" << i << "\",\"position\":{\"x\":" << i * 0.5f
+                 << ",\"y\":0,\"z\":" << -i * 0.25f << "},\"rotation\":{\"x\":0,\"y\":" << i % 360
+                 << ",\"z\":0},\"scale\":{\"x\":1,\"y\":1,\"z\":1}}";
+        }
+        file << "]}";
+        file.close();
+
+        std::vector<GameObject*> objects;
+        std::atomic<float> progress(0.0f);
+        auto start = std::chrono::steady_clock::now();
+        bool ok = SceneSerializer::LoadSceneFromJson("json_stream_big.json", objects, &progress);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "50000 objects streamed in " << ms << " ms" << std::endl;
+        Check(ok && objects.size() == 50000 && objects[49999]->GetName() == "Object49999", "Large scene streams");
+        Check(progress.load() == 1.0f, "Progress reaches 1 once the scene is read");
+        SceneSerializer::DestroySceneObjects(objects);
+    }
+
+    std::remove("json_stream_test.savscene");
+    std::remove("json_stream_level.json");
+    std::remove("json_stream_broken.json");
+    std::remove("json_stream_object.json");
+    std::remove("json_stream_project.json");
+    std::remove("json_stream_big.json");
+
+    return TestSummary();
+}
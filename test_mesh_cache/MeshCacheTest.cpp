@@ -0,0 +1,210 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include "../MeshCache.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the cooked mesh cache
+// Build with build_mesh_cache_test.sh
+
+static bool FileExists(const std::string& path) {
+    std::ifstream file(path);
+    return file.good();
+}
+
+static void WriteText(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+static bool SameMesh(const ObjMeshData& a, const ObjMeshData& b) {
+    if (a.submeshes.size() != b.submeshes.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.submeshes.size(); ++i) {
+        if (a.submeshes[i].material != b.submeshes[i].material ||
+            a.submeshes[i].firstIndex != b.submeshes[i].firstIndex ||
+            a.submeshes[i].indexCount != b.submeshes[i].indexCount) {
+            return false;
+        }
+    }
+    if (a.lods.size() != b.lods.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.lods.size(); ++i) {
+        if (a.lods[i].firstIndex != b.lods[i].firstIndex || a.lods[i].indexCount != b.lods[i].indexCount ||
+            a.lods[i].error != b.lods[i].error) {
+            return false;
+        }
+    }
+    return a.lodIndices == b.lodIndices && a.positions == b.positions && a.normals == b.normals && a.texCoords == b.texCoords &&
+           a.indices == b.indices && a.materialLibraries == b.materialLibraries && a.material == b.material &&
+           a.boundsMin.x == b.boundsMin.x && a.boundsMin.y == b.boundsMin.y && a.boundsMin.z == b.boundsMin.z &&
+           a.boundsMax.x == b.boundsMax.x && a.boundsMax.y == b.boundsMax.y && a.boundsMax.z == b.boundsMax.z;
+}
+
+static const char* quadObj =
+    "mtllib quad.mtl\n"
+    "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+    "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+    "vn 0 0 1\n"
+    "usemtl Front\n"
+    "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+    "usemtl Back\n"
+    "f 4/4/1 3/3/1 2/2/1 1/1/1\n";
+
+// Large grid for timing
+static void WriteGrid(const std::string& path, int n) {
+    std::ofstream file(path);
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            file << "v " << x * 0.5f << " " << (x + y) % 5 * 0.1f << " " << y * 0.5f << "\n";
+            file << "vt " << static_cast<float>(x) / n << " " << static_cast<float>(y) / n << "\n";
+        }
+    }
+    file << "vn 0 1 0\n";
+    int row = n + 1;
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            int a = y * row + x + 1;
+            file << "f " << a << "/" << a << "/1 " << a + 1 << "/" << a + 1 << "/1 "
+                 << a + row + 1 << "/" << a + row + 1 << "/1 " << a + row << "/" << a + row << "/1\n";
+        }
+    }
+}
+
+int main() {
+    std::cout << "=== Mesh Cache Tests ===" << std::endl;
+
+    const std::string source = "mesh_cache_quad.obj";
+    const std::string cooked = MeshCache::GetCookedPath(source);
+    std::remove(cooked.c_str());
+    WriteText(source, quadObj);
+
+    // First load imports and cooks, the second uses the cooked file
+    {
+        ObjMeshData imported;
+        ObjMeshData cached;
+        bool fromCache = true;
+        bool ok = MeshCache::Load(source, imported, &fromCache);
+        Check(ok && !fromCache && FileExists(cooked), "First load imports the OBJ and writes the cooked file");
+
+        ok = MeshCache::Load(source, cached, &fromCache);
+        Check(ok && fromCache, "Second load uses the cooked file");
+        Check(SameMesh(imported, cached), "Cooked data matches the import");
+        Check(cached.submeshes.size() == 2 && cached.submeshes[1].material == "Back" &&
+              cached.materialLibraries.size() == 1 && cached.materialLibraries[0] == "quad.mtl",
+              "Submeshes and material libraries are kept");
+
+        ObjMeshData direct;
+        Check(MeshCache::Read(cooked, direct) && SameMesh(direct, imported), "Cooked files can be read directly");
+    }
+
+    // Rewriting the same contents keeps the cooked file
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        WriteText(source, quadObj);
+        ObjMeshData mesh;
+        bool fromCache = false;
+        bool ok = MeshCache::Load(source, mesh, &fromCache);
+        Check(ok && fromCache && mesh.GetTriangleCount() == 4, "A touched but unchanged source still uses the cooked file");
+    }
+
+    // Changed contents of the same size are imported again
+    {
+        std::string changed = quadObj;
+        changed.replace(changed.find("v 1 1 0"), 7, "v 2 2 0");
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        WriteText(source, changed);
+
+        ObjMeshData mesh;
+        bool fromCache = true;
+        bool ok = MeshCache::Load(source, mesh, &fromCache);
+        Check(ok && !fromCache && mesh.boundsMax.x == 2.0f, "A changed source is imported again");
+
+        ok = MeshCache::Load(source, mesh, &fromCache);
+        Check(ok && fromCache && mesh.boundsMax.x == 2.0f, "The recooked file is used afterwards");
+    }
+
+    // Damaged and mismatched cooked files are replaced
+    {
+        std::ifstream in(cooked, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+
+        WriteText(cooked, bytes.substr(0, bytes.size() / 2));
+        ObjMeshData mesh;
+        bool fromCache = true;
+        bool ok = MeshCache::Load(source, mesh, &fromCache);
+        Check(ok && !fromCache && mesh.GetTriangleCount() == 4, "A truncated cooked file is rebuilt");
+
+        MeshCache::Header header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        header.settingsHash ^= 1;
+        std::string stale = bytes;
+        std::memcpy(&stale[0], &header, sizeof(header));
+        WriteText(cooked, stale);
+        ok = MeshCache::Load(source, mesh, &fromCache);
+        Check(ok && !fromCache, "A file cooked with other import settings is rebuilt");
+    }
+
+    // Shipped without the source
+    {
+        std::remove(source.c_str());
+        ObjMeshData mesh;
+        bool fromCache = false;
+        bool ok = MeshCache::Load(source, mesh, &fromCache);
+        Check(ok && fromCache && mesh.GetTriangleCount() == 4, "The cooked file is used when the source is missing");
+    }
+
+    // Disabled cache
+    {
+        std::remove(cooked.c_str());
+        WriteText(source, quadObj);
+        MeshCache::SetEnabled(false);
+        ObjMeshData mesh;
+        bool fromCache = true;
+        bool ok = MeshCache::Load(source, mesh, &fromCache);
+        Check(ok && !fromCache && !FileExists(cooked), "A disabled cache imports without cooking");
+        MeshCache::SetEnabled(true);
+    }
+
+    Check(MeshCache::Hash("abcdefghij", 10) != MeshCache::Hash("abcdefghik", 10) &&
+          MeshCache::Hash("abcdefgh", 8) != MeshCache::Hash("abcdefgh", 7), "Hash depends on every byte and the length");
+
+    // Cold and cached load times for a large mesh
+    {
+        const std::string grid = "mesh_cache_grid.obj";
+        WriteGrid(grid, 700);
+        std::remove(MeshCache::GetCookedPath(grid).c_str());
+
+        ObjMeshData imported;
+        ObjMeshData cached;
+        bool fromCache = false;
+        auto start = std::chrono::high_resolution_clock::now();
+        MeshCache::Load(grid, imported);
+        auto middle = std::chrono::high_resolution_clock::now();
+        bool ok = MeshCache::Load(grid, cached, &fromCache);
+        auto end = std::chrono::high_resolution_clock::now();
+        Check(ok && fromCache && SameMesh(imported, cached), "Large mesh round-trips through the cache");
+        Check(!cached.lods.empty(), "Levels of detail are cooked with the mesh");
+
+        double importMs = std::chrono::duration<double, std::milli>(middle - start).count();
+        double cachedMs = std::chrono::duration<double, std::milli>(end - middle).count();
+        std::cout << cached.GetTriangleCount() << " triangles: import and cook " << importMs << " ms, cached "
+                  << cachedMs << " ms" << std::endl;
+
+        std::remove(grid.c_str());
+        std::remove(MeshCache::GetCookedPath(grid).c_str());
+    }
+
+    std::remove(source.c_str());
+    std::remove(cooked.c_str());
+
+    return TestSummary();
+}
@@ -0,0 +1,21 @@
+@echo off
+echo Building mesh cache test program...
+
+REM Build mesh cache test
+g++ -std=c++14 -O2 -I.. ^
+    MeshCacheTest.cpp ^
+    ..\ObjLoader.cpp ^
+    ..\MeshCache.cpp ^
+    ..\MeshOptimizer.cpp ^
+    ..\MeshSimplifier.cpp ^
+    ..\MappedFile.cpp ^
+    -o mesh_cache_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run mesh_cache_test.exe from this folder to test the cooked mesh cache.
+pause
@@ -0,0 +1,22 @@
+#!/bin/bash
+
+# Build mesh cache test
+echo "Building mesh cache test program..."
+g++ -std=c++14 -O2 -I.. \
+    MeshCacheTest.cpp \
+    ../ObjLoader.cpp \
+    ../MeshCache.cpp \
+    ../MeshOptimizer.cpp \
+    ../MeshSimplifier.cpp \
+    ../MappedFile.cpp \
+    -pthread -o mesh_cache_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x mesh_cache_test
+
+echo "Build complete. Run ./mesh_cache_test from this folder to test the cooked mesh cache."
@@ -0,0 +1,276 @@
+// Tests for MeshSimplifier and LodGroup: simplification, locked seams and
+// borders, level chains and screen-size selection
+// Build with build_mesh_lod_test.sh
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <set>
+
+#include "../MeshSimplifier.h"
+#include "../MeshOptimizer.h"
+#include "../LodGroup.h"
+#include "../Camera.h"
+#include "../test_common/TestCheck.h"
+
+// Unit sphere from a subdivided icosahedron, closed and without seams
+static ObjMeshData MakeSphere(int subdivisions) {
+    ObjMeshData mesh;
+    const float t = (1.0f + std::sqrt(5.0f)) / 2.0f;
+    std::vector<std::array<float, 3>> points = {
+        { { -1, t, 0 } }, { { 1, t, 0 } }, { { -1, -t, 0 } }, { { 1, -t, 0 } },
+        { { 0, -1, t } }, { { 0, 1, t } }, { { 0, -1, -t } }, { { 0, 1, -t } },
+        { { t, 0, -1 } }, { { t, 0, 1 } }, { { -t, 0, -1 } }, { { -t, 0, 1 } } };
+    std::vector<unsigned int> faces = { 0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11, 1, 5, 9, 5, 11, 4,
+                                        11, 10, 2, 10, 7, 6, 7, 1, 8, 3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8,
+                                        3, 8, 9, 4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1 };
+    for (int level = 0; level < subdivisions; ++level) {
+        std::map<std::pair<unsigned int, unsigned int>, unsigned int> middles;
+        auto middle = [&](unsigned int a, unsigned int b) {
+            std::pair<unsigned int, unsigned int> key(std::min(a, b), std::max(a, b));
+            auto it = middles.find(key);
+            if (it != middles.end()) {
+                return it->second;
+            }
+            std::array<float, 3> point = { { (points[a][0] + points[b][0]) / 2, (points[a][1] + points[b][1]) / 2,
+                                             (points[a][2] + points[b][2]) / 2 } };
+            points.push_back(point);
+            return middles[key] = static_cast<unsigned int>(points.size() - 1);
+        };
+        std::vector<unsigned int> finer;
+        for (size_t i = 0; i < faces.size(); i += 3) {
+            unsigned int a = faces[i], b = faces[i + 1], c = faces[i + 2];
+            unsigned int ab = middle(a, b), bc = middle(b, c), ca = middle(c, a);
+            finer.insert(finer.end(), { a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca });
+        }
+        faces.swap(finer);
+    }
+    for (const auto& point : points) {
+        float length = std::sqrt(point[0] * point[0] + point[1] * point[1] + point[2] * point[2]);
+        mesh.positions.insert(mesh.positions.end(), { point[0] / length, point[1] / length, point[2] / length });
+    }
+    mesh.indices = faces;
+    return mesh;
+}
+
+// n x n quads of a flat grid facing +y; with a seam, the middle column of
+// vertices is doubled with other texture coordinates
+static ObjMeshData MakeGrid(int n, bool seam) {
+    ObjMeshData mesh;
+    unsigned int row = n + 1;
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            mesh.positions.insert(mesh.positions.end(), { static_cast<float>(x), 0.0f, static_cast<float>(y) });
+            mesh.texCoords.insert(mesh.texCoords.end(), { static_cast<float>(x) / n, static_cast<float>(y) / n });
+        }
+    }
+    std::vector<unsigned int> seamCopy(row);
+    if (seam) {
+        for (int y = 0; y <= n; ++y) {
+            seamCopy[y] = static_cast<unsigned int>(mesh.GetVertexCount());
+            mesh.positions.insert(mesh.positions.end(), { static_cast<float>(n / 2), 0.0f, static_cast<float>(y) });
+            mesh.texCoords.insert(mesh.texCoords.end(), { 0.0f, static_cast<float>(y) / n });
+        }
+    }
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            unsigned int a = y * row + x;
+            unsigned int b = a + 1;
+            unsigned int c = a + row;
+            unsigned int d = a + row + 1;
+            if (seam && x == n / 2) {
+                a = seamCopy[y];
+                c = seamCopy[y + 1];
+            }
+            mesh.indices.insert(mesh.indices.end(), { a, c, b, b, c, d });
+        }
+    }
+    return mesh;
+}
+
+// Triangles whose corners are not all different
+static size_t CountDegenerate(const std::vector<unsigned int>& indices, size_t first, size_t count) {
+    size_t degenerate = 0;
+    for (size_t i = first; i < first + count; i += 3) {
+        if (indices[i] == indices[i + 1] || indices[i + 1] == indices[i + 2] || indices[i] == indices[i + 2]) {
+            ++degenerate;
+        }
+    }
+    return degenerate;
+}
+
+// Whether every edge is shared by exactly two triangles
+static bool IsClosed(const std::vector<unsigned int>& indices, size_t first, size_t count) {
+    std::map<std::pair<unsigned int, unsigned int>, int> edges;
+    for (size_t i = first; i < first + count; i += 3) {
+        for (int corner = 0; corner < 3; ++corner) {
+            unsigned int a = indices[i + corner];
+            unsigned int b = indices[i + (corner + 1) % 3];
+            ++edges[std::make_pair(std::min(a, b), std::max(a, b))];
+        }
+    }
+    for (const auto& edge : edges) {
+        if (edge.second != 2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Mesh LOD Test ===" << std::endl;
+
+    // A chain of levels for a closed mesh
+    {
+        ObjMeshData sphere = MakeSphere(4);
+        size_t levels = MeshSimplifier::GenerateLods(sphere);
+        Check(levels == 3, "A detailed mesh gets three levels of detail");
+
+        bool halving = true;
+        bool valid = true;
+        bool increasing = true;
+        size_t previous = sphere.indices.size();
+        float previousError = 0.0f;
+        for (const ObjMeshLod& lod : sphere.lods) {
+            std::cout << "Level with " << lod.indexCount / 3 << " triangles, error " << lod.error << std::endl;
+            halving = halving && lod.indexCount * 10 >= previous * 4 && lod.indexCount * 10 <= previous * 6;
+            for (size_t i = lod.firstIndex; i < lod.firstIndex + lod.indexCount; ++i) {
+                valid = valid && sphere.lodIndices[i] < sphere.GetVertexCount();
+            }
+            valid = valid && CountDegenerate(sphere.lodIndices, lod.firstIndex, lod.indexCount) == 0 &&
+                    IsClosed(sphere.lodIndices, lod.firstIndex, lod.indexCount);
+            increasing = increasing && lod.error > previousError;
+            previous = lod.indexCount;
+            previousError = lod.error;
+        }
+        Check(halving, "Each level has about half the triangles of the one before");
+        Check(valid, "Levels index the original vertices and stay closed");
+        Check(increasing && previousError < 0.05f * 2.0f, "Errors grow with each level and stay within the limit");
+
+        // Outward winding is kept: every triangle faces away from the center
+        bool outward = true;
+        const ObjMeshLod& coarsest = sphere.lods.back();
+        for (size_t i = coarsest.firstIndex; i < coarsest.firstIndex + coarsest.indexCount; i += 3) {
+            const float* a = &sphere.positions[sphere.lodIndices[i] * 3];
+            const float* b = &sphere.positions[sphere.lodIndices[i + 1] * 3];
+            const float* c = &sphere.positions[sphere.lodIndices[i + 2] * 3];
+            float e1[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            float e2[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+            float normal[3] = { e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+                                e1[0] * e2[1] - e1[1] * e2[0] };
+            outward = outward && normal[0] * a[0] + normal[1] * a[1] + normal[2] * a[2] > 0.0f;
+        }
+        Check(outward, "No triangle is turned over");
+
+        // Renumbering the vertices renumbers the levels with them
+        std::vector<std::vector<float>> before;
+        for (unsigned int vertex : sphere.lodIndices) {
+            before.push_back(std::vector<float>(sphere.positions.begin() + vertex * 3,
+                                                sphere.positions.begin() + vertex * 3 + 3));
+        }
+        std::reverse(sphere.indices.begin(), sphere.indices.end());
+        MeshOptimizer::OptimizeVertexFetch(sphere);
+        bool same = true;
+        for (size_t i = 0; i < sphere.lodIndices.size(); ++i) {
+            unsigned int vertex = sphere.lodIndices[i];
+            same = same && std::equal(before[i].begin(), before[i].end(), sphere.positions.begin() + vertex * 3);
+        }
+        Check(same, "Vertex fetch order keeps the levels pointing at the same positions");
+
+        ObjMeshData small = MakeSphere(0);
+        Check(MeshSimplifier::GenerateLods(small) == 0 && small.lods.empty(), "Small meshes get no levels");
+    }
+
+    // Borders and seams stay put
+    {
+        ObjMeshData grid = MakeGrid(32, false);
+        std::vector<unsigned int> simplified;
+        float error = 1.0f;
+        MeshSimplifier::Simplify(grid.indices, grid.positions, 0, 1e-4f, simplified, &error);
+        std::set<unsigned int> used(simplified.begin(), simplified.end());
+        bool border = true;
+        for (int i = 0; i <= 32; ++i) {
+            border = border && used.count(i) && used.count(32 * 33 + i) && used.count(i * 33) && used.count(i * 33 + 32);
+        }
+        std::cout << "Flat grid of " << grid.GetTriangleCount() << " triangles simplified to "
+                  << simplified.size() / 3 << std::endl;
+        Check(simplified.size() * 10 < grid.indices.size() && error < 1e-4f, "A flat surface collapses at no cost");
+        Check(border, "Border vertices are kept");
+
+        ObjMeshData seamed = MakeGrid(32, true);
+        MeshSimplifier::Simplify(seamed.indices, seamed.positions, 0, 1e-4f, simplified);
+        used = std::set<unsigned int>(simplified.begin(), simplified.end());
+        bool seam = true;
+        for (int y = 0; y <= 32; ++y) {
+            seam = seam && used.count(y * 33 + 16) && used.count(static_cast<unsigned int>(33 * 33 + y));
+        }
+        Check(seam, "Both sides of a texture seam are kept");
+
+        std::vector<unsigned int> limited;
+        ObjMeshData sphere = MakeSphere(3);
+        MeshSimplifier::Simplify(sphere.indices, sphere.positions, 0, 1e-5f, limited, &error);
+        Check(limited.size() == sphere.indices.size() && error == 0.0f, "Nothing collapses past the error limit");
+    }
+
+    // Screen size
+    {
+        Matrix4x4 projection;
+        projection.elements[1][1] = 1.0f;
+        projection.elements[3][3] = 0.0f;
+        float height = LodGroup::GetScreenHeight(Vector3(0, 0, -10), 1.0f, Vector3(0, 0, 0), projection);
+        Check(std::fabs(height - 0.1f) < 1e-6f, "A unit sphere ten units away covers a tenth of a 90 degree view");
+        Check(LodGroup::GetScreenHeight(Vector3(0, 0, 0), 1.0f, Vector3(0, 0, 0.5f), projection) > 1.0f,
+              "A camera inside the bounds sees the full level");
+
+        Camera camera;
+        camera.SetFieldOfView(90.0f);
+        Check(std::fabs(camera.GetProjectionMatrix().elements[1][1] - 1.0f) < 1e-3f,
+              "Camera projections scale heights the same way");
+    }
+
+    // Selection with hysteresis, per camera
+    {
+        Camera mainCamera;
+        Camera minimap;
+        LodGroup group;
+        Check(group.Select(&mainCamera, 0.5f, 4).level == 0, "Close objects draw the full mesh");
+        Check(group.Select(&mainCamera, 0.37f, 4).level == 0, "Just under a transition the level holds");
+        Check(group.Select(&mainCamera, 0.3f, 4).level == 1, "Past the hysteresis the next level is drawn");
+        Check(group.Select(&mainCamera, 0.42f, 4).level == 1, "Just over the transition the level holds again");
+        Check(group.Select(&mainCamera, 0.45f, 4).level == 0, "Past it the full mesh returns");
+        Check(group.Select(&minimap, 0.01f, 4).level == 3 && group.Select(&mainCamera, 0.5f, 4).level == 0,
+              "Each camera keeps its own level");
+        Check(group.Select(&minimap, 0.01f, 2).level == 1, "Levels are limited to those the models have");
+
+        LodGroup fading;
+        fading.SetCrossfadeDuration(1.0f);
+        fading.Select(&mainCamera, 0.5f, 4);
+        LodGroup::Selection start = fading.Select(&mainCamera, 0.1f, 4);
+        Check(start.level == 2 && start.fadeLevel == 0 && start.fade == 0.0f, "A level change starts a crossfade");
+        fading.Update(0.5f);
+        LodGroup::Selection middle = fading.Select(&mainCamera, 0.1f, 4);
+        Check(middle.level == 2 && middle.fadeLevel == 0 && std::fabs(middle.fade - 0.5f) < 1e-6f,
+              "The crossfade advances with time");
+        fading.Update(0.6f);
+        LodGroup::Selection done = fading.Select(&mainCamera, 0.1f, 4);
+        Check(done.fade == 1.0f && done.fadeLevel == 2, "Once faded only the new level is drawn");
+    }
+
+    // Timing
+    {
+        ObjMeshData sphere = MakeSphere(7);
+        auto start = std::chrono::high_resolution_clock::now();
+        MeshSimplifier::GenerateLods(sphere);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << sphere.GetTriangleCount() << " triangles, " << sphere.lods.size() << " levels built in " << ms
+                  << " ms" << std::endl;
+        Check(sphere.lods.size() == 3, "Large meshes get their levels too");
+    }
+
+    return TestSummary();
+}
@@ -0,0 +1,23 @@
+@echo off
+echo Building mesh LOD test program...
+
+REM Build mesh LOD test
+g++ -std=c++14 -O2 -I.. ^
+    MeshLodTest.cpp ^
+    ..\MeshSimplifier.cpp ^
+    ..\MeshOptimizer.cpp ^
+    ..\LodGroup.cpp ^
+    ..\Coroutine.cpp ^
+    ..\TimerWheel.cpp ^
+    ..\Matrix4x4.cpp ^
+    ..\Vector3.cpp ^
+    -o mesh_lod_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run mesh_lod_test.exe from this folder to test mesh levels of detail.
+pause
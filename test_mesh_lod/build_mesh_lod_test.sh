@@ -0,0 +1,24 @@
+#!/bin/bash
+
+# Build mesh LOD test
+echo "Building mesh LOD test program..."
+g++ -std=c++14 -O2 -I.. \
+    MeshLodTest.cpp \
+    ../MeshSimplifier.cpp \
+    ../MeshOptimizer.cpp \
+    ../LodGroup.cpp \
+    ../Coroutine.cpp \
+    ../TimerWheel.cpp \
+    ../Matrix4x4.cpp \
+    ../Vector3.cpp \
+    -o mesh_lod_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x mesh_lod_test
+
+echo "Build complete. Run ./mesh_lod_test from this folder to test mesh levels of detail."
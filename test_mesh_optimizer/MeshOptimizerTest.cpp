@@ -0,0 +1,224 @@
+// Tests for MeshOptimizer: cache order, overdraw order, fetch order and
+// vertex quantization
+// Build with build_mesh_optimizer_test.sh
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include "../MeshOptimizer.h"
+#include "../test_common/TestCheck.h"
+
+// n x n quads of a grid, triangles shuffled the way a careless exporter
+// might write them
+static ObjMeshData MakeGrid(int n, bool shuffle) {
+    ObjMeshData mesh;
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            mesh.positions.insert(mesh.positions.end(), { static_cast<float>(x), 0.0f, static_cast<float>(y) });
+            mesh.normals.insert(mesh.normals.end(), { 0.0f, 1.0f, 0.0f });
+            mesh.texCoords.insert(mesh.texCoords.end(), { static_cast<float>(x) / n, static_cast<float>(y) / n });
+        }
+    }
+    std::vector<std::array<unsigned int, 3>> triangles;
+    unsigned int row = n + 1;
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            unsigned int a = y * row + x;
+            triangles.push_back({ { a, a + row, a + 1 } });
+            triangles.push_back({ { a + 1, a + row, a + row + 1 } });
+        }
+    }
+    if (shuffle) {
+        std::mt19937 random(11);
+        std::shuffle(triangles.begin(), triangles.end(), random);
+    }
+    for (const auto& triangle : triangles) {
+        mesh.indices.insert(mesh.indices.end(), triangle.begin(), triangle.end());
+    }
+    return mesh;
+}
+
+// Triangles as position triples, each rotated to start at its smallest
+// corner, sorted; equal for meshes that draw the same thing
+static std::vector<std::vector<float>> TriangleSet(const ObjMeshData& mesh, size_t first = 0, size_t count = 0) {
+    size_t end = count == 0 ? mesh.indices.size() : first + count;
+    std::vector<std::vector<float>> triangles;
+    for (size_t i = first; i < end; i += 3) {
+        std::vector<std::vector<float>> corners;
+        for (int corner = 0; corner < 3; ++corner) {
+            unsigned int vertex = mesh.indices[i + corner];
+            std::vector<float> attributes(mesh.positions.begin() + vertex * 3, mesh.positions.begin() + vertex * 3 + 3);
+            attributes.insert(attributes.end(), mesh.texCoords.begin() + vertex * 2,
+                              mesh.texCoords.begin() + vertex * 2 + 2);
+            corners.push_back(attributes);
+        }
+        size_t start = std::min_element(corners.begin(), corners.end()) - corners.begin();
+        std::vector<float> triangle;
+        for (int corner = 0; corner < 3; ++corner) {
+            const std::vector<float>& attributes = corners[(start + corner) % 3];
+            triangle.insert(triangle.end(), attributes.begin(), attributes.end());
+        }
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+// Square of quads at height z facing +z, appended to a mesh
+static void AddWall(ObjMeshData& mesh, float z, int n) {
+    unsigned int base = static_cast<unsigned int>(mesh.GetVertexCount());
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            mesh.positions.insert(mesh.positions.end(), { static_cast<float>(x), static_cast<float>(y), z });
+            mesh.texCoords.insert(mesh.texCoords.end(), { 0.0f, 0.0f });
+        }
+    }
+    unsigned int row = n + 1;
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            unsigned int a = base + y * row + x;
+            mesh.indices.insert(mesh.indices.end(), { a, a + 1, a + row, a + 1, a + row + 1, a + row });
+        }
+    }
+}
+
+int main() {
+    std::cout << "=== Mesh Optimizer Test ===" << std::endl;
+
+    // Vertex cache order
+    {
+        ObjMeshData mesh = MakeGrid(64, true);
+        std::vector<std::vector<float>> before = TriangleSet(mesh);
+        float shuffled = MeshOptimizer::GetACMR(mesh.indices, mesh.GetVertexCount());
+        MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.GetVertexCount());
+        float optimized = MeshOptimizer::GetACMR(mesh.indices, mesh.GetVertexCount());
+        std::cout << "ACMR shuffled " << shuffled << ", optimized " << optimized << std::endl;
+        Check(shuffled > 2.0f && optimized < 0.8f, "Cache order cuts vertex transforms to under 0.8 per triangle");
+        Check(TriangleSet(mesh) == before, "Cache order keeps every triangle and its winding");
+
+        ObjMeshData tiny = MakeGrid(1, false);
+        std::vector<unsigned int> original = tiny.indices;
+        MeshOptimizer::OptimizeVertexCache(tiny.indices, tiny.GetVertexCount(), 0, 3);
+        Check(tiny.indices == original, "A single triangle is left as it is");
+    }
+
+    // Overdraw order
+    {
+        ObjMeshData mesh;
+        AddWall(mesh, -1.0f, 8);
+        AddWall(mesh, 1.0f, 8);
+        size_t wallVertices = mesh.GetVertexCount() / 2;
+        std::vector<std::vector<float>> before = TriangleSet(mesh);
+        MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.GetVertexCount());
+        MeshOptimizer::OptimizeOverdraw(mesh.indices, mesh.positions);
+        bool frontFirst = true;
+        for (size_t i = 0; i < mesh.indices.size() / 2; ++i) {
+            frontFirst = frontFirst && mesh.indices[i] >= wallVertices;
+        }
+        Check(frontFirst, "The front wall draws before the wall it hides");
+        Check(TriangleSet(mesh) == before, "Overdraw order keeps every triangle");
+
+        ObjMeshData grid = MakeGrid(64, true);
+        MeshOptimizer::OptimizeVertexCache(grid.indices, grid.GetVertexCount());
+        float cached = MeshOptimizer::GetACMR(grid.indices, grid.GetVertexCount());
+        MeshOptimizer::OptimizeOverdraw(grid.indices, grid.positions, 0, 0, 1.05f);
+        float sorted = MeshOptimizer::GetACMR(grid.indices, grid.GetVertexCount());
+        std::cout << "ACMR before overdraw order " << cached << ", after " << sorted << std::endl;
+        Check(sorted <= cached * 1.1f, "Overdraw order costs the cache little");
+    }
+
+    // Fetch order and submeshes
+    {
+        ObjMeshData mesh = MakeGrid(16, true);
+        mesh.submeshes.resize(2);
+        mesh.submeshes[0].firstIndex = 0;
+        mesh.submeshes[0].indexCount = 300;
+        mesh.submeshes[1].firstIndex = 300;
+        mesh.submeshes[1].indexCount = mesh.indices.size() - 300;
+        std::vector<std::vector<float>> first = TriangleSet(mesh, 0, 300);
+        std::vector<std::vector<float>> second = TriangleSet(mesh, 300, mesh.indices.size() - 300);
+        MeshOptimizer::Optimize(mesh);
+
+        bool firstUse = true;
+        unsigned int next = 0;
+        for (unsigned int vertex : mesh.indices) {
+            firstUse = firstUse && vertex <= next;
+            if (vertex == next) {
+                ++next;
+            }
+        }
+        Check(firstUse, "Vertices are numbered in order of first use");
+        Check(TriangleSet(mesh, 0, 300) == first &&
+              TriangleSet(mesh, 300, mesh.indices.size() - 300) == second,
+              "Each submesh keeps its own triangles, attributes moved with the vertices");
+        Check(mesh.normals.size() == mesh.positions.size(), "Normals are moved too");
+    }
+
+    // Quantization
+    {
+        std::vector<float> normals = { 0.0f, 1.0f, 0.0f, 0.6f, -0.8f, 0.0f, -1.0f, 0.0f, 0.0f };
+        std::vector<int16_t> packed;
+        MeshOptimizer::QuantizeNormals(normals, packed);
+        float worst = 0.0f;
+        for (size_t v = 0; v < 3; ++v) {
+            for (int axis = 0; axis < 3; ++axis) {
+                worst = std::max(worst, std::fabs(packed[v * 4 + axis] / 32767.0f - normals[v * 3 + axis]));
+            }
+        }
+        Check(packed.size() == 12 && packed[3] == 0 && worst < 2e-5f, "Normals become snorm16 with 8 bytes a vertex");
+
+        std::vector<float> unit = { 0.0f, 1.0f, 0.25f, 0.75f };
+        std::vector<float> tiling = { -1.5f, 2.0f };
+        std::vector<float> far = { 0.0f, 10.0f };
+        Check(MeshOptimizer::GetTexCoordFormat(unit) == MeshOptimizer::TEXCOORDS_UNORM16 &&
+              MeshOptimizer::GetTexCoordFormat(tiling) == MeshOptimizer::TEXCOORDS_HALF &&
+              MeshOptimizer::GetTexCoordFormat(far) == MeshOptimizer::TEXCOORDS_FLOAT,
+              "Texture coordinates pick the smallest format that holds them");
+
+        std::vector<uint16_t> coordinates;
+        MeshOptimizer::QuantizeTexCoords(unit, MeshOptimizer::TEXCOORDS_UNORM16, coordinates);
+        Check(coordinates[0] == 0 && coordinates[1] == 65535 && coordinates[2] == 16384,
+              "Texture coordinates in [0, 1] become unorm16");
+
+        Check(MeshOptimizer::FloatToHalf(1.0f) == 0x3C00 && MeshOptimizer::FloatToHalf(-2.0f) == 0xC000 &&
+              MeshOptimizer::FloatToHalf(65504.0f) == 0x7BFF && MeshOptimizer::FloatToHalf(1e6f) == 0x7C00 &&
+              MeshOptimizer::FloatToHalf(std::ldexp(1.0f, -24)) == 0x0001,
+              "Half floats convert exactly where they can");
+        Check(MeshOptimizer::FloatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3C00 &&
+              MeshOptimizer::FloatToHalf(1.0f + 3 * std::ldexp(1.0f, -11)) == 0x3C02,
+              "Half floats round to nearest, ties to even");
+        bool roundTrip = true;
+        for (uint32_t bits = 0; bits < 0x7C00; ++bits) {
+            roundTrip = roundTrip &&
+                        MeshOptimizer::FloatToHalf(MeshOptimizer::HalfToFloat(static_cast<uint16_t>(bits))) == bits;
+        }
+        Check(roundTrip, "Every finite half float survives a round trip");
+
+        ObjMeshData grid = MakeGrid(16, false);
+        size_t full = (grid.positions.size() + grid.normals.size() + grid.texCoords.size()) * sizeof(float) +
+                      grid.indices.size() * sizeof(unsigned int);
+        size_t compact = MeshOptimizer::GetUploadSize(grid.positions, grid.normals, grid.texCoords, grid.indices);
+        std::cout << "Upload size " << full << " bytes as floats, " << compact << " quantized" << std::endl;
+        Check(compact * 3 < full * 2 && MeshOptimizer::CanUseShortIndices(65536) &&
+              !MeshOptimizer::CanUseShortIndices(65537), "Quantized meshes with 16-bit indices upload under two thirds");
+    }
+
+    // Timing
+    {
+        ObjMeshData mesh = MakeGrid(400, true);
+        auto start = std::chrono::high_resolution_clock::now();
+        MeshOptimizer::Optimize(mesh);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << mesh.GetTriangleCount() << " triangles optimized in " << ms << " ms, ACMR "
+                  << MeshOptimizer::GetACMR(mesh.indices, mesh.GetVertexCount()) << std::endl;
+        Check(MeshOptimizer::GetACMR(mesh.indices, mesh.GetVertexCount()) < 0.8f, "Large meshes are optimized too");
+    }
+
+    return TestSummary();
+}
@@ -0,0 +1,17 @@
+@echo off
+echo Building mesh optimizer test program...
+
+REM Build mesh optimizer test
+g++ -std=c++14 -O2 -I.. ^
+    MeshOptimizerTest.cpp ^
+    ..\MeshOptimizer.cpp ^
+    -o mesh_optimizer_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run mesh_optimizer_test.exe from this folder to test the mesh optimizer.
+pause
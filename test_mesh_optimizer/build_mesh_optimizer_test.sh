@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Build mesh optimizer test
+echo "Building mesh optimizer test program..."
+g++ -std=c++14 -O2 -I.. \
+    MeshOptimizerTest.cpp \
+    ../MeshOptimizer.cpp \
+    -o mesh_optimizer_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x mesh_optimizer_test
+
+echo "Build complete. Run ./mesh_optimizer_test from this folder to test the mesh optimizer."
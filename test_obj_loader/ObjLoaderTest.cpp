@@ -0,0 +1,262 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "../ObjLoader.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the OBJ/MTL loader
+// Build with build_obj_loader_test.sh
+
+// Triangle corners expanded the straightforward way (one entry per corner,
+// 8 floats: position, uv, normal), as a reference for the indexed output
+static bool ExpandReference(const std::string& path, std::vector<float>& corners) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<float> v, vt, vn;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream iss(line);
+        std::string prefix;
+        iss >> prefix;
+        float x = 0, y = 0, z = 0;
+        if (prefix == "v") {
+            iss >> x >> y >> z;
+            v.insert(v.end(), { x, y, z });
+        } else if (prefix == "vt") {
+            iss >> x >> y;
+            vt.insert(vt.end(), { x, y });
+        } else if (prefix == "vn") {
+            iss >> x >> y >> z;
+            vn.insert(vn.end(), { x, y, z });
+        } else if (prefix == "f") {
+            std::vector<std::vector<float>> polygon;
+            std::string corner;
+            while (iss >> corner) {
+                int indices[3] = { 0, 0, 0 };
+                size_t start = 0;
+                for (int k = 0; k < 3 && start <= corner.size(); ++k) {
+                    size_t slash = corner.find('/', start);
+                    std::string part = corner.substr(start, slash == std::string::npos ? std::string::npos : slash - start);
+                    indices[k] = part.empty() ? 0 : std::atoi(part.c_str());
+                    if (slash == std::string::npos) {
+                        break;
+                    }
+                    start = slash + 1;
+                }
+                int counts[3] = { static_cast<int>(v.size() / 3), static_cast<int>(vt.size() / 2), static_cast<int>(vn.size() / 3) };
+                for (int k = 0; k < 3; ++k) {
+                    if (indices[k] < 0) {
+                        indices[k] = counts[k] + indices[k] + 1;
+                    }
+                }
+                std::vector<float> values(8, 0.0f);
+                for (int k = 0; k < 3; ++k) values[k] = v[(indices[0] - 1) * 3 + k];
+                if (indices[1] > 0) for (int k = 0; k < 2; ++k) values[3 + k] = vt[(indices[1] - 1) * 2 + k];
+                if (indices[2] > 0) for (int k = 0; k < 3; ++k) values[5 + k] = vn[(indices[2] - 1) * 3 + k];
+                polygon.push_back(values);
+            }
+            for (size_t i = 2; i < polygon.size(); ++i) {
+                corners.insert(corners.end(), polygon[0].begin(), polygon[0].end());
+                corners.insert(corners.end(), polygon[i - 1].begin(), polygon[i - 1].end());
+                corners.insert(corners.end(), polygon[i].begin(), polygon[i].end());
+            }
+        }
+    }
+    return true;
+}
+
+// Indexed mesh expanded back into the reference layout
+static std::vector<float> Expand(const ObjMeshData& mesh) {
+    std::vector<float> corners;
+    for (unsigned int index : mesh.indices) {
+        for (int k = 0; k < 3; ++k) corners.push_back(mesh.positions[index * 3 + k]);
+        for (int k = 0; k < 2; ++k) corners.push_back(mesh.texCoords.empty() ? 0.0f : mesh.texCoords[index * 2 + k]);
+        for (int k = 0; k < 3; ++k) corners.push_back(mesh.normals.empty() ? 0.0f : mesh.normals[index * 3 + k]);
+    }
+    return corners;
+}
+
+static bool SameValues(const std::vector<float>& a, const std::vector<float>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::fabs(a[i] - b[i]) > 1e-5f * (1.0f + std::fabs(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool MatchesReference(const std::string& path, const ObjMeshData& mesh) {
+    std::vector<float> reference;
+    return ExpandReference(path, reference) && SameValues(Expand(mesh), reference);
+}
+
+static bool ParseText(const std::string& text, ObjMeshData& mesh, unsigned int threads = 1) {
+    return ObjLoader::Parse(text.data(), text.size(), mesh, "test", threads);
+}
+
+// Grid of n x n quads with shared corners, uvs and one normal. Faces use
+// negative indices every few rows so that relative indices cross the
+// parsing chunks.
+static void WriteGrid(const std::string& path, int n) {
+    std::ofstream file(path);
+    file << "# generated grid\n";
+    for (int y = 0; y <= n; ++y) {
+        for (int x = 0; x <= n; ++x) {
+            file << "v " << x * 0.25f << " " << y * -0.125f << " " << (x * y % 7) * 1e-3f << "\n";
+            file << "vt " << static_cast<float>(x) / n << " " << static_cast<float>(y) / n << "\n";
+        }
+    }
+    file << "vn 0 0 1\n";
+    int row = n + 1;
+    for (int y = 0; y < n; ++y) {
+        for (int x = 0; x < n; ++x) {
+            int a = y * row + x + 1;
+            int b = a + 1;
+            int c = a + row + 1;
+            int d = a + row;
+            if (y % 3 == 1) {
+                int total = row * row;
+                file << "f " << a - total - 1 << "/" << a - total - 1 << "/-1 "
+                     << b - total - 1 << "/" << b - total - 1 << "/-1 "
+                     << c - total - 1 << "/" << c - total - 1 << "/-1 "
+                     << d - total - 1 << "/" << d - total - 1 << "/-1\n";
+            } else {
+                file << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 "
+                     << c << "/" << c << "/1 " << d << "/" << d << "/1\n";
+            }
+        }
+    }
+}
+
+int main() {
+    std::cout << "=== OBJ Loader Tests ===" << std::endl;
+
+    // Shared corners become one vertex
+    {
+        ObjMeshData mesh;
+        bool ok = ObjLoader::Load("../test_assets/material_test/cube_with_materials.obj", mesh);
+        Check(ok && mesh.GetTriangleCount() == 12, "Cube faces are read");
+        Check(mesh.GetVertexCount() == 24 && mesh.faceCorners == 36, "Corners sharing position, uv and normal are merged");
+        Check(mesh.normals.size() == 24 * 3 && mesh.texCoords.size() == 24 * 2, "Normals and uvs are per vertex");
+        Check(MatchesReference("../test_assets/material_test/cube_with_materials.obj", mesh), "Indexed cube matches the expanded faces");
+        Check(mesh.materialLibraries.size() == 1 && mesh.materialLibraries[0] == "cube.mtl", "mtllib is recorded");
+        Check(mesh.material == "Cyan", "The last usemtl is recorded");
+        Check(mesh.submeshes.size() == 6 && mesh.submeshes[1].material == "Green" &&
+              mesh.submeshes[1].firstIndex == 6 && mesh.submeshes[5].indexCount == 6, "usemtl ranges become submeshes");
+        Check(mesh.boundsMin.x == -0.5f && mesh.boundsMax.z == 0.5f, "Bounds cover the positions");
+    }
+
+    {
+        ObjMeshData mesh;
+        bool ok = ObjLoader::Load("../test_assets/cube.obj", mesh);
+        Check(ok && mesh.normals.empty() && !mesh.texCoords.empty(), "Files without normals have no normals");
+        Check(MatchesReference("../test_assets/cube.obj", mesh), "Position/uv cube matches the expanded faces");
+    }
+
+    // Materials
+    {
+        std::map<std::string, ObjMaterial> materials;
+        bool ok = ObjLoader::LoadMaterials("../test_assets/material_test/cube.mtl", materials);
+        Check(ok && materials.size() == 6, "MTL materials are read");
+        Check(materials["Yellow"].diffuse.x == 1.0f && materials["Yellow"].diffuse.y == 1.0f &&
+              materials["Yellow"].diffuse.z == 0.0f, "Kd is read");
+
+        std::ofstream mtl("obj_test.mtl");
+        mtl << "newmtl Wood Floor\r\nKd 0.5 0.25 0.125\r\nmap_Kd -s 2 2 1 textures/wood.png\r\n";
+        mtl.close();
+        materials.clear();
+        ObjLoader::LoadMaterials("obj_test.mtl", materials);
+        Check(materials.count("Wood Floor") == 1 && materials["Wood Floor"].diffuseMap == "textures/wood.png",
+              "map_Kd options are skipped and CRLF is handled");
+        std::remove("obj_test.mtl");
+    }
+
+    // Polygons, negative indices and malformed input
+    {
+        ObjMeshData mesh;
+        ParseText("v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv -1 .5 0\nf 1 2 3 4 5\n", mesh);
+        Check(mesh.GetTriangleCount() == 3 && mesh.GetVertexCount() == 5, "Polygons are fan-triangulated");
+        Check(mesh.indices.size() == 9 && mesh.indices[0] == mesh.indices[3] && mesh.indices[3] == mesh.indices[6],
+              "Fan triangles share the first corner");
+
+        ParseText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf -3 -2 -1\nv 5 5 5\nf 1 -2 -1\n", mesh);
+        Check(mesh.GetTriangleCount() == 2 && mesh.GetVertexCount() == 4, "Negative indices count back from the current vertex");
+        Check(mesh.positions.size() == 12 && mesh.positions[mesh.indices[5] * 3] == 5.0f, "Negative indices resolve to the latest vertices");
+
+        ParseText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 7\nf 1 x 3\nf 1 2\nf 1 2 3\n", mesh);
+        Check(mesh.GetTriangleCount() == 1, "Faces with bad or out of range indices are skipped");
+
+        ParseText("v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\nusemtl A\nusemtl B\nf 1 2 3\nusemtl A\nusemtl A\nf 3 2 1\n", mesh);
+        Check(mesh.submeshes.size() == 3 && mesh.submeshes[0].material.empty() && mesh.submeshes[1].material == "B" &&
+              mesh.submeshes[2].firstIndex == 6, "Empty material ranges are dropped");
+
+        ParseText("", mesh);
+        Check(mesh.indices.empty() && mesh.positions.empty(), "Empty input gives an empty mesh");
+    }
+
+    // Number formats
+    {
+        ObjMeshData mesh;
+        ParseText("v 1e-3 -.5 +2.\r\nv 1.5E+2 0.1234567890123456789012 -0\r\nv\t3\t4\t5 1\r\nf 1 2 3\r\n", mesh);
+        bool ok = mesh.positions.size() == 9;
+        ok = ok && std::fabs(mesh.positions[0] - 0.001f) < 1e-9f && mesh.positions[1] == -0.5f && mesh.positions[2] == 2.0f;
+        ok = ok && mesh.positions[3] == 150.0f && std::fabs(mesh.positions[4] - 0.12345679f) < 1e-7f;
+        ok = ok && mesh.positions[6] == 3.0f && mesh.positions[8] == 5.0f;
+        Check(ok, "Exponents, signs, tabs, CRLF and long mantissas are parsed");
+
+        ParseText("v 1e40 nan 1e-40\nf 1 1 1\n", mesh);
+        Check(mesh.positions.size() == 3 && std::isinf(mesh.positions[0]) && std::isnan(mesh.positions[1]),
+              "Out of range values fall back to strtod");
+    }
+
+    // Large mesh: threaded parsing gives the same result as one thread
+    {
+        const int n = 700;
+        WriteGrid("obj_test_grid.obj", n);
+
+        ObjMeshData single;
+        ObjMeshData threaded;
+        auto start = std::chrono::high_resolution_clock::now();
+        bool singleOk = ObjLoader::Load("obj_test_grid.obj", single, 1);
+        auto middle = std::chrono::high_resolution_clock::now();
+        bool threadedOk = ObjLoader::Load("obj_test_grid.obj", threaded, 8);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        size_t expectedVertices = static_cast<size_t>(n + 1) * (n + 1);
+        Check(singleOk && single.GetTriangleCount() == static_cast<size_t>(n) * n * 2, "Grid triangles are read");
+        Check(single.GetVertexCount() == expectedVertices, "Grid corners are shared between neighbouring quads");
+        Check(threadedOk && threaded.indices == single.indices && threaded.positions == single.positions &&
+              threaded.texCoords == single.texCoords && threaded.normals == single.normals,
+              "Threaded parsing matches single-threaded parsing");
+
+        auto referenceStart = std::chrono::high_resolution_clock::now();
+        std::vector<float> reference;
+        ExpandReference("obj_test_grid.obj", reference);
+        auto referenceEnd = std::chrono::high_resolution_clock::now();
+        Check(SameValues(Expand(threaded), reference), "Grid matches the expanded faces");
+
+        double singleMs = std::chrono::duration<double, std::milli>(middle - start).count();
+        double threadedMs = std::chrono::duration<double, std::milli>(end - middle).count();
+        double referenceMs = std::chrono::duration<double, std::milli>(referenceEnd - referenceStart).count();
+        std::cout << single.GetTriangleCount() << " triangles: 1 thread " << singleMs << " ms, 8 threads "
+                  << threadedMs << " ms, getline/istringstream " << referenceMs << " ms" << std::endl;
+        std::cout << "Vertex data " << single.GetVertexCount() * 8 * sizeof(float) / 1024 << " KB indexed vs "
+                  << single.faceCorners * 8 * sizeof(float) / 1024 << " KB expanded" << std::endl;
+
+        std::remove("obj_test_grid.obj");
+    }
+
+    return TestSummary();
+}
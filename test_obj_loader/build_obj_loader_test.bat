@@ -0,0 +1,18 @@
+@echo off
+echo Building OBJ loader test program...
+
+REM Build OBJ loader test
+g++ -std=c++14 -O2 -I.. ^
+    ObjLoaderTest.cpp ^
+    ..\ObjLoader.cpp ^
+    ..\MappedFile.cpp ^
+    -o obj_loader_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run obj_loader_test.exe from this folder to test the OBJ loader.
+pause
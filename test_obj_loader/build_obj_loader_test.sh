@@ -0,0 +1,19 @@
+#!/bin/bash
+
+# Build OBJ loader test
+echo "Building OBJ loader test program..."
+g++ -std=c++14 -O2 -I.. \
+    ObjLoaderTest.cpp \
+    ../ObjLoader.cpp \
+    ../MappedFile.cpp \
+    -pthread -o obj_loader_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x obj_loader_test
+
+echo "Build complete. Run ./obj_loader_test from this folder to test the OBJ loader."
@@ -6,6 +6,11 @@ if not exist ..\bin\windows mkdir ..\bin\windows
 
 g++ -std=c++14 PerformanceTest.cpp ^
     ..\Scene.cpp ^
+    ..\Coroutine.cpp ^
+    ..\TimerWheel.cpp ^
+    ..\FrustumCuller.cpp ^
+    ..\RenderQueue.cpp ^
+    ..\LodGroup.cpp ^
     ..\GameObject.cpp ^
     ..\PhysicsSystem.cpp ^
     ..\RigidBody.cpp ^
@@ -13,6 +18,18 @@ g++ -std=c++14 PerformanceTest.cpp ^
     ..\EngineTime.cpp ^
     ..\Camera.cpp ^
     ..\Model.cpp ^
+    ..\ObjLoader.cpp ^
+    ..\MeshCache.cpp ^
+    ..\MeshOptimizer.cpp ^
+    ..\MeshSimplifier.cpp ^
+    ..\AssetManager.cpp ^
+    ..\AssetStreamer.cpp ^
+    ..\JobSystem.cpp ^
+    ..\Texture.cpp ^
+    ..\TextureCache.cpp ^
+    ..\TextureAtlas.cpp ^
+    ..\Debugger.cpp ^
+    ..\MappedFile.cpp ^
     ..\CollisionSystem.cpp ^
     -I.. ^
     -lopengl32 -lglu32 ^
@@ -8,6 +8,11 @@ mkdir -p ../bin/linux
 
 g++ -std=c++14 PerformanceTest.cpp \
     ../Scene.cpp \
+    ../Coroutine.cpp \
+    ../TimerWheel.cpp \
+    ../FrustumCuller.cpp \
+    ../RenderQueue.cpp \
+    ../LodGroup.cpp \
     ../GameObject.cpp \
     ../PhysicsSystem.cpp \
     ../RigidBody.cpp \
@@ -15,6 +20,18 @@ g++ -std=c++14 PerformanceTest.cpp \
     ../EngineTime.cpp \
     ../Camera.cpp \
     ../Model.cpp \
+    ../ObjLoader.cpp \
+    ../MeshCache.cpp \
+    ../MeshOptimizer.cpp \
+    ../MeshSimplifier.cpp \
+    ../AssetManager.cpp \
+    ../AssetStreamer.cpp \
+    ../JobSystem.cpp \
+    ../Texture.cpp \
+    ../TextureCache.cpp \
+    ../TextureAtlas.cpp \
+    ../Debugger.cpp \
+    ../MappedFile.cpp \
     ../CollisionSystem.cpp \
     -I.. \
     -o performance_test
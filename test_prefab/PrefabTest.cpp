@@ -0,0 +1,111 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include "../Prefab.h"
+#include "../Model.h"
+#include "../MonoBehaviourLike.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for compiled prefabs and instance pooling
+// Build with build_prefab_test.sh
+
+// GameObject::Render is linked in but never called here
+void Model::Render(const std::vector<PointLight>& lights) {}
+
+class Projectile : public MonoBehaviourLike {
+public:
+    static int constructed;
+    int enables = 0;
+    int disables = 0;
+    int hits = 0;
+
+    Projectile() { constructed++; }
+    void OnEnable() override { enables++; }
+    void OnDisable() override { disables++; }
+};
+
+int Projectile::constructed = 0;
+
+int main() {
+    std::cout << "Prefab Test" << std::endl;
+    std::cout << "===========" << std::endl;
+
+    // Template: root light, one child with a grandchild
+    PointLight muzzleFlash(Vector3(0, 0, 0), Vector3(1, 0.5f, 0), 2.0f, 5.0f);
+    GameObject trail("Trail", Vector3(0, 0, -1));
+    GameObject spark("Spark", Vector3(0, 1, 0));
+    spark.AddLight(PointLight());
+    trail.AddChild(&spark);
+
+    Prefab bullet;
+    bullet.name = "Bullet";
+    bullet.AddLight(&muzzleFlash);
+    bullet.AddChild(&trail);
+    bullet.AddComponent([]() { return std::make_shared<Projectile>(); });
+
+    GameObject* first = bullet.Instantiate(Vector3(10, 0, 0));
+    Check(first != nullptr && bullet.IsCompiled(), "Instantiate compiles the template");
+    Check(first->position.x == 10 && first->lights.size() == 1, "Root gets spawn transform and lights");
+    Check(first->childGameObjects.size() == 1 && first->childGameObjects[0] != &trail,
+          "Children are cloned, not shared with the template");
+
+    GameObject* clonedTrail = first->childGameObjects[0];
+    Check(clonedTrail->GetName() == "Trail" && clonedTrail->position.z == -1, "Child keeps its template data");
+    Check(clonedTrail->childGameObjects.size() == 1 &&
+          clonedTrail->childGameObjects[0]->lights.size() == 1, "Grandchild is linked by fixups");
+    Check(first->GetComponents<Projectile>().size() == 1, "Components are attached to the root");
+
+    // Pool reuse
+    Projectile* projectile = first->GetComponents<Projectile>()[0].get();
+    projectile->InvokeAfter(1.0f, [projectile]() { projectile->hits++; });
+    first->position = Vector3(99, 99, 99);
+    first->lights.clear();
+    bullet.Destroy(first);
+    Check(bullet.GetActiveCount() == 0 && bullet.GetPooledCount() == 1, "Destroy returns the instance to the pool");
+    Check(!first->IsEnabled(), "Pooled instances are disabled");
+    Check(projectile->disables == 1 && projectile->enables == 0, "Destroy calls OnDisable");
+    CoroutineScheduler::GetInstance().Update(2.0f);
+    Check(projectile->hits == 0, "Destroy stops pending callbacks");
+
+    GameObject* second = bullet.Instantiate(Vector3(1, 2, 3));
+    Check(second == first, "Instantiate reuses the pooled instance");
+    Check(second->position.y == 2 && second->lights.size() == 1 && second->IsEnabled(),
+          "Reused instance is restored from the template");
+    Check(Projectile::constructed == 1, "Components are not rebuilt on reuse");
+    Check(projectile->enables == 1 && projectile->disables == 1, "Reused components get only OnEnable");
+
+    // Prewarm and mass spawning
+    bullet.Destroy(second);
+    bullet.Prewarm(256);
+    Check(bullet.GetPooledCount() == 256, "Prewarm fills the pool");
+
+    std::vector<GameObject*> spawned;
+    for (int i = 0; i < 256; i++) {
+        spawned.push_back(bullet.Instantiate(Vector3((float)i, 0, 0)));
+    }
+    Check(bullet.GetActiveCount() == 256 && bullet.GetPooledCount() == 0 && Projectile::constructed == 256,
+          "Spawning from a prewarmed pool creates no new instances");
+    for (GameObject* object : spawned) {
+        bullet.Destroy(object);
+    }
+    Check(bullet.GetPooledCount() == 256, "All instances returned");
+
+    // Recompiling retires live instances of the old layout
+    GameObject* live = bullet.Instantiate(Vector3());
+    bullet.Move(Vector3(0, 0, -1));
+    bullet.Compile();
+    Check(bullet.GetPooledCount() == 0, "Compile drops idle instances");
+    Check(bullet.Owns(live), "Live instance is still tracked");
+    bullet.Destroy(live);
+    Check(!bullet.Owns(live) && bullet.GetPooledCount() == 0, "Stale instance is deleted instead of pooled");
+
+    GameObject* moved = bullet.Instantiate(Vector3());
+    Check(moved->childGameObjects[0]->position.z == -2, "New instances use the edited template");
+
+    GameObject stranger;
+    bullet.Destroy(&stranger);
+    Check(bullet.GetActiveCount() == 1, "Foreign objects are ignored");
+
+    return TestSummary();
+}
@@ -0,0 +1,17 @@
+@echo off
+echo Building prefab test program...
+
+REM Build prefab test
+g++ -std=c++14 -I.. ^
+    PrefabTest.cpp ^
+    ..\Prefab.cpp ..\GameObject.cpp ..\Coroutine.cpp ..\TimerWheel.cpp ..\Matrix4x4.cpp ^
+    -o prefab_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run prefab_test.exe to test prefab pooling.
+pause
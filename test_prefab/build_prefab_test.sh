@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Build prefab test
+echo "Building prefab test program..."
+g++ -std=c++14 -I.. \
+    PrefabTest.cpp \
+    ../Prefab.cpp ../GameObject.cpp ../Coroutine.cpp ../TimerWheel.cpp ../Matrix4x4.cpp \
+    -o prefab_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x prefab_test
+
+echo "Build complete. Run ./prefab_test to test prefab pooling."
@@ -0,0 +1,224 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include "../RenderQueue.h"
+#include "../Model.h"
+#include "../Graphics/Core/GraphicsAPIFactory.h"
+#include "../Graphics/Core/NullGraphicsAPI.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for render queue sort keys, sorting and instanced draws
+// Build with build_render_queue_test.sh
+
+static RenderQueue::DrawPacket MakePacket(uint64_t key, size_t order) {
+    RenderQueue::DrawPacket packet;
+    packet.key = key;
+    packet.model = nullptr;
+    packet.lodLevel = order;
+    packet.lodFade = 0.0f;
+    return packet;
+}
+
+// GL shader type values, passed through untouched by the null API
+static const int VERTEX_SHADER = 0x8B31;
+static const int FRAGMENT_SHADER = 0x8B30;
+
+// A program on the null API declaring the uniforms of the given vertex source
+static ShaderProgram* MakeProgram(IGraphicsAPI& graphics, const char* vertexSource) {
+    unsigned int vertex = graphics.CreateShader(VERTEX_SHADER);
+    graphics.ShaderSource(vertex, vertexSource);
+    graphics.CompileShader(vertex);
+    unsigned int fragment = graphics.CreateShader(FRAGMENT_SHADER);
+    graphics.ShaderSource(fragment, "#version 330 core\nout vec4 FragColor;\nvoid main() { FragColor = vec4(1.0); }\n");
+    graphics.CompileShader(fragment);
+
+    ShaderProgram* program = new ShaderProgram();
+    graphics.AttachShader(program->GetHandle(), vertex);
+    graphics.AttachShader(program->GetHandle(), fragment);
+    graphics.LinkProgram(program->GetHandle());
+    program->SetHandle(program->GetHandle());
+    return program;
+}
+
+// A triangle with its own vertex array
+static void MakeMesh(Model& model, ShaderProgram* program, const Vector3& position) {
+    model.vertices = { 0.0f, 1.0f, 0.0f, -1.0f, -1.0f, 0.0f, 1.0f, -1.0f, 0.0f };
+    model.normals = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+    model.texCoords = { 0.5f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+    model.indices = { 0, 1, 2 };
+    model.position = position;
+    model.SetShaderProgram(program);
+    model.InitializeBuffers();
+}
+
+int main() {
+    std::cout << "Render Queue Test" << std::endl;
+    std::cout << "=================" << std::endl;
+
+    const RenderQueue::Pass opaque = RenderQueue::OPAQUE_PASS;
+    const RenderQueue::Pass transparent = RenderQueue::TRANSPARENT_PASS;
+
+    // Keys
+    {
+        Check(RenderQueue::MakeKey(0, transparent, 9, 9, 9, 100.0f) < RenderQueue::MakeKey(1, opaque, 1, 1, 1, 1.0f),
+              "Layers draw in order");
+        Check(RenderQueue::MakeKey(0, opaque, 9, 9, 9, 100.0f) < RenderQueue::MakeKey(0, transparent, 1, 1, 1, 1.0f),
+              "Opaque draws come before transparent ones");
+        Check(RenderQueue::MakeKey(0, opaque, 1, 5, 5, 100.0f) < RenderQueue::MakeKey(0, opaque, 2, 1, 1, 1.0f),
+              "Opaque draws are grouped by program");
+        Check(RenderQueue::MakeKey(0, opaque, 1, 1, 5, 100.0f) < RenderQueue::MakeKey(0, opaque, 1, 2, 1, 1.0f),
+              "Opaque draws are grouped by texture within a program");
+        Check(RenderQueue::MakeKey(0, opaque, 1, 1, 1, 2.0f) < RenderQueue::MakeKey(0, opaque, 1, 1, 1, 2.5f) &&
+              RenderQueue::MakeKey(0, opaque, 1, 1, 1, 0.01f) < RenderQueue::MakeKey(0, opaque, 1, 1, 1, 500.0f),
+              "Opaque draws go front to back");
+        Check(RenderQueue::MakeKey(0, transparent, 1, 1, 1, 50.0f) < RenderQueue::MakeKey(0, transparent, 9, 9, 9, 10.0f),
+              "Transparent draws go back to front whatever they bind");
+        Check(RenderQueue::MakeKey(0, opaque, 1, 1, 1, -3.0f) == RenderQueue::MakeKey(0, opaque, 1, 1, 1, 0.0f),
+              "Depths behind the camera count as 0");
+    }
+
+    // Sorting
+    {
+        std::mt19937_64 random(7);
+        std::vector<RenderQueue::DrawPacket> packets;
+        for (size_t i = 0; i < 5000; i++) {
+            // Few distinct keys, so stability is exercised too
+            uint64_t key = random() % 300;
+            key = (key << 40) | (key * 0x9E3779B1ULL & 0xFFFFFF);
+            packets.push_back(MakePacket(key, i));
+        }
+
+        std::vector<RenderQueue::DrawPacket> expected = packets;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const RenderQueue::DrawPacket& a, const RenderQueue::DrawPacket& b) { return a.key < b.key; });
+
+        std::vector<RenderQueue::DrawPacket> scratch;
+        RenderQueue::RadixSort(packets, scratch);
+
+        bool same = packets.size() == expected.size();
+        for (size_t i = 0; same && i < packets.size(); i++) {
+            same = packets[i].key == expected[i].key && packets[i].lodLevel == expected[i].lodLevel;
+        }
+        Check(same, "Radix sort matches a stable sort");
+
+        std::vector<RenderQueue::DrawPacket> full;
+        for (size_t i = 0; i < 1000; i++) {
+            full.push_back(MakePacket(random(), i));
+        }
+        RenderQueue::RadixSort(full, scratch);
+        bool sorted = true;
+        for (size_t i = 1; i < full.size(); i++) {
+            sorted = sorted && full[i - 1].key <= full[i].key;
+        }
+        Check(sorted, "Keys using all 64 bits sort");
+
+        std::vector<RenderQueue::DrawPacket> single(1, MakePacket(42, 0));
+        RenderQueue::RadixSort(single, scratch);
+        Check(single.size() == 1 && single[0].key == 42, "A single packet is left alone");
+    }
+
+    // Queueing
+    {
+        RenderQueue queue;
+        Model model;
+        Check(!queue.Add(&model, 1.0f) && queue.GetSize() == 0, "Models without buffers are not queued");
+        Check(!queue.Add(nullptr, 1.0f), "Null models are not queued");
+
+        queue.Submit(nullptr);
+        Check(queue.GetStats().draws == 0, "Submit without a graphics API draws nothing");
+    }
+
+    // Instanced draws
+    {
+        GraphicsAPIFactory& factory = GraphicsAPIFactory::GetInstance();
+        factory.SetBackend(GraphicsBackend::NULL_API);
+        factory.SetTraceFile("");
+        factory.Initialize();
+        std::shared_ptr<IGraphicsAPI> graphics = factory.GetGraphicsAPI();
+        NullGraphicsAPI* null = dynamic_cast<NullGraphicsAPI*>(graphics.get());
+
+        const char* modelUniform =
+            "#version 330 core\nlayout (location = 0) in vec3 aPos;\nuniform mat4 model;\nuniform float lodFade;\n"
+            "void main() { gl_Position = model * vec4(aPos, 1.0); }\n";
+        ShaderProgram* plain = MakeProgram(*graphics, modelUniform);
+        ShaderProgram* lit = MakeProgram(*graphics, modelUniform);
+        ShaderProgram* litInstanced = MakeProgram(*graphics,
+            "#version 330 core\nlayout (location = 0) in vec3 aPos;\nlayout (location = 3) in mat4 instanceModel;\n"
+            "uniform float lodFade;\nvoid main() { gl_Position = instanceModel * vec4(aPos, 1.0); }\n");
+        lit->SetInstancedVariant(litInstanced);
+
+        // A forest of one mesh, loaded once and shared
+        const size_t treeCount = 50;
+        std::vector<Model> trees(treeCount);
+        bool loaded = true;
+        for (size_t i = 0; i < treeCount; i++) {
+            loaded = loaded && trees[i].LoadFromFile("../test_assets/cube.obj");
+            trees[i].SetShaderProgram(lit);
+            trees[i].position = Vector3(static_cast<float>(i), 0.0f, 10.0f);
+        }
+        // The same mesh drawn with a program that cannot instance, and a
+        // mesh of its own
+        std::vector<Model> plainTrees(2);
+        for (Model& model : plainTrees) {
+            loaded = loaded && model.LoadFromFile("../test_assets/cube.obj");
+            model.SetShaderProgram(plain);
+        }
+        Model bush;
+        MakeMesh(bush, lit, Vector3(5.0f, 0.0f, 0.0f));
+        Check(loaded && trees[0].GetVertexArray() != 0 && trees[0].GetVertexArray() == trees[1].GetVertexArray(),
+              "Models of one file share a vertex array");
+        Check(bush.GetModelMatrix().elements[0][3] == 5.0f, "Model matrix carries the position");
+
+        RenderQueue queue;
+        auto queueAll = [&]() {
+            queue.Clear();
+            for (size_t i = 0; i < treeCount; i++) {
+                queue.Add(&trees[i], 10.0f + i);
+            }
+            for (Model& model : plainTrees) {
+                queue.Add(&model, 1.0f);
+            }
+            queue.Add(&bush, 5.0f);
+            queue.Sort();
+        };
+
+        const size_t cubeIndices = trees[0].GetIndices().size();
+        queueAll();
+        null->SwapBuffers();
+        queue.Submit(graphics.get());
+        null->SwapBuffers();
+        const RenderQueue::Stats& stats = queue.GetStats();
+        const NullGraphicsAPI::Stats& frame = null->GetLastFrameStats();
+        Check(stats.instancedDraws == 1 && stats.instances == treeCount, "Repeated models draw as one");
+        Check(stats.draws == 4 && frame.drawCalls == 4, "Other models draw on their own");
+        Check(frame.instances == treeCount + 3 && frame.vertices == cubeIndices * (treeCount + 2) + 3,
+              "Every copy is drawn");
+        Check(frame.uniformUpdates == 7, "Instances upload no model uniform");
+        Check(stats.programBinds == 3, "Instanced variant is bound for the instanced draw");
+
+        // A crossfading copy has a uniform of its own
+        trees[0].SetLod(0, 0.5f);
+        queueAll();
+        queue.Submit(graphics.get());
+        Check(queue.GetStats().instancedDraws == 1 && queue.GetStats().instances == treeCount - 1 &&
+              queue.GetStats().draws == 5, "Crossfading copy breaks the run");
+        trees[0].SetLod(0, 0.0f);
+
+        queue.SetInstancingEnabled(false);
+        queueAll();
+        null->SwapBuffers();
+        queue.Submit(graphics.get());
+        null->SwapBuffers();
+        Check(queue.GetStats().instancedDraws == 0 && queue.GetStats().draws == treeCount + 3 &&
+              null->GetLastFrameStats().uniformUpdates == 2 * (treeCount + 3), "Instancing can be turned off");
+
+        queue.ReleaseBuffers(graphics.get());
+        delete plain;
+        delete lit;
+        delete litInstanced;
+    }
+
+    return TestSummary();
+}
@@ -0,0 +1,64 @@
+#!/bin/bash
+
+# Build render queue test
+echo "Building render queue test program..."
+g++ -std=c++14 -I.. \
+    RenderQueueTest.cpp \
+    ../WorldPartition.cpp \
+    ../JobSystem.cpp \
+    ../SceneSerializer.cpp \
+    ../BinaryScene.cpp \
+    ../Scene.cpp \
+    ../FrustumCuller.cpp \
+    ../RenderQueue.cpp \
+    ../LodGroup.cpp \
+    ../SceneLoadOperation.cpp \
+    ../SceneSnapshot.cpp \
+    ../EventBus.cpp \
+    ../Coroutine.cpp \
+    ../TimerWheel.cpp \
+    ../Camera.cpp \
+    ../CameraManager.cpp \
+    ../GameObject.cpp \
+    ../RigidBody.cpp \
+    ../TriggerVolume.cpp \
+    ../PhysicsSystem.cpp \
+    ../TimeManager.cpp \
+    ../EngineCondition.cpp \
+    ../Vector3.cpp \
+    ../Matrix4x4.cpp \
+    ../Model.cpp \
+    ../ObjLoader.cpp \
+    ../MeshCache.cpp \
+    ../MeshOptimizer.cpp \
+    ../MeshSimplifier.cpp \
+    ../AssetManager.cpp \
+    ../AssetStreamer.cpp \
+    ../Texture.cpp \
+    ../TextureCache.cpp \
+    ../TextureAtlas.cpp \
+    ../Debugger.cpp \
+    ../MappedFile.cpp \
+    ../Shaders/Core/Shader.cpp \
+    ../Shaders/Core/ShaderPreprocessor.cpp \
+    ../Shaders/Core/ShaderSourceCache.cpp \
+    ../Shaders/Core/ShaderProgram.cpp \
+    ../Shaders/Core/ShaderUniforms.cpp \
+    ../Shaders/Core/ShaderError.cpp \
+    ../Graphics/Core/GraphicsAPIFactory.cpp \
+    ../Graphics/Core/NullGraphicsAPI.cpp \
+    ../Graphics/Core/RecordingGraphicsAPI.cpp \
+    ../Graphics/Core/GraphicsTrace.cpp \
+    ../Graphics/Core/OpenGLGraphicsAPI.cpp \
+    ../Graphics/Core/GLStateCache.cpp \
+    -lGL -lGLEW -pthread -o render_queue_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x render_queue_test
+
+echo "Build complete. Run ./render_queue_test to test the render queue."
@@ -6,6 +6,11 @@ if not exist ..\bin\windows mkdir ..\bin\windows
 
 g++ -std=c++14 MultiCameraTest.cpp ^
     ..\Scene.cpp ^
+    ..\Coroutine.cpp ^
+    ..\TimerWheel.cpp ^
+    ..\FrustumCuller.cpp ^
+    ..\RenderQueue.cpp ^
+    ..\LodGroup.cpp ^
     ..\Camera.cpp ^
     ..\CameraManager.cpp ^
     ..\GameObject.cpp ^
@@ -13,6 +18,18 @@ g++ -std=c++14 MultiCameraTest.cpp ^
     ..\EngineTime.cpp ^
     ..\PhysicsSystem.cpp ^
     ..\Model.cpp ^
+    ..\ObjLoader.cpp ^
+    ..\MeshCache.cpp ^
+    ..\MeshOptimizer.cpp ^
+    ..\MeshSimplifier.cpp ^
+    ..\AssetManager.cpp ^
+    ..\AssetStreamer.cpp ^
+    ..\JobSystem.cpp ^
+    ..\Texture.cpp ^
+    ..\TextureCache.cpp ^
+    ..\TextureAtlas.cpp ^
+    ..\Debugger.cpp ^
+    ..\MappedFile.cpp ^
     -I.. -I..\ThirdParty ^
     -lopengl32 -lglu32 -lSDL2 ^
     -o multicamera_test.exe
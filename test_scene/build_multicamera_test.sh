@@ -8,6 +8,11 @@ mkdir -p ../bin/linux
 
 g++ -std=c++14 MultiCameraTest.cpp \
     ../Scene.cpp \
+    ../Coroutine.cpp \
+    ../TimerWheel.cpp \
+    ../FrustumCuller.cpp \
+    ../RenderQueue.cpp \
+    ../LodGroup.cpp \
     ../Camera.cpp \
     ../CameraManager.cpp \
     ../GameObject.cpp \
@@ -15,6 +20,18 @@ g++ -std=c++14 MultiCameraTest.cpp \
     ../EngineTime.cpp \
     ../PhysicsSystem.cpp \
     ../Model.cpp \
+    ../ObjLoader.cpp \
+    ../MeshCache.cpp \
+    ../MeshOptimizer.cpp \
+    ../MeshSimplifier.cpp \
+    ../AssetManager.cpp \
+    ../AssetStreamer.cpp \
+    ../JobSystem.cpp \
+    ../Texture.cpp \
+    ../TextureCache.cpp \
+    ../TextureAtlas.cpp \
+    ../Debugger.cpp \
+    ../MappedFile.cpp \
     -I.. -I../ThirdParty \
     -lGL -lGLU -lSDL2 \
     -o multicamera_test
@@ -7,6 +7,11 @@ mkdir -p ../bin/linux
 g++ -std=c++14 \
     SceneTransitionTest.cpp \
     ../Scene.cpp \
+    ../Coroutine.cpp \
+    ../TimerWheel.cpp \
+    ../FrustumCuller.cpp \
+    ../RenderQueue.cpp \
+    ../LodGroup.cpp \
     ../GameObject.cpp \
     ../Vector3.cpp \
     ../EngineTime.cpp \
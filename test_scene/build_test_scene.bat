@@ -14,8 +14,16 @@ g++ -std=c++14 TestSceneObjects.cpp ^
     ..\CollisionSystem.cpp ^
     ..\GameObject.cpp ^
     ..\Scene.cpp ^
+    ..\Coroutine.cpp ^
+    ..\TimerWheel.cpp ^
+    ..\FrustumCuller.cpp ^
+    ..\RenderQueue.cpp ^
+    ..\LodGroup.cpp ^
     ..\Vector3.cpp ^
     ..\Audio\AudioSystem.cpp ^
+    ..\AssetManager.cpp ^
+    ..\AssetStreamer.cpp ^
+    ..\JobSystem.cpp ^
     ..\Audio\AudioSource.cpp ^
     ..\Audio\AudioClip.cpp ^
     ..\Audio\AudioListener.cpp ^
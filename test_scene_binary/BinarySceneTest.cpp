@@ -0,0 +1,192 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include "../BinaryScene.h"
+#include "../SceneSerializer.h"
+#include "../GameObject.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the binary scene format and the JSON converter
+// Build with build_binary_scene_test.sh
+
+static nlohmann::json ReadJson(const std::string& path) {
+    std::ifstream file(path);
+    nlohmann::json json;
+    file >> json;
+    return json;
+}
+
+static void WriteJson(const std::string& path, const nlohmann::json& json) {
+    std::ofstream file(path);
+    file << json.dump();
+}
+
+// JSON -> binary -> JSON gives back the same document. Compared as text,
+// since json's == treats 1 and 1.0 as equal.
+static bool RoundTrips(const std::string& path) {
+    return BinaryScene::ConvertJsonToBinary(path, "binary_test.savscene") &&
+           BinaryScene::ConvertBinaryToJson("binary_test.savscene", "binary_test_back.json") &&
+           ReadJson("binary_test_back.json").dump() == ReadJson(path).dump();
+}
+
+static bool SameObject(const GameObject* a, const GameObject* b) {
+    if (a->GetName() != b->GetName() || a->GetPosition() != b->GetPosition() ||
+        a->GetRotation() != b->GetRotation() || a->GetScale() != b->GetScale() ||
+        a->lights.size() != b->lights.size() || a->childGameObjects.size() != b->childGameObjects.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a->lights.size(); i++) {
+        if (a->lights[i].GetColor() != b->lights[i].GetColor() ||
+            a->lights[i].GetIntensity() != b->lights[i].GetIntensity() ||
+            a->lights[i].GetRange() != b->lights[i].GetRange()) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < a->childGameObjects.size(); i++) {
+        if (!SameObject(a->childGameObjects[i], b->childGameObjects[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "Binary Scene Test" << std::endl;
+    std::cout << "=================" << std::endl;
+
+    // The example scenes convert losslessly
+    Check(RoundTrips("../Examples/RPG/Scenes/main_world.json"), "main_world.json round trips");
+    Check(RoundTrips("../Examples/RPG/Scenes/cave.json"), "cave.json round trips");
+
+    // Unusual documents round trip too
+    nlohmann::json odd = nlohmann::json::parse(R"({
+        "sceneName": "Odd",
+        "version": 3,
+        "environment": { "fog": [0.1, 0.2] },
+        "objects": [
+            { "name": "Root", "position": {"x": 0.1, "y": -2.5, "z": 1e-3}, "tag": "enemy",
+              "components": [], "children": [
+                { "position": [1, 2, 3], "children": [ { "name": "Leaf", "scale": {"x": 2, "y": 2, "z": 2} } ] },
+                { "name": "Lamp", "components": [
+                    { "type": "Light", "properties": { "color": {"r": 0.3, "g": 0.6, "b": 0.9}, "intensity": 2, "range": 5, "flicker": true } },
+                    { "type": "Marker" } ] } ] },
+            { "name": 42, "rotation": {"x": 0, "y": 90, "z": 0, "w": 1} }
+        ]
+    })");
+    WriteJson("binary_test_odd.json", odd);
+    Check(RoundTrips("binary_test_odd.json"), "Unknown keys, empty arrays and odd values round trip");
+
+    // Numbers a float cannot hold keep their exact value and type
+    nlohmann::json precise = nlohmann::json::parse(R"({
+        "objects": [
+            { "name": "Far", "position": {"x": 123456.789012345, "y": 0.1, "z": 1.0},
+              "rotation": {"x": 0, "y": 1.5, "z": 0}, "scale": {"x": 1.0, "y": 1.0, "z": 1.0} }
+        ]
+    })");
+    WriteJson("binary_test_precise.json", precise);
+    Check(RoundTrips("binary_test_precise.json"), "Doubles and integral floats round trip exactly");
+    {
+        BinaryScene scene;
+        Check(scene.Open("binary_test.savscene") && scene.GetObjectCount() == 1 &&
+              scene.GetObjects()[0].position[0] == 123456.789012345f && scene.GetObjects()[0].scale[1] == 1.0f,
+              "Records still hold the values as floats");
+    }
+
+    // The table of contents describes fixed-size sections
+    {
+        BinaryScene::ConvertJsonToBinary("binary_test_odd.json", "binary_test.savscene");
+        BinaryScene scene;
+        Check(scene.Open("binary_test.savscene") && scene.GetObjectCount() == 5 && scene.GetLightCount() == 1 &&
+              scene.GetComponentCount() == 2, "Records are readable in place");
+        Check(std::string(scene.GetString(scene.GetScene()->name)) == "Odd", "Strings resolve from the table");
+    }
+
+    // Loading the binary file gives the same objects as loading the JSON
+    nlohmann::json level = nlohmann::json::parse(R"({
+        "sceneName": "Level",
+        "objects": [
+            { "name": "Root", "position": {"x": 0.1, "y": -2.5, "z": 3}, "children": [
+                { "name": "Child", "rotation": {"x": 0, "y": 45, "z": 0}, "children": [ { "name": "Leaf" } ] },
+                { "name": "Lamp", "components": [
+                    { "type": "Light", "properties": { "color": {"r": 0.3, "g": 0.6, "b": 0.9}, "intensity": 2, "range": 5 } },
+                    { "type": "Marker", "properties": { "id": 7 } } ] } ] },
+            { "scale": {"x": 2, "y": 1, "z": 0.5} }
+        ]
+    })");
+    WriteJson("binary_test_level.json", level);
+    BinaryScene::ConvertJsonToBinary("binary_test_level.json", "binary_test.savscene");
+
+    std::vector<GameObject*> fromJson;
+    std::vector<GameObject*> fromBinary;
+    Check(SceneSerializer::LoadSceneFile("binary_test_level.json", fromJson) &&
+          SceneSerializer::LoadSceneFile("binary_test.savscene", fromBinary), "Both formats load through LoadSceneFile");
+    bool same = fromJson.size() == 2 && fromBinary.size() == 2;
+    for (size_t i = 0; same && i < fromJson.size(); i++) {
+        same = SameObject(fromJson[i], fromBinary[i]);
+    }
+    Check(same, "Binary and JSON scenes build identical objects");
+    Check(fromBinary.size() == 2 && fromBinary[0]->childGameObjects.size() == 2 &&
+          fromBinary[0]->childGameObjects[1]->lights.size() == 1, "Hierarchy and lights are restored");
+    SceneSerializer::DestroySceneObjects(fromJson);
+    SceneSerializer::DestroySceneObjects(fromBinary);
+
+    // Damaged files are rejected
+    {
+        std::ifstream in("binary_test.savscene", std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out("binary_test_truncated.savscene", std::ios::binary);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+        out.close();
+
+        BinaryScene scene;
+        Check(!scene.Open("binary_test_truncated.savscene"), "Truncated file is rejected");
+        Check(!BinaryScene::IsBinarySceneFile("binary_test_odd.json"), "JSON is not mistaken for a binary scene");
+    }
+
+    // Large scene: binary loading avoids the JSON parse
+    {
+        nlohmann::json big;
+        big["sceneName"] = "Big";
+        big["objects"] = nlohmann::json::array();
+        for (int i = 0; i < 50000; i++) {
+            nlohmann::json object;
+            object["name"] = "Object" + std::to_string(i);
+            object["position"] = { {"x", i * 0.5f}, {"y", 0}, {"z", -i * 0.25f} };
+            object["rotation"] = { {"x", 0}, {"y", i % 360}, {"z", 0} };
+            object["scale"] = { {"x", 1}, {"y", 1}, {"z", 1} };
+            big["objects"].push_back(object);
+        }
+        WriteJson("binary_test_big.json", big);
+        BinaryScene::ConvertJsonToBinary("binary_test_big.json", "binary_test_big.savscene");
+
+        std::vector<GameObject*> objects;
+        auto start = std::chrono::steady_clock::now();
+        bool jsonOk = SceneSerializer::LoadSceneFile("binary_test_big.json", objects);
+        double jsonMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        size_t jsonCount = objects.size();
+        SceneSerializer::DestroySceneObjects(objects);
+
+        start = std::chrono::steady_clock::now();
+        bool binaryOk = SceneSerializer::LoadSceneFile("binary_test_big.savscene", objects);
+        double binaryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        size_t binaryCount = objects.size();
+        SceneSerializer::DestroySceneObjects(objects);
+
+        std::cout << "50000 objects: JSON " << jsonMs << " ms, binary " << binaryMs << " ms" << std::endl;
+        Check(jsonOk && binaryOk && jsonCount == 50000 && binaryCount == 50000, "Large scene loads in both formats");
+    }
+
+    std::remove("binary_test.savscene");
+    std::remove("binary_test_back.json");
+    std::remove("binary_test_odd.json");
+    std::remove("binary_test_precise.json");
+    std::remove("binary_test_level.json");
+    std::remove("binary_test_truncated.savscene");
+    std::remove("binary_test_big.json");
+    std::remove("binary_test_big.savscene");
+
+    return TestSummary();
+}
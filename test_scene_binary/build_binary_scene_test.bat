@@ -0,0 +1,48 @@
+@echo off
+echo Building binary scene test program...
+
+REM Build binary scene test
+g++ -std=c++14 -I.. ^
+    BinarySceneTest.cpp ^
+    ..\BinaryScene.cpp ^
+    ..\SceneSerializer.cpp ^
+    ..\GameObject.cpp ^
+    ..\Coroutine.cpp ^
+    ..\TimerWheel.cpp ^
+    ..\Vector3.cpp ^
+    ..\Matrix4x4.cpp ^
+    ..\Model.cpp ^
+    ..\ObjLoader.cpp ^
+    ..\MeshCache.cpp ^
+    ..\MeshOptimizer.cpp ^
+    ..\MeshSimplifier.cpp ^
+    ..\AssetManager.cpp ^
+    ..\AssetStreamer.cpp ^
+    ..\JobSystem.cpp ^
+    ..\Texture.cpp ^
+    ..\TextureCache.cpp ^
+    ..\TextureAtlas.cpp ^
+    ..\Debugger.cpp ^
+    ..\MappedFile.cpp ^
+    ..\Shaders\Core\Shader.cpp ^
+    ..\Shaders\Core\ShaderPreprocessor.cpp ^
+    ..\Shaders\Core\ShaderSourceCache.cpp ^
+    ..\Shaders\Core\ShaderProgram.cpp ^
+    ..\Shaders\Core\ShaderUniforms.cpp ^
+    ..\Shaders\Core\ShaderError.cpp ^
+    ..\Graphics\Core\GraphicsAPIFactory.cpp ^
+    ..\Graphics\Core\NullGraphicsAPI.cpp ^
+    ..\Graphics\Core\RecordingGraphicsAPI.cpp ^
+    ..\Graphics\Core\GraphicsTrace.cpp ^
+    ..\Graphics\Core\OpenGLGraphicsAPI.cpp ^
+    ..\Graphics\Core\GLStateCache.cpp ^
+    -lopengl32 -lglew32 -o binary_scene_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run binary_scene_test.exe to test binary scenes.
+pause
@@ -0,0 +1,49 @@
+#!/bin/bash
+
+# Build binary scene test
+echo "Building binary scene test program..."
+g++ -std=c++14 -I.. \
+    BinarySceneTest.cpp \
+    ../BinaryScene.cpp \
+    ../SceneSerializer.cpp \
+    ../GameObject.cpp \
+    ../Coroutine.cpp \
+    ../TimerWheel.cpp \
+    ../Vector3.cpp \
+    ../Matrix4x4.cpp \
+    ../Model.cpp \
+    ../ObjLoader.cpp \
+    ../MeshCache.cpp \
+    ../MeshOptimizer.cpp \
+    ../MeshSimplifier.cpp \
+    ../AssetManager.cpp \
+    ../AssetStreamer.cpp \
+    ../JobSystem.cpp \
+    ../Texture.cpp \
+    ../TextureCache.cpp \
+    ../TextureAtlas.cpp \
+    ../Debugger.cpp \
+    ../MappedFile.cpp \
+    ../Shaders/Core/Shader.cpp \
+    ../Shaders/Core/ShaderPreprocessor.cpp \
+    ../Shaders/Core/ShaderSourceCache.cpp \
+    ../Shaders/Core/ShaderProgram.cpp \
+    ../Shaders/Core/ShaderUniforms.cpp \
+    ../Shaders/Core/ShaderError.cpp \
+    ../Graphics/Core/GraphicsAPIFactory.cpp \
+    ../Graphics/Core/NullGraphicsAPI.cpp \
+    ../Graphics/Core/RecordingGraphicsAPI.cpp \
+    ../Graphics/Core/GraphicsTrace.cpp \
+    ../Graphics/Core/OpenGLGraphicsAPI.cpp \
+    ../Graphics/Core/GLStateCache.cpp \
+    -lGL -lGLEW -o binary_scene_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x binary_scene_test
+
+echo "Build complete. Run ./binary_scene_test to test binary scenes."
@@ -0,0 +1,140 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "../Scene.h"
+#include "../SceneLoadOperation.h"
+#include "../SceneSerializer.h"
+#include "../GameObject.h"
+#include "../Model.h"
+#include "../JobSystem.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for synchronous and asynchronous scene loading
+// Build with build_scene_load_test.sh
+
+// Write a scene with `count` objects, each with a mesh and a child
+static void WriteScene(const std::string& path, const std::string& prefix, int count) {
+    std::ofstream file(path);
+    file << "{ \"sceneName\": \"" << prefix << "\", \"objects\": [";
+    for (int i = 0; i < count; i++) {
+        file << (i ? "," : "") << "{ \"name\": \"" << prefix << "_" << i << "\", "
+             << "\"position\": {\"x\": " << i << ", \"y\": 0, \"z\": 0}, "
+             << "\"components\": [ { \"type\": \"Mesh\", \"properties\": { \"model\": \"scene_load_test.obj\" } } ], "
+             << "\"children\": [ { \"name\": \"" << prefix << "_" << i << "_child\" } ] }";
+    }
+    file << "] }";
+}
+
+// Let the worker finish, then finalize until the load completes
+static int FinishLoad(Scene& scene, const std::shared_ptr<SceneLoadOperation>& load) {
+    JobSystem::GetInstance().WaitIdle();
+    int frames = 0;
+    while (!load->IsDone() && frames < 1000) {
+        scene.FinalizeLoads();
+        frames++;
+    }
+    return frames;
+}
+
+int main() {
+    std::cout << "Scene Load Test" << std::endl;
+    std::cout << "===============" << std::endl;
+
+    std::ofstream obj("scene_load_test.obj");
+    obj << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+    obj.close();
+    WriteScene("scene_load_small.json", "small", 3);
+    WriteScene("scene_load_big.json", "big", 20);
+
+    // Synchronous load
+    {
+        Scene scene;
+        Check(scene.Load("scene_load_small.json") && scene.gameObjects.size() == 3, "Load adds every object");
+        GameObject* first = scene.FindGameObject("small_0");
+        Check(first && first->childGameObjects.size() == 1, "Children are loaded");
+        Check(first && first->meshes.size() == 1 && first->meshes[0]->GetVertices().size() == 9, "Mesh components are parsed");
+        Check(!scene.Load("scene_load_missing.json") && scene.gameObjects.size() == 3, "Missing file fails without side effects");
+    }
+
+    // Asynchronous load, spread over frames
+    {
+        Scene scene;
+        scene.SetLoadBudget(0.0f);
+
+        int callbacks = 0;
+        std::shared_ptr<SceneLoadOperation> load = scene.LoadAsync("scene_load_big.json");
+        load->OnComplete([&callbacks](SceneLoadOperation& op) {
+            callbacks += op.Succeeded() ? 1 : 100;
+        });
+        Check(load->GetStatus() == SceneLoadOperation::Status::PARSING && load->GetProgress() <= 0.5f,
+              "LoadAsync returns while parsing");
+        Check(scene.gameObjects.empty(), "Nothing is added while parsing");
+
+        JobSystem::GetInstance().WaitIdle();
+        Check(load->GetStatus() == SceneLoadOperation::Status::PARSING && load->GetProgress() == 0.5f,
+              "Progress reaches 0.5 once the file is parsed");
+        scene.FinalizeLoads();
+        Check(load->GetStatus() == SceneLoadOperation::Status::FINALIZING, "Parsed load finalizes on the main thread");
+        float progress = load->GetProgress();
+        Check(progress > 0.5f && progress < 1.0f, "Progress reports finalization");
+        Check(scene.gameObjects.empty(), "Partially finalized objects are not in the scene");
+
+        scene.FinalizeLoads();
+        Check(load->GetProgress() > progress, "Progress advances each frame");
+
+        int frames = FinishLoad(scene, load);
+        Check(frames > 1, "Finalization is spread over several frames");
+        Check(load->Succeeded() && load->GetProgress() == 1.0f, "Load completes");
+        Check(scene.gameObjects.size() == 20, "All objects are added once complete");
+        Check(callbacks == 1, "Completion callback runs once");
+
+        // Callbacks can chain another load
+        std::shared_ptr<SceneLoadOperation> second;
+        std::shared_ptr<SceneLoadOperation> first = scene.LoadAsync("scene_load_small.json");
+        first->OnComplete([&scene, &second](SceneLoadOperation&) {
+            second = scene.LoadAsync("scene_load_small.json");
+        });
+        FinishLoad(scene, first);
+        Check(second && !second->IsDone(), "Completion callback can start a new load");
+        FinishLoad(scene, second);
+        Check(scene.gameObjects.size() == 26, "Chained load completes");
+
+        // Late callbacks run immediately
+        bool late = false;
+        load->OnComplete([&late](SceneLoadOperation&) { late = true; });
+        Check(late, "Callback added after completion runs immediately");
+
+        // Removed objects belong to the caller
+        GameObject* kept = scene.FindGameObject("big_0");
+        scene.RemoveGameObject(kept);
+        scene.Shutdown();
+        Check(kept->GetName() == "big_0", "Removed object survives Shutdown");
+        std::vector<GameObject*> release(1, kept);
+        SceneSerializer::DestroySceneObjects(release);
+    }
+
+    // Failures and shutdown
+    {
+        Scene scene;
+        std::shared_ptr<SceneLoadOperation> missing = scene.LoadAsync("scene_load_missing.json");
+        FinishLoad(scene, missing);
+        Check(missing->GetStatus() == SceneLoadOperation::Status::FAILED, "Missing file fails asynchronously");
+
+        bool notified = false;
+        std::shared_ptr<SceneLoadOperation> abandoned = scene.LoadAsync("scene_load_big.json");
+        abandoned->OnComplete([&notified](SceneLoadOperation& op) { notified = !op.Succeeded(); });
+        scene.Shutdown();
+        Check(abandoned->GetStatus() == SceneLoadOperation::Status::FAILED && notified,
+              "Shutdown fails loads in flight");
+        JobSystem::GetInstance().WaitIdle();
+    }
+
+    std::remove("scene_load_test.obj");
+    std::remove("scene_load_test.obj.savmesh");
+    std::remove("scene_load_small.json");
+    std::remove("scene_load_big.json");
+
+    return TestSummary();
+}
@@ -0,0 +1,210 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../MonoBehaviourLike.h"
+#include "../TimerWheel.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for the timer wheel, the scheduler's callback waits and coroutines
+// Build with build_coroutine_test.sh; the coroutine part needs C++20
+
+static void TestTimerWheel() {
+    std::cout << "\n=== TimerWheel Test ===" << std::endl;
+
+    TimerWheel wheel(0.001f);
+    std::vector<int> fired;
+
+    wheel.Schedule(0.005f, [&]() { fired.push_back(5); });
+    wheel.Schedule(0.100f, [&]() { fired.push_back(100); });
+    wheel.Schedule(10.0f, [&]() { fired.push_back(10000); });
+    TimerWheel::TimerId cancelled = wheel.Schedule(0.050f, [&]() { fired.push_back(50); });
+
+    Check(wheel.GetPendingCount() == 4, "Four timers pending");
+    Check(wheel.Cancel(cancelled), "Cancel pending timer");
+    Check(!wheel.Cancel(cancelled), "Cancel twice fails");
+
+    wheel.Advance(0.004f);
+    Check(fired.empty(), "Nothing fires before its delay");
+
+    wheel.Advance(0.002f);
+    Check(fired.size() == 1 && fired[0] == 5, "5ms timer fires");
+
+    for (int i = 0; i < 100; i++) {
+        wheel.Advance(0.016f);
+    }
+    Check(fired.size() == 2 && fired[1] == 100, "100ms timer fires after cascade, cancelled timer does not");
+
+    for (int i = 0; i < 600; i++) {
+        wheel.Advance(0.016f);
+    }
+    Check(fired.size() == 3 && fired[2] == 10000, "10s timer fires after multi-level cascade");
+    Check(wheel.GetPendingCount() == 0, "No timers left");
+
+    // Timers far beyond the wheel range are parked and re-inserted
+    bool farFired = false;
+    wheel.Schedule(20000.0f, [&]() { farFired = true; });
+    wheel.Advance(19999.0f);
+    Check(!farFired, "Overflow timer waits");
+    wheel.Advance(2.0f);
+    Check(farFired, "Overflow timer fires");
+}
+
+class Door : public MonoBehaviourLike {
+public:
+    int knocks = 0;
+    int fixedSteps = 0;
+    bool opened = false;
+    CoroutineTrigger doorTrigger;
+
+    // Re-schedules itself like a looping coroutine
+    void Knock() {
+        InvokeAfter(0.5f, [this]() {
+            knocks++;
+            Knock();
+        });
+    }
+};
+
+static void TestCallbacks() {
+    std::cout << "\n=== Callback Test ===" << std::endl;
+
+    CoroutineScheduler& scheduler = CoroutineScheduler::GetInstance();
+    scheduler.Clear();
+
+    Door* door = new Door();
+    door->Knock();
+    door->InvokeWhen(door->doorTrigger, [door]() { door->opened = true; });
+    door->InvokeOnFixedUpdate([door]() { door->fixedSteps++; });
+    CoroutineId cancelled = door->InvokeAfter(0.1f, [door]() { door->knocks += 100; });
+    Check(scheduler.GetCoroutineCount() == 4, "Four callbacks pending");
+
+    door->StopCoroutine(cancelled);
+    Check(scheduler.GetCoroutineCount() == 3, "Stopped callback is released");
+
+    // 0.75 seconds of frames
+    for (int i = 0; i < 45; i++) {
+        scheduler.Update(1.0f / 60.0f);
+    }
+    Check(door->knocks == 1, "InvokeAfter runs after 0.5s, cancelled callback does not");
+    Check(!door->opened, "InvokeWhen waits until fired");
+
+    door->doorTrigger.Fire();
+    scheduler.Update(1.0f / 60.0f);
+    Check(door->opened, "InvokeWhen runs after Fire");
+
+    bool immediate = false;
+    door->InvokeWhen(door->doorTrigger, [&]() { immediate = true; });
+    Check(immediate, "InvokeWhen on a fired trigger runs right away");
+
+    for (int i = 0; i < 3; i++) {
+        scheduler.FixedUpdate();
+    }
+    Check(door->fixedSteps == 1, "InvokeOnFixedUpdate runs once");
+    Check(scheduler.GetCoroutineCount() == 1, "Finished callbacks are released");
+
+    delete door;
+    Check(scheduler.GetCoroutineCount() == 0, "Destroying the owner cancels its callbacks");
+
+    // Many idle waiters must not be touched by Update
+    std::vector<Door*> idle;
+    for (int i = 0; i < 10000; i++) {
+        Door* d = new Door();
+        d->InvokeWhen(d->doorTrigger, [d]() { d->opened = true; });
+        idle.push_back(d);
+    }
+    scheduler.Update(1.0f / 60.0f);
+    Check(scheduler.GetCoroutineCount() == 10000, "Idle callbacks stay pending");
+    for (auto d : idle) {
+        delete d;
+    }
+    Check(scheduler.GetCoroutineCount() == 0, "Idle callbacks released");
+}
+
+#if GAMEENGINE_COROUTINES
+class Blinker : public MonoBehaviourLike {
+public:
+    int blinks = 0;
+    int fixedSteps = 0;
+    bool opened = false;
+    CoroutineTrigger doorTrigger;
+
+    Coroutine Blink() {
+        while (true) {
+            co_await WaitSeconds(0.5f);
+            blinks++;
+        }
+    }
+
+    Coroutine WaitForDoor() {
+        co_await WaitUntil(doorTrigger);
+        opened = true;
+    }
+
+    Coroutine CountFixedSteps() {
+        for (int i = 0; i < 3; i++) {
+            co_await WaitForFixedUpdate();
+            fixedSteps++;
+        }
+    }
+};
+
+static void TestCoroutines() {
+    std::cout << "\n=== Coroutine Test ===" << std::endl;
+
+    CoroutineScheduler& scheduler = CoroutineScheduler::GetInstance();
+    scheduler.Clear();
+
+    Blinker* blinker = new Blinker();
+    blinker->StartCoroutine(blinker->Blink());
+    blinker->StartCoroutine(blinker->WaitForDoor());
+    blinker->StartCoroutine(blinker->CountFixedSteps());
+    Check(scheduler.GetCoroutineCount() == 3, "Three coroutines running");
+
+    // 0.75 seconds of frames
+    for (int i = 0; i < 45; i++) {
+        scheduler.Update(1.0f / 60.0f);
+    }
+    Check(blinker->blinks == 1, "WaitSeconds resumes after 0.5s");
+    Check(!blinker->opened, "WaitUntil stays suspended until fired");
+
+    blinker->doorTrigger.Fire();
+    scheduler.Update(1.0f / 60.0f);
+    Check(blinker->opened, "WaitUntil resumes after Fire");
+
+    for (int i = 0; i < 5; i++) {
+        scheduler.FixedUpdate();
+    }
+    Check(blinker->fixedSteps == 3, "WaitForFixedUpdate resumes once per step");
+    Check(scheduler.GetCoroutineCount() == 1, "Finished coroutines are released");
+
+    delete blinker;
+    Check(scheduler.GetCoroutineCount() == 0, "Destroying the owner stops its coroutines");
+
+    // Many idle coroutines must not be touched by Update
+    std::vector<Blinker*> idle;
+    for (int i = 0; i < 10000; i++) {
+        Blinker* b = new Blinker();
+        b->StartCoroutine(b->WaitForDoor());
+        idle.push_back(b);
+    }
+    scheduler.Update(1.0f / 60.0f);
+    Check(scheduler.GetCoroutineCount() == 10000, "Idle coroutines stay suspended");
+    for (auto b : idle) {
+        delete b;
+    }
+    Check(scheduler.GetCoroutineCount() == 0, "Idle coroutines released");
+}
+#endif // GAMEENGINE_COROUTINES
+
+int main() {
+    std::cout << "Coroutine Scripting Test" << std::endl;
+    std::cout << "========================" << std::endl;
+
+    TestTimerWheel();
+    TestCallbacks();
+#if GAMEENGINE_COROUTINES
+    TestCoroutines();
+#endif
+
+    return TestSummary();
+}
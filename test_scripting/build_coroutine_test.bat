@@ -0,0 +1,31 @@
+@echo off
+echo Building coroutine test program...
+
+REM The C++14 build covers the callback waits the engine uses
+g++ -std=c++14 -I.. ^
+    CoroutineTest.cpp ^
+    ..\Coroutine.cpp ^
+    ..\TimerWheel.cpp ^
+    -o coroutine_test_cpp14.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+REM Coroutines need C++20
+g++ -std=c++20 -I.. ^
+    CoroutineTest.cpp ^
+    ..\Coroutine.cpp ^
+    ..\TimerWheel.cpp ^
+    -o coroutine_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run coroutine_test_cpp14.exe and coroutine_test.exe to test coroutine scripting.
+pause
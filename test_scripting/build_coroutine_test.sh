@@ -0,0 +1,31 @@
+#!/bin/bash
+
+# Build coroutine scripting test. The C++14 build covers the callback waits
+# the engine uses; coroutines themselves need C++20
+echo "Building coroutine test program..."
+g++ -std=c++14 -I.. \
+    CoroutineTest.cpp \
+    ../Coroutine.cpp \
+    ../TimerWheel.cpp \
+    -o coroutine_test_cpp14
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+g++ -std=c++20 -I.. \
+    CoroutineTest.cpp \
+    ../Coroutine.cpp \
+    ../TimerWheel.cpp \
+    -o coroutine_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x coroutine_test coroutine_test_cpp14
+
+echo "Build complete. Run ./coroutine_test_cpp14 and ./coroutine_test to test coroutine scripting."
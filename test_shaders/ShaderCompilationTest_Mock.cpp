@@ -1,7 +1,23 @@
 #include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <set>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <sys/stat.h>
+#include "../Shaders/Core/ShaderSourceCache.h"
+
+#if defined(_WIN32)
+#include <direct.h>
+#define MakeFolder(path) _mkdir(path)
+#define RemoveFolder(path) _rmdir(path)
+#else
+#include <unistd.h>
+#define MakeFolder(path) mkdir(path, 0755)
+#define RemoveFolder(path) rmdir(path)
+#endif
 
 // Mock OpenGL types and functions for testing without an OpenGL context
 typedef unsigned int GLuint;
@@ -25,7 +41,8 @@ typedef bool GLboolean;
 // Mock OpenGL functions
 GLuint glCreateShader(GLenum type) { return 1; }
 void glShaderSource(GLuint shader, GLint count, const char** string, const GLint* length) {}
-void glCompileShader(GLuint shader) {}
+int compiledShaders = 0;
+void glCompileShader(GLuint shader) { compiledShaders++; }
 void glGetShaderiv(GLuint shader, GLenum pname, GLint* params) { *params = GL_TRUE; }
 void glGetShaderInfoLog(GLuint shader, GLint maxLength, GLint* length, GLchar* infoLog) {}
 void glDeleteShader(GLuint shader) {}
@@ -414,6 +431,59 @@ public:
         return program;
     }
     
+    // Same as the engine's ShaderAsset::LoadVariant: the real preprocessor
+    // and source cache in front of the mock compiler
+    static ShaderProgram* LoadVariant(const std::string& vertPath,
+                                      const std::string& fragPath,
+                                      const std::vector<std::string>& keywords) {
+        std::string key = vertPath + ":" + fragPath + "|" + ShaderPreprocessor::JoinKeywords(keywords);
+        auto known = variantHashes.find(key);
+        if (known != variantHashes.end()) {
+            return variantPrograms[known->second];
+        }
+        
+        ShaderPreprocessor::Result stages[2];
+        if (!ShaderSourceCache::GetInstance().Get(vertPath, keywords, stages[0]) ||
+            !ShaderSourceCache::GetInstance().Get(fragPath, keywords, stages[1])) {
+            return nullptr;
+        }
+        uint64_t hash = 0;
+        std::set<std::string> declared;
+        for (const ShaderPreprocessor::Result& stage : stages) {
+            hash ^= ShaderSourceCache::Hash(stage.source) + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+            declared.insert(stage.keywords.begin(), stage.keywords.end());
+        }
+        for (const std::string& keyword : ShaderPreprocessor::Canonicalize(keywords)) {
+            if (declared.count(keyword) == 0) {
+                std::cerr << "Error: Unknown shader keyword " << keyword << " for " << key << std::endl;
+                return nullptr;
+            }
+        }
+        
+        auto shared = variantPrograms.find(hash);
+        if (shared != variantPrograms.end()) {
+            variantHashes[key] = hash;
+            return shared->second;
+        }
+        
+        ShaderProgram* program = new ShaderProgram();
+        Shader* vertexShader = new Shader(Shader::VERTEX);
+        Shader* fragmentShader = new Shader(Shader::FRAGMENT);
+        vertexShader->LoadFromString(stages[0].source);
+        fragmentShader->LoadFromString(stages[1].source);
+        if (!vertexShader->Compile() || !fragmentShader->Compile() ||
+            !program->AttachShader(vertexShader) || !program->AttachShader(fragmentShader) || !program->Link()) {
+            delete vertexShader;
+            delete fragmentShader;
+            delete program;
+            return nullptr;
+        }
+        
+        variantPrograms[hash] = program;
+        variantHashes[key] = hash;
+        return program;
+    }
+    
     static ShaderProgram* GetProgram(const std::string& name) {
         auto it = shaderPrograms.find(name);
         if (it != shaderPrograms.end()) {
@@ -427,14 +497,23 @@ public:
             delete pair.second;
         }
         shaderPrograms.clear();
+        for (auto& pair : variantPrograms) {
+            delete pair.second;
+        }
+        variantPrograms.clear();
+        variantHashes.clear();
     }
     
 private:
     static std::unordered_map<std::string, ShaderProgram*> shaderPrograms;
+    static std::unordered_map<uint64_t, ShaderProgram*> variantPrograms;
+    static std::unordered_map<std::string, uint64_t> variantHashes;
 };
 
 // Initialize static member
 std::unordered_map<std::string, ShaderProgram*> ShaderAsset::shaderPrograms;
+std::unordered_map<uint64_t, ShaderProgram*> ShaderAsset::variantPrograms;
+std::unordered_map<std::string, uint64_t> ShaderAsset::variantHashes;
 
 } // namespace Shaders
 
@@ -630,10 +709,131 @@ bool TestShaderCompilation() {
     return success;
 }
 
+static void WriteText(const std::string& path, const std::string& text) {
+    std::ofstream file(path);
+    file << text;
+}
+
+static void Expect(bool condition, const std::string& message, bool& success) {
+    if (condition) {
+        std::cout << message << std::endl;
+    } else {
+        std::cerr << "Failed: " << message << std::endl;
+        success = false;
+    }
+}
+
+// Test the preprocessor, variants and the shader source cache
+bool TestShaderVariants() {
+    bool success = true;
+    ShaderSourceCache& cache = ShaderSourceCache::GetInstance();
+    
+    // The default shaders, without writing cache files into the engine
+    ShaderSourceCache::SetEnabled(false);
+    {
+        ShaderPreprocessor::Result standard;
+        std::string error;
+        bool processed = ShaderPreprocessor::Process("../Shaders/Defaults/standard.frag", { "NORMAL_MAP" }, standard, &error);
+        Expect(processed && standard.source.compare(0, 44, "#version 330 core\n#define NORMAL_MAP 1\n#line") == 0,
+               "Keywords are defined right after #version", success);
+        Expect(processed && standard.files.size() == 4 && standard.files[1] == "../Shaders/Defaults/Include/globals.glsl" &&
+               standard.files[2] == "../Shaders/Defaults/Include/lod_fade.glsl" &&
+               standard.source.find("void applyLodFade()") != std::string::npos &&
+               standard.source.find("#include") == std::string::npos,
+               "Includes are expanded in place", success);
+        Expect(processed && standard.keywords == std::vector<std::string>({ "NORMAL_MAP", "OPACITY_MAP" }),
+               "Declared keywords are reported", success);
+        Expect(processed && standard.source.find("#line 1 1\n") != std::string::npos &&
+               standard.source.find("#line 20 0\n") != std::string::npos,
+               "Line directives map back to each file", success);
+        
+        ShaderPreprocessor::Result vertex;
+        ShaderPreprocessor::Result plain;
+        Expect(ShaderPreprocessor::Process("../Shaders/Defaults/standard.vert", { "NORMAL_MAP" }, vertex) &&
+               ShaderPreprocessor::Process("../Shaders/Defaults/standard.vert", {}, plain) &&
+               vertex.source == plain.source,
+               "Stages ignore keywords they do not declare", success);
+        Expect(!ShaderPreprocessor::Process("../Shaders/Defaults/missing.frag", {}, plain, &error) &&
+               error.find("missing.frag") != std::string::npos,
+               "Missing shaders fail to preprocess", success);
+        
+        int compiled = compiledShaders;
+        Shaders::ShaderProgram* lit = Shaders::ShaderAsset::LoadVariant(
+            "../Shaders/Defaults/standard.vert", "../Shaders/Defaults/standard.frag", { "NORMAL_MAP", "OPACITY_MAP" });
+        Expect(lit && compiledShaders == compiled + 2, "A variant is compiled when first asked for", success);
+        Expect(Shaders::ShaderAsset::LoadVariant("../Shaders/Defaults/standard.vert", "../Shaders/Defaults/standard.frag",
+                                                 { "OPACITY_MAP", "NORMAL_MAP", "NORMAL_MAP" }) == lit &&
+               compiledShaders == compiled + 2, "Keyword order and duplicates name the same variant", success);
+        Expect(Shaders::ShaderAsset::LoadVariant("../Shaders/Defaults/unlit.vert", "../Shaders/Defaults/unlit.frag",
+                                                 { "NORMAL_MAP" }) == nullptr,
+               "Keywords no stage declares are rejected", success);
+        Expect(Shaders::ShaderAsset::LoadVariant("../Shaders/Defaults/skybox.vert", "../Shaders/Defaults/skybox.frag",
+                                                 { "EQUIRECTANGULAR" }) != nullptr, "Skybox has variants", success);
+    }
+    ShaderSourceCache::SetEnabled(true);
+    
+    // Shaders of our own, cached on disk
+    MakeFolder("temp_variants");
+    MakeFolder("temp_variants/Include");
+    WriteText("temp_variants/lit.vert", "#version 330 core\nvoid main() {}\n");
+    WriteText("temp_variants/lit.frag",
+              "#version 330 core\n#pragma keywords FOG\n#include \"Include/fog.glsl\"\nvoid main() {}\n");
+    WriteText("temp_variants/copy.frag",
+              "#version 330 core\n#pragma keywords FOG\n#include \"Include/fog.glsl\"\nvoid main() {}\n");
+    WriteText("temp_variants/Include/fog.glsl", "uniform float fogDensity;\n#include \"fog.glsl\"\n");
+    {
+        int compiled = compiledShaders;
+        Shaders::ShaderProgram* fog = Shaders::ShaderAsset::LoadVariant("temp_variants/lit.vert", "temp_variants/lit.frag", { "FOG" });
+        Expect(fog && Shaders::ShaderAsset::LoadVariant("temp_variants/lit.vert", "temp_variants/copy.frag", { "FOG" }) == fog &&
+               compiledShaders == compiled + 2, "Variants with the same sources share one program", success);
+        
+        std::ifstream written(ShaderSourceCache::GetCachePath("temp_variants/lit.frag"));
+        Expect(written.is_open(), "Preprocessed sources are written to the cache file", success);
+        written.close();
+        
+        std::vector<std::string> dependents = cache.GetDependents("temp_variants/Include/fog.glsl");
+        Expect(dependents.size() == 2 && dependents[0] == "temp_variants/copy.frag" &&
+               dependents[1] == "temp_variants/lit.frag", "Shaders including a file are found", success);
+        
+        // A new run starts with nothing in memory
+        cache.Clear();
+        size_t preprocessed = cache.GetPreprocessCount();
+        ShaderPreprocessor::Result warm;
+        bool fromCache = false;
+        Expect(cache.Get("temp_variants/lit.frag", { "FOG" }, warm, &fromCache) && fromCache &&
+               cache.GetPreprocessCount() == preprocessed && warm.source.find("#define FOG 1") != std::string::npos &&
+               warm.files.size() == 2 && warm.keywords == std::vector<std::string>({ "FOG" }),
+               "Warm start reads the variant from the cache file", success);
+        
+        WriteText("temp_variants/Include/fog.glsl", "uniform float fogDensity;\nuniform vec3 fogColor;\n");
+        ShaderPreprocessor::Result changed;
+        Expect(cache.Get("temp_variants/lit.frag", { "FOG" }, changed, &fromCache) && !fromCache &&
+               changed.source.find("fogColor") != std::string::npos, "Changing an include preprocesses again", success);
+        
+        WriteText(ShaderSourceCache::GetCachePath("temp_variants/copy.frag"), "SAVS");
+        cache.Clear();
+        ShaderPreprocessor::Result corrupt;
+        Expect(cache.Get("temp_variants/copy.frag", { "FOG" }, corrupt, &fromCache) && !fromCache &&
+               corrupt.source == changed.source, "Corrupt cache files are ignored", success);
+    }
+    
+    Shaders::ShaderAsset::Cleanup();
+    const char* files[] = { "temp_variants/lit.vert", "temp_variants/lit.frag", "temp_variants/copy.frag",
+                            "temp_variants/Include/fog.glsl" };
+    for (const char* file : files) {
+        std::remove(file);
+        std::remove(ShaderSourceCache::GetCachePath(file).c_str());
+    }
+    RemoveFolder("temp_variants/Include");
+    RemoveFolder("temp_variants");
+    
+    return success;
+}
+
 int main() {
     std::cout << "Testing shader compilation..." << std::endl;
     
-    if (TestShaderCompilation()) {
+    if (TestShaderCompilation() && TestShaderVariants()) {
         std::cout << "All shader compilation tests passed" << std::endl;
         return 0;
     } else {
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include "../Shaders/Core/ShaderUniforms.h"
+#include "../PointLight.h"
+#include "../DirectionalLight.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for uniform name ids and the shared uniform blocks
+// Build with build_shader_uniforms_test.sh
+
+int main() {
+    std::cout << "Shader Uniforms Test" << std::endl;
+    std::cout << "====================" << std::endl;
+
+    // Uniform ids
+    {
+        int count = ShaderUniforms::GetIdCount();
+        int model = ShaderUniforms::GetId("model");
+        int lodFade = ShaderUniforms::GetId("lodFade");
+        Check(model != lodFade, "Different names get different ids");
+        Check(ShaderUniforms::GetId("model") == model, "A name keeps its id");
+        Check(ShaderUniforms::GetIdCount() == count + 2 && model == count && lodFade == count + 1,
+              "Ids are dense");
+        Check(ShaderUniforms::GetName(lodFade) == "lodFade", "Ids map back to names");
+        Check(ShaderUniforms::GetName(-1).empty() && ShaderUniforms::GetName(count + 2).empty(),
+              "Unknown ids have no name");
+    }
+
+    // Block layout, matching Shaders/Defaults/Include/globals.glsl
+    {
+        typedef ShaderUniforms::FrameData FrameData;
+        typedef ShaderUniforms::CameraData CameraData;
+        typedef ShaderUniforms::PointLightData PointLightData;
+        Check(offsetof(FrameData, numDirectionalLights) == 12 && offsetof(FrameData, pointLights) == 16,
+              "Frame block header is std140");
+        Check(offsetof(FrameData, directionalLights) == 16 + 8 * 32, "Light arrays have a 32 byte stride");
+        Check(offsetof(PointLightData, range) == 12 && offsetof(PointLightData, color) == 16,
+              "Point lights pack a float after each vec3");
+        Check(offsetof(CameraData, projection) == 64 && offsetof(CameraData, viewPos) == 128,
+              "Camera block is std140");
+        Check(std::string(ShaderUniforms::GetBlockName(ShaderUniforms::FRAME_BLOCK)) == "FrameUniforms" &&
+              std::string(ShaderUniforms::GetBlockName(ShaderUniforms::CAMERA_BLOCK)) == "CameraUniforms",
+              "Block names match the shaders");
+    }
+
+    ShaderUniforms& uniforms = ShaderUniforms::GetInstance();
+
+    // Lights
+    {
+        std::vector<PointLight> pointLights;
+        for (int i = 0; i < 10; i++) {
+            pointLights.push_back(PointLight(Vector3(i, 2, 3), Vector3(1, 0.5f, 0), 2.0f, 5.0f + i));
+        }
+        std::vector<DirectionalLight> directionalLights;
+        directionalLights.push_back(DirectionalLight(Vector3(0, -1, 0), Vector3(1, 1, 1), 0.5f));
+
+        Check(uniforms.SetLights(pointLights, directionalLights), "New lights are a change");
+        const ShaderUniforms::FrameData& frame = uniforms.GetFrameData();
+        Check(frame.numPointLights == ShaderUniforms::MAX_POINT_LIGHTS && frame.numDirectionalLights == 1,
+              "Light counts are clamped");
+        Check(frame.pointLights[3].position[0] == 3.0f && frame.pointLights[3].range == 8.0f &&
+              frame.pointLights[3].color[1] == 0.5f && frame.pointLights[3].intensity == 2.0f,
+              "Point lights are packed");
+        Check(frame.directionalLights[0].direction[1] == -1.0f && frame.directionalLights[0].intensity == 0.5f,
+              "Directional lights are packed");
+        Check(!uniforms.SetLights(pointLights, directionalLights), "Same lights are not a change");
+
+        pointLights[9].SetIntensity(4.0f);
+        Check(!uniforms.SetLights(pointLights, directionalLights), "Lights past the limit are ignored");
+
+        pointLights.resize(2);
+        Check(uniforms.SetLights(pointLights, directionalLights) && uniforms.GetFrameData().numPointLights == 2 &&
+              uniforms.GetFrameData().pointLights[2].intensity == 0.0f,
+              "Fewer lights clear the rest");
+    }
+
+    // Time
+    {
+        Check(uniforms.SetTime(1.0f, 0.016f), "New time is a change");
+        Check(!uniforms.SetTime(1.0f, 0.016f), "Same time is not a change");
+        Check(uniforms.GetFrameData().numPointLights == 2, "Time leaves the lights alone");
+    }
+
+    // Camera
+    {
+        Matrix4x4 view;
+        view.identity();
+        view.translate(-1.0f, -2.0f, -3.0f);
+        Matrix4x4 projection;
+        projection.identity();
+        projection.elements[3][2] = -1.0f;
+
+        Check(uniforms.SetCamera(view, projection), "New camera is a change");
+        const ShaderUniforms::CameraData& camera = uniforms.GetCameraData();
+        Check(camera.view[3] == view.elements[0][3] && camera.projection[14] == -1.0f,
+              "Matrices are stored as SetUniform passes them");
+        Check(camera.viewPos[0] == 1.0f && camera.viewPos[1] == 2.0f && camera.viewPos[2] == 3.0f,
+              "Camera position comes from the view matrix");
+        Check(!uniforms.SetCamera(view, projection), "Same camera is not a change");
+    }
+
+    // Nothing is uploaded without a graphics API
+    {
+        size_t uploads = uniforms.GetUploadCount();
+        uniforms.Upload(nullptr);
+        Check(uniforms.GetUploadCount() == uploads, "Upload without a graphics API does nothing");
+    }
+
+    return TestSummary();
+}
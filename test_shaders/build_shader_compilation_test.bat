@@ -6,7 +6,10 @@ g++ -std=c++14 -I.. ^
     ShaderCompilationTest.cpp ^
     ..\Shaders\Core\Shader.cpp ^
     ..\Shaders\Core\ShaderProgram.cpp ^
+    ..\Shaders\Core\ShaderUniforms.cpp ^
     ..\Shaders\Core\ShaderError.cpp ^
+    ..\Shaders\Core\ShaderPreprocessor.cpp ^
+    ..\Shaders\Core\ShaderSourceCache.cpp ^
     -I"%GLEW_HOME%\include" ^
     -L"%GLEW_HOME%\lib" ^
     -lopengl32 -lglew32 -lglfw3 -o shader_compilation_test.exe
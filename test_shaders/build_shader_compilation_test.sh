@@ -5,8 +5,14 @@ g++ -std=c++14 -I.. \
     ShaderCompilationTest.cpp \
     ../Shaders/Core/Shader.cpp \
     ../Shaders/Core/ShaderProgram.cpp \
+    ../Shaders/Core/ShaderUniforms.cpp \
     ../Shaders/Core/ShaderError.cpp \
+    ../Shaders/Core/ShaderPreprocessor.cpp \
+    ../Shaders/Core/ShaderSourceCache.cpp \
     ../Shaders/Assets/ShaderAsset.cpp \
+    ../AssetManager.cpp \
+    ../AssetStreamer.cpp \
+    ../JobSystem.cpp \
     -I/usr/include/GL \
     -lGL -lGLEW -lglfw -o shader_compilation_test
 
@@ -0,0 +1,20 @@
+@echo off
+echo Building shader compilation test against mock OpenGL...
+
+REM Build shader compilation test; needs no GL libraries
+g++ -std=c++14 -I.. ^
+    ShaderCompilationTest_Mock.cpp ^
+    ..\Shaders\Core\ShaderPreprocessor.cpp ^
+    ..\Shaders\Core\ShaderSourceCache.cpp ^
+    ..\AssetManager.cpp ^
+    -o shader_compilation_test_mock.exe
+
+if exist shader_compilation_test_mock.exe (
+    echo Build successful
+    echo Run shader_compilation_test_mock.exe from this folder to test shader compilation
+) else (
+    echo Build failed
+    exit /b 1
+)
+
+pause
@@ -0,0 +1,14 @@
+#!/bin/bash
+
+# Build shader compilation test against mock OpenGL; needs no GL libraries
+g++ -std=c++14 -I.. \
+    ShaderCompilationTest_Mock.cpp \
+    ../Shaders/Core/ShaderPreprocessor.cpp \
+    ../Shaders/Core/ShaderSourceCache.cpp \
+    ../AssetManager.cpp \
+    -pthread -o shader_compilation_test_mock
+
+# Make executable
+chmod +x shader_compilation_test_mock
+
+echo "Build complete. Run ./shader_compilation_test_mock from this folder to test shader compilation."
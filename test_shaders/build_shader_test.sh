@@ -4,13 +4,33 @@
 g++ -std=c++14 -I.. \
     ShaderTest.cpp \
     ../Model.cpp \
+    ../ObjLoader.cpp \
+    ../MeshCache.cpp \
+    ../MeshOptimizer.cpp \
+    ../MeshSimplifier.cpp \
+    ../AssetManager.cpp \
+    ../AssetStreamer.cpp \
+    ../JobSystem.cpp \
+    ../Texture.cpp \
+    ../TextureCache.cpp \
+    ../TextureAtlas.cpp \
+    ../Debugger.cpp \
+    ../MappedFile.cpp \
     ../Scene.cpp \
+    ../Coroutine.cpp \
+    ../TimerWheel.cpp \
+    ../FrustumCuller.cpp \
+    ../RenderQueue.cpp \
+    ../LodGroup.cpp \
     ../Camera.cpp \
     ../GameObject.cpp \
     ../Vector3.cpp \
     ../Matrix4x4.cpp \
     ../Shaders/Core/Shader.cpp \
+    ../Shaders/Core/ShaderPreprocessor.cpp \
+    ../Shaders/Core/ShaderSourceCache.cpp \
     ../Shaders/Core/ShaderProgram.cpp \
+    ../Shaders/Core/ShaderUniforms.cpp \
     ../Shaders/Core/ShaderError.cpp \
     ../Shaders/Assets/ShaderAsset.cpp \
     -I/usr/include/GL \
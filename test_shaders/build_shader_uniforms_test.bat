@@ -0,0 +1,20 @@
+@echo off
+echo Building shader uniforms test...
+
+REM Build shader uniforms test; needs no GL libraries
+g++ -std=c++14 -I.. ^
+    ShaderUniformsTest.cpp ^
+    ..\Shaders\Core\ShaderUniforms.cpp ^
+    ..\Matrix4x4.cpp ^
+    ..\Vector3.cpp ^
+    -o shader_uniforms_test.exe
+
+if exist shader_uniforms_test.exe (
+    echo Build successful
+    echo Run shader_uniforms_test.exe to test shader uniforms
+) else (
+    echo Build failed
+    exit /b 1
+)
+
+pause
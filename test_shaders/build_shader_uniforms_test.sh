@@ -0,0 +1,14 @@
+#!/bin/bash
+
+# Build shader uniforms test; needs no GL libraries
+g++ -std=c++14 -I.. \
+    ShaderUniformsTest.cpp \
+    ../Shaders/Core/ShaderUniforms.cpp \
+    ../Matrix4x4.cpp \
+    ../Vector3.cpp \
+    -pthread -o shader_uniforms_test
+
+# Make executable
+chmod +x shader_uniforms_test
+
+echo "Build complete. Run ./shader_uniforms_test to test shader uniforms."
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include "../SceneSnapshot.h"
+#include "../GameObject.h"
+#include "../RigidBody.h"
+#include "../Model.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for copy-on-write scene snapshots
+// Build with build_snapshot_test.sh
+
+// GameObject::Render is linked in but never called here
+void Model::Render(const std::vector<PointLight>& lights) {}
+
+int main() {
+    std::cout << "Scene Snapshot Test" << std::endl;
+    std::cout << "===================" << std::endl;
+
+    const int objectCount = 10000;
+    std::vector<std::unique_ptr<GameObject>> storage;
+    std::vector<GameObject*> sceneObjects;
+    for (int i = 0; i < objectCount; i++) {
+        storage.push_back(std::unique_ptr<GameObject>(new GameObject("Object" + std::to_string(i), Vector3((float)i, 0, 0))));
+        sceneObjects.push_back(storage.back().get());
+    }
+
+    // One object with a rigid body and a child
+    RigidBody* body = new RigidBody();
+    sceneObjects[0]->AddComponent(body);
+    GameObject child("Child", Vector3(0, 5, 0));
+    sceneObjects[0]->AddChild(&child);
+
+    SceneSnapshotter snapshotter(sceneObjects);
+
+    SceneSnapshot initial = snapshotter.Capture();
+    Check(initial.GetObjectCount() == objectCount + 1, "Snapshot covers objects and children");
+
+    // Unchanged chunks are shared
+    SceneSnapshot unchanged = snapshotter.Capture();
+    Check(unchanged.CountSharedChunks(initial) == initial.GetChunkCount(), "Capture with no changes shares every chunk");
+
+    sceneObjects[5000]->position.y = 3.0f;
+    sceneObjects[5000]->MarkDirty(GameObject::DIRTY_TRANSFORM);
+    SceneSnapshot oneChange = snapshotter.Capture();
+    Check(oneChange.CountSharedChunks(unchanged) == unchanged.GetChunkCount() - 1, "One change copies one chunk");
+
+    // Changes are found through MarkDirty; marking without a change copies nothing
+    sceneObjects[6000]->MarkDirty(GameObject::DIRTY_TRANSFORM);
+    SceneSnapshot markedOnly = snapshotter.Capture();
+    Check(markedOnly.CountSharedChunks(oneChange) == oneChange.GetChunkCount(), "Marked but unchanged object shares its chunk");
+
+    // Restore transforms, velocities and enabled flags
+    body->velocity = Vector3(1, 2, 3);
+    child.SetPosition(Vector3(9, 9, 9));
+    sceneObjects[10]->SetEnabled(false);
+    snapshotter.Restore(initial);
+    Check(sceneObjects[5000]->position.y == 0.0f && child.position.y == 5.0f, "Restore puts transforms back");
+    Check(body->velocity.x == 0.0f && body->velocity.z == 0.0f, "Restore puts rigid body velocity back");
+    Check(sceneObjects[10]->IsEnabled(), "Restore puts enabled flags back");
+
+    SceneSnapshot afterRestore = snapshotter.Capture();
+    Check(afterRestore.CountSharedChunks(initial) == initial.GetChunkCount(), "Capture after restore shares with the restored snapshot");
+
+    // Objects spawned after the capture stay in the scene and keep their state
+    GameObject spawned("Spawned", Vector3(7, 7, 7));
+    sceneObjects.push_back(&spawned);
+    SceneSnapshot withSpawn = snapshotter.Capture();
+    Check(withSpawn.GetObjectCount() == objectCount + 2, "Layout change is detected");
+    sceneObjects[20]->SetPosition(Vector3(1, 1, 1));
+    snapshotter.Restore(initial);
+    Check(sceneObjects.size() == (size_t)objectCount + 1 && spawned.position.x == 7.0f, "Restore keeps objects spawned after the capture");
+    Check(sceneObjects[20]->position.x == 20.0f && sceneObjects[20]->position.y == 0.0f, "Restore still puts older objects back");
+
+    // Objects removed since the capture are skipped
+    GameObject* removed = sceneObjects[30];
+    sceneObjects.erase(sceneObjects.begin() + 30);
+    removed->SetPosition(Vector3(2, 2, 2));
+    snapshotter.Restore(initial);
+    Check(removed->position.x == 2.0f, "Restore leaves objects removed from the scene alone");
+    sceneObjects.insert(sceneObjects.begin() + 30, removed);
+    sceneObjects.pop_back();
+
+    // Rollback history
+    SceneSnapshotHistory history(4);
+    for (unsigned int tick = 1; tick <= 6; tick++) {
+        sceneObjects[1]->position.z = (float)tick;
+        sceneObjects[1]->MarkDirty(GameObject::DIRTY_TRANSFORM);
+        history.Push(tick, snapshotter.Capture());
+    }
+    Check(history.GetCount() == 4 && history.Find(2) == nullptr && history.Find(3) != nullptr, "History keeps the newest ticks");
+    snapshotter.Restore(*history.Find(4));
+    history.DiscardAfter(4);
+    Check(sceneObjects[1]->position.z == 4.0f && history.Find(5) == nullptr, "Rollback restores a tick and drops newer ones");
+
+    // Per-tick cost with a few moving objects
+    const int ticks = 200;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int tick = 0; tick < ticks; tick++) {
+        for (int i = 0; i < 100; i++) {
+            sceneObjects[i * 97]->position.x += 0.1f;
+            sceneObjects[i * 97]->MarkDirty(GameObject::DIRTY_TRANSFORM);
+        }
+        SceneSnapshot snapshot = snapshotter.Capture();
+        history.Push(tick, snapshot);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double microseconds = std::chrono::duration<double, std::micro>(end - start).count() / ticks;
+    std::cout << "Average capture time for " << objectCount << " objects: " << microseconds << " us" << std::endl;
+    Check(microseconds < 100.0, "Capture of 10k objects with 100 moving stays under 100 us");
+    Check(history.GetCount() == 4, "History stays bounded while capturing every tick");
+
+    return TestSummary();
+}
@@ -0,0 +1,17 @@
+@echo off
+echo Building snapshot test program...
+
+REM Build snapshot test
+g++ -std=c++14 -O2 -I.. ^
+    SceneSnapshotTest.cpp ^
+    ..\SceneSnapshot.cpp ..\GameObject.cpp ..\Coroutine.cpp ..\TimerWheel.cpp ..\Matrix4x4.cpp ..\RigidBody.cpp ..\EventBus.cpp ^
+    -o snapshot_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run snapshot_test.exe to test scene snapshots.
+pause
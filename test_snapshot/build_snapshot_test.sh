@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Build snapshot test
+echo "Building snapshot test program..."
+g++ -std=c++14 -O2 -I.. \
+    SceneSnapshotTest.cpp \
+    ../SceneSnapshot.cpp ../GameObject.cpp ../Coroutine.cpp ../TimerWheel.cpp ../Matrix4x4.cpp ../RigidBody.cpp ../EventBus.cpp \
+    -pthread -o snapshot_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x snapshot_test
+
+echo "Build complete. Run ./snapshot_test to test scene snapshots."
@@ -0,0 +1,153 @@
+// Tests for TextureAtlas: packing, borders, mip levels and remapping
+// Build with build_texture_atlas_test.sh
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cmath>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include "../TextureAtlas.h"
+#include "../test_common/TestCheck.h"
+
+// Image of one color
+static std::vector<unsigned char> MakeImage(uint32_t width, uint32_t height, unsigned char shade) {
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i] = shade;
+        pixels[i + 1] = static_cast<unsigned char>(255 - shade);
+        pixels[i + 2] = 0;
+        pixels[i + 3] = 255;
+    }
+    return pixels;
+}
+
+static const unsigned char* PixelAt(const TextureAtlas::Page& page, uint32_t x, uint32_t y) {
+    return &page.pixels[(static_cast<size_t>(y) * page.width + x) * 4];
+}
+
+static bool Overlaps(const TextureAtlas::Rect& a, const TextureAtlas::Rect& b) {
+    return a.page == b.page && a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height &&
+           b.y < a.y + a.height;
+}
+
+int main() {
+    std::cout << "=== Texture Atlas Test ===" << std::endl;
+
+    // Packing
+    {
+        std::vector<TextureAtlas::Rect> rects;
+        std::srand(7);
+        uint32_t area = 0;
+        for (int i = 0; i < 300; ++i) {
+            TextureAtlas::Rect rect = { 8u + std::rand() % 57u, 8u + std::rand() % 57u, 0, 0, 0 };
+            area += rect.width * rect.height;
+            rects.push_back(rect);
+        }
+        bool packed = TextureAtlas::Pack(rects, 512, 512);
+
+        bool inside = true;
+        bool separate = true;
+        uint32_t pageCount = 0;
+        for (size_t i = 0; i < rects.size(); ++i) {
+            inside = inside && rects[i].x + rects[i].width <= 512 && rects[i].y + rects[i].height <= 512;
+            pageCount = std::max(pageCount, rects[i].page + 1);
+            for (size_t j = i + 1; j < rects.size(); ++j) {
+                separate = separate && !Overlaps(rects[i], rects[j]);
+            }
+        }
+        Check(packed && inside, "Rectangles are placed inside their pages");
+        Check(separate, "Rectangles never overlap");
+        Check(pageCount == (area + 512 * 512 - 1) / (512 * 512) && pageCount <= 4,
+              "Packing fills pages before opening new ones");
+
+        std::vector<TextureAtlas::Rect> huge(1);
+        huge[0].width = 600;
+        huge[0].height = 16;
+        Check(!TextureAtlas::Pack(huge, 512, 512), "A rectangle larger than a page is refused");
+    }
+
+    // Building pages
+    {
+        TextureAtlas::Options options;
+        options.pageSize = 256;
+        TextureAtlas atlas(options);
+
+        std::vector<unsigned char> red = MakeImage(10, 6, 200);
+        std::vector<unsigned char> green = MakeImage(16, 16, 40);
+        std::vector<unsigned char> large = MakeImage(300, 8, 90);
+        Check(atlas.Add("red", red.data(), 10, 6) && atlas.Add("green", green.data(), 16, 16),
+              "Small images are added");
+        Check(!atlas.Add("red", red.data(), 10, 6), "Names are unique");
+        Check(!atlas.Add("large", large.data(), 300, 8), "Images over the size limit are left out");
+        Check(atlas.Build() && atlas.GetPages().size() == 1, "Images are packed onto one page");
+
+        const TextureAtlas::Page& page = atlas.GetPages()[0];
+        Check(page.width == 256 && page.height == 32, "Pages are only as tall as their contents");
+
+        AtlasRegion region;
+        Check(atlas.Find("red", region) && region.width == 10 && region.height == 6 &&
+              (region.x - options.padding) % options.alignment == 0 &&
+              (region.y - options.padding) % options.alignment == 0, "Slots start on the alignment");
+        Check(PixelAt(page, region.x, region.y)[0] == 200 && PixelAt(page, region.x + 9, region.y + 5)[0] == 200,
+              "The image is copied into its region");
+        Check(PixelAt(page, region.x - options.padding, region.y - options.padding)[0] == 200 &&
+              PixelAt(page, region.x + 9 + options.padding, region.y + 5 + options.padding)[0] == 200,
+              "Edge pixels are extruded into the border");
+        Check(std::fabs(region.u0 - region.x / 256.0f) < 1e-6f && std::fabs(region.v1 - (region.y + 6) / 32.0f) < 1e-6f,
+              "Regions carry their texture coordinates");
+
+        // Every pixel of a clean mip level's texels comes from one image
+        bool clean = true;
+        uint32_t step = 1u << (atlas.GetMipLevels() - 1);
+        for (uint32_t y = 0; y < page.height; y += step) {
+            for (uint32_t x = 0; x < page.width; x += step) {
+                for (uint32_t i = 0; i < step * step; ++i) {
+                    clean = clean && PixelAt(page, x + i % step, y + i / step)[0] == PixelAt(page, x, y)[0];
+                }
+            }
+        }
+        Check(atlas.GetMipLevels() == 3 && clean, "Mip levels within the border do not mix images");
+
+        TextureAtlas::Options narrow;
+        narrow.padding = 2;
+        narrow.alignment = 1;
+        Check(TextureAtlas(narrow).GetMipLevels() == 1, "Unaligned slots allow no mips");
+    }
+
+    // Images spill onto further pages
+    {
+        TextureAtlas::Options options;
+        options.pageSize = 128;
+        options.maxImageSize = 64;
+        TextureAtlas atlas(options);
+        std::vector<unsigned char> image = MakeImage(56, 56, 10);
+        for (int i = 0; i < 5; ++i) {
+            atlas.Add("image" + std::to_string(i), image.data(), 56, 56);
+        }
+        AtlasRegion last;
+        Check(atlas.Build() && atlas.GetPages().size() == 2 && atlas.Find("image4", last),
+              "Images that do not fit open a new page");
+    }
+
+    // Remapping
+    {
+        AtlasRegion region;
+        region.u0 = 0.25f;
+        region.v0 = 0.5f;
+        region.u1 = 0.5f;
+        region.v1 = 1.0f;
+        std::vector<float> uvs = { 0.0f, 0.0f, 1.0f, 1.0f, 0.5f, 0.5f };
+        Check(TextureAtlas::CanRemap(uvs), "Coordinates inside [0, 1] can be remapped");
+        TextureAtlas::RemapTexCoords(uvs, region);
+        Check(uvs[0] == 0.25f && uvs[1] == 0.5f && uvs[2] == 0.5f && uvs[3] == 1.0f && uvs[4] == 0.375f &&
+              uvs[5] == 0.75f, "Coordinates are mapped onto the region");
+
+        std::vector<float> tiled = { 0.0f, 0.0f, 2.0f, 1.0f };
+        Check(!TextureAtlas::CanRemap(tiled), "Tiling coordinates cannot be remapped");
+    }
+
+    return TestSummary();
+}
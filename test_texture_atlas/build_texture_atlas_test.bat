@@ -0,0 +1,17 @@
+@echo off
+echo Building texture atlas test program...
+
+REM Build texture atlas test
+g++ -std=c++14 -O2 -I.. ^
+    TextureAtlasTest.cpp ^
+    ..\TextureAtlas.cpp ^
+    -o texture_atlas_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run texture_atlas_test.exe from this folder to test the texture atlas builder.
+pause
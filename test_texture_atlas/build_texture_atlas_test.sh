@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Build texture atlas test
+echo "Building texture atlas test program..."
+g++ -std=c++14 -O2 -I.. \
+    TextureAtlasTest.cpp \
+    ../TextureAtlas.cpp \
+    -o texture_atlas_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x texture_atlas_test
+
+echo "Build complete. Run ./texture_atlas_test from this folder to test the texture atlas builder."
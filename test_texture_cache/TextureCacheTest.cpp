@@ -0,0 +1,300 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "../TextureCache.h"
+#include "../ThirdParty/stb/stb_image_write.h"
+#include "../test_common/TestCheck.h"
+
+// stb_image's implementation normally comes from Texture.cpp, which needs OpenGL
+#define STB_IMAGE_IMPLEMENTATION
+#include "../stb_image.h"
+
+// Tests for the texture cooker and cooked texture cache
+// Build with build_texture_cache_test.sh
+
+static bool FileExists(const std::string& path) {
+    std::ifstream file(path);
+    return file.good();
+}
+
+// Smooth color ramps with a little noise, like a photo texture
+static std::vector<unsigned char> MakeImage(uint32_t width, uint32_t height, bool transparent) {
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+    unsigned int seed = 7;
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            seed = seed * 1103515245u + 12345u;
+            int noise = static_cast<int>((seed >> 16) % 9) - 4;
+            unsigned char* pixel = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+            pixel[0] = static_cast<unsigned char>(std::max(0, std::min(255, static_cast<int>(x * 255 / width) + noise)));
+            pixel[1] = static_cast<unsigned char>(std::max(0, std::min(255, static_cast<int>(y * 255 / height) + noise)));
+            pixel[2] = static_cast<unsigned char>(128 + 100 * std::sin(x * 0.05) * std::cos(y * 0.05));
+            pixel[3] = transparent ? static_cast<unsigned char>((x + y) * 255 / (width + height)) : 255;
+        }
+    }
+    return pixels;
+}
+
+static bool WritePng(const std::string& path, const std::vector<unsigned char>& pixels, uint32_t width, uint32_t height) {
+    return stbi_write_png(path.c_str(), static_cast<int>(width), static_cast<int>(height), 4, pixels.data(),
+                          static_cast<int>(width * 4)) != 0;
+}
+
+// Root mean square error over the given channels
+static double Rmse(const std::vector<unsigned char>& a, const std::vector<unsigned char>& b, int channels) {
+    double sum = 0.0;
+    size_t count = 0;
+    for (size_t i = 0; i < a.size(); i += 4) {
+        for (int channel = 0; channel < channels; ++channel) {
+            double difference = static_cast<double>(a[i + channel]) - b[i + channel];
+            sum += difference * difference;
+            count++;
+        }
+    }
+    return std::sqrt(sum / count);
+}
+
+static std::vector<unsigned char> DecompressLevel(const CookedTexture& texture, size_t level) {
+    std::vector<unsigned char> rgba;
+    const CookedTexture::Level& info = texture.levels[level];
+    TextureCache::Decompress(static_cast<TextureCache::Format>(texture.format), texture.data.data() + info.offset,
+                             info.width, info.height, rgba);
+    return rgba;
+}
+
+static void RemoveCooked(const std::string& source) {
+    std::remove(TextureCache::GetCookedPath(source).c_str());
+}
+
+int main() {
+    std::cout << "=== Texture Cache Tests ===" << std::endl;
+
+    // Block compression
+    {
+        Check(TextureCache::GetLevelSize(TextureCache::FORMAT_BC1, 256, 256) == 32768 &&
+              TextureCache::GetLevelSize(TextureCache::FORMAT_BC3, 256, 256) == 65536 &&
+              TextureCache::GetLevelSize(TextureCache::FORMAT_BC1, 5, 3) == 16 &&
+              TextureCache::GetLevelSize(TextureCache::FORMAT_RGBA8, 5, 3) == 60,
+              "Level sizes count whole 4x4 blocks");
+
+        unsigned char solid[64];
+        for (int i = 0; i < 16; ++i) {
+            solid[i * 4] = 255;
+            solid[i * 4 + 1] = 0;
+            solid[i * 4 + 2] = 0;
+            solid[i * 4 + 3] = 255;
+        }
+        unsigned char block[16];
+        std::vector<unsigned char> decoded;
+        TextureCache::CompressBC1Block(solid, block);
+        TextureCache::Decompress(TextureCache::FORMAT_BC1, block, 4, 4, decoded);
+        Check(std::vector<unsigned char>(solid, solid + 64) == decoded, "A solid block survives BC1 exactly");
+
+        std::vector<unsigned char> image = MakeImage(64, 64, true);
+        CookedTexture texture;
+        TextureCache::Options options;
+        options.mipmaps = false;
+
+        options.format = TextureCache::FORMAT_BC1;
+        TextureCache::Encode(image.data(), 64, 64, 4, options, texture);
+        double colorError = Rmse(image, DecompressLevel(texture, 0), 3);
+        Check(texture.data.size() == 64 * 64 / 2 && colorError < 6.0, "BC1 keeps color within a few levels");
+        std::cout << "BC1 color RMSE: " << colorError << std::endl;
+
+        options.format = TextureCache::FORMAT_BC3;
+        TextureCache::Encode(image.data(), 64, 64, 4, options, texture);
+        std::vector<unsigned char> bc3 = DecompressLevel(texture, 0);
+        double alphaError = 0.0;
+        for (size_t i = 3; i < image.size(); i += 4) {
+            alphaError = std::max(alphaError, std::fabs(static_cast<double>(image[i]) - bc3[i]));
+        }
+        Check(texture.data.size() == 64 * 64 && alphaError <= 3.0 && Rmse(image, bc3, 3) < 6.0,
+              "BC3 keeps alpha and color");
+
+        options.format = TextureCache::FORMAT_BC5;
+        TextureCache::Encode(image.data(), 64, 64, 4, options, texture);
+        double normalError = Rmse(image, DecompressLevel(texture, 0), 2);
+        Check(texture.data.size() == 64 * 64 && normalError < 2.0, "BC5 keeps two channels closely");
+        std::cout << "BC5 RMSE: " << normalError << std::endl;
+    }
+
+    // Mip generation
+    {
+        unsigned char blackWhite[16] = { 0, 0, 0, 255, 255, 255, 255, 255, 0, 0, 0, 255, 255, 255, 255, 255 };
+        std::vector<unsigned char> result;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        TextureCache::Downsample(blackWhite, 2, 2, true, false, result, width, height);
+        Check(width == 1 && height == 1 && result[0] == 188 && result[3] == 255,
+              "sRGB colors are averaged in linear space");
+        TextureCache::Downsample(blackWhite, 2, 2, false, false, result, width, height);
+        Check(result[0] == 128, "Linear data is averaged directly");
+
+        unsigned char row[12] = { 0, 0, 0, 0, 90, 90, 90, 90, 180, 180, 180, 180 };
+        TextureCache::Downsample(row, 3, 1, false, false, result, width, height);
+        Check(width == 1 && height == 1 && result[0] == 90 && result[3] == 90,
+              "Odd sizes weight every source pixel by its footprint");
+
+        // Two normals tilted opposite ways average to straight up
+        unsigned char normals[8] = { 218, 128, 218, 255, 38, 128, 218, 255 };
+        TextureCache::Downsample(normals, 2, 1, false, true, result, width, height);
+        Check(result[0] == 128 && result[2] == 255, "Averaged normals are renormalized");
+
+        std::vector<unsigned char> image = MakeImage(64, 32, false);
+        CookedTexture texture;
+        TextureCache::Encode(image.data(), 64, 32, 3, TextureCache::Options(), texture);
+        Check(texture.levels.size() == 7 && texture.levels[1].width == 32 && texture.levels[1].height == 16 &&
+              texture.levels.back().width == 1 && texture.levels.back().height == 1,
+              "The mip chain goes down to 1x1");
+        Check(texture.format == TextureCache::FORMAT_BC1, "Opaque images default to BC1");
+
+        std::vector<unsigned char> odd = MakeImage(5, 3, true);
+        TextureCache::Encode(odd.data(), 5, 3, 4, TextureCache::Options(), texture);
+        Check(texture.levels.size() == 3 && texture.levels[1].width == 2 && texture.levels[1].height == 1 &&
+              texture.format == TextureCache::FORMAT_BC3, "Odd sized transparent images get BC3 and a full chain");
+
+        TextureCache::Options shortChain = TextureCache::ParseOptions("levels=3");
+        TextureCache::Encode(image.data(), 64, 32, 3, shortChain, texture);
+        Check(shortChain.maxLevels == 3 && texture.levels.size() == 3 && texture.levels[2].width == 16,
+              "The mip chain can be cut short");
+    }
+
+    const std::string source = "texture_cache_test.png";
+    std::vector<unsigned char> image = MakeImage(128, 128, false);
+    RemoveCooked(source);
+    WritePng(source, image, 128, 128);
+
+    // First load cooks, the next one reads the cooked file
+    {
+        CookedTexture cooked;
+        bool fromCache = true;
+        bool ok = TextureCache::Load(source, TextureCache::Options(), cooked, &fromCache);
+        Check(ok && !fromCache && FileExists(TextureCache::GetCookedPath(source)),
+              "The first load cooks the image and writes the cooked file");
+
+        CookedTexture cached;
+        ok = TextureCache::Load(source, TextureCache::Options(), cached, &fromCache);
+        Check(ok && fromCache && cached.levels.size() == cooked.levels.size() && cached.format == cooked.format &&
+              DecompressLevel(cached, 0) == DecompressLevel(cooked, 0) &&
+              DecompressLevel(cached, 3) == DecompressLevel(cooked, 3),
+              "The next load uses the cooked file");
+        Check(cached.width == 128 && cached.height == 128 && cached.channels == 4, "Cooked files keep the image size");
+
+        size_t levelBytes = 0;
+        for (const CookedTexture::Level& level : cached.levels) {
+            levelBytes += level.size;
+        }
+        Check(cached.levels[0].size * 8 == 128 * 128 * 4 && levelBytes * 4 < 128 * 128 * 4,
+              "BC1 is an eighth of RGBA8, and the whole mip chain under a quarter");
+
+        CookedTexture direct;
+        Check(TextureCache::Read(TextureCache::GetCookedPath(source), direct) && direct.levels.size() == 8,
+              "Cooked files can be read directly");
+
+        std::vector<unsigned char> bytes(cached.data);
+        CookedTexture parsed;
+        Check(TextureCache::IsCooked(bytes.data(), bytes.size()) && TextureCache::Parse(bytes.data(), bytes.size(), parsed) &&
+              parsed.levels.size() == 8, "Cooked files held in memory can be parsed");
+    }
+
+    // Touched but unchanged, then changed
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        WritePng(source, image, 128, 128);
+        Check(!TextureCache::IsCurrent(source, TextureCache::Options()), "A touched image is no longer current");
+
+        CookedTexture texture;
+        bool fromCache = false;
+        bool ok = TextureCache::Load(source, TextureCache::Options(), texture, &fromCache);
+        Check(ok && fromCache && TextureCache::IsCurrent(source, TextureCache::Options()),
+              "An unchanged image is not cooked again, and its stamp is updated");
+
+        std::vector<unsigned char> changed = MakeImage(64, 64, true);
+        WritePng(source, changed, 64, 64);
+        ok = TextureCache::Load(source, TextureCache::Options(), texture, &fromCache);
+        Check(ok && !fromCache && texture.width == 64 && texture.format == TextureCache::FORMAT_BC3,
+              "A changed image is cooked again");
+        WritePng(source, image, 128, 128);
+    }
+
+    // Import settings
+    {
+        TextureCache::Options normalMap = TextureCache::ParseOptions("format=bc5;srgb=0");
+        TextureCache::Options noMips = TextureCache::ParseOptions("mips=0");
+        Check(normalMap.format == TextureCache::FORMAT_BC5 && !normalMap.srgb && normalMap.mipmaps && !noMips.mipmaps,
+              "Import settings choose the format and mips");
+        Check(TextureCache::GetCookedPath(source, normalMap) != TextureCache::GetCookedPath(source) &&
+              TextureCache::GetCookedPath(source, noMips) != TextureCache::GetCookedPath(source, normalMap),
+              "Each set of settings cooks its own file");
+
+        CookedTexture texture;
+        bool ok = TextureCache::Load(source, normalMap, texture);
+        Check(ok && texture.format == TextureCache::FORMAT_BC5 && FileExists(TextureCache::GetCookedPath(source, normalMap)),
+              "Textures cook to the requested format");
+        ok = TextureCache::Load(source, noMips, texture);
+        Check(ok && texture.levels.size() == 1, "Mips can be turned off");
+        std::remove(TextureCache::GetCookedPath(source, normalMap).c_str());
+        std::remove(TextureCache::GetCookedPath(source, noMips).c_str());
+    }
+
+    // Broken cooked files and shipped cooked files
+    {
+        {
+            std::ofstream file(TextureCache::GetCookedPath(source), std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(sizeof(TextureCache::Header));
+            unsigned int garbage = 0xFFFFFFFFu;
+            file.write(reinterpret_cast<const char*>(&garbage), sizeof(garbage));
+        }
+        CookedTexture texture;
+        bool fromCache = true;
+        bool ok = TextureCache::Load(source, TextureCache::Options(), texture, &fromCache);
+        Check(ok && !fromCache && texture.levels.size() == 8, "A damaged cooked file is cooked again");
+
+        std::remove(source.c_str());
+        ok = TextureCache::Load(source, TextureCache::Options(), texture, &fromCache);
+        Check(ok && fromCache, "The cooked file is used when the image was not shipped");
+        RemoveCooked(source);
+
+        WritePng(source, image, 128, 128);
+        TextureCache::SetEnabled(false);
+        ok = TextureCache::Load(source, TextureCache::Options(), texture);
+        Check(ok && !FileExists(TextureCache::GetCookedPath(source)), "With the cache disabled nothing is written");
+        TextureCache::SetEnabled(true);
+
+        Check(TextureCache::Cook(source) && TextureCache::IsCurrent(source, TextureCache::Options()),
+              "Images can be cooked ahead of time");
+    }
+
+    // Cooking and loading a large texture
+    {
+        const std::string large = "texture_cache_large.png";
+        std::vector<unsigned char> pixels = MakeImage(1024, 1024, false);
+        WritePng(large, pixels, 1024, 1024);
+        RemoveCooked(large);
+
+        CookedTexture texture;
+        auto start = std::chrono::high_resolution_clock::now();
+        TextureCache::Load(large, TextureCache::Options(), texture);
+        auto cooked = std::chrono::high_resolution_clock::now();
+        TextureCache::Load(large, TextureCache::Options(), texture);
+        auto loaded = std::chrono::high_resolution_clock::now();
+        std::cout << "1024x1024 cook: " << std::chrono::duration<double, std::milli>(cooked - start).count()
+                  << " ms, cached load: " << std::chrono::duration<double, std::milli>(loaded - cooked).count()
+                  << " ms" << std::endl;
+        Check(texture.levels.size() == 11, "A 1024x1024 texture has 11 levels");
+
+        std::remove(large.c_str());
+        RemoveCooked(large);
+    }
+
+    std::remove(source.c_str());
+    RemoveCooked(source);
+
+    return TestSummary();
+}
@@ -0,0 +1,24 @@
+@echo off
+echo Building texture cache test program...
+
+REM Build texture cache test
+g++ -std=c++14 -O2 -I.. ^
+    TextureCacheTest.cpp ^
+    ..\TextureCache.cpp ^
+    ..\MeshCache.cpp ^
+    ..\MeshOptimizer.cpp ^
+    ..\MeshSimplifier.cpp ^
+    ..\ObjLoader.cpp ^
+    ..\MappedFile.cpp ^
+    ..\AssetManager.cpp ^
+    ..\ThirdParty\stb\stb_image_write_impl.cpp ^
+    -o texture_cache_test.exe
+
+if %ERRORLEVEL% NEQ 0 (
+    echo Build failed with error code %ERRORLEVEL%
+    pause
+    exit /b %ERRORLEVEL%
+)
+
+echo Build complete. Run texture_cache_test.exe from this folder to test texture cooking and the texture cache.
+pause
@@ -0,0 +1,25 @@
+#!/bin/bash
+
+# Build texture cache test
+echo "Building texture cache test program..."
+g++ -std=c++14 -O2 -I.. \
+    TextureCacheTest.cpp \
+    ../TextureCache.cpp \
+    ../MeshCache.cpp \
+    ../MeshOptimizer.cpp \
+    ../MeshSimplifier.cpp \
+    ../ObjLoader.cpp \
+    ../MappedFile.cpp \
+    ../AssetManager.cpp \
+    ../ThirdParty/stb/stb_image_write_impl.cpp \
+    -pthread -o texture_cache_test
+
+if [ $? -ne 0 ]; then
+    echo "Build failed"
+    exit 1
+fi
+
+# Make executable
+chmod +x texture_cache_test
+
+echo "Build complete. Run ./texture_cache_test from this folder to test texture cooking and the texture cache."
@@ -0,0 +1,117 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "../Scene.h"
+#include "../WorldPartition.h"
+#include "../JobSystem.h"
+#include "../test_common/TestCheck.h"
+
+// Tests for world partition streaming
+// Build with build_world_partition_test.sh
+
+// Write a cell scene with `count` objects
+static void WriteCell(const std::string& path, const std::string& prefix, int count) {
+    std::ofstream file(path);
+    file << "{ \"sceneName\": \"" << prefix << "\", \"objects\": [";
+    for (int i = 0; i < count; i++) {
+        file << (i ? "," : "") << "{ \"name\": \"" << prefix << "_" << i << "\", "
+             << "\"position\": {\"x\": " << i << ", \"y\": 0, \"z\": 0} }";
+    }
+    file << "] }";
+}
+
+// Let the workers finish, then stream once more
+static void Settle(WorldPartition& world, const Vector3& viewer) {
+    JobSystem::GetInstance().WaitIdle();
+    world.Update(viewer);
+}
+
+int main() {
+    std::cout << "World Partition Test" << std::endl;
+    std::cout << "====================" << std::endl;
+
+    // A row of five 10x10 cells along X, plus one with many objects
+    std::ofstream manifest("world_test.json");
+    manifest << "{ \"cellSize\": 10, \"loadRadius\": 10, \"unloadRadius\": 20, \"cells\": [";
+    for (int x = 0; x < 5; x++) {
+        std::string path = "world_test_cell_" + std::to_string(x) + ".json";
+        WriteCell(path, "cell" + std::to_string(x), 3);
+        manifest << (x ? "," : "") << "{ \"x\": " << x << ", \"z\": 0, \"scene\": \"" << path << "\" }";
+    }
+    WriteCell("world_test_big.json", "big", 200);
+    manifest << ", { \"x\": 0, \"z\": 10, \"scene\": \"world_test_big.json\" }";
+    manifest << ", { \"x\": 0, \"z\": -10, \"scene\": \"world_test_missing.json\" }";
+    manifest << "] }";
+    manifest.close();
+
+    Scene scene;
+    {
+        WorldPartition world(&scene);
+        Check(world.LoadManifest("world_test.json") && world.GetCellCount() == 7, "Manifest registers every cell");
+        Check(world.GetLoadRadius() == 10 && world.GetUnloadRadius() == 20, "Manifest sets the streaming radii");
+
+        // Only nearby cells load, on worker threads
+        Vector3 viewer(5, 0, 5);
+        world.Update(viewer);
+        Check(world.GetCellState(0, 0) == WorldPartition::CellState::LOADING, "Nearby cell starts loading asynchronously");
+        Check(world.GetCellState(2, 0) == WorldPartition::CellState::UNLOADED, "Distant cell is not loaded");
+
+        Settle(world, viewer);
+        Check(world.GetCellState(0, 0) == WorldPartition::CellState::ACTIVE &&
+              world.GetCellState(1, 0) == WorldPartition::CellState::ACTIVE, "Loaded cells are activated");
+        Check(scene.gameObjects.size() == 6, "Cell objects are added to the scene");
+
+        // Hysteresis: cell 0 stays while inside the unload radius
+        viewer = Vector3(25, 0, 5);
+        Settle(world, viewer);
+        Settle(world, viewer);
+        Check(world.GetCellState(0, 0) == WorldPartition::CellState::ACTIVE, "Cell inside the unload radius stays resident");
+        Check(world.GetCellState(3, 0) == WorldPartition::CellState::ACTIVE, "Cell ahead of the viewer streams in");
+
+        viewer = Vector3(35, 0, 5);
+        world.Update(viewer);
+        Check(world.GetCellState(0, 0) == WorldPartition::CellState::UNLOADED, "Cell beyond the unload radius is unloaded");
+        Check(scene.FindGameObject("cell0_0") == nullptr, "Unloaded objects leave the scene");
+
+        // Moving away before a load finishes discards the result
+        viewer = Vector3(5, 0, 5);
+        world.Update(viewer);
+        world.Update(Vector3(500, 0, 500));
+        Settle(world, Vector3(500, 0, 500));
+        Check(world.GetCellState(0, 0) == WorldPartition::CellState::UNLOADED && scene.gameObjects.empty(),
+              "Load cancelled by moving away leaves nothing behind");
+        Check(world.GetResidentObjectCount() == 0, "No objects stay resident far from every cell");
+
+        // Activation is spread over frames under the budget
+        world.SetActivationBudget(0.0f);
+        viewer = Vector3(5, 0, 105);
+        Settle(world, viewer);
+        Settle(world, viewer);
+        Check(world.GetCellState(0, 10) == WorldPartition::CellState::ACTIVATING &&
+              scene.gameObjects.size() < 200, "Large cell activates over several frames");
+        for (int frame = 0; frame < 20; frame++) {
+            world.Update(viewer);
+        }
+        Check(world.GetCellState(0, 10) == WorldPartition::CellState::ACTIVE && scene.gameObjects.size() == 200,
+              "Large cell finishes activating");
+
+        // Missing cell files fail once instead of retrying every frame
+        viewer = Vector3(5, 0, -95);
+        Settle(world, viewer);
+        Settle(world, viewer);
+        Check(world.GetCellState(0, -10) == WorldPartition::CellState::FAILED, "Missing cell file is reported as failed");
+
+        world.Clear();
+        Check(scene.gameObjects.empty() && world.GetActiveCellCount() == 0, "Clear unloads every cell");
+    }
+
+    std::remove("world_test.json");
+    std::remove("world_test_big.json");
+    for (int x = 0; x < 5; x++) {
+        std::remove(("world_test_cell_" + std::to_string(x) + ".json").c_str());
+    }
+
+    return TestSummary();
+}